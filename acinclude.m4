@@ -28,6 +28,34 @@ AC_DEFUN([AX_LIBEWF_CHECK_HOST_OPERATING_SYSTEM],
     [Defines the fallback operating system string.])
 ])
 
+dnl Function to detect whether statically defined tracing (USDT) probes should be enabled
+AC_DEFUN([AX_LIBEWF_CHECK_ENABLE_USDT_PROBES],
+  [AX_COMMON_ARG_ENABLE(
+    [usdt-probes],
+    [usdt_probes],
+    [enable statically defined tracing (USDT) probes, requires sys/sdt.h],
+    [no])
+
+  AS_IF(
+    [test "x$ac_cv_enable_usdt_probes" != xno],
+    [dnl Header included in libewf/libewf_probes.h
+    AC_CHECK_HEADERS([sys/sdt.h])
+
+    AS_IF(
+      [test "x$ac_cv_header_sys_sdt_h" != xyes],
+      [AC_MSG_FAILURE(
+        [Missing header: sys/sdt.h required for USDT probes],
+        [1])
+    ])
+
+    AC_DEFINE(
+      [HAVE_USDT_PROBES],
+      [1],
+      [Define to 1 if statically defined tracing (USDT) probes should be used.])
+
+    ac_cv_enable_usdt_probes=yes])
+])
+
 dnl Function to detect if libewf dependencies are available
 AC_DEFUN([AX_LIBEWF_CHECK_LOCAL],
   [dnl Check for type definitions
@@ -60,12 +88,48 @@ AC_DEFUN([AX_LIBEWF_CHECK_LOCAL],
   dnl Check for internationalization functions in libewf/libewf_i18n.c 
   AC_CHECK_FUNCS([bindtextdomain])
 
+  dnl Atomic operations used in libewf/libewf_statistics.h
+  dnl and ewftools/storage_media_buffer_queue.c
+  AC_CACHE_CHECK(
+    [whether the compiler supports the __atomic builtins],
+    [ac_cv_libewf_have_atomic_builtins],
+    [AC_LANG_PUSH(C)
+    AC_LINK_IFELSE(
+      [AC_LANG_PROGRAM(
+        [[#include <stddef.h>
+#include <stdint.h>]],
+        [[size_t value = 0;
+size_t expected = 0;
+uint64_t counter = 0;
+__atomic_compare_exchange_n( &value, &expected, 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED );
+__atomic_store_n( &value, __atomic_load_n( &value, __ATOMIC_ACQUIRE ) + 1, __ATOMIC_RELEASE );
+__atomic_add_fetch( &value, 1, __ATOMIC_SEQ_CST );
+__atomic_add_fetch( &counter, __atomic_load_n( &counter, __ATOMIC_RELAXED ), __ATOMIC_RELAXED );
+__atomic_thread_fence( __ATOMIC_SEQ_CST ); ]] )],
+      [ac_cv_libewf_have_atomic_builtins=yes],
+      [ac_cv_libewf_have_atomic_builtins=no])
+    AC_LANG_POP(C)])
+
+  AS_IF(
+    [test "x$ac_cv_libewf_have_atomic_builtins" = xyes],
+    [AC_DEFINE(
+      [HAVE_ATOMIC_BUILTINS],
+      [1],
+      [Define to 1 if the compiler supports the __atomic builtins.])
+  ])
+
+  dnl Timing functions used in libewf/libewf_statistics.c
+  AC_CHECK_FUNCS([clock_gettime gettimeofday])
+
   dnl Check if library should be build with verbose output
   AX_COMMON_CHECK_ENABLE_VERBOSE_OUTPUT
 
   dnl Check if library should be build with debug output
   AX_COMMON_CHECK_ENABLE_DEBUG_OUTPUT
 
+  dnl Check if library should be build with USDT probes
+  AX_LIBEWF_CHECK_ENABLE_USDT_PROBES
+
   dnl Check if DLL support is needed
   AS_IF(
     [test "x$enable_shared" = xyes],
@@ -96,8 +160,18 @@ AC_DEFUN([AX_EWFTOOLS_CHECK_LOCAL],
     [AC_CHECK_HEADERS([io.h])
   ])
 
+  dnl Headers included in ewftools/nbd_handle.c and ewftools/nbd_connection.c
+  AC_CHECK_HEADERS([netdb.h sys/socket.h sys/un.h])
+
+  dnl Headers and functions used in ewftools/device_reader.c and ewftools/rescue_handle.c
+  AC_CHECK_HEADERS([fcntl.h])
+  AC_CHECK_FUNCS([fdatasync posix_memalign pread pwrite])
+
+  dnl Functions used in ewftools/checkpoint.c and ewftools/rescue_handle.c
+  AC_CHECK_FUNCS([fsync])
+
   dnl Functions used in ewftools
-  AC_CHECK_FUNCS([close getopt setvbuf])
+  AC_CHECK_FUNCS([clock_gettime close getopt gettimeofday setvbuf sysconf])
 
   AS_IF(
    [test "x$ac_cv_func_close" != xyes],
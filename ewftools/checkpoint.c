@@ -0,0 +1,1124 @@
+/*
+ * Checkpoint of an acquiry
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_STDIO_H )
+#include <stdio.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "checkpoint.h"
+#include "digest_context.h"
+#include "ewftools_libcerror.h"
+
+#if defined( HAVE_CHECKPOINT )
+
+/* The names of the digest context states in the checkpoint file
+ */
+static const char *checkpoint_digest_names[ CHECKPOINT_NUMBER_OF_DIGEST_TYPES ] = {
+	"md5", "sha1", "sha256" };
+
+/* Creates a checkpoint
+ * The checkpoint is stored next to the target as the basename with the extension .checkpoint
+ * Make sure the value checkpoint is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int checkpoint_initialize(
+     checkpoint_t **checkpoint,
+     const system_character_t *target_basename,
+     size_t target_basename_length,
+     libcerror_error_t **error )
+{
+	static char *function = "checkpoint_initialize";
+
+	if( checkpoint == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checkpoint.",
+		 function );
+
+		return( -1 );
+	}
+	if( *checkpoint != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid checkpoint value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( target_basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid target basename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( target_basename_length == 0 )
+	 || ( target_basename_length > (size_t) ( SSIZE_MAX - 12 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid target basename length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*checkpoint = memory_allocate_structure(
+	               checkpoint_t );
+
+	if( *checkpoint == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create checkpoint.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *checkpoint,
+	     0,
+	     sizeof( checkpoint_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear checkpoint.",
+		 function );
+
+		memory_free(
+		 *checkpoint );
+
+		*checkpoint = NULL;
+
+		return( -1 );
+	}
+	( *checkpoint )->filename_size = target_basename_length + 12;
+
+	( *checkpoint )->filename = system_string_allocate(
+	                             ( *checkpoint )->filename_size );
+
+	if( ( *checkpoint )->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     ( *checkpoint )->filename,
+	     target_basename,
+	     target_basename_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     &( ( *checkpoint )->filename[ target_basename_length ] ),
+	     _SYSTEM_STRING( ".checkpoint" ),
+	     11 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy filename extension.",
+		 function );
+
+		goto on_error;
+	}
+	( *checkpoint )->filename[ target_basename_length + 11 ] = 0;
+
+	return( 1 );
+
+on_error:
+	if( *checkpoint != NULL )
+	{
+		if( ( *checkpoint )->filename != NULL )
+		{
+			memory_free(
+			 ( *checkpoint )->filename );
+		}
+		memory_free(
+		 *checkpoint );
+
+		*checkpoint = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a checkpoint
+ * Returns 1 if successful or -1 on error
+ */
+int checkpoint_free(
+     checkpoint_t **checkpoint,
+     libcerror_error_t **error )
+{
+	static char *function = "checkpoint_free";
+
+	if( checkpoint == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checkpoint.",
+		 function );
+
+		return( -1 );
+	}
+	if( *checkpoint != NULL )
+	{
+		if( ( *checkpoint )->filename != NULL )
+		{
+			memory_free(
+			 ( *checkpoint )->filename );
+		}
+		memory_free(
+		 *checkpoint );
+
+		*checkpoint = NULL;
+	}
+	return( 1 );
+}
+
+/* Clears the values of the checkpoint
+ * Returns 1 if successful or -1 on error
+ */
+int checkpoint_clear_values(
+     checkpoint_t *checkpoint,
+     libcerror_error_t **error )
+{
+	static char *function = "checkpoint_clear_values";
+
+	if( checkpoint == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checkpoint.",
+		 function );
+
+		return( -1 );
+	}
+	checkpoint->offset           = 0;
+	checkpoint->segment_number   = 0;
+	checkpoint->number_of_chunks = 0;
+
+	if( memory_set(
+	     checkpoint->digest_states,
+	     0,
+	     sizeof( uint8_t ) * CHECKPOINT_NUMBER_OF_DIGEST_TYPES * DIGEST_CONTEXT_STATE_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear digest states.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     checkpoint->digest_state_is_set,
+	     0,
+	     sizeof( uint8_t ) * CHECKPOINT_NUMBER_OF_DIGEST_TYPES ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear digest states set values.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Restores a digest context from the state stored in the checkpoint
+ * Returns 1 if successful, 0 if the checkpoint does not contain the state or -1 on error
+ */
+int checkpoint_get_digest_state(
+     checkpoint_t *checkpoint,
+     int digest_type,
+     digest_context_t *digest_context,
+     libcerror_error_t **error )
+{
+	static char *function = "checkpoint_get_digest_state";
+
+	if( checkpoint == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checkpoint.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( digest_type < 0 )
+	 || ( digest_type >= CHECKPOINT_NUMBER_OF_DIGEST_TYPES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported digest type.",
+		 function );
+
+		return( -1 );
+	}
+	if( checkpoint->digest_state_is_set[ digest_type ] == 0 )
+	{
+		return( 0 );
+	}
+	if( digest_context_set_state(
+	     digest_context,
+	     checkpoint->digest_states[ digest_type ],
+	     DIGEST_CONTEXT_STATE_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set %s digest context state.",
+		 function,
+		 checkpoint_digest_names[ digest_type ] );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Stores the state of a digest context in the checkpoint
+ * Returns 1 if successful or -1 on error
+ */
+int checkpoint_set_digest_state(
+     checkpoint_t *checkpoint,
+     int digest_type,
+     digest_context_t *digest_context,
+     libcerror_error_t **error )
+{
+	static char *function = "checkpoint_set_digest_state";
+
+	if( checkpoint == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checkpoint.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( digest_type < 0 )
+	 || ( digest_type >= CHECKPOINT_NUMBER_OF_DIGEST_TYPES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported digest type.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_context_get_state(
+	     digest_context,
+	     checkpoint->digest_states[ digest_type ],
+	     DIGEST_CONTEXT_STATE_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve %s digest context state.",
+		 function,
+		 checkpoint_digest_names[ digest_type ] );
+
+		return( -1 );
+	}
+	checkpoint->digest_state_is_set[ digest_type ] = 1;
+
+	return( 1 );
+}
+
+/* Parses a decimal value in a checkpoint line
+ * Returns 1 if successful or -1 on error
+ */
+int checkpoint_parse_decimal_value(
+     const char *string,
+     size_t string_length,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function = "checkpoint_parse_decimal_value";
+	size_t string_index   = 0;
+	uint64_t safe_value   = 0;
+	uint8_t digit         = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( string_length == 0 )
+	 || ( string_length > 20 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid string length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	for( string_index = 0;
+	     string_index < string_length;
+	     string_index++ )
+	{
+		if( ( string[ string_index ] < '0' )
+		 || ( string[ string_index ] > '9' ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character in decimal value.",
+			 function );
+
+			return( -1 );
+		}
+		digit = (uint8_t) ( string[ string_index ] - '0' );
+
+		if( safe_value > ( ( UINT64_MAX - digit ) / 10 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: decimal value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		safe_value = ( safe_value * 10 ) + digit;
+	}
+	*value_64bit = safe_value;
+
+	return( 1 );
+}
+
+/* Parses a digest context state in a checkpoint line
+ * The state is stored as a hexadecimal string
+ * Returns 1 if successful or -1 on error
+ */
+int checkpoint_parse_digest_state(
+     const char *string,
+     size_t string_length,
+     uint8_t *state,
+     size_t state_size,
+     libcerror_error_t **error )
+{
+	static char *function = "checkpoint_parse_digest_state";
+	size_t string_index   = 0;
+	size_t state_index    = 0;
+	uint8_t byte_value    = 0;
+	uint8_t nibble        = 0;
+	char character        = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid state.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_length != ( state_size * 2 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid string length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( state_index = 0;
+	     state_index < state_size;
+	     state_index++ )
+	{
+		byte_value = 0;
+
+		for( string_index = state_index * 2;
+		     string_index < ( state_index * 2 ) + 2;
+		     string_index++ )
+		{
+			character = string[ string_index ];
+
+			if( ( character >= '0' )
+			 && ( character <= '9' ) )
+			{
+				nibble = (uint8_t) ( character - '0' );
+			}
+			else if( ( character >= 'a' )
+			      && ( character <= 'f' ) )
+			{
+				nibble = (uint8_t) ( character - 'a' + 10 );
+			}
+			else
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported character in digest state.",
+				 function );
+
+				return( -1 );
+			}
+			byte_value = (uint8_t) ( ( byte_value << 4 ) | nibble );
+		}
+		state[ state_index ] = byte_value;
+	}
+	return( 1 );
+}
+
+/* Reads the checkpoint
+ * Returns 1 if successful, 0 if no checkpoint was written or -1 on error
+ */
+int checkpoint_read(
+     checkpoint_t *checkpoint,
+     libcerror_error_t **error )
+{
+	char line[ 256 ];
+
+	FILE *stream          = NULL;
+	const char *value     = NULL;
+	static char *function = "checkpoint_read";
+	size_t line_length    = 0;
+	size_t name_length    = 0;
+	size_t value_length   = 0;
+	uint64_t value_64bit  = 0;
+	int digest_type       = 0;
+	int has_offset        = 0;
+	int line_number       = 0;
+
+	if( checkpoint == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checkpoint.",
+		 function );
+
+		return( -1 );
+	}
+	if( checkpoint_clear_values(
+	     checkpoint,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to clear checkpoint values.",
+		 function );
+
+		return( -1 );
+	}
+	stream = file_stream_open(
+	          checkpoint->filename,
+	          FILE_STREAM_OPEN_READ );
+
+	if( stream == NULL )
+	{
+		if( errno != ENOENT )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 errno,
+			 "%s: unable to open checkpoint: %" PRIs_SYSTEM ".",
+			 function,
+			 checkpoint->filename );
+
+			return( -1 );
+		}
+		return( 0 );
+	}
+	while( file_stream_get_string(
+	        stream,
+	        line,
+	        256 ) != NULL )
+	{
+		line_number++;
+
+		line_length = narrow_string_length(
+		               line );
+
+		while( ( line_length > 0 )
+		    && ( ( line[ line_length - 1 ] == '\n' )
+		     ||  ( line[ line_length - 1 ] == '\r' ) ) )
+		{
+			line_length--;
+		}
+		if( ( line_length == 0 )
+		 || ( line[ 0 ] == '#' ) )
+		{
+			continue;
+		}
+		for( name_length = 0;
+		     name_length < line_length;
+		     name_length++ )
+		{
+			if( line[ name_length ] == ':' )
+			{
+				break;
+			}
+		}
+		if( ( name_length + 2 ) > line_length )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing value in checkpoint line: %d.",
+			 function,
+			 line_number );
+
+			goto on_error;
+		}
+		value        = &( line[ name_length + 2 ] );
+		value_length = line_length - ( name_length + 2 );
+
+		if( ( name_length == 6 )
+		 && ( narrow_string_compare(
+		       line,
+		       "offset",
+		       6 ) == 0 ) )
+		{
+			if( checkpoint_parse_decimal_value(
+			     value,
+			     value_length,
+			     &value_64bit,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to parse offset in checkpoint line: %d.",
+				 function,
+				 line_number );
+
+				goto on_error;
+			}
+			if( value_64bit > (uint64_t) INT64_MAX )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid offset value out of bounds.",
+				 function );
+
+				goto on_error;
+			}
+			checkpoint->offset = (off64_t) value_64bit;
+
+			has_offset = 1;
+		}
+		else if( ( name_length == 14 )
+		      && ( narrow_string_compare(
+		            line,
+		            "segment number",
+		            14 ) == 0 ) )
+		{
+			if( checkpoint_parse_decimal_value(
+			     value,
+			     value_length,
+			     &value_64bit,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to parse segment number in checkpoint line: %d.",
+				 function,
+				 line_number );
+
+				goto on_error;
+			}
+			if( value_64bit > (uint64_t) UINT32_MAX )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid segment number value out of bounds.",
+				 function );
+
+				goto on_error;
+			}
+			checkpoint->segment_number = (uint32_t) value_64bit;
+		}
+		else if( ( name_length == 16 )
+		      && ( narrow_string_compare(
+		            line,
+		            "number of chunks",
+		            16 ) == 0 ) )
+		{
+			if( checkpoint_parse_decimal_value(
+			     value,
+			     value_length,
+			     &( checkpoint->number_of_chunks ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to parse number of chunks in checkpoint line: %d.",
+				 function,
+				 line_number );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			for( digest_type = 0;
+			     digest_type < CHECKPOINT_NUMBER_OF_DIGEST_TYPES;
+			     digest_type++ )
+			{
+				if( ( name_length == narrow_string_length( checkpoint_digest_names[ digest_type ] ) )
+				 && ( narrow_string_compare(
+				       line,
+				       checkpoint_digest_names[ digest_type ],
+				       name_length ) == 0 ) )
+				{
+					break;
+				}
+			}
+			if( digest_type >= CHECKPOINT_NUMBER_OF_DIGEST_TYPES )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported value in checkpoint line: %d.",
+				 function,
+				 line_number );
+
+				goto on_error;
+			}
+			if( checkpoint_parse_digest_state(
+			     value,
+			     value_length,
+			     checkpoint->digest_states[ digest_type ],
+			     DIGEST_CONTEXT_STATE_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to parse %s digest state in checkpoint line: %d.",
+				 function,
+				 checkpoint_digest_names[ digest_type ],
+				 line_number );
+
+				goto on_error;
+			}
+			checkpoint->digest_state_is_set[ digest_type ] = 1;
+		}
+	}
+	if( has_offset == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing offset in checkpoint: %" PRIs_SYSTEM ".",
+		 function,
+		 checkpoint->filename );
+
+		goto on_error;
+	}
+	if( file_stream_close(
+	     stream ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close checkpoint.",
+		 function );
+
+		stream = NULL;
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( stream != NULL )
+	{
+		file_stream_close(
+		 stream );
+	}
+	checkpoint_clear_values(
+	 checkpoint,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Writes the checkpoint
+ * The checkpoint is written to a temporary file that is flushed to storage
+ * and then replaces the previous checkpoint
+ * Returns 1 if successful or -1 on error
+ */
+int checkpoint_write(
+     checkpoint_t *checkpoint,
+     libcerror_error_t **error )
+{
+	FILE *stream                           = NULL;
+	system_character_t *temporary_filename = NULL;
+	static char *function                  = "checkpoint_write";
+	size_t state_index                     = 0;
+	int digest_type                        = 0;
+
+	if( checkpoint == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checkpoint.",
+		 function );
+
+		return( -1 );
+	}
+	temporary_filename = system_string_allocate(
+	                      checkpoint->filename_size + 4 );
+
+	if( temporary_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create temporary filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     temporary_filename,
+	     checkpoint->filename,
+	     checkpoint->filename_size - 1 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy temporary filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     &( temporary_filename[ checkpoint->filename_size - 1 ] ),
+	     _SYSTEM_STRING( ".tmp" ),
+	     4 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy temporary filename extension.",
+		 function );
+
+		goto on_error;
+	}
+	temporary_filename[ checkpoint->filename_size + 3 ] = 0;
+
+	stream = file_stream_open(
+	          temporary_filename,
+	          FILE_STREAM_OPEN_WRITE );
+
+	if( stream == NULL )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open checkpoint: %" PRIs_SYSTEM ".",
+		 function,
+		 temporary_filename );
+
+		goto on_error;
+	}
+	fprintf(
+	 stream,
+	 "# Checkpoint created by ewfacquire\n"
+	 "offset: %" PRIi64 "\n"
+	 "segment number: %" PRIu32 "\n"
+	 "number of chunks: %" PRIu64 "\n",
+	 checkpoint->offset,
+	 checkpoint->segment_number,
+	 checkpoint->number_of_chunks );
+
+	for( digest_type = 0;
+	     digest_type < CHECKPOINT_NUMBER_OF_DIGEST_TYPES;
+	     digest_type++ )
+	{
+		if( checkpoint->digest_state_is_set[ digest_type ] == 0 )
+		{
+			continue;
+		}
+		fprintf(
+		 stream,
+		 "%s: ",
+		 checkpoint_digest_names[ digest_type ] );
+
+		for( state_index = 0;
+		     state_index < DIGEST_CONTEXT_STATE_SIZE;
+		     state_index++ )
+		{
+			fprintf(
+			 stream,
+			 "%02" PRIx8 "",
+			 checkpoint->digest_states[ digest_type ][ state_index ] );
+		}
+		fprintf(
+		 stream,
+		 "\n" );
+	}
+	/* Make sure the checkpoint is stored before it replaces the previous one
+	 */
+	if( fflush(
+	     stream ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 errno,
+		 "%s: unable to flush checkpoint.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_FSYNC )
+	if( fsync(
+	     fileno( stream ) ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 errno,
+		 "%s: unable to synchronize checkpoint.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( file_stream_close(
+	     stream ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close checkpoint.",
+		 function );
+
+		stream = NULL;
+
+		goto on_error;
+	}
+	stream = NULL;
+
+	if( rename(
+	     temporary_filename,
+	     checkpoint->filename ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 errno,
+		 "%s: unable to replace checkpoint: %" PRIs_SYSTEM ".",
+		 function,
+		 checkpoint->filename );
+
+		goto on_error;
+	}
+	memory_free(
+	 temporary_filename );
+
+	return( 1 );
+
+on_error:
+	if( stream != NULL )
+	{
+		file_stream_close(
+		 stream );
+	}
+	if( temporary_filename != NULL )
+	{
+		memory_free(
+		 temporary_filename );
+	}
+	return( -1 );
+}
+
+/* Removes the checkpoint
+ * Returns 1 if successful or -1 on error
+ */
+int checkpoint_remove(
+     checkpoint_t *checkpoint,
+     libcerror_error_t **error )
+{
+	static char *function = "checkpoint_remove";
+
+	if( checkpoint == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checkpoint.",
+		 function );
+
+		return( -1 );
+	}
+	if( remove(
+	     checkpoint->filename ) != 0 )
+	{
+		if( errno != ENOENT )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+			 errno,
+			 "%s: unable to remove checkpoint: %" PRIs_SYSTEM ".",
+			 function,
+			 checkpoint->filename );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_CHECKPOINT ) */
+
@@ -0,0 +1,143 @@
+/*
+ * Checkpoint of an acquiry
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _CHECKPOINT_H )
+#define _CHECKPOINT_H
+
+#include <common.h>
+#include <types.h>
+
+#include "digest_context.h"
+#include "ewftools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The checkpoint requires replacing a file by renaming
+ */
+#if !defined( WINAPI ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#define HAVE_CHECKPOINT
+#endif
+
+enum CHECKPOINT_DIGEST_TYPES
+{
+	CHECKPOINT_DIGEST_TYPE_MD5		= 0,
+	CHECKPOINT_DIGEST_TYPE_SHA1		= 1,
+	CHECKPOINT_DIGEST_TYPE_SHA256		= 2
+};
+
+#define CHECKPOINT_NUMBER_OF_DIGEST_TYPES	3
+
+#if defined( HAVE_CHECKPOINT )
+
+typedef struct checkpoint checkpoint_t;
+
+struct checkpoint
+{
+	/* The filename
+	 */
+	system_character_t *filename;
+
+	/* The filename size
+	 */
+	size_t filename_size;
+
+	/* The offset of the data acquired, relative to the acquiry offset
+	 */
+	off64_t offset;
+
+	/* The segment number of the last segment file written
+	 */
+	uint32_t segment_number;
+
+	/* The number of chunks written
+	 */
+	uint64_t number_of_chunks;
+
+	/* The digest context states
+	 */
+	uint8_t digest_states[ CHECKPOINT_NUMBER_OF_DIGEST_TYPES ][ DIGEST_CONTEXT_STATE_SIZE ];
+
+	/* Value to indicate which digest context states are set
+	 */
+	uint8_t digest_state_is_set[ CHECKPOINT_NUMBER_OF_DIGEST_TYPES ];
+};
+
+int checkpoint_initialize(
+     checkpoint_t **checkpoint,
+     const system_character_t *target_basename,
+     size_t target_basename_length,
+     libcerror_error_t **error );
+
+int checkpoint_free(
+     checkpoint_t **checkpoint,
+     libcerror_error_t **error );
+
+int checkpoint_clear_values(
+     checkpoint_t *checkpoint,
+     libcerror_error_t **error );
+
+int checkpoint_get_digest_state(
+     checkpoint_t *checkpoint,
+     int digest_type,
+     digest_context_t *digest_context,
+     libcerror_error_t **error );
+
+int checkpoint_set_digest_state(
+     checkpoint_t *checkpoint,
+     int digest_type,
+     digest_context_t *digest_context,
+     libcerror_error_t **error );
+
+int checkpoint_parse_decimal_value(
+     const char *string,
+     size_t string_length,
+     uint64_t *value_64bit,
+     libcerror_error_t **error );
+
+int checkpoint_parse_digest_state(
+     const char *string,
+     size_t string_length,
+     uint8_t *state,
+     size_t state_size,
+     libcerror_error_t **error );
+
+int checkpoint_read(
+     checkpoint_t *checkpoint,
+     libcerror_error_t **error );
+
+int checkpoint_write(
+     checkpoint_t *checkpoint,
+     libcerror_error_t **error );
+
+int checkpoint_remove(
+     checkpoint_t *checkpoint,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_CHECKPOINT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _CHECKPOINT_H ) */
+
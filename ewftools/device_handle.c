@@ -180,6 +180,7 @@ int device_handle_initialize(
 		goto on_error;
 	}
 	( *device_handle )->number_of_error_retries = 2;
+	( *device_handle )->read_queue_depth        = 4;
 	( *device_handle )->notify_stream           = DEVICE_HANDLE_NOTIFY_STREAM;
 
 	return( 1 );
@@ -2263,6 +2264,60 @@ int device_handle_set_number_of_error_retries(
 	return( result );
 }
 
+/* Sets the read queue depth
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int device_handle_set_read_queue_depth(
+     device_handle_t *device_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function     = "device_handle_set_read_queue_depth";
+	size_t string_length      = 0;
+	uint64_t read_queue_depth = 0;
+	int result                = 0;
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string[ 0 ] != (system_character_t) '-' )
+	{
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &read_queue_depth,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine read queue depth.",
+			 function );
+
+			return( -1 );
+		}
+		if( read_queue_depth <= 64 )
+		{
+			device_handle->read_queue_depth = (int) read_queue_depth;
+
+			result = 1;
+		}
+	}
+	return( result );
+}
+
 /* Sets the error values
  * Returns 1 if successful or -1 on error
  */
@@ -111,6 +111,10 @@ struct device_handle
 	 */
 	uint8_t zero_buffer_on_error;
 
+	/* The read queue depth, the number of reads kept in flight by the device reader
+	 */
+	int read_queue_depth;
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
@@ -254,6 +258,11 @@ int device_handle_set_number_of_error_retries(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int device_handle_set_read_queue_depth(
+     device_handle_t *device_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int device_handle_set_error_values(
      device_handle_t *device_handle,
      size_t error_granularity,
@@ -0,0 +1,740 @@
+/*
+ * Device reader, reads ahead device data using concurrent direct I/O reads
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "device_handle.h"
+#include "device_reader.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "storage_media_buffer.h"
+
+#if defined( HAVE_DEVICE_READER )
+
+/* Creates a device reader
+ * Make sure the value device_reader is referencing, is set to NULL
+ * The device is opened a second time, using direct I/O if supported, for the read ahead
+ * Returns 1 if successful or -1 on error
+ */
+int device_reader_initialize(
+     device_reader_t **device_reader,
+     device_handle_t *device_handle,
+     const system_character_t *filename,
+     off64_t media_offset,
+     int queue_depth,
+     libcerror_error_t **error )
+{
+	static char *function = "device_reader_initialize";
+	int open_flags        = O_RDONLY;
+
+	if( device_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *device_reader != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid device reader value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid media offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( queue_depth <= 0 )
+	 || ( queue_depth > DEVICE_READER_MAXIMUM_QUEUE_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid queue depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*device_reader = memory_allocate_structure(
+	                  device_reader_t );
+
+	if( *device_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create device reader.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *device_reader,
+	     0,
+	     sizeof( device_reader_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear device reader.",
+		 function );
+
+		memory_free(
+		 *device_reader );
+
+		*device_reader = NULL;
+
+		return( -1 );
+	}
+	( *device_reader )->device_handle   = device_handle;
+	( *device_reader )->media_offset    = media_offset;
+	( *device_reader )->file_descriptor = -1;
+	( *device_reader )->queue_depth     = queue_depth;
+
+#if defined( O_DIRECT )
+	( *device_reader )->file_descriptor = open(
+	                                       filename,
+	                                       open_flags | O_DIRECT );
+
+	if( ( *device_reader )->file_descriptor != -1 )
+	{
+		( *device_reader )->use_direct_io = 1;
+	}
+#endif
+	/* Not every device or file system supports direct I/O
+	 */
+	if( ( *device_reader )->file_descriptor == -1 )
+	{
+		( *device_reader )->file_descriptor = open(
+		                                       filename,
+		                                       open_flags );
+	}
+	if( ( *device_reader )->file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open device: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *device_reader )->completion_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create completion mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *device_reader )->completion_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create completion condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( ( *device_reader )->read_thread_pool ),
+	     NULL,
+	     queue_depth,
+	     queue_depth,
+	     (int (*)(intptr_t *, void *)) &device_reader_read_callback,
+	     (void *) *device_reader,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *device_reader != NULL )
+	{
+		if( ( *device_reader )->completion_condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *device_reader )->completion_condition ),
+			 NULL );
+		}
+		if( ( *device_reader )->completion_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *device_reader )->completion_mutex ),
+			 NULL );
+		}
+		if( ( *device_reader )->file_descriptor != -1 )
+		{
+			close(
+			 ( *device_reader )->file_descriptor );
+		}
+		memory_free(
+		 *device_reader );
+
+		*device_reader = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a device reader
+ * Waits for the reads in flight and frees the storage media buffers that were not retrieved
+ * Returns 1 if successful or -1 on error
+ */
+int device_reader_free(
+     device_reader_t **device_reader,
+     libcerror_error_t **error )
+{
+	static char *function = "device_reader_free";
+	int request_index     = 0;
+	int result            = 1;
+
+	if( device_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *device_reader != NULL )
+	{
+		if( ( *device_reader )->read_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *device_reader )->read_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join read thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		while( ( *device_reader )->number_of_requests > 0 )
+		{
+			request_index = ( *device_reader )->first_request_index;
+
+			if( storage_media_buffer_free(
+			     &( ( ( *device_reader )->requests[ request_index ] ).storage_media_buffer ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free storage media buffer: %d.",
+				 function,
+				 request_index );
+
+				result = -1;
+			}
+			( *device_reader )->first_request_index = ( request_index + 1 ) % ( *device_reader )->queue_depth;
+
+			( *device_reader )->number_of_requests -= 1;
+		}
+		if( ( *device_reader )->file_descriptor != -1 )
+		{
+			if( close(
+			     ( *device_reader )->file_descriptor ) != 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 errno,
+				 "%s: unable to close device.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *device_reader )->completion_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free completion condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *device_reader )->completion_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free completion mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *device_reader );
+
+		*device_reader = NULL;
+	}
+	return( result );
+}
+
+/* Reads the data of a request from the device
+ * Callback function for the read thread pool
+ * A failed or short read is not an error, the region is read again using the device handle
+ * Returns 1 if successful or -1 on error
+ */
+int device_reader_read_callback(
+     device_reader_request_t *request,
+     device_reader_t *device_reader )
+{
+	uint8_t *buffer     = NULL;
+	ssize_t read_count  = 0;
+	size_t buffer_index = 0;
+	int result          = 1;
+
+	if( ( request == NULL )
+	 || ( device_reader == NULL ) )
+	{
+		return( -1 );
+	}
+	buffer = request->storage_media_buffer->raw_buffer;
+
+	while( buffer_index < request->read_size )
+	{
+		read_count = pread(
+		              device_reader->file_descriptor,
+		              &( buffer[ buffer_index ] ),
+		              request->read_size - buffer_index,
+		              (off_t) ( device_reader->media_offset + request->storage_media_offset + (off64_t) buffer_index ) );
+
+		if( read_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			break;
+		}
+		if( read_count == 0 )
+		{
+			break;
+		}
+		buffer_index += (size_t) read_count;
+	}
+	if( libcthreads_mutex_grab(
+	     device_reader->completion_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	if( read_count < 0 )
+	{
+		request->read_count = -1;
+	}
+	else
+	{
+		request->read_count = (ssize_t) buffer_index;
+	}
+	request->is_completed = 1;
+
+	if( libcthreads_condition_broadcast(
+	     device_reader->completion_condition,
+	     NULL ) != 1 )
+	{
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     device_reader->completion_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Starts reading a storage media buffer ahead
+ * The storage media buffer is owned by the device reader until it is retrieved by device_reader_wait_read
+ * Returns 1 if successful or -1 on error
+ */
+int device_reader_start_read(
+     device_reader_t *device_reader,
+     storage_media_buffer_t *storage_media_buffer,
+     off64_t storage_media_offset,
+     size_t read_size,
+     libcerror_error_t **error )
+{
+	device_reader_request_t *request = NULL;
+	static char *function            = "device_reader_start_read";
+	int request_index                = 0;
+
+	if( device_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_reader->number_of_requests >= device_reader->queue_depth )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid device reader - queue is full.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid storage media offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_size == 0 )
+	 || ( read_size > storage_media_buffer->raw_buffer_size )
+	 || ( read_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	request_index = ( device_reader->first_request_index + device_reader->number_of_requests ) % device_reader->queue_depth;
+
+	request = &( device_reader->requests[ request_index ] );
+
+	request->storage_media_buffer = storage_media_buffer;
+	request->storage_media_offset = storage_media_offset;
+	request->read_size            = read_size;
+	request->read_count           = 0;
+	request->is_completed         = 0;
+
+	if( libcthreads_thread_pool_push(
+	     device_reader->read_thread_pool,
+	     (intptr_t *) request,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push request onto read thread pool queue.",
+		 function );
+
+		request->storage_media_buffer = NULL;
+
+		return( -1 );
+	}
+	device_reader->number_of_requests += 1;
+
+	return( 1 );
+}
+
+/* Waits for the oldest read to complete and retrieves its storage media buffer
+ * Regions the direct read failed on are read again using the device handle,
+ * which applies the error retries, error granularity and zeroing on error
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t device_reader_wait_read(
+         device_reader_t *device_reader,
+         storage_media_buffer_t **storage_media_buffer,
+         libcerror_error_t **error )
+{
+	device_reader_request_t *request = NULL;
+	static char *function            = "device_reader_wait_read";
+	ssize_t read_count               = 0;
+
+	if( device_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_reader->number_of_requests == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid device reader - missing requests.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	request = &( device_reader->requests[ device_reader->first_request_index ] );
+
+	if( libcthreads_mutex_grab(
+	     device_reader->completion_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab completion mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( request->is_completed == 0 )
+	{
+		if( libcthreads_condition_wait(
+		     device_reader->completion_condition,
+		     device_reader->completion_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for completion condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 device_reader->completion_mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	read_count = request->read_count;
+
+	if( libcthreads_mutex_release(
+	     device_reader->completion_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release completion mutex.",
+		 function );
+
+		return( -1 );
+	}
+	*storage_media_buffer = request->storage_media_buffer;
+
+	request->storage_media_buffer = NULL;
+
+	device_reader->first_request_index = ( device_reader->first_request_index + 1 ) % device_reader->queue_depth;
+	device_reader->number_of_requests -= 1;
+
+	if( read_count == (ssize_t) request->read_size )
+	{
+		( *storage_media_buffer )->storage_media_offset = request->storage_media_offset;
+		( *storage_media_buffer )->requested_size       = request->read_size;
+		( *storage_media_buffer )->raw_buffer_data_size = (size_t) read_count;
+
+		return( read_count );
+	}
+#if defined( HAVE_VERBOSE_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: direct read failed at offset: 0x%08" PRIx64 " of size: %" PRIzd ", reading it using the device handle.\n",
+		 function,
+		 request->storage_media_offset,
+		 request->read_size );
+	}
+#endif
+	device_reader->number_of_fallback_reads += 1;
+
+	if( device_handle_seek_offset(
+	     device_reader->device_handle,
+	     device_reader->media_offset + request->storage_media_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " in device handle.",
+		 function,
+		 device_reader->media_offset + request->storage_media_offset );
+
+		return( -1 );
+	}
+	read_count = device_handle_read_storage_media_buffer(
+	              device_reader->device_handle,
+	              *storage_media_buffer,
+	              request->storage_media_offset,
+	              request->read_size,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read storage media buffer from device handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* The reads ahead assume the regions are contiguous
+	 */
+	if( read_count != (ssize_t) request->read_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unexpected end of input at offset: %" PRIi64 ".",
+		 function,
+		 request->storage_media_offset + (off64_t) read_count );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+#endif /* defined( HAVE_DEVICE_READER ) */
+
@@ -0,0 +1,162 @@
+/*
+ * Device reader, reads ahead device data using concurrent direct I/O reads
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _DEVICE_READER_H )
+#define _DEVICE_READER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "device_handle.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "storage_media_buffer.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The device reader requires threads and positional reads on a file descriptor
+ */
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( HAVE_FCNTL_H ) && defined( HAVE_PREAD ) && !defined( WINAPI ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#define HAVE_DEVICE_READER
+#endif
+
+#define DEVICE_READER_MAXIMUM_QUEUE_DEPTH	64
+
+typedef struct device_reader_request device_reader_request_t;
+
+struct device_reader_request
+{
+	/* The storage media buffer
+	 */
+	storage_media_buffer_t *storage_media_buffer;
+
+	/* The storage media offset
+	 */
+	off64_t storage_media_offset;
+
+	/* The read size
+	 */
+	size_t read_size;
+
+	/* The read count, which is -1 if the read failed
+	 */
+	ssize_t read_count;
+
+	/* Value to indicate the read has completed
+	 */
+	uint8_t is_completed;
+};
+
+typedef struct device_reader device_reader_t;
+
+struct device_reader
+{
+	/* The device handle, used to read regions the direct reads failed on
+	 */
+	device_handle_t *device_handle;
+
+	/* The offset of the storage media data relative to the start of the device
+	 */
+	off64_t media_offset;
+
+	/* The file descriptor
+	 */
+	int file_descriptor;
+
+	/* Value to indicate the file descriptor uses direct I/O
+	 */
+	uint8_t use_direct_io;
+
+	/* The queue depth
+	 */
+	int queue_depth;
+
+	/* The requests, stored as a ring buffer in order of submission
+	 */
+	device_reader_request_t requests[ DEVICE_READER_MAXIMUM_QUEUE_DEPTH ];
+
+	/* The index of the first (oldest) request
+	 */
+	int first_request_index;
+
+	/* The number of requests in flight
+	 */
+	int number_of_requests;
+
+	/* The number of reads that were redone using the device handle
+	 */
+	int number_of_fallback_reads;
+
+#if defined( HAVE_DEVICE_READER )
+	/* The read thread pool
+	 */
+	libcthreads_thread_pool_t *read_thread_pool;
+
+	/* The completion mutex
+	 */
+	libcthreads_mutex_t *completion_mutex;
+
+	/* The completion condition
+	 */
+	libcthreads_condition_t *completion_condition;
+#endif
+};
+
+#if defined( HAVE_DEVICE_READER )
+
+int device_reader_initialize(
+     device_reader_t **device_reader,
+     device_handle_t *device_handle,
+     const system_character_t *filename,
+     off64_t media_offset,
+     int queue_depth,
+     libcerror_error_t **error );
+
+int device_reader_free(
+     device_reader_t **device_reader,
+     libcerror_error_t **error );
+
+int device_reader_read_callback(
+     device_reader_request_t *request,
+     device_reader_t *device_reader );
+
+int device_reader_start_read(
+     device_reader_t *device_reader,
+     storage_media_buffer_t *storage_media_buffer,
+     off64_t storage_media_offset,
+     size_t read_size,
+     libcerror_error_t **error );
+
+ssize_t device_reader_wait_read(
+         device_reader_t *device_reader,
+         storage_media_buffer_t **storage_media_buffer,
+         libcerror_error_t **error );
+
+#endif /* defined( HAVE_DEVICE_READER ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _DEVICE_READER_H ) */
+
@@ -0,0 +1,945 @@
+/*
+ * Digest context with a state that can be stored and restored
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "digest_context.h"
+#include "ewftools_libcerror.h"
+
+#define digest_context_rotate_left_32bit( value, number_of_bits ) \
+	( ( ( value ) << ( number_of_bits ) ) | ( ( value ) >> ( 32 - ( number_of_bits ) ) ) )
+
+#define digest_context_rotate_right_32bit( value, number_of_bits ) \
+	( ( ( value ) >> ( number_of_bits ) ) | ( ( value ) << ( 32 - ( number_of_bits ) ) ) )
+
+/* The MD5 per round constants
+ */
+static const uint32_t digest_context_md5_constants[ 64 ] = {
+	0xd76aa478UL, 0xe8c7b756UL, 0x242070dbUL, 0xc1bdceeeUL, 0xf57c0fafUL, 0x4787c62aUL, 0xa8304613UL, 0xfd469501UL,
+	0x698098d8UL, 0x8b44f7afUL, 0xffff5bb1UL, 0x895cd7beUL, 0x6b901122UL, 0xfd987193UL, 0xa679438eUL, 0x49b40821UL,
+	0xf61e2562UL, 0xc040b340UL, 0x265e5a51UL, 0xe9b6c7aaUL, 0xd62f105dUL, 0x02441453UL, 0xd8a1e681UL, 0xe7d3fbc8UL,
+	0x21e1cde6UL, 0xc33707d6UL, 0xf4d50d87UL, 0x455a14edUL, 0xa9e3e905UL, 0xfcefa3f8UL, 0x676f02d9UL, 0x8d2a4c8aUL,
+	0xfffa3942UL, 0x8771f681UL, 0x6d9d6122UL, 0xfde5380cUL, 0xa4beea44UL, 0x4bdecfa9UL, 0xf6bb4b60UL, 0xbebfbc70UL,
+	0x289b7ec6UL, 0xeaa127faUL, 0xd4ef3085UL, 0x04881d05UL, 0xd9d4d039UL, 0xe6db99e5UL, 0x1fa27cf8UL, 0xc4ac5665UL,
+	0xf4292244UL, 0x432aff97UL, 0xab9423a7UL, 0xfc93a039UL, 0x655b59c3UL, 0x8f0ccc92UL, 0xffeff47dUL, 0x85845dd1UL,
+	0x6fa87e4fUL, 0xfe2ce6e0UL, 0xa3014314UL, 0x4e0811a1UL, 0xf7537e82UL, 0xbd3af235UL, 0x2ad7d2bbUL, 0xeb86d391UL };
+
+/* The MD5 per round left rotations
+ */
+static const uint8_t digest_context_md5_rotations[ 64 ] = {
+	7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+	5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20,
+	4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+	6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21 };
+
+/* The SHA256 per round constants
+ */
+static const uint32_t digest_context_sha256_constants[ 64 ] = {
+	0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+	0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+	0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL, 0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+	0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+	0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+	0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+	0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+	0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL, 0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL };
+
+/* Creates a digest context
+ * Make sure the value digest_context is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_initialize(
+     digest_context_t **digest_context,
+     uint8_t type,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_context_initialize";
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid digest context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( type != DIGEST_CONTEXT_TYPE_MD5 )
+	 && ( type != DIGEST_CONTEXT_TYPE_SHA1 )
+	 && ( type != DIGEST_CONTEXT_TYPE_SHA256 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported type.",
+		 function );
+
+		return( -1 );
+	}
+	*digest_context = memory_allocate_structure(
+	                   digest_context_t );
+
+	if( *digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create digest context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *digest_context,
+	     0,
+	     sizeof( digest_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear digest context.",
+		 function );
+
+		goto on_error;
+	}
+	( *digest_context )->type = type;
+
+	switch( type )
+	{
+		case DIGEST_CONTEXT_TYPE_MD5:
+			( *digest_context )->hash_values[ 0 ] = 0x67452301UL;
+			( *digest_context )->hash_values[ 1 ] = 0xefcdab89UL;
+			( *digest_context )->hash_values[ 2 ] = 0x98badcfeUL;
+			( *digest_context )->hash_values[ 3 ] = 0x10325476UL;
+			break;
+
+		case DIGEST_CONTEXT_TYPE_SHA1:
+			( *digest_context )->hash_values[ 0 ] = 0x67452301UL;
+			( *digest_context )->hash_values[ 1 ] = 0xefcdab89UL;
+			( *digest_context )->hash_values[ 2 ] = 0x98badcfeUL;
+			( *digest_context )->hash_values[ 3 ] = 0x10325476UL;
+			( *digest_context )->hash_values[ 4 ] = 0xc3d2e1f0UL;
+			break;
+
+		case DIGEST_CONTEXT_TYPE_SHA256:
+			( *digest_context )->hash_values[ 0 ] = 0x6a09e667UL;
+			( *digest_context )->hash_values[ 1 ] = 0xbb67ae85UL;
+			( *digest_context )->hash_values[ 2 ] = 0x3c6ef372UL;
+			( *digest_context )->hash_values[ 3 ] = 0xa54ff53aUL;
+			( *digest_context )->hash_values[ 4 ] = 0x510e527fUL;
+			( *digest_context )->hash_values[ 5 ] = 0x9b05688cUL;
+			( *digest_context )->hash_values[ 6 ] = 0x1f83d9abUL;
+			( *digest_context )->hash_values[ 7 ] = 0x5be0cd19UL;
+			break;
+	}
+	return( 1 );
+
+on_error:
+	if( *digest_context != NULL )
+	{
+		memory_free(
+		 *digest_context );
+
+		*digest_context = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a digest context
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_free(
+     digest_context_t **digest_context,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_context_free";
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_context != NULL )
+	{
+		memory_free(
+		 *digest_context );
+
+		*digest_context = NULL;
+	}
+	return( 1 );
+}
+
+/* Calculates the MD5 hash values of a block
+ */
+void digest_context_md5_transform(
+      digest_context_t *digest_context,
+      const uint8_t *block )
+{
+	uint32_t values_32bit[ 16 ];
+
+	uint32_t hash_value_a = 0;
+	uint32_t hash_value_b = 0;
+	uint32_t hash_value_c = 0;
+	uint32_t hash_value_d = 0;
+	uint32_t round_value  = 0;
+	uint32_t value_32bit  = 0;
+	int round_index       = 0;
+	int value_index       = 0;
+
+	for( value_index = 0;
+	     value_index < 16;
+	     value_index++ )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( block[ value_index * 4 ] ),
+		 values_32bit[ value_index ] );
+	}
+	hash_value_a = digest_context->hash_values[ 0 ];
+	hash_value_b = digest_context->hash_values[ 1 ];
+	hash_value_c = digest_context->hash_values[ 2 ];
+	hash_value_d = digest_context->hash_values[ 3 ];
+
+	for( round_index = 0;
+	     round_index < 64;
+	     round_index++ )
+	{
+		if( round_index < 16 )
+		{
+			round_value = ( hash_value_b & hash_value_c ) | ( ~hash_value_b & hash_value_d );
+			value_index = round_index;
+		}
+		else if( round_index < 32 )
+		{
+			round_value = ( hash_value_d & hash_value_b ) | ( ~hash_value_d & hash_value_c );
+			value_index = ( ( 5 * round_index ) + 1 ) % 16;
+		}
+		else if( round_index < 48 )
+		{
+			round_value = hash_value_b ^ hash_value_c ^ hash_value_d;
+			value_index = ( ( 3 * round_index ) + 5 ) % 16;
+		}
+		else
+		{
+			round_value = hash_value_c ^ ( hash_value_b | ~hash_value_d );
+			value_index = ( 7 * round_index ) % 16;
+		}
+		value_32bit  = hash_value_a
+		             + round_value
+		             + digest_context_md5_constants[ round_index ]
+		             + values_32bit[ value_index ];
+
+		hash_value_a = hash_value_d;
+		hash_value_d = hash_value_c;
+		hash_value_c = hash_value_b;
+		hash_value_b = hash_value_b
+		             + digest_context_rotate_left_32bit(
+		                value_32bit,
+		                digest_context_md5_rotations[ round_index ] );
+	}
+	digest_context->hash_values[ 0 ] += hash_value_a;
+	digest_context->hash_values[ 1 ] += hash_value_b;
+	digest_context->hash_values[ 2 ] += hash_value_c;
+	digest_context->hash_values[ 3 ] += hash_value_d;
+}
+
+/* Calculates the SHA1 hash values of a block
+ */
+void digest_context_sha1_transform(
+      digest_context_t *digest_context,
+      const uint8_t *block )
+{
+	uint32_t values_32bit[ 80 ];
+
+	uint32_t hash_values[ 5 ];
+
+	uint32_t round_constant = 0;
+	uint32_t round_value    = 0;
+	uint32_t value_32bit    = 0;
+	int round_index         = 0;
+	int value_index         = 0;
+
+	for( value_index = 0;
+	     value_index < 16;
+	     value_index++ )
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 &( block[ value_index * 4 ] ),
+		 values_32bit[ value_index ] );
+	}
+	for( value_index = 16;
+	     value_index < 80;
+	     value_index++ )
+	{
+		value_32bit = values_32bit[ value_index - 3 ]
+		            ^ values_32bit[ value_index - 8 ]
+		            ^ values_32bit[ value_index - 14 ]
+		            ^ values_32bit[ value_index - 16 ];
+
+		values_32bit[ value_index ] = digest_context_rotate_left_32bit(
+		                               value_32bit,
+		                               1 );
+	}
+	for( value_index = 0;
+	     value_index < 5;
+	     value_index++ )
+	{
+		hash_values[ value_index ] = digest_context->hash_values[ value_index ];
+	}
+	for( round_index = 0;
+	     round_index < 80;
+	     round_index++ )
+	{
+		if( round_index < 20 )
+		{
+			round_value    = ( hash_values[ 1 ] & hash_values[ 2 ] ) | ( ~hash_values[ 1 ] & hash_values[ 3 ] );
+			round_constant = 0x5a827999UL;
+		}
+		else if( round_index < 40 )
+		{
+			round_value    = hash_values[ 1 ] ^ hash_values[ 2 ] ^ hash_values[ 3 ];
+			round_constant = 0x6ed9eba1UL;
+		}
+		else if( round_index < 60 )
+		{
+			round_value    = ( hash_values[ 1 ] & hash_values[ 2 ] ) | ( hash_values[ 1 ] & hash_values[ 3 ] ) | ( hash_values[ 2 ] & hash_values[ 3 ] );
+			round_constant = 0x8f1bbcdcUL;
+		}
+		else
+		{
+			round_value    = hash_values[ 1 ] ^ hash_values[ 2 ] ^ hash_values[ 3 ];
+			round_constant = 0xca62c1d6UL;
+		}
+		value_32bit = digest_context_rotate_left_32bit(
+		               hash_values[ 0 ],
+		               5 )
+		            + round_value
+		            + hash_values[ 4 ]
+		            + round_constant
+		            + values_32bit[ round_index ];
+
+		hash_values[ 4 ] = hash_values[ 3 ];
+		hash_values[ 3 ] = hash_values[ 2 ];
+		hash_values[ 2 ] = digest_context_rotate_left_32bit(
+		                    hash_values[ 1 ],
+		                    30 );
+		hash_values[ 1 ] = hash_values[ 0 ];
+		hash_values[ 0 ] = value_32bit;
+	}
+	for( value_index = 0;
+	     value_index < 5;
+	     value_index++ )
+	{
+		digest_context->hash_values[ value_index ] += hash_values[ value_index ];
+	}
+}
+
+/* Calculates the SHA256 hash values of a block
+ */
+void digest_context_sha256_transform(
+      digest_context_t *digest_context,
+      const uint8_t *block )
+{
+	uint32_t values_32bit[ 64 ];
+
+	uint32_t hash_values[ 8 ];
+
+	uint32_t sigma0     = 0;
+	uint32_t sigma1     = 0;
+	uint32_t value1     = 0;
+	uint32_t value2     = 0;
+	int round_index     = 0;
+	int value_index     = 0;
+
+	for( value_index = 0;
+	     value_index < 16;
+	     value_index++ )
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 &( block[ value_index * 4 ] ),
+		 values_32bit[ value_index ] );
+	}
+	for( value_index = 16;
+	     value_index < 64;
+	     value_index++ )
+	{
+		sigma0 = digest_context_rotate_right_32bit( values_32bit[ value_index - 15 ], 7 )
+		       ^ digest_context_rotate_right_32bit( values_32bit[ value_index - 15 ], 18 )
+		       ^ ( values_32bit[ value_index - 15 ] >> 3 );
+
+		sigma1 = digest_context_rotate_right_32bit( values_32bit[ value_index - 2 ], 17 )
+		       ^ digest_context_rotate_right_32bit( values_32bit[ value_index - 2 ], 19 )
+		       ^ ( values_32bit[ value_index - 2 ] >> 10 );
+
+		values_32bit[ value_index ] = values_32bit[ value_index - 16 ]
+		                            + sigma0
+		                            + values_32bit[ value_index - 7 ]
+		                            + sigma1;
+	}
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		hash_values[ value_index ] = digest_context->hash_values[ value_index ];
+	}
+	for( round_index = 0;
+	     round_index < 64;
+	     round_index++ )
+	{
+		sigma1 = digest_context_rotate_right_32bit( hash_values[ 4 ], 6 )
+		       ^ digest_context_rotate_right_32bit( hash_values[ 4 ], 11 )
+		       ^ digest_context_rotate_right_32bit( hash_values[ 4 ], 25 );
+
+		value1 = hash_values[ 7 ]
+		       + sigma1
+		       + ( ( hash_values[ 4 ] & hash_values[ 5 ] ) ^ ( ~hash_values[ 4 ] & hash_values[ 6 ] ) )
+		       + digest_context_sha256_constants[ round_index ]
+		       + values_32bit[ round_index ];
+
+		sigma0 = digest_context_rotate_right_32bit( hash_values[ 0 ], 2 )
+		       ^ digest_context_rotate_right_32bit( hash_values[ 0 ], 13 )
+		       ^ digest_context_rotate_right_32bit( hash_values[ 0 ], 22 );
+
+		value2 = sigma0
+		       + ( ( hash_values[ 0 ] & hash_values[ 1 ] ) ^ ( hash_values[ 0 ] & hash_values[ 2 ] ) ^ ( hash_values[ 1 ] & hash_values[ 2 ] ) );
+
+		hash_values[ 7 ] = hash_values[ 6 ];
+		hash_values[ 6 ] = hash_values[ 5 ];
+		hash_values[ 5 ] = hash_values[ 4 ];
+		hash_values[ 4 ] = hash_values[ 3 ] + value1;
+		hash_values[ 3 ] = hash_values[ 2 ];
+		hash_values[ 2 ] = hash_values[ 1 ];
+		hash_values[ 1 ] = hash_values[ 0 ];
+		hash_values[ 0 ] = value1 + value2;
+	}
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		digest_context->hash_values[ value_index ] += hash_values[ value_index ];
+	}
+}
+
+/* Calculates the hash values of a block
+ */
+void digest_context_transform(
+      digest_context_t *digest_context,
+      const uint8_t *block )
+{
+	switch( digest_context->type )
+	{
+		case DIGEST_CONTEXT_TYPE_MD5:
+			digest_context_md5_transform(
+			 digest_context,
+			 block );
+			break;
+
+		case DIGEST_CONTEXT_TYPE_SHA1:
+			digest_context_sha1_transform(
+			 digest_context,
+			 block );
+			break;
+
+		case DIGEST_CONTEXT_TYPE_SHA256:
+			digest_context_sha256_transform(
+			 digest_context,
+			 block );
+			break;
+	}
+}
+
+/* Updates the digest context
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_update(
+     digest_context_t *digest_context,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_context_update";
+	size_t buffer_offset  = 0;
+	size_t copy_size      = 0;
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	digest_context->hash_count += size;
+
+	if( digest_context->block_offset > 0 )
+	{
+		copy_size = DIGEST_CONTEXT_BLOCK_SIZE - digest_context->block_offset;
+
+		if( copy_size > size )
+		{
+			copy_size = size;
+		}
+		if( memory_copy(
+		     &( digest_context->block[ digest_context->block_offset ] ),
+		     buffer,
+		     copy_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to block.",
+			 function );
+
+			return( -1 );
+		}
+		digest_context->block_offset += copy_size;
+		buffer_offset                += copy_size;
+
+		if( digest_context->block_offset < DIGEST_CONTEXT_BLOCK_SIZE )
+		{
+			return( 1 );
+		}
+		digest_context_transform(
+		 digest_context,
+		 digest_context->block );
+
+		digest_context->block_offset = 0;
+	}
+	while( ( size - buffer_offset ) >= DIGEST_CONTEXT_BLOCK_SIZE )
+	{
+		digest_context_transform(
+		 digest_context,
+		 &( buffer[ buffer_offset ] ) );
+
+		buffer_offset += DIGEST_CONTEXT_BLOCK_SIZE;
+	}
+	if( buffer_offset < size )
+	{
+		copy_size = size - buffer_offset;
+
+		if( memory_copy(
+		     digest_context->block,
+		     &( buffer[ buffer_offset ] ),
+		     copy_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to block.",
+			 function );
+
+			return( -1 );
+		}
+		digest_context->block_offset = copy_size;
+	}
+	return( 1 );
+}
+
+/* Finalizes the digest context
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_finalize(
+     digest_context_t *digest_context,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error )
+{
+	static char *function        = "digest_context_finalize";
+	size_t required_hash_size    = 0;
+	uint64_t number_of_bits      = 0;
+	int number_of_hash_values    = 0;
+	int value_index              = 0;
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash.",
+		 function );
+
+		return( -1 );
+	}
+	switch( digest_context->type )
+	{
+		case DIGEST_CONTEXT_TYPE_MD5:
+			required_hash_size = DIGEST_CONTEXT_MD5_HASH_SIZE;
+			break;
+
+		case DIGEST_CONTEXT_TYPE_SHA1:
+			required_hash_size = DIGEST_CONTEXT_SHA1_HASH_SIZE;
+			break;
+
+		case DIGEST_CONTEXT_TYPE_SHA256:
+			required_hash_size = DIGEST_CONTEXT_SHA256_HASH_SIZE;
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: invalid digest context - unsupported type.",
+			 function );
+
+			return( -1 );
+	}
+	if( hash_size < required_hash_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid hash size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_bits = digest_context->hash_count * 8;
+
+	/* Pad the data with a 1-bit and zero bytes up to the 64-bit data size
+	 */
+	digest_context->block[ digest_context->block_offset++ ] = 0x80;
+
+	if( digest_context->block_offset > ( DIGEST_CONTEXT_BLOCK_SIZE - 8 ) )
+	{
+		if( memory_set(
+		     &( digest_context->block[ digest_context->block_offset ] ),
+		     0,
+		     DIGEST_CONTEXT_BLOCK_SIZE - digest_context->block_offset ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear block.",
+			 function );
+
+			return( -1 );
+		}
+		digest_context_transform(
+		 digest_context,
+		 digest_context->block );
+
+		digest_context->block_offset = 0;
+	}
+	if( memory_set(
+	     &( digest_context->block[ digest_context->block_offset ] ),
+	     0,
+	     DIGEST_CONTEXT_BLOCK_SIZE - 8 - digest_context->block_offset ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block.",
+		 function );
+
+		return( -1 );
+	}
+	/* MD5 stores the data size in little-endian and SHA in big-endian
+	 */
+	if( digest_context->type == DIGEST_CONTEXT_TYPE_MD5 )
+	{
+		byte_stream_copy_from_uint64_little_endian(
+		 &( digest_context->block[ DIGEST_CONTEXT_BLOCK_SIZE - 8 ] ),
+		 number_of_bits );
+	}
+	else
+	{
+		byte_stream_copy_from_uint64_big_endian(
+		 &( digest_context->block[ DIGEST_CONTEXT_BLOCK_SIZE - 8 ] ),
+		 number_of_bits );
+	}
+	digest_context_transform(
+	 digest_context,
+	 digest_context->block );
+
+	digest_context->block_offset = 0;
+
+	number_of_hash_values = (int) ( required_hash_size / 4 );
+
+	for( value_index = 0;
+	     value_index < number_of_hash_values;
+	     value_index++ )
+	{
+		if( digest_context->type == DIGEST_CONTEXT_TYPE_MD5 )
+		{
+			byte_stream_copy_from_uint32_little_endian(
+			 &( hash[ value_index * 4 ] ),
+			 digest_context->hash_values[ value_index ] );
+		}
+		else
+		{
+			byte_stream_copy_from_uint32_big_endian(
+			 &( hash[ value_index * 4 ] ),
+			 digest_context->hash_values[ value_index ] );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the state of the digest context
+ * The state contains the type, the number of bytes hashed, the hash values
+ * and the data of the incomplete block, all stored in little-endian
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_get_state(
+     digest_context_t *digest_context,
+     uint8_t *state,
+     size_t state_size,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_context_get_state";
+	int value_index       = 0;
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid state.",
+		 function );
+
+		return( -1 );
+	}
+	if( state_size < DIGEST_CONTEXT_STATE_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid state size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     state,
+	     0,
+	     DIGEST_CONTEXT_STATE_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear state.",
+		 function );
+
+		return( -1 );
+	}
+	state[ 0 ] = digest_context->type;
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( state[ 8 ] ),
+	 digest_context->hash_count );
+
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 &( state[ 16 + ( value_index * 4 ) ] ),
+		 digest_context->hash_values[ value_index ] );
+	}
+	if( memory_copy(
+	     &( state[ 48 ] ),
+	     digest_context->block,
+	     digest_context->block_offset ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy block data to state.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the state of the digest context
+ * The state must have been retrieved from a digest context of the same type
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_set_state(
+     digest_context_t *digest_context,
+     const uint8_t *state,
+     size_t state_size,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_context_set_state";
+	uint64_t hash_count   = 0;
+	int value_index       = 0;
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid state.",
+		 function );
+
+		return( -1 );
+	}
+	if( state_size < DIGEST_CONTEXT_STATE_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid state size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( state[ 0 ] != digest_context->type )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported state type: %" PRIu8 ".",
+		 function,
+		 state[ 0 ] );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 &( state[ 8 ] ),
+	 hash_count );
+
+	digest_context->hash_count   = hash_count;
+	digest_context->block_offset = (size_t) ( hash_count % DIGEST_CONTEXT_BLOCK_SIZE );
+
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( state[ 16 + ( value_index * 4 ) ] ),
+		 digest_context->hash_values[ value_index ] );
+	}
+	if( memory_copy(
+	     digest_context->block,
+	     &( state[ 48 ] ),
+	     DIGEST_CONTEXT_BLOCK_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy block data from state.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
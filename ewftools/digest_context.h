@@ -0,0 +1,130 @@
+/*
+ * Digest context with a state that can be stored and restored
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _DIGEST_CONTEXT_H )
+#define _DIGEST_CONTEXT_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of a stored digest context state
+ */
+#define DIGEST_CONTEXT_STATE_SIZE		112
+
+#define DIGEST_CONTEXT_BLOCK_SIZE		64
+
+#define DIGEST_CONTEXT_MD5_HASH_SIZE		16
+#define DIGEST_CONTEXT_SHA1_HASH_SIZE		20
+#define DIGEST_CONTEXT_SHA256_HASH_SIZE		32
+
+enum DIGEST_CONTEXT_TYPES
+{
+	DIGEST_CONTEXT_TYPE_MD5			= 1,
+	DIGEST_CONTEXT_TYPE_SHA1		= 2,
+	DIGEST_CONTEXT_TYPE_SHA256		= 3
+};
+
+typedef struct digest_context digest_context_t;
+
+struct digest_context
+{
+	/* The type
+	 */
+	uint8_t type;
+
+	/* The hash values
+	 */
+	uint32_t hash_values[ 8 ];
+
+	/* The number of bytes hashed
+	 */
+	uint64_t hash_count;
+
+	/* The block data
+	 */
+	uint8_t block[ DIGEST_CONTEXT_BLOCK_SIZE ];
+
+	/* The block offset
+	 */
+	size_t block_offset;
+};
+
+int digest_context_initialize(
+     digest_context_t **digest_context,
+     uint8_t type,
+     libcerror_error_t **error );
+
+int digest_context_free(
+     digest_context_t **digest_context,
+     libcerror_error_t **error );
+
+void digest_context_md5_transform(
+      digest_context_t *digest_context,
+      const uint8_t *block );
+
+void digest_context_sha1_transform(
+      digest_context_t *digest_context,
+      const uint8_t *block );
+
+void digest_context_sha256_transform(
+      digest_context_t *digest_context,
+      const uint8_t *block );
+
+void digest_context_transform(
+      digest_context_t *digest_context,
+      const uint8_t *block );
+
+int digest_context_update(
+     digest_context_t *digest_context,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int digest_context_finalize(
+     digest_context_t *digest_context,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error );
+
+int digest_context_get_state(
+     digest_context_t *digest_context,
+     uint8_t *state,
+     size_t state_size,
+     libcerror_error_t **error );
+
+int digest_context_set_state(
+     digest_context_t *digest_context,
+     const uint8_t *state,
+     size_t state_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _DIGEST_CONTEXT_H ) */
+
@@ -0,0 +1,993 @@
+/*
+ * Digest hash thread
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "digest_hash_thread.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_unused.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The digest hash thread start function
+ * Updates the digest hash with the buffer of the current update until asked to exit
+ * On failure the state is set to error so that waiting threads do not block
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_thread_start_function(
+     digest_hash_thread_t *digest_hash_thread )
+{
+	int mutex_grabbed = 0;
+
+	if( digest_hash_thread == NULL )
+	{
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     digest_hash_thread->state_mutex,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	mutex_grabbed = 1;
+
+	while( digest_hash_thread->state != DIGEST_HASH_THREAD_STATE_EXIT )
+	{
+		if( digest_hash_thread->state != DIGEST_HASH_THREAD_STATE_UPDATE )
+		{
+			if( libcthreads_condition_wait(
+			     digest_hash_thread->state_condition,
+			     digest_hash_thread->state_mutex,
+			     NULL ) != 1 )
+			{
+				goto on_error;
+			}
+			continue;
+		}
+		/* The buffer is not modified by the owner until the update has been waited for
+		 * so the mutex does not need to be held while calculating the digest hash
+		 */
+		if( libcthreads_mutex_release(
+		     digest_hash_thread->state_mutex,
+		     NULL ) != 1 )
+		{
+			goto on_error;
+		}
+		mutex_grabbed = 0;
+
+		digest_hash_thread->result = digest_hash_thread->update_function(
+		                              digest_hash_thread->context,
+		                              digest_hash_thread->buffer,
+		                              digest_hash_thread->buffer_size,
+		                              NULL );
+
+		if( libcthreads_mutex_grab(
+		     digest_hash_thread->state_mutex,
+		     NULL ) != 1 )
+		{
+			goto on_error;
+		}
+		mutex_grabbed = 1;
+
+		if( digest_hash_thread->state == DIGEST_HASH_THREAD_STATE_UPDATE )
+		{
+			digest_hash_thread->state = DIGEST_HASH_THREAD_STATE_IDLE;
+		}
+		if( libcthreads_condition_broadcast(
+		     digest_hash_thread->state_condition,
+		     NULL ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     digest_hash_thread->state_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	/* No more updates are done by this thread, the error state makes
+	 * waiting for and starting an update fail instead of block
+	 */
+	digest_hash_thread->state = DIGEST_HASH_THREAD_STATE_ERROR;
+
+	libcthreads_condition_broadcast(
+	 digest_hash_thread->state_condition,
+	 NULL );
+
+	if( mutex_grabbed != 0 )
+	{
+		libcthreads_mutex_release(
+		 digest_hash_thread->state_mutex,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Creates a digest hash thread
+ * Make sure the value digest_hash_thread is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_thread_initialize(
+     digest_hash_thread_t **digest_hash_thread,
+     intptr_t *context,
+     int (*update_function)(
+            intptr_t *context,
+            const uint8_t *buffer,
+            size_t size,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_thread_initialize";
+
+	if( digest_hash_thread == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash thread.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_hash_thread != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid digest hash thread value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( update_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid update function.",
+		 function );
+
+		return( -1 );
+	}
+	*digest_hash_thread = memory_allocate_structure(
+	                       digest_hash_thread_t );
+
+	if( *digest_hash_thread == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create digest hash thread.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *digest_hash_thread,
+	     0,
+	     sizeof( digest_hash_thread_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear digest hash thread.",
+		 function );
+
+		memory_free(
+		 *digest_hash_thread );
+
+		*digest_hash_thread = NULL;
+
+		return( -1 );
+	}
+	( *digest_hash_thread )->context         = context;
+	( *digest_hash_thread )->update_function = update_function;
+	( *digest_hash_thread )->state           = DIGEST_HASH_THREAD_STATE_IDLE;
+	( *digest_hash_thread )->result          = 1;
+
+	if( libcthreads_mutex_initialize(
+	     &( ( *digest_hash_thread )->state_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create state mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *digest_hash_thread )->state_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create state condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_create(
+	     &( ( *digest_hash_thread )->thread ),
+	     NULL,
+	     (int (*)(void *)) &digest_hash_thread_start_function,
+	     (void *) *digest_hash_thread,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *digest_hash_thread != NULL )
+	{
+		if( ( *digest_hash_thread )->state_condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *digest_hash_thread )->state_condition ),
+			 NULL );
+		}
+		if( ( *digest_hash_thread )->state_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *digest_hash_thread )->state_mutex ),
+			 NULL );
+		}
+		memory_free(
+		 *digest_hash_thread );
+
+		*digest_hash_thread = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a digest hash thread
+ * Waits for the current update to finish and stops the thread
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_thread_free(
+     digest_hash_thread_t **digest_hash_thread,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_thread_free";
+	int result            = 1;
+
+	if( digest_hash_thread == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash thread.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_hash_thread != NULL )
+	{
+		if( digest_hash_thread_wait_update(
+		     *digest_hash_thread,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for update.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_grab(
+		     ( *digest_hash_thread )->state_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab state mutex.",
+			 function );
+
+			return( -1 );
+		}
+		( *digest_hash_thread )->state = DIGEST_HASH_THREAD_STATE_EXIT;
+
+		if( libcthreads_condition_broadcast(
+		     ( *digest_hash_thread )->state_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast state condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_release(
+		     ( *digest_hash_thread )->state_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release state mutex.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcthreads_thread_join(
+		     &( ( *digest_hash_thread )->thread ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_condition_free(
+		     &( ( *digest_hash_thread )->state_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free state condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *digest_hash_thread )->state_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free state mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *digest_hash_thread );
+
+		*digest_hash_thread = NULL;
+	}
+	return( result );
+}
+
+/* Starts updating the digest hash with the buffer
+ * The buffer must not be modified or freed until the update has been waited for
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_thread_start_update(
+     digest_hash_thread_t *digest_hash_thread,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_thread_start_update";
+	int result            = 1;
+
+	if( digest_hash_thread == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash thread.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     digest_hash_thread->state_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab state mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_hash_thread->state == DIGEST_HASH_THREAD_STATE_ERROR )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: invalid digest hash thread - thread stopped on error.",
+		 function );
+
+		result = -1;
+	}
+	else if( digest_hash_thread->state != DIGEST_HASH_THREAD_STATE_IDLE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid digest hash thread - state value out of bounds.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		digest_hash_thread->buffer      = buffer;
+		digest_hash_thread->buffer_size = buffer_size;
+		digest_hash_thread->state       = DIGEST_HASH_THREAD_STATE_UPDATE;
+
+		if( libcthreads_condition_broadcast(
+		     digest_hash_thread->state_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast state condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     digest_hash_thread->state_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release state mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Waits for the current update of the digest hash to finish
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_thread_wait_update(
+     digest_hash_thread_t *digest_hash_thread,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_thread_wait_update";
+	int result            = 1;
+
+	if( digest_hash_thread == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash thread.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     digest_hash_thread->state_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab state mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( digest_hash_thread->state == DIGEST_HASH_THREAD_STATE_UPDATE )
+	{
+		if( libcthreads_condition_wait(
+		     digest_hash_thread->state_condition,
+		     digest_hash_thread->state_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for state condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( ( result == 1 )
+	 && ( digest_hash_thread->state == DIGEST_HASH_THREAD_STATE_ERROR ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: invalid digest hash thread - thread stopped on error.",
+		 function );
+
+		result = -1;
+	}
+	else if( ( result == 1 )
+	      && ( digest_hash_thread->result != 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update digest hash.",
+		 function );
+
+		/* Only report a failed update once
+		 */
+		digest_hash_thread->result = 1;
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     digest_hash_thread->state_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release state mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Creates the digest hash threads of the additional digest hashes
+ * The first digest hash is calculated by the calling thread
+ * every additional digest hash is calculated by its own thread
+ * A context that is NULL represents a digest hash that is not calculated
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_thread_initialize_additional(
+     digest_hash_thread_t **sha1_hash_thread,
+     digest_hash_thread_t **sha256_hash_thread,
+     intptr_t *md5_context,
+     intptr_t *sha1_context,
+     int (*sha1_update_function)(
+            intptr_t *context,
+            const uint8_t *buffer,
+            size_t size,
+            libcerror_error_t **error ),
+     intptr_t *sha256_context,
+     int (*sha256_update_function)(
+            intptr_t *context,
+            const uint8_t *buffer,
+            size_t size,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_thread_initialize_additional";
+
+	if( sha1_hash_thread == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid SHA1 digest hash thread.",
+		 function );
+
+		return( -1 );
+	}
+	if( sha256_hash_thread == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid SHA256 digest hash thread.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( md5_context != NULL )
+	 && ( sha1_context != NULL ) )
+	{
+		if( digest_hash_thread_initialize(
+		     sha1_hash_thread,
+		     sha1_context,
+		     sha1_update_function,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA1 digest hash thread.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( ( md5_context != NULL )
+	  || ( sha1_context != NULL ) )
+	 && ( sha256_context != NULL ) )
+	{
+		if( digest_hash_thread_initialize(
+		     sha256_hash_thread,
+		     sha256_context,
+		     sha256_update_function,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA256 digest hash thread.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *sha1_hash_thread != NULL )
+	{
+		digest_hash_thread_free(
+		 sha1_hash_thread,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees the digest hash threads of the additional digest hashes
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_thread_free_additional(
+     digest_hash_thread_t **sha1_hash_thread,
+     digest_hash_thread_t **sha256_hash_thread,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_thread_free_additional";
+	int result            = 1;
+
+	if( sha1_hash_thread == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid SHA1 digest hash thread.",
+		 function );
+
+		return( -1 );
+	}
+	if( sha256_hash_thread == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid SHA256 digest hash thread.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sha1_hash_thread != NULL )
+	{
+		if( digest_hash_thread_free(
+		     sha1_hash_thread,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free SHA1 digest hash thread.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( *sha256_hash_thread != NULL )
+	{
+		if( digest_hash_thread_free(
+		     sha256_hash_thread,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free SHA256 digest hash thread.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Updates the digest hashes with the buffer
+ * The digest hashes that have a digest hash thread are updated by their thread
+ * while the other digest hashes are updated by the calling thread
+ * A context that is NULL represents a digest hash that is not calculated
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_thread_update_digest_hashes(
+     digest_hash_thread_t *sha1_hash_thread,
+     digest_hash_thread_t *sha256_hash_thread,
+     intptr_t *md5_context,
+     int (*md5_update_function)(
+            intptr_t *context,
+            const uint8_t *buffer,
+            size_t size,
+            libcerror_error_t **error ),
+     intptr_t *sha1_context,
+     int (*sha1_update_function)(
+            intptr_t *context,
+            const uint8_t *buffer,
+            size_t size,
+            libcerror_error_t **error ),
+     intptr_t *sha256_context,
+     int (*sha256_update_function)(
+            intptr_t *context,
+            const uint8_t *buffer,
+            size_t size,
+            libcerror_error_t **error ),
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_thread_update_digest_hashes";
+
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	EWFTOOLS_UNREFERENCED_PARAMETER( sha1_hash_thread )
+	EWFTOOLS_UNREFERENCED_PARAMETER( sha256_hash_thread )
+#endif
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( sha1_hash_thread != NULL )
+	{
+		if( digest_hash_thread_start_update(
+		     sha1_hash_thread,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to start update of SHA1 digest hash.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( sha256_hash_thread != NULL )
+	{
+		if( digest_hash_thread_start_update(
+		     sha256_hash_thread,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to start update of SHA256 digest hash.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	if( md5_context != NULL )
+	{
+		if( md5_update_function(
+		     md5_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update MD5 digest hash.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( sha1_hash_thread != NULL )
+	{
+		if( digest_hash_thread_wait_update(
+		     sha1_hash_thread,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA1 digest hash.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+#endif
+	if( sha1_context != NULL )
+	{
+		if( sha1_update_function(
+		     sha1_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA1 digest hash.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( sha256_hash_thread != NULL )
+	{
+		if( digest_hash_thread_wait_update(
+		     sha256_hash_thread,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 digest hash.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+#endif
+	if( sha256_context != NULL )
+	{
+		if( sha256_update_function(
+		     sha256_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 digest hash.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* Make sure the digest hash threads are no longer using the buffer
+	 */
+	if( sha1_hash_thread != NULL )
+	{
+		digest_hash_thread_wait_update(
+		 sha1_hash_thread,
+		 NULL );
+	}
+	if( sha256_hash_thread != NULL )
+	{
+		digest_hash_thread_wait_update(
+		 sha256_hash_thread,
+		 NULL );
+	}
+#endif
+	return( -1 );
+}
+
@@ -0,0 +1,172 @@
+/*
+ * Digest hash thread
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _DIGEST_HASH_THREAD_H )
+#define _DIGEST_HASH_THREAD_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct digest_hash_thread digest_hash_thread_t;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+enum DIGEST_HASH_THREAD_STATES
+{
+	DIGEST_HASH_THREAD_STATE_IDLE		= 0,
+	DIGEST_HASH_THREAD_STATE_UPDATE		= 1,
+	DIGEST_HASH_THREAD_STATE_EXIT		= 2,
+	DIGEST_HASH_THREAD_STATE_ERROR		= 3
+};
+
+struct digest_hash_thread
+{
+	/* The digest hash context
+	 */
+	intptr_t *context;
+
+	/* The digest hash update function
+	 */
+	int (*update_function)(
+	       intptr_t *context,
+	       const uint8_t *buffer,
+	       size_t size,
+	       libcerror_error_t **error );
+
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+
+	/* The state mutex
+	 */
+	libcthreads_mutex_t *state_mutex;
+
+	/* The state condition
+	 */
+	libcthreads_condition_t *state_condition;
+
+	/* The state
+	 */
+	int state;
+
+	/* The buffer of the current update
+	 */
+	const uint8_t *buffer;
+
+	/* The buffer size of the current update
+	 */
+	size_t buffer_size;
+
+	/* The result of the last update
+	 */
+	int result;
+};
+
+int digest_hash_thread_start_function(
+     digest_hash_thread_t *digest_hash_thread );
+
+int digest_hash_thread_initialize(
+     digest_hash_thread_t **digest_hash_thread,
+     intptr_t *context,
+     int (*update_function)(
+            intptr_t *context,
+            const uint8_t *buffer,
+            size_t size,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+int digest_hash_thread_free(
+     digest_hash_thread_t **digest_hash_thread,
+     libcerror_error_t **error );
+
+int digest_hash_thread_start_update(
+     digest_hash_thread_t *digest_hash_thread,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int digest_hash_thread_wait_update(
+     digest_hash_thread_t *digest_hash_thread,
+     libcerror_error_t **error );
+
+int digest_hash_thread_initialize_additional(
+     digest_hash_thread_t **sha1_hash_thread,
+     digest_hash_thread_t **sha256_hash_thread,
+     intptr_t *md5_context,
+     intptr_t *sha1_context,
+     int (*sha1_update_function)(
+            intptr_t *context,
+            const uint8_t *buffer,
+            size_t size,
+            libcerror_error_t **error ),
+     intptr_t *sha256_context,
+     int (*sha256_update_function)(
+            intptr_t *context,
+            const uint8_t *buffer,
+            size_t size,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+int digest_hash_thread_free_additional(
+     digest_hash_thread_t **sha1_hash_thread,
+     digest_hash_thread_t **sha256_hash_thread,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+int digest_hash_thread_update_digest_hashes(
+     digest_hash_thread_t *sha1_hash_thread,
+     digest_hash_thread_t *sha256_hash_thread,
+     intptr_t *md5_context,
+     int (*md5_update_function)(
+            intptr_t *context,
+            const uint8_t *buffer,
+            size_t size,
+            libcerror_error_t **error ),
+     intptr_t *sha1_context,
+     int (*sha1_update_function)(
+            intptr_t *context,
+            const uint8_t *buffer,
+            size_t size,
+            libcerror_error_t **error ),
+     intptr_t *sha256_context,
+     int (*sha256_update_function)(
+            intptr_t *context,
+            const uint8_t *buffer,
+            size_t size,
+            libcerror_error_t **error ),
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _DIGEST_HASH_THREAD_H ) */
+
@@ -32,6 +32,7 @@
 
 #include "byte_size_string.h"
 #include "device_handle.h"
+#include "device_reader.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
 #include "ewftools_getopt.h"
@@ -46,8 +47,10 @@
 #include "imaging_handle.h"
 #include "log_handle.h"
 #include "process_status.h"
+#include "rescue_handle.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "storage_media_buffer_reorder.h"
 
 #if defined( __BORLANDC__ ) && ( __BORLANDC__ < 0x0560 )
 #define EWFACQUIRE_2_TIB			0x20000000000UL
@@ -59,6 +62,7 @@
 
 device_handle_t *ewfacquire_device_handle   = NULL;
 imaging_handle_t *ewfacquire_imaging_handle = NULL;
+rescue_handle_t *ewfacquire_rescue_handle   = NULL;
 int ewfacquire_abort                        = 0;
 
 /* Prints the executable usage information to the stream
@@ -118,10 +122,15 @@ void ewfacquire_usage_fprint(
 	                 "                  [ -B number_of_bytes ] [ -c compression_values ]\n"
 	                 "                  [ -C case_number ] [ -d digest_type ] [ -D description ]\n"
 	                 "                  [ -e examiner_name ] [ -E evidence_number ] [ -f format ]\n"
-	                 "                  [ -g number_of_sectors ] [ -j jobs ] [ -l log_filename ]\n"
-	                 "                  [ -m media_type ] [ -M media_flags ] [ -N notes ]\n"
-	                 "                  [ -o offset ] [ -p process_buffer_size ]\n"
-	                 "                  [ -P bytes_per_sector ] [ -r read_error_retries ]\n"
+	                 "                  [ -g number_of_sectors ] [ -I rescue_image ] [ -j jobs ]\n"
+	                 "                  [ -J telemetry_file ] [ -k number_of_chunks ]\n"
+	                 "                  [ -l log_filename ]\n"
+	                 "                  [ -L memory_limit ] [ -m media_type ]\n"
+	                 "                  [ -M media_flags ] [ -N notes ]\n"
+	                 "                  [ -o offset ] [ -O additional_target ]\n"
+	                 "                  [ -p process_buffer_size ]\n"
+	                 "                  [ -P bytes_per_sector ] [ -Q read_queue_depth ]\n"
+	                 "                  [ -r read_error_retries ]\n"
 	                 "                  [ -S segment_file_size ] [ -t target ] [ -T toc_file ]\n"
 	                 "                  [ -2 secondary_target ] [ -hqRsuvVwx ] source\n\n" );
 
@@ -156,19 +165,55 @@ void ewfacquire_usage_fprint(
 	                 "\t        encase7, encase7-v2, linen5, linen6, linen7, ewfx\n" );
 	fprintf( stream, "\t-g      specify the number of sectors to be used as error granularity\n" );
 	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-I:     rescue a failing device into the rescue_image before it is\n"
+	                 "\t        acquired. The device is read in passes: first the readable\n"
+	                 "\t        areas, skipping ahead after a read error, next the areas around\n"
+	                 "\t        the read errors per error granularity and last the bad sectors\n"
+	                 "\t        are retried. The progress is kept in rescue_image.map so that\n"
+	                 "\t        an interrupted rescue can be continued\n" );
 	fprintf( stream, "\t-j:     the number of concurrent processing jobs (threads), where\n"
-	                 "\t        a number of 0 represents single-threaded mode (default is 4\n"
-	                 "\t        if multi-threaded mode is supported)\n" );
+	                 "\t        a number of 0 represents single-threaded mode and auto a\n"
+	                 "\t        thread per processor, where the number of active jobs is\n"
+	                 "\t        adjusted to the measured read, hash and write throughput\n"
+	                 "\t        (default is 4 if multi-threaded mode is supported)\n" );
+	fprintf( stream, "\t-J:     writes a JSON object per line with the throughput per stage\n"
+	                 "\t        (read, process, hash and write), the buffer queue depths, the\n"
+	                 "\t        worker utilization, the compression ratio and the number of read\n"
+	                 "\t        errors to the telemetry_file every second, which can be a FIFO\n" );
+	fprintf( stream, "\t-k:     specify the maximum number of chunks per chunks section, shorter\n"
+	                 "\t        chunks sections reduce the data that needs to be acquired again\n"
+	                 "\t        when the acquiry is interrupted and resumed, where a number\n"
+	                 "\t        of 0 represents the maximum of the format (default). Every\n"
+	                 "\t        chunks section a checkpoint with the state of the digest\n"
+	                 "\t        hashes is written to target.checkpoint, from which -R\n"
+	                 "\t        with the same -k continues without reading the written\n"
+	                 "\t        data again\n" );
 	fprintf( stream, "\t-l:     logs acquiry errors and the digest (hash) to the log_filename\n" );
+	fprintf( stream, "\t-L:     specify the maximum amount of memory used by the buffers\n"
+	                 "\t        of the concurrent processing jobs (default is 512 MiB or\n"
+	                 "\t        a quarter of the physical memory if less)\n" );
 	fprintf( stream, "\t-m:     specify the media type, options: fixed (default), removable,\n"
 	                 "\t        optical, memory\n" );
 	fprintf( stream, "\t-M:     specify the media flags, options: logical, physical (default)\n" );
 	fprintf( stream, "\t-N:     specify the notes (default is notes).\n" );
 	fprintf( stream, "\t-o:     specify the offset to start to acquire (default is 0)\n" );
+	fprintf( stream, "\t-O:     specify an additional target file (without extension), the\n"
+	                 "\t        segment files are distributed round-robin over the target and\n"
+	                 "\t        the additional targets, for example to spread them over multiple\n"
+	                 "\t        disks. Without compression the process jobs write the segment\n"
+	                 "\t        files concurrently, but only the chunks in the buffered window\n"
+	                 "\t        (-L), so use a segment size of at most -L divided by the number\n"
+	                 "\t        of targets. Reading and hashing remain sequential. Cannot be\n"
+	                 "\t        combined with -R. Can be specified up to %d times\n",
+	                 IMAGING_HANDLE_MAXIMUM_NUMBER_OF_ADDITIONAL_TARGETS );
 	fprintf( stream, "\t-p:     specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-P:     specify the number of bytes per sector (default is 512)\n"
 	                 "\t        (use this to override the automatic bytes per sector detection)\n" );
 	fprintf( stream, "\t-q:     quiet shows minimal status information\n" );
+	fprintf( stream, "\t-Q:     specify the number of reads of a device kept in flight using\n"
+	                 "\t        direct I/O, where a number of 0 represents sequential reads\n"
+	                 "\t        (default is 4 if multi-threaded mode is supported, maximum is\n"
+	                 "\t        64). Regions that fail are read again with the error retries\n" );
 	fprintf( stream, "\t-r:     specify the number of retries when a read error occurs (default\n"
 	                 "\t        is 2)\n" );
 	fprintf( stream, "\t-R:     resume acquiry at a safe point\n" );
@@ -206,7 +251,8 @@ void ewfacquire_usage_fprint(
 	fprintf( stream, "\t-x:     use the chunk data instead of the buffered read and write\n"
 	                 "\t        functions.\n" );
 	fprintf( stream, "\t-2:     specify the secondary target file (without extension) to write\n"
-	                 "\t        to\n" );
+	                 "\t        to, implies -x since the chunks are compressed once and\n"
+	                 "\t        written to both targets\n" );
 }
 
 /* Signal handler for ewfacquire
@@ -253,6 +299,24 @@ void ewfacquire_signal_handler(
 			 &error );
 		}
 	}
+#if defined( HAVE_RESCUE_HANDLE )
+	if( ewfacquire_rescue_handle != NULL )
+	{
+		if( rescue_handle_signal_abort(
+		     ewfacquire_rescue_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal rescue handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif
 	/* Force stdin to close otherwise any function reading it will remain blocked
 	 */
 #if defined( WINAPI ) && !defined( __CYGWIN__ )
@@ -568,11 +632,15 @@ int ewfacquire_determine_sessions(
 }
 
 /* Reads the input
+ * When multi-threaded a device is read ahead using the source filename
+ * When a rescue handle is provided the input is read from the rescue image
  * Returns 1 if successful or -1 on error
  */
 int ewfacquire_read_input(
      imaging_handle_t *imaging_handle,
      device_handle_t *device_handle,
+     rescue_handle_t *rescue_handle,
+     const system_character_t *source_filename,
      off64_t resume_acquiry_offset,
      uint8_t swap_byte_pairs,
      uint8_t print_status_information,
@@ -580,25 +648,30 @@ int ewfacquire_read_input(
      log_handle_t *log_handle,
      libcerror_error_t **error )
 {
+	device_reader_t *device_reader               = NULL;
 	storage_media_buffer_t *storage_media_buffer = NULL;
 	uint8_t *data                                = NULL;
 	static char *function                        = "ewfacquire_read_input";
+	off64_t read_ahead_offset                    = 0;
 	off64_t read_error_offset                    = 0;
 	off64_t storage_media_offset                 = 0;
-	size64_t acquiry_count                       = 0;
 	size64_t read_error_size                     = 0;
 	size64_t remaining_aquiry_size               = 0;
 	size_t data_size                             = 0;
 	size_t process_buffer_size                   = 0;
+	size_t read_ahead_size                       = 0;
 	size_t read_size                             = 0;
 	ssize_t read_count                           = 0;
 	ssize_t process_count                        = 0;
 	ssize_t write_count                          = 0;
+	uint64_t stage_timestamp                     = 0;
 	uint32_t chunk_size                          = 0;
 	uint8_t storage_media_buffer_mode            = 0;
 	int maximum_number_of_queued_items           = 0;
 	int number_of_read_errors                    = 0;
+	int number_of_reported_read_errors           = 0;
 	int read_error_iterator                      = 0;
+	int read_queue_depth                         = 0;
 	int status                                   = PROCESS_STATUS_COMPLETED;
 
 	if( imaging_handle == NULL )
@@ -729,9 +802,12 @@ int ewfacquire_read_input(
 
 			goto on_error;
 		}
+		/* The data before the checkpoint does not need to be read again
+		 * since the state of the digest hashes is restored from the checkpoint
+		 */
 		if( imaging_handle_seek_offset(
 		     imaging_handle,
-		     0,
+		     imaging_handle->checkpoint_resume_offset,
 		     error ) == -1 )
 		{
 			libcerror_error_set(
@@ -743,6 +819,8 @@ int ewfacquire_read_input(
 
 			goto on_error;
 		}
+		storage_media_offset                = imaging_handle->checkpoint_resume_offset;
+		imaging_handle->last_offset_written = imaging_handle->checkpoint_resume_offset;
 	}
 	if( imaging_handle_get_chunk_size(
 	     imaging_handle,
@@ -789,7 +867,22 @@ int ewfacquire_read_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 	if( imaging_handle->number_of_threads != 0 )
 	{
-		maximum_number_of_queued_items = 1 + ( ( 512 * 1024 * 1024 ) / process_buffer_size );
+		if( storage_media_buffer_queue_get_maximum_number_of_values(
+		     imaging_handle->memory_limit,
+		     process_buffer_size,
+		     imaging_handle->number_of_threads,
+		     &maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine maximum number of queued items.",
+			 function );
+
+			goto on_error;
+		}
 
 		if( libcthreads_thread_pool_create(
 		     &( imaging_handle->process_thread_pool ),
@@ -827,15 +920,17 @@ int ewfacquire_read_input(
 
 			goto on_error;
 		}
-		if( libcdata_list_initialize(
-		     &( imaging_handle->output_list ),
+		if( storage_media_buffer_reorder_initialize(
+		     &( imaging_handle->output_reorder ),
+		     maximum_number_of_queued_items,
+		     process_buffer_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create output list.",
+			 "%s: unable to create output reorder window.",
 			 function );
 
 			goto on_error;
@@ -857,6 +952,46 @@ int ewfacquire_read_input(
 
 			goto on_error;
 		}
+#if defined( HAVE_DEVICE_READER )
+		/* Keep multiple reads in flight against a device, a resumed acquiry
+		 * reads back the data already written and is read sequentially
+		 */
+		if( ( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
+		 && ( device_handle->read_queue_depth > 0 )
+		 && ( resume_acquiry_offset == 0 )
+		 && ( rescue_handle == NULL )
+		 && ( source_filename != NULL ) )
+		{
+			/* Leave buffers for the process and output threads
+			 */
+			read_queue_depth = device_handle->read_queue_depth;
+
+			if( read_queue_depth > ( maximum_number_of_queued_items / 2 ) )
+			{
+				read_queue_depth = maximum_number_of_queued_items / 2;
+			}
+			if( read_queue_depth > 0 )
+			{
+				if( device_reader_initialize(
+				     &device_reader,
+				     device_handle,
+				     source_filename,
+				     (off64_t) imaging_handle->acquiry_offset,
+				     read_queue_depth,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to initialize device reader.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+#endif /* defined( HAVE_DEVICE_READER ) */
 	}
 #endif
 	if( imaging_handle_initialize_integrity_hash(
@@ -890,6 +1025,35 @@ int ewfacquire_read_input(
 
 		goto on_error;
 	}
+	if( process_status_set_telemetry(
+	     imaging_handle->process_status,
+	     imaging_handle->telemetry_stream,
+	     imaging_handle->number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set process status telemetry.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_set_collect_stage_values(
+	     imaging_handle->process_status,
+	     imaging_handle->automatic_number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set process status collect stage values.",
+		 function );
+
+		goto on_error;
+	}
 	if( process_status_start(
 	     imaging_handle->process_status,
 	     error ) != 1 )
@@ -922,7 +1086,7 @@ int ewfacquire_read_input(
 			goto on_error;
 		}
 	}
-	remaining_aquiry_size = imaging_handle->acquiry_size;
+	remaining_aquiry_size = imaging_handle->acquiry_size - (size64_t) storage_media_offset;
 
 	while( remaining_aquiry_size > 0 )
 	{
@@ -931,8 +1095,28 @@ int ewfacquire_read_input(
 			break;
 		}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( imaging_handle->number_of_threads != 0 )
+		{
+			/* The device reader holds a buffer per outstanding read request
+			 */
+			if( imaging_handle_adjust_number_of_jobs(
+			     imaging_handle,
+			     read_queue_depth,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to adjust number of jobs.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		if( ( storage_media_buffer == NULL )
-		 && ( imaging_handle->number_of_threads != 0 ) )
+		 && ( imaging_handle->number_of_threads != 0 )
+		 && ( device_reader == NULL ) )
 		{
 			if( storage_media_buffer_queue_grab_buffer(
 			     imaging_handle->storage_media_buffer_queue,
@@ -961,6 +1145,23 @@ int ewfacquire_read_input(
 			}
 		}
 #endif
+		if( imaging_handle->process_status != NULL )
+		{
+			if( process_status_get_stage_timestamp(
+			     imaging_handle->process_status,
+			     &stage_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve stage timestamp.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		read_size = process_buffer_size;
 
 		if( remaining_aquiry_size < (size64_t) read_size )
@@ -971,9 +1172,9 @@ int ewfacquire_read_input(
 		{
 			/* Align with resume acquiry offset if necessary
 			 */
-			if( ( resume_acquiry_offset - (off64_t) acquiry_count ) < (off64_t) read_size )
+			if( ( resume_acquiry_offset - imaging_handle->last_offset_written ) < (off64_t) read_size )
 			{
-				read_size = (size_t) ( resume_acquiry_offset - acquiry_count );
+				read_size = (size_t) ( resume_acquiry_offset - imaging_handle->last_offset_written );
 			}
 			read_count = storage_media_buffer_read_from_handle(
 			              storage_media_buffer,
@@ -1040,13 +1241,80 @@ int ewfacquire_read_input(
 		}
 		else
 		{
-			read_count = device_handle_read_storage_media_buffer(
-				      device_handle,
-				      storage_media_buffer,
-				      storage_media_offset,
-				      read_size,
-				      error );
+#if defined( HAVE_DEVICE_READER )
+			if( device_reader != NULL )
+			{
+				while( ( device_reader->number_of_requests < device_reader->queue_depth )
+				    && ( (size64_t) read_ahead_offset < imaging_handle->acquiry_size ) )
+				{
+					if( storage_media_buffer_queue_grab_buffer(
+					     imaging_handle->storage_media_buffer_queue,
+					     &storage_media_buffer,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+						 "%s: unable to grab storage media buffer from queue.",
+						 function );
+
+						goto on_error;
+					}
+					read_ahead_size = process_buffer_size;
+
+					if( ( imaging_handle->acquiry_size - (size64_t) read_ahead_offset ) < (size64_t) read_ahead_size )
+					{
+						read_ahead_size = (size_t) ( imaging_handle->acquiry_size - (size64_t) read_ahead_offset );
+					}
+					if( device_reader_start_read(
+					     device_reader,
+					     storage_media_buffer,
+					     read_ahead_offset,
+					     read_ahead_size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to start read ahead at offset: %" PRIi64 ".",
+						 function,
+						 read_ahead_offset );
+
+						goto on_error;
+					}
+					storage_media_buffer = NULL;
 
+					read_ahead_offset += (off64_t) read_ahead_size;
+				}
+				read_count = device_reader_wait_read(
+					      device_reader,
+					      &storage_media_buffer,
+					      error );
+			}
+			else
+#endif /* defined( HAVE_DEVICE_READER ) */
+#if defined( HAVE_RESCUE_HANDLE )
+			if( rescue_handle != NULL )
+			{
+				read_count = rescue_handle_read_storage_media_buffer(
+					      rescue_handle,
+					      storage_media_buffer,
+					      storage_media_offset,
+					      read_size,
+					      error );
+			}
+			else
+#endif /* defined( HAVE_RESCUE_HANDLE ) */
+			{
+				read_count = device_handle_read_storage_media_buffer(
+					      device_handle,
+					      storage_media_buffer,
+					      storage_media_offset,
+					      read_size,
+					      error );
+			}
 			if( read_count < 0 )
 			{
 				libcerror_error_set(
@@ -1071,6 +1339,61 @@ int ewfacquire_read_input(
 			}
 			storage_media_offset  += read_count;
 			remaining_aquiry_size -= read_count;
+
+			if( imaging_handle->process_status->telemetry_stream != NULL )
+			{
+				if( device_handle_get_number_of_read_errors(
+				     device_handle,
+				     &number_of_read_errors,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve number of read errors.",
+					 function );
+
+					goto on_error;
+				}
+				if( number_of_read_errors > number_of_reported_read_errors )
+				{
+					if( process_status_add_read_errors(
+					     imaging_handle->process_status,
+					     (uint32_t) ( number_of_read_errors - number_of_reported_read_errors ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to add read errors.",
+						 function );
+
+						goto on_error;
+					}
+					number_of_reported_read_errors = number_of_read_errors;
+				}
+			}
+		}
+		if( imaging_handle->process_status != NULL )
+		{
+			if( process_status_add_stage_value(
+			     imaging_handle->process_status,
+			     PROCESS_STATUS_STAGE_READ,
+			     (size64_t) read_count,
+			     stage_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to add read stage value.",
+				 function );
+
+				goto on_error;
+			}
 		}
 		if( storage_media_buffer_get_data(
 		     storage_media_buffer,
@@ -1125,6 +1448,23 @@ int ewfacquire_read_input(
 
 			goto on_error;
 		}
+		if( imaging_handle->last_offset_written >= resume_acquiry_offset )
+		{
+			if( imaging_handle_set_checkpoint_digest_states(
+			     imaging_handle,
+			     storage_media_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set checkpoint digest states.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		if( imaging_handle->last_offset_written < resume_acquiry_offset )
 		{
 			imaging_handle->last_offset_written += (off64_t) read_count;
@@ -1167,6 +1507,23 @@ int ewfacquire_read_input(
 #endif
 		else
 		{
+			if( imaging_handle->process_status != NULL )
+			{
+				if( process_status_get_stage_timestamp(
+				     imaging_handle->process_status,
+				     &stage_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve stage timestamp.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			process_count = storage_media_buffer_write_process(
 					 storage_media_buffer,
 					 error );
@@ -1182,6 +1539,25 @@ int ewfacquire_read_input(
 
 				goto on_error;
 			}
+			if( imaging_handle->process_status != NULL )
+			{
+				if( process_status_add_stage_value(
+				     imaging_handle->process_status,
+				     PROCESS_STATUS_STAGE_PROCESS,
+				     (size64_t) process_count,
+				     stage_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to add process stage value.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			write_count = imaging_handle_write_storage_media_buffer(
 				       imaging_handle,
 				       storage_media_buffer,
@@ -1201,6 +1577,19 @@ int ewfacquire_read_input(
 			}
 			imaging_handle->last_offset_written += (off64_t) process_count;
 
+			if( imaging_handle_write_checkpoint(
+			     imaging_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write checkpoint.",
+				 function );
+
+				goto on_error;
+			}
 			if( process_status_update(
 			     imaging_handle->process_status,
 			     imaging_handle->last_offset_written,
@@ -1234,64 +1623,68 @@ int ewfacquire_read_input(
 			goto on_error;
 		}
 	}
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( imaging_handle->process_thread_pool != NULL )
+#if defined( HAVE_DEVICE_READER )
+	if( device_reader != NULL )
 	{
-		if( libcthreads_thread_pool_join(
-		     &( imaging_handle->process_thread_pool ),
+		if( device_reader_free(
+		     &device_reader,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to join process thread pool.",
+			 "%s: unable to free device reader.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	if( imaging_handle->output_thread_pool != NULL )
+#endif
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->process_thread_pool != NULL )
 	{
 		if( libcthreads_thread_pool_join(
-		     &( imaging_handle->output_thread_pool ),
+		     &( imaging_handle->process_thread_pool ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to join output thread pool.",
+			 "%s: unable to join process thread pool.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	if( imaging_handle->output_list != NULL )
+	if( imaging_handle->output_thread_pool != NULL )
 	{
-		if( imaging_handle_empty_output_list(
-		     imaging_handle,
+		if( libcthreads_thread_pool_join(
+		     &( imaging_handle->output_thread_pool ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
+			 "%s: unable to join output thread pool.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcdata_list_free(
-		     &( imaging_handle->output_list ),
-		     NULL,
+	}
+	if( imaging_handle->output_reorder != NULL )
+	{
+		if( storage_media_buffer_reorder_free(
+		     &( imaging_handle->output_reorder ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
+			 "%s: unable to free output reorder window.",
 			 function );
 
 			goto on_error;
@@ -1381,6 +1774,65 @@ int ewfacquire_read_input(
 				goto on_error;
 			}
 		}
+#if defined( HAVE_RESCUE_HANDLE )
+		/* The ranges that could not be rescued are the read errors of the acquiry
+		 */
+		if( rescue_handle != NULL )
+		{
+			if( rescue_handle_get_number_of_bad_ranges(
+			     rescue_handle,
+			     &number_of_read_errors,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of bad ranges.",
+				 function );
+
+				goto on_error;
+			}
+			for( read_error_iterator = 0;
+			     read_error_iterator < number_of_read_errors;
+			     read_error_iterator++ )
+			{
+				if( rescue_handle_get_bad_range(
+				     rescue_handle,
+				     read_error_iterator,
+				     &read_error_offset,
+				     &read_error_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve bad range: %d.",
+					 function,
+					 read_error_iterator );
+
+					goto on_error;
+				}
+				if( imaging_handle_append_read_error(
+				     imaging_handle,
+				     read_error_offset,
+				     read_error_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append bad range: %d to imaging handle.",
+					 function,
+					 read_error_iterator );
+
+					goto on_error;
+				}
+			}
+		}
+#endif /* defined( HAVE_RESCUE_HANDLE ) */
 		write_count = imaging_handle_finalize(
 			       imaging_handle,
 			       error );
@@ -1446,6 +1898,26 @@ int ewfacquire_read_input(
 
 			goto on_error;
 		}
+#if defined( HAVE_RESCUE_HANDLE )
+		if( rescue_handle != NULL )
+		{
+			if( rescue_handle_bad_ranges_fprint(
+			     rescue_handle,
+			     imaging_handle->notify_stream,
+			     imaging_handle->bytes_per_sector,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print rescue bad ranges.",
+				 function );
+
+				goto on_error;
+			}
+		}
+#endif
 		if( imaging_handle_print_hashes(
 		     imaging_handle,
 		     imaging_handle->notify_stream,
@@ -1476,6 +1948,26 @@ int ewfacquire_read_input(
 
 				goto on_error;
 			}
+#if defined( HAVE_RESCUE_HANDLE )
+			if( rescue_handle != NULL )
+			{
+				if( rescue_handle_bad_ranges_fprint(
+				     rescue_handle,
+				     log_handle->log_stream,
+				     imaging_handle->bytes_per_sector,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+					 "%s: unable to print rescue bad ranges in log handle.",
+					 function );
+
+					goto on_error;
+				}
+			}
+#endif
 			if( imaging_handle_print_hashes(
 			     imaging_handle,
 			     log_handle->log_stream,
@@ -1513,6 +2005,14 @@ on_error:
 		 &( imaging_handle->process_status ),
 		 NULL );
 	}
+#if defined( HAVE_DEVICE_READER )
+	if( device_reader != NULL )
+	{
+		device_reader_free(
+		 &device_reader,
+		 NULL );
+	}
+#endif
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 	if( imaging_handle->process_thread_pool != NULL )
 	{
@@ -1526,14 +2026,10 @@ on_error:
 		 &( imaging_handle->output_thread_pool ),
 		 NULL );
 	}
-	if( imaging_handle->output_list != NULL )
+	if( imaging_handle->output_reorder != NULL )
 	{
-		imaging_handle_empty_output_list(
-		 imaging_handle,
-		 NULL );
-		libcdata_list_free(
-		 &( imaging_handle->output_list ),
-		 NULL,
+		storage_media_buffer_reorder_free(
+		 &( imaging_handle->output_reorder ),
 		 NULL );
 	}
 	if( imaging_handle->storage_media_buffer_queue != NULL )
@@ -1557,13 +2053,17 @@ int main( int argc, char * const argv[] )
 	system_character_t input_buffer[ EWFACQUIRE_INPUT_BUFFER_SIZE ];
 	system_character_t media_information_model[ 64 ];
 	system_character_t media_information_serial_number[ 64 ];
+	system_character_t *option_additional_target_filenames[ IMAGING_HANDLE_MAXIMUM_NUMBER_OF_ADDITIONAL_TARGETS ];
 
 	libcerror_error_t *error                             = NULL;
 	log_handle_t *log_handle                             = NULL;
+	log_handle_t *telemetry_handle                       = NULL;
 	system_character_t *log_filename                     = NULL;
+	system_character_t *telemetry_filename               = NULL;
 	system_character_t *option_additional_digest_types   = NULL;
 	system_character_t *option_bytes_per_sector          = NULL;
 	system_character_t *option_case_number               = NULL;
+	system_character_t *option_chunks_section_limit      = NULL;
 	system_character_t *option_compression_values        = NULL;
 	system_character_t *option_description               = NULL;
 	system_character_t *option_evidence_number           = NULL;
@@ -1573,11 +2073,14 @@ int main( int argc, char * const argv[] )
 	system_character_t *option_maximum_segment_size      = NULL;
 	system_character_t *option_media_flags               = NULL;
 	system_character_t *option_media_type                = NULL;
+	system_character_t *option_memory_limit              = NULL;
 	system_character_t *option_notes                     = NULL;
 	system_character_t *option_number_of_error_retries   = NULL;
 	system_character_t *option_number_of_jobs            = NULL;
 	system_character_t *option_offset                    = NULL;
 	system_character_t *option_process_buffer_size       = NULL;
+	system_character_t *option_read_queue_depth          = NULL;
+	system_character_t *option_rescue_image_filename     = NULL;
 	system_character_t *option_secondary_target_filename = NULL;
 	system_character_t *option_sector_error_granularity  = NULL;
 	system_character_t *option_sectors_per_chunk         = NULL;
@@ -1598,7 +2101,9 @@ int main( int argc, char * const argv[] )
 	uint8_t zero_buffer_on_error                         = 0;
 	int8_t acquiry_parameters_confirmed                  = 0;
 	int interactive_mode                                 = 1;
+	int number_of_additional_target_filenames            = 0;
 	int result                                           = 0;
+	int target_index                                     = 0;
 
 	libcnotify_stream_set(
 	 stderr,
@@ -1633,7 +2138,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:g:hj:l:m:M:N:o:p:P:qr:RsS:t:T:uvVwx2:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:g:hI:j:J:k:l:L:m:M:N:o:O:p:P:qQ:r:RsS:t:T:uvVwx2:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -1718,16 +2223,36 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'I':
+				option_rescue_image_filename = optarg;
+
+				break;
+
 			case (system_integer_t) 'j':
 				option_number_of_jobs = optarg;
 
 				break;
 
+			case (system_integer_t) 'J':
+				telemetry_filename = optarg;
+
+				break;
+
+			case (system_integer_t) 'k':
+				option_chunks_section_limit = optarg;
+
+				break;
+
 			case (system_integer_t) 'l':
 				log_filename = optarg;
 
 				break;
 
+			case (system_integer_t) 'L':
+				option_memory_limit = optarg;
+
+				break;
+
 			case (system_integer_t) 'm':
 				option_media_type = optarg;
 
@@ -1748,6 +2273,23 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'O':
+				if( number_of_additional_target_filenames >= IMAGING_HANDLE_MAXIMUM_NUMBER_OF_ADDITIONAL_TARGETS )
+				{
+					ewfoutput_version_fprint(
+					 stdout,
+					 program );
+
+					fprintf(
+					 stderr,
+					 "Too many additional targets.\n" );
+
+					return( EXIT_FAILURE );
+				}
+				option_additional_target_filenames[ number_of_additional_target_filenames++ ] = optarg;
+
+				break;
+
 			case (system_integer_t) 'p':
 				option_process_buffer_size = optarg;
 
@@ -1763,6 +2305,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'Q':
+				option_read_queue_depth = optarg;
+
+				break;
+
 			case (system_integer_t) 'r':
 				option_number_of_error_retries = optarg;
 
@@ -1894,6 +2441,30 @@ int main( int argc, char * const argv[] )
 			}
 		}
 	}
+	if( option_secondary_target_filename != NULL )
+	{
+		/* Use the chunk data functions so that every chunk is packed once
+		 * and the packed chunk data is written to both the primary and the secondary target
+		 */
+		use_chunk_data_functions = 1;
+	}
+	if( number_of_additional_target_filenames > 0 )
+	{
+		/* Use the chunk data functions so that the process threads can write
+		 * the chunks to the segment files on the additional targets concurrently
+		 */
+		use_chunk_data_functions = 1;
+	}
+	if( ( resume_acquiry != 0 )
+	 && ( number_of_additional_target_filenames > 0 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Resume (-R) is not supported with additional targets (-O), the segment files\n"
+		 "on the additional targets cannot be found when resuming.\n" );
+
+		goto on_error;
+	}
 	if( device_handle_initialize(
 	     &ewfacquire_device_handle,
 	     &error ) != 1 )
@@ -1943,6 +2514,29 @@ int main( int argc, char * const argv[] )
 			 ewfacquire_device_handle->number_of_error_retries );
 		}
 	}
+	if( option_read_queue_depth != NULL )
+	{
+		result = device_handle_set_read_queue_depth(
+			  ewfacquire_device_handle,
+			  option_read_queue_depth,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set read queue depth.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported read queue depth defaulting to: %d.\n",
+			 ewfacquire_device_handle->read_queue_depth );
+		}
+	}
 	if( zero_buffer_on_error != 0 )
 	{
 		ewfacquire_device_handle->zero_buffer_on_error = 1;
@@ -1998,20 +2592,42 @@ int main( int argc, char * const argv[] )
 		 stderr,
 		 "Unable to retrieve media size.\n" );
 
-		goto on_error;
+		goto on_error;
+	}
+	if( option_header_codepage != NULL )
+	{
+		result = imaging_handle_set_header_codepage(
+			  ewfacquire_imaging_handle,
+			  option_header_codepage,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set header codepage.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported header codepage defaulting to: ascii.\n" );
+		}
 	}
-	if( option_header_codepage != NULL )
+	if( option_chunks_section_limit != NULL )
 	{
-		result = imaging_handle_set_header_codepage(
+		result = imaging_handle_set_chunks_section_limit(
 			  ewfacquire_imaging_handle,
-			  option_header_codepage,
+			  option_chunks_section_limit,
 			  &error );
 
 		if( result == -1 )
 		{
 			fprintf(
 			 stderr,
-			 "Unable to set header codepage.\n" );
+			 "Unable to set chunks section limit.\n" );
 
 			goto on_error;
 		}
@@ -2019,7 +2635,7 @@ int main( int argc, char * const argv[] )
 		{
 			fprintf(
 			 stderr,
-			 "Unsupported header codepage defaulting to: ascii.\n" );
+			 "Unsupported chunks section limit defaulting to: 0.\n" );
 		}
 	}
 	if( option_target_filename != NULL )
@@ -2083,6 +2699,29 @@ int main( int argc, char * const argv[] )
 		}
 		else
 		{
+			if( ewfacquire_imaging_handle->chunks_section_limit > 0 )
+			{
+				result = imaging_handle_enable_checkpoints(
+					  ewfacquire_imaging_handle,
+					  ewfacquire_imaging_handle->target_filename,
+					  resume_acquiry,
+					  &error );
+
+				if( result == -1 )
+				{
+					fprintf(
+					 stderr,
+					 "Unable to enable checkpoints.\n" );
+
+					goto on_error;
+				}
+				else if( result == 0 )
+				{
+					fprintf(
+					 stdout,
+					 "Checkpoints not supported on this platform.\n" );
+				}
+			}
 			if( ewftools_signal_attach(
 			     ewfacquire_signal_handler,
 			     &error ) != 1 )
@@ -2123,6 +2762,42 @@ int main( int argc, char * const argv[] )
 			}
 		}
 	}
+	for( target_index = 0;
+	     target_index < number_of_additional_target_filenames;
+	     target_index++ )
+	{
+		if( imaging_handle_append_additional_target_filename(
+		     ewfacquire_imaging_handle,
+		     option_additional_target_filenames[ target_index ],
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set additional target filename.\n" );
+
+			goto on_error;
+		}
+		/* Make sure we can write the additional target file
+		 */
+		if( imaging_handle_check_write_access(
+		     ewfacquire_imaging_handle,
+		     option_additional_target_filenames[ target_index ],
+		     &error ) != 1 )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			libcnotify_print_error_backtrace(
+			 error );
+#endif
+			libcerror_error_free(
+			 &error );
+
+			fprintf(
+			 stdout,
+			 "Unable to write additional target file.\n" );
+
+			goto on_error;
+		}
+	}
 	if( option_secondary_target_filename != NULL )
 	{
 		if( imaging_handle_set_string(
@@ -2546,7 +3221,7 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 		else if( ( result == 0 )
-		      || ( ewfacquire_imaging_handle->number_of_threads > (int) 32 ) )
+		      || ( ewfacquire_imaging_handle->number_of_threads > (int) IMAGING_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
 		{
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 			ewfacquire_imaging_handle->number_of_threads = 4;
@@ -2560,6 +3235,30 @@ int main( int argc, char * const argv[] )
 			 ewfacquire_imaging_handle->number_of_threads );
 		}
 	}
+	if( option_memory_limit != NULL )
+	{
+		result = imaging_handle_set_memory_limit(
+			  ewfacquire_imaging_handle,
+			  option_memory_limit,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set memory limit.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			ewfacquire_imaging_handle->memory_limit = 0;
+
+			fprintf(
+			 stderr,
+			 "Unsupported memory limit defaulting to: automatic.\n" );
+		}
+	}
 	if( option_additional_digest_types != NULL )
 	{
 		result = imaging_handle_set_additional_digest_types(
@@ -2655,6 +3354,29 @@ int main( int argc, char * const argv[] )
 		}
 		if( resume_acquiry != 0 )
 		{
+			if( ewfacquire_imaging_handle->chunks_section_limit > 0 )
+			{
+				result = imaging_handle_enable_checkpoints(
+					  ewfacquire_imaging_handle,
+					  ewfacquire_imaging_handle->target_filename,
+					  resume_acquiry,
+					  &error );
+
+				if( result == -1 )
+				{
+					fprintf(
+					 stderr,
+					 "Unable to enable checkpoints.\n" );
+
+					goto on_error;
+				}
+				else if( result == 0 )
+				{
+					fprintf(
+					 stdout,
+					 "Checkpoints not supported on this platform.\n" );
+				}
+			}
 			if( ewftools_signal_attach(
 			     ewfacquire_signal_handler,
 			     &error ) != 1 )
@@ -3118,6 +3840,125 @@ int main( int argc, char * const argv[] )
 	{
 		goto on_abort;
 	}
+	if( option_rescue_image_filename != NULL )
+	{
+#if defined( HAVE_RESCUE_HANDLE )
+		/* The rescue image is read back in order by the acquiry, which allows
+		 * the failing areas to be read in multiple passes before the EWF
+		 * image, which must be written sequentially, is created
+		 */
+		if( ( ( argc - optind ) != 1 )
+		 || ( ewfacquire_device_handle->type == DEVICE_HANDLE_TYPE_OPTICAL_DISC_FILE )
+		 || ( ewfacquire_imaging_handle->media_type == DEVICE_HANDLE_MEDIA_TYPE_OPTICAL ) )
+		{
+			fprintf(
+			 stderr,
+			 "Rescue is only supported for a single file or non-optical device.\n" );
+
+			goto on_error;
+		}
+		if( rescue_handle_initialize(
+		     &ewfacquire_rescue_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create rescue handle.\n" );
+
+			goto on_error;
+		}
+		ewfacquire_rescue_handle->number_of_retries = ewfacquire_device_handle->number_of_error_retries;
+
+		if( rescue_handle_open(
+		     ewfacquire_rescue_handle,
+		     argv[ optind ],
+		     option_rescue_image_filename,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open rescue image: %" PRIs_SYSTEM ".\n",
+			 option_rescue_image_filename );
+
+			goto on_error;
+		}
+		if( rescue_handle_set_region(
+		     ewfacquire_rescue_handle,
+		     (off64_t) ewfacquire_imaging_handle->acquiry_offset,
+		     (size64_t) ewfacquire_imaging_handle->acquiry_size,
+		     (size_t) ewfacquire_imaging_handle->sectors_per_chunk * ewfacquire_imaging_handle->bytes_per_sector,
+		     (size_t) ewfacquire_imaging_handle->sector_error_granularity * ewfacquire_imaging_handle->bytes_per_sector,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set rescue region.\n" );
+
+			goto on_error;
+		}
+		result = rescue_handle_read_map(
+		          ewfacquire_rescue_handle,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read rescue map.\n" );
+
+			goto on_error;
+		}
+		else if( result == 1 )
+		{
+			fprintf(
+			 stdout,
+			 "Continuing rescue using map: %" PRIs_SYSTEM ".\n\n",
+			 ewfacquire_rescue_handle->map_filename );
+		}
+		if( ewftools_signal_attach(
+		     ewfacquire_signal_handler,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to attach signal handler.\n" );
+
+			goto on_error;
+		}
+		result = rescue_handle_acquire(
+		          ewfacquire_rescue_handle,
+		          print_status_information,
+		          &error );
+
+		if( ewftools_signal_detach(
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to detach signal handler.\n" );
+
+			goto on_error;
+		}
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to rescue input.\n" );
+
+			goto on_error;
+		}
+		if( ewfacquire_abort != 0 )
+		{
+			goto on_abort;
+		}
+#else
+		fprintf(
+		 stderr,
+		 "Rescue not supported on this platform.\n" );
+
+		goto on_error;
+#endif /* defined( HAVE_RESCUE_HANDLE ) */
+	}
 	if( resume_acquiry == 0 )
 	{
 		result = device_handle_get_information_value(
@@ -3166,6 +4007,29 @@ int main( int argc, char * const argv[] )
 		{
 			media_information_serial_number[ 0 ] = 0;
 		}
+		if( ewfacquire_imaging_handle->chunks_section_limit > 0 )
+		{
+			result = imaging_handle_enable_checkpoints(
+				  ewfacquire_imaging_handle,
+				  ewfacquire_imaging_handle->target_filename,
+				  resume_acquiry,
+				  &error );
+
+			if( result == -1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to enable checkpoints.\n" );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				fprintf(
+				 stdout,
+				 "Checkpoints not supported on this platform.\n" );
+			}
+		}
 		if( imaging_handle_open_output(
 		     ewfacquire_imaging_handle,
 		     ewfacquire_imaging_handle->target_filename,
@@ -3218,6 +4082,29 @@ int main( int argc, char * const argv[] )
 
 			goto on_error;
 		}
+		if( ewfacquire_imaging_handle->number_of_additional_target_filenames > 0 )
+		{
+			result = imaging_handle_enable_concurrent_segment_write(
+				  ewfacquire_imaging_handle,
+				  &error );
+
+			if( result == -1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to enable concurrent segment write.\n" );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				fprintf(
+				 stdout,
+				 "Segment files are written one after another, writing them concurrently\n"
+				 "requires multiple jobs, no compression, a known acquiry size, no -k and\n"
+				 "an EWF version 1 format other than ewf and smart.\n" );
+			}
+		}
 		if( ewfacquire_imaging_handle->media_type == DEVICE_HANDLE_MEDIA_TYPE_OPTICAL )
 		{
 			if( ewfacquire_determine_sessions(
@@ -3271,9 +4158,37 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( telemetry_filename != NULL )
+	{
+		if( log_handle_initialize(
+		     &telemetry_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create telemetry handle.\n" );
+
+			goto on_error;
+		}
+		if( log_handle_open(
+		     telemetry_handle,
+		     telemetry_filename,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open telemetry file: %" PRIs_SYSTEM ".\n",
+			 telemetry_filename );
+
+			goto on_error;
+		}
+		ewfacquire_imaging_handle->telemetry_stream = telemetry_handle->log_stream;
+	}
 	result = ewfacquire_read_input(
 		  ewfacquire_imaging_handle,
 		  ewfacquire_device_handle,
+		  ewfacquire_rescue_handle,
+		  argv[ optind ],
 		  resume_acquiry_offset,
 		  swap_byte_pairs,
 		  print_status_information,
@@ -3315,6 +4230,31 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( telemetry_handle != NULL )
+	{
+		ewfacquire_imaging_handle->telemetry_stream = NULL;
+
+		if( log_handle_close(
+		     telemetry_handle,
+		     &error ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to close telemetry handle.\n" );
+
+			goto on_error;
+		}
+		if( log_handle_free(
+		     &telemetry_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free telemetry handle.\n" );
+
+			goto on_error;
+		}
+	}
 on_abort:
 	if( ewftools_signal_detach(
 	     &error ) != 1 )
@@ -3368,6 +4308,21 @@ on_abort:
 
 		goto on_error;
 	}
+#if defined( HAVE_RESCUE_HANDLE )
+	if( ewfacquire_rescue_handle != NULL )
+	{
+		if( rescue_handle_free(
+		     &ewfacquire_rescue_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free rescue handle.\n" );
+
+			goto on_error;
+		}
+	}
+#endif
 	if( ewfacquire_abort != 0 )
 	{
 		fprintf(
@@ -3410,6 +4365,15 @@ on_error:
 		 &log_handle,
 		 NULL );
 	}
+	if( telemetry_handle != NULL )
+	{
+		log_handle_close(
+		 telemetry_handle,
+		 NULL );
+		log_handle_free(
+		 &telemetry_handle,
+		 NULL );
+	}
 	if( ewfacquire_imaging_handle != NULL )
 	{
 		imaging_handle_close(
@@ -3428,6 +4392,14 @@ on_error:
 		 &ewfacquire_device_handle,
 		 NULL );
 	}
+#if defined( HAVE_RESCUE_HANDLE )
+	if( ewfacquire_rescue_handle != NULL )
+	{
+		rescue_handle_free(
+		 &ewfacquire_rescue_handle,
+		 NULL );
+	}
+#endif
 	return( EXIT_FAILURE );
 }
 
@@ -51,6 +51,8 @@
 #include "process_status.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "storage_media_buffer_reorder.h"
+#include "stream_reader.h"
 
 imaging_handle_t *ewfacquirestream_imaging_handle = NULL;
 int ewfacquirestream_abort                        = 0;
@@ -113,9 +115,12 @@ void usage_fprint(
 	                 "                        [ -C case_number ] [ -d digest_type ]\n"
 	                 "                        [ -D description ] [ -e examiner_name ]\n"
 	                 "                        [ -E evidence_number ] [ -f format ] [ -j jobs ]\n"
-	                 "                        [ -l log_filename ] [ -m media_type ]\n"
-	                 "                        [ -M media_flags ] [ -N notes ]\n"
-	                 "                        [ -o offset ] [ -p process_buffer_size ]\n"
+	                 "                        [ -J telemetry_file ] [ -l log_filename ]\n"
+	                 "                        [ -L memory_limit ]\n"
+	                 "                        [ -m media_type ] [ -M media_flags ]\n"
+	                 "                        [ -N notes ]\n"
+	                 "                        [ -o offset ] [ -O additional_target ]\n"
+	                 "                        [ -p process_buffer_size ]\n"
 	                 "                        [ -P bytes_per_sector ] [ -S segment_file_size ]\n"
 	                 "                        [ -t target ] [ -2 secondary_target ]\n"
 	                 "                        [ -hqsvVx ]\n\n" );
@@ -151,14 +156,29 @@ void usage_fprint(
 	                 "\t    linen6, linen7, ewfx\n" );
 	fprintf( stream, "\t-h: shows this help\n" );
 	fprintf( stream, "\t-j: the number of concurrent processing jobs (threads), where\n"
-	                 "\t    a number of 0 represents single-threaded mode (default is 4\n"
-	                 "\t    if multi-threaded mode is supported)\n" );
+	                 "\t    a number of 0 represents single-threaded mode and auto a\n"
+	                 "\t    thread per processor, where the number of active jobs is\n"
+	                 "\t    adjusted to the measured read, hash and write throughput\n"
+	                 "\t    (default is 4 if multi-threaded mode is supported)\n" );
+	fprintf( stream, "\t-J: writes a JSON object per line with the throughput per stage (read,\n"
+	                 "\t    process, hash and write), the buffer queue depths, the worker\n"
+	                 "\t    utilization, the compression ratio and the number of read errors to\n"
+	                 "\t    the telemetry_file every second, which can be a FIFO\n" );
 	fprintf( stream, "\t-l: logs acquiry errors and the digest (hash) to the log_filename\n" );
+	fprintf( stream, "\t-L: specify the maximum amount of memory used by the buffers of\n"
+	                 "\t    the concurrent processing jobs (default is 512 MiB or a\n"
+	                 "\t    quarter of the physical memory if less)\n" );
 	fprintf( stream, "\t-m: specify the media type, options: fixed (default), removable,\n"
 	                 "\t    optical, memory\n" );
 	fprintf( stream, "\t-M: specify the media flags, options: logical, physical (default)\n" );
 	fprintf( stream, "\t-N: specify the notes (default is notes).\n" );
 	fprintf( stream, "\t-o: specify the offset to start to acquire (default is 0)\n" );
+	fprintf( stream, "\t-O: specify an additional target file (without extension), the segment\n"
+	                 "\t    files are distributed round-robin over the target and the\n"
+	                 "\t    additional targets, for example to spread them over multiple disks.\n"
+	                 "\t    The segment files are still written one after another.\n"
+	                 "\t    Can be specified up to %d times\n",
+	                 IMAGING_HANDLE_MAXIMUM_NUMBER_OF_ADDITIONAL_TARGETS );
 	fprintf( stream, "\t-p: specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-P: specify the number of bytes per sector (default is 512)\n" );
 	fprintf( stream, "\t-q: quiet shows minimal status information\n" );
@@ -190,7 +210,9 @@ void usage_fprint(
 	fprintf( stream, "\t-v: verbose output to stderr\n" );
 	fprintf( stream, "\t-V: print version\n" );
 	fprintf( stream, "\t-x: use the chunk data instead of the buffered read and write functions.\n" );
-	fprintf( stream, "\t-2: specify the secondary target file (without extension) to write to\n" );
+	fprintf( stream, "\t-2: specify the secondary target file (without extension) to write to,\n"
+	                 "\t    implies -x since the chunks are compressed once and written to both\n"
+	                 "\t    targets\n" );
 }
 
 /* Signal handler for ewfacquire
@@ -237,245 +259,8 @@ void ewfacquirestream_signal_handler(
 	}
 }
 
-/* Reads a chunk of data from the file descriptor into the buffer
- * Returns the number of bytes read, 0 if at end of input or -1 on error
- */
-ssize_t ewfacquirestream_read_chunk(
-         libewf_handle_t *handle,
-         int input_file_descriptor,
-         storage_media_buffer_t *storage_media_buffer,
-         off64_t storage_media_offset,
-         size_t buffer_read_size,
-         size32_t chunk_size,
-         uint8_t read_error_retries,
-         libcerror_error_t **error )
-{
-	static char *function         = "ewfacquirestream_read_chunk";
-	size_t buffer_offset          = 0;
-	size_t chunk_read_size        = 0;
-	size_t input_read_size        = 0;
-	size_t remaining_read_size    = 0;
-	ssize_t chunk_read_count      = 0;
-	ssize_t input_read_count      = 0;
-	int32_t read_number_of_errors = 0;
-
-	if( handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( input_file_descriptor == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid input file descriptor.",
-		 function );
-
-		return( -1 );
-	}
-	if( storage_media_buffer == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid storage media buffer.",
-		 function );
-
-		return( -1 );
-	}
-	if( buffer_read_size > (size_t) SSIZE_MAX )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer read size value exceeds maximum.",
-		 function );
-
-		return( -1 );
-	}
-	if( chunk_size == 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
-		 "%s: invalid chunk size value zero or less.",
-		 function );
-
-		return( -1 );
-	}
-	remaining_read_size = buffer_read_size;
-
-	while( remaining_read_size > 0 )
-	{
-		/* Determine the number of bytes to read from the input
-		 * Read as much as possible in chunk sizes
-		 */
-		if( remaining_read_size < (size_t) chunk_size )
-		{
-			chunk_read_size = remaining_read_size;
-		}
-		else
-		{
-			chunk_read_size = chunk_size;
-		}
-		input_read_size = chunk_read_size;
-
-		chunk_read_count      = 0;
-		read_number_of_errors = 0;
-
-		while( input_read_size > 0 )
-		{
-			if( ewfacquirestream_abort != 0 )
-			{
-				break;
-			}
-#if defined( HAVE_VERBOSE_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: reading buffer at offset: 0x%08" PRIx64 " of size: %" PRIzd ".\n",
-				 function,
-				 storage_media_offset + (off64_t) buffer_offset,
-				 input_read_size );
-			}
-#endif
-#if defined( WINAPI ) && !defined( __CYGWIN__ )
-			input_read_count = _read(
-			                    input_file_descriptor,
-			                    &( ( storage_media_buffer->raw_buffer )[ buffer_offset ] ),
-			                    input_read_size );
-#else
-			input_read_count = read(
-			                    input_file_descriptor,
-			                    &( ( storage_media_buffer->raw_buffer )[ buffer_offset ] ),
-			                    input_read_size );
-#endif
-			if( input_read_count < 0 )
-			{
-				if( ( errno == ESPIPE )
-				 || ( errno == EPERM )
-				 || ( errno == ENXIO )
-				 || ( errno == ENODEV ) )
-				{
-					if( errno == ESPIPE )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: error reading data: invalid seek.",
-						 function );
-					}
-					else if( errno == EPERM )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: error reading data: operation not permitted.",
-						 function );
-					}
-					else if( errno == ENXIO )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: error reading data: no such device or address.",
-						 function );
-					}
-					else if( errno == ENODEV )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: error reading data: no such device.",
-						 function );
-					}
-					else
-					{
-						libcerror_system_set_error(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 errno,
-						 "%s: error reading data.",
-						 function );
-					}
-					return( -1 );
-				}
-				read_number_of_errors++;
-			}
-			/* No bytes were read
-			 */
-			else if( input_read_count == 0 )
-			{
-				break;
-			}
-			else
-			{
-				chunk_read_count += input_read_count;
-				buffer_offset    += input_read_count;
-				input_read_size  -= input_read_count;
-
-				/* The entire read is OK
-				 */
-				if( chunk_read_count == (ssize_t) chunk_read_size )
-				{
-					break;
-				}
-				/* There was a read error at a certain offset
-				 */
-#if defined( HAVE_VERBOSE_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: read error at offset: 0x%08" PRIx64 " when reading %" PRIzd " bytes.\n",
-					 function,
-					 storage_media_offset + (off64_t) buffer_offset,
-					 input_read_count );
-				}
-#endif
-				read_number_of_errors++;
-			}
-			if( read_number_of_errors > read_error_retries )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: error reading data.",
-				 function );
-
-				return( -1 );
-			}
-		}
-		if( chunk_read_count == 0 )
-		{
-			break;
-		}
-		remaining_read_size -= chunk_read_count;
-	}
-	storage_media_buffer->storage_media_offset = storage_media_offset;
-	storage_media_buffer->requested_size       = buffer_read_size;
-	storage_media_buffer->raw_buffer_data_size = buffer_offset;
-
-	return( (ssize_t) buffer_offset );
-}
-
 /* Reads the input
+ * When multi-threaded the input is read ahead by a separate read thread
  * Returns 1 if successful or -1 on error
  */
 int ewfacquirestream_read_input(
@@ -489,6 +274,7 @@ int ewfacquirestream_read_input(
      libcerror_error_t **error )
 {
 	storage_media_buffer_t *storage_media_buffer = NULL;
+	stream_reader_t *stream_reader               = NULL;
 	uint8_t *data                                = NULL;
 	static char *function                        = "ewfacquirestream_read_input";
 	off64_t storage_media_offset                 = 0;
@@ -501,8 +287,11 @@ int ewfacquirestream_read_input(
 	ssize_t read_count                           = 0;
 	ssize_t process_count                        = 0;
 	ssize_t write_count                          = 0;
+	uint64_t stage_timestamp                     = 0;
 	uint8_t storage_media_buffer_mode            = 0;
+	size_t pipe_size                             = 0;
 	int maximum_number_of_queued_items           = 0;
+	int maximum_number_of_read_buffers           = 0;
 	int status                                   = PROCESS_STATUS_COMPLETED;
 
 	if( imaging_handle == NULL )
@@ -593,10 +382,52 @@ int ewfacquirestream_read_input(
 		}
 		storage_media_buffer_mode = STORAGE_MEDIA_BUFFER_MODE_BUFFERED;
 	}
+	/* A larger pipe buffer reduces the number of reads and the number of times
+	 * the writer of the pipe is blocked
+	 */
+	pipe_size = 4 * process_buffer_size;
+
+	if( pipe_size < (size_t) ( 1024 * 1024 ) )
+	{
+		pipe_size = (size_t) ( 1024 * 1024 );
+	}
+	else if( pipe_size > (size_t) STREAM_READER_MAXIMUM_PIPE_SIZE )
+	{
+		pipe_size = (size_t) STREAM_READER_MAXIMUM_PIPE_SIZE;
+	}
+	if( stream_reader_set_pipe_size(
+	     input_file_descriptor,
+	     pipe_size,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set pipe size.",
+		 function );
+
+		goto on_error;
+	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 	if( imaging_handle->number_of_threads != 0 )
 	{
-		maximum_number_of_queued_items = 1 + ( ( 512 * 1024 * 1024 ) / process_buffer_size );
+		if( storage_media_buffer_queue_get_maximum_number_of_values(
+		     imaging_handle->memory_limit,
+		     process_buffer_size,
+		     imaging_handle->number_of_threads,
+		     &maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine maximum number of queued items.",
+			 function );
+
+			goto on_error;
+		}
 
 		if( libcthreads_thread_pool_create(
 		     &( imaging_handle->process_thread_pool ),
@@ -634,15 +465,17 @@ int ewfacquirestream_read_input(
 
 			goto on_error;
 		}
-		if( libcdata_list_initialize(
-		     &( imaging_handle->output_list ),
+		if( storage_media_buffer_reorder_initialize(
+		     &( imaging_handle->output_reorder ),
+		     maximum_number_of_queued_items,
+		     process_buffer_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create output list.",
+			 "%s: unable to create output reorder window.",
 			 function );
 
 			goto on_error;
@@ -664,6 +497,37 @@ int ewfacquirestream_read_input(
 
 			goto on_error;
 		}
+		/* Leave buffers for the process and output threads
+		 */
+		maximum_number_of_read_buffers = maximum_number_of_queued_items / 2;
+
+		if( maximum_number_of_read_buffers > STREAM_READER_MAXIMUM_NUMBER_OF_BUFFERS )
+		{
+			maximum_number_of_read_buffers = STREAM_READER_MAXIMUM_NUMBER_OF_BUFFERS;
+		}
+		if( maximum_number_of_read_buffers > 0 )
+		{
+			if( stream_reader_initialize(
+			     &stream_reader,
+			     input_file_descriptor,
+			     imaging_handle->storage_media_buffer_queue,
+			     process_buffer_size,
+			     imaging_handle->acquiry_offset,
+			     imaging_handle->acquiry_size,
+			     read_error_retries,
+			     maximum_number_of_read_buffers,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize stream reader.",
+				 function );
+
+				goto on_error;
+			}
+		}
 	}
 #endif
 	if( imaging_handle_initialize_integrity_hash(
@@ -697,6 +561,35 @@ int ewfacquirestream_read_input(
 
 		goto on_error;
 	}
+	if( process_status_set_telemetry(
+	     imaging_handle->process_status,
+	     imaging_handle->telemetry_stream,
+	     imaging_handle->number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set process status telemetry.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_set_collect_stage_values(
+	     imaging_handle->process_status,
+	     imaging_handle->automatic_number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set process status collect stage values.",
+		 function );
+
+		goto on_error;
+	}
 	if( process_status_start(
 	     imaging_handle->process_status,
 	     error ) != 1 )
@@ -741,6 +634,26 @@ int ewfacquirestream_read_input(
 		}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( imaging_handle->number_of_threads != 0 )
+		{
+			/* The stream reader holds the buffers it read ahead
+			 */
+			if( imaging_handle_adjust_number_of_jobs(
+			     imaging_handle,
+			     maximum_number_of_read_buffers,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to adjust number of jobs.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( ( imaging_handle->number_of_threads != 0 )
+		 && ( stream_reader == NULL ) )
 		{
 			if( storage_media_buffer_queue_grab_buffer(
 			     imaging_handle->storage_media_buffer_queue,
@@ -783,17 +696,42 @@ int ewfacquirestream_read_input(
 		{
 			read_size = (size_t) remaining_aquiry_size;
 		}
-		/* Read a chunk from the file descriptor
-		 */
-		read_count = ewfacquirestream_read_chunk(
-		              imaging_handle->output_handle,
-		              input_file_descriptor,
-		              storage_media_buffer,
-		              storage_media_offset,
-		              storage_media_buffer->raw_buffer_size,
-		              (size32_t) read_size,
-		              read_error_retries,
-		              error );
+		if( imaging_handle->process_status != NULL )
+		{
+			if( process_status_get_stage_timestamp(
+			     imaging_handle->process_status,
+			     &stage_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve stage timestamp.",
+				 function );
+
+				goto on_error;
+			}
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( stream_reader != NULL )
+		{
+			read_count = stream_reader_get_buffer(
+			              stream_reader,
+			              &storage_media_buffer,
+			              error );
+		}
+		else
+#endif
+		{
+			read_count = stream_reader_read_buffer(
+			              input_file_descriptor,
+			              storage_media_buffer,
+			              storage_media_offset,
+			              read_size,
+			              read_error_retries,
+			              error );
+		}
 
 		if( read_count < 0 )
 		{
@@ -812,6 +750,26 @@ int ewfacquirestream_read_input(
 		}
 		storage_media_offset += read_count;
 
+		if( imaging_handle->process_status != NULL )
+		{
+			if( process_status_add_stage_value(
+			     imaging_handle->process_status,
+			     PROCESS_STATUS_STAGE_READ,
+			     (size64_t) read_count,
+			     stage_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to add read stage value.",
+				 function );
+
+				goto on_error;
+			}
+		}
+
 		/* Skip a certain number of bytes if necessary
 		 */
 		if( skip_aquiry_size > 0 )
@@ -819,6 +777,26 @@ int ewfacquirestream_read_input(
 			imaging_handle->last_offset_written += read_count;
 			skip_aquiry_size                    -= read_count;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			if( imaging_handle->number_of_threads != 0 )
+			{
+				if( storage_media_buffer_queue_release_buffer(
+				     imaging_handle->storage_media_buffer_queue,
+				     storage_media_buffer,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to release storage media buffer onto queue.",
+					 function );
+
+					goto on_error;
+				}
+				storage_media_buffer = NULL;
+			}
+#endif
 			continue;
 		}
 		remaining_aquiry_size -= read_count;
@@ -897,6 +875,23 @@ int ewfacquirestream_read_input(
 		else
 #endif
 		{
+			if( imaging_handle->process_status != NULL )
+			{
+				if( process_status_get_stage_timestamp(
+				     imaging_handle->process_status,
+				     &stage_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve stage timestamp.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			process_count = storage_media_buffer_write_process(
 			                 storage_media_buffer,
 			                 error );
@@ -912,6 +907,25 @@ int ewfacquirestream_read_input(
 
 				goto on_error;
 			}
+			if( imaging_handle->process_status != NULL )
+			{
+				if( process_status_add_stage_value(
+				     imaging_handle->process_status,
+				     PROCESS_STATUS_STAGE_PROCESS,
+				     (size64_t) process_count,
+				     stage_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to add process stage value.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			write_count = imaging_handle_write_storage_media_buffer(
 			               imaging_handle,
 			               storage_media_buffer,
@@ -964,63 +978,65 @@ int ewfacquirestream_read_input(
 		}
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( imaging_handle->process_thread_pool != NULL )
+	if( stream_reader != NULL )
 	{
-		if( libcthreads_thread_pool_join(
-		     &( imaging_handle->process_thread_pool ),
+		if( stream_reader_free(
+		     &stream_reader,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to join process thread pool.",
+			 "%s: unable to free stream reader.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	if( imaging_handle->output_thread_pool != NULL )
+	if( imaging_handle->process_thread_pool != NULL )
 	{
 		if( libcthreads_thread_pool_join(
-		     &( imaging_handle->output_thread_pool ),
+		     &( imaging_handle->process_thread_pool ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to join output thread pool.",
+			 "%s: unable to join process thread pool.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	if( imaging_handle->output_list != NULL )
+	if( imaging_handle->output_thread_pool != NULL )
 	{
-		if( imaging_handle_empty_output_list(
-		     imaging_handle,
+		if( libcthreads_thread_pool_join(
+		     &( imaging_handle->output_thread_pool ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
+			 "%s: unable to join output thread pool.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcdata_list_free(
-		     &( imaging_handle->output_list ),
-		     NULL,
+	}
+	if( imaging_handle->output_reorder != NULL )
+	{
+		if( storage_media_buffer_reorder_free(
+		     &( imaging_handle->output_reorder ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
+			 "%s: unable to free output reorder window.",
 			 function );
 
 			goto on_error;
@@ -1161,6 +1177,12 @@ on_error:
 		 NULL );
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( stream_reader != NULL )
+	{
+		stream_reader_free(
+		 &stream_reader,
+		 NULL );
+	}
 	if( imaging_handle->process_thread_pool != NULL )
 	{
 		libcthreads_thread_pool_join(
@@ -1173,14 +1195,10 @@ on_error:
 		 &( imaging_handle->output_thread_pool ),
 		 NULL );
 	}
-	if( imaging_handle->output_list != NULL )
+	if( imaging_handle->output_reorder != NULL )
 	{
-		imaging_handle_empty_output_list(
-		 imaging_handle,
-		 NULL );
-		libcdata_list_free(
-		 &( imaging_handle->output_list ),
-		 NULL,
+		storage_media_buffer_reorder_free(
+		 &( imaging_handle->output_reorder ),
 		 NULL );
 	}
 	if( imaging_handle->storage_media_buffer_queue != NULL )
@@ -1201,9 +1219,13 @@ int wmain( int argc, wchar_t * const argv[] )
 int main( int argc, char * const argv[] )
 #endif
 {
+	system_character_t *option_additional_target_filenames[ IMAGING_HANDLE_MAXIMUM_NUMBER_OF_ADDITIONAL_TARGETS ];
+
 	libcerror_error_t *error                             = NULL;
 	log_handle_t *log_handle                             = NULL;
+	log_handle_t *telemetry_handle                       = NULL;
 	system_character_t *log_filename                     = NULL;
+	system_character_t *telemetry_filename               = NULL;
 	system_character_t *option_additional_digest_types   = NULL;
 	system_character_t *option_bytes_per_sector          = NULL;
 	system_character_t *option_case_number               = NULL;
@@ -1216,6 +1238,7 @@ int main( int argc, char * const argv[] )
 	system_character_t *option_maximum_segment_size      = NULL;
 	system_character_t *option_media_flags               = NULL;
 	system_character_t *option_media_type                = NULL;
+	system_character_t *option_memory_limit              = NULL;
 	system_character_t *option_notes                     = NULL;
 	system_character_t *option_number_of_jobs            = NULL;
 	system_character_t *option_offset                    = NULL;
@@ -1234,7 +1257,9 @@ int main( int argc, char * const argv[] )
 	uint8_t swap_byte_pairs                              = 0;
 	uint8_t use_chunk_data_functions                     = 0;
 	uint8_t verbose                                      = 0;
+	int number_of_additional_target_filenames            = 0;
 	int result                                           = 0;
+	int target_index                                     = 0;
 
 	libcnotify_stream_set(
 	 stderr,
@@ -1296,7 +1321,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:hj:l:m:M:N:o:p:P:qsS:t:vVx2:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:hj:J:l:L:m:M:N:o:O:p:P:qsS:t:vVx2:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -1381,11 +1406,21 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'J':
+				telemetry_filename = optarg;
+
+				break;
+
 			case (system_integer_t) 'l':
 				log_filename = optarg;
 
 				break;
 
+			case (system_integer_t) 'L':
+				option_memory_limit = optarg;
+
+				break;
+
 			case (system_integer_t) 'm':
 				option_media_type = optarg;
 
@@ -1406,6 +1441,23 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'O':
+				if( number_of_additional_target_filenames >= IMAGING_HANDLE_MAXIMUM_NUMBER_OF_ADDITIONAL_TARGETS )
+				{
+					ewfoutput_version_fprint(
+					 stdout,
+					 program );
+
+					fprintf(
+					 stderr,
+					 "Too many additional targets.\n" );
+
+					return( EXIT_FAILURE );
+				}
+				option_additional_target_filenames[ number_of_additional_target_filenames++ ] = optarg;
+
+				break;
+
 			case (system_integer_t) 'p':
 				option_process_buffer_size = optarg;
 
@@ -1499,6 +1551,13 @@ int main( int argc, char * const argv[] )
 			}
 		}
 	}
+	if( option_secondary_target_filename != NULL )
+	{
+		/* Use the chunk data functions so that every chunk is packed once
+		 * and the packed chunk data is written to both the primary and the secondary target
+		 */
+		use_chunk_data_functions = 1;
+	}
 	if( imaging_handle_initialize(
 	     &ewfacquirestream_imaging_handle,
 	     calculate_md5,
@@ -1585,6 +1644,42 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	for( target_index = 0;
+	     target_index < number_of_additional_target_filenames;
+	     target_index++ )
+	{
+		if( imaging_handle_append_additional_target_filename(
+		     ewfacquirestream_imaging_handle,
+		     option_additional_target_filenames[ target_index ],
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set additional target filename.\n" );
+
+			goto on_error;
+		}
+		/* Make sure we can write the additional target file
+		 */
+		if( imaging_handle_check_write_access(
+		     ewfacquirestream_imaging_handle,
+		     option_additional_target_filenames[ target_index ],
+		     &error ) != 1 )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			libcnotify_print_error_backtrace(
+			 error );
+#endif
+			libcerror_error_free(
+			 &error );
+
+			fprintf(
+			 stdout,
+			 "Unable to write additional target file.\n" );
+
+			goto on_error;
+		}
+	}
 	if( option_secondary_target_filename != NULL )
 	{
 		if( imaging_handle_set_string(
@@ -1956,7 +2051,7 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 		else if( ( result == 0 )
-		      || ( ewfacquirestream_imaging_handle->number_of_threads > (int) 32 ) )
+		      || ( ewfacquirestream_imaging_handle->number_of_threads > (int) IMAGING_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
 		{
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 			ewfacquirestream_imaging_handle->number_of_threads = 4;
@@ -1970,6 +2065,30 @@ int main( int argc, char * const argv[] )
 			 ewfacquirestream_imaging_handle->number_of_threads );
 		}
 	}
+	if( option_memory_limit != NULL )
+	{
+		result = imaging_handle_set_memory_limit(
+			  ewfacquirestream_imaging_handle,
+			  option_memory_limit,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set memory limit.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			ewfacquirestream_imaging_handle->memory_limit = 0;
+
+			fprintf(
+			 stderr,
+			 "Unsupported memory limit defaulting to: automatic.\n" );
+		}
+	}
 	if( option_additional_digest_types != NULL )
 	{
 		result = imaging_handle_set_additional_digest_types(
@@ -2083,6 +2202,32 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( telemetry_filename != NULL )
+	{
+		if( log_handle_initialize(
+		     &telemetry_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create telemetry handle.\n" );
+
+			goto on_error;
+		}
+		if( log_handle_open(
+		     telemetry_handle,
+		     telemetry_filename,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open telemetry file: %" PRIs_SYSTEM ".\n",
+			 telemetry_filename );
+
+			goto on_error;
+		}
+		ewfacquirestream_imaging_handle->telemetry_stream = telemetry_handle->log_stream;
+	}
 	result = ewfacquirestream_read_input(
 	          ewfacquirestream_imaging_handle,
 	          0,
@@ -2127,6 +2272,31 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( telemetry_handle != NULL )
+	{
+		ewfacquirestream_imaging_handle->telemetry_stream = NULL;
+
+		if( log_handle_close(
+		     telemetry_handle,
+		     &error ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to close telemetry handle.\n" );
+
+			goto on_error;
+		}
+		if( log_handle_free(
+		     &telemetry_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free telemetry handle.\n" );
+
+			goto on_error;
+		}
+	}
 	if( ewftools_signal_detach(
 	     &error ) != 1 )
 	{
@@ -2201,6 +2371,15 @@ on_error:
 		 &log_handle,
 		 NULL );
 	}
+	if( telemetry_handle != NULL )
+	{
+		log_handle_close(
+		 telemetry_handle,
+		 NULL );
+		log_handle_free(
+		 &telemetry_handle,
+		 NULL );
+	}
 	if( ewfacquirestream_imaging_handle != NULL )
 	{
 		imaging_handle_close(
@@ -113,9 +113,10 @@ void usage_fprint(
 
 	fprintf( stream, "Usage: ewfexport [ -A codepage ] [ -b number_of_sectors ]\n"
 	                 "                 [ -B number_of_bytes ] [ -c compression_values ]\n"
-	                 "                 [ -d digest_type ] [ -f format ] [ -j jobs ] [ -l log_filename ]\n"
-	                 "                 [ -o offset ] [ -p process_buffer_size ]\n"
-	                 "                 [ -S segment_file_size ] [ -t target ] [ -hqsuvVwx ] ewf_files\n\n" );
+	                 "                 [ -d digest_type ] [ -f format ] [ -j jobs ]\n"
+	                 "                 [ -J telemetry_file ] [ -l log_filename ]\n"
+	                 "                 [ -L memory_limit ] [ -o offset ] [ -p process_buffer_size ]\n"
+	                 "                 [ -S segment_file_size ] [ -t target ] [ -hqsuvVwxz ] ewf_files\n\n" );
 
 	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n\n" );
 
@@ -146,11 +147,22 @@ void usage_fprint(
 	                 "\t           encase7, encase7-v2, linen5, linen6, linen7, ewfx\n" );
 	fprintf( stream, "\t-h:        shows this help\n" );
 	fprintf( stream, "\t-j:        the number of concurrent processing jobs (threads), where\n"
-	                 "\t           a number of 0 represents single-threaded mode (default is 4\n"
-	                 "\t           if multi-threaded mode is supported)\n" );
+	                 "\t           a number of 0 represents single-threaded mode and auto the\n"
+	                 "\t           number of processors (default is 4 if multi-threaded mode\n"
+	                 "\t           is supported), for the files format\n"
+	                 "\t           the files are exported concurrently\n" );
+	fprintf( stream, "\t-J:        writes a JSON object per line with the throughput per stage\n"
+	                 "\t           (read, process, hash and write), the buffer queue depths, the\n"
+	                 "\t           worker utilization, the compression ratio and the number of\n"
+	                 "\t           read errors to the telemetry_file every second, which can be\n"
+	                 "\t           a FIFO\n" );
 	fprintf( stream, "\t-l:        logs export errors and the digest (hash) to the log_filename\n" );
+	fprintf( stream, "\t-L:        specify the maximum amount of memory used by the buffers\n"
+	                 "\t           of the concurrent processing jobs (default is 512 MiB or\n"
+	                 "\t           a quarter of the physical memory if less)\n" );
 	fprintf( stream, "\t-o:        specify the offset to start the export (default is 0)\n" );
-	fprintf( stream, "\t-p:        specify the process buffer size (default is the chunk size)\n" );
+	fprintf( stream, "\t-p:        specify the process buffer size (default is the chunk size,\n"
+	                 "\t           1 MiB for the files format)\n" );
 	fprintf( stream, "\t-q:        quiet shows minimal status information\n" );
 	fprintf( stream, "\t-s:        swap byte pairs of the media data (from AB to BA)\n"
 	                 "\t           (use this for big to little endian conversion and vice\n"
@@ -188,6 +200,9 @@ void usage_fprint(
 	fprintf( stream, "\t-w:        zero sectors on checksum error (mimic EnCase like behavior)\n" );
 	fprintf( stream, "\t-x:        use the chunk data instead of the buffered read and write\n"
 	                 "\t           functions.\n" );
+	fprintf( stream, "\t-z:        create a sparse raw file, where empty blocks are not written\n"
+	                 "\t           but seeked over (only supported for the raw format and\n"
+	                 "\t           a single raw file)\n" );
 }
 
 /* Signal handler for ewfexport
@@ -251,13 +266,16 @@ int main( int argc, char * const argv[] )
 	system_character_t * const *source_filenames       = NULL;
 	libcerror_error_t *error                           = NULL;
 	log_handle_t *log_handle                           = NULL;
+	log_handle_t *telemetry_handle                     = NULL;
 	system_character_t *acquiry_software_version       = NULL;
 	system_character_t *log_filename                   = NULL;
+	system_character_t *telemetry_filename             = NULL;
 	system_character_t *option_additional_digest_types = NULL;
 	system_character_t *option_compression_values      = NULL;
 	system_character_t *option_format                  = NULL;
 	system_character_t *option_header_codepage         = NULL;
 	system_character_t *option_maximum_segment_size    = NULL;
+	system_character_t *option_memory_limit            = NULL;
 	system_character_t *option_number_of_jobs          = NULL;
 	system_character_t *option_offset                  = NULL;
 	system_character_t *option_process_buffer_size     = NULL;
@@ -269,6 +287,7 @@ int main( int argc, char * const argv[] )
 	system_integer_t option                            = 0;
 	uint8_t calculate_md5                              = 1;
 	uint8_t print_status_information                   = 1;
+	uint8_t sparse_output                              = 0;
 	uint8_t swap_byte_pairs                            = 0;
 	uint8_t use_chunk_data_functions                   = 0;
 	uint8_t verbose                                    = 0;
@@ -338,7 +357,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:b:B:c:d:f:hj:l:o:p:qsS:t:uvVwx" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:b:B:c:d:f:hj:J:l:L:o:p:qsS:t:uvVwxz" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -403,11 +422,21 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'J':
+				telemetry_filename = optarg;
+
+				break;
+
 			case (system_integer_t) 'l':
 				log_filename = optarg;
 
 				break;
 
+			case (system_integer_t) 'L':
+				option_memory_limit = optarg;
+
+				break;
+
 			case (system_integer_t) 'o':
 				option_offset = optarg;
 
@@ -466,6 +495,11 @@ int main( int argc, char * const argv[] )
 			case (system_integer_t) 'x':
 				use_chunk_data_functions = 1;
 
+				break;
+
+			case (system_integer_t) 'z':
+				sparse_output = 1;
+
 				break;
 		}
 	}
@@ -880,7 +914,7 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 		else if( ( result == 0 )
-		      || ( ewfexport_export_handle->number_of_threads > (int) 32 ) )
+		      || ( ewfexport_export_handle->number_of_threads > (int) EXPORT_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
 		{
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 			ewfexport_export_handle->number_of_threads = 4;
@@ -894,6 +928,30 @@ int main( int argc, char * const argv[] )
 			 ewfexport_export_handle->number_of_threads );
 		}
 	}
+	if( option_memory_limit != NULL )
+	{
+		result = export_handle_set_memory_limit(
+			  ewfexport_export_handle,
+			  option_memory_limit,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set memory limit.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			ewfexport_export_handle->memory_limit = 0;
+
+			fprintf(
+			 stderr,
+			 "Unsupported memory limit defaulting to: automatic.\n" );
+		}
+	}
 	if( option_additional_digest_types != NULL )
 	{
 		result = export_handle_set_additional_digest_types(
@@ -1216,6 +1274,32 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( telemetry_filename != NULL )
+	{
+		if( log_handle_initialize(
+		     &telemetry_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create telemetry handle.\n" );
+
+			goto on_error;
+		}
+		if( log_handle_open(
+		     telemetry_handle,
+		     telemetry_filename,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open telemetry file: %" PRIs_SYSTEM ".\n",
+			 telemetry_filename );
+
+			goto on_error;
+		}
+		ewfexport_export_handle->telemetry_stream = telemetry_handle->log_stream;
+	}
 	if( ewfexport_export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_FILES )
 	{
 		result = export_handle_export_single_files(
@@ -1250,6 +1334,25 @@ int main( int argc, char * const argv[] )
 
 			goto on_error;
 		}
+		result = export_handle_set_sparse_output(
+		          ewfexport_export_handle,
+		          sparse_output,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set sparse output.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Sparse output is only supported for a single raw file, defaulting to non-sparse output.\n" );
+		}
 		if( platform_get_operating_system(
 		     acquiry_operating_system,
 		     32,
@@ -1326,6 +1429,31 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( telemetry_handle != NULL )
+	{
+		ewfexport_export_handle->telemetry_stream = NULL;
+
+		if( log_handle_close(
+		     telemetry_handle,
+		     &error ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to close telemetry handle.\n" );
+
+			goto on_error;
+		}
+		if( log_handle_free(
+		     &telemetry_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free telemetry handle.\n" );
+
+			goto on_error;
+		}
+	}
 on_abort:
 	if( export_handle_close(
 	     ewfexport_export_handle,
@@ -1401,6 +1529,15 @@ on_error:
 		 &log_handle,
 		 NULL );
 	}
+	if( telemetry_handle != NULL )
+	{
+		log_handle_close(
+		 telemetry_handle,
+		 NULL );
+		log_handle_free(
+		 &telemetry_handle,
+		 NULL );
+	}
 	if( ewfexport_export_handle != NULL )
 	{
 		export_handle_close(
@@ -83,6 +83,8 @@
 #include "ewftools_unused.h"
 #include "mount_handle.h"
 
+#define EWFMOUNT_MAXIMUM_READ_SIZE	( 1024 * 1024 )
+
 mount_handle_t *ewfmount_mount_handle = NULL;
 int ewfmount_abort                    = 0;
 
@@ -98,8 +100,8 @@ void usage_fprint(
 	fprintf( stream, "Use ewfmount to mount the EWF format (Expert Witness\n"
                          "Compression Format)\n\n" );
 
-	fprintf( stream, "Usage: ewfmount [ -f format ] [ -X extended_options ] [ -hvV ]\n"
-	                 "                ewf_files mount_point\n\n" );
+	fprintf( stream, "Usage: ewfmount [ -f format ] [ -j jobs ] [ -X extended_options ]\n"
+	                 "                [ -hvV ] ewf_files mount_point\n\n" );
 
 	fprintf( stream, "\tewf_files:   the first or the entire set of EWF segment files\n\n" );
 	fprintf( stream, "\tmount_point: the directory to serve as mount point\n\n" );
@@ -107,6 +109,9 @@ void usage_fprint(
 	fprintf( stream, "\t-f:          specify the input format, options: raw (default),\n"
 	                 "\t             files (restricted to logical volume files)\n" );
 	fprintf( stream, "\t-h:          shows this help\n" );
+	fprintf( stream, "\t-j:          the number of concurrent read jobs (threads), where a\n"
+	                 "\t             number of 0 represents single-threaded mode (default is\n"
+	                 "\t             4 if multi-threaded mode is supported)\n" );
 	fprintf( stream, "\t-v:          verbose output to stderr\n"
 	                 "\t             ewfmount will remain running in the foreground\n" );
 	fprintf( stream, "\t-V:          print version\n" );
@@ -281,6 +286,10 @@ int ewfmount_fuse_open(
 
 		goto on_error;
 	}
+	/* The image is read-only hence the data cached by the kernel remains valid
+	 */
+	file_info->keep_cache = 1;
+
 	return( 0 );
 
 on_error:
@@ -383,27 +392,11 @@ int ewfmount_fuse_read(
 
 			goto on_error;
 		}
-		if( libewf_file_entry_seek_offset(
-		     file_entry,
-		     (off64_t) offset,
-		     SEEK_SET,
-		     &error ) == -1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset in file entry.",
-			 function );
-
-			result = -EIO;
-
-			goto on_error;
-		}
-		read_count = libewf_file_entry_read_buffer(
+		read_count = libewf_file_entry_read_buffer_at_offset(
 			      file_entry,
 			      (uint8_t *) buffer,
 			      size,
+			      (off64_t) offset,
 			      &error );
 
 		if( read_count == -1 )
@@ -485,27 +478,11 @@ int ewfmount_fuse_read(
 
 			goto on_error;
 		}
-		if( mount_handle_seek_offset(
-		     ewfmount_mount_handle,
-		     (off64_t) offset,
-		     SEEK_SET,
-		     &error ) == -1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset in mount handle.",
-			 function );
-
-			result = -EIO;
-
-			goto on_error;
-		}
-		read_count = mount_handle_read_buffer(
+		read_count = mount_handle_read_buffer_at_offset(
 			      ewfmount_mount_handle,
 			      (uint8_t *) buffer,
 			      size,
+			      (off64_t) offset,
 			      &error );
 
 		if( read_count == -1 )
@@ -1776,27 +1753,11 @@ int __stdcall ewfmount_dokan_ReadFile(
 
 			goto on_error;
 		}
-		if( libewf_file_entry_seek_offset(
-		     file_entry,
-		     (off64_t) offset,
-		     SEEK_SET,
-		     &error ) == -1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset in file entry.",
-			 function );
-
-			result = -ERROR_SEEK_ON_DEVICE;
-
-			goto on_error;
-		}
-		read_count = libewf_file_entry_read_buffer(
+		read_count = libewf_file_entry_read_buffer_at_offset(
 			      file_entry,
 			      (uint8_t *) buffer,
 			      (size_t) number_of_bytes_to_read,
+			      (off64_t) offset,
 			      &error );
 
 		if( read_count == -1 )
@@ -1878,27 +1839,11 @@ int __stdcall ewfmount_dokan_ReadFile(
 
 			goto on_error;
 		}
-		if( mount_handle_seek_offset(
-		     ewfmount_mount_handle,
-		     (off64_t) offset,
-		     SEEK_SET,
-		     &error ) == -1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset in mount handle.",
-			 function );
-
-			result = -ERROR_SEEK_ON_DEVICE;
-
-			goto on_error;
-		}
-		read_count = mount_handle_read_buffer(
+		read_count = mount_handle_read_buffer_at_offset(
 			      ewfmount_mount_handle,
 			      (uint8_t *) buffer,
 			      (size_t) number_of_bytes_to_read,
+			      (off64_t) offset,
 			      &error );
 
 		if( read_count == -1 )
@@ -3102,6 +3047,7 @@ int main( int argc, char * const argv[] )
 	system_character_t *mount_point              = NULL;
 	system_character_t *option_extended_options  = NULL;
 	system_character_t *option_format            = NULL;
+	system_character_t *option_number_of_jobs    = NULL;
 	system_character_t *program                  = _SYSTEM_STRING( "ewfmount" );
 	system_integer_t option                      = 0;
 	int number_of_filenames                      = 0;
@@ -3119,6 +3065,13 @@ int main( int argc, char * const argv[] )
 	struct fuse_chan *ewfmount_fuse_channel      = NULL;
 	struct fuse *ewfmount_fuse_handle            = NULL;
 
+#if defined( HAVE_LIBFUSE )
+	char fuse_mount_options[ 128 ];
+
+	size_t maximum_read_size                     = 0;
+	size32_t chunk_size                          = 0;
+#endif
+
 #elif defined( HAVE_LIBDOKAN )
 	DOKAN_OPERATIONS ewfmount_dokan_operations;
 	DOKAN_OPTIONS ewfmount_dokan_options;
@@ -3157,7 +3110,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "f:hvVX:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "f:hj:vVX:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -3184,6 +3137,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'j':
+				option_number_of_jobs = optarg;
+
+				break;
+
 			case (system_integer_t) 'v':
 				verbose = 1;
 
@@ -3306,6 +3264,35 @@ int main( int argc, char * const argv[] )
 			 "Unsupported input format defaulting to: raw.\n" );
 		}
 	}
+	if( option_number_of_jobs != NULL )
+	{
+		result = mount_handle_set_number_of_threads(
+			  ewfmount_mount_handle,
+			  option_number_of_jobs,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of jobs (threads).\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			ewfmount_mount_handle->number_of_threads = 4;
+#else
+			ewfmount_mount_handle->number_of_threads = 0;
+#endif
+
+			fprintf(
+			 stderr,
+			 "Unsupported number of jobs (threads) defaulting to: %d.\n",
+			 ewfmount_mount_handle->number_of_threads );
+		}
+	}
 #if defined( HAVE_GETRLIMIT )
 	if( getrlimit(
             RLIMIT_NOFILE,
@@ -3359,20 +3346,79 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
-	if( option_extended_options != NULL )
+	/* This argument is required but ignored
+	 */
+	if( fuse_opt_add_arg(
+	     &ewfmount_fuse_arguments,
+	     "" ) != 0 )
 	{
-		/* This argument is required but ignored
-		 */
-		if( fuse_opt_add_arg(
-		     &ewfmount_fuse_arguments,
-		     "" ) != 0 )
-		{
-			fprintf(
-			 stderr,
-			 "Unable add fuse arguments.\n" );
+		fprintf(
+		 stderr,
+		 "Unable add fuse arguments.\n" );
 
-			goto on_error;
-		}
+		goto on_error;
+	}
+#if defined( HAVE_LIBFUSE )
+	/* Allow the kernel to request large reads that are a multiple of the chunk size,
+	 * so that fewer reads are needed to read a range of chunks and the reads start
+	 * and end on a chunk boundary when the read ahead is chunk aligned.
+	 * The image does not change while mounted hence the kernel is allowed to cache
+	 * the data and attributes for as long as it wants
+	 */
+	if( mount_handle_get_chunk_size(
+	     ewfmount_mount_handle,
+	     &chunk_size,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve chunk size.\n" );
+
+		goto on_error;
+	}
+	maximum_read_size = EWFMOUNT_MAXIMUM_READ_SIZE;
+
+	if( ( chunk_size != 0 )
+	 && ( ( maximum_read_size % chunk_size ) != 0 ) )
+	{
+		maximum_read_size = ( ( maximum_read_size / chunk_size ) + 1 ) * chunk_size;
+	}
+	if( narrow_string_snprintf(
+	     fuse_mount_options,
+	     128,
+	     "max_read=%" PRIzu ",max_readahead=%" PRIzu ",kernel_cache,attr_timeout=86400,entry_timeout=86400,negative_timeout=86400",
+	     maximum_read_size,
+	     maximum_read_size ) < 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set fuse mount options.\n" );
+
+		goto on_error;
+	}
+	if( fuse_opt_add_arg(
+	     &ewfmount_fuse_arguments,
+	     "-o" ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable add fuse arguments.\n" );
+
+		goto on_error;
+	}
+	if( fuse_opt_add_arg(
+	     &ewfmount_fuse_arguments,
+	     fuse_mount_options ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable add fuse arguments.\n" );
+
+		goto on_error;
+	}
+#endif
+	if( option_extended_options != NULL )
+	{
 		if( fuse_opt_add_arg(
 		     &ewfmount_fuse_arguments,
 		     "-o" ) != 0 )
@@ -3439,8 +3485,19 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
-	result = fuse_loop(
-	          ewfmount_fuse_handle );
+	/* The multi-threaded loop serves concurrent reads, the reads of
+	 * the raw format are divided over the reader handles of the mount handle
+	 */
+	if( ewfmount_mount_handle->number_of_threads != 0 )
+	{
+		result = fuse_loop_mt(
+		          ewfmount_fuse_handle );
+	}
+	else
+	{
+		result = fuse_loop(
+		          ewfmount_fuse_handle );
+	}
 
 	if( result != 0 )
 	{
@@ -3482,9 +3539,14 @@ int main( int argc, char * const argv[] )
 		goto on_error;
 	}
 	ewfmount_dokan_options.Version     = 600;
-	ewfmount_dokan_options.ThreadCount = 0;
+	ewfmount_dokan_options.ThreadCount = 1;
 	ewfmount_dokan_options.MountPoint  = mount_point;
 
+	if( ewfmount_mount_handle->number_of_threads != 0 )
+	{
+		ewfmount_dokan_options.ThreadCount = (USHORT) ewfmount_mount_handle->number_of_threads;
+	}
+
 	if( verbose != 0 )
 	{
 		ewfmount_dokan_options.Options |= DOKAN_OPTION_STDERR;
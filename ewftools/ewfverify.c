@@ -50,9 +50,11 @@
 #include "ewftools_signal.h"
 #include "ewftools_unused.h"
 #include "log_handle.h"
+#include "verification_batch.h"
 #include "verification_handle.h"
 
 verification_handle_t *ewfverify_verification_handle = NULL;
+verification_batch_t *ewfverify_verification_batch   = NULL;
 int ewfverify_abort                                  = 0;
 
 /* Prints the executable usage information to the stream
@@ -67,9 +69,12 @@ void usage_fprint(
 	fprintf( stream, "Use ewfverify to verify data stored in the EWF format (Expert Witness\n"
 	                 "Compression Format).\n\n" );
 
-	fprintf( stream, "Usage: ewfverify [ -A codepage ] [ -d digest_type ] [ -f format ]\n"
-	                 "                 [ -j jobs ] [ -l log_filename ] [ -p process_buffer_size ]\n"
-	                 "                 [ -hqvVwx ] ewf_files\n\n" );
+	fprintf( stream, "Usage: ewfverify [ -A codepage ] [ -b concurrent_images ] [ -d digest_type ]\n"
+	                 "                 [ -f format ] [ -j jobs ] [ -J telemetry_file ]\n"
+	                 "                 [ -l log_filename ]\n"
+	                 "                 [ -L memory_limit ] [ -p process_buffer_size ]\n"
+	                 "                 [ -s sample ] [ -S seed ]\n"
+	                 "                 [ -chqvVwx ] ewf_files\n\n" );
 
 	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n\n" );
 
@@ -78,18 +83,40 @@ void usage_fprint(
 	                 "\t           windows-950, windows-1250, windows-1251, windows-1252,\n"
 	                 "\t           windows-1253, windows-1254, windows-1255, windows-1256,\n"
 	                 "\t           windows-1257 or windows-1258\n" );
+	fprintf( stream, "\t-b:        verify every ewf_files argument as the first segment file of\n"
+	                 "\t           a separate image, where concurrent_images is the maximum\n"
+	                 "\t           number of images that are verified concurrently (between 1\n"
+	                 "\t           and 32). The images share a single pool of processing jobs.\n" );
+	fprintf( stream, "\t-c:        only verify the checksums of the chunks, this does not\n"
+	                 "\t           calculate the digest (hash) of the media data and allows\n"
+	                 "\t           the chunks to be verified out of order, where every\n"
+	                 "\t           job reads a separate region of the chunks\n" );
 	fprintf( stream, "\t-d:        calculate additional digest (hash) types besides md5,\n"
 	                 "\t           options: sha1, sha256\n" );
 	fprintf( stream, "\t-f:        specify the input format, options: raw (default),\n"
 	                 "\t           files (restricted to logical volume files)\n" );
 	fprintf( stream, "\t-h:        shows this help\n" );
 	fprintf( stream, "\t-j:        the number of concurrent processing jobs (threads), where\n"
-	                 "\t           a number of 0 represents single-threaded mode (default is 4\n"
-	                 "\t           if multi-threaded mode is supported)\n" );
+	                 "\t           a number of 0 represents single-threaded mode and auto the\n"
+	                 "\t           number of processors (default is 4 if multi-threaded mode\n"
+	                 "\t           is supported)\n" );
+	fprintf( stream, "\t-J:        writes a JSON object per line with the throughput per stage\n"
+	                 "\t           (read, process, hash and write), the buffer queue depths, the\n"
+	                 "\t           worker utilization, the compression ratio and the number of\n"
+	                 "\t           read errors to the telemetry_file every second, which can be\n"
+	                 "\t           a FIFO\n" );
 	fprintf( stream, "\t-l:        logs verification errors and the digest (hash) to the\n"
 	                 "\t           log_filename\n" );
+	fprintf( stream, "\t-L:        specify the maximum amount of memory used by the buffers\n"
+	                 "\t           of the concurrent processing jobs (default is 512 MiB or\n"
+	                 "\t           a quarter of the physical memory if less)\n" );
 	fprintf( stream, "\t-p:        specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-q:        quiet shows minimal status information\n" );
+	fprintf( stream, "\t-s:        only verify the checksums of a sample of the chunks and\n"
+	                 "\t           estimate the corruption rate, where sample is formatted as:\n"
+	                 "\t           [random:|stratified:]number_of_chunks (default stratified)\n" );
+	fprintf( stream, "\t-S:        the seed of the sample, the same seed reproduces the same\n"
+	                 "\t           sample (default is based on the current time)\n" );
 	fprintf( stream, "\t-v:        verbose output to stderr\n" );
 	fprintf( stream, "\t-V:        print version\n" );
 	fprintf( stream, "\t-w:        zero sectors on checksum error (mimic EnCase like behavior)\n" );
@@ -125,6 +152,22 @@ void ewfverify_signal_handler(
 			 &error );
 		}
 	}
+	if( ewfverify_verification_batch != NULL )
+	{
+		if( verification_batch_signal_abort(
+		     ewfverify_verification_batch,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal verification batch to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
 	/* Force stdin to close otherwise any function reading it will remain blocked
 	 */
 #if defined( WINAPI ) && !defined( __CYGWIN__ )
@@ -156,18 +199,25 @@ int main( int argc, char * const argv[] )
 	system_character_t * const *source_filenames       = NULL;
 	libcerror_error_t *error                           = NULL;
 	log_handle_t *log_handle                           = NULL;
+	log_handle_t *telemetry_handle                     = NULL;
 	system_character_t *log_filename                   = NULL;
+	system_character_t *telemetry_filename             = NULL;
 	system_character_t *option_additional_digest_types = NULL;
+	system_character_t *option_concurrent_images       = NULL;
 	system_character_t *option_format                  = NULL;
 	system_character_t *option_header_codepage         = NULL;
+	system_character_t *option_memory_limit            = NULL;
 	system_character_t *option_number_of_jobs          = NULL;
 	system_character_t *option_process_buffer_size     = NULL;
+	system_character_t *option_sample                  = NULL;
+	system_character_t *option_sample_seed             = NULL;
 	system_character_t *program                        = _SYSTEM_STRING( "ewfverify" );
 	system_integer_t option                            = 0;
 	uint8_t calculate_md5                              = 1;
 	uint8_t print_status_information                   = 1;
 	uint8_t use_chunk_data_functions                   = 0;
 	uint8_t verbose                                    = 0;
+	uint8_t verify_chunks_only                         = 0;
 	uint8_t zero_chunk_on_error                        = 0;
 	int number_of_filenames                            = 0;
 	int result                                         = 0;
@@ -209,7 +259,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:d:f:j:hl:p:qvVwx" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:b:cd:f:j:J:hl:L:p:qs:S:vVwx" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -230,6 +280,16 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'b':
+				option_concurrent_images = optarg;
+
+				break;
+
+			case (system_integer_t) 'c':
+				verify_chunks_only = 1;
+
+				break;
+
 			case (system_integer_t) 'd':
 				option_additional_digest_types = optarg;
 
@@ -251,11 +311,21 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'J':
+				telemetry_filename = optarg;
+
+				break;
+
 			case (system_integer_t) 'l':
 				log_filename = optarg;
 
 				break;
 
+			case (system_integer_t) 'L':
+				option_memory_limit = optarg;
+
+				break;
+
 			case (system_integer_t) 'p':
 				option_process_buffer_size = optarg;
 
@@ -266,6 +336,16 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 's':
+				option_sample = optarg;
+
+				break;
+
+			case (system_integer_t) 'S':
+				option_sample_seed = optarg;
+
+				break;
+
 			case (system_integer_t) 'v':
 				verbose = 1;
 
@@ -406,7 +486,7 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 		else if( ( result == 0 )
-		      || ( ewfverify_verification_handle->number_of_threads > (int) 32 ) )
+		      || ( ewfverify_verification_handle->number_of_threads > (int) VERIFICATION_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
 		{
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 			ewfverify_verification_handle->number_of_threads = 4;
@@ -420,6 +500,30 @@ int main( int argc, char * const argv[] )
 			 ewfverify_verification_handle->number_of_threads );
 		}
 	}
+	if( option_memory_limit != NULL )
+	{
+		result = verification_handle_set_memory_limit(
+			  ewfverify_verification_handle,
+			  option_memory_limit,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set memory limit.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			ewfverify_verification_handle->memory_limit = 0;
+
+			fprintf(
+			 stderr,
+			 "Unsupported memory limit defaulting to: automatic.\n" );
+		}
+	}
 	if( option_additional_digest_types != NULL )
 	{
 		result = verification_handle_set_additional_digest_types(
@@ -436,6 +540,133 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( verify_chunks_only != 0 )
+	{
+		if( ewfverify_verification_handle->input_format == VERIFICATION_HANDLE_INPUT_FORMAT_FILES )
+		{
+			fprintf(
+			 stderr,
+			 "Verifying only the chunks is not supported for the files input format.\n" );
+
+			goto on_error;
+		}
+		if( verification_handle_set_verify_chunks_only(
+		     ewfverify_verification_handle,
+		     verify_chunks_only,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set verify chunks only.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_sample != NULL )
+	{
+		if( ewfverify_verification_handle->input_format == VERIFICATION_HANDLE_INPUT_FORMAT_FILES )
+		{
+			fprintf(
+			 stderr,
+			 "Verifying a sample is not supported for the files input format.\n" );
+
+			goto on_error;
+		}
+		result = verification_handle_set_sample(
+			  ewfverify_verification_handle,
+			  option_sample,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set sample.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported sample defaulting to: all chunks.\n" );
+		}
+	}
+	if( option_sample_seed != NULL )
+	{
+		result = verification_handle_set_sample_seed(
+			  ewfverify_verification_handle,
+			  option_sample_seed,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set sample seed.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported sample seed defaulting to: current time.\n" );
+		}
+	}
+	if( option_concurrent_images != NULL )
+	{
+		if( ewfverify_verification_handle->input_format == VERIFICATION_HANDLE_INPUT_FORMAT_FILES )
+		{
+			fprintf(
+			 stderr,
+			 "Verifying multiple images is not supported for the files input format.\n" );
+
+			goto on_error;
+		}
+		if( verification_batch_initialize(
+		     &ewfverify_verification_batch,
+		     ewfverify_verification_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create verification batch.\n" );
+
+			goto on_error;
+		}
+		result = verification_batch_set_maximum_number_of_concurrent_images(
+			  ewfverify_verification_batch,
+			  option_concurrent_images,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set maximum number of concurrent images.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported maximum number of concurrent images defaulting to: %d.\n",
+			 ewfverify_verification_batch->maximum_number_of_concurrent_images );
+		}
+		if( verification_batch_set_zero_chunk_on_error(
+		     ewfverify_verification_batch,
+		     zero_chunk_on_error,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set zero on chunk error.\n" );
+
+			goto on_error;
+		}
+	}
 #if !defined( HAVE_GLOB_H )
 	if( ewftools_glob_initialize(
 	     &glob,
@@ -504,6 +735,20 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( ewfverify_verification_batch != NULL )
+	{
+		if( verification_batch_set_maximum_number_of_open_handles(
+		     ewfverify_verification_batch,
+		     (int) limit_data.rlim_max,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set maximum number of open file handles.\n" );
+
+			goto on_error;
+		}
+	}
 #endif
 	if( ewftools_signal_attach(
 	     ewfverify_signal_handler,
@@ -518,46 +763,49 @@ int main( int argc, char * const argv[] )
 		libcerror_error_free(
 		 &error );
 	}
-	result = verification_handle_open_input(
-	          ewfverify_verification_handle,
-	          source_filenames,
-	          number_of_filenames,
-	          &error );
-
-	if( ewfverify_abort != 0 )
+	if( ewfverify_verification_batch == NULL )
 	{
-		goto on_abort;
-	}
-	if( result != 1 )
-	{
-		fprintf(
-		 stderr,
-		 "Unable to open EWF image file(s).\n" );
+		result = verification_handle_open_input(
+		          ewfverify_verification_handle,
+		          source_filenames,
+		          number_of_filenames,
+		          &error );
 
-		goto on_error;
-	}
+		if( ewfverify_abort != 0 )
+		{
+			goto on_abort;
+		}
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open EWF image file(s).\n" );
+
+			goto on_error;
+		}
 #if !defined( HAVE_GLOB_H )
-	if( ewftools_glob_free(
-	     &glob,
-	     &error ) != 1 )
-	{
-		fprintf(
-		 stderr,
-		 "Unable to free glob.\n" );
+		if( ewftools_glob_free(
+		     &glob,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free glob.\n" );
 
-		goto on_error;
-	}
+			goto on_error;
+		}
 #endif
-	if( verification_handle_set_zero_chunk_on_error(
-	     ewfverify_verification_handle,
-	     zero_chunk_on_error,
-	     &error ) != 1 )
-	{
-		fprintf(
-		 stderr,
-		 "Unable to set zero on chunk error.\n" );
+		if( verification_handle_set_zero_chunk_on_error(
+		     ewfverify_verification_handle,
+		     zero_chunk_on_error,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set zero on chunk error.\n" );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
 	if( log_filename != NULL )
 	{
@@ -584,7 +832,54 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
-	if( ewfverify_verification_handle->input_format == VERIFICATION_HANDLE_INPUT_FORMAT_FILES )
+	if( telemetry_filename != NULL )
+	{
+		if( log_handle_initialize(
+		     &telemetry_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create telemetry handle.\n" );
+
+			goto on_error;
+		}
+		if( log_handle_open(
+		     telemetry_handle,
+		     telemetry_filename,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open telemetry file: %" PRIs_SYSTEM ".\n",
+			 telemetry_filename );
+
+			goto on_error;
+		}
+		ewfverify_verification_handle->telemetry_stream = telemetry_handle->log_stream;
+	}
+	if( ewfverify_verification_batch != NULL )
+	{
+		result = verification_batch_verify_images(
+		          ewfverify_verification_batch,
+		          source_filenames,
+		          number_of_filenames,
+		          log_handle,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to verify images.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	else if( ewfverify_verification_handle->input_format == VERIFICATION_HANDLE_INPUT_FORMAT_FILES )
 	{
 		result = verification_handle_verify_single_files(
 		          ewfverify_verification_handle,
@@ -647,6 +942,31 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( telemetry_handle != NULL )
+	{
+		ewfverify_verification_handle->telemetry_stream = NULL;
+
+		if( log_handle_close(
+		     telemetry_handle,
+		     &error ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to close telemetry handle.\n" );
+
+			goto on_error;
+		}
+		if( log_handle_free(
+		     &telemetry_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free telemetry handle.\n" );
+
+			goto on_error;
+		}
+	}
 on_abort:
 	if( ewftools_signal_detach(
 	     &error ) != 1 )
@@ -660,9 +980,37 @@ on_abort:
 		libcerror_error_free(
 		 &error );
 	}
-	if( verification_handle_close(
-	     ewfverify_verification_handle,
-	     &error ) != 0 )
+#if !defined( HAVE_GLOB_H )
+	if( glob != NULL )
+	{
+		if( ewftools_glob_free(
+		     &glob,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free glob.\n" );
+
+			goto on_error;
+		}
+	}
+#endif
+	if( ewfverify_verification_batch != NULL )
+	{
+		if( verification_batch_free(
+		     &ewfverify_verification_batch,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free verification batch.\n" );
+
+			goto on_error;
+		}
+	}
+	else if( verification_handle_close(
+	          ewfverify_verification_handle,
+	          &error ) != 0 )
 	{
 		fprintf(
 		 stderr,
@@ -723,6 +1071,21 @@ on_error:
 		 &log_handle,
 		 NULL );
 	}
+	if( telemetry_handle != NULL )
+	{
+		log_handle_close(
+		 telemetry_handle,
+		 NULL );
+		log_handle_free(
+		 &telemetry_handle,
+		 NULL );
+	}
+	if( ewfverify_verification_batch != NULL )
+	{
+		verification_batch_free(
+		 &ewfverify_verification_batch,
+		 NULL );
+	}
 	if( ewfverify_verification_handle != NULL )
 	{
 		verification_handle_close(
@@ -51,16 +51,21 @@
 #include "ewftools_libhmac.h"
 #include "ewftools_system_string.h"
 #include "export_handle.h"
+#include "file_export_job.h"
 #include "guid.h"
+#include "platform.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "storage_media_buffer_reorder.h"
 
-#define EXPORT_HANDLE_BUFFER_SIZE		8192
+#define EXPORT_HANDLE_FILE_ENTRY_BUFFER_SIZE	( 1024 * 1024 )
 #define EXPORT_HANDLE_INPUT_BUFFER_SIZE		64
 #define EXPORT_HANDLE_STRING_SIZE		1024
 #define EXPORT_HANDLE_NOTIFY_STREAM		stderr
 
+#define EXPORT_HANDLE_MAXIMUM_NUMBER_OF_QUEUED_FILE_EXPORT_JOBS	4096
+
 /* Creates an export handle
  * Make sure the value export_handle is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
@@ -1110,8 +1115,11 @@ ssize_t export_handle_write_storage_media_buffer(
          size_t write_size,
          libcerror_error_t **error )
 {
-	static char *function = "export_handle_write_storage_media_buffer";
-	ssize_t write_count   = 0;
+	static char *function    = "export_handle_write_storage_media_buffer";
+	size_t packed_data_size  = 0;
+	ssize_t write_count      = 0;
+	uint64_t stage_timestamp = 0;
+	int result               = 0;
 
 	if( export_handle == NULL )
 	{
@@ -1128,6 +1136,23 @@ ssize_t export_handle_write_storage_media_buffer(
 	{
 		return( 0 );
 	}
+if( export_handle->process_status != NULL )
+{
+	if( process_status_get_stage_timestamp(
+	     export_handle->process_status,
+	     &stage_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve stage timestamp.",
+		 function );
+
+		return( -1 );
+	}
+}
 	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
 	{
 		write_count = storage_media_buffer_write_to_handle(
@@ -1165,6 +1190,67 @@ ssize_t export_handle_write_storage_media_buffer(
 		}
 		else
 		{
+			if( export_handle->sparse_output != 0 )
+			{
+				/* The empty state was determined from the packed data of the chunks if available
+				 * otherwise the data is scanned for 0-byte values
+				 */
+				if( storage_media_buffer->empty_state == STORAGE_MEDIA_BUFFER_EMPTY_STATE_EMPTY )
+				{
+					result = 1;
+				}
+				else if( storage_media_buffer->empty_state == STORAGE_MEDIA_BUFFER_EMPTY_STATE_NOT_EMPTY )
+				{
+					result = 0;
+				}
+				else
+				{
+					result = export_handle_is_empty_block(
+					          export_handle,
+					          storage_media_buffer->raw_buffer,
+					          write_size,
+					          error );
+
+					if( result == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_GENERIC,
+						 "%s: unable to determine if storage media buffer is empty.",
+						 function );
+
+						return( -1 );
+					}
+				}
+				/* Empty blocks are not written but seeked over when the next block is written
+				 */
+				if( result != 0 )
+				{
+					export_handle->sparse_pending_size += write_size;
+
+					return( (ssize_t) write_size );
+				}
+				if( export_handle->sparse_pending_size > 0 )
+				{
+					if( libsmraw_handle_seek_offset(
+					     export_handle->raw_output_handle,
+					     (off64_t) export_handle->sparse_pending_size,
+					     SEEK_CUR,
+					     error ) == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_SEEK_FAILED,
+						 "%s: unable to seek over empty blocks in raw output.",
+						 function );
+
+						return( -1 );
+					}
+					export_handle->sparse_pending_size = 0;
+				}
+			}
 			write_count = libsmraw_handle_write_buffer(
 				       export_handle->raw_output_handle,
 				       storage_media_buffer->raw_buffer,
@@ -1183,6 +1269,69 @@ ssize_t export_handle_write_storage_media_buffer(
 
 		return( -1 );
 	}
+if( export_handle->process_status != NULL )
+{
+	if( process_status_add_stage_value(
+	     export_handle->process_status,
+	     PROCESS_STATUS_STAGE_WRITE,
+	     (size64_t) write_count,
+	     stage_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to add write stage value.",
+		 function );
+
+		return( -1 );
+	}
+}
+	/* The chunk data was compressed before the write, which allows to determine
+	 * the compression ratio
+	 */
+	if( ( export_handle->process_status != NULL )
+	 && ( export_handle->process_status->telemetry_stream != NULL )
+	 && ( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+	 && ( storage_media_buffer != NULL )
+	 && ( storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA ) )
+	{
+		result = libewf_data_chunk_get_packed_data_size(
+		          storage_media_buffer->data_chunk,
+		          &packed_data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve packed data size.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			if( process_status_add_compression_values(
+			     export_handle->process_status,
+			     (size64_t) write_count,
+			     (size64_t) packed_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to add compression values.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
 	return( write_count );
 }
 
@@ -1225,6 +1374,81 @@ off64_t export_handle_seek_offset(
 	return( offset );
 }
 
+/* Determines if a buffer only contains 0-byte values
+ * Returns 1 if empty, 0 if not or -1 on error
+ */
+int export_handle_is_empty_block(
+     export_handle_t *export_handle,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_is_empty_block";
+	size_t buffer_offset  = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* Compare the unaligned start of the buffer per byte and the remainder per 64-bit value
+	 */
+	while( ( buffer_offset < buffer_size )
+	    && ( ( (intptr_t) &( buffer[ buffer_offset ] ) % sizeof( uint64_t ) ) != 0 ) )
+	{
+		if( buffer[ buffer_offset ] != 0 )
+		{
+			return( 0 );
+		}
+		buffer_offset++;
+	}
+	while( ( buffer_offset + sizeof( uint64_t ) ) <= buffer_size )
+	{
+		if( *( (uint64_t *) &( buffer[ buffer_offset ] ) ) != 0 )
+		{
+			return( 0 );
+		}
+		buffer_offset += sizeof( uint64_t );
+	}
+	while( buffer_offset < buffer_size )
+	{
+		if( buffer[ buffer_offset ] != 0 )
+		{
+			return( 0 );
+		}
+		buffer_offset++;
+	}
+	return( 1 );
+}
+
 /* Swaps the byte order of byte pairs within a buffer of a certain size
  * Returns 1 if successful, -1 on error
  */
@@ -1394,7 +1618,8 @@ int export_handle_update_integrity_hash(
      size_t buffer_size,
      libcerror_error_t **error )
 {
-	static char *function = "export_handle_update_integrity_hash";
+	static char *function    = "export_handle_update_integrity_hash";
+	uint64_t stage_timestamp = 0;
 
 	if( export_handle == NULL )
 	{
@@ -1430,6 +1655,23 @@ int export_handle_update_integrity_hash(
 
 		return( -1 );
 	}
+if( export_handle->process_status != NULL )
+{
+	if( process_status_get_stage_timestamp(
+	     export_handle->process_status,
+	     &stage_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve stage timestamp.",
+		 function );
+
+		return( -1 );
+	}
+}
 	if( export_handle->calculate_md5 != 0 )
 	{
 		if( libhmac_md5_update(
@@ -1484,6 +1726,25 @@ int export_handle_update_integrity_hash(
 			return( -1 );
 		}
 	}
+if( export_handle->process_status != NULL )
+{
+	if( process_status_add_stage_value(
+	     export_handle->process_status,
+	     PROCESS_STATUS_STAGE_HASH,
+	     (size64_t) buffer_size,
+	     stage_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to add hash stage value.",
+		 function );
+
+		return( -1 );
+	}
+}
 	return( 1 );
 }
 
@@ -1688,6 +1949,122 @@ int export_handle_input_is_corrupted(
 	return( result );
 }
 
+/* Determines if the stored chunks of the input can be copied to the output without being recompressed
+ * This requires EWF output with a segment file layout, chunk size and compression method
+ * that are the same as those of the input
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_determine_chunk_passthrough(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function             = "export_handle_determine_chunk_passthrough";
+	size32_t output_chunk_size        = 0;
+	uint64_t export_end_offset        = 0;
+	uint16_t input_compression_method = 0;
+	uint8_t input_format              = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->chunk_passthrough = 0;
+
+	if( ( export_handle->output_format != EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+	 || ( export_handle->ewf_output_handle == NULL )
+	 || ( export_handle->swap_byte_pairs != 0 ) )
+	{
+		return( 1 );
+	}
+	if( export_handle->input_chunk_size == 0 )
+	{
+		return( 1 );
+	}
+	/* The data chunks are read from the start of a chunk
+	 */
+	export_end_offset = export_handle->export_offset + export_handle->export_size;
+
+	if( ( ( export_handle->export_offset % export_handle->input_chunk_size ) != 0 )
+	 || ( ( ( export_end_offset % export_handle->input_chunk_size ) != 0 )
+	  &&  ( export_end_offset != (uint64_t) export_handle->input_media_size ) ) )
+	{
+		return( 1 );
+	}
+	if( libewf_handle_get_chunk_size(
+	     export_handle->ewf_output_handle,
+	     &output_chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve output chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_chunk_size != export_handle->input_chunk_size )
+	{
+		return( 1 );
+	}
+	if( libewf_handle_get_compression_method(
+	     export_handle->input_handle,
+	     &input_compression_method,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input compression method.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_compression_method != export_handle->compression_method )
+	{
+		return( 1 );
+	}
+	if( libewf_handle_get_format(
+	     export_handle->input_handle,
+	     &input_format,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input format.",
+		 function );
+
+		return( -1 );
+	}
+	/* The EWF version 1 formats, except for SMART, store the chunks in the same way
+	 */
+	if( input_format != export_handle->ewf_format )
+	{
+		if( ( input_format == LIBEWF_FORMAT_SMART )
+		 || ( input_format == LIBEWF_FORMAT_V2_ENCASE7 )
+		 || ( input_format == LIBEWF_FORMAT_V2_LOGICAL_ENCASE7 )
+		 || ( export_handle->ewf_format == LIBEWF_FORMAT_SMART )
+		 || ( export_handle->ewf_format == LIBEWF_FORMAT_V2_ENCASE7 ) )
+		{
+			return( 1 );
+		}
+	}
+	export_handle->chunk_passthrough = 1;
+
+	return( 1 );
+}
+
 /* Retrieves the chunk size
  * Returns 1 if successful or -1 on error
  */
@@ -3171,6 +3548,7 @@ int export_handle_set_number_of_threads(
 	static char *function      = "export_handle_set_number_of_threads";
 	size_t string_length       = 0;
 	uint64_t number_of_threads = 0;
+	int number_of_processors   = 0;
 	int result                 = 0;
 
 	if( export_handle == NULL )
@@ -3187,32 +3565,63 @@ int export_handle_set_number_of_threads(
 	string_length = system_string_length(
 	                 string );
 
-	if( string[ 0 ] != (system_character_t) '-' )
+	if( ( string_length == 4 )
+	 && ( system_string_compare(
+	       string,
+	       _SYSTEM_STRING( "auto" ),
+	       4 ) == 0 ) )
 	{
-		string_length = system_string_length(
-				 string );
+		/* Use a thread per processor, if the number of processors cannot
+		 * be determined the current number of threads is retained
+		 */
+		result = platform_get_number_of_processors(
+		          &number_of_processors,
+		          error );
 
-		if( ewftools_system_string_decimal_copy_to_64_bit(
-		     string,
-		     string_length + 1,
-		     &number_of_threads,
-		     error ) != 1 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine number of threads.",
+			 "%s: unable to determine number of processors.",
 			 function );
 
 			return( -1 );
 		}
-		result = 1;
-
-		if( number_of_threads > 32 )
+		else if( result != 0 )
 		{
-			result = 0;
-		}
+			if( number_of_processors > EXPORT_HANDLE_MAXIMUM_NUMBER_OF_THREADS )
+			{
+				number_of_processors = EXPORT_HANDLE_MAXIMUM_NUMBER_OF_THREADS;
+			}
+			export_handle->number_of_threads = number_of_processors;
+		}
+		result = 1;
+	}
+	else if( string[ 0 ] != (system_character_t) '-' )
+	{
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine number of threads.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+
+		if( number_of_threads > EXPORT_HANDLE_MAXIMUM_NUMBER_OF_THREADS )
+		{
+			result = 0;
+		}
 		else
 		{
 			export_handle->number_of_threads = (int) number_of_threads;
@@ -3221,6 +3630,64 @@ int export_handle_set_number_of_threads(
 	return( result );
 }
 
+/* Sets the memory limit of the storage media buffers
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int export_handle_set_memory_limit(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function  = "export_handle_set_memory_limit";
+	size_t string_length   = 0;
+	uint64_t size_variable = 0;
+	int result             = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	result = byte_size_string_convert(
+	          string,
+	          string_length,
+	          &size_variable,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine memory limit.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( size_variable == 0 )
+		{
+			result = 0;
+		}
+		else
+		{
+			export_handle->memory_limit = (size64_t) size_variable;
+		}
+	}
+	return( result );
+}
+
 /* Sets the additional digest types
  * Returns 1 if successful or -1 on error
  */
@@ -3519,6 +3986,52 @@ on_error:
 	return( -1 );
 }
 
+/* Sets if the raw output should be written as a sparse file
+ * A sparse file is only supported for raw output to a single file
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int export_handle_set_sparse_output(
+     export_handle_t *export_handle,
+     uint8_t sparse_output,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_sparse_output";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->sparse_output       = 0;
+	export_handle->sparse_pending_size = 0;
+
+	if( sparse_output == 0 )
+	{
+		return( 1 );
+	}
+	if( ( export_handle->output_format != EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
+	 || ( export_handle->use_stdout != 0 ) )
+	{
+		return( 0 );
+	}
+	/* Empty blocks at the end of a segment file cannot be seeked over
+	 */
+	if( ( export_handle->maximum_segment_size != 0 )
+	 && ( export_handle->maximum_segment_size < export_handle->export_size ) )
+	{
+		return( 0 );
+	}
+	export_handle->sparse_output = 1;
+
+	return( 1 );
+}
+
 /* Sets the output values of the export handle
  * Returns 1 if successful or -1 on error
  */
@@ -4175,9 +4688,121 @@ int export_handle_append_read_error(
 			return( -1 );
 		}
 	}
+	if( export_handle->process_status != NULL )
+	{
+		if( process_status_add_read_errors(
+		     export_handle->process_status,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add read error.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Appends a checksum error of a corrupted chunk to the input handle
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_append_checksum_error(
+      export_handle_t *export_handle,
+      off64_t start_offset,
+      size_t number_of_bytes,
+      libcerror_error_t **error )
+{
+	static char *function      = "export_handle_append_checksum_error";
+	uint64_t start_sector      = 0;
+	uint64_t number_of_sectors = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid export handle - invalid bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	start_sector      = start_offset / export_handle->bytes_per_sector;
+	number_of_sectors = number_of_bytes / export_handle->bytes_per_sector;
+
+	if( ( number_of_bytes % export_handle->bytes_per_sector ) != 0 )
+	{
+		number_of_sectors += 1;
+	}
+	if( libewf_handle_append_checksum_error(
+	     export_handle->input_handle,
+	     start_sector,
+	     number_of_sectors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append checksum error.",
+		 function );
+
+		return( -1 );
+	}
 	return( 1 );
 }
 
+/* Determines if packed data can be written to the output without being recompressed
+ * A compressed chunk requires compression of the output, an uncompressed chunk requires
+ * no compression and no empty block or pattern fill compression of the output
+ * Returns 1 if compatible or 0 if not
+ */
+int export_handle_is_packed_data_compatible(
+     export_handle_t *export_handle,
+     uint32_t packed_data_flags )
+{
+	if( export_handle == NULL )
+	{
+		return( 0 );
+	}
+	if( ( packed_data_flags & LIBEWF_DATA_CHUNK_FLAG_USES_PATTERN_FILL ) != 0 )
+	{
+		if( ( export_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 )
+		{
+			return( 1 );
+		}
+	}
+	else if( ( packed_data_flags & LIBEWF_DATA_CHUNK_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		if( export_handle->compression_level != LIBEWF_COMPRESSION_NONE )
+		{
+			return( 1 );
+		}
+	}
+	else if( ( export_handle->compression_level == LIBEWF_COMPRESSION_NONE )
+	      && ( ( export_handle->compression_flags & ( LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION | LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION ) ) == 0 ) )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
 /* Writes a storage media buffer to the export handle
  * Returns the number of input bytes written or -1 on error
  */
@@ -4193,6 +4818,8 @@ ssize_t export_handle_write(
 	size_t write_size     = 0;
 	ssize_t process_count = 0;
 	ssize_t write_count   = 0;
+	uint8_t empty_state   = 0;
+	int result            = 0;
 
 	if( export_handle == NULL )
 	{
@@ -4246,6 +4873,66 @@ ssize_t export_handle_write(
 			{
 				write_size = export_handle->output_chunk_size - output_storage_media_buffer->raw_buffer_data_size;
 			}
+			/* Copy the stored chunk if it contains the entire output chunk
+			 */
+			if( ( export_handle->chunk_passthrough != 0 )
+			 && ( output_storage_media_buffer->raw_buffer_data_size == 0 )
+			 && ( write_size == input_size )
+			 && ( input_storage_media_buffer->is_corrupted == 0 )
+			 && ( input_storage_media_buffer->packed_data_size > 0 )
+			 && ( input_storage_media_buffer->packed_data_size <= ( (size_t) export_handle->output_chunk_size + 4 ) ) )
+			{
+				result = export_handle_is_packed_data_compatible(
+				          export_handle,
+				          input_storage_media_buffer->packed_data_flags );
+			}
+			else
+			{
+				result = 0;
+			}
+			if( result != 0 )
+			{
+				process_count = storage_media_buffer_write_packed_process(
+				                 output_storage_media_buffer,
+				                 input_storage_media_buffer->packed_buffer,
+				                 input_storage_media_buffer->packed_data_size,
+				                 write_size,
+				                 input_storage_media_buffer->packed_data_flags,
+				                 error );
+
+				if( process_count < 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write packed data to output storage media buffer.",
+					 function );
+
+					return( -1 );
+				}
+				write_count = export_handle_write_storage_media_buffer(
+					       export_handle,
+					       output_storage_media_buffer,
+					       process_count,
+					       error );
+
+				if( write_count < 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write storage media buffer.",
+					 function );
+
+					return( -1 );
+				}
+				input_size  -= process_count;
+				write_count += process_count;
+
+				continue;
+			}
 			input_buffer = input_storage_media_buffer->raw_buffer;
 
 			if( memory_copy(
@@ -4262,6 +4949,31 @@ ssize_t export_handle_write(
 
 				return( -1 );
 			}
+			/* The output chunk only is empty if all the input data it contains is empty
+			 */
+			empty_state = input_storage_media_buffer->empty_state;
+
+			if( ( empty_state == STORAGE_MEDIA_BUFFER_EMPTY_STATE_NOT_EMPTY )
+			 && ( write_size != input_storage_media_buffer->processed_size ) )
+			{
+				empty_state = STORAGE_MEDIA_BUFFER_EMPTY_STATE_UNKNOWN;
+			}
+			if( output_storage_media_buffer->raw_buffer_data_size == 0 )
+			{
+				output_storage_media_buffer->empty_state = empty_state;
+			}
+			else if( ( output_storage_media_buffer->empty_state != STORAGE_MEDIA_BUFFER_EMPTY_STATE_NOT_EMPTY )
+			      && ( output_storage_media_buffer->empty_state != empty_state ) )
+			{
+				if( empty_state == STORAGE_MEDIA_BUFFER_EMPTY_STATE_NOT_EMPTY )
+				{
+					output_storage_media_buffer->empty_state = STORAGE_MEDIA_BUFFER_EMPTY_STATE_NOT_EMPTY;
+				}
+				else
+				{
+					output_storage_media_buffer->empty_state = STORAGE_MEDIA_BUFFER_EMPTY_STATE_UNKNOWN;
+				}
+			}
 			output_storage_media_buffer->raw_buffer_data_size += write_size;
 
 			/* Make sure the output chunk is filled upto the output chunk size
@@ -4348,6 +5060,7 @@ ssize_t export_handle_finalize(
 {
 	static char *function = "export_handle_finalize";
 	ssize_t write_count   = 0;
+	uint8_t empty_byte    = 0;
 
 	if( export_handle == NULL )
 	{
@@ -4438,14 +5151,54 @@ ssize_t export_handle_finalize(
 			return( -1 );
 		}
 	}
-	return( write_count );
-}
-
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	else if( ( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
+	      && ( export_handle->use_stdout == 0 ) )
+	{
+		/* Write the last byte of trailing empty blocks so the sparse raw output has the full media size
+		 */
+		if( export_handle->sparse_pending_size > 0 )
+		{
+			if( libsmraw_handle_seek_offset(
+			     export_handle->raw_output_handle,
+			     (off64_t) export_handle->sparse_pending_size - 1,
+			     SEEK_CUR,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to seek over empty blocks in raw output.",
+				 function );
 
-/* Prepares a storage media buffer for export
- * Callback function for the process thread pool
- * Returns 1 if successful or -1 on error
+				return( -1 );
+			}
+			if( libsmraw_handle_write_buffer(
+			     export_handle->raw_output_handle,
+			     &empty_byte,
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write last empty byte to raw output.",
+				 function );
+
+				return( -1 );
+			}
+			export_handle->sparse_pending_size = 0;
+		}
+	}
+	return( write_count );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Prepares a storage media buffer for export
+ * Callback function for the process thread pool
+ * Returns 1 if successful or -1 on error
  */
 int export_handle_process_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
@@ -4454,6 +5207,7 @@ int export_handle_process_storage_media_buffer_callback(
         libcerror_error_t *error = NULL;
         static char *function    = "export_handle_process_storage_media_buffer_callback";
 	ssize_t process_count    = 0;
+	uint64_t stage_timestamp = 0;
 
 	if( storage_media_buffer == NULL )
 	{
@@ -4466,6 +5220,23 @@ int export_handle_process_storage_media_buffer_callback(
 
 		goto on_error;
 	}
+	if( export_handle->process_status != NULL )
+	{
+		if( process_status_get_stage_timestamp(
+		     export_handle->process_status,
+		     &stage_timestamp,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve stage timestamp.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	process_count = storage_media_buffer_read_process(
 			 storage_media_buffer,
 			 &error );
@@ -4500,11 +5271,46 @@ int export_handle_process_storage_media_buffer_callback(
 			goto on_error;
 		}
 	}
-	if( libcthreads_thread_pool_push_sorted(
+	else if( storage_media_buffer->is_corrupted != 0 )
+	{
+		if( export_handle_append_checksum_error(
+		     export_handle,
+		     storage_media_buffer->storage_media_offset,
+		     storage_media_buffer->processed_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append checksum error.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( export_handle->process_status != NULL )
+	{
+		if( process_status_add_stage_value(
+		     export_handle->process_status,
+		     PROCESS_STATUS_STAGE_PROCESS,
+		     (size64_t) process_count,
+		     stage_timestamp,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add process stage value.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_thread_pool_push(
 	     export_handle->output_thread_pool,
 	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCTHREADS_SORT_FLAG_UNIQUE_VALUES,
 	     &error ) != 1 )
 	{
 		libcerror_error_set(
@@ -4563,14 +5369,13 @@ int export_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      export_handle_t *export_handle )
 {
-	libcdata_list_element_t *element                    = NULL;
-	libcdata_list_element_t *next_element               = NULL;
         libcerror_error_t *error                            = NULL;
 	storage_media_buffer_t *output_storage_media_buffer = NULL;
 	uint8_t *data                                       = NULL;
         static char *function                               = "export_handle_process_storage_media_buffer_callback";
 	size_t data_size                                    = 0;
 	ssize_t write_count                                 = 0;
+	int result                                          = 0;
 
 	if( export_handle == NULL )
 	{
@@ -4594,68 +5399,42 @@ int export_handle_output_storage_media_buffer_callback(
 
 		goto on_error;
 	}
-	if( libcdata_list_insert_value(
-	     export_handle->output_list,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
+	if( storage_media_buffer_reorder_insert_buffer(
+	     export_handle->output_reorder,
+	     storage_media_buffer,
 	     &error ) != 1 )
 	{
 		libcerror_error_set(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert storage media buffer into output list.",
+		 "%s: unable to insert storage media buffer into output reorder window.",
 		 function );
 
 		goto on_error;
 	}
 	storage_media_buffer = NULL;
 
-	if( libcdata_list_get_first_element(
-	     export_handle->output_list,
-	     &element,
-	     &error ) != 1 )
+	do
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
+		result = storage_media_buffer_reorder_remove_buffer(
+		          export_handle->output_reorder,
+		          export_handle->last_offset_hashed,
+		          &storage_media_buffer,
+		          &error );
 
-		goto on_error;
-	}
-	while( element != NULL )
-	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     &error ) != 1 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove storage media buffer from output reorder window.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
-
-			return( -1 );
-		}
-		if( storage_media_buffer->storage_media_offset != export_handle->last_offset_hashed )
+		else if( result == 0 )
 		{
 			break;
 		}
@@ -4672,8 +5451,6 @@ int export_handle_output_storage_media_buffer_callback(
 			 "%s: unable to determine storage media buffer data.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
 		/* Swap byte pairs
@@ -4693,8 +5470,6 @@ int export_handle_output_storage_media_buffer_callback(
 				 "%s: unable to swap byte pairs.",
 				 function );
 
-				storage_media_buffer = NULL;
-
 				goto on_error;
 			}
 		}
@@ -4713,8 +5488,6 @@ int export_handle_output_storage_media_buffer_callback(
 			 "%s: unable to update integrity hash(es).",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
 		export_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
@@ -4735,8 +5508,6 @@ int export_handle_output_storage_media_buffer_callback(
 				 "%s: unable to create output storage media buffer.",
 				 function );
 
-				storage_media_buffer = NULL;
-
 				goto on_error;
 			}
 		}
@@ -4756,56 +5527,6 @@ int export_handle_output_storage_media_buffer_callback(
 			 "%s: unable to write to export handle.",
 			 function );
 
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		if( libcdata_list_remove_element(
-		     export_handle->output_list,
-		     element,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
-
 			goto on_error;
 		}
 /* TODO: if storage media buffer can be passed on do not release it */
@@ -4842,8 +5563,19 @@ int export_handle_output_storage_media_buffer_callback(
 				goto on_error;
 			}
 		}
-		element = next_element;
+		if( export_handle_set_telemetry_buffer_values(
+		     export_handle,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set telemetry buffer values.",
+			 function );
 
+			goto on_error;
+		}
 		if( process_status_update(
 		     export_handle->process_status,
 		     export_handle->last_offset_hashed,
@@ -4860,6 +5592,8 @@ int export_handle_output_storage_media_buffer_callback(
 			goto on_error;
 		}
 	}
+	while( result == 1 );
+
 	return( 1 );
 
 on_error:
@@ -4904,17 +5638,15 @@ on_error:
 	return( -1 );
 }
 
-/* Empties the output list
+/* Sets the storage media buffer values of the telemetry
  * Returns 1 if successful or -1 on error
  */
-int export_handle_empty_output_list(
+int export_handle_set_telemetry_buffer_values(
      export_handle_t *export_handle,
      libcerror_error_t **error )
 {
-	libcdata_list_element_t *element             = NULL;
-	libcdata_list_element_t *next_element        = NULL;
-	storage_media_buffer_t *storage_media_buffer = NULL;
-        static char *function                        = "export_handle_empty_output_list";
+	static char *function        = "export_handle_set_telemetry_buffer_values";
+	int number_of_buffers_in_use = 0;
 
 	if( export_handle == NULL )
 	{
@@ -4927,108 +5659,42 @@ int export_handle_empty_output_list(
 
 		return( -1 );
 	}
-	if( libcdata_list_get_first_element(
-	     export_handle->output_list,
-	     &element,
+	if( ( export_handle->process_status == NULL )
+	 || ( export_handle->process_status->telemetry_stream == NULL )
+	 || ( export_handle->storage_media_buffer_queue == NULL )
+	 || ( export_handle->output_reorder == NULL ) )
+	{
+		return( 1 );
+	}
+	if( storage_media_buffer_queue_get_number_of_buffers_in_use(
+	     export_handle->storage_media_buffer_queue,
+	     &number_of_buffers_in_use,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
+		 "%s: unable to retrieve number of storage media buffers in use.",
 		 function );
 
 		return( -1 );
 	}
-	while( element != NULL )
+	if( process_status_set_buffer_values(
+	     export_handle->process_status,
+	     number_of_buffers_in_use,
+	     export_handle->storage_media_buffer_queue->number_of_buffers,
+	     export_handle->output_reorder->number_of_buffers,
+	     error ) != 1 )
 	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
-
-			return( -1 );
-		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
-
-			return( -1 );
-		}
-		if( storage_media_buffer_queue_release_buffer(
-		     export_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
-			 function );
-
-			return( -1 );
-		}
-		storage_media_buffer = NULL;
-
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
-
-			return( -1 );
-		}
-		if( libcdata_list_remove_element(
-		     export_handle->output_list,
-		     element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
-
-			return( -1 );
-		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set process status buffer values.",
+		 function );
 
-			return( -1 );
-		}
-		element = next_element;
+		return( -1 );
 	}
 	return( 1 );
 }
@@ -5057,6 +5723,7 @@ int export_handle_export_input(
 	ssize_t process_count                               = 0;
 	ssize_t read_count                                  = 0;
 	ssize_t write_count                                 = 0;
+	uint64_t stage_timestamp                            = 0;
 	uint8_t storage_media_buffer_mode                   = 0;
 	int maximum_number_of_queued_items                  = 0;
 	int status                                          = PROCESS_STATUS_COMPLETED;
@@ -5159,6 +5826,33 @@ int export_handle_export_input(
 			goto on_error;
 		}
 	}
+	export_handle->swap_byte_pairs = swap_byte_pairs;
+
+	if( export_handle_determine_chunk_passthrough(
+	     export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if chunks can be copied without recompression.",
+		 function );
+
+		goto on_error;
+	}
+	/* Copying the stored chunks requires the chunk data functions
+	 */
+	if( export_handle->chunk_passthrough != 0 )
+	{
+		export_handle->use_chunk_data_functions = 1;
+	}
+	/* Determining empty chunks from their packed data requires the chunk data functions
+	 */
+	if( export_handle->sparse_output != 0 )
+	{
+		export_handle->use_chunk_data_functions = 1;
+	}
 	if( export_handle->use_chunk_data_functions != 0 )
 	{
 		if( export_handle_get_output_chunk_size(
@@ -5204,7 +5898,22 @@ int export_handle_export_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 	if( export_handle->number_of_threads != 0 )
 	{
-		maximum_number_of_queued_items = 1 + ( ( 512 * 1024 * 1024 ) / process_buffer_size );
+		if( storage_media_buffer_queue_get_maximum_number_of_values(
+		     export_handle->memory_limit,
+		     process_buffer_size,
+		     export_handle->number_of_threads,
+		     &maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine maximum number of queued items.",
+			 function );
+
+			goto on_error;
+		}
 
 		if( libcthreads_thread_pool_create(
 		     &( export_handle->input_process_thread_pool ),
@@ -5242,15 +5951,17 @@ int export_handle_export_input(
 
 			goto on_error;
 		}
-		if( libcdata_list_initialize(
-		     &( export_handle->output_list ),
+		if( storage_media_buffer_reorder_initialize(
+		     &( export_handle->output_reorder ),
+		     maximum_number_of_queued_items,
+		     process_buffer_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create output list.",
+			 "%s: unable to create output reorder window.",
 			 function );
 
 			goto on_error;
@@ -5274,8 +5985,6 @@ int export_handle_export_input(
 		}
 	}
 #endif
-	export_handle->swap_byte_pairs = swap_byte_pairs;
-
 	if( export_handle_initialize_integrity_hash(
 	     export_handle,
 	     error ) != 1 )
@@ -5307,6 +6016,21 @@ int export_handle_export_input(
 
 		goto on_error;
 	}
+	if( process_status_set_telemetry(
+	     export_handle->process_status,
+	     export_handle->telemetry_stream,
+	     export_handle->number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set process status telemetry.",
+		 function );
+
+		goto on_error;
+	}
 	if( process_status_start(
 	     export_handle->process_status,
 	     error ) != 1 )
@@ -5338,6 +6062,8 @@ int export_handle_export_input(
 
 			goto on_error;
 		}
+		input_storage_media_buffer->retain_packed_data  = export_handle->chunk_passthrough;
+		input_storage_media_buffer->detect_empty_chunks = export_handle->sparse_output;
 	}
 	remaining_export_size = (size64_t) export_handle->export_size;
 
@@ -5375,6 +6101,8 @@ int export_handle_export_input(
 
 				goto on_error;
 			}
+			input_storage_media_buffer->retain_packed_data  = export_handle->chunk_passthrough;
+			input_storage_media_buffer->detect_empty_chunks = export_handle->sparse_output;
 		}
 #endif
 		read_size = process_buffer_size;
@@ -5383,6 +6111,23 @@ int export_handle_export_input(
 		{
 			read_size = (size_t) remaining_export_size;
 		}
+		if( export_handle->process_status != NULL )
+		{
+			if( process_status_get_stage_timestamp(
+			     export_handle->process_status,
+			     &stage_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve stage timestamp.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		read_count = storage_media_buffer_read_from_handle(
 		              input_storage_media_buffer,
 		              export_handle->input_handle,
@@ -5416,6 +6161,25 @@ int export_handle_export_input(
 		input_storage_media_offset += read_count;
 		remaining_export_size      -= read_count;
 
+		if( export_handle->process_status != NULL )
+		{
+			if( process_status_add_stage_value(
+			     export_handle->process_status,
+			     PROCESS_STATUS_STAGE_READ,
+			     (size64_t) read_count,
+			     stage_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to add read stage value.",
+				 function );
+
+				goto on_error;
+			}
+		}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( export_handle->number_of_threads != 0 )
 		{
@@ -5438,6 +6202,23 @@ int export_handle_export_input(
 		else
 #endif
 		{
+			if( export_handle->process_status != NULL )
+			{
+				if( process_status_get_stage_timestamp(
+				     export_handle->process_status,
+				     &stage_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve stage timestamp.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			process_count = storage_media_buffer_read_process(
 			                 input_storage_media_buffer,
 			                 error );
@@ -5473,6 +6254,43 @@ int export_handle_export_input(
 					goto on_error;
 				}
 			}
+			else if( input_storage_media_buffer->is_corrupted != 0 )
+			{
+				if( export_handle_append_checksum_error(
+				     export_handle,
+				     input_storage_media_buffer->storage_media_offset,
+				     input_storage_media_buffer->processed_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append checksum error.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( export_handle->process_status != NULL )
+			{
+				if( process_status_add_stage_value(
+				     export_handle->process_status,
+				     PROCESS_STATUS_STAGE_PROCESS,
+				     (size64_t) process_count,
+				     stage_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to add process stage value.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			if( storage_media_buffer_get_data(
 			     input_storage_media_buffer,
 			     &data,
@@ -5647,31 +6465,17 @@ int export_handle_export_input(
 			goto on_error;
 		}
 	}
-	if( export_handle->output_list != NULL )
+	if( export_handle->output_reorder != NULL )
 	{
-		if( export_handle_empty_output_list(
-		     export_handle,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
-			 function );
-
-			goto on_error;
-		}
-		if( libcdata_list_free(
-		     &( export_handle->output_list ),
-		     NULL,
+		if( storage_media_buffer_reorder_free(
+		     &( export_handle->output_reorder ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
+			 "%s: unable to free output reorder window.",
 			 function );
 
 			goto on_error;
@@ -5856,14 +6660,10 @@ on_error:
 		 &( export_handle->output_thread_pool ),
 		 NULL );
 	}
-	if( export_handle->output_list != NULL )
+	if( export_handle->output_reorder != NULL )
 	{
-		export_handle_empty_output_list(
-		 export_handle,
-		 NULL );
-		libcdata_list_free(
-		 &( export_handle->output_list ),
-		 NULL,
+		storage_media_buffer_reorder_free(
+		 &( export_handle->output_reorder ),
 		 NULL );
 	}
 	if( export_handle->storage_media_buffer_queue != NULL )
@@ -5972,6 +6772,21 @@ int export_handle_export_single_files(
 
 		goto on_error;
 	}
+	if( process_status_set_telemetry(
+	     export_handle->process_status,
+	     export_handle->telemetry_stream,
+	     export_handle->number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set process status telemetry.",
+		 function );
+
+		goto on_error;
+	}
 	if( process_status_start(
 	     export_handle->process_status,
 	     error ) != 1 )
@@ -6010,23 +6825,113 @@ int export_handle_export_single_files(
 	 "Created directory: %" PRIs_SYSTEM ".\n",
 	 export_handle->target_path );
 
+	export_handle->number_of_file_export_errors = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The directories are created while walking the file entries, the data
+	 * of the files is exported by the file export thread pool, which picks
+	 * the queued files in order of their media data offset
+	 */
+	if( export_handle->number_of_threads != 0 )
+	{
+		if( libcthreads_mutex_initialize(
+		     &( export_handle->file_export_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file export mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_thread_pool_create(
+		     &( export_handle->file_export_thread_pool ),
+		     NULL,
+		     export_handle->number_of_threads,
+		     EXPORT_HANDLE_MAXIMUM_NUMBER_OF_QUEUED_FILE_EXPORT_JOBS,
+		     (int (*)(intptr_t *, void *)) &export_handle_file_export_job_callback,
+		     (void *) export_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize file export thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 	result = export_handle_export_file_entry(
 	          export_handle,
-	          file_entry,
+	          &file_entry,
 	          export_handle->target_path,
 	          export_path_size,
 	          export_path_size - 1,
 	          log_handle,
 	          error );
 
-	if( result == -1 )
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to export root file entry.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->file_export_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( export_handle->file_export_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join file export thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( export_handle->file_export_mutex != NULL )
+	{
+		if( libcthreads_mutex_free(
+		     &( export_handle->file_export_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file export mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	if( export_handle->number_of_file_export_errors > 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GENERIC,
-		 "%s: unable to export root file entry.",
-		 function );
+		 "%s: unable to export data of %d file entries.",
+		 function,
+		 export_handle->number_of_file_export_errors );
 
 		goto on_error;
 	}
@@ -6078,6 +6983,20 @@ int export_handle_export_single_files(
 	return( 1 );
 
 on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->file_export_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( export_handle->file_export_thread_pool ),
+		 NULL );
+	}
+	if( export_handle->file_export_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( export_handle->file_export_mutex ),
+		 NULL );
+	}
+#endif
 	if( export_handle->process_status != NULL )
 	{
 		process_status_stop(
@@ -6099,25 +7018,31 @@ on_error:
 }
 
 /* Exports a (single) file entry
+ * If the data of the file entry is exported by the file export thread pool
+ * the file entry is taken over and set to NULL
  * Returns 1 if successful, 0 if not or -1 on error
  */
 int export_handle_export_file_entry(
      export_handle_t *export_handle,
-     libewf_file_entry_t *file_entry,
+     libewf_file_entry_t **file_entry,
      const system_character_t *export_path,
      size_t export_path_size,
      size_t file_entry_path_index,
      log_handle_t *log_handle,
      libcerror_error_t **error )
 {
-	system_character_t *name        = NULL;
-	system_character_t *target_path = NULL;
-	static char *function           = "export_handle_export_file_entry";
-	size_t name_size                = 0;
-	size_t target_path_size         = 0;
-	uint8_t file_entry_type         = 0;
-	int result                      = 0;
-	int return_value                = 0;
+	system_character_t *name           = NULL;
+	system_character_t *target_path    = NULL;
+	static char *function              = "export_handle_export_file_entry";
+	size_t name_size                   = 0;
+	size_t target_path_size            = 0;
+	uint8_t file_entry_type            = 0;
+	int result                         = 0;
+	int return_value                   = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	file_export_job_t *file_export_job = NULL;
+#endif
 
 	if( export_handle == NULL )
 	{
@@ -6130,7 +7055,8 @@ int export_handle_export_file_entry(
 
 		return( -1 );
 	}
-	if( file_entry == NULL )
+	if( ( file_entry == NULL )
+	 || ( *file_entry == NULL ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -6142,7 +7068,7 @@ int export_handle_export_file_entry(
 		return( -1 );
 	}
 	if( libewf_file_entry_get_type(
-	     file_entry,
+	     *file_entry,
 	     &file_entry_type,
 	     error ) != 1 )
 	{
@@ -6157,12 +7083,12 @@ int export_handle_export_file_entry(
 	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	result = libewf_file_entry_get_utf16_name_size(
-	          file_entry,
+	          *file_entry,
 	          &name_size,
 	          error );
 #else
 	result = libewf_file_entry_get_utf8_name_size(
-	          file_entry,
+	          *file_entry,
 	          &name_size,
 	          error );
 #endif
@@ -6195,13 +7121,13 @@ int export_handle_export_file_entry(
 		}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 		result = libewf_file_entry_get_utf16_name(
-		          file_entry,
+		          *file_entry,
 		          (uint16_t *) name,
 		          name_size,
 		          error );
 #else
 		result = libewf_file_entry_get_utf8_name(
-		          file_entry,
+		          *file_entry,
 		          (uint8_t *) name,
 		          name_size,
 		          error );
@@ -6325,39 +7251,68 @@ int export_handle_export_file_entry(
 			}
 			/* TODO what about NTFS streams ?
 			 */
-			fprintf(
-			 export_handle->notify_stream,
-			 "Single file: %" PRIs_SYSTEM "\n",
-			 &( target_path[ file_entry_path_index ] ) );
-
-			return_value = export_handle_export_file_entry_data(
-				        export_handle,
-			                file_entry,
-			                target_path,
-			                error );
-
-			if( return_value == -1 )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			if( export_handle->file_export_thread_pool != NULL )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GENERIC,
-				 "%s: unable to export file entry data.",
-				 function );
+				if( file_export_job_initialize(
+				     &file_export_job,
+				     *file_entry,
+				     target_path,
+				     file_entry_path_index,
+				     log_handle,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create file export job.",
+					 function );
 
-				goto on_error;
+					goto on_error;
+				}
+				*file_entry = NULL;
+				target_path = NULL;
+
+				if( libcthreads_thread_pool_push_sorted(
+				     export_handle->file_export_thread_pool,
+				     (intptr_t *) file_export_job,
+				     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &file_export_job_compare,
+				     0,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to push file export job onto file export thread pool queue.",
+					 function );
+
+					goto on_error;
+				}
+				file_export_job = NULL;
 			}
-			if( return_value == 0 )
+			else
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 			{
-				fprintf(
-				 export_handle->notify_stream,
-				 "FAILED\n" );
-
-				if( log_handle != NULL )
+				return_value = export_handle_export_single_file(
+				                export_handle,
+				                *file_entry,
+				                target_path,
+				                file_entry_path_index,
+				                log_handle,
+				                error );
+
+				if( return_value == -1 )
 				{
-					log_handle_printf(
-					 log_handle,
-					 "FAILED\n" );
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to export single file.",
+					 function );
+
+					goto on_error;
 				}
 			}
 		}
@@ -6402,7 +7357,7 @@ int export_handle_export_file_entry(
 	{
 		result = export_handle_export_file_entry_sub_file_entries(
 		          export_handle,
-		          file_entry,
+		          *file_entry,
 		          target_path,
 		          target_path_size,
 		          file_entry_path_index,
@@ -6425,7 +7380,8 @@ int export_handle_export_file_entry(
 			return_value = 0;
 		}
 	}
-	if( target_path != export_path )
+	if( ( target_path != NULL )
+	 && ( target_path != export_path ) )
 	{
 		memory_free(
 		 target_path );
@@ -6433,6 +7389,14 @@ int export_handle_export_file_entry(
 	return( return_value );
 
 on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( file_export_job != NULL )
+	{
+		file_export_job_free(
+		 &file_export_job,
+		 NULL );
+	}
+#endif
 	if( ( target_path != NULL )
 	 && ( target_path != export_path ) )
 	{
@@ -6447,6 +7411,228 @@ on_error:
 	return( -1 );
 }
 
+/* Exports a single file
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int export_handle_export_single_file(
+     export_handle_t *export_handle,
+     libewf_file_entry_t *file_entry,
+     const system_character_t *target_path,
+     size_t file_entry_path_index,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_export_single_file";
+	int result            = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid target path.",
+		 function );
+
+		return( -1 );
+	}
+	result = export_handle_export_file_entry_data(
+	          export_handle,
+	          file_entry,
+	          target_path,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to export file entry data.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->file_export_mutex != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     export_handle->file_export_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab file export mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	fprintf(
+	 export_handle->notify_stream,
+	 "Single file: %" PRIs_SYSTEM "\n",
+	 &( target_path[ file_entry_path_index ] ) );
+
+	if( result == 0 )
+	{
+		fprintf(
+		 export_handle->notify_stream,
+		 "FAILED\n" );
+
+		if( log_handle != NULL )
+		{
+			log_handle_printf(
+			 log_handle,
+			 "Single file: %" PRIs_SYSTEM "\n",
+			 &( target_path[ file_entry_path_index ] ) );
+
+			log_handle_printf(
+			 log_handle,
+			 "FAILED\n" );
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->file_export_mutex != NULL )
+	{
+		if( libcthreads_mutex_release(
+		     export_handle->file_export_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release file export mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	return( result );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Exports the single file of a file export job
+ * Callback function for the file export thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_file_export_job_callback(
+     file_export_job_t *file_export_job,
+     export_handle_t *export_handle )
+{
+        libcerror_error_t *error = NULL;
+        static char *function    = "export_handle_file_export_job_callback";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_export_job == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file export job.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle->abort == 0 )
+	{
+		if( export_handle_export_single_file(
+		     export_handle,
+		     file_export_job->file_entry,
+		     file_export_job->target_path,
+		     file_export_job->file_entry_path_index,
+		     file_export_job->log_handle,
+		     &error ) == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to export single file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( file_export_job_free(
+	     &file_export_job,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file export job.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_export_job != NULL )
+	{
+		file_export_job_free(
+		 &file_export_job,
+		 NULL );
+	}
+	if( export_handle != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     export_handle->file_export_mutex,
+		     NULL ) == 1 )
+		{
+			export_handle->number_of_file_export_errors += 1;
+
+			libcthreads_mutex_release(
+			 export_handle->file_export_mutex,
+			 NULL );
+		}
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 /* Exports the data of a (single) file entry
  * Returns 1 if successful, 0 if not or -1 on error
  */
@@ -6460,7 +7646,7 @@ int export_handle_export_file_entry_data(
 	uint8_t *file_entry_data      = NULL;
 	static char *function         = "export_handle_export_file_entry_data";
 	size64_t file_entry_data_size = 0;
-	size_t process_buffer_size    = EXPORT_HANDLE_BUFFER_SIZE;
+	size_t process_buffer_size    = EXPORT_HANDLE_FILE_ENTRY_BUFFER_SIZE;
 	size_t read_size              = 0;
 	ssize_t read_count            = 0;
 	ssize_t write_count           = 0;
@@ -6578,13 +7764,16 @@ int export_handle_export_file_entry_data(
 	 */
 	if( file_entry_data_size > 0 )
 	{
-		if( export_handle->process_buffer_size == 0 )
+		/* The file entry data is read and written in large blocks to reduce
+		 * the number of read and write calls per file
+		 */
+		if( export_handle->process_buffer_size != 0 )
 		{
-			process_buffer_size = export_handle->input_chunk_size;
+			process_buffer_size = export_handle->process_buffer_size;
 		}
-		else
+		if( (size64_t) process_buffer_size > file_entry_data_size )
 		{
-			process_buffer_size = export_handle->process_buffer_size;
+			process_buffer_size = (size_t) file_entry_data_size;
 		}
 		/* This function in not necessary for normal use
 		 * but it was added for testing
@@ -6620,9 +7809,9 @@ int export_handle_export_file_entry_data(
 		}
 		while( file_entry_data_size > 0 )
 		{
-			if( file_entry_data_size >= EXPORT_HANDLE_BUFFER_SIZE )
+			if( file_entry_data_size >= (size64_t) process_buffer_size )
 			{
-				read_size = EXPORT_HANDLE_BUFFER_SIZE;
+				read_size = process_buffer_size;
 			}
 			else
 			{
@@ -6767,6 +7956,10 @@ int export_handle_export_file_entry_sub_file_entries(
 	     sub_file_entry_index < number_of_sub_file_entries;
 	     sub_file_entry_index++ )
 	{
+		if( export_handle->abort != 0 )
+		{
+			break;
+		}
 		if( libewf_file_entry_get_sub_file_entry(
 		     file_entry,
 		     sub_file_entry_index,
@@ -6785,7 +7978,7 @@ int export_handle_export_file_entry_sub_file_entries(
 		}
 		result = export_handle_export_file_entry(
 		          export_handle,
-		          sub_file_entry,
+		          &sub_file_entry,
 		          export_path,
 		          export_path_size,
 		          file_entry_path_index,
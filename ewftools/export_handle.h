@@ -32,14 +32,21 @@
 #include "ewftools_libewf.h"
 #include "ewftools_libhmac.h"
 #include "ewftools_libsmraw.h"
+#include "file_export_job.h"
 #include "log_handle.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+#include "storage_media_buffer_reorder.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+/* The maximum number of threads in the process thread pool
+ */
+#define EXPORT_HANDLE_MAXIMUM_NUMBER_OF_THREADS	256
+
 enum EXPORT_HANDLE_OUTPUT_FORMATS
 {
 	EXPORT_HANDLE_OUTPUT_FORMAT_EWF		= (int) 'e',
@@ -155,6 +162,10 @@ struct export_handle
 	 */
 	uint8_t use_chunk_data_functions;
 
+	/* Value to indicate if the stored chunks should be copied without being recompressed
+	 */
+	uint8_t chunk_passthrough;
+
 	/* The process buffer size
 	 */
 	size_t process_buffer_size;
@@ -163,6 +174,10 @@ struct export_handle
 	 */
 	int number_of_threads;
 
+	/* The memory limit of the storage media buffers, 0 represents the default
+	 */
+	size64_t memory_limit;
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
 	/* The input process thread pool
@@ -173,16 +188,28 @@ struct export_handle
 	 */
 	libcthreads_thread_pool_t *output_thread_pool;
 
-	/* The output list
+	/* The output reorder window
 	 */
-	libcdata_list_t *output_list;
+	storage_media_buffer_reorder_t *output_reorder;
 
 	/* The storage media buffer queue
 	 */
-	libcthreads_queue_t *storage_media_buffer_queue;
+	storage_media_buffer_queue_t *storage_media_buffer_queue;
+
+	/* The file export thread pool
+	 */
+	libcthreads_thread_pool_t *file_export_thread_pool;
+
+	/* The mutex that protects the notification output and log of the file export
+	 */
+	libcthreads_mutex_t *file_export_mutex;
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
+	/* The number of file entries that could not be exported due to an error
+	 */
+	int number_of_file_export_errors;
+
 	/* The libewf input handle
 	 */
 	libewf_handle_t *input_handle;
@@ -231,6 +258,14 @@ struct export_handle
 	 */
 	uint8_t swap_byte_pairs;
 
+	/* Value to indicate if the raw output should be written as a sparse file
+	 */
+	uint8_t sparse_output;
+
+	/* The number of empty bytes that were skipped but not yet seeked over in the sparse raw output
+	 */
+	size64_t sparse_pending_size;
+
 	/* The last offset hashed
 	 */
 	off64_t last_offset_hashed;
@@ -243,6 +278,10 @@ struct export_handle
 	 */
 	process_status_t *process_status;
 
+	/* The telemetry stream
+	 */
+	FILE *telemetry_stream;
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
@@ -310,6 +349,12 @@ off64_t export_handle_seek_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+int export_handle_is_empty_block(
+     export_handle_t *export_handle,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
 int export_handle_swap_byte_pairs(
      export_handle_t *export_handle,
      uint8_t *buffer,
@@ -334,6 +379,10 @@ int export_handle_input_is_corrupted(
      export_handle_t *export_handle,
      libcerror_error_t **error );
 
+int export_handle_determine_chunk_passthrough(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
 int export_handle_get_output_chunk_size(
      export_handle_t *export_handle,
      size32_t *chunk_size,
@@ -433,11 +482,21 @@ int export_handle_set_number_of_threads(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int export_handle_set_memory_limit(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int export_handle_set_additional_digest_types(
      export_handle_t *export_handle,
      const system_character_t *string,
      libcerror_error_t **error );
 
+int export_handle_set_sparse_output(
+     export_handle_t *export_handle,
+     uint8_t sparse_output,
+     libcerror_error_t **error );
+
 int export_handle_set_output_values(
      export_handle_t *export_handle,
      system_character_t *acquiry_operating_system,
@@ -461,6 +520,16 @@ int export_handle_append_read_error(
       size_t number_of_bytes,
       libcerror_error_t **error );
 
+int export_handle_append_checksum_error(
+      export_handle_t *export_handle,
+      off64_t start_offset,
+      size_t number_of_bytes,
+      libcerror_error_t **error );
+
+int export_handle_is_packed_data_compatible(
+     export_handle_t *export_handle,
+     uint32_t packed_data_flags );
+
 ssize_t export_handle_write(
          export_handle_t *export_handle,
          storage_media_buffer_t *input_storage_media_buffer,
@@ -482,7 +551,7 @@ int export_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      export_handle_t *export_handle );
 
-int export_handle_empty_output_list(
+int export_handle_set_telemetry_buffer_values(
      export_handle_t *export_handle,
      libcerror_error_t **error );
 
@@ -504,13 +573,29 @@ int export_handle_export_single_files(
 
 int export_handle_export_file_entry(
      export_handle_t *export_handle,
-     libewf_file_entry_t *file_entry,
+     libewf_file_entry_t **file_entry,
      const system_character_t *export_path,
      size_t export_path_size,
      size_t file_entry_path_index,
      log_handle_t *log_handle,
      libcerror_error_t **error );
 
+int export_handle_export_single_file(
+     export_handle_t *export_handle,
+     libewf_file_entry_t *file_entry,
+     const system_character_t *target_path,
+     size_t file_entry_path_index,
+     log_handle_t *log_handle,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int export_handle_file_export_job_callback(
+     file_export_job_t *file_export_job,
+     export_handle_t *export_handle );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 int export_handle_export_file_entry_data(
      export_handle_t *export_handle,
      libewf_file_entry_t *file_entry,
@@ -0,0 +1,243 @@
+/*
+ * File export job
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+#include "file_export_job.h"
+#include "log_handle.h"
+
+/* Creates a file export job
+ * Make sure the value file_export_job is referencing, is set to NULL
+ * The file export job takes over the file entry and the target path when successful
+ * Returns 1 if successful or -1 on error
+ */
+int file_export_job_initialize(
+     file_export_job_t **file_export_job,
+     libewf_file_entry_t *file_entry,
+     system_character_t *target_path,
+     size_t file_entry_path_index,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	static char *function     = "file_export_job_initialize";
+	off64_t media_data_offset = 0;
+
+	if( file_export_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file export job.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_export_job != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file export job value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid target path.",
+		 function );
+
+		return( -1 );
+	}
+	/* The media data offset is used to export the file entries in the order
+	 * their data is stored, the file entry data of sparse and empty files
+	 * does not need to be read sequentially
+	 */
+	if( libewf_file_entry_get_media_data_offset(
+	     file_entry,
+	     &media_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media data offset.",
+		 function );
+
+		return( -1 );
+	}
+	*file_export_job = memory_allocate_structure(
+	                    file_export_job_t );
+
+	if( *file_export_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file export job.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     *file_export_job,
+	     0,
+	     sizeof( file_export_job_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file export job.",
+		 function );
+
+		memory_free(
+		 *file_export_job );
+
+		*file_export_job = NULL;
+
+		return( -1 );
+	}
+	( *file_export_job )->file_entry            = file_entry;
+	( *file_export_job )->target_path           = target_path;
+	( *file_export_job )->file_entry_path_index = file_entry_path_index;
+	( *file_export_job )->media_data_offset     = media_data_offset;
+	( *file_export_job )->log_handle            = log_handle;
+
+	return( 1 );
+}
+
+/* Frees a file export job
+ * Returns 1 if successful or -1 on error
+ */
+int file_export_job_free(
+     file_export_job_t **file_export_job,
+     libcerror_error_t **error )
+{
+	static char *function = "file_export_job_free";
+	int result            = 1;
+
+	if( file_export_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file export job.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_export_job != NULL )
+	{
+		if( libewf_file_entry_free(
+		     &( ( *file_export_job )->file_entry ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file entry.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *file_export_job )->target_path != NULL )
+		{
+			memory_free(
+			 ( *file_export_job )->target_path );
+		}
+		memory_free(
+		 *file_export_job );
+
+		*file_export_job = NULL;
+	}
+	return( result );
+}
+
+/* Compares 2 file export jobs by their media data offset
+ * Returns LIBCTHREADS_COMPARE_LESS, LIBCTHREADS_COMPARE_EQUAL, LIBCTHREADS_COMPARE_GREATER if successful or -1 on error
+ */
+int file_export_job_compare(
+     file_export_job_t *first_file_export_job,
+     file_export_job_t *second_file_export_job,
+     libcerror_error_t **error )
+{
+	static char *function = "file_export_job_compare";
+
+	if( first_file_export_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first file export job.",
+		 function );
+
+		return( -1 );
+	}
+	if( second_file_export_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid second file export job.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_file_export_job->media_data_offset < second_file_export_job->media_data_offset )
+	{
+		return( LIBCTHREADS_COMPARE_LESS );
+	}
+	else if( first_file_export_job->media_data_offset > second_file_export_job->media_data_offset )
+	{
+		return( LIBCTHREADS_COMPARE_GREATER );
+	}
+	return( LIBCTHREADS_COMPARE_EQUAL );
+}
+
@@ -0,0 +1,83 @@
+/*
+ * File export job
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _FILE_EXPORT_JOB_H )
+#define _FILE_EXPORT_JOB_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libewf.h"
+#include "log_handle.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct file_export_job file_export_job_t;
+
+struct file_export_job
+{
+	/* The file entry
+	 */
+	libewf_file_entry_t *file_entry;
+
+	/* The target path
+	 */
+	system_character_t *target_path;
+
+	/* The index of the file entry path in the target path
+	 */
+	size_t file_entry_path_index;
+
+	/* The media data offset of the file entry
+	 */
+	off64_t media_data_offset;
+
+	/* The log handle
+	 */
+	log_handle_t *log_handle;
+};
+
+int file_export_job_initialize(
+     file_export_job_t **file_export_job,
+     libewf_file_entry_t *file_entry,
+     system_character_t *target_path,
+     size_t file_entry_path_index,
+     log_handle_t *log_handle,
+     libcerror_error_t **error );
+
+int file_export_job_free(
+     file_export_job_t **file_export_job,
+     libcerror_error_t **error );
+
+int file_export_job_compare(
+     file_export_job_t *first_file_export_job,
+     file_export_job_t *second_file_export_job,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _FILE_EXPORT_JOB_H ) */
+
@@ -34,7 +34,10 @@
 #endif
 
 #include "byte_size_string.h"
+#include "checkpoint.h"
+#include "digest_context.h"
 #include "digest_hash.h"
+#include "digest_hash_thread.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
 #include "ewftools_libcerror.h"
@@ -44,11 +47,13 @@
 #include "ewftools_libewf.h"
 #include "ewftools_libhmac.h"
 #include "ewftools_system_string.h"
+#include "ewftools_unused.h"
 #include "guid.h"
 #include "imaging_handle.h"
 #include "platform.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "storage_media_buffer_reorder.h"
 
 #define IMAGING_HANDLE_INPUT_BUFFER_SIZE	64
 #define IMAGING_HANDLE_STRING_SIZE		1024
@@ -238,6 +243,7 @@ int imaging_handle_free(
 {
 	static char *function = "imaging_handle_free";
 	int result            = 1;
+	int target_index      = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -265,6 +271,16 @@ int imaging_handle_free(
 			memory_free(
 			 ( *imaging_handle )->secondary_target_filename );
 		}
+		for( target_index = 0;
+		     target_index < ( *imaging_handle )->number_of_additional_target_filenames;
+		     target_index++ )
+		{
+			if( ( *imaging_handle )->additional_target_filenames[ target_index ] != NULL )
+			{
+				memory_free(
+				 ( *imaging_handle )->additional_target_filenames[ target_index ] );
+			}
+		}
 		if( ( *imaging_handle )->case_number != NULL )
 		{
 			memory_free(
@@ -290,6 +306,22 @@ int imaging_handle_free(
 			memory_free(
 			 ( *imaging_handle )->notes );
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( digest_hash_thread_free_additional(
+		     &( ( *imaging_handle )->sha1_hash_thread ),
+		     &( ( *imaging_handle )->sha256_hash_thread ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free additional digest hash threads.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		if( ( *imaging_handle )->md5_context != NULL )
 		{
 			if( libhmac_md5_free(
@@ -353,6 +385,90 @@ int imaging_handle_free(
 			memory_free(
 			 ( *imaging_handle )->calculated_sha256_hash_string );
 		}
+#if defined( HAVE_CHECKPOINT )
+		if( ( *imaging_handle )->md5_digest_context != NULL )
+		{
+			if( digest_context_free(
+			     &( ( *imaging_handle )->md5_digest_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free MD5 digest context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *imaging_handle )->sha1_digest_context != NULL )
+		{
+			if( digest_context_free(
+			     &( ( *imaging_handle )->sha1_digest_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free SHA1 digest context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *imaging_handle )->sha256_digest_context != NULL )
+		{
+			if( digest_context_free(
+			     &( ( *imaging_handle )->sha256_digest_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free SHA256 digest context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *imaging_handle )->checkpoint != NULL )
+		{
+			if( checkpoint_free(
+			     &( ( *imaging_handle )->checkpoint ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free checkpoint.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *imaging_handle )->checkpoint_mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *imaging_handle )->checkpoint_mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free checkpoint mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+#endif /* defined( HAVE_CHECKPOINT ) */
 		if( libewf_handle_free(
 		     &( ( *imaging_handle )->output_handle ),
 		     error ) != 1 )
@@ -572,9 +688,11 @@ int imaging_handle_open_output(
 	system_character_t **libewf_filenames = NULL;
 	system_character_t *filenames[ 1 ]    = { NULL };
 	static char *function                 = "imaging_handle_open_output";
+	size_t filename_length                = 0;
 	size_t first_filename_length          = 0;
 	int access_flags                      = 0;
 	int number_of_filenames               = 0;
+	int target_index                      = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -665,6 +783,58 @@ int imaging_handle_open_output(
 
 		goto on_error;
 	}
+	if( imaging_handle->chunks_section_limit != 0 )
+	{
+		if( libewf_handle_set_chunks_section_limit(
+		     imaging_handle->output_handle,
+		     imaging_handle->chunks_section_limit,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunks section limit.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( resume == 0 )
+	{
+		for( target_index = 0;
+		     target_index < imaging_handle->number_of_additional_target_filenames;
+		     target_index++ )
+		{
+			filename_length = system_string_length(
+			                   imaging_handle->additional_target_filenames[ target_index ] );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+			if( libewf_handle_append_segment_filename_wide(
+			     imaging_handle->output_handle,
+			     imaging_handle->additional_target_filenames[ target_index ],
+			     filename_length,
+			     error ) != 1 )
+#else
+			if( libewf_handle_append_segment_filename(
+			     imaging_handle->output_handle,
+			     imaging_handle->additional_target_filenames[ target_index ],
+			     filename_length,
+			     error ) != 1 )
+#endif
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append additional segment filename: %d.",
+				 function,
+				 target_index );
+
+				goto on_error;
+			}
+		}
+	}
 	if( libewf_filenames != filenames )
 	{
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -838,6 +1008,23 @@ int imaging_handle_open_secondary_output(
 
 		goto on_error;
 	}
+	if( imaging_handle->chunks_section_limit != 0 )
+	{
+		if( libewf_handle_set_chunks_section_limit(
+		     imaging_handle->secondary_output_handle,
+		     imaging_handle->chunks_section_limit,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunks section limit.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libewf_filenames != filenames )
 	{
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -952,6 +1139,20 @@ int imaging_handle_open_output_resume(
 
 		goto on_error;
 	}
+	if( imaging_handle_read_checkpoint(
+	     imaging_handle,
+	     *resume_acquiry_offset,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read checkpoint.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
@@ -1024,8 +1225,11 @@ ssize_t imaging_handle_write_storage_media_buffer(
          libcerror_error_t **error )
 {
 	static char *function         = "imaging_handle_write_buffer";
+	size_t packed_data_size       = 0;
 	ssize_t secondary_write_count = 0;
 	ssize_t write_count           = 0;
+	uint64_t stage_timestamp      = 0;
+	int result                    = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -1038,11 +1242,50 @@ ssize_t imaging_handle_write_storage_media_buffer(
 
 		return( -1 );
 	}
-	write_count = storage_media_buffer_write_to_handle(
-	               storage_media_buffer,
-	               imaging_handle->output_handle,
-	               write_size,
-	               error );
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->process_status != NULL )
+	{
+		if( process_status_get_stage_timestamp(
+		     imaging_handle->process_status,
+		     &stage_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve stage timestamp.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( imaging_handle->concurrent_segment_write != 0 )
+	{
+		write_count = storage_media_buffer_write_to_handle_at_offset(
+		               storage_media_buffer,
+		               imaging_handle->output_handle,
+		               write_size,
+		               error );
+	}
+	else
+	{
+		write_count = storage_media_buffer_write_to_handle(
+		               storage_media_buffer,
+		               imaging_handle->output_handle,
+		               write_size,
+		               error );
+	}
 
 	if( write_count < 0 )
 	{
@@ -1066,11 +1309,22 @@ ssize_t imaging_handle_write_storage_media_buffer(
 	}
 	if( imaging_handle->secondary_output_handle != NULL )
 	{
-		secondary_write_count = storage_media_buffer_write_to_handle(
-		                         storage_media_buffer,
-		                         imaging_handle->secondary_output_handle,
-		                         write_size,
-		                         error );
+		if( imaging_handle->concurrent_segment_write != 0 )
+		{
+			secondary_write_count = storage_media_buffer_write_to_handle_at_offset(
+			                         storage_media_buffer,
+			                         imaging_handle->secondary_output_handle,
+			                         write_size,
+			                         error );
+		}
+		else
+		{
+			secondary_write_count = storage_media_buffer_write_to_handle(
+			                         storage_media_buffer,
+			                         imaging_handle->secondary_output_handle,
+			                         write_size,
+			                         error );
+		}
 
 		if( secondary_write_count < 0 )
 		{
@@ -1093,6 +1347,67 @@ ssize_t imaging_handle_write_storage_media_buffer(
 			return( -1 );
 		}
 	}
+	if( imaging_handle->process_status != NULL )
+	{
+		if( process_status_add_stage_value(
+		     imaging_handle->process_status,
+		     PROCESS_STATUS_STAGE_WRITE,
+		     (size64_t) write_count,
+		     stage_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add write stage value.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* The chunk data was compressed before the write, which allows to determine
+	 * the compression ratio
+	 */
+	if( ( imaging_handle->process_status != NULL )
+	 && ( imaging_handle->process_status->telemetry_stream != NULL )
+	 && ( storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA ) )
+	{
+		result = libewf_data_chunk_get_packed_data_size(
+		          storage_media_buffer->data_chunk,
+		          &packed_data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve packed data size.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			if( process_status_add_compression_values(
+			     imaging_handle->process_status,
+			     (size64_t) write_count,
+			     (size64_t) packed_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to add compression values.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
 	return( write_count );
 }
 
@@ -1278,14 +1593,19 @@ int imaging_handle_swap_byte_pairs(
 	return( 1 );
 }
 
-/* Initializes the integrity hash(es)
+#if defined( HAVE_CHECKPOINT )
+
+/* Initializes the integrity hash(es) of which the state is stored in the checkpoint
+ * The digest states of the checkpoint are restored when a resumed acquiry continues from it
  * Returns 1 if successful or -1 on error
  */
-int imaging_handle_initialize_integrity_hash(
+int imaging_handle_initialize_checkpoint_integrity_hash(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error )
 {
-	static char *function = "imaging_handle_initialize_integrity_hash";
+	static char *function = "imaging_handle_initialize_checkpoint_integrity_hash";
+	size32_t chunk_size   = 0;
+	int result            = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -1300,71 +1620,301 @@ int imaging_handle_initialize_integrity_hash(
 	}
 	if( imaging_handle->calculate_md5 != 0 )
 	{
-		if( libhmac_md5_initialize(
-		     &( imaging_handle->md5_context ),
+		if( digest_context_initialize(
+		     &( imaging_handle->md5_digest_context ),
+		     DIGEST_CONTEXT_TYPE_MD5,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize MD5 context.",
+			 "%s: unable to initialize MD5 digest context.",
 			 function );
 
 			goto on_error;
 		}
-		imaging_handle->md5_context_initialized = 1;
 	}
 	if( imaging_handle->calculate_sha1 != 0 )
 	{
-		if( libhmac_sha1_initialize(
-		     &( imaging_handle->sha1_context ),
+		if( digest_context_initialize(
+		     &( imaging_handle->sha1_digest_context ),
+		     DIGEST_CONTEXT_TYPE_SHA1,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize SHA1 context.",
+			 "%s: unable to initialize SHA1 digest context.",
 			 function );
 
 			goto on_error;
 		}
-		imaging_handle->sha1_context_initialized = 1;
 	}
 	if( imaging_handle->calculate_sha256 != 0 )
 	{
-		if( libhmac_sha256_initialize(
-		     &( imaging_handle->sha256_context ),
+		if( digest_context_initialize(
+		     &( imaging_handle->sha256_digest_context ),
+		     DIGEST_CONTEXT_TYPE_SHA256,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize SHA256 context.",
+			 "%s: unable to initialize SHA256 digest context.",
 			 function );
 
 			goto on_error;
 		}
-		imaging_handle->sha256_context_initialized = 1;
 	}
-	return( 1 );
-
-on_error:
-	if( imaging_handle->sha1_context != NULL )
+	if( imaging_handle->checkpoint_resume_offset > 0 )
 	{
-		libhmac_sha1_free(
-		 &( imaging_handle->sha1_context ),
-		 NULL );
+		result = 1;
+
+		if( imaging_handle->md5_digest_context != NULL )
+		{
+			result = checkpoint_get_digest_state(
+			          imaging_handle->checkpoint,
+			          CHECKPOINT_DIGEST_TYPE_MD5,
+			          imaging_handle->md5_digest_context,
+			          error );
+		}
+		if( ( result == 1 )
+		 && ( imaging_handle->sha1_digest_context != NULL ) )
+		{
+			result = checkpoint_get_digest_state(
+			          imaging_handle->checkpoint,
+			          CHECKPOINT_DIGEST_TYPE_SHA1,
+			          imaging_handle->sha1_digest_context,
+			          error );
+		}
+		if( ( result == 1 )
+		 && ( imaging_handle->sha256_digest_context != NULL ) )
+		{
+			result = checkpoint_get_digest_state(
+			          imaging_handle->checkpoint,
+			          CHECKPOINT_DIGEST_TYPE_SHA256,
+			          imaging_handle->sha256_digest_context,
+			          error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to restore digest context states from checkpoint.",
+			 function );
+
+			goto on_error;
+		}
 	}
-	if( imaging_handle->md5_context != NULL )
+	if( imaging_handle_get_chunk_size(
+	     imaging_handle,
+	     &chunk_size,
+	     error ) != 1 )
 	{
-		libhmac_md5_free(
-		 &( imaging_handle->md5_context ),
-		 NULL );
-	}
-	return( -1 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk size.",
+		 function );
+
+		goto on_error;
+	}
+	imaging_handle->checkpoint_interval    = (size64_t) imaging_handle->chunks_section_limit * chunk_size;
+	imaging_handle->next_checkpoint_offset = imaging_handle->checkpoint_resume_offset + (off64_t) imaging_handle->checkpoint_interval;
+	imaging_handle->checkpoint_pending     = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->number_of_threads != 0 )
+	{
+		if( digest_hash_thread_initialize_additional(
+		     &( imaging_handle->sha1_hash_thread ),
+		     &( imaging_handle->sha256_hash_thread ),
+		     (intptr_t *) imaging_handle->md5_digest_context,
+		     (intptr_t *) imaging_handle->sha1_digest_context,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &digest_context_update,
+		     (intptr_t *) imaging_handle->sha256_digest_context,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &digest_context_update,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize additional digest hash threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( imaging_handle->sha256_digest_context != NULL )
+	{
+		digest_context_free(
+		 &( imaging_handle->sha256_digest_context ),
+		 NULL );
+	}
+	if( imaging_handle->sha1_digest_context != NULL )
+	{
+		digest_context_free(
+		 &( imaging_handle->sha1_digest_context ),
+		 NULL );
+	}
+	if( imaging_handle->md5_digest_context != NULL )
+	{
+		digest_context_free(
+		 &( imaging_handle->md5_digest_context ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_CHECKPOINT ) */
+
+/* Initializes the integrity hash(es)
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_initialize_integrity_hash(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_initialize_integrity_hash";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_CHECKPOINT )
+	if( imaging_handle->checkpoint != NULL )
+	{
+		if( imaging_handle_initialize_checkpoint_integrity_hash(
+		     imaging_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize checkpoint integrity hash(es).",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#endif
+	if( imaging_handle->calculate_md5 != 0 )
+	{
+		if( libhmac_md5_initialize(
+		     &( imaging_handle->md5_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize MD5 context.",
+			 function );
+
+			goto on_error;
+		}
+		imaging_handle->md5_context_initialized = 1;
+	}
+	if( imaging_handle->calculate_sha1 != 0 )
+	{
+		if( libhmac_sha1_initialize(
+		     &( imaging_handle->sha1_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA1 context.",
+			 function );
+
+			goto on_error;
+		}
+		imaging_handle->sha1_context_initialized = 1;
+	}
+	if( imaging_handle->calculate_sha256 != 0 )
+	{
+		if( libhmac_sha256_initialize(
+		     &( imaging_handle->sha256_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA256 context.",
+			 function );
+
+			goto on_error;
+		}
+		imaging_handle->sha256_context_initialized = 1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->number_of_threads != 0 )
+	{
+		if( digest_hash_thread_initialize_additional(
+		     &( imaging_handle->sha1_hash_thread ),
+		     &( imaging_handle->sha256_hash_thread ),
+		     (intptr_t *) imaging_handle->md5_context,
+		     (intptr_t *) imaging_handle->sha1_context,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_sha1_update,
+		     (intptr_t *) imaging_handle->sha256_context,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_sha256_update,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize additional digest hash threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( imaging_handle->sha256_context != NULL )
+	{
+		libhmac_sha256_free(
+		 &( imaging_handle->sha256_context ),
+		 NULL );
+	}
+	if( imaging_handle->sha1_context != NULL )
+	{
+		libhmac_sha1_free(
+		 &( imaging_handle->sha1_context ),
+		 NULL );
+	}
+	if( imaging_handle->md5_context != NULL )
+	{
+		libhmac_md5_free(
+		 &( imaging_handle->md5_context ),
+		 NULL );
+	}
+	return( -1 );
 }
 
 /* Updates the integrity hash(es)
@@ -1376,7 +1926,9 @@ int imaging_handle_update_integrity_hash(
      size_t buffer_size,
      libcerror_error_t **error )
 {
-	static char *function = "imaging_handle_update_integrity_hash";
+	static char *function    = "imaging_handle_update_integrity_hash";
+	uint64_t stage_timestamp = 0;
+	int result               = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -1412,55 +1964,90 @@ int imaging_handle_update_integrity_hash(
 
 		return( -1 );
 	}
-	if( imaging_handle->calculate_md5 != 0 )
+	if( imaging_handle->process_status != NULL )
 	{
-		if( libhmac_md5_update(
-		     imaging_handle->md5_context,
-		     buffer,
-		     buffer_size,
+		if( process_status_get_stage_timestamp(
+		     imaging_handle->process_status,
+		     &stage_timestamp,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update MD5 digest hash.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve stage timestamp.",
 			 function );
 
 			return( -1 );
 		}
 	}
-	if( imaging_handle->calculate_sha1 != 0 )
+#if defined( HAVE_CHECKPOINT )
+	if( imaging_handle->checkpoint != NULL )
 	{
-		if( libhmac_sha1_update(
-		     imaging_handle->sha1_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update SHA1 digest hash.",
-			 function );
+		result = digest_hash_thread_update_digest_hashes(
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		          imaging_handle->sha1_hash_thread,
+		          imaging_handle->sha256_hash_thread,
+#else
+		          NULL,
+		          NULL,
+#endif
+		          (intptr_t *) imaging_handle->md5_digest_context,
+		          (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &digest_context_update,
+		          (intptr_t *) imaging_handle->sha1_digest_context,
+		          (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &digest_context_update,
+		          (intptr_t *) imaging_handle->sha256_digest_context,
+		          (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &digest_context_update,
+		          buffer,
+		          buffer_size,
+		          error );
+	}
+	else
+#endif
+	{
+		result = digest_hash_thread_update_digest_hashes(
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		          imaging_handle->sha1_hash_thread,
+		          imaging_handle->sha256_hash_thread,
+#else
+		          NULL,
+		          NULL,
+#endif
+		          (intptr_t *) imaging_handle->md5_context,
+		          (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_md5_update,
+		          (intptr_t *) imaging_handle->sha1_context,
+		          (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_sha1_update,
+		          (intptr_t *) imaging_handle->sha256_context,
+		          (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_sha256_update,
+		          buffer,
+		          buffer_size,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update digest hashes.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	if( imaging_handle->calculate_sha256 != 0 )
+	if( imaging_handle->process_status != NULL )
 	{
-		if( libhmac_sha256_update(
-		     imaging_handle->sha256_context,
-		     buffer,
-		     buffer_size,
+		if( process_status_add_stage_value(
+		     imaging_handle->process_status,
+		     PROCESS_STATUS_STAGE_HASH,
+		     (size64_t) buffer_size,
+		     stage_timestamp,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update SHA256 digest hash.",
+			 "%s: unable to add hash stage value.",
 			 function );
 
 			return( -1 );
@@ -1481,6 +2068,7 @@ int imaging_handle_finalize_integrity_hash(
 	uint8_t calculated_sha256_hash[ LIBHMAC_SHA256_HASH_SIZE ];
 
 	static char *function = "imaging_handle_finalize_integrity_hash";
+	int result            = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -1493,6 +2081,22 @@ int imaging_handle_finalize_integrity_hash(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( digest_hash_thread_free_additional(
+	     &( imaging_handle->sha1_hash_thread ),
+	     &( imaging_handle->sha256_hash_thread ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free additional digest hash threads.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	if( imaging_handle->calculate_md5 != 0 )
 	{
 		if( imaging_handle->calculated_md5_hash_string == NULL )
@@ -1506,11 +2110,25 @@ int imaging_handle_finalize_integrity_hash(
 
 			return( -1 );
 		}
-		if( libhmac_md5_finalize(
-		     imaging_handle->md5_context,
-		     calculated_md5_hash,
-		     LIBHMAC_MD5_HASH_SIZE,
-		     error ) != 1 )
+#if defined( HAVE_CHECKPOINT )
+		if( imaging_handle->md5_digest_context != NULL )
+		{
+			result = digest_context_finalize(
+			          imaging_handle->md5_digest_context,
+			          calculated_md5_hash,
+			          LIBHMAC_MD5_HASH_SIZE,
+			          error );
+		}
+		else
+#endif
+		{
+			result = libhmac_md5_finalize(
+			          imaging_handle->md5_context,
+			          calculated_md5_hash,
+			          LIBHMAC_MD5_HASH_SIZE,
+			          error );
+		}
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -1551,11 +2169,25 @@ int imaging_handle_finalize_integrity_hash(
 
 			return( -1 );
 		}
-		if( libhmac_sha1_finalize(
-		     imaging_handle->sha1_context,
-		     calculated_sha1_hash,
-		     LIBHMAC_SHA1_HASH_SIZE,
-		     error ) != 1 )
+#if defined( HAVE_CHECKPOINT )
+		if( imaging_handle->sha1_digest_context != NULL )
+		{
+			result = digest_context_finalize(
+			          imaging_handle->sha1_digest_context,
+			          calculated_sha1_hash,
+			          LIBHMAC_SHA1_HASH_SIZE,
+			          error );
+		}
+		else
+#endif
+		{
+			result = libhmac_sha1_finalize(
+			          imaging_handle->sha1_context,
+			          calculated_sha1_hash,
+			          LIBHMAC_SHA1_HASH_SIZE,
+			          error );
+		}
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -1596,11 +2228,25 @@ int imaging_handle_finalize_integrity_hash(
 
 			return( -1 );
 		}
-		if( libhmac_sha256_finalize(
-		     imaging_handle->sha256_context,
-		     calculated_sha256_hash,
-		     LIBHMAC_SHA256_HASH_SIZE,
-		     error ) != 1 )
+#if defined( HAVE_CHECKPOINT )
+		if( imaging_handle->sha256_digest_context != NULL )
+		{
+			result = digest_context_finalize(
+			          imaging_handle->sha256_digest_context,
+			          calculated_sha256_hash,
+			          LIBHMAC_SHA256_HASH_SIZE,
+			          error );
+		}
+		else
+#endif
+		{
+			result = libhmac_sha256_finalize(
+			          imaging_handle->sha256_context,
+			          calculated_sha256_hash,
+			          LIBHMAC_SHA256_HASH_SIZE,
+			          error );
+		}
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -1644,6 +2290,8 @@ int imaging_handle_process_storage_media_buffer_callback(
         libcerror_error_t *error = NULL;
         static char *function    = "imaging_handle_process_storage_media_buffer_callback";
 	ssize_t process_count    = 0;
+	ssize_t write_count      = 0;
+	uint64_t stage_timestamp = 0;
 
 	if( storage_media_buffer == NULL )
 	{
@@ -1656,6 +2304,23 @@ int imaging_handle_process_storage_media_buffer_callback(
 
 		goto on_error;
 	}
+	if( imaging_handle->process_status != NULL )
+	{
+		if( process_status_get_stage_timestamp(
+		     imaging_handle->process_status,
+		     &stage_timestamp,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve stage timestamp.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	process_count = storage_media_buffer_write_process(
 			 storage_media_buffer,
 			 &error );
@@ -1671,22 +2336,63 @@ int imaging_handle_process_storage_media_buffer_callback(
 
 		goto on_error;
 	}
-	if( libcthreads_thread_pool_push_sorted(
-	     imaging_handle->output_thread_pool,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCTHREADS_SORT_FLAG_UNIQUE_VALUES,
-	     &error ) != 1 )
+	if( imaging_handle->process_status != NULL )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to push storage media buffer onto output thread pool queue.",
-		 function );
-
-		goto on_error;
-	}
+		if( process_status_add_stage_value(
+		     imaging_handle->process_status,
+		     PROCESS_STATUS_STAGE_PROCESS,
+		     (size64_t) process_count,
+		     stage_timestamp,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add process stage value.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* With a concurrent segment write the process threads write the chunks
+	 * to their reserved offsets, the output thread only keeps track of the
+	 * data written in order
+	 */
+	if( imaging_handle->concurrent_segment_write != 0 )
+	{
+		write_count = imaging_handle_write_storage_media_buffer(
+			       imaging_handle,
+			       storage_media_buffer,
+			       storage_media_buffer->processed_size,
+			       &error );
+
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write storage media buffer.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_thread_pool_push(
+	     imaging_handle->output_thread_pool,
+	     (intptr_t *) storage_media_buffer,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push storage media buffer onto output thread pool queue.",
+		 function );
+
+		goto on_error;
+	}
 	storage_media_buffer = NULL;
 
 	return( 1 );
@@ -1726,20 +2432,18 @@ on_error:
 	return( -1 );
 }
 
-/* Prepares a storage media buffer for imaging
- * Callback function for the process thread pool
+/* Writes storage media buffers in order
+ * Callback function for the output thread pool
  * Returns 1 if successful or -1 on error
  */
 int imaging_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      imaging_handle_t *imaging_handle )
 {
-	libcdata_list_element_t *element      = NULL;
-	libcdata_list_element_t *next_element = NULL;
-        libcerror_error_t *error              = NULL;
-        static char *function                 = "imaging_handle_output_storage_media_buffer_callback";
-	ssize_t write_count                   = 0;
-	int result                            = 0;
+        libcerror_error_t *error = NULL;
+        static char *function    = "imaging_handle_output_storage_media_buffer_callback";
+	ssize_t write_count      = 0;
+	int result               = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -1763,158 +2467,110 @@ int imaging_handle_output_storage_media_buffer_callback(
 
 		goto on_error;
 	}
-	if( libcdata_list_insert_value(
-	     imaging_handle->output_list,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
+	if( storage_media_buffer_reorder_insert_buffer(
+	     imaging_handle->output_reorder,
+	     storage_media_buffer,
 	     &error ) != 1 )
 	{
 		libcerror_error_set(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert storage media buffer into output list.",
+		 "%s: unable to insert storage media buffer into output reorder window.",
 		 function );
 
 		goto on_error;
 	}
 	storage_media_buffer = NULL;
 
-	if( libcdata_list_get_first_element(
-	     imaging_handle->output_list,
-	     &element,
-	     &error ) != 1 )
+	do
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
+		result = storage_media_buffer_reorder_remove_buffer(
+		          imaging_handle->output_reorder,
+		          imaging_handle->last_offset_written,
+		          &storage_media_buffer,
+		          &error );
 
-		goto on_error;
-	}
-	while( element != NULL )
-	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     &error ) != 1 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove storage media buffer from output reorder window.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
-
-			return( -1 );
-		}
-		if( storage_media_buffer->storage_media_offset != imaging_handle->last_offset_written )
+		else if( result == 0 )
 		{
 			break;
 		}
-		write_count = imaging_handle_write_storage_media_buffer(
-			       imaging_handle,
-			       storage_media_buffer,
-			       storage_media_buffer->processed_size,
-			       &error );
-
-		if( write_count < 0 )
+		if( imaging_handle->concurrent_segment_write == 0 )
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write storage media buffer.",
-			 function );
+			write_count = imaging_handle_write_storage_media_buffer(
+				       imaging_handle,
+				       storage_media_buffer,
+				       storage_media_buffer->processed_size,
+				       &error );
 
-			storage_media_buffer = NULL;
+			if( write_count < 0 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write storage media buffer.",
+				 function );
 
-			goto on_error;
+				goto on_error;
+			}
 		}
 		imaging_handle->last_offset_written = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
 
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
+		if( imaging_handle_write_checkpoint(
+		     imaging_handle,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write checkpoint.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		if( libcdata_list_remove_element(
-		     imaging_handle->output_list,
-		     element,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
 
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
+		if( storage_media_buffer_queue_release_buffer(
+		     imaging_handle->storage_media_buffer_queue,
+		     storage_media_buffer,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to release storage media buffer onto queue.",
 			 function );
 
 			goto on_error;
 		}
-		element = next_element;
+		storage_media_buffer = NULL;
 
-		if( storage_media_buffer_queue_release_buffer(
-		     imaging_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
+		if( imaging_handle_set_telemetry_buffer_values(
+		     imaging_handle,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set telemetry buffer values.",
 			 function );
 
 			goto on_error;
 		}
-		storage_media_buffer = NULL;
-
 		if( imaging_handle->acquiry_size == 0 )
 		{
 			result = process_status_update_unknown_total(
@@ -1942,6 +2598,8 @@ int imaging_handle_output_storage_media_buffer_callback(
 			goto on_error;
 		}
 	}
+	while( result == 1 );
+
 	return( 1 );
 
 on_error:
@@ -1979,17 +2637,16 @@ on_error:
 	return( -1 );
 }
 
-/* Empties the output list
+/* Sets the storage media buffer values of the telemetry
  * Returns 1 if successful or -1 on error
  */
-int imaging_handle_empty_output_list(
+int imaging_handle_set_telemetry_buffer_values(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error )
 {
-	libcdata_list_element_t *element             = NULL;
-	libcdata_list_element_t *next_element        = NULL;
-	storage_media_buffer_t *storage_media_buffer = NULL;
-        static char *function                        = "imaging_handle_empty_output_list";
+	static char *function         = "imaging_handle_set_telemetry_buffer_values";
+	int maximum_number_of_buffers = 0;
+	int number_of_buffers_in_use  = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -2002,108 +2659,134 @@ int imaging_handle_empty_output_list(
 
 		return( -1 );
 	}
-	if( libcdata_list_get_first_element(
-	     imaging_handle->output_list,
-	     &element,
+	if( ( imaging_handle->process_status == NULL )
+	 || ( imaging_handle->process_status->telemetry_stream == NULL )
+	 || ( imaging_handle->storage_media_buffer_queue == NULL )
+	 || ( imaging_handle->output_reorder == NULL ) )
+	{
+		return( 1 );
+	}
+	if( storage_media_buffer_queue_get_number_of_buffers_in_use(
+	     imaging_handle->storage_media_buffer_queue,
+	     &number_of_buffers_in_use,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
+		 "%s: unable to retrieve number of storage media buffers in use.",
 		 function );
 
 		return( -1 );
 	}
-	while( element != NULL )
+	maximum_number_of_buffers = imaging_handle->storage_media_buffer_queue->maximum_number_of_buffers_in_use;
+
+	if( maximum_number_of_buffers == 0 )
 	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
+		maximum_number_of_buffers = imaging_handle->storage_media_buffer_queue->number_of_buffers;
+	}
+	if( process_status_set_buffer_values(
+	     imaging_handle->process_status,
+	     number_of_buffers_in_use,
+	     maximum_number_of_buffers,
+	     imaging_handle->output_reorder->number_of_buffers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set process status buffer values.",
+		 function );
 
-			return( -1 );
-		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
+		return( -1 );
+	}
+	return( 1 );
+}
 
-			return( -1 );
-		}
-		if( storage_media_buffer_queue_release_buffer(
-		     imaging_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
-			 function );
+/* Adjusts the number of active jobs to the measured stage throughput
+ * The process thread pool cannot be resized, instead the number of storage media
+ * buffers in use is limited, which limits the number of buffers the process
+ * threads can work on concurrently. The number of held buffers is the number of
+ * buffers the calling thread holds while grabbing another one
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_adjust_number_of_jobs(
+     imaging_handle_t *imaging_handle,
+     int number_of_held_buffers,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_adjust_number_of_jobs";
+	int number_of_jobs    = 0;
+	int result            = 0;
 
-			return( -1 );
-		}
-		storage_media_buffer = NULL;
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
 
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
+		return( -1 );
+	}
+	if( number_of_held_buffers < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of held buffers value less than zero.",
+		 function );
 
-			return( -1 );
-		}
-		if( libcdata_list_remove_element(
-		     imaging_handle->output_list,
-		     element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
+		return( -1 );
+	}
+	if( ( imaging_handle->automatic_number_of_threads == 0 )
+	 || ( imaging_handle->number_of_threads <= 1 )
+	 || ( imaging_handle->process_status == NULL )
+	 || ( imaging_handle->storage_media_buffer_queue == NULL ) )
+	{
+		return( 1 );
+	}
+	result = process_status_get_number_of_jobs(
+	          imaging_handle->process_status,
+	          imaging_handle->number_of_threads,
+	          &number_of_jobs,
+	          error );
 
-			return( -1 );
-		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of jobs.",
+		 function );
 
-			return( -1 );
-		}
-		element = next_element;
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 1 );
+	}
+	/* Besides the buffers of the jobs a buffer is read and a buffer is hashed
+	 * and written
+	 */
+	if( storage_media_buffer_queue_set_maximum_number_of_buffers_in_use(
+	     imaging_handle->storage_media_buffer_queue,
+	     number_of_jobs + number_of_held_buffers + 2,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum number of storage media buffers in use.",
+		 function );
+
+		return( -1 );
 	}
 	return( 1 );
 }
@@ -4036,61 +4719,655 @@ int imaging_handle_set_acquiry_size(
 
 	if( imaging_handle == NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid imaging handle.",
-		 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string[ 0 ] != (system_character_t) '-' )
+	{
+		string_length = system_string_length(
+				 string );
+
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &( imaging_handle->acquiry_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine acquiry size.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+	}
+	return( result );
+}
+
+/* Sets the header codepage
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_set_header_codepage(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_set_header_codepage";
+	int result            = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = ewfinput_determine_header_codepage(
+	          string,
+	          &imaging_handle->header_codepage,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine header codepage.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Sets the process buffer size
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int imaging_handle_set_process_buffer_size(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function  = "imaging_handle_set_process_buffer_size";
+	size_t string_length   = 0;
+	uint64_t size_variable = 0;
+	int result             = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	result = byte_size_string_convert(
+	          string,
+	          string_length,
+	          &size_variable,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine process buffer size.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( size_variable > (uint64_t) SSIZE_MAX )
+		{
+			imaging_handle->process_buffer_size = 0;
+
+			result = 0;
+		}
+		else
+		{
+			imaging_handle->process_buffer_size = (size_t) size_variable;
+		}
+	}
+	return( result );
+}
+
+/* Sets the number of threads
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int imaging_handle_set_number_of_threads(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function      = "imaging_handle_set_number_of_threads";
+	size_t string_length       = 0;
+	uint64_t number_of_threads = 0;
+	int number_of_processors   = 0;
+	int result                 = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( ( string_length == 4 )
+	 && ( system_string_compare(
+	       string,
+	       _SYSTEM_STRING( "auto" ),
+	       4 ) == 0 ) )
+	{
+		/* Use a thread per processor, if the number of processors cannot
+		 * be determined the current number of threads is retained
+		 */
+		result = platform_get_number_of_processors(
+		          &number_of_processors,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine number of processors.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			if( number_of_processors > IMAGING_HANDLE_MAXIMUM_NUMBER_OF_THREADS )
+			{
+				number_of_processors = IMAGING_HANDLE_MAXIMUM_NUMBER_OF_THREADS;
+			}
+			imaging_handle->number_of_threads = number_of_processors;
+		}
+		imaging_handle->automatic_number_of_threads = 1;
+
+		result = 1;
+	}
+	else if( string[ 0 ] != (system_character_t) '-' )
+	{
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine number of threads.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+
+		if( number_of_threads > IMAGING_HANDLE_MAXIMUM_NUMBER_OF_THREADS )
+		{
+			result = 0;
+		}
+		else
+		{
+			imaging_handle->number_of_threads           = (int) number_of_threads;
+			imaging_handle->automatic_number_of_threads = 0;
+		}
+	}
+	return( result );
+}
+
+/* Sets the memory limit of the storage media buffers
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int imaging_handle_set_memory_limit(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function  = "imaging_handle_set_memory_limit";
+	size_t string_length   = 0;
+	uint64_t size_variable = 0;
+	int result             = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	result = byte_size_string_convert(
+	          string,
+	          string_length,
+	          &size_variable,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine memory limit.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( size_variable == 0 )
+		{
+			result = 0;
+		}
+		else
+		{
+			imaging_handle->memory_limit = (size64_t) size_variable;
+		}
+	}
+	return( result );
+}
+
+/* Appends an additional target filename
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_append_additional_target_filename(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_append_additional_target_filename";
+	size_t filename_size  = 0;
+	int target_index      = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( imaging_handle->number_of_additional_target_filenames < 0 )
+	 || ( imaging_handle->number_of_additional_target_filenames >= IMAGING_HANDLE_MAXIMUM_NUMBER_OF_ADDITIONAL_TARGETS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid imaging handle - number of additional target filenames value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	target_index = imaging_handle->number_of_additional_target_filenames;
+
+	if( imaging_handle_set_string(
+	     imaging_handle,
+	     filename,
+	     &( imaging_handle->additional_target_filenames[ target_index ] ),
+	     &filename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set additional target filename: %d.",
+		 function,
+		 target_index );
+
+		return( -1 );
+	}
+	imaging_handle->number_of_additional_target_filenames += 1;
+
+	return( 1 );
+}
+
+/* Enables the concurrent segment write of the output
+ * The segment files are written by the process threads at the same time,
+ * which requires multiple threads, the chunk data functions, uncompressed output of a known size
+ * in an EWF (version 1) format and no checkpoints
+ * Returns 1 if successful, 0 if not supported or -1 on error
+ */
+int imaging_handle_enable_concurrent_segment_write(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_enable_concurrent_segment_write";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( imaging_handle->use_chunk_data_functions == 0 )
+	 || ( imaging_handle->number_of_threads == 0 )
+	 || ( imaging_handle->acquiry_size == 0 )
+	 || ( imaging_handle->chunks_section_limit != 0 )
+	 || ( imaging_handle->compression_level != LIBEWF_COMPRESSION_NONE )
+	 || ( imaging_handle->compression_flags != 0 )
+	 || ( imaging_handle->ewf_format == LIBEWF_FORMAT_EWF )
+	 || ( imaging_handle->ewf_format == LIBEWF_FORMAT_SMART )
+	 || ( imaging_handle->ewf_format == LIBEWF_FORMAT_V2_ENCASE7 ) )
+	{
+		return( 0 );
+	}
+	if( libewf_handle_set_concurrent_segment_write(
+	     imaging_handle->output_handle,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set concurrent segment write.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->secondary_output_handle != NULL )
+	{
+		if( libewf_handle_set_concurrent_segment_write(
+		     imaging_handle->secondary_output_handle,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set concurrent segment write of secondary output handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	imaging_handle->concurrent_segment_write = 1;
+
+	return( 1 );
+}
+
+/* Sets the chunks section limit
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int imaging_handle_set_chunks_section_limit(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function         = "imaging_handle_set_chunks_section_limit";
+	size_t string_length          = 0;
+	uint64_t chunks_section_limit = 0;
+	int result                    = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string[ 0 ] != (system_character_t) '-' )
+	{
+		string_length = system_string_length(
+				 string );
+
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &chunks_section_limit,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine chunks section limit.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+
+		if( chunks_section_limit > (uint64_t) INT32_MAX )
+		{
+			result = 0;
+		}
+		else
+		{
+			imaging_handle->chunks_section_limit = (uint32_t) chunks_section_limit;
+		}
+	}
+	return( result );
+}
+
+/* Enables writing checkpoints
+ * A checkpoint is written every chunks section limit number of chunks and
+ * contains the state of the digest hashes so that a resumed acquiry does not
+ * need to read the data written before the checkpoint
+ * The target filename of a resumed acquiry contains the segment file extension
+ * that is not part of the basename of the checkpoint
+ * Returns 1 if successful, 0 if not supported or -1 on error
+ */
+int imaging_handle_enable_checkpoints(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *target_filename,
+     uint8_t resume_acquiry,
+     libcerror_error_t **error )
+{
+	static char *function         = "imaging_handle_enable_checkpoints";
+
+#if defined( HAVE_CHECKPOINT )
+	size_t target_basename_length = 0;
+	size_t target_filename_index  = 0;
+#endif
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_CHECKPOINT )
+	if( imaging_handle->chunks_section_limit == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid imaging handle - missing chunks section limit.",
+		 function );
+
+		return( -1 );
+	}
+	if( target_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid target filename.",
+		 function );
+
+		return( -1 );
+	}
+	target_basename_length = system_string_length(
+	                          target_filename );
+
+	if( resume_acquiry != 0 )
+	{
+		for( target_filename_index = target_basename_length;
+		     target_filename_index > 0;
+		     target_filename_index-- )
+		{
+			if( target_filename[ target_filename_index - 1 ] == (system_character_t) '/' )
+			{
+				break;
+			}
+			if( target_filename[ target_filename_index - 1 ] == (system_character_t) '.' )
+			{
+				target_basename_length = target_filename_index - 1;
+
+				break;
+			}
+		}
+	}
+	/* The target filename can change when the acquiry parameters are requested again
+	 */
+	if( imaging_handle->checkpoint != NULL )
+	{
+		if( checkpoint_free(
+		     &( imaging_handle->checkpoint ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free checkpoint.",
+			 function );
 
-		return( -1 );
+			goto on_error;
+		}
 	}
-	if( string == NULL )
+	if( checkpoint_initialize(
+	     &( imaging_handle->checkpoint ),
+	     target_filename,
+	     target_basename_length,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid string.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create checkpoint.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( string[ 0 ] != (system_character_t) '-' )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->checkpoint_mutex == NULL )
 	{
-		string_length = system_string_length(
-				 string );
-
-		if( ewftools_system_string_decimal_copy_to_64_bit(
-		     string,
-		     string_length + 1,
-		     &( imaging_handle->acquiry_size ),
+		if( libcthreads_mutex_initialize(
+		     &( imaging_handle->checkpoint_mutex ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine acquiry size.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create checkpoint mutex.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		result = 1;
 	}
-	return( result );
+#endif
+	return( 1 );
+
+on_error:
+	if( imaging_handle->checkpoint != NULL )
+	{
+		checkpoint_free(
+		 &( imaging_handle->checkpoint ),
+		 NULL );
+	}
+	return( -1 );
+#else
+	EWFTOOLS_UNREFERENCED_PARAMETER( target_filename )
+	EWFTOOLS_UNREFERENCED_PARAMETER( resume_acquiry )
+
+	return( 0 );
+#endif /* defined( HAVE_CHECKPOINT ) */
 }
 
-/* Sets the header codepage
- * Returns 1 if successful or -1 on error
+/* Reads the checkpoint of a resumed acquiry
+ * The checkpoint is only used if its offset is not beyond the resume acquiry offset
+ * and it contains the state of every digest hash that is calculated
+ * Returns 1 if successful, 0 if no usable checkpoint is available or -1 on error
  */
-int imaging_handle_set_header_codepage(
+int imaging_handle_read_checkpoint(
      imaging_handle_t *imaging_handle,
-     const system_character_t *string,
+     off64_t resume_acquiry_offset,
      libcerror_error_t **error )
 {
-	static char *function = "imaging_handle_set_header_codepage";
+	static char *function = "imaging_handle_read_checkpoint";
+
+#if defined( HAVE_CHECKPOINT )
+	size32_t chunk_size   = 0;
 	int result            = 0;
+#endif
 
 	if( imaging_handle == NULL )
 	{
@@ -4103,37 +5380,91 @@ int imaging_handle_set_header_codepage(
 
 		return( -1 );
 	}
-	result = ewfinput_determine_header_codepage(
-	          string,
-	          &imaging_handle->header_codepage,
+	imaging_handle->checkpoint_resume_offset = 0;
+
+#if defined( HAVE_CHECKPOINT )
+	if( imaging_handle->checkpoint == NULL )
+	{
+		return( 0 );
+	}
+	result = checkpoint_read(
+	          imaging_handle->checkpoint,
 	          error );
 
 	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read checkpoint.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( imaging_handle_get_chunk_size(
+	     imaging_handle,
+	     &chunk_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine header codepage.",
+		 "%s: unable to retrieve chunk size.",
 		 function );
 
 		return( -1 );
 	}
-	return( result );
+	/* A checkpoint beyond the resume acquiry offset refers to data that did not
+	 * make it to storage and a checkpoint that does not match the chunks
+	 * written belongs to another acquiry
+	 */
+	if( ( imaging_handle->checkpoint->offset <= 0 )
+	 || ( imaging_handle->checkpoint->offset > resume_acquiry_offset )
+	 || ( imaging_handle->checkpoint->number_of_chunks != (uint64_t) ( imaging_handle->checkpoint->offset / chunk_size ) )
+	 || ( ( imaging_handle->checkpoint->offset % chunk_size ) != 0 ) )
+	{
+		return( 0 );
+	}
+	if( ( ( imaging_handle->calculate_md5 != 0 )
+	  && ( imaging_handle->checkpoint->digest_state_is_set[ CHECKPOINT_DIGEST_TYPE_MD5 ] == 0 ) )
+	 || ( ( imaging_handle->calculate_sha1 != 0 )
+	  && ( imaging_handle->checkpoint->digest_state_is_set[ CHECKPOINT_DIGEST_TYPE_SHA1 ] == 0 ) )
+	 || ( ( imaging_handle->calculate_sha256 != 0 )
+	  && ( imaging_handle->checkpoint->digest_state_is_set[ CHECKPOINT_DIGEST_TYPE_SHA256 ] == 0 ) ) )
+	{
+		return( 0 );
+	}
+	imaging_handle->checkpoint_resume_offset = imaging_handle->checkpoint->offset;
+
+	return( 1 );
+#else
+	EWFTOOLS_UNREFERENCED_PARAMETER( resume_acquiry_offset )
+
+	return( 0 );
+#endif /* defined( HAVE_CHECKPOINT ) */
 }
 
-/* Sets the process buffer size
- * Returns 1 if successful, 0 if unsupported value or -1 on error
+/* Stores the state of the digest hashes in the checkpoint when the offset of the next checkpoint is reached
+ * This function is called after the digest hashes were updated with the data up to the offset
+ * The checkpoint is written when the data up to the offset has been written
+ * Returns 1 if successful or -1 on error
  */
-int imaging_handle_set_process_buffer_size(
+int imaging_handle_set_checkpoint_digest_states(
      imaging_handle_t *imaging_handle,
-     const system_character_t *string,
+     off64_t offset,
      libcerror_error_t **error )
 {
-	static char *function  = "imaging_handle_set_process_buffer_size";
-	size_t string_length   = 0;
-	uint64_t size_variable = 0;
-	int result             = 0;
+	static char *function = "imaging_handle_set_checkpoint_digest_states";
+
+#if defined( HAVE_CHECKPOINT )
+	int result            = 1;
+#endif
 
 	if( imaging_handle == NULL )
 	{
@@ -4146,54 +5477,119 @@ int imaging_handle_set_process_buffer_size(
 
 		return( -1 );
 	}
-	string_length = system_string_length(
-	                 string );
-
-	result = byte_size_string_convert(
-	          string,
-	          string_length,
-	          &size_variable,
-	          error );
-
-	if( result == -1 )
+#if defined( HAVE_CHECKPOINT )
+	if( ( imaging_handle->checkpoint == NULL )
+	 || ( offset < imaging_handle->next_checkpoint_offset ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine process buffer size.",
-		 function );
-
-		return( -1 );
+		return( 1 );
 	}
-	else if( result != 0 )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->checkpoint_mutex != NULL )
 	{
-		if( size_variable > (uint64_t) SSIZE_MAX )
+		if( libcthreads_mutex_grab(
+		     imaging_handle->checkpoint_mutex,
+		     error ) != 1 )
 		{
-			imaging_handle->process_buffer_size = 0;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab checkpoint mutex.",
+			 function );
 
-			result = 0;
+			return( -1 );
+		}
+	}
+#endif
+	/* If the previous checkpoint has not yet been written this checkpoint is skipped
+	 */
+	if( imaging_handle->checkpoint_pending == 0 )
+	{
+		if( imaging_handle->md5_digest_context != NULL )
+		{
+			result = checkpoint_set_digest_state(
+			          imaging_handle->checkpoint,
+			          CHECKPOINT_DIGEST_TYPE_MD5,
+			          imaging_handle->md5_digest_context,
+			          error );
+		}
+		if( ( result == 1 )
+		 && ( imaging_handle->sha1_digest_context != NULL ) )
+		{
+			result = checkpoint_set_digest_state(
+			          imaging_handle->checkpoint,
+			          CHECKPOINT_DIGEST_TYPE_SHA1,
+			          imaging_handle->sha1_digest_context,
+			          error );
+		}
+		if( ( result == 1 )
+		 && ( imaging_handle->sha256_digest_context != NULL ) )
+		{
+			result = checkpoint_set_digest_state(
+			          imaging_handle->checkpoint,
+			          CHECKPOINT_DIGEST_TYPE_SHA256,
+			          imaging_handle->sha256_digest_context,
+			          error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set checkpoint digest states.",
+			 function );
 		}
 		else
 		{
-			imaging_handle->process_buffer_size = (size_t) size_variable;
+			imaging_handle->checkpoint->offset = offset;
+			imaging_handle->checkpoint_pending = 1;
+		}
+	}
+	imaging_handle->next_checkpoint_offset = offset + (off64_t) imaging_handle->checkpoint_interval;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->checkpoint_mutex != NULL )
+	{
+		if( libcthreads_mutex_release(
+		     imaging_handle->checkpoint_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release checkpoint mutex.",
+			 function );
+
+			return( -1 );
 		}
 	}
+#endif
 	return( result );
+#else
+	EWFTOOLS_UNREFERENCED_PARAMETER( offset )
+
+	return( 1 );
+#endif /* defined( HAVE_CHECKPOINT ) */
 }
 
-/* Sets the number of threads
- * Returns 1 if successful, 0 if unsupported value or -1 on error
+/* Writes the checkpoint when the data up to its offset has been written
+ * This function is called after the last offset written was updated
+ * Returns 1 if successful or -1 on error
  */
-int imaging_handle_set_number_of_threads(
+int imaging_handle_write_checkpoint(
      imaging_handle_t *imaging_handle,
-     const system_character_t *string,
      libcerror_error_t **error )
 {
-	static char *function      = "imaging_handle_set_number_of_threads";
-	size_t string_length       = 0;
-	uint64_t number_of_threads = 0;
-	int result                 = 0;
+	static char *function     = "imaging_handle_write_checkpoint";
+
+#if defined( HAVE_CHECKPOINT )
+	uint64_t number_of_chunks = 0;
+	size32_t chunk_size       = 0;
+	uint32_t segment_number   = 0;
+	int result                = 1;
+#endif
 
 	if( imaging_handle == NULL )
 	{
@@ -4206,41 +5602,136 @@ int imaging_handle_set_number_of_threads(
 
 		return( -1 );
 	}
-	string_length = system_string_length(
-	                 string );
-
-	if( string[ 0 ] != (system_character_t) '-' )
+#if defined( HAVE_CHECKPOINT )
+	if( imaging_handle->checkpoint == NULL )
 	{
-		string_length = system_string_length(
-				 string );
-
-		if( ewftools_system_string_decimal_copy_to_64_bit(
-		     string,
-		     string_length + 1,
-		     &number_of_threads,
+		return( 1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->checkpoint_mutex != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     imaging_handle->checkpoint_mutex,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine number of threads.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab checkpoint mutex.",
 			 function );
 
 			return( -1 );
 		}
-		result = 1;
-
-		if( number_of_threads > 32 )
+	}
+#endif
+	if( ( imaging_handle->checkpoint_pending != 0 )
+	 && ( imaging_handle->last_offset_written >= imaging_handle->checkpoint->offset ) )
+	{
+		/* The data is written in the same buffers as it was hashed
+		 * so a checkpoint that is passed over cannot be written
+		 */
+		if( imaging_handle->last_offset_written == imaging_handle->checkpoint->offset )
 		{
-			result = 0;
+			if( libewf_handle_write_checkpoint(
+			     imaging_handle->output_handle,
+			     &segment_number,
+			     &number_of_chunks,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write checkpoint of output handle.",
+				 function );
+
+				result = -1;
+			}
+			if( ( result == 1 )
+			 && ( imaging_handle->secondary_output_handle != NULL ) )
+			{
+				if( libewf_handle_write_checkpoint(
+				     imaging_handle->secondary_output_handle,
+				     &segment_number,
+				     &number_of_chunks,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write checkpoint of secondary output handle.",
+					 function );
+
+					result = -1;
+				}
+			}
+			if( result == 1 )
+			{
+				if( imaging_handle_get_chunk_size(
+				     imaging_handle,
+				     &chunk_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve chunk size.",
+					 function );
+
+					result = -1;
+				}
+			}
+			/* Data that does not fill a chunk is not yet written by the output handle
+			 * so the checkpoint is only written if it ends at a chunk boundary
+			 */
+			if( ( result == 1 )
+			 && ( ( number_of_chunks * chunk_size ) == (uint64_t) imaging_handle->checkpoint->offset ) )
+			{
+				imaging_handle->checkpoint->segment_number   = segment_number;
+				imaging_handle->checkpoint->number_of_chunks = number_of_chunks;
+
+				if( checkpoint_write(
+				     imaging_handle->checkpoint,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write checkpoint.",
+					 function );
+
+					result = -1;
+				}
+			}
 		}
-		else
+		imaging_handle->checkpoint_pending = 0;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->checkpoint_mutex != NULL )
+	{
+		if( libcthreads_mutex_release(
+		     imaging_handle->checkpoint_mutex,
+		     error ) != 1 )
 		{
-			imaging_handle->number_of_threads = (int) number_of_threads;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release checkpoint mutex.",
+			 function );
+
+			return( -1 );
 		}
 	}
+#endif
 	return( result );
+#else
+	return( 1 );
+#endif /* defined( HAVE_CHECKPOINT ) */
 }
 
 /* Sets the additional digest types
@@ -5877,6 +7368,28 @@ ssize_t imaging_handle_finalize(
 			return( -1 );
 		}
 	}
+#if defined( HAVE_CHECKPOINT )
+	/* The checkpoint is no longer needed once the acquiry has been completed
+	 * but an aborted acquiry can still be resumed from it
+	 */
+	if( ( imaging_handle->checkpoint != NULL )
+	 && ( (size64_t) imaging_handle->last_offset_written >= imaging_handle->acquiry_size ) )
+	{
+		if( checkpoint_remove(
+		     imaging_handle->checkpoint,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+			 "%s: unable to remove checkpoint.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	return( write_count );
 }
 
@@ -5896,6 +7409,7 @@ int imaging_handle_print_parameters(
 
 	static char *function = "imaging_handle_print_parameters";
 	int result            = 0;
+	int target_index      = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -5981,6 +7495,15 @@ int imaging_handle_print_parameters(
 	 imaging_handle->notify_stream,
 	 "\n" );
 
+	for( target_index = 0;
+	     target_index < imaging_handle->number_of_additional_target_filenames;
+	     target_index++ )
+	{
+		fprintf(
+		 imaging_handle->notify_stream,
+		 "Additional image path:\t\t\t%" PRIs_SYSTEM "\n",
+		 imaging_handle->additional_target_filenames[ target_index ] );
+	}
 	if( imaging_handle->secondary_target_filename != NULL )
 	{
 		fprintf(
@@ -26,6 +26,9 @@
 #include <file_stream.h>
 #include <types.h>
 
+#include "checkpoint.h"
+#include "digest_context.h"
+#include "digest_hash_thread.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
@@ -33,11 +36,21 @@
 #include "ewftools_libhmac.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+#include "storage_media_buffer_reorder.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+/* The maximum number of additional targets
+ */
+#define IMAGING_HANDLE_MAXIMUM_NUMBER_OF_ADDITIONAL_TARGETS	15
+
+/* The maximum number of threads in the process thread pool
+ */
+#define IMAGING_HANDLE_MAXIMUM_NUMBER_OF_THREADS		256
+
 typedef struct imaging_handle imaging_handle_t;
 
 struct imaging_handle
@@ -62,6 +75,15 @@ struct imaging_handle
 	 */
 	size_t secondary_target_filename_size;
 
+	/* The additional target filenames, the segment files of the target
+	 * are distributed round-robin over the target and the additional targets
+	 */
+	system_character_t *additional_target_filenames[ IMAGING_HANDLE_MAXIMUM_NUMBER_OF_ADDITIONAL_TARGETS ];
+
+	/* The number of additional target filenames
+	 */
+	int number_of_additional_target_filenames;
+
 	/* The header codepage
 	 */
 	int header_codepage;
@@ -202,10 +224,67 @@ struct imaging_handle
 	 */
 	system_character_t *calculated_sha256_hash_string;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The thread that calculates the SHA1 digest hash
+	 */
+	digest_hash_thread_t *sha1_hash_thread;
+
+	/* The thread that calculates the SHA256 digest hash
+	 */
+	digest_hash_thread_t *sha256_hash_thread;
+
+#endif
+#if defined( HAVE_CHECKPOINT )
+	/* The checkpoint, which is NULL if no checkpoints are written
+	 */
+	checkpoint_t *checkpoint;
+
+	/* The MD5 digest context of which the state is stored in the checkpoint
+	 */
+	digest_context_t *md5_digest_context;
+
+	/* The SHA1 digest context of which the state is stored in the checkpoint
+	 */
+	digest_context_t *sha1_digest_context;
+
+	/* The SHA256 digest context of which the state is stored in the checkpoint
+	 */
+	digest_context_t *sha256_digest_context;
+
+	/* The number of bytes between checkpoints
+	 */
+	size64_t checkpoint_interval;
+
+	/* The offset of the next checkpoint
+	 */
+	off64_t next_checkpoint_offset;
+
+	/* Value to indicate the checkpoint contains digest states
+	 * of data that has not yet been written
+	 */
+	uint8_t checkpoint_pending;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The checkpoint mutex
+	 */
+	libcthreads_mutex_t *checkpoint_mutex;
+
+#endif
+#endif /* defined( HAVE_CHECKPOINT ) */
+
+	/* The offset of the checkpoint a resumed acquiry continues from
+	 */
+	off64_t checkpoint_resume_offset;
+
 	/* Value to indicate if the chunk data instead of the buffered read and write functions should be used
 	 */
 	uint8_t use_chunk_data_functions;
 
+	/* Value to indicate if the segment files of the output are written concurrently
+	 * by the process threads
+	 */
+	uint8_t concurrent_segment_write;
+
 	/* The process buffer size
 	 */
 	size_t process_buffer_size;
@@ -214,6 +293,19 @@ struct imaging_handle
 	 */
 	int number_of_threads;
 
+	/* Value to indicate if the number of active jobs is adjusted to the measured stage throughput
+	 */
+	uint8_t automatic_number_of_threads;
+
+	/* The memory limit of the storage media buffers, 0 represents the default
+	 */
+	size64_t memory_limit;
+
+	/* The chunks section limit, which is the maximum number of chunks written
+	 * to a chunks section of the output before the section is closed
+	 */
+	uint32_t chunks_section_limit;
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
 	/* The process thread pool
@@ -224,13 +316,13 @@ struct imaging_handle
 	 */
 	libcthreads_thread_pool_t *output_thread_pool;
 
-	/* The output list
+	/* The output reorder window
 	 */
-	libcdata_list_t *output_list;
+	storage_media_buffer_reorder_t *output_reorder;
 
 	/* The storage media buffer queue
 	 */
-	libcthreads_queue_t *storage_media_buffer_queue;
+	storage_media_buffer_queue_t *storage_media_buffer_queue;
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
@@ -258,6 +350,10 @@ struct imaging_handle
 	 */
 	process_status_t *process_status;
 
+	/* The telemetry stream
+	 */
+	FILE *telemetry_stream;
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
@@ -350,10 +446,15 @@ int imaging_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      imaging_handle_t *imaging_handle );
 
-int imaging_handle_empty_output_list(
+int imaging_handle_set_telemetry_buffer_values(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error );
 
+int imaging_handle_adjust_number_of_jobs(
+     imaging_handle_t *imaging_handle,
+     int number_of_held_buffers,
+     libcerror_error_t **error );
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 int imaging_handle_get_chunk_size(
@@ -499,6 +600,45 @@ int imaging_handle_set_number_of_threads(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int imaging_handle_set_memory_limit(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int imaging_handle_append_additional_target_filename(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int imaging_handle_enable_concurrent_segment_write(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error );
+
+int imaging_handle_set_chunks_section_limit(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int imaging_handle_enable_checkpoints(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *target_filename,
+     uint8_t resume_acquiry,
+     libcerror_error_t **error );
+
+int imaging_handle_read_checkpoint(
+     imaging_handle_t *imaging_handle,
+     off64_t resume_acquiry_offset,
+     libcerror_error_t **error );
+
+int imaging_handle_set_checkpoint_digest_states(
+     imaging_handle_t *imaging_handle,
+     off64_t offset,
+     libcerror_error_t **error );
+
+int imaging_handle_write_checkpoint(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error );
+
 int imaging_handle_set_additional_digest_types(
      imaging_handle_t *imaging_handle,
      const system_character_t *string,
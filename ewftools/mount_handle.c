@@ -28,6 +28,7 @@
 
 #include "ewftools_libcerror.h"
 #include "ewftools_libewf.h"
+#include "ewftools_system_string.h"
 #include "mount_handle.h"
 
 /* Creates a mount handle
@@ -105,6 +106,10 @@ int mount_handle_initialize(
 	}
 	( *mount_handle )->input_format = MOUNT_HANDLE_INPUT_FORMAT_RAW;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	( *mount_handle )->number_of_threads = 4;
+#endif
+
 	return( 1 );
 
 on_error:
@@ -125,8 +130,12 @@ int mount_handle_free(
      mount_handle_t **mount_handle,
      libcerror_error_t **error )
 {
-	static char *function = "mount_handle_free";
-	int result            = 1;
+	static char *function   = "mount_handle_free";
+	int result              = 1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int reader_handle_index = 0;
+#endif
 
 	if( mount_handle == NULL )
 	{
@@ -157,6 +166,32 @@ int mount_handle_free(
 				result = -1;
 			}
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *mount_handle )->reader_handles != NULL )
+		{
+			for( reader_handle_index = 0;
+			     reader_handle_index < ( *mount_handle )->number_of_reader_handles;
+			     reader_handle_index++ )
+			{
+				if( libewf_handle_free(
+				     &( ( *mount_handle )->reader_handles[ reader_handle_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free reader handle: %d.",
+					 function,
+					 reader_handle_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *mount_handle )->reader_handles );
+		}
+#endif
 		if( libewf_handle_free(
 		     &( ( *mount_handle )->input_handle ),
 		     error ) != 1 )
@@ -185,7 +220,11 @@ int mount_handle_signal_abort(
      mount_handle_t *mount_handle,
      libcerror_error_t **error )
 {
-	static char *function = "mount_handle_signal_abort";
+	static char *function   = "mount_handle_signal_abort";
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int reader_handle_index = 0;
+#endif
 
 	if( mount_handle == NULL )
 	{
@@ -214,6 +253,27 @@ int mount_handle_signal_abort(
 			return( -1 );
 		}
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	for( reader_handle_index = 0;
+	     reader_handle_index < mount_handle->number_of_reader_handles;
+	     reader_handle_index++ )
+	{
+		if( libewf_handle_signal_abort(
+		     mount_handle->reader_handles[ reader_handle_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal reader handle: %d to abort.",
+			 function,
+			 reader_handle_index );
+
+			return( -1 );
+		}
+	}
+#endif
 	return( 1 );
 }
 
@@ -252,9 +312,69 @@ int mount_handle_set_maximum_number_of_open_handles(
 
 		return( -1 );
 	}
+	mount_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+
 	return( 1 );
 }
 
+/* Sets the number of threads
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int mount_handle_set_number_of_threads(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function      = "mount_handle_set_number_of_threads";
+	size_t string_length       = 0;
+	uint64_t number_of_threads = 0;
+	int result                 = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string[ 0 ] != (system_character_t) '-' )
+	{
+		string_length = system_string_length(
+				 string );
+
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine number of threads.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+
+		if( number_of_threads > 32 )
+		{
+			result = 0;
+		}
+		else
+		{
+			mount_handle->number_of_threads = (int) number_of_threads;
+		}
+	}
+	return( result );
+}
+
 /* Sets the format
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
@@ -466,9 +586,208 @@ int mount_handle_open_input(
 			return( -1 );
 		}
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The file entries are bound to the input handle, hence the reader handles
+	 * are only used for the raw format
+	 */
+	if( ( mount_handle->input_format == MOUNT_HANDLE_INPUT_FORMAT_RAW )
+	 && ( mount_handle->number_of_threads > 1 ) )
+	{
+		if( mount_handle_open_reader_handles(
+		     mount_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open reader handles.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	return( 1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Opens the reader handles
+ * The media data is divided in chunk aligned regions that are distributed over
+ * the reader handles, so that reads of different regions do not have to wait
+ * on the same handle lock and repeated reads of a region are served from
+ * the chunk cache of the same handle
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_open_reader_handles(
+     mount_handle_t *mount_handle,
+     libcerror_error_t **error )
+{
+	static char *function              = "mount_handle_open_reader_handles";
+	size32_t chunk_size                = 0;
+	int maximum_number_of_open_handles = 0;
+	int number_of_reader_handles       = 0;
+	int reader_handle_index            = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_handle->reader_handles != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid mount handle - reader handles value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mount_handle->number_of_threads <= 1 )
+	 || ( mount_handle->number_of_threads > 32 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid mount handle - number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The input handle is used as the first reader handle
+	 */
+	number_of_reader_handles = mount_handle->number_of_threads - 1;
+
+	mount_handle->reader_handles = (libewf_handle_t **) memory_allocate(
+	                                                     sizeof( libewf_handle_t * ) * number_of_reader_handles );
+
+	if( mount_handle->reader_handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create reader handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     mount_handle->reader_handles,
+	     0,
+	     sizeof( libewf_handle_t * ) * number_of_reader_handles ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear reader handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_chunk_size(
+	     mount_handle->input_handle,
+	     &chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk size from input handle.",
+		 function );
+
+		goto on_error;
+	}
+	mount_handle->reader_region_size = MOUNT_HANDLE_READER_REGION_SIZE;
+
+	if( ( chunk_size != 0 )
+	 && ( ( mount_handle->reader_region_size % chunk_size ) != 0 ) )
+	{
+		mount_handle->reader_region_size = ( ( mount_handle->reader_region_size / chunk_size ) + 1 ) * chunk_size;
+	}
+	/* The open file handles are divided over the reader handles
+	 */
+	if( mount_handle->maximum_number_of_open_handles > 0 )
+	{
+		maximum_number_of_open_handles = mount_handle->maximum_number_of_open_handles / mount_handle->number_of_threads;
+
+		if( maximum_number_of_open_handles == 0 )
+		{
+			maximum_number_of_open_handles = 1;
+		}
+		if( libewf_handle_set_maximum_number_of_open_handles(
+		     mount_handle->input_handle,
+		     maximum_number_of_open_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles in input handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( reader_handle_index = 0;
+	     reader_handle_index < number_of_reader_handles;
+	     reader_handle_index++ )
+	{
+		if( libewf_handle_clone(
+		     &( mount_handle->reader_handles[ reader_handle_index ] ),
+		     mount_handle->input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create reader handle: %d.",
+			 function,
+			 reader_handle_index );
+
+			goto on_error;
+		}
+		mount_handle->number_of_reader_handles += 1;
+	}
 	return( 1 );
+
+on_error:
+	if( mount_handle->reader_handles != NULL )
+	{
+		for( reader_handle_index = 0;
+		     reader_handle_index < mount_handle->number_of_reader_handles;
+		     reader_handle_index++ )
+		{
+			libewf_handle_free(
+			 &( mount_handle->reader_handles[ reader_handle_index ] ),
+			 NULL );
+		}
+		memory_free(
+		 mount_handle->reader_handles );
+
+		mount_handle->reader_handles = NULL;
+	}
+	mount_handle->number_of_reader_handles = 0;
+
+	return( -1 );
 }
 
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 /* Closes the mount handle
  * Returns the 0 if succesful or -1 on error
  */
@@ -476,7 +795,11 @@ int mount_handle_close(
      mount_handle_t *mount_handle,
      libcerror_error_t **error )
 {
-	static char *function = "mount_handle_close";
+	static char *function   = "mount_handle_close";
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int reader_handle_index = 0;
+#endif
 
 	if( mount_handle == NULL )
 	{
@@ -489,6 +812,27 @@ int mount_handle_close(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	for( reader_handle_index = 0;
+	     reader_handle_index < mount_handle->number_of_reader_handles;
+	     reader_handle_index++ )
+	{
+		if( libewf_handle_close(
+		     mount_handle->reader_handles[ reader_handle_index ],
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close reader handle: %d.",
+			 function,
+			 reader_handle_index );
+
+			return( -1 );
+		}
+	}
+#endif
 	if( libewf_handle_close(
 	     mount_handle->input_handle,
 	     error ) != 0 )
@@ -548,6 +892,77 @@ ssize_t mount_handle_read_buffer(
 	return( read_count );
 }
 
+/* Reads a buffer at a specific offset from the input handle
+ * This function does not change the current offset of the input handle
+ * and can be called concurrently
+ * Return the number of bytes read if successful or -1 on error
+ */
+ssize_t mount_handle_read_buffer_at_offset(
+         mount_handle_t *mount_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_handle_t *reader_handle = NULL;
+	static char *function          = "mount_handle_read_buffer_at_offset";
+	ssize_t read_count             = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int reader_handle_index        = 0;
+#endif
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( mount_handle->number_of_reader_handles > 0 )
+	 && ( mount_handle->reader_region_size > 0 )
+	 && ( offset >= 0 ) )
+	{
+		/* Reader handle index 0 refers to the input handle
+		 */
+		reader_handle_index = (int) ( ( (size64_t) offset / mount_handle->reader_region_size ) % ( mount_handle->number_of_reader_handles + 1 ) );
+	}
+	if( reader_handle_index > 0 )
+	{
+		reader_handle = mount_handle->reader_handles[ reader_handle_index - 1 ];
+	}
+	else
+#endif
+	{
+		reader_handle = mount_handle->input_handle;
+	}
+	read_count = libewf_handle_read_buffer_at_offset(
+	              reader_handle,
+	              buffer,
+	              size,
+	              offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " from input handle.",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
 /* Seeks a specific offset from the input handle
  * Return the offset if successful or -1 on error
  */
@@ -628,6 +1043,44 @@ int mount_handle_get_media_size(
 	return( 1 );
 }
 
+/* Retrieves the chunk size of the input handle
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_get_chunk_size(
+     mount_handle_t *mount_handle,
+     size32_t *chunk_size,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_get_chunk_size";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_chunk_size(
+	     mount_handle->input_handle,
+	     chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk size from input handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Retrieves the file entry of a specific path
  * Returns 1 if successful, 0 if no such file entry or -1 on error
  */
@@ -33,6 +33,8 @@
 extern "C" {
 #endif
 
+#define MOUNT_HANDLE_READER_REGION_SIZE		( 1024 * 1024 )
+
 enum MOUNT_HANDLE_INPUT_FORMATS
 {
 	MOUNT_HANDLE_INPUT_FORMAT_FILES	= (int) 'f',
@@ -55,6 +57,28 @@ struct mount_handle
 	 */
 	libewf_file_entry_t *root_file_entry;
 
+	/* The maximum number of (concurrent) open file handles
+	 */
+	int maximum_number_of_open_handles;
+
+	/* The number of threads that read concurrently
+	 */
+	int number_of_threads;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The reader handles, clones of the libewf input handle that are used for concurrent reads
+	 */
+	libewf_handle_t **reader_handles;
+
+	/* The number of reader handles
+	 */
+	int number_of_reader_handles;
+
+	/* The size of the media data regions, where every region is read by the same reader handle
+	 */
+	size64_t reader_region_size;
+#endif
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
@@ -77,6 +101,11 @@ int mount_handle_set_maximum_number_of_open_handles(
      int maximum_number_of_open_handles,
      libcerror_error_t **error );
 
+int mount_handle_set_number_of_threads(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int mount_handle_set_format(
      mount_handle_t *mount_handle,
      const system_character_t *string,
@@ -88,6 +117,14 @@ int mount_handle_open_input(
      int number_of_filenames,
      libcerror_error_t **error );
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int mount_handle_open_reader_handles(
+     mount_handle_t *mount_handle,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 int mount_handle_close(
      mount_handle_t *mount_handle,
      libcerror_error_t **error );
@@ -98,6 +135,13 @@ ssize_t mount_handle_read_buffer(
          size_t size,
          libcerror_error_t **error );
 
+ssize_t mount_handle_read_buffer_at_offset(
+         mount_handle_t *mount_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 off64_t mount_handle_seek_offset(
          mount_handle_t *mount_handle,
          off64_t offset,
@@ -109,6 +153,11 @@ int mount_handle_get_media_size(
      size64_t *size,
      libcerror_error_t **error );
 
+int mount_handle_get_chunk_size(
+     mount_handle_t *mount_handle,
+     size32_t *chunk_size,
+     libcerror_error_t **error );
+
 int mount_handle_get_file_entry_by_path(
      mount_handle_t *mount_handle,
      const system_character_t *path,
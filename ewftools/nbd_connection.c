@@ -0,0 +1,2372 @@
+/*
+ * Network Block Device (NBD) connection
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_SYS_SOCKET_H )
+#include <sys/socket.h>
+#include <poll.h>
+#endif
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libewf.h"
+#include "ewftools_unused.h"
+#include "nbd_connection.h"
+#include "nbd_handle.h"
+
+/* The NBD protocol values, as defined by the NBD protocol specification
+ */
+#define NBD_MAGIC					0x4e42444d41474943ULL
+#define NBD_OPTION_MAGIC				0x49484156454f5054ULL
+#define NBD_OPTION_REPLY_MAGIC				0x0003e889045565a9ULL
+#define NBD_REQUEST_MAGIC				0x25609513UL
+#define NBD_SIMPLE_REPLY_MAGIC				0x67446698UL
+#define NBD_STRUCTURED_REPLY_MAGIC			0x668e33efUL
+
+#define NBD_FLAG_FIXED_NEWSTYLE				0x0001
+#define NBD_FLAG_NO_ZEROES				0x0002
+
+#define NBD_FLAG_C_NO_ZEROES				0x00000002UL
+
+#define NBD_OPT_EXPORT_NAME				1
+#define NBD_OPT_ABORT					2
+#define NBD_OPT_LIST					3
+#define NBD_OPT_INFO					6
+#define NBD_OPT_GO					7
+#define NBD_OPT_STRUCTURED_REPLY			8
+#define NBD_OPT_LIST_META_CONTEXT			9
+#define NBD_OPT_SET_META_CONTEXT			10
+
+#define NBD_REP_ACK					1
+#define NBD_REP_SERVER					2
+#define NBD_REP_INFO					3
+#define NBD_REP_META_CONTEXT				4
+#define NBD_REP_ERR_UNSUP				0x80000001UL
+#define NBD_REP_ERR_INVALID				0x80000003UL
+#define NBD_REP_ERR_TOO_BIG				0x80000009UL
+
+#define NBD_INFO_EXPORT					0
+#define NBD_INFO_BLOCK_SIZE				3
+
+#define NBD_FLAG_HAS_FLAGS				0x0001
+#define NBD_FLAG_READ_ONLY				0x0002
+#define NBD_FLAG_SEND_FLUSH				0x0004
+#define NBD_FLAG_SEND_DF				0x0080
+#define NBD_FLAG_CAN_MULTI_CONN				0x0100
+#define NBD_FLAG_SEND_CACHE				0x0400
+
+#define NBD_CMD_FLAG_REQ_ONE				0x0008
+
+#define NBD_CMD_READ					0
+#define NBD_CMD_WRITE					1
+#define NBD_CMD_DISC					2
+#define NBD_CMD_FLUSH					3
+#define NBD_CMD_TRIM					4
+#define NBD_CMD_CACHE					5
+#define NBD_CMD_WRITE_ZEROES				6
+#define NBD_CMD_BLOCK_STATUS				7
+
+#define NBD_REPLY_FLAG_DONE				0x0001
+
+#define NBD_REPLY_TYPE_OFFSET_DATA			1
+#define NBD_REPLY_TYPE_BLOCK_STATUS			5
+#define NBD_REPLY_TYPE_ERROR				0x8001
+
+#define NBD_STATE_HOLE					0x00000001UL
+#define NBD_STATE_ZERO					0x00000002UL
+
+#define NBD_EPERM					1
+#define NBD_EIO						5
+#define NBD_EINVAL					22
+
+#define NBD_BASE_ALLOCATION_CONTEXT_IDENTIFIER		1
+
+#if defined( MSG_NOSIGNAL )
+#define NBD_SEND_FLAGS					MSG_NOSIGNAL
+#else
+#define NBD_SEND_FLAGS					0
+#endif
+
+#if defined( HAVE_SYS_SOCKET_H )
+
+/* Creates a NBD connection
+ * Make sure the value nbd_connection is referencing, is set to NULL
+ * The connection takes over the socket descriptor, also on error
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_initialize(
+     nbd_connection_t **nbd_connection,
+     nbd_handle_t *nbd_handle,
+     int socket_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_initialize";
+	size_t status_size    = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		goto on_error;
+	}
+	if( *nbd_connection != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD connection value already set.",
+		 function );
+
+		goto on_error;
+	}
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		goto on_error;
+	}
+	*nbd_connection = memory_allocate_structure(
+	                   nbd_connection_t );
+
+	if( *nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create NBD connection.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *nbd_connection,
+	     0,
+	     sizeof( nbd_connection_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear NBD connection.",
+		 function );
+
+		memory_free(
+		 *nbd_connection );
+
+		*nbd_connection = NULL;
+
+		goto on_error;
+	}
+	( *nbd_connection )->nbd_handle        = nbd_handle;
+	( *nbd_connection )->socket_descriptor = socket_descriptor;
+
+	if( nbd_handle_clone_input_handle(
+	     nbd_handle,
+	     &( ( *nbd_connection )->input_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create input handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_data_chunk(
+	     ( *nbd_connection )->input_handle,
+	     &( ( *nbd_connection )->data_chunk ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create data chunk.",
+		 function );
+
+		goto on_error;
+	}
+	( *nbd_connection )->option_buffer = (uint8_t *) memory_allocate(
+	                                                  sizeof( uint8_t ) * NBD_CONNECTION_MAXIMUM_OPTION_SIZE );
+
+	if( ( *nbd_connection )->option_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create option buffer.",
+		 function );
+
+		goto on_error;
+	}
+	( *nbd_connection )->chunk_buffer = (uint8_t *) memory_allocate(
+	                                                 sizeof( uint8_t ) * nbd_handle->chunk_size );
+
+	if( ( *nbd_connection )->chunk_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk buffer.",
+		 function );
+
+		goto on_error;
+	}
+	/* The block status reply consists of a 20 byte structured reply header,
+	 * a 4 byte context identifier and a 8 byte descriptor per extent
+	 */
+	status_size = 24 + ( 8 * NBD_CONNECTION_MAXIMUM_NUMBER_OF_STATUS_CHUNKS );
+
+	( *nbd_connection )->status_buffer = (uint8_t *) memory_allocate(
+	                                                  sizeof( uint8_t ) * status_size );
+
+	if( ( *nbd_connection )->status_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create status buffer.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( ( nbd_connection != NULL )
+	 && ( *nbd_connection != NULL ) )
+	{
+		nbd_connection_free(
+		 nbd_connection,
+		 NULL );
+	}
+	else if( socket_descriptor != -1 )
+	{
+		close(
+		 socket_descriptor );
+	}
+	return( -1 );
+}
+
+/* Frees a NBD connection
+ * This closes the socket descriptor
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_free(
+     nbd_connection_t **nbd_connection,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_free";
+	int result            = 1;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( *nbd_connection != NULL )
+	{
+		if( ( *nbd_connection )->socket_descriptor != -1 )
+		{
+			close(
+			 ( *nbd_connection )->socket_descriptor );
+		}
+		if( ( *nbd_connection )->status_buffer != NULL )
+		{
+			memory_free(
+			 ( *nbd_connection )->status_buffer );
+		}
+		if( ( *nbd_connection )->packed_buffer != NULL )
+		{
+			memory_free(
+			 ( *nbd_connection )->packed_buffer );
+		}
+		if( ( *nbd_connection )->chunk_buffer != NULL )
+		{
+			memory_free(
+			 ( *nbd_connection )->chunk_buffer );
+		}
+		if( ( *nbd_connection )->reply_buffer != NULL )
+		{
+			memory_free(
+			 ( *nbd_connection )->reply_buffer );
+		}
+		if( ( *nbd_connection )->option_buffer != NULL )
+		{
+			memory_free(
+			 ( *nbd_connection )->option_buffer );
+		}
+		if( ( *nbd_connection )->data_chunk != NULL )
+		{
+			if( libewf_data_chunk_free(
+			     &( ( *nbd_connection )->data_chunk ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free data chunk.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *nbd_connection )->input_handle != NULL )
+		{
+			if( libewf_handle_free(
+			     &( ( *nbd_connection )->input_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free input handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *nbd_connection );
+
+		*nbd_connection = NULL;
+	}
+	return( result );
+}
+
+/* Receives a buffer from the socket
+ * Waits at most NBD_HANDLE_POLL_TIMEOUT milliseconds at a time so that abort is honoured
+ * Returns 1 if successful, 0 if the connection was closed or abort was signalled or -1 on error
+ */
+int nbd_connection_receive(
+     nbd_connection_t *nbd_connection,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	struct pollfd poll_descriptor;
+
+	static char *function = "nbd_connection_receive";
+	size_t buffer_offset  = 0;
+	ssize_t read_count    = 0;
+	int result            = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	poll_descriptor.fd     = nbd_connection->socket_descriptor;
+	poll_descriptor.events = POLLIN;
+
+	while( buffer_offset < size )
+	{
+		if( nbd_connection->nbd_handle->abort != 0 )
+		{
+			return( 0 );
+		}
+		poll_descriptor.revents = 0;
+
+		result = poll(
+		          &poll_descriptor,
+		          1,
+		          NBD_HANDLE_POLL_TIMEOUT );
+
+		if( result == 0 )
+		{
+			continue;
+		}
+		else if( result == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to poll socket.",
+			 function );
+
+			return( -1 );
+		}
+		read_count = recv(
+		              nbd_connection->socket_descriptor,
+		              &( buffer[ buffer_offset ] ),
+		              size - buffer_offset,
+		              0 );
+
+		if( read_count == 0 )
+		{
+			return( 0 );
+		}
+		else if( read_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to receive data.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset += (size_t) read_count;
+	}
+	return( 1 );
+}
+
+/* Sends a buffer to the socket
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_send(
+     nbd_connection_t *nbd_connection,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_send";
+	size_t buffer_offset  = 0;
+	ssize_t write_count   = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer == NULL )
+	 && ( size > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		write_count = send(
+		               nbd_connection->socket_descriptor,
+		               &( buffer[ buffer_offset ] ),
+		               size - buffer_offset,
+		               NBD_SEND_FLAGS );
+
+		if( write_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to send data.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset += (size_t) write_count;
+	}
+	return( 1 );
+}
+
+/* Sends an option reply
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_send_option_reply(
+     nbd_connection_t *nbd_connection,
+     uint32_t option,
+     uint32_t reply_type,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t reply_header[ 20 ];
+
+	static char *function = "nbd_connection_send_option_reply";
+
+	if( data_size > (size_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 &( reply_header[ 0 ] ),
+	 NBD_OPTION_REPLY_MAGIC );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 8 ] ),
+	 option );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 12 ] ),
+	 reply_type );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 16 ] ),
+	 (uint32_t) data_size );
+
+	if( nbd_connection_send(
+	     nbd_connection,
+	     reply_header,
+	     20,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to send option reply header.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > 0 )
+	{
+		if( nbd_connection_send(
+		     nbd_connection,
+		     data,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to send option reply data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sends the export size and transmission flags
+ * For NBD_OPT_EXPORT_NAME these are sent without an option reply header,
+ * otherwise as a NBD_INFO_EXPORT information reply
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_send_export_information(
+     nbd_connection_t *nbd_connection,
+     uint32_t option,
+     libcerror_error_t **error )
+{
+	uint8_t export_information[ 12 + 124 ];
+
+	static char *function         = "nbd_connection_send_export_information";
+	size_t export_information_size = 0;
+	uint16_t transmission_flags    = 0;
+	int result                     = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	/* The image is read-only and every connection reads the same data,
+	 * hence it is safe for a client to use multiple connections
+	 */
+	transmission_flags = NBD_FLAG_HAS_FLAGS
+	                   | NBD_FLAG_READ_ONLY
+	                   | NBD_FLAG_SEND_FLUSH
+	                   | NBD_FLAG_CAN_MULTI_CONN
+	                   | NBD_FLAG_SEND_CACHE;
+
+	if( nbd_connection->structured_replies != 0 )
+	{
+		transmission_flags |= NBD_FLAG_SEND_DF;
+	}
+	if( memory_set(
+	     export_information,
+	     0,
+	     12 + 124 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear export information.",
+		 function );
+
+		return( -1 );
+	}
+	if( option == NBD_OPT_EXPORT_NAME )
+	{
+		byte_stream_copy_from_uint64_big_endian(
+		 &( export_information[ 0 ] ),
+		 nbd_connection->nbd_handle->media_size );
+
+		byte_stream_copy_from_uint16_big_endian(
+		 &( export_information[ 8 ] ),
+		 transmission_flags );
+
+		export_information_size = 10;
+
+		if( nbd_connection->no_zeroes == 0 )
+		{
+			export_information_size += 124;
+		}
+		result = nbd_connection_send(
+		          nbd_connection,
+		          export_information,
+		          export_information_size,
+		          error );
+	}
+	else
+	{
+		byte_stream_copy_from_uint16_big_endian(
+		 &( export_information[ 0 ] ),
+		 NBD_INFO_EXPORT );
+
+		byte_stream_copy_from_uint64_big_endian(
+		 &( export_information[ 2 ] ),
+		 nbd_connection->nbd_handle->media_size );
+
+		byte_stream_copy_from_uint16_big_endian(
+		 &( export_information[ 10 ] ),
+		 transmission_flags );
+
+		result = nbd_connection_send_option_reply(
+		          nbd_connection,
+		          option,
+		          NBD_REP_INFO,
+		          export_information,
+		          12,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to send export information.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Handles a NBD_OPT_INFO or NBD_OPT_GO option
+ * Every export name refers to the image
+ * Returns 1 if the transmission phase should be entered, 0 if not or -1 on error
+ */
+int nbd_connection_handle_information_option(
+     nbd_connection_t *nbd_connection,
+     uint32_t option,
+     const uint8_t *option_data,
+     size_t option_data_size,
+     libcerror_error_t **error )
+{
+	uint8_t block_size_information[ 14 ];
+
+	static char *function             = "nbd_connection_handle_information_option";
+	size_t option_data_offset         = 0;
+	uint32_t export_name_length       = 0;
+	uint16_t information_type         = 0;
+	uint16_t number_of_requests       = 0;
+	uint16_t request_index            = 0;
+	uint8_t send_block_size           = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( option_data_size < 6 )
+	{
+		return( nbd_connection_send_option_reply(
+		         nbd_connection,
+		         option,
+		         NBD_REP_ERR_INVALID,
+		         NULL,
+		         0,
+		         error ) == 1 ? 0 : -1 );
+	}
+	byte_stream_copy_to_uint32_big_endian(
+	 option_data,
+	 export_name_length );
+
+	if( (size_t) export_name_length > ( option_data_size - 6 ) )
+	{
+		return( nbd_connection_send_option_reply(
+		         nbd_connection,
+		         option,
+		         NBD_REP_ERR_INVALID,
+		         NULL,
+		         0,
+		         error ) == 1 ? 0 : -1 );
+	}
+	option_data_offset = 4 + (size_t) export_name_length;
+
+	byte_stream_copy_to_uint16_big_endian(
+	 &( option_data[ option_data_offset ] ),
+	 number_of_requests );
+
+	option_data_offset += 2;
+
+	if( ( (size_t) number_of_requests * 2 ) != ( option_data_size - option_data_offset ) )
+	{
+		return( nbd_connection_send_option_reply(
+		         nbd_connection,
+		         option,
+		         NBD_REP_ERR_INVALID,
+		         NULL,
+		         0,
+		         error ) == 1 ? 0 : -1 );
+	}
+	for( request_index = 0;
+	     request_index < number_of_requests;
+	     request_index++ )
+	{
+		byte_stream_copy_to_uint16_big_endian(
+		 &( option_data[ option_data_offset ] ),
+		 information_type );
+
+		option_data_offset += 2;
+
+		if( information_type == NBD_INFO_BLOCK_SIZE )
+		{
+			send_block_size = 1;
+		}
+	}
+	if( nbd_connection_send_export_information(
+	     nbd_connection,
+	     option,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to send export information.",
+		 function );
+
+		return( -1 );
+	}
+	/* The chunk size is the preferred block size, since smaller reads
+	 * still require the entire chunk to be read and decompressed
+	 */
+	if( send_block_size != 0 )
+	{
+		byte_stream_copy_from_uint16_big_endian(
+		 &( block_size_information[ 0 ] ),
+		 NBD_INFO_BLOCK_SIZE );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( block_size_information[ 2 ] ),
+		 1 );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( block_size_information[ 6 ] ),
+		 nbd_connection->nbd_handle->chunk_size );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( block_size_information[ 10 ] ),
+		 NBD_CONNECTION_MAXIMUM_READ_SIZE );
+
+		if( nbd_connection_send_option_reply(
+		     nbd_connection,
+		     option,
+		     NBD_REP_INFO,
+		     block_size_information,
+		     14,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to send block size information.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( nbd_connection_send_option_reply(
+	     nbd_connection,
+	     option,
+	     NBD_REP_ACK,
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to send acknowledgement.",
+		 function );
+
+		return( -1 );
+	}
+	if( option == NBD_OPT_GO )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Handles a NBD_OPT_LIST_META_CONTEXT or NBD_OPT_SET_META_CONTEXT option
+ * Only the base:allocation meta context is supported
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_handle_meta_context_option(
+     nbd_connection_t *nbd_connection,
+     uint32_t option,
+     const uint8_t *option_data,
+     size_t option_data_size,
+     libcerror_error_t **error )
+{
+	uint8_t meta_context[ 4 + 15 ];
+
+	static char *function     = "nbd_connection_handle_meta_context_option";
+	size_t option_data_offset = 0;
+	uint32_t export_name_length = 0;
+	uint32_t number_of_queries  = 0;
+	uint32_t query_index        = 0;
+	uint32_t query_length       = 0;
+	uint8_t select_context      = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( option == NBD_OPT_SET_META_CONTEXT )
+	 && ( nbd_connection->structured_replies == 0 ) )
+	{
+		return( nbd_connection_send_option_reply(
+		         nbd_connection,
+		         option,
+		         NBD_REP_ERR_INVALID,
+		         NULL,
+		         0,
+		         error ) );
+	}
+	if( option_data_size < 8 )
+	{
+		return( nbd_connection_send_option_reply(
+		         nbd_connection,
+		         option,
+		         NBD_REP_ERR_INVALID,
+		         NULL,
+		         0,
+		         error ) );
+	}
+	byte_stream_copy_to_uint32_big_endian(
+	 option_data,
+	 export_name_length );
+
+	if( (size_t) export_name_length > ( option_data_size - 8 ) )
+	{
+		return( nbd_connection_send_option_reply(
+		         nbd_connection,
+		         option,
+		         NBD_REP_ERR_INVALID,
+		         NULL,
+		         0,
+		         error ) );
+	}
+	option_data_offset = 4 + (size_t) export_name_length;
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( option_data[ option_data_offset ] ),
+	 number_of_queries );
+
+	option_data_offset += 4;
+
+	/* A list request without queries lists all the meta contexts
+	 */
+	if( ( option == NBD_OPT_LIST_META_CONTEXT )
+	 && ( number_of_queries == 0 ) )
+	{
+		select_context = 1;
+	}
+	for( query_index = 0;
+	     query_index < number_of_queries;
+	     query_index++ )
+	{
+		if( ( option_data_size - option_data_offset ) < 4 )
+		{
+			return( nbd_connection_send_option_reply(
+			         nbd_connection,
+			         option,
+			         NBD_REP_ERR_INVALID,
+			         NULL,
+			         0,
+			         error ) );
+		}
+		byte_stream_copy_to_uint32_big_endian(
+		 &( option_data[ option_data_offset ] ),
+		 query_length );
+
+		option_data_offset += 4;
+
+		if( (size_t) query_length > ( option_data_size - option_data_offset ) )
+		{
+			return( nbd_connection_send_option_reply(
+			         nbd_connection,
+			         option,
+			         NBD_REP_ERR_INVALID,
+			         NULL,
+			         0,
+			         error ) );
+		}
+		if( ( query_length == 15 )
+		 && ( narrow_string_compare(
+		       (char *) &( option_data[ option_data_offset ] ),
+		       "base:allocation",
+		       15 ) == 0 ) )
+		{
+			select_context = 1;
+		}
+		else if( ( option == NBD_OPT_LIST_META_CONTEXT )
+		      && ( query_length == 5 )
+		      && ( narrow_string_compare(
+		            (char *) &( option_data[ option_data_offset ] ),
+		            "base:",
+		            5 ) == 0 ) )
+		{
+			select_context = 1;
+		}
+		option_data_offset += (size_t) query_length;
+	}
+	if( option_data_offset != option_data_size )
+	{
+		return( nbd_connection_send_option_reply(
+		         nbd_connection,
+		         option,
+		         NBD_REP_ERR_INVALID,
+		         NULL,
+		         0,
+		         error ) );
+	}
+	if( option == NBD_OPT_SET_META_CONTEXT )
+	{
+		nbd_connection->base_allocation_context = select_context;
+	}
+	if( select_context != 0 )
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( meta_context[ 0 ] ),
+		 NBD_BASE_ALLOCATION_CONTEXT_IDENTIFIER );
+
+		if( memory_copy(
+		     &( meta_context[ 4 ] ),
+		     "base:allocation",
+		     15 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy meta context name.",
+			 function );
+
+			return( -1 );
+		}
+		if( nbd_connection_send_option_reply(
+		     nbd_connection,
+		     option,
+		     NBD_REP_META_CONTEXT,
+		     meta_context,
+		     4 + 15,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to send meta context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( nbd_connection_send_option_reply(
+	     nbd_connection,
+	     option,
+	     NBD_REP_ACK,
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to send acknowledgement.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Negotiates the connection using the fixed newstyle handshake
+ * Returns 1 if the transmission phase should be entered, 0 if the client ended the connection or -1 on error
+ */
+int nbd_connection_negotiate(
+     nbd_connection_t *nbd_connection,
+     libcerror_error_t **error )
+{
+	uint8_t handshake[ 18 ];
+	uint8_t option_header[ 16 ];
+
+	static char *function    = "nbd_connection_negotiate";
+	size_t read_size         = 0;
+	uint64_t option_magic    = 0;
+	uint32_t client_flags    = 0;
+	uint32_t option          = 0;
+	uint32_t option_size     = 0;
+	int result               = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 &( handshake[ 0 ] ),
+	 NBD_MAGIC );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( handshake[ 8 ] ),
+	 NBD_OPTION_MAGIC );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( handshake[ 16 ] ),
+	 NBD_FLAG_FIXED_NEWSTYLE | NBD_FLAG_NO_ZEROES );
+
+	if( nbd_connection_send(
+	     nbd_connection,
+	     handshake,
+	     18,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to send handshake.",
+		 function );
+
+		return( -1 );
+	}
+	result = nbd_connection_receive(
+	          nbd_connection,
+	          handshake,
+	          4,
+	          error );
+
+	if( result != 1 )
+	{
+		return( result );
+	}
+	byte_stream_copy_to_uint32_big_endian(
+	 handshake,
+	 client_flags );
+
+	if( ( client_flags & NBD_FLAG_C_NO_ZEROES ) != 0 )
+	{
+		nbd_connection->no_zeroes = 1;
+	}
+	while( nbd_connection->nbd_handle->abort == 0 )
+	{
+		result = nbd_connection_receive(
+		          nbd_connection,
+		          option_header,
+		          16,
+		          error );
+
+		if( result != 1 )
+		{
+			return( result );
+		}
+		byte_stream_copy_to_uint64_big_endian(
+		 &( option_header[ 0 ] ),
+		 option_magic );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( option_header[ 8 ] ),
+		 option );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( option_header[ 12 ] ),
+		 option_size );
+
+		if( option_magic != NBD_OPTION_MAGIC )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_SIGNATURE_MISMATCH,
+			 "%s: unsupported option magic.",
+			 function );
+
+			return( -1 );
+		}
+		if( option_size > NBD_CONNECTION_MAXIMUM_OPTION_SIZE )
+		{
+			/* The option data is discarded to remain in sync with the client
+			 */
+			while( option_size > 0 )
+			{
+				read_size = NBD_CONNECTION_MAXIMUM_OPTION_SIZE;
+
+				if( read_size > (size_t) option_size )
+				{
+					read_size = (size_t) option_size;
+				}
+				result = nbd_connection_receive(
+				          nbd_connection,
+				          nbd_connection->option_buffer,
+				          read_size,
+				          error );
+
+				if( result != 1 )
+				{
+					return( result );
+				}
+				option_size -= (uint32_t) read_size;
+			}
+			if( option == NBD_OPT_EXPORT_NAME )
+			{
+				return( 0 );
+			}
+			if( nbd_connection_send_option_reply(
+			     nbd_connection,
+			     option,
+			     NBD_REP_ERR_TOO_BIG,
+			     NULL,
+			     0,
+			     error ) != 1 )
+			{
+				return( -1 );
+			}
+			continue;
+		}
+		if( option_size > 0 )
+		{
+			result = nbd_connection_receive(
+			          nbd_connection,
+			          nbd_connection->option_buffer,
+			          (size_t) option_size,
+			          error );
+
+			if( result != 1 )
+			{
+				return( result );
+			}
+		}
+		switch( option )
+		{
+			case NBD_OPT_EXPORT_NAME:
+				if( nbd_connection_send_export_information(
+				     nbd_connection,
+				     option,
+				     error ) != 1 )
+				{
+					return( -1 );
+				}
+				return( 1 );
+
+			case NBD_OPT_ABORT:
+				/* The client is allowed to close the connection without waiting for the acknowledgement
+				 */
+				nbd_connection_send_option_reply(
+				 nbd_connection,
+				 option,
+				 NBD_REP_ACK,
+				 NULL,
+				 0,
+				 NULL );
+
+				return( 0 );
+
+			case NBD_OPT_LIST:
+				if( option_size != 0 )
+				{
+					result = nbd_connection_send_option_reply(
+					          nbd_connection,
+					          option,
+					          NBD_REP_ERR_INVALID,
+					          NULL,
+					          0,
+					          error );
+				}
+				else
+				{
+					/* The image is listed as the default export with an empty name
+					 */
+					byte_stream_copy_from_uint32_big_endian(
+					 handshake,
+					 0 );
+
+					result = nbd_connection_send_option_reply(
+					          nbd_connection,
+					          option,
+					          NBD_REP_SERVER,
+					          handshake,
+					          4,
+					          error );
+
+					if( result == 1 )
+					{
+						result = nbd_connection_send_option_reply(
+						          nbd_connection,
+						          option,
+						          NBD_REP_ACK,
+						          NULL,
+						          0,
+						          error );
+					}
+				}
+				break;
+
+			case NBD_OPT_INFO:
+			case NBD_OPT_GO:
+				result = nbd_connection_handle_information_option(
+				          nbd_connection,
+				          option,
+				          nbd_connection->option_buffer,
+				          (size_t) option_size,
+				          error );
+
+				if( result == 1 )
+				{
+					return( 1 );
+				}
+				else if( result == 0 )
+				{
+					result = 1;
+				}
+				break;
+
+			case NBD_OPT_STRUCTURED_REPLY:
+				if( option_size != 0 )
+				{
+					result = nbd_connection_send_option_reply(
+					          nbd_connection,
+					          option,
+					          NBD_REP_ERR_INVALID,
+					          NULL,
+					          0,
+					          error );
+				}
+				else
+				{
+					nbd_connection->structured_replies = 1;
+
+					result = nbd_connection_send_option_reply(
+					          nbd_connection,
+					          option,
+					          NBD_REP_ACK,
+					          NULL,
+					          0,
+					          error );
+				}
+				break;
+
+			case NBD_OPT_LIST_META_CONTEXT:
+			case NBD_OPT_SET_META_CONTEXT:
+				result = nbd_connection_handle_meta_context_option(
+				          nbd_connection,
+				          option,
+				          nbd_connection->option_buffer,
+				          (size_t) option_size,
+				          error );
+				break;
+
+			default:
+				result = nbd_connection_send_option_reply(
+				          nbd_connection,
+				          option,
+				          NBD_REP_ERR_UNSUP,
+				          NULL,
+				          0,
+				          error );
+				break;
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to reply to option: %" PRIu32 ".",
+			 function,
+			 option );
+
+			return( -1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Sends a simple reply without data
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_send_simple_reply(
+     nbd_connection_t *nbd_connection,
+     uint64_t request_handle,
+     uint32_t error_value,
+     libcerror_error_t **error )
+{
+	uint8_t reply_header[ 16 ];
+
+	static char *function = "nbd_connection_send_simple_reply";
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 0 ] ),
+	 NBD_SIMPLE_REPLY_MAGIC );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 4 ] ),
+	 error_value );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( reply_header[ 8 ] ),
+	 request_handle );
+
+	if( nbd_connection_send(
+	     nbd_connection,
+	     reply_header,
+	     16,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to send simple reply.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sends an error reply
+ * A structured error reply is sent if structured replies were negotiated
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_send_error_reply(
+     nbd_connection_t *nbd_connection,
+     uint64_t request_handle,
+     uint32_t error_value,
+     libcerror_error_t **error )
+{
+	uint8_t reply[ 26 ];
+
+	static char *function = "nbd_connection_send_error_reply";
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_connection->structured_replies == 0 )
+	{
+		return( nbd_connection_send_simple_reply(
+		         nbd_connection,
+		         request_handle,
+		         error_value,
+		         error ) );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply[ 0 ] ),
+	 NBD_STRUCTURED_REPLY_MAGIC );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( reply[ 4 ] ),
+	 NBD_REPLY_FLAG_DONE );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( reply[ 6 ] ),
+	 NBD_REPLY_TYPE_ERROR );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( reply[ 8 ] ),
+	 request_handle );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply[ 16 ] ),
+	 6 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply[ 20 ] ),
+	 error_value );
+
+	/* No error message
+	 */
+	byte_stream_copy_from_uint16_big_endian(
+	 &( reply[ 24 ] ),
+	 0 );
+
+	if( nbd_connection_send(
+	     nbd_connection,
+	     reply,
+	     26,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to send structured error reply.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Handles a read request
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_read(
+     nbd_connection_t *nbd_connection,
+     uint64_t request_handle,
+     uint64_t offset,
+     uint32_t length,
+     libcerror_error_t **error )
+{
+	uint8_t *reply_buffer    = NULL;
+	static char *function    = "nbd_connection_read";
+	size_t reply_buffer_size = 0;
+	size_t reply_header_size = 0;
+	ssize_t read_count       = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( length == 0 )
+	 || ( length > NBD_CONNECTION_MAXIMUM_READ_SIZE )
+	 || ( offset > nbd_connection->nbd_handle->media_size )
+	 || ( (uint64_t) length > ( nbd_connection->nbd_handle->media_size - offset ) ) )
+	{
+		return( nbd_connection_send_error_reply(
+		         nbd_connection,
+		         request_handle,
+		         NBD_EINVAL,
+		         error ) );
+	}
+	/* The structured reply header is followed by the 64-bit offset of the data
+	 */
+	if( nbd_connection->structured_replies != 0 )
+	{
+		reply_header_size = 28;
+	}
+	else
+	{
+		reply_header_size = 16;
+	}
+	reply_buffer_size = reply_header_size + (size_t) length;
+
+	if( reply_buffer_size > nbd_connection->reply_buffer_size )
+	{
+		reply_buffer = (uint8_t *) memory_reallocate(
+		                            nbd_connection->reply_buffer,
+		                            sizeof( uint8_t ) * reply_buffer_size );
+
+		if( reply_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize reply buffer.",
+			 function );
+
+			return( -1 );
+		}
+		nbd_connection->reply_buffer      = reply_buffer;
+		nbd_connection->reply_buffer_size = reply_buffer_size;
+	}
+	read_count = libewf_handle_read_buffer_at_offset(
+	              nbd_connection->input_handle,
+	              &( nbd_connection->reply_buffer[ reply_header_size ] ),
+	              (size_t) length,
+	              (off64_t) offset,
+	              error );
+
+	if( read_count != (ssize_t) length )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to read: %" PRIu32 " bytes at offset: %" PRIu64 ".\n",
+			 function,
+			 length,
+			 offset );
+
+			if( ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+		}
+#endif
+		libcerror_error_free(
+		 error );
+
+		return( nbd_connection_send_error_reply(
+		         nbd_connection,
+		         request_handle,
+		         NBD_EIO,
+		         error ) );
+	}
+	if( nbd_connection->structured_replies != 0 )
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( nbd_connection->reply_buffer[ 0 ] ),
+		 NBD_STRUCTURED_REPLY_MAGIC );
+
+		byte_stream_copy_from_uint16_big_endian(
+		 &( nbd_connection->reply_buffer[ 4 ] ),
+		 NBD_REPLY_FLAG_DONE );
+
+		byte_stream_copy_from_uint16_big_endian(
+		 &( nbd_connection->reply_buffer[ 6 ] ),
+		 NBD_REPLY_TYPE_OFFSET_DATA );
+
+		byte_stream_copy_from_uint64_big_endian(
+		 &( nbd_connection->reply_buffer[ 8 ] ),
+		 request_handle );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( nbd_connection->reply_buffer[ 16 ] ),
+		 8 + length );
+
+		byte_stream_copy_from_uint64_big_endian(
+		 &( nbd_connection->reply_buffer[ 20 ] ),
+		 offset );
+	}
+	else
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( nbd_connection->reply_buffer[ 0 ] ),
+		 NBD_SIMPLE_REPLY_MAGIC );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( nbd_connection->reply_buffer[ 4 ] ),
+		 0 );
+
+		byte_stream_copy_from_uint64_big_endian(
+		 &( nbd_connection->reply_buffer[ 8 ] ),
+		 request_handle );
+	}
+	if( nbd_connection_send(
+	     nbd_connection,
+	     nbd_connection->reply_buffer,
+	     reply_buffer_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to send read reply.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Determines the allocation status of a chunk
+ * The status flags are set to NBD_STATE_HOLE | NBD_STATE_ZERO if the chunk only
+ * contains zero bytes, otherwise to 0. Chunks that could not be read are reported
+ * as data. Compressed chunks that are too large to contain only zero bytes
+ * and pattern fill chunks are determined without decompressing the chunk
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_get_chunk_status(
+     nbd_connection_t *nbd_connection,
+     off64_t chunk_offset,
+     uint32_t *status_flags,
+     libcerror_error_t **error )
+{
+	uint8_t *packed_buffer        = NULL;
+	static char *function         = "nbd_connection_get_chunk_status";
+	size_t maximum_zero_data_size = 0;
+	size_t packed_data_size       = 0;
+	ssize_t read_count            = 0;
+	uint32_t chunk_flags          = 0;
+	int result                    = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( status_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid status flags.",
+		 function );
+
+		return( -1 );
+	}
+	*status_flags = 0;
+
+	if( libewf_handle_seek_offset(
+	     nbd_connection->input_handle,
+	     chunk_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 ".",
+		 function,
+		 chunk_offset );
+
+		return( -1 );
+	}
+	read_count = libewf_handle_read_packed_data_chunk(
+	              nbd_connection->input_handle,
+	              nbd_connection->data_chunk,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data chunk at offset: %" PRIi64 ".",
+		 function,
+		 chunk_offset );
+
+		return( -1 );
+	}
+	result = libewf_data_chunk_get_packed_data_size(
+	          nbd_connection->data_chunk,
+	          &packed_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve packed data size.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( packed_data_size > nbd_connection->packed_buffer_size )
+		{
+			packed_buffer = (uint8_t *) memory_reallocate(
+			                             nbd_connection->packed_buffer,
+			                             sizeof( uint8_t ) * packed_data_size );
+
+			if( packed_buffer == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize packed buffer.",
+				 function );
+
+				return( -1 );
+			}
+			nbd_connection->packed_buffer      = packed_buffer;
+			nbd_connection->packed_buffer_size = packed_data_size;
+		}
+		read_count = libewf_data_chunk_read_packed_data(
+		              nbd_connection->data_chunk,
+		              nbd_connection->packed_buffer,
+		              nbd_connection->packed_buffer_size,
+		              &chunk_flags,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read packed data from data chunk.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( ( chunk_flags & LIBEWF_DATA_CHUNK_FLAG_USES_PATTERN_FILL ) != 0 )
+		 && ( read_count >= 8 ) )
+		{
+			if( ( nbd_connection->packed_buffer[ 0 ] == 0 )
+			 && ( nbd_connection->packed_buffer[ 1 ] == 0 )
+			 && ( nbd_connection->packed_buffer[ 2 ] == 0 )
+			 && ( nbd_connection->packed_buffer[ 3 ] == 0 )
+			 && ( nbd_connection->packed_buffer[ 4 ] == 0 )
+			 && ( nbd_connection->packed_buffer[ 5 ] == 0 )
+			 && ( nbd_connection->packed_buffer[ 6 ] == 0 )
+			 && ( nbd_connection->packed_buffer[ 7 ] == 0 ) )
+			{
+				*status_flags = NBD_STATE_HOLE | NBD_STATE_ZERO;
+			}
+			return( 1 );
+		}
+		/* A chunk of zero bytes compresses extremely well, hence a compressed
+		 * chunk larger than this cannot contain only zero bytes
+		 */
+		maximum_zero_data_size = ( nbd_connection->nbd_handle->chunk_size / 64 ) + 64;
+
+		if( ( ( chunk_flags & LIBEWF_DATA_CHUNK_FLAG_IS_COMPRESSED ) != 0 )
+		 && ( (size_t) read_count > maximum_zero_data_size ) )
+		{
+			return( 1 );
+		}
+	}
+	read_count = libewf_data_chunk_read_buffer(
+	              nbd_connection->data_chunk,
+	              nbd_connection->chunk_buffer,
+	              (size_t) nbd_connection->nbd_handle->chunk_size,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_free(
+		 error );
+
+		return( 1 );
+	}
+	while( read_count > 0 )
+	{
+		read_count--;
+
+		if( nbd_connection->chunk_buffer[ read_count ] != 0 )
+		{
+			return( 1 );
+		}
+	}
+	*status_flags = NBD_STATE_HOLE | NBD_STATE_ZERO;
+
+	return( 1 );
+}
+
+/* Handles a block status request for the base:allocation meta context
+ * The status is determined per chunk and adjacent chunks with the same
+ * status are described by a single extent. At most NBD_CONNECTION_MAXIMUM_NUMBER_OF_STATUS_CHUNKS
+ * chunks are described per reply, the client requests the remainder if needed
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_block_status(
+     nbd_connection_t *nbd_connection,
+     uint64_t request_handle,
+     uint16_t command_flags,
+     uint64_t offset,
+     uint32_t length,
+     libcerror_error_t **error )
+{
+	static char *function         = "nbd_connection_block_status";
+	size_t status_buffer_offset   = 0;
+	uint64_t chunk_offset         = 0;
+	uint64_t end_offset           = 0;
+	uint64_t extent_size          = 0;
+	uint64_t range_size           = 0;
+	uint32_t chunk_status_flags   = 0;
+	uint32_t extent_status_flags  = 0;
+	uint32_t reply_data_size      = 0;
+	int number_of_chunks          = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( nbd_connection->structured_replies == 0 )
+	 || ( nbd_connection->base_allocation_context == 0 )
+	 || ( length == 0 )
+	 || ( offset >= nbd_connection->nbd_handle->media_size )
+	 || ( (uint64_t) length > ( nbd_connection->nbd_handle->media_size - offset ) ) )
+	{
+		return( nbd_connection_send_error_reply(
+		         nbd_connection,
+		         request_handle,
+		         NBD_EINVAL,
+		         error ) );
+	}
+	end_offset = offset + length;
+
+	/* The descriptors follow the 20 byte structured reply header and 4 byte context identifier
+	 */
+	status_buffer_offset = 24;
+
+	while( ( offset < end_offset )
+	    && ( number_of_chunks < NBD_CONNECTION_MAXIMUM_NUMBER_OF_STATUS_CHUNKS ) )
+	{
+		chunk_offset = offset - ( offset % nbd_connection->nbd_handle->chunk_size );
+
+		if( nbd_connection_get_chunk_status(
+		     nbd_connection,
+		     (off64_t) chunk_offset,
+		     &chunk_status_flags,
+		     error ) != 1 )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to determine status of chunk at offset: %" PRIu64 ".\n",
+				 function,
+				 chunk_offset );
+
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
+
+			return( nbd_connection_send_error_reply(
+			         nbd_connection,
+			         request_handle,
+			         NBD_EIO,
+			         error ) );
+		}
+		range_size = ( chunk_offset + nbd_connection->nbd_handle->chunk_size ) - offset;
+
+		if( range_size > ( end_offset - offset ) )
+		{
+			range_size = end_offset - offset;
+		}
+		if( ( extent_size != 0 )
+		 && ( chunk_status_flags != extent_status_flags ) )
+		{
+			byte_stream_copy_from_uint32_big_endian(
+			 &( nbd_connection->status_buffer[ status_buffer_offset ] ),
+			 (uint32_t) extent_size );
+
+			byte_stream_copy_from_uint32_big_endian(
+			 &( nbd_connection->status_buffer[ status_buffer_offset + 4 ] ),
+			 extent_status_flags );
+
+			status_buffer_offset += 8;
+			extent_size           = 0;
+
+			if( ( command_flags & NBD_CMD_FLAG_REQ_ONE ) != 0 )
+			{
+				break;
+			}
+		}
+		extent_status_flags = chunk_status_flags;
+		extent_size        += range_size;
+		offset             += range_size;
+
+		number_of_chunks++;
+	}
+	if( extent_size != 0 )
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( nbd_connection->status_buffer[ status_buffer_offset ] ),
+		 (uint32_t) extent_size );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( nbd_connection->status_buffer[ status_buffer_offset + 4 ] ),
+		 extent_status_flags );
+
+		status_buffer_offset += 8;
+	}
+	reply_data_size = (uint32_t) ( status_buffer_offset - 20 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( nbd_connection->status_buffer[ 0 ] ),
+	 NBD_STRUCTURED_REPLY_MAGIC );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( nbd_connection->status_buffer[ 4 ] ),
+	 NBD_REPLY_FLAG_DONE );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( nbd_connection->status_buffer[ 6 ] ),
+	 NBD_REPLY_TYPE_BLOCK_STATUS );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( nbd_connection->status_buffer[ 8 ] ),
+	 request_handle );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( nbd_connection->status_buffer[ 16 ] ),
+	 reply_data_size );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( nbd_connection->status_buffer[ 20 ] ),
+	 NBD_BASE_ALLOCATION_CONTEXT_IDENTIFIER );
+
+	if( nbd_connection_send(
+	     nbd_connection,
+	     nbd_connection->status_buffer,
+	     status_buffer_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to send block status reply.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Handles the requests of the transmission phase
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_transmit(
+     nbd_connection_t *nbd_connection,
+     libcerror_error_t **error )
+{
+	uint8_t request[ 28 ];
+
+	static char *function   = "nbd_connection_transmit";
+	size_t read_size        = 0;
+	uint64_t offset         = 0;
+	uint64_t request_handle = 0;
+	uint32_t length         = 0;
+	uint32_t request_magic  = 0;
+	uint16_t command_flags  = 0;
+	uint16_t command_type   = 0;
+	int result              = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	while( nbd_connection->nbd_handle->abort == 0 )
+	{
+		result = nbd_connection_receive(
+		          nbd_connection,
+		          request,
+		          28,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to receive request.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		byte_stream_copy_to_uint32_big_endian(
+		 &( request[ 0 ] ),
+		 request_magic );
+
+		byte_stream_copy_to_uint16_big_endian(
+		 &( request[ 4 ] ),
+		 command_flags );
+
+		byte_stream_copy_to_uint16_big_endian(
+		 &( request[ 6 ] ),
+		 command_type );
+
+		byte_stream_copy_to_uint64_big_endian(
+		 &( request[ 8 ] ),
+		 request_handle );
+
+		byte_stream_copy_to_uint64_big_endian(
+		 &( request[ 16 ] ),
+		 offset );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( request[ 24 ] ),
+		 length );
+
+		if( request_magic != NBD_REQUEST_MAGIC )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_SIGNATURE_MISMATCH,
+			 "%s: unsupported request magic.",
+			 function );
+
+			return( -1 );
+		}
+		switch( command_type )
+		{
+			case NBD_CMD_READ:
+				result = nbd_connection_read(
+				          nbd_connection,
+				          request_handle,
+				          offset,
+				          length,
+				          error );
+				break;
+
+			case NBD_CMD_WRITE:
+				/* The data of the write request is discarded to remain in sync with the client
+				 */
+				while( length > 0 )
+				{
+					read_size = NBD_CONNECTION_MAXIMUM_OPTION_SIZE;
+
+					if( read_size > (size_t) length )
+					{
+						read_size = (size_t) length;
+					}
+					result = nbd_connection_receive(
+					          nbd_connection,
+					          nbd_connection->option_buffer,
+					          read_size,
+					          error );
+
+					if( result != 1 )
+					{
+						return( result == 0 ? 1 : -1 );
+					}
+					length -= (uint32_t) read_size;
+				}
+				result = nbd_connection_send_error_reply(
+				          nbd_connection,
+				          request_handle,
+				          NBD_EPERM,
+				          error );
+				break;
+
+			case NBD_CMD_DISC:
+				return( 1 );
+
+			case NBD_CMD_FLUSH:
+			case NBD_CMD_CACHE:
+				result = nbd_connection_send_simple_reply(
+				          nbd_connection,
+				          request_handle,
+				          0,
+				          error );
+				break;
+
+			case NBD_CMD_TRIM:
+			case NBD_CMD_WRITE_ZEROES:
+				result = nbd_connection_send_error_reply(
+				          nbd_connection,
+				          request_handle,
+				          NBD_EPERM,
+				          error );
+				break;
+
+			case NBD_CMD_BLOCK_STATUS:
+				result = nbd_connection_block_status(
+				          nbd_connection,
+				          request_handle,
+				          command_flags,
+				          offset,
+				          length,
+				          error );
+				break;
+
+			default:
+				result = nbd_connection_send_error_reply(
+				          nbd_connection,
+				          request_handle,
+				          NBD_EINVAL,
+				          error );
+				break;
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to handle request: %" PRIu16 ".",
+			 function,
+			 command_type );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Serves the connection
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_serve(
+     nbd_connection_t *nbd_connection,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_serve";
+	int result            = 0;
+
+	result = nbd_connection_negotiate(
+	          nbd_connection,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to negotiate connection.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 1 );
+	}
+	if( nbd_connection_transmit(
+	     nbd_connection,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to transmit.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Serves a connection from the connection thread pool
+ * The connection is freed after it has been served
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_thread_pool_callback(
+     nbd_connection_t *nbd_connection,
+     void *arguments EWFTOOLS_ATTRIBUTE_UNUSED )
+{
+        libcerror_error_t *error = NULL;
+        static char *function    = "nbd_connection_thread_pool_callback";
+
+	EWFTOOLS_UNREFERENCED_PARAMETER( arguments )
+
+	/* An error of a single connection does not stop the other connections
+	 */
+	if( nbd_connection_serve(
+	     nbd_connection,
+	     &error ) != 1 )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( nbd_connection_free(
+	     &nbd_connection,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free connection.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_VERBOSE_OUTPUT )
+	libcnotify_print_error_backtrace(
+	 error );
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#endif /* defined( HAVE_SYS_SOCKET_H ) */
+
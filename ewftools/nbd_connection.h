@@ -0,0 +1,216 @@
+/*
+ * Network Block Device (NBD) connection
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _NBD_CONNECTION_H )
+#define _NBD_CONNECTION_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libewf.h"
+#include "nbd_handle.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum size of an option sent by the client
+ */
+#define NBD_CONNECTION_MAXIMUM_OPTION_SIZE		4096
+
+/* The maximum size of the data of a read request
+ */
+#define NBD_CONNECTION_MAXIMUM_READ_SIZE		( 32 * 1024 * 1024 )
+
+/* The maximum number of chunks described by a block status reply
+ */
+#define NBD_CONNECTION_MAXIMUM_NUMBER_OF_STATUS_CHUNKS	2048
+
+typedef struct nbd_connection nbd_connection_t;
+
+struct nbd_connection
+{
+	/* The NBD handle
+	 */
+	nbd_handle_t *nbd_handle;
+
+	/* The socket descriptor
+	 */
+	int socket_descriptor;
+
+	/* The libewf input handle, a clone of the input handle of the NBD handle
+	 */
+	libewf_handle_t *input_handle;
+
+	/* The libewf data chunk used to determine the block status
+	 */
+	libewf_data_chunk_t *data_chunk;
+
+	/* The option buffer
+	 */
+	uint8_t *option_buffer;
+
+	/* The reply buffer, that contains the reply header followed by the read data
+	 */
+	uint8_t *reply_buffer;
+
+	/* The size of the reply buffer
+	 */
+	size_t reply_buffer_size;
+
+	/* The chunk buffer
+	 */
+	uint8_t *chunk_buffer;
+
+	/* The packed data buffer
+	 */
+	uint8_t *packed_buffer;
+
+	/* The size of the packed data buffer
+	 */
+	size_t packed_buffer_size;
+
+	/* The block status descriptors buffer
+	 */
+	uint8_t *status_buffer;
+
+	/* Value to indicate the 124 bytes of zeros after the export information are omitted
+	 */
+	uint8_t no_zeroes;
+
+	/* Value to indicate structured replies were negotiated
+	 */
+	uint8_t structured_replies;
+
+	/* Value to indicate the base:allocation meta context was selected
+	 */
+	uint8_t base_allocation_context;
+};
+
+int nbd_connection_initialize(
+     nbd_connection_t **nbd_connection,
+     nbd_handle_t *nbd_handle,
+     int socket_descriptor,
+     libcerror_error_t **error );
+
+int nbd_connection_free(
+     nbd_connection_t **nbd_connection,
+     libcerror_error_t **error );
+
+int nbd_connection_receive(
+     nbd_connection_t *nbd_connection,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int nbd_connection_send(
+     nbd_connection_t *nbd_connection,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int nbd_connection_send_option_reply(
+     nbd_connection_t *nbd_connection,
+     uint32_t option,
+     uint32_t reply_type,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_send_export_information(
+     nbd_connection_t *nbd_connection,
+     uint32_t option,
+     libcerror_error_t **error );
+
+int nbd_connection_handle_information_option(
+     nbd_connection_t *nbd_connection,
+     uint32_t option,
+     const uint8_t *option_data,
+     size_t option_data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_handle_meta_context_option(
+     nbd_connection_t *nbd_connection,
+     uint32_t option,
+     const uint8_t *option_data,
+     size_t option_data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_negotiate(
+     nbd_connection_t *nbd_connection,
+     libcerror_error_t **error );
+
+int nbd_connection_send_simple_reply(
+     nbd_connection_t *nbd_connection,
+     uint64_t request_handle,
+     uint32_t error_value,
+     libcerror_error_t **error );
+
+int nbd_connection_send_error_reply(
+     nbd_connection_t *nbd_connection,
+     uint64_t request_handle,
+     uint32_t error_value,
+     libcerror_error_t **error );
+
+int nbd_connection_read(
+     nbd_connection_t *nbd_connection,
+     uint64_t request_handle,
+     uint64_t offset,
+     uint32_t length,
+     libcerror_error_t **error );
+
+int nbd_connection_get_chunk_status(
+     nbd_connection_t *nbd_connection,
+     off64_t chunk_offset,
+     uint32_t *status_flags,
+     libcerror_error_t **error );
+
+int nbd_connection_block_status(
+     nbd_connection_t *nbd_connection,
+     uint64_t request_handle,
+     uint16_t command_flags,
+     uint64_t offset,
+     uint32_t length,
+     libcerror_error_t **error );
+
+int nbd_connection_transmit(
+     nbd_connection_t *nbd_connection,
+     libcerror_error_t **error );
+
+int nbd_connection_serve(
+     nbd_connection_t *nbd_connection,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int nbd_connection_thread_pool_callback(
+     nbd_connection_t *nbd_connection,
+     void *arguments );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _NBD_CONNECTION_H ) */
+
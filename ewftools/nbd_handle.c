@@ -0,0 +1,1238 @@
+/*
+ * Network Block Device (NBD) handle
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_SYS_SOCKET_H )
+#include <sys/socket.h>
+#endif
+
+#if defined( HAVE_SYS_UN_H )
+#include <sys/un.h>
+#endif
+
+#if defined( HAVE_NETDB_H )
+#include <netdb.h>
+#endif
+
+#if defined( HAVE_SYS_SOCKET_H )
+#include <poll.h>
+#endif
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+#include "ewftools_system_string.h"
+#include "nbd_connection.h"
+#include "nbd_handle.h"
+
+/* Creates a NBD handle
+ * Make sure the value nbd_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_initialize(
+     nbd_handle_t **nbd_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_initialize";
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *nbd_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*nbd_handle = memory_allocate_structure(
+	               nbd_handle_t );
+
+	if( *nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create NBD handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *nbd_handle,
+	     0,
+	     sizeof( nbd_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear NBD handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_initialize(
+	     &( ( *nbd_handle )->input_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *nbd_handle )->socket_descriptor = -1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	( *nbd_handle )->number_of_threads = 4;
+#endif
+
+	return( 1 );
+
+on_error:
+	if( *nbd_handle != NULL )
+	{
+		memory_free(
+		 *nbd_handle );
+
+		*nbd_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a NBD handle
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_free(
+     nbd_handle_t **nbd_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_free";
+	int result            = 1;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *nbd_handle != NULL )
+	{
+#if defined( HAVE_SYS_SOCKET_H )
+		if( ( *nbd_handle )->socket_descriptor != -1 )
+		{
+			close(
+			 ( *nbd_handle )->socket_descriptor );
+		}
+		if( ( *nbd_handle )->unix_socket_path != NULL )
+		{
+			unlink(
+			 ( *nbd_handle )->unix_socket_path );
+
+			memory_free(
+			 ( *nbd_handle )->unix_socket_path );
+		}
+#endif
+		if( libewf_handle_free(
+		     &( ( *nbd_handle )->input_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input handle.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *nbd_handle );
+
+		*nbd_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the NBD handle to abort
+ * The connections and the accept loop check the abort value
+ * at least every NBD_HANDLE_POLL_TIMEOUT milliseconds
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_signal_abort(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_signal_abort";
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_handle->abort = 1;
+
+	if( nbd_handle->input_handle != NULL )
+	{
+		if( libewf_handle_signal_abort(
+		     nbd_handle->input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input handle to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the maximum number of (concurrent) open file handles
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_set_maximum_number_of_open_handles(
+     nbd_handle_t *nbd_handle,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_set_maximum_number_of_open_handles";
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_set_maximum_number_of_open_handles(
+	     nbd_handle->input_handle,
+	     maximum_number_of_open_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum number of open handles in input handle.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+
+	return( 1 );
+}
+
+/* Sets the number of threads
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int nbd_handle_set_number_of_threads(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function      = "nbd_handle_set_number_of_threads";
+	size_t string_length       = 0;
+	uint64_t number_of_threads = 0;
+	int result                 = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string[ 0 ] != (system_character_t) '-' )
+	{
+		string_length = system_string_length(
+				 string );
+
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine number of threads.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+
+		if( number_of_threads > 32 )
+		{
+			result = 0;
+		}
+		else
+		{
+			nbd_handle->number_of_threads = (int) number_of_threads;
+		}
+	}
+	return( result );
+}
+
+/* Opens the input of the NBD handle
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_open_input(
+     nbd_handle_t *nbd_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     libcerror_error_t **error )
+{
+	system_character_t **libewf_filenames = NULL;
+	static char *function                 = "nbd_handle_open_input";
+	size_t first_filename_length          = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_filenames <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_filenames == 1 )
+	{
+		first_filename_length = system_string_length(
+		                         filenames[ 0 ] );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libewf_glob_wide(
+		     filenames[ 0 ],
+		     first_filename_length,
+		     LIBEWF_FORMAT_UNKNOWN,
+		     &libewf_filenames,
+		     &number_of_filenames,
+		     error ) != 1 )
+#else
+		if( libewf_glob(
+		     filenames[ 0 ],
+		     first_filename_length,
+		     LIBEWF_FORMAT_UNKNOWN,
+		     &libewf_filenames,
+		     &number_of_filenames,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to resolve filename(s).",
+			 function );
+
+			return( -1 );
+		}
+		filenames = (system_character_t * const *) libewf_filenames;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     nbd_handle->input_handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     nbd_handle->input_handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file(s).",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_filenames != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libewf_glob_wide_free(
+		     libewf_filenames,
+		     number_of_filenames,
+		     error ) != 1 )
+#else
+		if( libewf_glob_free(
+		     libewf_filenames,
+		     number_of_filenames,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free globbed filenames.",
+			 function );
+
+			libewf_filenames = NULL;
+
+			return( -1 );
+		}
+		libewf_filenames = NULL;
+	}
+	if( libewf_handle_get_media_size(
+	     nbd_handle->input_handle,
+	     &( nbd_handle->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_chunk_size(
+	     nbd_handle->input_handle,
+	     &( nbd_handle->chunk_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( libewf_filenames != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 libewf_filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 libewf_filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	return( -1 );
+}
+
+/* Closes the NBD handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int nbd_handle_close(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_close";
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_close(
+	     nbd_handle->input_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Clones the input handle for a connection
+ * Every connection reads with its own handle, so that the connections
+ * do not have to wait on the same handle lock and do not evict each
+ * others cached chunks
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_clone_input_handle(
+     nbd_handle_t *nbd_handle,
+     libewf_handle_t **input_handle,
+     libcerror_error_t **error )
+{
+	static char *function              = "nbd_handle_clone_input_handle";
+	int maximum_number_of_open_handles = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_clone(
+	     input_handle,
+	     nbd_handle->input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to clone input handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* The open file handles are divided over the concurrent connections
+	 */
+	if( nbd_handle->maximum_number_of_open_handles > 0 )
+	{
+		maximum_number_of_open_handles = nbd_handle->maximum_number_of_open_handles;
+
+		if( nbd_handle->number_of_threads > 1 )
+		{
+			maximum_number_of_open_handles /= nbd_handle->number_of_threads;
+		}
+		if( maximum_number_of_open_handles == 0 )
+		{
+			maximum_number_of_open_handles = 1;
+		}
+		if( libewf_handle_set_maximum_number_of_open_handles(
+		     *input_handle,
+		     maximum_number_of_open_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles in cloned input handle.",
+			 function );
+
+			libewf_handle_free(
+			 input_handle,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_SYS_SOCKET_H )
+
+/* Listens on a TCP address and port
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_listen_tcp(
+     nbd_handle_t *nbd_handle,
+     const char *address,
+     const char *port,
+     libcerror_error_t **error )
+{
+	struct addrinfo address_hints;
+
+	struct addrinfo *address_information = NULL;
+	struct addrinfo *address_iterator    = NULL;
+	static char *function                = "nbd_handle_listen_tcp";
+	int option_value                     = 1;
+	int result                           = 0;
+	int socket_descriptor                = -1;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->socket_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD handle - socket descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( port == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid port.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &address_hints,
+	     0,
+	     sizeof( struct addrinfo ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear address hints.",
+		 function );
+
+		return( -1 );
+	}
+	address_hints.ai_family   = AF_UNSPEC;
+	address_hints.ai_socktype = SOCK_STREAM;
+	address_hints.ai_flags    = AI_PASSIVE;
+
+	result = getaddrinfo(
+	          address,
+	          port,
+	          &address_hints,
+	          &address_information );
+
+	if( result != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to resolve address with error: %s.",
+		 function,
+		 gai_strerror( result ) );
+
+		return( -1 );
+	}
+	for( address_iterator = address_information;
+	     address_iterator != NULL;
+	     address_iterator = address_iterator->ai_next )
+	{
+		socket_descriptor = socket(
+		                     address_iterator->ai_family,
+		                     address_iterator->ai_socktype,
+		                     address_iterator->ai_protocol );
+
+		if( socket_descriptor == -1 )
+		{
+			continue;
+		}
+		if( setsockopt(
+		     socket_descriptor,
+		     SOL_SOCKET,
+		     SO_REUSEADDR,
+		     &option_value,
+		     sizeof( int ) ) == 0 )
+		{
+			if( bind(
+			     socket_descriptor,
+			     address_iterator->ai_addr,
+			     address_iterator->ai_addrlen ) == 0 )
+			{
+				break;
+			}
+		}
+		close(
+		 socket_descriptor );
+
+		socket_descriptor = -1;
+	}
+	freeaddrinfo(
+	 address_information );
+
+	if( socket_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to bind socket to port: %s.",
+		 function,
+		 port );
+
+		return( -1 );
+	}
+	if( listen(
+	     socket_descriptor,
+	     SOMAXCONN ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to listen on socket.",
+		 function );
+
+		close(
+		 socket_descriptor );
+
+		return( -1 );
+	}
+	nbd_handle->socket_descriptor = socket_descriptor;
+
+	return( 1 );
+}
+
+/* Listens on a Unix domain socket
+ * The socket file is removed when the NBD handle is freed
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_listen_unix(
+     nbd_handle_t *nbd_handle,
+     const char *path,
+     libcerror_error_t **error )
+{
+	struct sockaddr_un socket_address;
+
+	static char *function = "nbd_handle_listen_unix";
+	size_t path_length    = 0;
+	int socket_descriptor = -1;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->socket_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD handle - socket descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	path_length = narrow_string_length(
+	               path );
+
+	if( ( path_length == 0 )
+	 || ( path_length >= sizeof( socket_address.sun_path ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid path length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &socket_address,
+	     0,
+	     sizeof( struct sockaddr_un ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear socket address.",
+		 function );
+
+		return( -1 );
+	}
+	socket_address.sun_family = AF_UNIX;
+
+	if( narrow_string_copy(
+	     socket_address.sun_path,
+	     path,
+	     path_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy path.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_handle->unix_socket_path = narrow_string_allocate(
+	                                path_length + 1 );
+
+	if( nbd_handle->unix_socket_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create Unix socket path.",
+		 function );
+
+		goto on_error;
+	}
+	if( narrow_string_copy(
+	     nbd_handle->unix_socket_path,
+	     path,
+	     path_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy Unix socket path.",
+		 function );
+
+		goto on_error;
+	}
+	nbd_handle->unix_socket_path[ path_length ] = 0;
+
+	socket_descriptor = socket(
+	                     AF_UNIX,
+	                     SOCK_STREAM,
+	                     0 );
+
+	if( socket_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to create socket.",
+		 function );
+
+		goto on_error;
+	}
+	/* An existing file is not replaced
+	 */
+	if( bind(
+	     socket_descriptor,
+	     (struct sockaddr *) &socket_address,
+	     sizeof( struct sockaddr_un ) ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to bind socket to: %s.",
+		 function,
+		 path );
+
+		memory_free(
+		 nbd_handle->unix_socket_path );
+
+		nbd_handle->unix_socket_path = NULL;
+
+		goto on_error;
+	}
+	if( listen(
+	     socket_descriptor,
+	     SOMAXCONN ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to listen on socket.",
+		 function );
+
+		goto on_error;
+	}
+	nbd_handle->socket_descriptor = socket_descriptor;
+
+	return( 1 );
+
+on_error:
+	if( socket_descriptor != -1 )
+	{
+		close(
+		 socket_descriptor );
+	}
+	if( nbd_handle->unix_socket_path != NULL )
+	{
+		unlink(
+		 nbd_handle->unix_socket_path );
+
+		memory_free(
+		 nbd_handle->unix_socket_path );
+
+		nbd_handle->unix_socket_path = NULL;
+	}
+	return( -1 );
+}
+
+/* Accepts and serves connections until abort is signalled
+ * Every connection is served by a separate thread, up to the number of threads
+ * concurrent connections, where further connections wait in the listen backlog
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_serve(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error )
+{
+	struct pollfd poll_descriptor;
+
+	nbd_connection_t *nbd_connection = NULL;
+	static char *function            = "nbd_handle_serve";
+	int result                       = 0;
+	int socket_descriptor            = -1;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->socket_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid NBD handle - missing socket descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( nbd_handle->number_of_threads > 0 )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( nbd_handle->connection_thread_pool ),
+		     NULL,
+		     nbd_handle->number_of_threads,
+		     nbd_handle->number_of_threads,
+		     (int (*)(intptr_t *, void *)) &nbd_connection_thread_pool_callback,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize connection thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	poll_descriptor.fd     = nbd_handle->socket_descriptor;
+	poll_descriptor.events = POLLIN;
+
+	while( nbd_handle->abort == 0 )
+	{
+		poll_descriptor.revents = 0;
+
+		result = poll(
+		          &poll_descriptor,
+		          1,
+		          NBD_HANDLE_POLL_TIMEOUT );
+
+		if( result == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 errno,
+			 "%s: unable to poll socket.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			continue;
+		}
+		socket_descriptor = accept(
+		                     nbd_handle->socket_descriptor,
+		                     NULL,
+		                     NULL );
+
+		if( socket_descriptor == -1 )
+		{
+			if( ( errno == EINTR )
+			 || ( errno == ECONNABORTED ) )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 errno,
+			 "%s: unable to accept connection.",
+			 function );
+
+			goto on_error;
+		}
+		/* The connection takes over the socket descriptor
+		 */
+		if( nbd_connection_initialize(
+		     &nbd_connection,
+		     nbd_handle,
+		     socket_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create connection.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( nbd_handle->connection_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_push(
+			     nbd_handle->connection_thread_pool,
+			     (intptr_t *) nbd_connection,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push connection onto thread pool queue.",
+				 function );
+
+				goto on_error;
+			}
+			nbd_connection = NULL;
+
+			continue;
+		}
+#endif
+		if( nbd_connection_serve(
+		     nbd_connection,
+		     error ) != 1 )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+#endif
+			libcerror_error_free(
+			 error );
+		}
+		if( nbd_connection_free(
+		     &nbd_connection,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free connection.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( nbd_handle->connection_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( nbd_handle->connection_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join connection thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( nbd_connection != NULL )
+	{
+		nbd_connection_free(
+		 &nbd_connection,
+		 NULL );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( nbd_handle->connection_thread_pool != NULL )
+	{
+		nbd_handle->abort = 1;
+
+		libcthreads_thread_pool_join(
+		 &( nbd_handle->connection_thread_pool ),
+		 NULL );
+	}
+#endif
+	return( -1 );
+}
+
+#endif /* defined( HAVE_SYS_SOCKET_H ) */
+
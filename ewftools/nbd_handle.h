@@ -0,0 +1,144 @@
+/*
+ * Network Block Device (NBD) handle
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _NBD_HANDLE_H )
+#define _NBD_HANDLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The default NBD TCP port
+ */
+#define NBD_HANDLE_DEFAULT_PORT			"10809"
+
+/* The time in milliseconds to wait for a socket before checking if abort was signalled
+ */
+#define NBD_HANDLE_POLL_TIMEOUT			1000
+
+typedef struct nbd_handle nbd_handle_t;
+
+struct nbd_handle
+{
+	/* The libewf input handle
+	 */
+	libewf_handle_t *input_handle;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The chunk size
+	 */
+	size32_t chunk_size;
+
+	/* The maximum number of (concurrent) open file handles
+	 */
+	int maximum_number_of_open_handles;
+
+	/* The maximum number of connections that are served concurrently
+	 */
+	int number_of_threads;
+
+	/* The listening socket descriptor
+	 */
+	int socket_descriptor;
+
+	/* The path of the Unix domain socket
+	 */
+	char *unix_socket_path;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The connection thread pool
+	 */
+	libcthreads_thread_pool_t *connection_thread_pool;
+#endif
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int nbd_handle_initialize(
+     nbd_handle_t **nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_free(
+     nbd_handle_t **nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_signal_abort(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_set_maximum_number_of_open_handles(
+     nbd_handle_t *nbd_handle,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error );
+
+int nbd_handle_set_number_of_threads(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int nbd_handle_open_input(
+     nbd_handle_t *nbd_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     libcerror_error_t **error );
+
+int nbd_handle_close(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_clone_input_handle(
+     nbd_handle_t *nbd_handle,
+     libewf_handle_t **input_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_listen_tcp(
+     nbd_handle_t *nbd_handle,
+     const char *address,
+     const char *port,
+     libcerror_error_t **error );
+
+int nbd_handle_listen_unix(
+     nbd_handle_t *nbd_handle,
+     const char *path,
+     libcerror_error_t **error );
+
+int nbd_handle_serve(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _NBD_HANDLE_H ) */
+
@@ -27,6 +27,10 @@
 #include <sys/utsname.h>
 #endif
 
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
 #include "ewftools_libcerror.h"
 #include "ewftools_libclocale.h"
 #include "ewftools_libuna.h"
@@ -265,3 +269,122 @@ int platform_get_operating_system(
 	return( 1 );
 }
 
+/* Determines the number of processors that are online
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int platform_get_number_of_processors(
+     int *number_of_processors,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	SYSTEM_INFO system_info;
+
+#elif defined( HAVE_SYSCONF ) && defined( _SC_NPROCESSORS_ONLN )
+	long sysconf_value    = 0;
+#endif
+
+	static char *function = "platform_get_number_of_processors";
+
+	if( number_of_processors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of processors.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_processors = 0;
+
+#if defined( WINAPI )
+	GetSystemInfo(
+	 &system_info );
+
+	if( system_info.dwNumberOfProcessors > (DWORD) INT_MAX )
+	{
+		*number_of_processors = INT_MAX;
+	}
+	else
+	{
+		*number_of_processors = (int) system_info.dwNumberOfProcessors;
+	}
+#elif defined( HAVE_SYSCONF ) && defined( _SC_NPROCESSORS_ONLN )
+	sysconf_value = sysconf(
+	                 _SC_NPROCESSORS_ONLN );
+
+	if( sysconf_value > (long) INT_MAX )
+	{
+		*number_of_processors = INT_MAX;
+	}
+	else if( sysconf_value > 0 )
+	{
+		*number_of_processors = (int) sysconf_value;
+	}
+#endif
+	if( *number_of_processors <= 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Determines the size of the physical memory
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int platform_get_physical_memory_size(
+     size64_t *physical_memory_size,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI ) && ( WINVER >= 0x0500 )
+	MEMORYSTATUSEX memory_status;
+
+#elif defined( HAVE_SYSCONF ) && defined( _SC_PHYS_PAGES ) && defined( _SC_PAGESIZE )
+	long number_of_pages  = 0;
+	long page_size        = 0;
+#endif
+
+	static char *function = "platform_get_physical_memory_size";
+
+	if( physical_memory_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid physical memory size.",
+		 function );
+
+		return( -1 );
+	}
+	*physical_memory_size = 0;
+
+#if defined( WINAPI ) && ( WINVER >= 0x0500 )
+	memory_status.dwLength = sizeof( MEMORYSTATUSEX );
+
+	if( GlobalMemoryStatusEx(
+	     &memory_status ) != 0 )
+	{
+		*physical_memory_size = (size64_t) memory_status.ullTotalPhys;
+	}
+#elif defined( HAVE_SYSCONF ) && defined( _SC_PHYS_PAGES ) && defined( _SC_PAGESIZE )
+	number_of_pages = sysconf(
+	                   _SC_PHYS_PAGES );
+
+	page_size = sysconf(
+	             _SC_PAGESIZE );
+
+	if( ( number_of_pages > 0 )
+	 && ( page_size > 0 ) )
+	{
+		*physical_memory_size = (size64_t) number_of_pages * (size64_t) page_size;
+	}
+#endif
+	if( *physical_memory_size == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
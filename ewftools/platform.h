@@ -36,6 +36,14 @@ int platform_get_operating_system(
      size_t operating_system_string_size,
      libcerror_error_t **error );
 
+int platform_get_number_of_processors(
+     int *number_of_processors,
+     libcerror_error_t **error );
+
+int platform_get_physical_memory_size(
+     size64_t *physical_memory_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -33,11 +33,16 @@
 #include <time.h>
 #endif
 
+#if defined( HAVE_CLOCK_GETTIME ) && defined( HAVE_SYS_TIME_H ) && !defined( TIME_WITH_SYS_TIME )
+#include <time.h>
+#endif
+
 #include "byte_size_string.h"
 #include "ewftools_libcdatetime.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libclocale.h"
 #include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
 #include "process_status.h"
 
 /* Creates process status information
@@ -243,6 +248,24 @@ int process_status_free(
 
 			result = -1;
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *process_status )->telemetry_mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *process_status )->telemetry_mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free telemetry mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		memory_free(
 		 *process_status );
 
@@ -316,6 +339,23 @@ int process_status_start(
 
 		return( -1 );
 	}
+	if( process_status->telemetry_stream != NULL )
+	{
+		if( process_status_get_timestamp(
+		     &( process_status->telemetry_start_timestamp ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve telemetry start timestamp.",
+			 function );
+
+			return( -1 );
+		}
+		process_status->telemetry_last_timestamp = process_status->telemetry_start_timestamp;
+	}
 	if( ( process_status->output_stream != NULL )
 	 && ( process_status->print_status_information != 0 )
 	 && ( process_status->status_process_string != NULL ) )
@@ -373,6 +413,24 @@ int process_status_update(
 
 		return( -1 );
 	}
+	if( process_status->telemetry_stream != NULL )
+	{
+		if( process_status_telemetry_update(
+		     process_status,
+		     bytes_read,
+		     bytes_total,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update telemetry.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	if( ( process_status->output_stream != NULL )
 	 && ( process_status->print_status_information != 0 )
 	 && ( process_status->status_update_string != NULL ) )
@@ -531,6 +589,24 @@ int process_status_update_unknown_total(
 
 		return( -1 );
 	}
+	if( process_status->telemetry_stream != NULL )
+	{
+		if( process_status_telemetry_update(
+		     process_status,
+		     bytes_read,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update telemetry.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	if( ( process_status->output_stream != NULL )
 	 && ( process_status->print_status_information != 0 )
 	 && ( process_status->status_update_string != NULL ) )
@@ -642,6 +718,7 @@ int process_status_stop(
 	system_character_t time_string[ 32 ];
 
 	const system_character_t *status_string = NULL;
+	const char *telemetry_status_string     = NULL;
 	static char *function                   = "process_status_start";
 	int64_t total_number_of_seconds         = 0;
 
@@ -682,6 +759,37 @@ int process_status_stop(
 
 		return( -1 );
 	}
+	if( process_status->telemetry_stream != NULL )
+	{
+		if( status == PROCESS_STATUS_ABORTED )
+		{
+			telemetry_status_string = "aborted";
+		}
+		else if( status == PROCESS_STATUS_COMPLETED )
+		{
+			telemetry_status_string = "completed";
+		}
+		else
+		{
+			telemetry_status_string = "failed";
+		}
+		if( process_status_telemetry_fprint(
+		     process_status,
+		     bytes_total,
+		     0,
+		     telemetry_status_string,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print telemetry.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	if( ( process_status->output_stream != NULL )
 	 && ( process_status->print_status_information != 0 )
 	 && ( process_status->status_process_string != NULL ) )
@@ -771,6 +879,974 @@ int process_status_stop(
 	return( 1 );
 }
 
+/* Sets the telemetry stream
+ * The telemetry stream receives a JSON object per line at an interval of
+ * PROCESS_STATUS_TELEMETRY_INTERVAL seconds and when the process is stopped
+ * Returns 1 if successful or -1 on error
+ */
+int process_status_set_telemetry(
+     process_status_t *process_status,
+     FILE *telemetry_stream,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "process_status_set_telemetry";
+
+	if( process_status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process status.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of threads value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( telemetry_stream != NULL )
+	 && ( process_status->telemetry_mutex == NULL ) )
+	{
+		if( libcthreads_mutex_initialize(
+		     &( process_status->telemetry_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create telemetry mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	process_status->telemetry_stream  = telemetry_stream;
+	process_status->number_of_threads = number_of_threads;
+
+	return( 1 );
+}
+
+/* Sets if the stage values should be collected without a telemetry stream
+ * Returns 1 if successful or -1 on error
+ */
+int process_status_set_collect_stage_values(
+     process_status_t *process_status,
+     uint8_t collect_stage_values,
+     libcerror_error_t **error )
+{
+	static char *function = "process_status_set_collect_stage_values";
+
+	if( process_status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process status.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( collect_stage_values != 0 )
+	 && ( process_status->telemetry_mutex == NULL ) )
+	{
+		if( libcthreads_mutex_initialize(
+		     &( process_status->telemetry_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create telemetry mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	process_status->collect_stage_values = collect_stage_values;
+
+	return( 1 );
+}
+
+/* Retrieves a timestamp in micro seconds
+ * The timestamp is relative to an unspecified point in time and only
+ * suitable to determine durations
+ * Returns 1 if successful or -1 on error
+ */
+int process_status_get_timestamp(
+     uint64_t *timestamp,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	struct timespec time_value;
+
+#elif defined( HAVE_GETTIMEOFDAY )
+	struct timeval time_value;
+
+#endif
+	static char *function = "process_status_get_timestamp";
+
+	if( timestamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( QueryPerformanceCounter(
+	       &counter ) == 0 )
+	 || ( frequency.QuadPart <= 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve performance counter.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) ( counter.QuadPart / frequency.QuadPart ) * 1000000 )
+	           + ( ( (uint64_t) ( counter.QuadPart % frequency.QuadPart ) * 1000000 ) / (uint64_t) frequency.QuadPart );
+
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_value ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve monotonic clock time.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) time_value.tv_sec * 1000000 )
+	           + ( (uint64_t) time_value.tv_nsec / 1000 );
+
+#elif defined( HAVE_GETTIMEOFDAY )
+	if( gettimeofday(
+	     &time_value,
+	     NULL ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve time of day.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) time_value.tv_sec * 1000000 )
+	           + (uint64_t) time_value.tv_usec;
+
+#else
+	*timestamp = (uint64_t) time( NULL ) * 1000000;
+
+#endif
+	return( 1 );
+}
+
+/* Retrieves the timestamp at the start of a stage
+ * The timestamp is 0 if telemetry is not enabled and stage values are not collected
+ * Returns 1 if successful or -1 on error
+ */
+int process_status_get_stage_timestamp(
+     process_status_t *process_status,
+     uint64_t *timestamp,
+     libcerror_error_t **error )
+{
+	static char *function = "process_status_get_stage_timestamp";
+
+	if( process_status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process status.",
+		 function );
+
+		return( -1 );
+	}
+	if( timestamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( process_status->telemetry_stream == NULL )
+	 && ( process_status->collect_stage_values == 0 ) )
+	{
+		*timestamp = 0;
+
+		return( 1 );
+	}
+	if( process_status_get_timestamp(
+	     timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Adds the number of bytes and the time since the start timestamp to a stage
+ * This function can be called by multiple threads concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int process_status_add_stage_value(
+     process_status_t *process_status,
+     int stage,
+     size64_t number_of_bytes,
+     uint64_t start_timestamp,
+     libcerror_error_t **error )
+{
+	static char *function = "process_status_add_stage_value";
+	uint64_t timestamp    = 0;
+
+	if( process_status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process status.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( stage < 0 )
+	 || ( stage >= PROCESS_STATUS_NUMBER_OF_STAGES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid stage value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( process_status->telemetry_stream == NULL )
+	 && ( process_status->collect_stage_values == 0 ) )
+	{
+		return( 1 );
+	}
+	if( process_status_get_timestamp(
+	     &timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     process_status->telemetry_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab telemetry mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	process_status->stage_number_of_bytes[ stage ] += number_of_bytes;
+
+	if( timestamp > start_timestamp )
+	{
+		process_status->stage_number_of_micro_seconds[ stage ] += timestamp - start_timestamp;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     process_status->telemetry_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release telemetry mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the number of jobs that keeps up with the slowest sequential stage
+ * The number of jobs is determined from the stage values collected since it was
+ * last determined, where the read stage and the hash and write stages are
+ * sequential and the process stage is divided over the jobs
+ * Returns 1 if successful, 0 if not enough stage values were collected or -1 on error
+ */
+int process_status_get_number_of_jobs(
+     process_status_t *process_status,
+     int maximum_number_of_jobs,
+     int *number_of_jobs,
+     libcerror_error_t **error )
+{
+	uint64_t micro_seconds_per_mebibyte[ PROCESS_STATUS_NUMBER_OF_STAGES ];
+	uint64_t stage_number_of_bytes[ PROCESS_STATUS_NUMBER_OF_STAGES ];
+	uint64_t stage_number_of_micro_seconds[ PROCESS_STATUS_NUMBER_OF_STAGES ];
+
+	static char *function             = "process_status_get_number_of_jobs";
+	uint64_t sequential_micro_seconds = 0;
+	uint64_t required_number_of_jobs  = 0;
+	int stage                         = 0;
+	int result                        = 0;
+
+	if( process_status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process status.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_jobs <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of jobs value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_jobs == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of jobs.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( process_status->telemetry_stream == NULL )
+	 && ( process_status->collect_stage_values == 0 ) )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     process_status->telemetry_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab telemetry mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( stage = 0;
+	     stage < PROCESS_STATUS_NUMBER_OF_STAGES;
+	     stage++ )
+	{
+		stage_number_of_bytes[ stage ]         = process_status->stage_number_of_bytes[ stage ]
+		                                       - process_status->jobs_stage_number_of_bytes[ stage ];
+		stage_number_of_micro_seconds[ stage ] = process_status->stage_number_of_micro_seconds[ stage ]
+		                                       - process_status->jobs_stage_number_of_micro_seconds[ stage ];
+	}
+	if( ( stage_number_of_micro_seconds[ PROCESS_STATUS_STAGE_PROCESS ] >= PROCESS_STATUS_NUMBER_OF_JOBS_INTERVAL )
+	 && ( stage_number_of_bytes[ PROCESS_STATUS_STAGE_PROCESS ] > 0 )
+	 && ( stage_number_of_bytes[ PROCESS_STATUS_STAGE_READ ] > 0 ) )
+	{
+		for( stage = 0;
+		     stage < PROCESS_STATUS_NUMBER_OF_STAGES;
+		     stage++ )
+		{
+			process_status->jobs_stage_number_of_bytes[ stage ]         = process_status->stage_number_of_bytes[ stage ];
+			process_status->jobs_stage_number_of_micro_seconds[ stage ] = process_status->stage_number_of_micro_seconds[ stage ];
+		}
+		result = 1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     process_status->telemetry_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release telemetry mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result == 0 )
+	{
+		return( 0 );
+	}
+	for( stage = 0;
+	     stage < PROCESS_STATUS_NUMBER_OF_STAGES;
+	     stage++ )
+	{
+		micro_seconds_per_mebibyte[ stage ] = 0;
+
+		if( stage_number_of_bytes[ stage ] > 0 )
+		{
+			micro_seconds_per_mebibyte[ stage ] = ( stage_number_of_micro_seconds[ stage ] * 1048576 )
+			                                    / stage_number_of_bytes[ stage ];
+		}
+	}
+	/* The output thread hashes and writes the data in order
+	 */
+	sequential_micro_seconds = micro_seconds_per_mebibyte[ PROCESS_STATUS_STAGE_HASH ]
+	                         + micro_seconds_per_mebibyte[ PROCESS_STATUS_STAGE_WRITE ];
+
+	if( sequential_micro_seconds < micro_seconds_per_mebibyte[ PROCESS_STATUS_STAGE_READ ] )
+	{
+		sequential_micro_seconds = micro_seconds_per_mebibyte[ PROCESS_STATUS_STAGE_READ ];
+	}
+	if( sequential_micro_seconds == 0 )
+	{
+		required_number_of_jobs = (uint64_t) maximum_number_of_jobs;
+	}
+	else
+	{
+		/* Use 1 job more than required to keep up with the sequential stages
+		 * so that a job is ready when a sequential stage speeds up
+		 */
+		required_number_of_jobs = ( micro_seconds_per_mebibyte[ PROCESS_STATUS_STAGE_PROCESS ] + sequential_micro_seconds - 1 )
+		                        / sequential_micro_seconds;
+		required_number_of_jobs += 1;
+	}
+	if( required_number_of_jobs > (uint64_t) maximum_number_of_jobs )
+	{
+		required_number_of_jobs = (uint64_t) maximum_number_of_jobs;
+	}
+	*number_of_jobs = (int) required_number_of_jobs;
+
+	return( 1 );
+}
+
+/* Adds the uncompressed and compressed size of written chunks
+ * This function can be called by multiple threads concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int process_status_add_compression_values(
+     process_status_t *process_status,
+     size64_t number_of_uncompressed_bytes,
+     size64_t number_of_compressed_bytes,
+     libcerror_error_t **error )
+{
+	static char *function = "process_status_add_compression_values";
+
+	if( process_status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process status.",
+		 function );
+
+		return( -1 );
+	}
+	if( process_status->telemetry_stream == NULL )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     process_status->telemetry_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab telemetry mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	process_status->number_of_uncompressed_bytes += number_of_uncompressed_bytes;
+	process_status->number_of_compressed_bytes   += number_of_compressed_bytes;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     process_status->telemetry_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release telemetry mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Adds read errors
+ * This function can be called by multiple threads concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int process_status_add_read_errors(
+     process_status_t *process_status,
+     uint32_t number_of_read_errors,
+     libcerror_error_t **error )
+{
+	static char *function = "process_status_add_read_errors";
+
+	if( process_status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process status.",
+		 function );
+
+		return( -1 );
+	}
+	if( process_status->telemetry_stream == NULL )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     process_status->telemetry_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab telemetry mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	process_status->number_of_read_errors += number_of_read_errors;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     process_status->telemetry_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release telemetry mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the storage media buffer values
+ * Returns 1 if successful or -1 on error
+ */
+int process_status_set_buffer_values(
+     process_status_t *process_status,
+     int number_of_buffers_in_use,
+     int maximum_number_of_buffers,
+     int number_of_reordered_buffers,
+     libcerror_error_t **error )
+{
+	static char *function = "process_status_set_buffer_values";
+
+	if( process_status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process status.",
+		 function );
+
+		return( -1 );
+	}
+	if( process_status->telemetry_stream == NULL )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     process_status->telemetry_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab telemetry mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	process_status->number_of_buffers_in_use    = number_of_buffers_in_use;
+	process_status->maximum_number_of_buffers   = maximum_number_of_buffers;
+	process_status->number_of_reordered_buffers = number_of_reordered_buffers;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     process_status->telemetry_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release telemetry mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Prints a telemetry record if the telemetry interval has passed
+ * Returns 1 if successful or -1 on error
+ */
+int process_status_telemetry_update(
+     process_status_t *process_status,
+     size64_t bytes_read,
+     size64_t bytes_total,
+     libcerror_error_t **error )
+{
+	static char *function = "process_status_telemetry_update";
+	uint64_t timestamp    = 0;
+
+	if( process_status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process status.",
+		 function );
+
+		return( -1 );
+	}
+	if( process_status->telemetry_stream == NULL )
+	{
+		return( 1 );
+	}
+	if( process_status_get_timestamp(
+	     &timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( timestamp - process_status->telemetry_last_timestamp ) < ( (uint64_t) PROCESS_STATUS_TELEMETRY_INTERVAL * 1000000 ) )
+	{
+		return( 1 );
+	}
+	if( process_status_telemetry_fprint(
+	     process_status,
+	     bytes_read,
+	     bytes_total,
+	     "running",
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print telemetry.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Prints a telemetry record as a single line JSON object
+ * The durations are in micro seconds and the ratios in parts per thousand
+ * so that the output does not depend on the locale
+ * Returns 1 if successful or -1 on error
+ */
+int process_status_telemetry_fprint(
+     process_status_t *process_status,
+     size64_t bytes_read,
+     size64_t bytes_total,
+     const char *status_string,
+     libcerror_error_t **error )
+{
+	const char *stage_names[ PROCESS_STATUS_NUMBER_OF_STAGES ] = {
+		"read", "process", "hash", "write" };
+
+	uint64_t stage_number_of_bytes[ PROCESS_STATUS_NUMBER_OF_STAGES ];
+	uint64_t stage_number_of_micro_seconds[ PROCESS_STATUS_NUMBER_OF_STAGES ];
+
+	static char *function                 = "process_status_telemetry_fprint";
+	uint64_t elapsed_micro_seconds        = 0;
+	uint64_t number_of_compressed_bytes   = 0;
+	uint64_t number_of_uncompressed_bytes = 0;
+	uint64_t ratio                        = 0;
+	uint64_t timestamp                    = 0;
+	uint32_t number_of_read_errors        = 0;
+	int maximum_number_of_buffers         = 0;
+	int number_of_buffers_in_use          = 0;
+	int number_of_reordered_buffers       = 0;
+	int stage                             = 0;
+
+	if( process_status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process status.",
+		 function );
+
+		return( -1 );
+	}
+	if( status_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid status string.",
+		 function );
+
+		return( -1 );
+	}
+	if( process_status->telemetry_stream == NULL )
+	{
+		return( 1 );
+	}
+	if( process_status_get_timestamp(
+	     &timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	/* Take a consistent copy of the values that are updated by the worker threads
+	 */
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     process_status->telemetry_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab telemetry mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( stage = 0;
+	     stage < PROCESS_STATUS_NUMBER_OF_STAGES;
+	     stage++ )
+	{
+		stage_number_of_bytes[ stage ]         = process_status->stage_number_of_bytes[ stage ];
+		stage_number_of_micro_seconds[ stage ] = process_status->stage_number_of_micro_seconds[ stage ];
+	}
+	number_of_uncompressed_bytes = process_status->number_of_uncompressed_bytes;
+	number_of_compressed_bytes   = process_status->number_of_compressed_bytes;
+	number_of_read_errors        = process_status->number_of_read_errors;
+	number_of_buffers_in_use     = process_status->number_of_buffers_in_use;
+	maximum_number_of_buffers    = process_status->maximum_number_of_buffers;
+	number_of_reordered_buffers  = process_status->number_of_reordered_buffers;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     process_status->telemetry_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release telemetry mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( timestamp > process_status->telemetry_start_timestamp )
+	{
+		elapsed_micro_seconds = timestamp - process_status->telemetry_start_timestamp;
+	}
+	process_status->telemetry_last_timestamp = timestamp;
+
+	fprintf(
+	 process_status->telemetry_stream,
+	 "{" );
+
+	if( process_status->status_process_string != NULL )
+	{
+		fprintf(
+		 process_status->telemetry_stream,
+		 "\"process\":\"%" PRIs_SYSTEM "\",",
+		 process_status->status_process_string );
+	}
+	fprintf(
+	 process_status->telemetry_stream,
+	 "\"status\":\"%s\",\"elapsed_micro_seconds\":%" PRIu64 ",\"bytes\":%" PRIu64 "",
+	 status_string,
+	 elapsed_micro_seconds,
+	 bytes_read );
+
+	if( bytes_total > 0 )
+	{
+		fprintf(
+		 process_status->telemetry_stream,
+		 ",\"bytes_total\":%" PRIu64 "",
+		 bytes_total );
+	}
+	fprintf(
+	 process_status->telemetry_stream,
+	 ",\"stages\":{" );
+
+	for( stage = 0;
+	     stage < PROCESS_STATUS_NUMBER_OF_STAGES;
+	     stage++ )
+	{
+		fprintf(
+		 process_status->telemetry_stream,
+		 "%s\"%s\":{\"bytes\":%" PRIu64 ",\"micro_seconds\":%" PRIu64 "}",
+		 ( stage == 0 ) ? "" : ",",
+		 stage_names[ stage ],
+		 stage_number_of_bytes[ stage ],
+		 stage_number_of_micro_seconds[ stage ] );
+	}
+	fprintf(
+	 process_status->telemetry_stream,
+	 "},\"threads\":%d",
+	 process_status->number_of_threads );
+
+	/* The worker utilization is the time spent in the process stage
+	 * relative to the time available to the processing threads
+	 */
+	if( ( process_status->number_of_threads > 0 )
+	 && ( elapsed_micro_seconds > 0 ) )
+	{
+		ratio = ( stage_number_of_micro_seconds[ PROCESS_STATUS_STAGE_PROCESS ] * 1000 )
+		      / ( elapsed_micro_seconds * (uint64_t) process_status->number_of_threads );
+
+		fprintf(
+		 process_status->telemetry_stream,
+		 ",\"worker_utilization_per_mille\":%" PRIu64 "",
+		 ratio );
+	}
+	if( maximum_number_of_buffers > 0 )
+	{
+		fprintf(
+		 process_status->telemetry_stream,
+		 ",\"buffers_in_use\":%d,\"maximum_buffers\":%d,\"reordered_buffers\":%d",
+		 number_of_buffers_in_use,
+		 maximum_number_of_buffers,
+		 number_of_reordered_buffers );
+	}
+	if( number_of_compressed_bytes > 0 )
+	{
+		ratio = ( number_of_uncompressed_bytes * 1000 ) / number_of_compressed_bytes;
+
+		fprintf(
+		 process_status->telemetry_stream,
+		 ",\"compression_ratio_per_mille\":%" PRIu64 "",
+		 ratio );
+	}
+	fprintf(
+	 process_status->telemetry_stream,
+	 ",\"read_errors\":%" PRIu32 "}\n",
+	 number_of_read_errors );
+
+	fflush(
+	 process_status->telemetry_stream );
+
+	return( 1 );
+}
+
 /* Prints a time stamp (with a leading space) to a stream
  */
 void process_status_timestamp_fprint(
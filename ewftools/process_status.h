@@ -27,6 +27,7 @@
 
 #include "ewftools_libcdatetime.h"
 #include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -39,6 +40,25 @@ enum PROCESS_STATUS
 	PROCESS_STATUS_FAILED		= (int) 'f'
 };
 
+/* The minimum number of seconds between telemetry records
+ */
+#define PROCESS_STATUS_TELEMETRY_INTERVAL	1
+
+enum PROCESS_STATUS_STAGES
+{
+	PROCESS_STATUS_STAGE_READ		= 0,
+	PROCESS_STATUS_STAGE_PROCESS		= 1,
+	PROCESS_STATUS_STAGE_HASH		= 2,
+	PROCESS_STATUS_STAGE_WRITE		= 3
+};
+
+#define PROCESS_STATUS_NUMBER_OF_STAGES		4
+
+/* The minimum number of micro seconds spent processing between determining
+ * the number of jobs
+ */
+#define PROCESS_STATUS_NUMBER_OF_JOBS_INTERVAL	1000000
+
 typedef struct process_status process_status_t;
 
 struct process_status
@@ -86,6 +106,72 @@ struct process_status
 	/* The last parts per million
 	 */
 	int64_t last_parts_per_million;
+
+	/* The telemetry stream
+	 */
+	FILE *telemetry_stream;
+
+	/* The number of processing threads
+	 */
+	int number_of_threads;
+
+	/* The telemetry start timestamp in micro seconds
+	 */
+	uint64_t telemetry_start_timestamp;
+
+	/* The last telemetry timestamp in micro seconds
+	 */
+	uint64_t telemetry_last_timestamp;
+
+	/* The number of bytes per stage
+	 */
+	uint64_t stage_number_of_bytes[ PROCESS_STATUS_NUMBER_OF_STAGES ];
+
+	/* The number of micro seconds per stage
+	 */
+	uint64_t stage_number_of_micro_seconds[ PROCESS_STATUS_NUMBER_OF_STAGES ];
+
+	/* Value to indicate if the stage values should be collected without telemetry
+	 */
+	uint8_t collect_stage_values;
+
+	/* The number of bytes per stage when the number of jobs was last determined
+	 */
+	uint64_t jobs_stage_number_of_bytes[ PROCESS_STATUS_NUMBER_OF_STAGES ];
+
+	/* The number of micro seconds per stage when the number of jobs was last determined
+	 */
+	uint64_t jobs_stage_number_of_micro_seconds[ PROCESS_STATUS_NUMBER_OF_STAGES ];
+
+	/* The number of uncompressed bytes of the written chunks
+	 */
+	uint64_t number_of_uncompressed_bytes;
+
+	/* The number of compressed (packed) bytes of the written chunks
+	 */
+	uint64_t number_of_compressed_bytes;
+
+	/* The number of read errors
+	 */
+	uint32_t number_of_read_errors;
+
+	/* The number of storage media buffers in use
+	 */
+	int number_of_buffers_in_use;
+
+	/* The maximum number of storage media buffers
+	 */
+	int maximum_number_of_buffers;
+
+	/* The number of storage media buffers waiting to be output in order
+	 */
+	int number_of_reordered_buffers;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The telemetry mutex
+	 */
+	libcthreads_mutex_t *telemetry_mutex;
+#endif
 };
 
 int process_status_initialize(
@@ -122,6 +208,70 @@ int process_status_stop(
      int status,
      libcerror_error_t **error );
 
+int process_status_set_telemetry(
+     process_status_t *process_status,
+     FILE *telemetry_stream,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int process_status_set_collect_stage_values(
+     process_status_t *process_status,
+     uint8_t collect_stage_values,
+     libcerror_error_t **error );
+
+int process_status_get_timestamp(
+     uint64_t *timestamp,
+     libcerror_error_t **error );
+
+int process_status_get_stage_timestamp(
+     process_status_t *process_status,
+     uint64_t *timestamp,
+     libcerror_error_t **error );
+
+int process_status_add_stage_value(
+     process_status_t *process_status,
+     int stage,
+     size64_t number_of_bytes,
+     uint64_t start_timestamp,
+     libcerror_error_t **error );
+
+int process_status_get_number_of_jobs(
+     process_status_t *process_status,
+     int maximum_number_of_jobs,
+     int *number_of_jobs,
+     libcerror_error_t **error );
+
+int process_status_add_compression_values(
+     process_status_t *process_status,
+     size64_t number_of_uncompressed_bytes,
+     size64_t number_of_compressed_bytes,
+     libcerror_error_t **error );
+
+int process_status_add_read_errors(
+     process_status_t *process_status,
+     uint32_t number_of_read_errors,
+     libcerror_error_t **error );
+
+int process_status_set_buffer_values(
+     process_status_t *process_status,
+     int number_of_buffers_in_use,
+     int maximum_number_of_buffers,
+     int number_of_reordered_buffers,
+     libcerror_error_t **error );
+
+int process_status_telemetry_update(
+     process_status_t *process_status,
+     size64_t bytes_read,
+     size64_t bytes_total,
+     libcerror_error_t **error );
+
+int process_status_telemetry_fprint(
+     process_status_t *process_status,
+     size64_t bytes_read,
+     size64_t bytes_total,
+     const char *status_string,
+     libcerror_error_t **error );
+
 void process_status_timestamp_fprint(
       FILE *stream,
       int64_t number_of_seconds );
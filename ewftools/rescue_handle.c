@@ -0,0 +1,2925 @@
+/*
+ * Rescue handle, multi-pass acquiry of failing media
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_STDIO_H )
+#include <stdio.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "ewftools_libcerror.h"
+#include "process_status.h"
+#include "rescue_handle.h"
+#include "storage_media_buffer.h"
+
+#define RESCUE_HANDLE_NOTIFY_STREAM		stdout
+
+#if defined( HAVE_RESCUE_HANDLE )
+
+/* Creates a rescue handle
+ * Make sure the value rescue_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_handle_initialize(
+     rescue_handle_t **rescue_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_handle_initialize";
+
+	if( rescue_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *rescue_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid rescue handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*rescue_handle = memory_allocate_structure(
+	                  rescue_handle_t );
+
+	if( *rescue_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create rescue handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *rescue_handle,
+	     0,
+	     sizeof( rescue_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear rescue handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *rescue_handle )->source_descriptor = -1;
+	( *rescue_handle )->image_descriptor  = -1;
+	( *rescue_handle )->current_status    = RESCUE_RANGE_STATUS_NON_TRIED;
+	( *rescue_handle )->notify_stream     = RESCUE_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *rescue_handle != NULL )
+	{
+		memory_free(
+		 *rescue_handle );
+
+		*rescue_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a rescue handle
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_handle_free(
+     rescue_handle_t **rescue_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_handle_free";
+	int result            = 1;
+
+	if( rescue_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *rescue_handle != NULL )
+	{
+		if( rescue_handle_close(
+		     *rescue_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close rescue handle.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *rescue_handle )->map_filename != NULL )
+		{
+			memory_free(
+			 ( *rescue_handle )->map_filename );
+		}
+		if( ( *rescue_handle )->ranges != NULL )
+		{
+			memory_free(
+			 ( *rescue_handle )->ranges );
+		}
+		if( ( *rescue_handle )->buffer != NULL )
+		{
+			memory_free(
+			 ( *rescue_handle )->buffer );
+		}
+		memory_free(
+		 *rescue_handle );
+
+		*rescue_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the rescue handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_handle_signal_abort(
+     rescue_handle_t *rescue_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_handle_signal_abort";
+
+	if( rescue_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue handle.",
+		 function );
+
+		return( -1 );
+	}
+	rescue_handle->abort = 1;
+
+	return( 1 );
+}
+
+/* Opens the source and the rescue image
+ * The map is stored next to the rescue image with the extension .map
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_handle_open(
+     rescue_handle_t *rescue_handle,
+     const system_character_t *source_filename,
+     const system_character_t *image_filename,
+     libcerror_error_t **error )
+{
+	static char *function       = "rescue_handle_open";
+	size_t image_filename_length = 0;
+
+	if( rescue_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( rescue_handle->source_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid rescue handle - source already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( rescue_handle->map_filename != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid rescue handle - map filename value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( image_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid image filename.",
+		 function );
+
+		return( -1 );
+	}
+	image_filename_length = system_string_length(
+	                         image_filename );
+
+	rescue_handle->map_filename_size = image_filename_length + 5;
+
+	rescue_handle->map_filename = system_string_allocate(
+	                               rescue_handle->map_filename_size );
+
+	if( rescue_handle->map_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create map filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     rescue_handle->map_filename,
+	     image_filename,
+	     image_filename_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy map filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     &( rescue_handle->map_filename[ image_filename_length ] ),
+	     _SYSTEM_STRING( ".map" ),
+	     4 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy map filename extension.",
+		 function );
+
+		goto on_error;
+	}
+	rescue_handle->map_filename[ image_filename_length + 4 ] = 0;
+
+	rescue_handle->source_descriptor = open(
+	                                    source_filename,
+	                                    O_RDONLY );
+
+	if( rescue_handle->source_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open source: %" PRIs_SYSTEM ".",
+		 function,
+		 source_filename );
+
+		goto on_error;
+	}
+	rescue_handle->image_descriptor = open(
+	                                   image_filename,
+	                                   O_RDWR | O_CREAT,
+	                                   0644 );
+
+	if( rescue_handle->image_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open rescue image: %" PRIs_SYSTEM ".",
+		 function,
+		 image_filename );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( rescue_handle->source_descriptor != -1 )
+	{
+		close(
+		 rescue_handle->source_descriptor );
+
+		rescue_handle->source_descriptor = -1;
+	}
+	if( rescue_handle->map_filename != NULL )
+	{
+		memory_free(
+		 rescue_handle->map_filename );
+
+		rescue_handle->map_filename = NULL;
+	}
+	rescue_handle->map_filename_size = 0;
+
+	return( -1 );
+}
+
+/* Closes the source and the rescue image
+ * Returns the 0 if succesful or -1 on error
+ */
+int rescue_handle_close(
+     rescue_handle_t *rescue_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_handle_close";
+	int result            = 0;
+
+	if( rescue_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( rescue_handle->source_descriptor != -1 )
+	{
+		if( close(
+		     rescue_handle->source_descriptor ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 errno,
+			 "%s: unable to close source.",
+			 function );
+
+			result = -1;
+		}
+		rescue_handle->source_descriptor = -1;
+	}
+	if( rescue_handle->image_descriptor != -1 )
+	{
+		if( close(
+		     rescue_handle->image_descriptor ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 errno,
+			 "%s: unable to close rescue image.",
+			 function );
+
+			result = -1;
+		}
+		rescue_handle->image_descriptor = -1;
+	}
+	return( result );
+}
+
+/* Sets the region to rescue and the read sizes
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_handle_set_region(
+     rescue_handle_t *rescue_handle,
+     off64_t region_offset,
+     size64_t region_size,
+     size_t block_size,
+     size_t error_granularity,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_handle_set_region";
+
+	if( rescue_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( rescue_handle->buffer != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid rescue handle - buffer value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( region_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid region offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( region_size == 0 )
+	 || ( region_size > (size64_t) ( INT64_MAX - region_offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid region size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_size == 0 )
+	 || ( block_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( error_granularity == 0 )
+	 || ( error_granularity > block_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid error granularity value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( memory_allocate_aligned )
+	if( memory_allocate_aligned(
+	     (void **) &( rescue_handle->buffer ),
+	     block_size,
+	     4096 ) != 0 )
+	{
+		rescue_handle->buffer = NULL;
+	}
+#else
+	rescue_handle->buffer = (uint8_t *) memory_allocate(
+	                                     sizeof( uint8_t ) * block_size );
+#endif
+	if( rescue_handle->buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		return( -1 );
+	}
+	rescue_handle->buffer_size       = block_size;
+	rescue_handle->region_offset     = region_offset;
+	rescue_handle->region_size       = region_size;
+	rescue_handle->block_size        = block_size;
+	rescue_handle->error_granularity = error_granularity;
+
+	return( 1 );
+}
+
+/* Parses a hexadecimal map value, formatted as 0x####, from a string
+ * Leading whitespace is ignored
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_handle_parse_map_value(
+     const char *string,
+     size_t string_size,
+     size_t *string_index,
+     uint64_t *value,
+     libcerror_error_t **error )
+{
+	static char *function      = "rescue_handle_parse_map_value";
+	size_t number_of_digits    = 0;
+	size_t safe_string_index   = 0;
+	uint64_t safe_value        = 0;
+	uint8_t character_value    = 0;
+	char character             = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string index.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	safe_string_index = *string_index;
+
+	while( ( safe_string_index < string_size )
+	    && ( ( string[ safe_string_index ] == ' ' )
+	     ||  ( string[ safe_string_index ] == '\t' ) ) )
+	{
+		safe_string_index++;
+	}
+	if( ( ( safe_string_index + 2 ) >= string_size )
+	 || ( string[ safe_string_index ] != '0' )
+	 || ( ( string[ safe_string_index + 1 ] != 'x' )
+	  &&  ( string[ safe_string_index + 1 ] != 'X' ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported value - missing hexadecimal prefix.",
+		 function );
+
+		return( -1 );
+	}
+	safe_string_index += 2;
+
+	while( safe_string_index < string_size )
+	{
+		character = string[ safe_string_index ];
+
+		if( ( character >= '0' )
+		 && ( character <= '9' ) )
+		{
+			character_value = (uint8_t) ( character - '0' );
+		}
+		else if( ( character >= 'A' )
+		      && ( character <= 'F' ) )
+		{
+			character_value = (uint8_t) ( character - 'A' + 10 );
+		}
+		else if( ( character >= 'a' )
+		      && ( character <= 'f' ) )
+		{
+			character_value = (uint8_t) ( character - 'a' + 10 );
+		}
+		else
+		{
+			break;
+		}
+		if( number_of_digits >= 16 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: unsupported value - too many digits.",
+			 function );
+
+			return( -1 );
+		}
+		safe_value <<= 4;
+		safe_value  |= character_value;
+
+		number_of_digits++;
+		safe_string_index++;
+	}
+	if( number_of_digits == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported value - missing digits.",
+		 function );
+
+		return( -1 );
+	}
+	*string_index = safe_string_index;
+	*value        = safe_value;
+
+	return( 1 );
+}
+
+/* Reads the map
+ * If no map exists the entire region is marked as non-tried
+ * Returns 1 if successful, 0 if no map exists or -1 on error
+ */
+int rescue_handle_read_map(
+     rescue_handle_t *rescue_handle,
+     libcerror_error_t **error )
+{
+	char line[ 128 ];
+
+	FILE *stream          = NULL;
+	static char *function = "rescue_handle_read_map";
+	size_t line_index     = 0;
+	size_t line_length    = 0;
+	uint64_t range_offset = 0;
+	uint64_t range_size   = 0;
+	uint64_t value_64bit  = 0;
+	off64_t next_offset   = 0;
+	uint8_t status        = 0;
+	int has_current_value = 0;
+	int line_number       = 0;
+
+	if( rescue_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( rescue_handle->map_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid rescue handle - missing map filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( rescue_handle->region_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid rescue handle - missing region.",
+		 function );
+
+		return( -1 );
+	}
+	if( rescue_handle->number_of_ranges != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid rescue handle - ranges already set.",
+		 function );
+
+		return( -1 );
+	}
+	stream = file_stream_open(
+	          rescue_handle->map_filename,
+	          FILE_STREAM_OPEN_READ );
+
+	if( stream == NULL )
+	{
+		if( errno != ENOENT )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 errno,
+			 "%s: unable to open map: %" PRIs_SYSTEM ".",
+			 function,
+			 rescue_handle->map_filename );
+
+			return( -1 );
+		}
+		if( rescue_handle_insert_range(
+		     rescue_handle,
+		     0,
+		     rescue_handle->region_offset,
+		     rescue_handle->region_size,
+		     RESCUE_RANGE_STATUS_NON_TRIED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert region range.",
+			 function );
+
+			return( -1 );
+		}
+		rescue_handle->current_status = RESCUE_RANGE_STATUS_NON_TRIED;
+
+		return( 0 );
+	}
+	next_offset = rescue_handle->region_offset;
+
+	while( file_stream_get_string(
+	        stream,
+	        line,
+	        128 ) != NULL )
+	{
+		line_number++;
+
+		line_length = narrow_string_length(
+		               line );
+
+		while( ( line_length > 0 )
+		    && ( ( line[ line_length - 1 ] == '\n' )
+		     ||  ( line[ line_length - 1 ] == '\r' ) ) )
+		{
+			line_length--;
+		}
+		if( ( line_length == 0 )
+		 || ( line[ 0 ] == '#' ) )
+		{
+			continue;
+		}
+		line_index = 0;
+
+		if( rescue_handle_parse_map_value(
+		     line,
+		     line_length,
+		     &line_index,
+		     &range_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to parse offset in map line: %d.",
+			 function,
+			 line_number );
+
+			goto on_error;
+		}
+		/* The first line contains the current position and status
+		 */
+		if( has_current_value != 0 )
+		{
+			if( rescue_handle_parse_map_value(
+			     line,
+			     line_length,
+			     &line_index,
+			     &range_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to parse size in map line: %d.",
+				 function,
+				 line_number );
+
+				goto on_error;
+			}
+		}
+		while( ( line_index < line_length )
+		    && ( ( line[ line_index ] == ' ' )
+		     ||  ( line[ line_index ] == '\t' ) ) )
+		{
+			line_index++;
+		}
+		if( line_index >= line_length )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing status in map line: %d.",
+			 function,
+			 line_number );
+
+			goto on_error;
+		}
+		status = (uint8_t) line[ line_index ];
+
+		if( ( status != RESCUE_RANGE_STATUS_NON_TRIED )
+		 && ( status != RESCUE_RANGE_STATUS_NON_TRIMMED )
+		 && ( status != RESCUE_RANGE_STATUS_BAD_SECTOR )
+		 && ( status != RESCUE_RANGE_STATUS_FINISHED ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported status: %c in map line: %d.",
+			 function,
+			 (char) status,
+			 line_number );
+
+			goto on_error;
+		}
+		if( has_current_value == 0 )
+		{
+			rescue_handle->current_status = status;
+
+			has_current_value = 1;
+
+			continue;
+		}
+		value_64bit = (uint64_t) next_offset - rescue_handle->region_offset;
+
+		if( ( range_offset != (uint64_t) next_offset )
+		 || ( range_size == 0 )
+		 || ( range_size > ( rescue_handle->region_size - value_64bit ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: range in map line: %d does not match region.",
+			 function,
+			 line_number );
+
+			goto on_error;
+		}
+		if( rescue_handle_insert_range(
+		     rescue_handle,
+		     rescue_handle->number_of_ranges,
+		     (off64_t) range_offset,
+		     (size64_t) range_size,
+		     status,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert range of map line: %d.",
+			 function,
+			 line_number );
+
+			goto on_error;
+		}
+		next_offset += (off64_t) range_size;
+	}
+	if( next_offset != (off64_t) ( rescue_handle->region_offset + rescue_handle->region_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: map: %" PRIs_SYSTEM " does not match region.",
+		 function,
+		 rescue_handle->map_filename );
+
+		goto on_error;
+	}
+	if( file_stream_close(
+	     stream ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close map.",
+		 function );
+
+		stream = NULL;
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( stream != NULL )
+	{
+		file_stream_close(
+		 stream );
+	}
+	if( rescue_handle->ranges != NULL )
+	{
+		memory_free(
+		 rescue_handle->ranges );
+
+		rescue_handle->ranges = NULL;
+	}
+	rescue_handle->number_of_ranges         = 0;
+	rescue_handle->maximum_number_of_ranges = 0;
+
+	return( -1 );
+}
+
+/* Writes the map
+ * The map is written to a temporary file that replaces the previous map
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_handle_write_map(
+     rescue_handle_t *rescue_handle,
+     libcerror_error_t **error )
+{
+	FILE *stream                           = NULL;
+	rescue_range_t *range                  = NULL;
+	system_character_t *temporary_filename = NULL;
+	static char *function                  = "rescue_handle_write_map";
+	int range_index                        = 0;
+
+#if defined( HAVE_FDATASYNC ) || defined( HAVE_FSYNC )
+	int result                             = 0;
+#endif
+
+	if( rescue_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( rescue_handle->map_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid rescue handle - missing map filename.",
+		 function );
+
+		return( -1 );
+	}
+	temporary_filename = system_string_allocate(
+	                      rescue_handle->map_filename_size + 4 );
+
+	if( temporary_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create temporary filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     temporary_filename,
+	     rescue_handle->map_filename,
+	     rescue_handle->map_filename_size - 1 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy temporary filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     &( temporary_filename[ rescue_handle->map_filename_size - 1 ] ),
+	     _SYSTEM_STRING( ".tmp" ),
+	     4 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy temporary filename extension.",
+		 function );
+
+		goto on_error;
+	}
+	temporary_filename[ rescue_handle->map_filename_size + 3 ] = 0;
+
+#if defined( HAVE_FDATASYNC ) || defined( HAVE_FSYNC )
+	/* Make sure the rescued data is stored before the map marks it as rescued
+	 */
+	if( rescue_handle->image_descriptor != -1 )
+	{
+#if defined( HAVE_FDATASYNC )
+		result = fdatasync(
+		          rescue_handle->image_descriptor );
+#else
+		result = fsync(
+		          rescue_handle->image_descriptor );
+#endif
+		if( result != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to synchronize image.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	stream = file_stream_open(
+	          temporary_filename,
+	          FILE_STREAM_OPEN_WRITE );
+
+	if( stream == NULL )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open map: %" PRIs_SYSTEM ".",
+		 function,
+		 temporary_filename );
+
+		goto on_error;
+	}
+	fprintf(
+	 stream,
+	 "# Rescue map created by ewfacquire\n"
+	 "# current_pos  current_status\n"
+	 "0x%08" PRIx64 "     %c\n"
+	 "#      pos        size  status\n",
+	 rescue_handle->region_offset,
+	 (char) rescue_handle->current_status );
+
+	for( range_index = 0;
+	     range_index < rescue_handle->number_of_ranges;
+	     range_index++ )
+	{
+		range = &( rescue_handle->ranges[ range_index ] );
+
+		fprintf(
+		 stream,
+		 "0x%08" PRIx64 "  0x%08" PRIx64 "  %c\n",
+		 range->offset,
+		 range->size,
+		 (char) range->status );
+	}
+	/* Make sure the map is stored before it replaces the previous one
+	 */
+	if( fflush(
+	     stream ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 errno,
+		 "%s: unable to flush map.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_FSYNC )
+	if( fsync(
+	     fileno( stream ) ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 errno,
+		 "%s: unable to synchronize map.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( file_stream_close(
+	     stream ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close map.",
+		 function );
+
+		stream = NULL;
+
+		goto on_error;
+	}
+	stream = NULL;
+
+	if( rename(
+	     temporary_filename,
+	     rescue_handle->map_filename ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 errno,
+		 "%s: unable to replace map: %" PRIs_SYSTEM ".",
+		 function,
+		 rescue_handle->map_filename );
+
+		goto on_error;
+	}
+	memory_free(
+	 temporary_filename );
+
+	rescue_handle->number_of_map_changes = 0;
+
+	return( 1 );
+
+on_error:
+	if( stream != NULL )
+	{
+		file_stream_close(
+		 stream );
+	}
+	if( temporary_filename != NULL )
+	{
+		memory_free(
+		 temporary_filename );
+	}
+	return( -1 );
+}
+
+/* Retrieves the index of the range that contains the offset
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_handle_get_range_index(
+     rescue_handle_t *rescue_handle,
+     off64_t offset,
+     int *range_index,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_handle_get_range_index";
+	int first_index       = 0;
+	int last_index        = 0;
+	int middle_index      = 0;
+
+	if( rescue_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < rescue_handle->region_offset )
+	 || ( (size64_t) ( offset - rescue_handle->region_offset ) >= rescue_handle->region_size )
+	 || ( rescue_handle->number_of_ranges == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range index.",
+		 function );
+
+		return( -1 );
+	}
+	last_index = rescue_handle->number_of_ranges - 1;
+
+	while( first_index < last_index )
+	{
+		middle_index = first_index + ( ( last_index - first_index + 1 ) / 2 );
+
+		if( rescue_handle->ranges[ middle_index ].offset <= offset )
+		{
+			first_index = middle_index;
+		}
+		else
+		{
+			last_index = middle_index - 1;
+		}
+	}
+	*range_index = first_index;
+
+	return( 1 );
+}
+
+/* Inserts a range before the range at the index
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_handle_insert_range(
+     rescue_handle_t *rescue_handle,
+     int range_index,
+     off64_t offset,
+     size64_t size,
+     uint8_t status,
+     libcerror_error_t **error )
+{
+	rescue_range_t *ranges            = NULL;
+	static char *function             = "rescue_handle_insert_range";
+	size_t ranges_size                = 0;
+	int maximum_number_of_ranges      = 0;
+	int safe_range_index              = 0;
+
+	if( rescue_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( range_index < 0 )
+	 || ( range_index > rescue_handle->number_of_ranges ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( rescue_handle->number_of_ranges >= rescue_handle->maximum_number_of_ranges )
+	{
+		if( rescue_handle->maximum_number_of_ranges > ( INT_MAX - 256 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid maximum number of ranges value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		maximum_number_of_ranges = rescue_handle->maximum_number_of_ranges + 256;
+
+		ranges_size = sizeof( rescue_range_t ) * maximum_number_of_ranges;
+
+		ranges = (rescue_range_t *) memory_reallocate(
+		                             rescue_handle->ranges,
+		                             ranges_size );
+
+		if( ranges == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize ranges.",
+			 function );
+
+			return( -1 );
+		}
+		rescue_handle->ranges                   = ranges;
+		rescue_handle->maximum_number_of_ranges = maximum_number_of_ranges;
+	}
+	for( safe_range_index = rescue_handle->number_of_ranges;
+	     safe_range_index > range_index;
+	     safe_range_index-- )
+	{
+		rescue_handle->ranges[ safe_range_index ] = rescue_handle->ranges[ safe_range_index - 1 ];
+	}
+	rescue_handle->ranges[ range_index ].offset = offset;
+	rescue_handle->ranges[ range_index ].size   = size;
+	rescue_handle->ranges[ range_index ].status = status;
+
+	rescue_handle->number_of_ranges += 1;
+
+	return( 1 );
+}
+
+/* Removes a number of ranges starting at the index
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_handle_remove_ranges(
+     rescue_handle_t *rescue_handle,
+     int range_index,
+     int number_of_ranges,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_handle_remove_ranges";
+	int safe_range_index  = 0;
+
+	if( rescue_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( range_index < 0 )
+	 || ( number_of_ranges < 0 )
+	 || ( number_of_ranges > ( rescue_handle->number_of_ranges - range_index ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( safe_range_index = range_index;
+	     safe_range_index < ( rescue_handle->number_of_ranges - number_of_ranges );
+	     safe_range_index++ )
+	{
+		rescue_handle->ranges[ safe_range_index ] = rescue_handle->ranges[ safe_range_index + number_of_ranges ];
+	}
+	rescue_handle->number_of_ranges -= number_of_ranges;
+
+	return( 1 );
+}
+
+/* Splits the range that contains the offset so that a range starts at the offset
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_handle_split_range(
+     rescue_handle_t *rescue_handle,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	rescue_range_t *range = NULL;
+	static char *function = "rescue_handle_split_range";
+	off64_t range_end     = 0;
+	int range_index       = 0;
+
+	if( rescue_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == (off64_t) ( rescue_handle->region_offset + rescue_handle->region_size ) )
+	{
+		return( 1 );
+	}
+	if( rescue_handle_get_range_index(
+	     rescue_handle,
+	     offset,
+	     &range_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve range index of offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	range = &( rescue_handle->ranges[ range_index ] );
+
+	if( range->offset == offset )
+	{
+		return( 1 );
+	}
+	range_end   = range->offset + (off64_t) range->size;
+	range->size = (size64_t) ( offset - range->offset );
+
+	if( rescue_handle_insert_range(
+	     rescue_handle,
+	     range_index + 1,
+	     offset,
+	     (size64_t) ( range_end - offset ),
+	     range->status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert range.",
+		 function );
+
+		/* The insert can reallocate the ranges
+		 */
+		rescue_handle->ranges[ range_index ].size = (size64_t) ( range_end - rescue_handle->ranges[ range_index ].offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the status of a range of the region
+ * Adjacent ranges with the same status are merged
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_handle_set_range_status(
+     rescue_handle_t *rescue_handle,
+     off64_t offset,
+     size64_t size,
+     uint8_t status,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_handle_set_range_status";
+	off64_t range_end     = 0;
+	int first_index       = 0;
+	int last_index        = 0;
+
+	if( rescue_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < rescue_handle->region_offset )
+	 || ( size == 0 )
+	 || ( (size64_t) ( offset - rescue_handle->region_offset ) > rescue_handle->region_size )
+	 || ( size > ( rescue_handle->region_size - (size64_t) ( offset - rescue_handle->region_offset ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	range_end = offset + (off64_t) size;
+
+	if( ( rescue_handle_split_range(
+	       rescue_handle,
+	       offset,
+	       error ) != 1 )
+	 || ( rescue_handle_split_range(
+	       rescue_handle,
+	       range_end,
+	       error ) != 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to split ranges.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( rescue_handle_get_range_index(
+	       rescue_handle,
+	       offset,
+	       &first_index,
+	       error ) != 1 )
+	 || ( rescue_handle_get_range_index(
+	       rescue_handle,
+	       range_end - 1,
+	       &last_index,
+	       error ) != 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve range indexes.",
+		 function );
+
+		return( -1 );
+	}
+	rescue_handle->ranges[ first_index ].size   = size;
+	rescue_handle->ranges[ first_index ].status = status;
+
+	if( rescue_handle_remove_ranges(
+	     rescue_handle,
+	     first_index + 1,
+	     last_index - first_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to remove ranges.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( first_index + 1 ) < rescue_handle->number_of_ranges )
+	 && ( rescue_handle->ranges[ first_index + 1 ].status == status ) )
+	{
+		rescue_handle->ranges[ first_index ].size += rescue_handle->ranges[ first_index + 1 ].size;
+
+		if( rescue_handle_remove_ranges(
+		     rescue_handle,
+		     first_index + 1,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove next range.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( first_index > 0 )
+	 && ( rescue_handle->ranges[ first_index - 1 ].status == status ) )
+	{
+		rescue_handle->ranges[ first_index - 1 ].size += rescue_handle->ranges[ first_index ].size;
+
+		if( rescue_handle_remove_ranges(
+		     rescue_handle,
+		     first_index,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove range.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	rescue_handle->number_of_map_changes += 1;
+
+	return( 1 );
+}
+
+/* Retrieves the next range with a specific status at or after the offset
+ * Returns 1 if successful, 0 if no such range or -1 on error
+ */
+int rescue_handle_get_next_range(
+     rescue_handle_t *rescue_handle,
+     uint8_t status,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	rescue_range_t *range = NULL;
+	static char *function = "rescue_handle_get_next_range";
+	int range_index       = 0;
+
+	if( rescue_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < rescue_handle->region_offset )
+	{
+		offset = rescue_handle->region_offset;
+	}
+	if( (size64_t) ( offset - rescue_handle->region_offset ) >= rescue_handle->region_size )
+	{
+		return( 0 );
+	}
+	if( rescue_handle_get_range_index(
+	     rescue_handle,
+	     offset,
+	     &range_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve range index of offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	while( range_index < rescue_handle->number_of_ranges )
+	{
+		range = &( rescue_handle->ranges[ range_index ] );
+
+		if( range->status == status )
+		{
+			if( offset < range->offset )
+			{
+				offset = range->offset;
+			}
+			*range_offset = offset;
+			*range_size   = range->size - (size64_t) ( offset - range->offset );
+
+			return( 1 );
+		}
+		range_index++;
+	}
+	return( 0 );
+}
+
+/* Rescues a block, the data is read from the source and written to the rescue image
+ * The block is marked as finished if successful or with the failure status otherwise
+ * Returns 1 if the block was rescued, 0 if not or -1 on error
+ */
+int rescue_handle_rescue_block(
+     rescue_handle_t *rescue_handle,
+     off64_t offset,
+     size_t size,
+     uint8_t failure_status,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_handle_rescue_block";
+	size_t buffer_index   = 0;
+	ssize_t read_count    = 0;
+	ssize_t write_count   = 0;
+	uint8_t status        = RESCUE_RANGE_STATUS_FINISHED;
+	int result            = 1;
+
+	if( rescue_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > rescue_handle->buffer_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_index < size )
+	{
+		read_count = pread(
+		              rescue_handle->source_descriptor,
+		              &( rescue_handle->buffer[ buffer_index ] ),
+		              size - buffer_index,
+		              (off_t) ( offset + (off64_t) buffer_index ) );
+
+		if( read_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			break;
+		}
+		if( read_count == 0 )
+		{
+			break;
+		}
+		buffer_index += (size_t) read_count;
+	}
+	if( buffer_index < size )
+	{
+		status = failure_status;
+		result = 0;
+	}
+	else
+	{
+		buffer_index = 0;
+
+		while( buffer_index < size )
+		{
+			write_count = pwrite(
+			               rescue_handle->image_descriptor,
+			               &( rescue_handle->buffer[ buffer_index ] ),
+			               size - buffer_index,
+			               (off_t) ( offset + (off64_t) buffer_index ) );
+
+			if( write_count < 0 )
+			{
+				if( errno == EINTR )
+				{
+					continue;
+				}
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 errno,
+				 "%s: unable to write rescue image at offset: %" PRIi64 ".",
+				 function,
+				 offset + (off64_t) buffer_index );
+
+				return( -1 );
+			}
+			buffer_index += (size_t) write_count;
+		}
+	}
+	if( rescue_handle_set_range_status(
+	     rescue_handle,
+	     offset,
+	     (size64_t) size,
+	     status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set status of range at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	if( rescue_handle->number_of_map_changes >= RESCUE_HANDLE_MAP_WRITE_INTERVAL )
+	{
+		if( rescue_handle_write_map(
+		     rescue_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write map.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Copies the non-tried ranges in a single forward pass without retries
+ * After a read error the following area is skipped, the skip size doubles with
+ * every consecutive read error, so that the healthy areas are copied first
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_handle_copy(
+     rescue_handle_t *rescue_handle,
+     process_status_t *process_status,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_handle_copy";
+	size64_t range_size   = 0;
+	size64_t skip_size    = 0;
+	size_t read_size      = 0;
+	off64_t offset        = 0;
+	off64_t range_end     = 0;
+	off64_t range_offset  = 0;
+	int result            = 0;
+
+	if( rescue_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue handle.",
+		 function );
+
+		return( -1 );
+	}
+	offset = rescue_handle->region_offset;
+
+	while( rescue_handle->abort == 0 )
+	{
+		result = rescue_handle_get_next_range(
+		          rescue_handle,
+		          RESCUE_RANGE_STATUS_NON_TRIED,
+		          offset,
+		          &range_offset,
+		          &range_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next non-tried range.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		offset    = range_offset;
+		range_end = range_offset + (off64_t) range_size;
+
+		while( ( offset < range_end )
+		    && ( rescue_handle->abort == 0 ) )
+		{
+			read_size = rescue_handle->block_size;
+
+			if( (size64_t) ( range_end - offset ) < (size64_t) read_size )
+			{
+				read_size = (size_t) ( range_end - offset );
+			}
+			result = rescue_handle_rescue_block(
+			          rescue_handle,
+			          offset,
+			          read_size,
+			          RESCUE_RANGE_STATUS_NON_TRIMMED,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to rescue block at offset: %" PRIi64 ".",
+				 function,
+				 offset );
+
+				return( -1 );
+			}
+			offset += (off64_t) read_size;
+
+			if( result != 0 )
+			{
+				skip_size = 0;
+			}
+			else
+			{
+				if( skip_size == 0 )
+				{
+					skip_size = rescue_handle->block_size;
+				}
+				else if( skip_size < RESCUE_HANDLE_MAXIMUM_SKIP_SIZE )
+				{
+					skip_size *= 2;
+				}
+				if( (size64_t) ( range_end - offset ) < skip_size )
+				{
+					offset = range_end;
+				}
+				else
+				{
+					offset += (off64_t) skip_size;
+				}
+			}
+			if( process_status_update(
+			     process_status,
+			     (size64_t) ( offset - rescue_handle->region_offset ),
+			     rescue_handle->region_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update process status.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Trims the non-tried and non-trimmed ranges left by the copy pass
+ * Blocks that cannot be read are read per error granularity, the parts that
+ * still cannot be read are marked as bad sectors
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_handle_trim(
+     rescue_handle_t *rescue_handle,
+     process_status_t *process_status,
+     libcerror_error_t **error )
+{
+	static char *function        = "rescue_handle_trim";
+	size64_t non_tried_size      = 0;
+	size64_t non_trimmed_size    = 0;
+	size_t read_size             = 0;
+	size_t trim_size             = 0;
+	off64_t block_offset         = 0;
+	off64_t non_tried_offset     = 0;
+	off64_t non_trimmed_offset   = 0;
+	off64_t offset               = 0;
+	off64_t range_end            = 0;
+	uint8_t range_status         = 0;
+	int non_tried_result         = 0;
+	int non_trimmed_result       = 0;
+	int result                   = 0;
+
+	if( rescue_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue handle.",
+		 function );
+
+		return( -1 );
+	}
+	offset = rescue_handle->region_offset;
+
+	while( rescue_handle->abort == 0 )
+	{
+		non_tried_result = rescue_handle_get_next_range(
+		                    rescue_handle,
+		                    RESCUE_RANGE_STATUS_NON_TRIED,
+		                    offset,
+		                    &non_tried_offset,
+		                    &non_tried_size,
+		                    error );
+
+		non_trimmed_result = rescue_handle_get_next_range(
+		                      rescue_handle,
+		                      RESCUE_RANGE_STATUS_NON_TRIMMED,
+		                      offset,
+		                      &non_trimmed_offset,
+		                      &non_trimmed_size,
+		                      error );
+
+		if( ( non_tried_result == -1 )
+		 || ( non_trimmed_result == -1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next range.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( non_tried_result == 0 )
+		 && ( non_trimmed_result == 0 ) )
+		{
+			break;
+		}
+		if( ( non_trimmed_result == 0 )
+		 || ( ( non_tried_result != 0 )
+		  &&  ( non_tried_offset < non_trimmed_offset ) ) )
+		{
+			offset       = non_tried_offset;
+			range_end    = non_tried_offset + (off64_t) non_tried_size;
+			range_status = RESCUE_RANGE_STATUS_NON_TRIED;
+		}
+		else
+		{
+			offset       = non_trimmed_offset;
+			range_end    = non_trimmed_offset + (off64_t) non_trimmed_size;
+			range_status = RESCUE_RANGE_STATUS_NON_TRIMMED;
+		}
+		while( ( offset < range_end )
+		    && ( rescue_handle->abort == 0 ) )
+		{
+			read_size = rescue_handle->block_size;
+
+			if( (size64_t) ( range_end - offset ) < (size64_t) read_size )
+			{
+				read_size = (size_t) ( range_end - offset );
+			}
+			result = 0;
+
+			if( range_status == RESCUE_RANGE_STATUS_NON_TRIED )
+			{
+				result = rescue_handle_rescue_block(
+				          rescue_handle,
+				          offset,
+				          read_size,
+				          RESCUE_RANGE_STATUS_NON_TRIMMED,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to rescue block at offset: %" PRIi64 ".",
+					 function,
+					 offset );
+
+					return( -1 );
+				}
+			}
+			if( result == 0 )
+			{
+				for( block_offset = offset;
+				     block_offset < ( offset + (off64_t) read_size );
+				     block_offset += (off64_t) trim_size )
+				{
+					trim_size = rescue_handle->error_granularity;
+
+					if( (size64_t) ( offset + (off64_t) read_size - block_offset ) < (size64_t) trim_size )
+					{
+						trim_size = (size_t) ( offset + (off64_t) read_size - block_offset );
+					}
+					if( rescue_handle_rescue_block(
+					     rescue_handle,
+					     block_offset,
+					     trim_size,
+					     RESCUE_RANGE_STATUS_BAD_SECTOR,
+					     error ) == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to rescue sectors at offset: %" PRIi64 ".",
+						 function,
+						 block_offset );
+
+						return( -1 );
+					}
+				}
+			}
+			offset += (off64_t) read_size;
+
+			if( process_status_update(
+			     process_status,
+			     (size64_t) ( offset - rescue_handle->region_offset ),
+			     rescue_handle->region_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update process status.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Retries the bad sectors per error granularity, once per retry pass
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_handle_retry(
+     rescue_handle_t *rescue_handle,
+     process_status_t *process_status,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_handle_retry";
+	size64_t range_size   = 0;
+	size_t read_size      = 0;
+	off64_t offset        = 0;
+	off64_t range_end     = 0;
+	off64_t range_offset  = 0;
+	uint8_t retry_pass    = 0;
+	int result            = 0;
+
+	if( rescue_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue handle.",
+		 function );
+
+		return( -1 );
+	}
+	for( retry_pass = 0;
+	     retry_pass < rescue_handle->number_of_retries;
+	     retry_pass++ )
+	{
+		offset = rescue_handle->region_offset;
+
+		while( rescue_handle->abort == 0 )
+		{
+			result = rescue_handle_get_next_range(
+			          rescue_handle,
+			          RESCUE_RANGE_STATUS_BAD_SECTOR,
+			          offset,
+			          &range_offset,
+			          &range_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve next bad sector range.",
+				 function );
+
+				return( -1 );
+			}
+			else if( result == 0 )
+			{
+				break;
+			}
+			offset    = range_offset;
+			range_end = range_offset + (off64_t) range_size;
+
+			while( ( offset < range_end )
+			    && ( rescue_handle->abort == 0 ) )
+			{
+				read_size = rescue_handle->error_granularity;
+
+				if( (size64_t) ( range_end - offset ) < (size64_t) read_size )
+				{
+					read_size = (size_t) ( range_end - offset );
+				}
+				if( rescue_handle_rescue_block(
+				     rescue_handle,
+				     offset,
+				     read_size,
+				     RESCUE_RANGE_STATUS_BAD_SECTOR,
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to rescue sectors at offset: %" PRIi64 ".",
+					 function,
+					 offset );
+
+					return( -1 );
+				}
+				offset += (off64_t) read_size;
+
+				if( process_status_update(
+				     process_status,
+				     (size64_t) ( offset - rescue_handle->region_offset ),
+				     rescue_handle->region_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to update process status.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+		if( rescue_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	return( 1 );
+}
+
+/* Rescues the region in multiple passes: copy, trim and retry
+ * The passes continue from the status stored in the map
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_handle_acquire(
+     rescue_handle_t *rescue_handle,
+     uint8_t print_status_information,
+     libcerror_error_t **error )
+{
+	process_status_t *process_status           = NULL;
+	const system_character_t *status_string    = NULL;
+	static char *function                      = "rescue_handle_acquire";
+	uint8_t next_status                        = 0;
+	int status                                 = PROCESS_STATUS_COMPLETED;
+	int result                                 = 0;
+
+	int (*pass_function)(
+	       rescue_handle_t *rescue_handle,
+	       process_status_t *process_status,
+	       libcerror_error_t **error ) = NULL;
+
+	if( rescue_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( rescue_handle->number_of_ranges == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid rescue handle - missing ranges.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( rescue_handle->current_status != RESCUE_RANGE_STATUS_FINISHED )
+	    && ( rescue_handle->abort == 0 ) )
+	{
+		switch( rescue_handle->current_status )
+		{
+			case RESCUE_RANGE_STATUS_NON_TRIED:
+				status_string = _SYSTEM_STRING( "Rescue copy pass" );
+				pass_function = &rescue_handle_copy;
+				next_status   = RESCUE_RANGE_STATUS_NON_TRIMMED;
+				break;
+
+			case RESCUE_RANGE_STATUS_NON_TRIMMED:
+				status_string = _SYSTEM_STRING( "Rescue trim pass" );
+				pass_function = &rescue_handle_trim;
+				next_status   = RESCUE_RANGE_STATUS_BAD_SECTOR;
+				break;
+
+			case RESCUE_RANGE_STATUS_BAD_SECTOR:
+				status_string = _SYSTEM_STRING( "Rescue retry pass" );
+				pass_function = &rescue_handle_retry;
+				next_status   = RESCUE_RANGE_STATUS_FINISHED;
+				break;
+
+			default:
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported current status: %c.",
+				 function,
+				 (char) rescue_handle->current_status );
+
+				goto on_error;
+		}
+		if( process_status_initialize(
+		     &process_status,
+		     status_string,
+		     _SYSTEM_STRING( "rescued" ),
+		     NULL,
+		     rescue_handle->notify_stream,
+		     print_status_information,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create process status.",
+			 function );
+
+			goto on_error;
+		}
+		if( process_status_start(
+		     process_status,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to start process status.",
+			 function );
+
+			goto on_error;
+		}
+		result = pass_function(
+		          rescue_handle,
+		          process_status,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to run pass.",
+			 function );
+
+			goto on_error;
+		}
+		if( rescue_handle->abort != 0 )
+		{
+			status = PROCESS_STATUS_ABORTED;
+		}
+		if( process_status_stop(
+		     process_status,
+		     rescue_handle->region_size,
+		     status,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to stop process status.",
+			 function );
+
+			goto on_error;
+		}
+		if( process_status_free(
+		     &process_status,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free process status.",
+			 function );
+
+			goto on_error;
+		}
+		if( rescue_handle->abort == 0 )
+		{
+			rescue_handle->current_status = next_status;
+		}
+		if( rescue_handle_write_map(
+		     rescue_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write map.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( process_status != NULL )
+	{
+		process_status_stop(
+		 process_status,
+		 0,
+		 PROCESS_STATUS_FAILED,
+		 NULL );
+		process_status_free(
+		 &process_status,
+		 NULL );
+	}
+	/* Keep the progress made so far
+	 */
+	rescue_handle_write_map(
+	 rescue_handle,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Reads a storage media buffer from the rescue image
+ * The storage media offset is relative to the start of the region
+ * Data of ranges that were not rescued is zeroed
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t rescue_handle_read_storage_media_buffer(
+         rescue_handle_t *rescue_handle,
+         storage_media_buffer_t *storage_media_buffer,
+         off64_t storage_media_offset,
+         size_t read_size,
+         libcerror_error_t **error )
+{
+	rescue_range_t *range = NULL;
+	static char *function = "rescue_handle_read_storage_media_buffer";
+	size_t buffer_index   = 0;
+	size_t zero_size      = 0;
+	ssize_t read_count    = 0;
+	off64_t offset        = 0;
+	off64_t range_end     = 0;
+	off64_t read_end      = 0;
+	int range_index       = 0;
+
+	if( rescue_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( storage_media_offset < 0 )
+	 || ( (size64_t) storage_media_offset >= rescue_handle->region_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid storage media offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_size == 0 )
+	 || ( read_size > storage_media_buffer->raw_buffer_size )
+	 || ( read_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) read_size > ( rescue_handle->region_size - (size64_t) storage_media_offset ) )
+	{
+		read_size = (size_t) ( rescue_handle->region_size - (size64_t) storage_media_offset );
+	}
+	offset = rescue_handle->region_offset + storage_media_offset;
+
+	while( buffer_index < read_size )
+	{
+		read_count = pread(
+		              rescue_handle->image_descriptor,
+		              &( storage_media_buffer->raw_buffer[ buffer_index ] ),
+		              read_size - buffer_index,
+		              (off_t) ( offset + (off64_t) buffer_index ) );
+
+		if( read_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to read rescue image at offset: %" PRIi64 ".",
+			 function,
+			 offset + (off64_t) buffer_index );
+
+			return( -1 );
+		}
+		/* Ranges at the end of the region that were not rescued are not stored
+		 */
+		if( read_count == 0 )
+		{
+			break;
+		}
+		buffer_index += (size_t) read_count;
+	}
+	if( buffer_index < read_size )
+	{
+		if( memory_set(
+		     &( storage_media_buffer->raw_buffer[ buffer_index ] ),
+		     0,
+		     read_size - buffer_index ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* The rescue image can contain data of a previous rescue in ranges that were not rescued
+	 */
+	if( rescue_handle_get_range_index(
+	     rescue_handle,
+	     offset,
+	     &range_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve range index of offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	read_end = offset + (off64_t) read_size;
+
+	while( range_index < rescue_handle->number_of_ranges )
+	{
+		range = &( rescue_handle->ranges[ range_index ] );
+
+		if( range->offset >= read_end )
+		{
+			break;
+		}
+		if( range->status != RESCUE_RANGE_STATUS_FINISHED )
+		{
+			range_end = range->offset + (off64_t) range->size;
+
+			if( range_end > read_end )
+			{
+				range_end = read_end;
+			}
+			buffer_index = 0;
+
+			if( range->offset > offset )
+			{
+				buffer_index = (size_t) ( range->offset - offset );
+			}
+			zero_size = (size_t) ( range_end - offset ) - buffer_index;
+
+			if( memory_set(
+			     &( storage_media_buffer->raw_buffer[ buffer_index ] ),
+			     0,
+			     zero_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		range_index++;
+	}
+	storage_media_buffer->storage_media_offset = storage_media_offset;
+	storage_media_buffer->requested_size       = read_size;
+	storage_media_buffer->raw_buffer_data_size = read_size;
+
+	return( (ssize_t) read_size );
+}
+
+/* Retrieves the number of bad ranges, the ranges that were not rescued
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_handle_get_number_of_bad_ranges(
+     rescue_handle_t *rescue_handle,
+     int *number_of_bad_ranges,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_handle_get_number_of_bad_ranges";
+	int range_index       = 0;
+
+	if( rescue_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_bad_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of bad ranges.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_bad_ranges = 0;
+
+	for( range_index = 0;
+	     range_index < rescue_handle->number_of_ranges;
+	     range_index++ )
+	{
+		if( rescue_handle->ranges[ range_index ].status != RESCUE_RANGE_STATUS_FINISHED )
+		{
+			*number_of_bad_ranges += 1;
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves a bad range
+ * The offset is relative to the start of the region
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_handle_get_bad_range(
+     rescue_handle_t *rescue_handle,
+     int bad_range_index,
+     off64_t *offset,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_handle_get_bad_range";
+	int range_index       = 0;
+
+	if( rescue_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bad_range_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid bad range index value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	for( range_index = 0;
+	     range_index < rescue_handle->number_of_ranges;
+	     range_index++ )
+	{
+		if( rescue_handle->ranges[ range_index ].status == RESCUE_RANGE_STATUS_FINISHED )
+		{
+			continue;
+		}
+		if( bad_range_index == 0 )
+		{
+			*offset = rescue_handle->ranges[ range_index ].offset - rescue_handle->region_offset;
+			*size   = rescue_handle->ranges[ range_index ].size;
+
+			return( 1 );
+		}
+		bad_range_index--;
+	}
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+	 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+	 "%s: invalid bad range index value out of bounds.",
+	 function );
+
+	return( -1 );
+}
+
+/* Prints the bad ranges to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_handle_bad_ranges_fprint(
+     rescue_handle_t *rescue_handle,
+     FILE *stream,
+     uint32_t bytes_per_sector,
+     libcerror_error_t **error )
+{
+	rescue_range_t *range = NULL;
+	static char *function = "rescue_handle_bad_ranges_fprint";
+	off64_t range_offset  = 0;
+	int number_of_ranges  = 0;
+	int range_index       = 0;
+
+	if( rescue_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid bytes per sector value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( rescue_handle_get_number_of_bad_ranges(
+	     rescue_handle,
+	     &number_of_ranges,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of bad ranges.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_ranges > 0 )
+	{
+		fprintf(
+		 stream,
+		 "Errors rescuing device:\n" );
+		fprintf(
+		 stream,
+		 "\ttotal number: %d\n",
+		 number_of_ranges );
+
+		for( range_index = 0;
+		     range_index < rescue_handle->number_of_ranges;
+		     range_index++ )
+		{
+			range = &( rescue_handle->ranges[ range_index ] );
+
+			if( range->status == RESCUE_RANGE_STATUS_FINISHED )
+			{
+				continue;
+			}
+			range_offset = range->offset - rescue_handle->region_offset;
+
+			fprintf(
+			 stream,
+			 "\tat sector(s): %" PRIi64 " - %" PRIi64 " number: %" PRIu64 " (offset: 0x%08" PRIx64 " of size: %" PRIu64 ")\n",
+			 range_offset / bytes_per_sector,
+			 ( range_offset + (off64_t) range->size ) / bytes_per_sector,
+			 range->size / bytes_per_sector,
+			 range_offset,
+			 range->size );
+		}
+		fprintf(
+		 stream,
+		 "\n" );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_RESCUE_HANDLE ) */
+
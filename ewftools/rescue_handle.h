@@ -0,0 +1,301 @@
+/*
+ * Rescue handle, multi-pass acquiry of failing media
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _RESCUE_HANDLE_H )
+#define _RESCUE_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "process_status.h"
+#include "storage_media_buffer.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The rescue handle requires positional reads and writes on a file descriptor
+ */
+#if defined( HAVE_FCNTL_H ) && defined( HAVE_PREAD ) && defined( HAVE_PWRITE ) && !defined( WINAPI ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#define HAVE_RESCUE_HANDLE
+#endif
+
+/* The maximum number of bytes skipped after a read error in the copy pass
+ */
+#define RESCUE_HANDLE_MAXIMUM_SKIP_SIZE		( 1024 * 1024 * 1024 )
+
+/* The number of range status changes after which the map is written
+ */
+#define RESCUE_HANDLE_MAP_WRITE_INTERVAL	256
+
+/* The range status definitions, these are also used in the map file
+ */
+enum RESCUE_RANGE_STATUSES
+{
+	RESCUE_RANGE_STATUS_NON_TRIED		= (uint8_t) '?',
+	RESCUE_RANGE_STATUS_NON_TRIMMED		= (uint8_t) '*',
+	RESCUE_RANGE_STATUS_BAD_SECTOR		= (uint8_t) '-',
+	RESCUE_RANGE_STATUS_FINISHED		= (uint8_t) '+'
+};
+
+typedef struct rescue_range rescue_range_t;
+
+struct rescue_range
+{
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* The status
+	 */
+	uint8_t status;
+};
+
+typedef struct rescue_handle rescue_handle_t;
+
+struct rescue_handle
+{
+	/* The source file descriptor
+	 */
+	int source_descriptor;
+
+	/* The rescue image file descriptor
+	 */
+	int image_descriptor;
+
+	/* The map filename
+	 */
+	system_character_t *map_filename;
+
+	/* The map filename size
+	 */
+	size_t map_filename_size;
+
+	/* The offset of the rescued region
+	 */
+	off64_t region_offset;
+
+	/* The size of the rescued region
+	 */
+	size64_t region_size;
+
+	/* The number of bytes read at once in the copy pass
+	 */
+	size_t block_size;
+
+	/* The number of bytes read at once when trimming and retrying
+	 */
+	size_t error_granularity;
+
+	/* The number of retry passes over the bad sectors
+	 */
+	uint8_t number_of_retries;
+
+	/* The current status, which indicates the pass
+	 */
+	uint8_t current_status;
+
+	/* The ranges, sorted by offset and covering the rescued region
+	 */
+	rescue_range_t *ranges;
+
+	/* The number of ranges
+	 */
+	int number_of_ranges;
+
+	/* The number of allocated ranges
+	 */
+	int maximum_number_of_ranges;
+
+	/* The number of range status changes since the map was written
+	 */
+	int number_of_map_changes;
+
+	/* The read buffer
+	 */
+	uint8_t *buffer;
+
+	/* The read buffer size
+	 */
+	size_t buffer_size;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+#if defined( HAVE_RESCUE_HANDLE )
+
+int rescue_handle_initialize(
+     rescue_handle_t **rescue_handle,
+     libcerror_error_t **error );
+
+int rescue_handle_free(
+     rescue_handle_t **rescue_handle,
+     libcerror_error_t **error );
+
+int rescue_handle_signal_abort(
+     rescue_handle_t *rescue_handle,
+     libcerror_error_t **error );
+
+int rescue_handle_open(
+     rescue_handle_t *rescue_handle,
+     const system_character_t *source_filename,
+     const system_character_t *image_filename,
+     libcerror_error_t **error );
+
+int rescue_handle_close(
+     rescue_handle_t *rescue_handle,
+     libcerror_error_t **error );
+
+int rescue_handle_set_region(
+     rescue_handle_t *rescue_handle,
+     off64_t region_offset,
+     size64_t region_size,
+     size_t block_size,
+     size_t error_granularity,
+     libcerror_error_t **error );
+
+int rescue_handle_parse_map_value(
+     const char *string,
+     size_t string_size,
+     size_t *string_index,
+     uint64_t *value,
+     libcerror_error_t **error );
+
+int rescue_handle_read_map(
+     rescue_handle_t *rescue_handle,
+     libcerror_error_t **error );
+
+int rescue_handle_write_map(
+     rescue_handle_t *rescue_handle,
+     libcerror_error_t **error );
+
+int rescue_handle_get_range_index(
+     rescue_handle_t *rescue_handle,
+     off64_t offset,
+     int *range_index,
+     libcerror_error_t **error );
+
+int rescue_handle_insert_range(
+     rescue_handle_t *rescue_handle,
+     int range_index,
+     off64_t offset,
+     size64_t size,
+     uint8_t status,
+     libcerror_error_t **error );
+
+int rescue_handle_remove_ranges(
+     rescue_handle_t *rescue_handle,
+     int range_index,
+     int number_of_ranges,
+     libcerror_error_t **error );
+
+int rescue_handle_split_range(
+     rescue_handle_t *rescue_handle,
+     off64_t offset,
+     libcerror_error_t **error );
+
+int rescue_handle_set_range_status(
+     rescue_handle_t *rescue_handle,
+     off64_t offset,
+     size64_t size,
+     uint8_t status,
+     libcerror_error_t **error );
+
+int rescue_handle_get_next_range(
+     rescue_handle_t *rescue_handle,
+     uint8_t status,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+int rescue_handle_rescue_block(
+     rescue_handle_t *rescue_handle,
+     off64_t offset,
+     size_t size,
+     uint8_t failure_status,
+     libcerror_error_t **error );
+
+int rescue_handle_copy(
+     rescue_handle_t *rescue_handle,
+     process_status_t *process_status,
+     libcerror_error_t **error );
+
+int rescue_handle_trim(
+     rescue_handle_t *rescue_handle,
+     process_status_t *process_status,
+     libcerror_error_t **error );
+
+int rescue_handle_retry(
+     rescue_handle_t *rescue_handle,
+     process_status_t *process_status,
+     libcerror_error_t **error );
+
+int rescue_handle_acquire(
+     rescue_handle_t *rescue_handle,
+     uint8_t print_status_information,
+     libcerror_error_t **error );
+
+ssize_t rescue_handle_read_storage_media_buffer(
+         rescue_handle_t *rescue_handle,
+         storage_media_buffer_t *storage_media_buffer,
+         off64_t storage_media_offset,
+         size_t read_size,
+         libcerror_error_t **error );
+
+int rescue_handle_get_number_of_bad_ranges(
+     rescue_handle_t *rescue_handle,
+     int *number_of_bad_ranges,
+     libcerror_error_t **error );
+
+int rescue_handle_get_bad_range(
+     rescue_handle_t *rescue_handle,
+     int bad_range_index,
+     off64_t *offset,
+     size64_t *size,
+     libcerror_error_t **error );
+
+int rescue_handle_bad_ranges_fprint(
+     rescue_handle_t *rescue_handle,
+     FILE *stream,
+     uint32_t bytes_per_sector,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_RESCUE_HANDLE ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _RESCUE_HANDLE_H ) */
+
@@ -120,12 +120,13 @@ int storage_media_buffer_initialize(
 	}
 	if( size > 0 )
 	{
-/* TODO can low level functions and direct IO be combined ? */
+/* The raw buffer is aligned to the page size so it can be used for direct I/O
+ */
 #if defined( memory_allocate_aligned )
 		if( memory_allocate_aligned(
 		     (void **) &( ( *buffer )->raw_buffer ),
 		     size,
-		     512 ) != 0 )
+		     4096 ) != 0 )
 		{
 			libcerror_error_set(
 			 error,
@@ -226,6 +227,16 @@ int storage_media_buffer_free(
 			memory_free(
 			 ( *buffer )->raw_buffer );
 		}
+		if( ( *buffer )->packed_buffer != NULL )
+		{
+			memory_free(
+			 ( *buffer )->packed_buffer );
+		}
+		if( ( *buffer )->empty_packed_buffer != NULL )
+		{
+			memory_free(
+			 ( *buffer )->empty_packed_buffer );
+		}
 		if( ( *buffer )->data_chunk != NULL )
 		{
 			if( libewf_data_chunk_free(
@@ -373,7 +384,7 @@ ssize_t storage_media_buffer_read_from_handle(
 	}
 	if( storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
 	{
-		read_count = libewf_handle_read_data_chunk(
+		read_count = libewf_handle_read_packed_data_chunk(
 	                      handle,
 	                      storage_media_buffer->data_chunk,
 		              error );
@@ -414,7 +425,9 @@ ssize_t storage_media_buffer_read_process(
          libcerror_error_t **error )
 {
         static char *function = "storage_media_buffer_read_process";
+	size_t data_offset    = 0;
 	ssize_t process_count = 0;
+	int result            = 0;
 
 	if( storage_media_buffer == NULL )
 	{
@@ -427,8 +440,98 @@ ssize_t storage_media_buffer_read_process(
 
 		return( -1 );
 	}
+	storage_media_buffer->is_corrupted     = 0;
+	storage_media_buffer->packed_data_size = 0;
+	storage_media_buffer->empty_state      = STORAGE_MEDIA_BUFFER_EMPTY_STATE_UNKNOWN;
+
 	if( storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
 	{
+		/* The packed data is retained before the data chunk is unpacked
+		 */
+		if( ( storage_media_buffer->retain_packed_data != 0 )
+		 || ( storage_media_buffer->detect_empty_chunks != 0 ) )
+		{
+			if( storage_media_buffer_read_packed_data(
+			     storage_media_buffer,
+			     error ) < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read packed data from data chunk.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( storage_media_buffer->detect_empty_chunks != 0 )
+		{
+			if( storage_media_buffer_determine_empty_state(
+			     storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine empty state.",
+				 function );
+
+				return( -1 );
+			}
+			/* An empty chunk is not unpacked, its data is set to 0-byte values instead
+			 */
+			if( storage_media_buffer->empty_state == STORAGE_MEDIA_BUFFER_EMPTY_STATE_EMPTY )
+			{
+				if( storage_media_buffer->requested_size > storage_media_buffer->raw_buffer_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+					 "%s: invalid requested size value out of bounds.",
+					 function );
+
+					return( -1 );
+				}
+				if( memory_set(
+				     storage_media_buffer->raw_buffer,
+				     0,
+				     storage_media_buffer->requested_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear raw buffer.",
+					 function );
+
+					return( -1 );
+				}
+				storage_media_buffer->raw_buffer_data_size = storage_media_buffer->requested_size;
+				storage_media_buffer->processed_size       = storage_media_buffer->requested_size;
+
+				return( (ssize_t) storage_media_buffer->requested_size );
+			}
+		}
+		result = libewf_data_chunk_is_corrupted(
+		          storage_media_buffer->data_chunk,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if data chunk is corrupted.",
+			 function );
+
+			return( -1 );
+		}
+		storage_media_buffer->is_corrupted = (uint8_t) result;
+
 		process_count = libewf_data_chunk_read_buffer(
 		                 storage_media_buffer->data_chunk,
 		                 storage_media_buffer->raw_buffer,
@@ -458,6 +561,46 @@ ssize_t storage_media_buffer_read_process(
 			return( -1 );
 		}
 		storage_media_buffer->raw_buffer_data_size = (size_t) process_count;
+
+		/* Remember the packed data of an empty chunk so that chunks with
+		 * the same packed data do not need to be unpacked
+		 */
+		if( ( storage_media_buffer->detect_empty_chunks != 0 )
+		 && ( storage_media_buffer->empty_state == STORAGE_MEDIA_BUFFER_EMPTY_STATE_UNKNOWN )
+		 && ( storage_media_buffer->is_corrupted == 0 )
+		 && ( storage_media_buffer->packed_data_size > 0 ) )
+		{
+			while( data_offset < (size_t) process_count )
+			{
+				if( storage_media_buffer->raw_buffer[ data_offset ] != 0 )
+				{
+					break;
+				}
+				data_offset++;
+			}
+			if( data_offset < (size_t) process_count )
+			{
+				storage_media_buffer->empty_state = STORAGE_MEDIA_BUFFER_EMPTY_STATE_NOT_EMPTY;
+			}
+			else
+			{
+				storage_media_buffer->empty_state = STORAGE_MEDIA_BUFFER_EMPTY_STATE_EMPTY;
+
+				if( storage_media_buffer_set_empty_packed_data(
+				     storage_media_buffer,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set empty packed data.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
 	}
 	else
 	{
@@ -518,6 +661,333 @@ ssize_t storage_media_buffer_write_process(
 	return( process_count );
 }
 
+/* Reads the packed data of the data chunk into the packed data buffer
+ * Returns the number of bytes read, 0 if the data chunk is not packed or -1 on error
+ */
+ssize_t storage_media_buffer_read_packed_data(
+         storage_media_buffer_t *storage_media_buffer,
+         libcerror_error_t **error )
+{
+	uint8_t *packed_buffer  = NULL;
+	static char *function   = "storage_media_buffer_read_packed_data";
+	size_t packed_data_size = 0;
+	ssize_t read_count      = 0;
+	int result              = 0;
+
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer->mode != STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid storage media buffer - unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	storage_media_buffer->packed_data_size  = 0;
+	storage_media_buffer->packed_data_flags = 0;
+
+	result = libewf_data_chunk_get_packed_data_size(
+	          storage_media_buffer->data_chunk,
+	          &packed_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve packed data size.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( packed_data_size > storage_media_buffer->packed_buffer_size )
+	{
+		packed_buffer = (uint8_t *) memory_reallocate(
+		                             storage_media_buffer->packed_buffer,
+		                             sizeof( uint8_t ) * packed_data_size );
+
+		if( packed_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize packed buffer.",
+			 function );
+
+			return( -1 );
+		}
+		storage_media_buffer->packed_buffer      = packed_buffer;
+		storage_media_buffer->packed_buffer_size = packed_data_size;
+	}
+	read_count = libewf_data_chunk_read_packed_data(
+	              storage_media_buffer->data_chunk,
+	              storage_media_buffer->packed_buffer,
+	              storage_media_buffer->packed_buffer_size,
+	              &( storage_media_buffer->packed_data_flags ),
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read packed data from data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	storage_media_buffer->packed_data_size = (size_t) read_count;
+
+	return( read_count );
+}
+
+/* Determines if the data chunk only contains 0-byte values from its packed data
+ * Pattern fill chunks, compressed chunks that are too large to contain only 0-byte values
+ * and chunks with the same packed data as a previous empty chunk are determined
+ * without unpacking the chunk, otherwise the empty state remains unknown
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_determine_empty_state(
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error )
+{
+	static char *function          = "storage_media_buffer_determine_empty_state";
+	size_t maximum_empty_data_size = 0;
+	size_t packed_data_offset      = 0;
+
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	storage_media_buffer->empty_state = STORAGE_MEDIA_BUFFER_EMPTY_STATE_UNKNOWN;
+
+	if( ( storage_media_buffer->packed_buffer == NULL )
+	 || ( storage_media_buffer->packed_data_size == 0 ) )
+	{
+		return( 1 );
+	}
+	if( ( storage_media_buffer->packed_data_flags & LIBEWF_DATA_CHUNK_FLAG_USES_PATTERN_FILL ) != 0 )
+	{
+		/* The packed data of a pattern fill chunk starts with the 8-byte pattern
+		 */
+		if( storage_media_buffer->packed_data_size >= 8 )
+		{
+			storage_media_buffer->empty_state = STORAGE_MEDIA_BUFFER_EMPTY_STATE_EMPTY;
+
+			for( packed_data_offset = 0;
+			     packed_data_offset < 8;
+			     packed_data_offset++ )
+			{
+				if( storage_media_buffer->packed_buffer[ packed_data_offset ] != 0 )
+				{
+					storage_media_buffer->empty_state = STORAGE_MEDIA_BUFFER_EMPTY_STATE_NOT_EMPTY;
+
+					break;
+				}
+			}
+		}
+		return( 1 );
+	}
+	/* A chunk of 0-byte values compresses extremely well, hence a compressed
+	 * chunk larger than this cannot contain only 0-byte values
+	 */
+	maximum_empty_data_size = ( storage_media_buffer->raw_buffer_size / 64 ) + 64;
+
+	if( ( ( storage_media_buffer->packed_data_flags & LIBEWF_DATA_CHUNK_FLAG_IS_COMPRESSED ) != 0 )
+	 && ( storage_media_buffer->packed_data_size > maximum_empty_data_size ) )
+	{
+		storage_media_buffer->empty_state = STORAGE_MEDIA_BUFFER_EMPTY_STATE_NOT_EMPTY;
+
+		return( 1 );
+	}
+	/* Identical packed data unpacks to identical data
+	 */
+	if( ( storage_media_buffer->empty_packed_buffer != NULL )
+	 && ( storage_media_buffer->empty_packed_data_size == storage_media_buffer->packed_data_size )
+	 && ( memory_compare(
+	       storage_media_buffer->empty_packed_buffer,
+	       storage_media_buffer->packed_buffer,
+	       storage_media_buffer->packed_data_size ) == 0 ) )
+	{
+		storage_media_buffer->empty_state = STORAGE_MEDIA_BUFFER_EMPTY_STATE_EMPTY;
+	}
+	return( 1 );
+}
+
+/* Sets the packed data of the data chunk as the packed data of an empty chunk
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_set_empty_packed_data(
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error )
+{
+	uint8_t *empty_packed_buffer = NULL;
+	static char *function        = "storage_media_buffer_set_empty_packed_data";
+
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( storage_media_buffer->packed_buffer == NULL )
+	 || ( storage_media_buffer->packed_data_size == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid storage media buffer - missing packed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer->packed_data_size > storage_media_buffer->empty_packed_buffer_size )
+	{
+		empty_packed_buffer = (uint8_t *) memory_reallocate(
+		                                   storage_media_buffer->empty_packed_buffer,
+		                                   sizeof( uint8_t ) * storage_media_buffer->packed_data_size );
+
+		if( empty_packed_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize empty packed buffer.",
+			 function );
+
+			return( -1 );
+		}
+		storage_media_buffer->empty_packed_buffer      = empty_packed_buffer;
+		storage_media_buffer->empty_packed_buffer_size = storage_media_buffer->packed_data_size;
+	}
+	if( memory_copy(
+	     storage_media_buffer->empty_packed_buffer,
+	     storage_media_buffer->packed_buffer,
+	     storage_media_buffer->packed_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy packed data.",
+		 function );
+
+		storage_media_buffer->empty_packed_data_size = 0;
+
+		return( -1 );
+	}
+	storage_media_buffer->empty_packed_data_size = storage_media_buffer->packed_data_size;
+
+	return( 1 );
+}
+
+/* Processes packed data before write
+ * The packed data is written to the data chunk without being compressed
+ * Returns the resulting buffer size or -1 on error
+ */
+ssize_t storage_media_buffer_write_packed_process(
+         storage_media_buffer_t *storage_media_buffer,
+         const uint8_t *packed_data,
+         size_t packed_data_size,
+         size_t data_size,
+         uint32_t packed_data_flags,
+         libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_write_packed_process";
+	ssize_t write_count   = 0;
+
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer->mode != STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid storage media buffer - unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = libewf_data_chunk_write_packed_data(
+	               storage_media_buffer->data_chunk,
+	               packed_data,
+	               packed_data_size,
+	               data_size,
+	               packed_data_flags,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write packed data to data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	storage_media_buffer->processed_size = data_size;
+
+	return( (ssize_t) data_size );
+}
+
 /* Writes a storage media buffer to the input handle
  * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
  */
@@ -574,3 +1044,63 @@ ssize_t storage_media_buffer_write_to_handle(
 	return( write_count );
 }
 
+/* Writes the data chunk of a storage media buffer to the handle at its storage media offset
+ * The handle requires a concurrent segment write
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t storage_media_buffer_write_to_handle_at_offset(
+         storage_media_buffer_t *storage_media_buffer,
+         libewf_handle_t *handle,
+         size_t write_size,
+         libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_write_to_handle_at_offset";
+	ssize_t write_count   = 0;
+
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer->mode != STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid storage media buffer - unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_size == 0 )
+	{
+		return( 0 );
+	}
+	write_count = libewf_handle_write_data_chunk_at_offset(
+	               handle,
+	               storage_media_buffer->data_chunk,
+	               storage_media_buffer->storage_media_offset,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write storage media buffer at offset: %" PRIi64 ".",
+		 function,
+		 storage_media_buffer->storage_media_offset );
+
+		return( -1 );
+	}
+	return( write_count );
+}
+
@@ -38,6 +38,13 @@ enum STORAGE_MEDIA_BUFFER_MODES
 	STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA	= 1
 };
 
+enum STORAGE_MEDIA_BUFFER_EMPTY_STATES
+{
+	STORAGE_MEDIA_BUFFER_EMPTY_STATE_UNKNOWN	= 0,
+	STORAGE_MEDIA_BUFFER_EMPTY_STATE_EMPTY		= 1,
+	STORAGE_MEDIA_BUFFER_EMPTY_STATE_NOT_EMPTY	= 2
+};
+
 typedef struct storage_media_buffer storage_media_buffer_t;
 
 struct storage_media_buffer
@@ -73,6 +80,55 @@ struct storage_media_buffer
 	/* The processed size
 	 */
 	size_t processed_size;
+
+	/* Value to indicate the data chunk is corrupted
+	 */
+	uint8_t is_corrupted;
+
+	/* Value to indicate the packed data of the data chunk should be retained
+	 */
+	uint8_t retain_packed_data;
+
+	/* The packed data buffer
+	 */
+	uint8_t *packed_buffer;
+
+	/* The packed data buffer size
+	 */
+	size_t packed_buffer_size;
+
+	/* The size of the packed data in the packed data buffer
+	 */
+	size_t packed_data_size;
+
+	/* The packed data chunk flags
+	 */
+	uint32_t packed_data_flags;
+
+	/* Value to indicate if empty chunks should be determined from their packed data
+	 */
+	uint8_t detect_empty_chunks;
+
+	/* Value to indicate if the data only contains 0-byte values
+	 */
+	uint8_t empty_state;
+
+	/* The packed data of a chunk that was found to be empty
+	 */
+	uint8_t *empty_packed_buffer;
+
+	/* The empty packed data buffer size
+	 */
+	size_t empty_packed_buffer_size;
+
+	/* The size of the packed data in the empty packed data buffer
+	 */
+	size_t empty_packed_data_size;
+
+	/* The owner of the buffer, which is used when the buffers of multiple
+	 * handles are processed by a shared thread pool
+	 */
+	intptr_t *owner;
 };
 
 int storage_media_buffer_initialize(
@@ -111,12 +167,38 @@ ssize_t storage_media_buffer_write_process(
          storage_media_buffer_t *storage_media_buffer,
          libcerror_error_t **error );
 
+ssize_t storage_media_buffer_read_packed_data(
+         storage_media_buffer_t *storage_media_buffer,
+         libcerror_error_t **error );
+
+int storage_media_buffer_determine_empty_state(
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
+int storage_media_buffer_set_empty_packed_data(
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
+ssize_t storage_media_buffer_write_packed_process(
+         storage_media_buffer_t *storage_media_buffer,
+         const uint8_t *packed_data,
+         size_t packed_data_size,
+         size_t data_size,
+         uint32_t packed_data_flags,
+         libcerror_error_t **error );
+
 ssize_t storage_media_buffer_write_to_handle(
          storage_media_buffer_t *storage_media_buffer,
          libewf_handle_t *handle,
          size_t write_size,
          libcerror_error_t **error );
 
+ssize_t storage_media_buffer_write_to_handle_at_offset(
+         storage_media_buffer_t *storage_media_buffer,
+         libewf_handle_t *handle,
+         size_t write_size,
+         libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
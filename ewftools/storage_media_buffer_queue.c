@@ -25,9 +25,132 @@
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
+#include "platform.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
 
+#if defined( HAVE_ATOMIC_BUILTINS )
+
+#define storage_media_buffer_queue_atomic_load( value ) \
+	__atomic_load_n( value, __ATOMIC_ACQUIRE )
+
+#define storage_media_buffer_queue_atomic_store( value, new_value ) \
+	__atomic_store_n( value, new_value, __ATOMIC_RELEASE )
+
+#define storage_media_buffer_queue_atomic_compare_exchange( value, expected_value, new_value ) \
+	__atomic_compare_exchange_n( value, expected_value, new_value, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED )
+
+#else
+
+/* Without atomic operations the queue is protected by the condition mutex
+ * hence the compare exchange always succeeds
+ */
+#define storage_media_buffer_queue_atomic_load( value ) \
+	*( value )
+
+#define storage_media_buffer_queue_atomic_store( value, new_value ) \
+	*( value ) = new_value
+
+#define storage_media_buffer_queue_atomic_compare_exchange( value, expected_value, new_value ) \
+	( ( *( value ) = new_value ), 1 )
+
+#endif /* defined( HAVE_ATOMIC_BUILTINS ) */
+
+/* Determines the maximum number of storage media buffers in a queue
+ * If the memory limit is 0 the default memory limit is used, which is reduced
+ * to a quarter of the physical memory on systems with little memory
+ * The number of buffers is at least 2 more than the number of threads, so
+ * every thread can be kept busy while data is read and written
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_queue_get_maximum_number_of_values(
+     size64_t memory_limit,
+     size_t storage_media_buffer_size,
+     int number_of_threads,
+     int *maximum_number_of_values,
+     libcerror_error_t **error )
+{
+	static char *function          = "storage_media_buffer_queue_get_maximum_number_of_values";
+	size64_t physical_memory_size  = 0;
+	uint64_t safe_number_of_values = 0;
+	int result                     = 0;
+
+	if( storage_media_buffer_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid storage media buffer size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > (int) ( INT_MAX / 4 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of values.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_limit == 0 )
+	{
+		memory_limit = STORAGE_MEDIA_BUFFER_QUEUE_DEFAULT_MEMORY_LIMIT;
+
+		result = platform_get_physical_memory_size(
+		          &physical_memory_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve physical memory size.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			if( ( physical_memory_size / 4 ) < memory_limit )
+			{
+				memory_limit = physical_memory_size / 4;
+			}
+		}
+	}
+	safe_number_of_values = 1 + ( memory_limit / storage_media_buffer_size );
+
+	if( safe_number_of_values < (uint64_t) ( number_of_threads + 2 ) )
+	{
+		safe_number_of_values = (uint64_t) ( number_of_threads + 2 );
+	}
+	if( safe_number_of_values > (uint64_t) ( INT_MAX / 2 ) )
+	{
+		safe_number_of_values = (uint64_t) ( INT_MAX / 2 );
+	}
+	*maximum_number_of_values = (int) safe_number_of_values;
+
+	return( 1 );
+}
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
 /* Creates a storage media buffer queue
@@ -35,7 +158,7 @@
  * Returns 1 if successful or -1 on error
  */
 int storage_media_buffer_queue_initialize(
-     libcthreads_queue_t **queue,
+     storage_media_buffer_queue_t **queue,
      libewf_handle_t *handle,
      int maximum_number_of_values,
      uint8_t storage_media_buffer_mode,
@@ -44,6 +167,8 @@ int storage_media_buffer_queue_initialize(
 {
 	storage_media_buffer_t *buffer = NULL;
 	static char *function          = "storage_media_buffer_queue_initialize";
+	size_t number_of_slots         = 1;
+	size_t slot_index              = 0;
 	int value_index                = 0;
 
 	if( queue == NULL )
@@ -69,7 +194,7 @@ int storage_media_buffer_queue_initialize(
 		return( -1 );
 	}
 	if( ( maximum_number_of_values < 0 )
-	 || ( maximum_number_of_values > (int) ( INT_MAX - 1 ) ) )
+	 || ( maximum_number_of_values > (int) ( INT_MAX / 2 ) ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -80,16 +205,90 @@ int storage_media_buffer_queue_initialize(
 
 		return( -1 );
 	}
-	if( libcthreads_queue_initialize(
-	     queue,
-	     maximum_number_of_values,
+	/* The number of slots is a power of 2 so the slot index can be masked
+	 */
+	while( number_of_slots < (size_t) maximum_number_of_values )
+	{
+		number_of_slots <<= 1;
+	}
+	*queue = memory_allocate_structure(
+	          storage_media_buffer_queue_t );
+
+	if( *queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create queue.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *queue,
+	     0,
+	     sizeof( storage_media_buffer_queue_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear queue.",
+		 function );
+
+		memory_free(
+		 *queue );
+
+		*queue = NULL;
+
+		return( -1 );
+	}
+	( *queue )->slots = (storage_media_buffer_queue_slot_t *) memory_allocate(
+	                                                           sizeof( storage_media_buffer_queue_slot_t ) * number_of_slots );
+
+	if( ( *queue )->slots == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create slots.",
+		 function );
+
+		goto on_error;
+	}
+	for( slot_index = 0;
+	     slot_index < number_of_slots;
+	     slot_index++ )
+	{
+		( *queue )->slots[ slot_index ].sequence_number      = slot_index;
+		( *queue )->slots[ slot_index ].storage_media_buffer = NULL;
+	}
+	( *queue )->number_of_slots = number_of_slots;
+
+	if( libcthreads_mutex_initialize(
+	     &( ( *queue )->condition_mutex ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to initialize storage media buffer queue.",
+		 "%s: unable to create condition mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *queue )->buffer_released_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create buffer released condition.",
 		 function );
 
 		goto on_error;
@@ -116,10 +315,10 @@ int storage_media_buffer_queue_initialize(
 
 			goto on_error;
 		}
-		if( libcthreads_queue_push(
+		if( storage_media_buffer_queue_try_push(
 		     *queue,
-		     (intptr_t *) buffer,
-		     error ) == -1 )
+		     buffer,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -131,6 +330,8 @@ int storage_media_buffer_queue_initialize(
 			goto on_error;
 		}
 		buffer = NULL;
+
+		( *queue )->number_of_buffers += 1;
 	}
 	return( 1 );
 
@@ -151,14 +352,17 @@ on_error:
 }
 
 /* Frees a storage media buffer queue
+ * The storage media buffers in the queue are freed, buffers that were
+ * grabbed and not released need to be freed by the caller
  * Returns 1 if successful or -1 on error
  */
 int storage_media_buffer_queue_free(
-     libcthreads_queue_t **queue,
+     storage_media_buffer_queue_t **queue,
      libcerror_error_t **error )
 {
-	static char *function = "storage_media_buffer_queue_free";
-	int result            = 1;
+	storage_media_buffer_t *buffer = NULL;
+	static char *function          = "storage_media_buffer_queue_free";
+	int result                     = 1;
 
 	if( queue == NULL )
 	{
@@ -173,38 +377,439 @@ int storage_media_buffer_queue_free(
 	}
 	if( *queue != NULL )
 	{
-		if( libcthreads_queue_free(
-		     queue,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &storage_media_buffer_free,
-		     error ) != 1 )
+		if( ( *queue )->slots != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free storage media buffer queue.",
-			 function );
+			while( storage_media_buffer_queue_try_pop(
+			        *queue,
+			        &buffer,
+			        NULL ) == 1 )
+			{
+				if( storage_media_buffer_free(
+				     &buffer,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free storage media buffer.",
+					 function );
 
-			result = -1;
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *queue )->slots );
+		}
+		if( ( *queue )->buffer_released_condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( ( *queue )->buffer_released_condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free buffer released condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *queue )->condition_mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *queue )->condition_mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free condition mutex.",
+				 function );
+
+				result = -1;
+			}
 		}
+		memory_free(
+		 *queue );
+
+		*queue = NULL;
+	}
+	return( result );
+}
+
+/* Tries to pop a storage media buffer from the queue without waiting
+ * Without atomic builtins the caller must hold the condition mutex
+ * Returns 1 if successful, 0 if the queue is empty or -1 on error
+ */
+int storage_media_buffer_queue_try_pop(
+     storage_media_buffer_queue_t *queue,
+     storage_media_buffer_t **buffer,
+     libcerror_error_t **error )
+{
+	storage_media_buffer_queue_slot_t *slot = NULL;
+	static char *function                   = "storage_media_buffer_queue_try_pop";
+	size_t dequeue_index                    = 0;
+	size_t sequence_number                  = 0;
+	ssize_t difference                      = 0;
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	dequeue_index = storage_media_buffer_queue_atomic_load(
+	                 &( queue->dequeue_index ) );
+
+	for( ;; )
+	{
+		slot = &( queue->slots[ dequeue_index & ( queue->number_of_slots - 1 ) ] );
+
+		sequence_number = storage_media_buffer_queue_atomic_load(
+		                   &( slot->sequence_number ) );
+
+		difference = (ssize_t) ( sequence_number - ( dequeue_index + 1 ) );
+
+		if( difference == 0 )
+		{
+			/* The slot was filled, claim it
+			 */
+			if( storage_media_buffer_queue_atomic_compare_exchange(
+			     &( queue->dequeue_index ),
+			     &dequeue_index,
+			     dequeue_index + 1 ) )
+			{
+				break;
+			}
+		}
+		else if( difference < 0 )
+		{
+			/* The slot was not filled, hence the queue is empty
+			 */
+			return( 0 );
+		}
+		else
+		{
+			/* Another thread claimed the slot
+			 */
+			dequeue_index = storage_media_buffer_queue_atomic_load(
+			                 &( queue->dequeue_index ) );
+		}
+	}
+	*buffer = slot->storage_media_buffer;
+
+	slot->storage_media_buffer = NULL;
+
+	/* Mark the slot to be filled on the next pass over the ring
+	 */
+	storage_media_buffer_queue_atomic_store(
+	 &( slot->sequence_number ),
+	 dequeue_index + queue->number_of_slots );
+
+	return( 1 );
+}
+
+/* Tries to push a storage media buffer onto the queue without waiting
+ * Without atomic builtins the caller must hold the condition mutex
+ * Returns 1 if successful, 0 if the queue is full or -1 on error
+ */
+int storage_media_buffer_queue_try_push(
+     storage_media_buffer_queue_t *queue,
+     storage_media_buffer_t *buffer,
+     libcerror_error_t **error )
+{
+	storage_media_buffer_queue_slot_t *slot = NULL;
+	static char *function                   = "storage_media_buffer_queue_try_push";
+	size_t current_enqueue_index            = 0;
+	size_t dequeue_index                    = 0;
+	size_t enqueue_index                    = 0;
+	size_t sequence_number                  = 0;
+	ssize_t difference                      = 0;
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	enqueue_index = storage_media_buffer_queue_atomic_load(
+	                 &( queue->enqueue_index ) );
+
+	for( ;; )
+	{
+		slot = &( queue->slots[ enqueue_index & ( queue->number_of_slots - 1 ) ] );
+
+		sequence_number = storage_media_buffer_queue_atomic_load(
+		                   &( slot->sequence_number ) );
+
+		difference = (ssize_t) ( sequence_number - enqueue_index );
+
+		if( difference == 0 )
+		{
+			/* The slot is empty, claim it
+			 */
+			if( storage_media_buffer_queue_atomic_compare_exchange(
+			     &( queue->enqueue_index ),
+			     &enqueue_index,
+			     enqueue_index + 1 ) )
+			{
+				break;
+			}
+		}
+		else if( difference < 0 )
+		{
+			/* The slot was not emptied, the queue is full unless the enqueue
+			 * index is outdated or another thread claimed the slot to empty it
+			 * but did not finish yet
+			 */
+			current_enqueue_index = storage_media_buffer_queue_atomic_load(
+			                         &( queue->enqueue_index ) );
+
+			if( current_enqueue_index == enqueue_index )
+			{
+				dequeue_index = storage_media_buffer_queue_atomic_load(
+				                 &( queue->dequeue_index ) );
+
+				if( (ssize_t) ( enqueue_index - dequeue_index ) >= (ssize_t) queue->number_of_slots )
+				{
+					return( 0 );
+				}
+			}
+			enqueue_index = current_enqueue_index;
+		}
+		else
+		{
+			/* Another thread claimed the slot
+			 */
+			enqueue_index = storage_media_buffer_queue_atomic_load(
+			                 &( queue->enqueue_index ) );
+		}
+	}
+	slot->storage_media_buffer = buffer;
+
+	/* Mark the slot as filled
+	 */
+	storage_media_buffer_queue_atomic_store(
+	 &( slot->sequence_number ),
+	 enqueue_index + 1 );
+
+	return( 1 );
+}
+
+/* Tries to grab a storage media buffer from the queue without waiting
+ * No buffer is grabbed if the maximum number of buffers in use was reached,
+ * which is approximate when multiple threads grab buffers concurrently
+ * Without atomic builtins the caller must hold the condition mutex
+ * Returns 1 if successful, 0 if no buffer is available or -1 on error
+ */
+int storage_media_buffer_queue_try_grab(
+     storage_media_buffer_queue_t *queue,
+     storage_media_buffer_t **buffer,
+     libcerror_error_t **error )
+{
+	static char *function                = "storage_media_buffer_queue_try_grab";
+	size_t dequeue_index                 = 0;
+	size_t enqueue_index                 = 0;
+	ssize_t number_of_free               = 0;
+	int maximum_number_of_buffers_in_use = 0;
+	int result                           = 0;
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	maximum_number_of_buffers_in_use = storage_media_buffer_queue_atomic_load(
+	                                    &( queue->maximum_number_of_buffers_in_use ) );
+
+	if( ( maximum_number_of_buffers_in_use > 0 )
+	 && ( maximum_number_of_buffers_in_use < queue->number_of_buffers ) )
+	{
+		dequeue_index = storage_media_buffer_queue_atomic_load(
+		                 &( queue->dequeue_index ) );
+
+		enqueue_index = storage_media_buffer_queue_atomic_load(
+		                 &( queue->enqueue_index ) );
+
+		number_of_free = (ssize_t) ( enqueue_index - dequeue_index );
+
+		if( ( queue->number_of_buffers - (int) number_of_free ) >= maximum_number_of_buffers_in_use )
+		{
+			return( 0 );
+		}
+	}
+	result = storage_media_buffer_queue_try_pop(
+	          queue,
+	          buffer,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to pop storage media buffer from queue.",
+		 function );
+
+		return( -1 );
 	}
 	return( result );
 }
 
 /* Grabs a storage media buffer from the queue
+ * Waits until a buffer is released if the queue is empty or if the maximum
+ * number of buffers in use was reached
  * Returns 1 if successful or -1 on error
  */
 int storage_media_buffer_queue_grab_buffer(
-     libcthreads_queue_t *queue,
+     storage_media_buffer_queue_t *queue,
      storage_media_buffer_t **buffer,
      libcerror_error_t **error )
 {
 	static char *function = "storage_media_buffer_queue_grab_buffer";
+	int result            = 0;
 
-	if( libcthreads_queue_pop(
-	     queue,
-	     (intptr_t **) buffer,
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_ATOMIC_BUILTINS )
+	result = storage_media_buffer_queue_try_grab(
+	          queue,
+	          buffer,
+	          error );
+
+	if( result != 0 )
+	{
+		goto on_pop;
+	}
+	/* The waiting thread is registered before the queue is checked again
+	 * so that a concurrent release either is seen or signals the condition
+	 */
+	__atomic_add_fetch(
+	 &( queue->number_of_waiting_threads ),
+	 1,
+	 __ATOMIC_SEQ_CST );
+
+	__atomic_thread_fence(
+	 __ATOMIC_SEQ_CST );
+#endif
+	if( libcthreads_mutex_grab(
+	     queue->condition_mutex,
 	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		for( ;; )
+		{
+			result = storage_media_buffer_queue_try_grab(
+			          queue,
+			          buffer,
+			          error );
+
+			if( result != 0 )
+			{
+				break;
+			}
+			if( libcthreads_condition_wait(
+			     queue->buffer_released_condition,
+			     queue->condition_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for buffer released condition.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+		}
+		if( libcthreads_mutex_release(
+		     queue->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release condition mutex.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_ATOMIC_BUILTINS )
+	__atomic_sub_fetch(
+	 &( queue->number_of_waiting_threads ),
+	 1,
+	 __ATOMIC_SEQ_CST );
+
+on_pop:
+#endif
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -222,16 +827,95 @@ int storage_media_buffer_queue_grab_buffer(
  * Returns 1 if successful or -1 on error
  */
 int storage_media_buffer_queue_release_buffer(
-     libcthreads_queue_t *queue,
+     storage_media_buffer_queue_t *queue,
      storage_media_buffer_t *buffer,
      libcerror_error_t **error )
 {
 	static char *function = "storage_media_buffer_queue_release_buffer";
+	int result            = 0;
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_ATOMIC_BUILTINS )
+	result = storage_media_buffer_queue_try_push(
+	          queue,
+	          buffer,
+	          error );
+
+	if( result != 1 )
+	{
+		goto on_push;
+	}
+	__atomic_thread_fence(
+	 __ATOMIC_SEQ_CST );
+
+	/* Only take the condition mutex if a thread is waiting for a buffer
+	 */
+	if( __atomic_load_n(
+	     &( queue->number_of_waiting_threads ),
+	     __ATOMIC_SEQ_CST ) == 0 )
+	{
+		return( 1 );
+	}
+#endif
+	if( libcthreads_mutex_grab(
+	     queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
 
-	if( libcthreads_queue_push(
-	     queue,
-	     (intptr_t *) buffer,
+		return( -1 );
+	}
+#if !defined( HAVE_ATOMIC_BUILTINS )
+	result = storage_media_buffer_queue_try_push(
+	          queue,
+	          buffer,
+	          error );
+#endif
+	if( libcthreads_condition_broadcast(
+	     queue->buffer_released_condition,
 	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast buffer released condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_ATOMIC_BUILTINS )
+on_push:
+#endif
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -245,5 +929,185 @@ int storage_media_buffer_queue_release_buffer(
 	return( 1 );
 }
 
+/* Retrieves the number of storage media buffers in use
+ * The number is an estimate when other threads grab or release buffers concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_queue_get_number_of_buffers_in_use(
+     storage_media_buffer_queue_t *queue,
+     int *number_of_buffers_in_use,
+     libcerror_error_t **error )
+{
+	static char *function  = "storage_media_buffer_queue_get_number_of_buffers_in_use";
+	size_t dequeue_index   = 0;
+	size_t enqueue_index   = 0;
+	ssize_t number_of_free = 0;
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buffers_in_use == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of buffers in use.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_ATOMIC_BUILTINS )
+	if( libcthreads_mutex_grab(
+	     queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	dequeue_index = storage_media_buffer_queue_atomic_load(
+	                 &( queue->dequeue_index ) );
+
+	enqueue_index = storage_media_buffer_queue_atomic_load(
+	                 &( queue->enqueue_index ) );
+
+#if !defined( HAVE_ATOMIC_BUILTINS )
+	if( libcthreads_mutex_release(
+	     queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	number_of_free = (ssize_t) ( enqueue_index - dequeue_index );
+
+	if( number_of_free < 0 )
+	{
+		number_of_free = 0;
+	}
+	else if( number_of_free > (ssize_t) queue->number_of_buffers )
+	{
+		number_of_free = (ssize_t) queue->number_of_buffers;
+	}
+	*number_of_buffers_in_use = queue->number_of_buffers - (int) number_of_free;
+
+	return( 1 );
+}
+
+/* Sets the maximum number of storage media buffers in use
+ * The maximum limits the number of buffers being processed concurrently,
+ * where 0 represents all the storage media buffers. It should exceed the number
+ * of buffers a thread holds while it grabs another one, otherwise it can wait
+ * on itself
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_queue_set_maximum_number_of_buffers_in_use(
+     storage_media_buffer_queue_t *queue,
+     int maximum_number_of_buffers_in_use,
+     libcerror_error_t **error )
+{
+	static char *function                         = "storage_media_buffer_queue_set_maximum_number_of_buffers_in_use";
+	int previous_maximum_number_of_buffers_in_use = 0;
+	int result                                    = 1;
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_buffers_in_use < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of buffers in use value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	previous_maximum_number_of_buffers_in_use = queue->maximum_number_of_buffers_in_use;
+
+	storage_media_buffer_queue_atomic_store(
+	 &( queue->maximum_number_of_buffers_in_use ),
+	 maximum_number_of_buffers_in_use );
+
+	/* Threads waiting for the previous maximum can continue if it was raised
+	 */
+	if( ( previous_maximum_number_of_buffers_in_use != 0 )
+	 && ( ( maximum_number_of_buffers_in_use == 0 )
+	  || ( maximum_number_of_buffers_in_use > previous_maximum_number_of_buffers_in_use ) ) )
+	{
+		if( libcthreads_condition_broadcast(
+		     queue->buffer_released_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast buffer released condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     queue->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
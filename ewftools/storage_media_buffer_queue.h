@@ -34,10 +34,95 @@
 extern "C" {
 #endif
 
+/* The default memory limit of the storage media buffers
+ */
+#define STORAGE_MEDIA_BUFFER_QUEUE_DEFAULT_MEMORY_LIMIT	( 512 * 1024 * 1024 )
+
+/* The size of a CPU cache line, used to keep the enqueue and dequeue index
+ * of the queue from sharing a cache line
+ */
+#define STORAGE_MEDIA_BUFFER_QUEUE_CACHE_LINE_SIZE	64
+
+typedef struct storage_media_buffer_queue_slot storage_media_buffer_queue_slot_t;
+
+struct storage_media_buffer_queue_slot
+{
+	/* The sequence number, which indicates if the slot can be filled or emptied
+	 */
+	size_t sequence_number;
+
+	/* The storage media buffer
+	 */
+	storage_media_buffer_t *storage_media_buffer;
+};
+
+typedef struct storage_media_buffer_queue storage_media_buffer_queue_t;
+
+/* A bounded multi producer multi consumer ring of storage media buffers
+ * Grabbing and releasing buffers does not take a lock unless a thread
+ * has to wait for a buffer to be released
+ */
+struct storage_media_buffer_queue
+{
+	/* The index of the next slot to fill
+	 */
+	size_t enqueue_index;
+
+	/* Padding to keep the enqueue and dequeue index on separate cache lines
+	 */
+	uint8_t enqueue_padding[ STORAGE_MEDIA_BUFFER_QUEUE_CACHE_LINE_SIZE - sizeof( size_t ) ];
+
+	/* The index of the next slot to empty
+	 */
+	size_t dequeue_index;
+
+	/* Padding to keep the enqueue and dequeue index on separate cache lines
+	 */
+	uint8_t dequeue_padding[ STORAGE_MEDIA_BUFFER_QUEUE_CACHE_LINE_SIZE - sizeof( size_t ) ];
+
+	/* The slots
+	 */
+	storage_media_buffer_queue_slot_t *slots;
+
+	/* The number of slots, which is a power of 2
+	 */
+	size_t number_of_slots;
+
+	/* The number of storage media buffers
+	 */
+	int number_of_buffers;
+
+	/* The number of threads waiting for a storage media buffer
+	 */
+	int number_of_waiting_threads;
+
+	/* The maximum number of storage media buffers in use
+	 * 0 represents all the storage media buffers
+	 */
+	int maximum_number_of_buffers_in_use;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The condition mutex
+	 */
+	libcthreads_mutex_t *condition_mutex;
+
+	/* The buffer released condition
+	 */
+	libcthreads_condition_t *buffer_released_condition;
+#endif
+};
+
+int storage_media_buffer_queue_get_maximum_number_of_values(
+     size64_t memory_limit,
+     size_t storage_media_buffer_size,
+     int number_of_threads,
+     int *maximum_number_of_values,
+     libcerror_error_t **error );
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
 int storage_media_buffer_queue_initialize(
-     libcthreads_queue_t **queue,
+     storage_media_buffer_queue_t **queue,
      libewf_handle_t *handle,
      int maximum_number_of_values,
      uint8_t storage_media_buffer_mode,
@@ -45,19 +130,44 @@ int storage_media_buffer_queue_initialize(
      libcerror_error_t **error );
 
 int storage_media_buffer_queue_free(
-     libcthreads_queue_t **queue,
+     storage_media_buffer_queue_t **queue,
+     libcerror_error_t **error );
+
+int storage_media_buffer_queue_try_pop(
+     storage_media_buffer_queue_t *queue,
+     storage_media_buffer_t **buffer,
+     libcerror_error_t **error );
+
+int storage_media_buffer_queue_try_push(
+     storage_media_buffer_queue_t *queue,
+     storage_media_buffer_t *buffer,
+     libcerror_error_t **error );
+
+int storage_media_buffer_queue_try_grab(
+     storage_media_buffer_queue_t *queue,
+     storage_media_buffer_t **buffer,
      libcerror_error_t **error );
 
 int storage_media_buffer_queue_grab_buffer(
-     libcthreads_queue_t *queue,
+     storage_media_buffer_queue_t *queue,
      storage_media_buffer_t **buffer,
      libcerror_error_t **error );
 
 int storage_media_buffer_queue_release_buffer(
-     libcthreads_queue_t *queue,
+     storage_media_buffer_queue_t *queue,
      storage_media_buffer_t *buffer,
      libcerror_error_t **error );
 
+int storage_media_buffer_queue_get_number_of_buffers_in_use(
+     storage_media_buffer_queue_t *queue,
+     int *number_of_buffers_in_use,
+     libcerror_error_t **error );
+
+int storage_media_buffer_queue_set_maximum_number_of_buffers_in_use(
+     storage_media_buffer_queue_t *queue,
+     int maximum_number_of_buffers_in_use,
+     libcerror_error_t **error );
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 #if defined( __cplusplus )
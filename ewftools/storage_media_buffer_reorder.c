@@ -0,0 +1,390 @@
+/*
+ * Storage media buffer reorder window
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_reorder.h"
+
+/* Creates a storage media buffer reorder window
+ * The number of slots must be at least the number of storage media buffers
+ * that can be in flight at the same time
+ * Make sure the value reorder is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_reorder_initialize(
+     storage_media_buffer_reorder_t **reorder,
+     int number_of_slots,
+     size_t storage_media_buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_reorder_initialize";
+
+	if( reorder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reorder window.",
+		 function );
+
+		return( -1 );
+	}
+	if( *reorder != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid reorder window value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_slots <= 0 )
+	 || ( (size_t) number_of_slots > ( (size_t) SSIZE_MAX / sizeof( storage_media_buffer_t * ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of slots value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid storage media buffer size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	*reorder = memory_allocate_structure(
+	            storage_media_buffer_reorder_t );
+
+	if( *reorder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create reorder window.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *reorder,
+	     0,
+	     sizeof( storage_media_buffer_reorder_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear reorder window.",
+		 function );
+
+		memory_free(
+		 *reorder );
+
+		*reorder = NULL;
+
+		return( -1 );
+	}
+	( *reorder )->slots = (storage_media_buffer_t **) memory_allocate(
+	                                                   sizeof( storage_media_buffer_t * ) * number_of_slots );
+
+	if( ( *reorder )->slots == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create slots.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *reorder )->slots,
+	     0,
+	     sizeof( storage_media_buffer_t * ) * number_of_slots ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear slots.",
+		 function );
+
+		goto on_error;
+	}
+	( *reorder )->number_of_slots           = number_of_slots;
+	( *reorder )->storage_media_buffer_size = storage_media_buffer_size;
+
+	return( 1 );
+
+on_error:
+	if( *reorder != NULL )
+	{
+		if( ( *reorder )->slots != NULL )
+		{
+			memory_free(
+			 ( *reorder )->slots );
+		}
+		memory_free(
+		 *reorder );
+
+		*reorder = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a storage media buffer reorder window
+ * The storage media buffers that remain in the window are freed
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_reorder_free(
+     storage_media_buffer_reorder_t **reorder,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_reorder_free";
+	int result            = 1;
+	int slot_index        = 0;
+
+	if( reorder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reorder window.",
+		 function );
+
+		return( -1 );
+	}
+	if( *reorder != NULL )
+	{
+		for( slot_index = 0;
+		     slot_index < ( *reorder )->number_of_slots;
+		     slot_index++ )
+		{
+			if( ( *reorder )->slots[ slot_index ] == NULL )
+			{
+				continue;
+			}
+			if( storage_media_buffer_free(
+			     &( ( *reorder )->slots[ slot_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free storage media buffer: %d.",
+				 function,
+				 slot_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 ( *reorder )->slots );
+
+		memory_free(
+		 *reorder );
+
+		*reorder = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the slot index of a storage media offset
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_reorder_get_slot_index(
+     storage_media_buffer_reorder_t *reorder,
+     off64_t storage_media_offset,
+     int *slot_index,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_reorder_get_slot_index";
+
+	if( reorder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reorder window.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid storage media offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( slot_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid slot index.",
+		 function );
+
+		return( -1 );
+	}
+	/* Consecutive storage media buffers map onto consecutive slots
+	 */
+	*slot_index = (int) ( ( (uint64_t) storage_media_offset / reorder->storage_media_buffer_size ) % (uint64_t) reorder->number_of_slots );
+
+	return( 1 );
+}
+
+/* Inserts a storage media buffer into the reorder window
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_reorder_insert_buffer(
+     storage_media_buffer_reorder_t *reorder,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_reorder_insert_buffer";
+	int slot_index        = 0;
+
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer_reorder_get_slot_index(
+	     reorder,
+	     storage_media_buffer->storage_media_offset,
+	     &slot_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve slot index.",
+		 function );
+
+		return( -1 );
+	}
+	if( reorder->slots[ slot_index ] != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid reorder window - slot: %d for offset: %" PRIi64 " already set.",
+		 function,
+		 slot_index,
+		 storage_media_buffer->storage_media_offset );
+
+		return( -1 );
+	}
+	reorder->slots[ slot_index ] = storage_media_buffer;
+
+	reorder->number_of_buffers += 1;
+
+	return( 1 );
+}
+
+/* Removes the storage media buffer at a specific storage media offset from the reorder window
+ * Returns 1 if successful, 0 if the buffer is not (yet) available or -1 on error
+ */
+int storage_media_buffer_reorder_remove_buffer(
+     storage_media_buffer_reorder_t *reorder,
+     off64_t storage_media_offset,
+     storage_media_buffer_t **storage_media_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_reorder_remove_buffer";
+	int slot_index        = 0;
+
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer_reorder_get_slot_index(
+	     reorder,
+	     storage_media_offset,
+	     &slot_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve slot index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( reorder->slots[ slot_index ] == NULL )
+	 || ( reorder->slots[ slot_index ]->storage_media_offset != storage_media_offset ) )
+	{
+		return( 0 );
+	}
+	*storage_media_buffer = reorder->slots[ slot_index ];
+
+	reorder->slots[ slot_index ] = NULL;
+
+	reorder->number_of_buffers -= 1;
+
+	return( 1 );
+}
+
@@ -0,0 +1,92 @@
+/*
+ * Storage media buffer reorder window
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#if !defined( _STORAGE_MEDIA_BUFFER_REORDER_H )
+#define _STORAGE_MEDIA_BUFFER_REORDER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "storage_media_buffer.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct storage_media_buffer_reorder storage_media_buffer_reorder_t;
+
+/* A window of storage media buffers indexed by their storage media offset
+ * used to bring buffers that were processed out of order back in order
+ */
+struct storage_media_buffer_reorder
+{
+	/* The slots
+	 */
+	storage_media_buffer_t **slots;
+
+	/* The number of slots
+	 */
+	int number_of_slots;
+
+	/* The storage media buffer size, which determines the slot of a buffer
+	 */
+	size_t storage_media_buffer_size;
+
+	/* The number of storage media buffers in the window
+	 */
+	int number_of_buffers;
+};
+
+int storage_media_buffer_reorder_initialize(
+     storage_media_buffer_reorder_t **reorder,
+     int number_of_slots,
+     size_t storage_media_buffer_size,
+     libcerror_error_t **error );
+
+int storage_media_buffer_reorder_free(
+     storage_media_buffer_reorder_t **reorder,
+     libcerror_error_t **error );
+
+int storage_media_buffer_reorder_get_slot_index(
+     storage_media_buffer_reorder_t *reorder,
+     off64_t storage_media_offset,
+     int *slot_index,
+     libcerror_error_t **error );
+
+int storage_media_buffer_reorder_insert_buffer(
+     storage_media_buffer_reorder_t *reorder,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
+int storage_media_buffer_reorder_remove_buffer(
+     storage_media_buffer_reorder_t *reorder,
+     off64_t storage_media_offset,
+     storage_media_buffer_t **storage_media_buffer,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _STORAGE_MEDIA_BUFFER_REORDER_H ) */
+
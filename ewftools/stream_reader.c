@@ -0,0 +1,1020 @@
+/*
+ * Stream reader, reads ahead data from a file descriptor such as stdin
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H ) || defined( WINAPI )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_IO_H ) || defined( WINAPI )
+#include <io.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+#include "stream_reader.h"
+
+/* Grows the pipe buffer of the file descriptor
+ * Larger pipe buffers allow the writer of the pipe to continue while the data is processed
+ * Returns 1 if successful, 0 if not supported or -1 on error
+ */
+int stream_reader_set_pipe_size(
+     int file_descriptor,
+     size_t pipe_size,
+     libcerror_error_t **error )
+{
+	static char *function = "stream_reader_set_pipe_size";
+
+#if defined( F_SETPIPE_SZ ) && defined( F_GETPIPE_SZ )
+	int current_pipe_size = 0;
+#endif
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( pipe_size > (size_t) STREAM_READER_MAXIMUM_PIPE_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid pipe size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( F_SETPIPE_SZ ) && defined( F_GETPIPE_SZ )
+	/* This fails if the file descriptor is not a pipe
+	 */
+	current_pipe_size = fcntl(
+	                     file_descriptor,
+	                     F_GETPIPE_SZ );
+
+	if( current_pipe_size <= 0 )
+	{
+		return( 0 );
+	}
+	/* Without privileges the pipe size is limited by /proc/sys/fs/pipe-max-size
+	 */
+	while( pipe_size > (size_t) current_pipe_size )
+	{
+		if( fcntl(
+		     file_descriptor,
+		     F_SETPIPE_SZ,
+		     (int) pipe_size ) != -1 )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: pipe size: %" PRIzd ".\n",
+				 function,
+				 pipe_size );
+			}
+#endif
+			return( 1 );
+		}
+		if( errno != EPERM )
+		{
+			break;
+		}
+		pipe_size /= 2;
+	}
+#endif /* defined( F_SETPIPE_SZ ) && defined( F_GETPIPE_SZ ) */
+
+	return( 0 );
+}
+
+/* Reads a buffer of data from the file descriptor
+ * Reads until the buffer is filled or the end of the input is reached, since a
+ * pipe can return less data than requested
+ * Returns the number of bytes read, 0 if at end of input or -1 on error
+ */
+ssize_t stream_reader_read_buffer(
+         int file_descriptor,
+         storage_media_buffer_t *storage_media_buffer,
+         off64_t storage_media_offset,
+         size_t read_size,
+         uint8_t read_error_retries,
+         libcerror_error_t **error )
+{
+	static char *function         = "stream_reader_read_buffer";
+	size_t buffer_offset          = 0;
+	ssize_t read_count            = 0;
+	int32_t read_number_of_errors = 0;
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_size == 0 )
+	 || ( read_size > storage_media_buffer->raw_buffer_size )
+	 || ( read_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < read_size )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: reading buffer at offset: 0x%08" PRIx64 " of size: %" PRIzd ".\n",
+			 function,
+			 storage_media_offset + (off64_t) buffer_offset,
+			 read_size - buffer_offset );
+		}
+#endif
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+		read_count = _read(
+		              file_descriptor,
+		              &( ( storage_media_buffer->raw_buffer )[ buffer_offset ] ),
+		              (unsigned int) ( read_size - buffer_offset ) );
+#else
+		read_count = read(
+		              file_descriptor,
+		              &( ( storage_media_buffer->raw_buffer )[ buffer_offset ] ),
+		              read_size - buffer_offset );
+#endif
+		if( read_count < 0 )
+		{
+			if( ( errno == ESPIPE )
+			 || ( errno == EPERM )
+			 || ( errno == ENXIO )
+			 || ( errno == ENODEV ) )
+			{
+				if( errno == ESPIPE )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: error reading data: invalid seek.",
+					 function );
+				}
+				else if( errno == EPERM )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: error reading data: operation not permitted.",
+					 function );
+				}
+				else if( errno == ENXIO )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: error reading data: no such device or address.",
+					 function );
+				}
+				else
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: error reading data: no such device.",
+					 function );
+				}
+				return( -1 );
+			}
+			/* An interrupted read is not a read error
+			 */
+			if( errno == EINTR )
+			{
+				continue;
+			}
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: read error at offset: 0x%08" PRIx64 ".\n",
+				 function,
+				 storage_media_offset + (off64_t) buffer_offset );
+			}
+#endif
+			read_number_of_errors++;
+
+			if( read_number_of_errors > (int32_t) read_error_retries )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 errno,
+				 "%s: error reading data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		/* No bytes were read
+		 */
+		else if( read_count == 0 )
+		{
+			break;
+		}
+		else
+		{
+			buffer_offset += (size_t) read_count;
+		}
+	}
+	storage_media_buffer->storage_media_offset = storage_media_offset;
+	storage_media_buffer->requested_size       = read_size;
+	storage_media_buffer->raw_buffer_data_size = buffer_offset;
+
+	return( (ssize_t) buffer_offset );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a stream reader and starts the read thread
+ * Make sure the value stream_reader is referencing, is set to NULL
+ * The storage media buffers are grabbed from the storage media buffer queue
+ * An acquiry size of 0 represents reading until the end of the input
+ * Returns 1 if successful or -1 on error
+ */
+int stream_reader_initialize(
+     stream_reader_t **stream_reader,
+     int file_descriptor,
+     storage_media_buffer_queue_t *storage_media_buffer_queue,
+     size_t process_buffer_size,
+     size64_t acquiry_offset,
+     size64_t acquiry_size,
+     uint8_t read_error_retries,
+     int maximum_number_of_buffers,
+     libcerror_error_t **error )
+{
+	static char *function = "stream_reader_initialize";
+
+	if( stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *stream_reader != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid stream reader value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( process_buffer_size == 0 )
+	 || ( process_buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid process buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_buffers <= 0 )
+	 || ( maximum_number_of_buffers > STREAM_READER_MAXIMUM_NUMBER_OF_BUFFERS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of buffers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*stream_reader = memory_allocate_structure(
+	                  stream_reader_t );
+
+	if( *stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create stream reader.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *stream_reader,
+	     0,
+	     sizeof( stream_reader_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear stream reader.",
+		 function );
+
+		memory_free(
+		 *stream_reader );
+
+		*stream_reader = NULL;
+
+		return( -1 );
+	}
+	( *stream_reader )->file_descriptor            = file_descriptor;
+	( *stream_reader )->storage_media_buffer_queue = storage_media_buffer_queue;
+	( *stream_reader )->process_buffer_size        = process_buffer_size;
+	( *stream_reader )->skip_size                  = acquiry_offset;
+	( *stream_reader )->remaining_size             = acquiry_size;
+	( *stream_reader )->has_acquiry_size           = (uint8_t) ( acquiry_size != 0 );
+	( *stream_reader )->read_error_retries         = read_error_retries;
+	( *stream_reader )->maximum_number_of_buffers  = maximum_number_of_buffers;
+
+	if( libcthreads_mutex_initialize(
+	     &( ( *stream_reader )->state_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create state mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *stream_reader )->state_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create state condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_create(
+	     &( ( *stream_reader )->read_thread ),
+	     NULL,
+	     (int (*)(void *)) &stream_reader_read_thread_start_function,
+	     (void *) *stream_reader,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read thread.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *stream_reader != NULL )
+	{
+		if( ( *stream_reader )->state_condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *stream_reader )->state_condition ),
+			 NULL );
+		}
+		if( ( *stream_reader )->state_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *stream_reader )->state_mutex ),
+			 NULL );
+		}
+		memory_free(
+		 *stream_reader );
+
+		*stream_reader = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a stream reader
+ * Stops the read thread and releases the storage media buffers that were not retrieved
+ * The read thread stops after its current read, which blocks until the input provides data
+ * Returns 1 if successful or -1 on error
+ */
+int stream_reader_free(
+     stream_reader_t **stream_reader,
+     libcerror_error_t **error )
+{
+	static char *function = "stream_reader_free";
+	int buffer_index      = 0;
+	int result            = 1;
+
+	if( stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *stream_reader != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     ( *stream_reader )->state_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab state mutex.",
+			 function );
+
+			return( -1 );
+		}
+		( *stream_reader )->abort = 1;
+
+		/* Releasing the buffers allows a read thread waiting for a buffer to continue
+		 */
+		while( ( *stream_reader )->number_of_buffers > 0 )
+		{
+			buffer_index = ( *stream_reader )->first_buffer_index;
+
+			if( storage_media_buffer_queue_release_buffer(
+			     ( *stream_reader )->storage_media_buffer_queue,
+			     ( *stream_reader )->buffers[ buffer_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release storage media buffer: %d.",
+				 function,
+				 buffer_index );
+
+				result = -1;
+			}
+			( *stream_reader )->buffers[ buffer_index ] = NULL;
+
+			( *stream_reader )->first_buffer_index = ( buffer_index + 1 ) % STREAM_READER_MAXIMUM_NUMBER_OF_BUFFERS;
+
+			( *stream_reader )->number_of_buffers -= 1;
+		}
+		if( libcthreads_condition_broadcast(
+		     ( *stream_reader )->state_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast state condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_release(
+		     ( *stream_reader )->state_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release state mutex.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcthreads_thread_join(
+		     &( ( *stream_reader )->read_thread ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join read thread.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *stream_reader )->read_error != NULL )
+		{
+			libcerror_error_free(
+			 &( ( *stream_reader )->read_error ) );
+		}
+		if( libcthreads_condition_free(
+		     &( ( *stream_reader )->state_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free state condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *stream_reader )->state_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free state mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *stream_reader );
+
+		*stream_reader = NULL;
+	}
+	return( result );
+}
+
+/* Reads the input ahead into storage media buffers
+ * The sizes of the reads align with the acquiry offset and stop at the acquiry size
+ * Returns 1 if successful or -1 on error
+ */
+int stream_reader_read_thread_start_function(
+     stream_reader_t *stream_reader )
+{
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	libcerror_error_t *error                     = NULL;
+	static char *function                        = "stream_reader_read_thread_start_function";
+	size_t read_size                             = 0;
+	ssize_t read_count                           = 0;
+	int buffer_index                             = 0;
+	int result                                   = 1;
+
+	if( stream_reader == NULL )
+	{
+		return( -1 );
+	}
+	while( result == 1 )
+	{
+		if( libcthreads_mutex_grab(
+		     stream_reader->state_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab state mutex.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		while( ( stream_reader->number_of_buffers >= stream_reader->maximum_number_of_buffers )
+		    && ( stream_reader->abort == 0 ) )
+		{
+			if( libcthreads_condition_wait(
+			     stream_reader->state_condition,
+			     stream_reader->state_mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to wait for state condition.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+		}
+		if( ( result != 1 )
+		 || ( stream_reader->abort != 0 ) )
+		{
+			libcthreads_mutex_release(
+			 stream_reader->state_mutex,
+			 NULL );
+
+			break;
+		}
+		if( libcthreads_mutex_release(
+		     stream_reader->state_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release state mutex.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		read_size = stream_reader->process_buffer_size;
+
+		/* Align with acquiry offset if necessary
+		 */
+		if( ( stream_reader->skip_size > 0 )
+		 && ( stream_reader->skip_size < (size64_t) read_size ) )
+		{
+			read_size = (size_t) stream_reader->skip_size;
+		}
+		else if( ( stream_reader->skip_size == 0 )
+		      && ( stream_reader->has_acquiry_size != 0 )
+		      && ( stream_reader->remaining_size < (size64_t) read_size ) )
+		{
+			read_size = (size_t) stream_reader->remaining_size;
+		}
+		read_count = 0;
+
+		if( read_size > 0 )
+		{
+			if( storage_media_buffer_queue_grab_buffer(
+			     stream_reader->storage_media_buffer_queue,
+			     &storage_media_buffer,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to grab storage media buffer from queue.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+			read_count = stream_reader_read_buffer(
+			              stream_reader->file_descriptor,
+			              storage_media_buffer,
+			              stream_reader->storage_media_offset,
+			              read_size,
+			              stream_reader->read_error_retries,
+			              &error );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read buffer at offset: %" PRIi64 ".",
+				 function,
+				 stream_reader->storage_media_offset );
+
+				result = -1;
+
+				break;
+			}
+		}
+		if( read_count == 0 )
+		{
+			break;
+		}
+		stream_reader->storage_media_offset += (off64_t) read_count;
+
+		if( stream_reader->skip_size > 0 )
+		{
+			stream_reader->skip_size -= (size64_t) read_count;
+		}
+		else if( stream_reader->has_acquiry_size != 0 )
+		{
+			stream_reader->remaining_size -= (size64_t) read_count;
+		}
+		if( libcthreads_mutex_grab(
+		     stream_reader->state_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab state mutex.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		buffer_index = ( stream_reader->first_buffer_index + stream_reader->number_of_buffers ) % STREAM_READER_MAXIMUM_NUMBER_OF_BUFFERS;
+
+		stream_reader->buffers[ buffer_index ] = storage_media_buffer;
+		stream_reader->number_of_buffers      += 1;
+
+		storage_media_buffer = NULL;
+
+		if( libcthreads_condition_broadcast(
+		     stream_reader->state_condition,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast state condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_release(
+		     stream_reader->state_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release state mutex.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( storage_media_buffer != NULL )
+	{
+		storage_media_buffer_queue_release_buffer(
+		 stream_reader->storage_media_buffer_queue,
+		 storage_media_buffer,
+		 NULL );
+	}
+	/* Signal the end of the input, the error is passed on by stream_reader_get_buffer
+	 */
+	if( libcthreads_mutex_grab(
+	     stream_reader->state_mutex,
+	     NULL ) != 1 )
+	{
+		if( error != NULL )
+		{
+			libcerror_error_free(
+			 &error );
+		}
+		return( -1 );
+	}
+	stream_reader->end_of_input = 1;
+	stream_reader->read_error   = error;
+
+	libcthreads_condition_broadcast(
+	 stream_reader->state_condition,
+	 NULL );
+
+	libcthreads_mutex_release(
+	 stream_reader->state_mutex,
+	 NULL );
+
+	return( result );
+}
+
+/* Retrieves the next storage media buffer that was read
+ * The storage media buffer is owned by the caller and must be released to the queue
+ * Returns the number of bytes read, 0 if at end of input or -1 on error
+ */
+ssize_t stream_reader_get_buffer(
+         stream_reader_t *stream_reader,
+         storage_media_buffer_t **storage_media_buffer,
+         libcerror_error_t **error )
+{
+	static char *function = "stream_reader_get_buffer";
+	ssize_t read_count    = 0;
+	int buffer_index      = 0;
+
+	if( stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     stream_reader->state_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab state mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( stream_reader->number_of_buffers == 0 )
+	    && ( stream_reader->end_of_input == 0 ) )
+	{
+		if( libcthreads_condition_wait(
+		     stream_reader->state_condition,
+		     stream_reader->state_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for state condition.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	*storage_media_buffer = NULL;
+
+	if( stream_reader->number_of_buffers > 0 )
+	{
+		buffer_index = stream_reader->first_buffer_index;
+
+		*storage_media_buffer = stream_reader->buffers[ buffer_index ];
+
+		stream_reader->buffers[ buffer_index ] = NULL;
+
+		stream_reader->first_buffer_index = ( buffer_index + 1 ) % STREAM_READER_MAXIMUM_NUMBER_OF_BUFFERS;
+
+		stream_reader->number_of_buffers -= 1;
+
+		read_count = (ssize_t) ( *storage_media_buffer )->raw_buffer_data_size;
+
+		if( libcthreads_condition_broadcast(
+		     stream_reader->state_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast state condition.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else if( stream_reader->read_error != NULL )
+	{
+		/* Pass on the error of the read thread
+		 */
+		if( error != NULL )
+		{
+			*error = stream_reader->read_error;
+		}
+		else
+		{
+			libcerror_error_free(
+			 &( stream_reader->read_error ) );
+		}
+		stream_reader->read_error = NULL;
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read input.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_release(
+	     stream_reader->state_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release state mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( read_count );
+
+on_error:
+	libcthreads_mutex_release(
+	 stream_reader->state_mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
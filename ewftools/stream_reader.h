@@ -0,0 +1,167 @@
+/*
+ * Stream reader, reads ahead data from a file descriptor such as stdin
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _STREAM_READER_H )
+#define _STREAM_READER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define STREAM_READER_MAXIMUM_NUMBER_OF_BUFFERS	16
+
+/* The size the pipe buffer is grown to, if permitted
+ */
+#define STREAM_READER_MAXIMUM_PIPE_SIZE		( 16 * 1024 * 1024 )
+
+typedef struct stream_reader stream_reader_t;
+
+struct stream_reader
+{
+	/* The file descriptor
+	 */
+	int file_descriptor;
+
+	/* The number of retries when a read error occurs
+	 */
+	uint8_t read_error_retries;
+
+	/* The process buffer size
+	 */
+	size_t process_buffer_size;
+
+	/* The number of bytes to read before the acquiry offset
+	 */
+	size64_t skip_size;
+
+	/* The number of bytes remaining to be read, if the acquiry size is known
+	 */
+	size64_t remaining_size;
+
+	/* Value to indicate the acquiry size is known
+	 */
+	uint8_t has_acquiry_size;
+
+	/* The offset of the next read
+	 */
+	off64_t storage_media_offset;
+
+	/* The buffers that were read, stored as a ring buffer in order of the stream
+	 */
+	storage_media_buffer_t *buffers[ STREAM_READER_MAXIMUM_NUMBER_OF_BUFFERS ];
+
+	/* The index of the first (oldest) buffer
+	 */
+	int first_buffer_index;
+
+	/* The number of buffers that were read and not yet retrieved
+	 */
+	int number_of_buffers;
+
+	/* The maximum number of buffers that are read ahead
+	 */
+	int maximum_number_of_buffers;
+
+	/* Value to indicate the end of the input was reached or reading failed
+	 */
+	uint8_t end_of_input;
+
+	/* The error of the read thread
+	 */
+	libcerror_error_t *read_error;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The storage media buffer queue
+	 */
+	storage_media_buffer_queue_t *storage_media_buffer_queue;
+
+	/* The read thread
+	 */
+	libcthreads_thread_t *read_thread;
+
+	/* The state mutex
+	 */
+	libcthreads_mutex_t *state_mutex;
+
+	/* The state condition
+	 */
+	libcthreads_condition_t *state_condition;
+#endif
+};
+
+int stream_reader_set_pipe_size(
+     int file_descriptor,
+     size_t pipe_size,
+     libcerror_error_t **error );
+
+ssize_t stream_reader_read_buffer(
+         int file_descriptor,
+         storage_media_buffer_t *storage_media_buffer,
+         off64_t storage_media_offset,
+         size_t read_size,
+         uint8_t read_error_retries,
+         libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int stream_reader_initialize(
+     stream_reader_t **stream_reader,
+     int file_descriptor,
+     storage_media_buffer_queue_t *storage_media_buffer_queue,
+     size_t process_buffer_size,
+     size64_t acquiry_offset,
+     size64_t acquiry_size,
+     uint8_t read_error_retries,
+     int maximum_number_of_buffers,
+     libcerror_error_t **error );
+
+int stream_reader_free(
+     stream_reader_t **stream_reader,
+     libcerror_error_t **error );
+
+int stream_reader_read_thread_start_function(
+     stream_reader_t *stream_reader );
+
+ssize_t stream_reader_get_buffer(
+         stream_reader_t *stream_reader,
+         storage_media_buffer_t **storage_media_buffer,
+         libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _STREAM_READER_H ) */
+
@@ -0,0 +1,1108 @@
+/*
+ * Verification batch
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_system_string.h"
+#include "log_handle.h"
+#include "verification_batch.h"
+#include "verification_handle.h"
+
+#define VERIFICATION_BATCH_MAXIMUM_NUMBER_OF_CONCURRENT_IMAGES	32
+
+/* Creates a verification batch
+ * Make sure the value verification_batch is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int verification_batch_initialize(
+     verification_batch_t **verification_batch,
+     verification_handle_t *settings_verification_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_batch_initialize";
+
+	if( verification_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( *verification_batch != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verification batch value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( settings_verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid settings verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	*verification_batch = memory_allocate_structure(
+	                       verification_batch_t );
+
+	if( *verification_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create verification batch.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *verification_batch,
+	     0,
+	     sizeof( verification_batch_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear verification batch.",
+		 function );
+
+		memory_free(
+		 *verification_batch );
+
+		*verification_batch = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *verification_batch )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	( *verification_batch )->maximum_number_of_concurrent_images = 2;
+#else
+	( *verification_batch )->maximum_number_of_concurrent_images = 1;
+#endif
+	( *verification_batch )->settings_verification_handle = settings_verification_handle;
+	( *verification_batch )->notify_stream                = settings_verification_handle->notify_stream;
+
+	return( 1 );
+
+on_error:
+	if( *verification_batch != NULL )
+	{
+		memory_free(
+		 *verification_batch );
+
+		*verification_batch = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a verification batch
+ * Returns 1 if successful or -1 on error
+ */
+int verification_batch_free(
+     verification_batch_t **verification_batch,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_batch_free";
+	int result            = 1;
+
+	if( verification_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( *verification_batch != NULL )
+	{
+		/* The settings_verification_handle and filenames references are freed elsewhere
+		 */
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *verification_batch )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( ( *verification_batch )->verification_handles != NULL )
+		{
+			memory_free(
+			 ( *verification_batch )->verification_handles );
+		}
+		memory_free(
+		 *verification_batch );
+
+		*verification_batch = NULL;
+	}
+	return( result );
+}
+
+/* Signals the verification batch to abort
+ * Returns 1 if successful or -1 on error
+ */
+int verification_batch_signal_abort(
+     verification_batch_t *verification_batch,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_batch_signal_abort";
+	int filename_index    = 0;
+	int result            = 1;
+
+	if( verification_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification batch.",
+		 function );
+
+		return( -1 );
+	}
+	verification_batch->abort = 1;
+
+	if( verification_batch->verification_handles != NULL )
+	{
+		for( filename_index = 0;
+		     filename_index < verification_batch->number_of_filenames;
+		     filename_index++ )
+		{
+			if( verification_batch->verification_handles[ filename_index ] == NULL )
+			{
+				continue;
+			}
+			if( verification_handle_signal_abort(
+			     verification_batch->verification_handles[ filename_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to signal verification handle: %d to abort.",
+				 function,
+				 filename_index );
+
+				result = -1;
+			}
+		}
+	}
+	return( result );
+}
+
+/* Sets the maximum number of concurrent images
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int verification_batch_set_maximum_number_of_concurrent_images(
+     verification_batch_t *verification_batch,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function                        = "verification_batch_set_maximum_number_of_concurrent_images";
+	size_t string_length                         = 0;
+	uint64_t maximum_number_of_concurrent_images = 0;
+	int result                                   = 0;
+
+	if( verification_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( string[ 0 ] != (system_character_t) '-' )
+	{
+		string_length = system_string_length(
+				 string );
+
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &maximum_number_of_concurrent_images,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine maximum number of concurrent images.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+
+		if( ( maximum_number_of_concurrent_images == 0 )
+		 || ( maximum_number_of_concurrent_images > VERIFICATION_BATCH_MAXIMUM_NUMBER_OF_CONCURRENT_IMAGES ) )
+		{
+			result = 0;
+		}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+		else if( maximum_number_of_concurrent_images > 1 )
+		{
+			result = 0;
+		}
+#endif
+		else
+		{
+			verification_batch->maximum_number_of_concurrent_images = (int) maximum_number_of_concurrent_images;
+		}
+	}
+	return( result );
+}
+
+/* Sets the maximum number of open handles, which is shared by all images
+ * Returns 1 if successful or -1 on error
+ */
+int verification_batch_set_maximum_number_of_open_handles(
+     verification_batch_t *verification_batch,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_batch_set_maximum_number_of_open_handles";
+
+	if( verification_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification batch.",
+		 function );
+
+		return( -1 );
+	}
+	verification_batch->maximum_number_of_open_handles = maximum_number_of_open_handles;
+
+	return( 1 );
+}
+
+/* Sets the zero chunk on error
+ * Returns 1 if successful or -1 on error
+ */
+int verification_batch_set_zero_chunk_on_error(
+     verification_batch_t *verification_batch,
+     uint8_t zero_chunk_on_error,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_batch_set_zero_chunk_on_error";
+
+	if( verification_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification batch.",
+		 function );
+
+		return( -1 );
+	}
+	verification_batch->zero_chunk_on_error = zero_chunk_on_error;
+
+	return( 1 );
+}
+
+/* Verifies a single image of the batch
+ * The output of the verification is captured and printed when the image has been verified,
+ * so that the output of concurrently verified images is not interleaved
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int verification_batch_verify_image(
+     verification_batch_t *verification_batch,
+     int filename_index,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	uint8_t copy_buffer[ 4096 ];
+
+	libcerror_error_t *image_error             = NULL;
+	verification_handle_t *verification_handle = NULL;
+	FILE *capture_stream                       = NULL;
+	static char *function                      = "verification_batch_verify_image";
+	size_t read_count                          = 0;
+	int maximum_number_of_open_handles         = 0;
+	int result                                 = 0;
+
+	if( verification_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( filename_index < 0 )
+	 || ( filename_index >= verification_batch->number_of_filenames ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	capture_stream = tmpfile();
+
+	if( capture_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to create capture stream.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle_initialize(
+	     &verification_handle,
+	     verification_batch->settings_verification_handle->calculate_md5,
+	     verification_batch->settings_verification_handle->use_chunk_data_functions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create verification handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle_copy_settings(
+	     verification_handle,
+	     verification_batch->settings_verification_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to copy settings to verification handle.",
+		 function );
+
+		goto on_error;
+	}
+	verification_handle->number_of_threads = number_of_threads;
+	verification_handle->notify_stream     = capture_stream;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( verification_batch->process_thread_pool != NULL )
+	 && ( number_of_threads != 0 ) )
+	{
+		if( verification_handle_set_shared_process_thread_pool(
+		     verification_handle,
+		     verification_batch->process_thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set shared process thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+
+	if( verification_batch->maximum_number_of_open_handles > 0 )
+	{
+		maximum_number_of_open_handles = verification_batch->maximum_number_of_open_handles
+		                               / verification_batch->maximum_number_of_concurrent_images;
+
+		if( maximum_number_of_open_handles == 0 )
+		{
+			maximum_number_of_open_handles = 1;
+		}
+		if( verification_handle_set_maximum_number_of_open_handles(
+		     verification_handle,
+		     maximum_number_of_open_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	verification_batch->verification_handles[ filename_index ] = verification_handle;
+
+	if( verification_batch->abort != 0 )
+	{
+		result = 0;
+	}
+	else
+	{
+		result = verification_handle_open_input(
+		          verification_handle,
+		          &( verification_batch->filenames[ filename_index ] ),
+		          1,
+		          &image_error );
+
+		if( result != 1 )
+		{
+			fprintf(
+			 capture_stream,
+			 "Unable to open EWF image file(s).\n" );
+
+			result = 0;
+		}
+		else
+		{
+			if( verification_handle_set_zero_chunk_on_error(
+			     verification_handle,
+			     verification_batch->zero_chunk_on_error,
+			     &image_error ) != 1 )
+			{
+				fprintf(
+				 capture_stream,
+				 "Unable to set zero on chunk error.\n" );
+
+				result = 0;
+			}
+			else
+			{
+				result = verification_handle_verify_input(
+				          verification_handle,
+				          0,
+				          NULL,
+				          &image_error );
+
+				if( result == -1 )
+				{
+					fprintf(
+					 capture_stream,
+					 "Unable to verify input.\n" );
+
+					result = 0;
+				}
+			}
+			if( verification_handle_close(
+			     verification_handle,
+			     NULL ) != 0 )
+			{
+				fprintf(
+				 capture_stream,
+				 "Unable to close verification handle.\n" );
+
+				result = 0;
+			}
+		}
+		if( image_error != NULL )
+		{
+			libcnotify_print_error_backtrace(
+			 image_error );
+			libcerror_error_free(
+			 &image_error );
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     verification_batch->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	verification_batch->verification_handles[ filename_index ] = NULL;
+
+	if( result != 1 )
+	{
+		verification_batch->number_of_failed_images += 1;
+	}
+	/* Stream the result of the image as soon as it is available
+	 */
+	fprintf(
+	 verification_batch->notify_stream,
+	 "Image: %" PRIs_SYSTEM "\n\n",
+	 verification_batch->filenames[ filename_index ] );
+
+	if( verification_batch->log_handle != NULL )
+	{
+		fprintf(
+		 verification_batch->log_handle->log_stream,
+		 "Image: %" PRIs_SYSTEM "\n\n",
+		 verification_batch->filenames[ filename_index ] );
+	}
+	rewind(
+	 capture_stream );
+
+	do
+	{
+		read_count = fread(
+		              copy_buffer,
+		              1,
+		              4096,
+		              capture_stream );
+
+		if( read_count > 0 )
+		{
+			fwrite(
+			 copy_buffer,
+			 1,
+			 read_count,
+			 verification_batch->notify_stream );
+
+			if( verification_batch->log_handle != NULL )
+			{
+				fwrite(
+				 copy_buffer,
+				 1,
+				 read_count,
+				 verification_batch->log_handle->log_stream );
+			}
+		}
+	}
+	while( read_count > 0 );
+
+	fprintf(
+	 verification_batch->notify_stream,
+	 "%" PRIs_SYSTEM ": %s\n\n",
+	 verification_batch->filenames[ filename_index ],
+	 ( result == 1 ) ? "SUCCESS" : "FAILURE" );
+
+	if( verification_batch->log_handle != NULL )
+	{
+		fprintf(
+		 verification_batch->log_handle->log_stream,
+		 "%" PRIs_SYSTEM ": %s\n\n",
+		 verification_batch->filenames[ filename_index ],
+		 ( result == 1 ) ? "SUCCESS" : "FAILURE" );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     verification_batch->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( verification_handle_free(
+	     &verification_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free verification handle.",
+		 function );
+
+		goto on_error;
+	}
+	fclose(
+	 capture_stream );
+
+	return( result );
+
+on_error:
+	if( verification_handle != NULL )
+	{
+		verification_batch->verification_handles[ filename_index ] = NULL;
+
+		verification_handle_free(
+		 &verification_handle,
+		 NULL );
+	}
+	if( capture_stream != NULL )
+	{
+		fclose(
+		 capture_stream );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The verification batch thread start function
+ * Verifies images until all images of the batch have been verified
+ * Returns 1 if successful or -1 on error
+ */
+int verification_batch_thread_start_function(
+     verification_batch_t *verification_batch )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "verification_batch_thread_start_function";
+	int filename_index       = 0;
+
+	if( verification_batch == NULL )
+	{
+		return( -1 );
+	}
+	while( verification_batch->abort == 0 )
+	{
+		if( libcthreads_mutex_grab(
+		     verification_batch->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		filename_index = verification_batch->next_filename_index;
+
+		if( filename_index < verification_batch->number_of_filenames )
+		{
+			verification_batch->next_filename_index += 1;
+		}
+		if( libcthreads_mutex_release(
+		     verification_batch->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( filename_index >= verification_batch->number_of_filenames )
+		{
+			break;
+		}
+		/* The images share the process thread pool, which balances the processing
+		 * jobs over the images that are verified and hands the threads of finished
+		 * images to the images that are still being verified
+		 */
+		if( verification_batch_verify_image(
+		     verification_batch,
+		     filename_index,
+		     verification_batch->settings_verification_handle->number_of_threads,
+		     &error ) == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to verify image: %d.",
+			 function,
+			 filename_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Verifies the images of the batch
+ * Every filename is the first segment file of an image
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int verification_batch_verify_images(
+     verification_batch_t *verification_batch,
+     system_character_t * const *filenames,
+     int number_of_filenames,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_t **threads     = NULL;
+	int maximum_number_of_queued_items = 0;
+	int number_of_threads              = 0;
+	int thread_index                   = 0;
+#endif
+
+	static char *function              = "verification_batch_verify_images";
+	size_t handles_size                = 0;
+	int filename_index                 = 0;
+	int result                         = 1;
+
+	if( verification_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_batch->verification_handles != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verification batch - verification handles value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_filenames <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of filenames.",
+		 function );
+
+		return( -1 );
+	}
+	handles_size = sizeof( verification_handle_t * ) * number_of_filenames;
+
+	verification_batch->verification_handles = (verification_handle_t **) memory_allocate(
+	                                                                        handles_size );
+
+	if( verification_batch->verification_handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create verification handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     verification_batch->verification_handles,
+	     0,
+	     handles_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear verification handles.",
+		 function );
+
+		goto on_error;
+	}
+	verification_batch->filenames               = filenames;
+	verification_batch->number_of_filenames     = number_of_filenames;
+	verification_batch->next_filename_index     = 0;
+	verification_batch->number_of_failed_images = 0;
+	verification_batch->log_handle              = log_handle;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	number_of_threads = verification_batch->maximum_number_of_concurrent_images;
+
+	if( number_of_threads > number_of_filenames )
+	{
+		number_of_threads = number_of_filenames;
+	}
+	if( ( number_of_threads > 1 )
+	 && ( verification_batch->settings_verification_handle->number_of_threads != 0 ) )
+	{
+		/* A single process thread pool is shared by the images, instead of a pool
+		 * per image, so that the number of processing jobs does not depend on
+		 * the number of images that are verified concurrently
+		 */
+		maximum_number_of_queued_items = verification_batch->settings_verification_handle->number_of_threads
+		                               * number_of_threads
+		                               * VERIFICATION_BATCH_NUMBER_OF_QUEUED_BUFFERS_PER_THREAD;
+
+		if( libcthreads_thread_pool_create(
+		     &( verification_batch->process_thread_pool ),
+		     NULL,
+		     verification_batch->settings_verification_handle->number_of_threads,
+		     maximum_number_of_queued_items,
+		     (int (*)(intptr_t *, void *)) &verification_handle_shared_process_storage_media_buffer_callback,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize process thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( number_of_threads > 1 )
+	{
+		threads = (libcthreads_thread_t **) memory_allocate(
+		                                     sizeof( libcthreads_thread_t * ) * number_of_threads );
+
+		if( threads == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create threads.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     threads,
+		     0,
+		     sizeof( libcthreads_thread_t * ) * number_of_threads ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear threads.",
+			 function );
+
+			goto on_error;
+		}
+		for( thread_index = 0;
+		     thread_index < number_of_threads;
+		     thread_index++ )
+		{
+			if( libcthreads_thread_create(
+			     &( threads[ thread_index ] ),
+			     NULL,
+			     (int (*)(void *)) &verification_batch_thread_start_function,
+			     (void *) verification_batch,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create thread: %d.",
+				 function,
+				 thread_index );
+
+				goto on_error;
+			}
+		}
+		for( thread_index = 0;
+		     thread_index < number_of_threads;
+		     thread_index++ )
+		{
+			if( libcthreads_thread_join(
+			     &( threads[ thread_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread: %d.",
+				 function,
+				 thread_index );
+
+				goto on_error;
+			}
+		}
+		memory_free(
+		 threads );
+
+		threads = NULL;
+
+		if( verification_batch->process_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( verification_batch->process_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join process thread pool.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	else
+#endif
+	{
+		for( filename_index = 0;
+		     filename_index < number_of_filenames;
+		     filename_index++ )
+		{
+			if( verification_batch->abort != 0 )
+			{
+				break;
+			}
+			if( verification_batch_verify_image(
+			     verification_batch,
+			     filename_index,
+			     verification_batch->settings_verification_handle->number_of_threads,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to verify image: %d.",
+				 function,
+				 filename_index );
+
+				goto on_error;
+			}
+		}
+	}
+	if( ( verification_batch->abort != 0 )
+	 || ( verification_batch->number_of_failed_images != 0 ) )
+	{
+		result = 0;
+	}
+	memory_free(
+	 verification_batch->verification_handles );
+
+	verification_batch->verification_handles = NULL;
+
+	return( result );
+
+on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( threads != NULL )
+	{
+		verification_batch->abort = 1;
+
+		for( thread_index = 0;
+		     thread_index < number_of_threads;
+		     thread_index++ )
+		{
+			if( threads[ thread_index ] != NULL )
+			{
+				libcthreads_thread_join(
+				 &( threads[ thread_index ] ),
+				 NULL );
+			}
+		}
+		memory_free(
+		 threads );
+	}
+	if( verification_batch->process_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( verification_batch->process_thread_pool ),
+		 NULL );
+	}
+#endif
+	if( verification_batch->verification_handles != NULL )
+	{
+		memory_free(
+		 verification_batch->verification_handles );
+
+		verification_batch->verification_handles = NULL;
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,159 @@
+/*
+ * Verification batch
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _VERIFICATION_BATCH_H )
+#define _VERIFICATION_BATCH_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "log_handle.h"
+#include "verification_handle.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The number of storage media buffers per process thread that can be queued
+ * on the process thread pool shared by the images
+ */
+#define VERIFICATION_BATCH_NUMBER_OF_QUEUED_BUFFERS_PER_THREAD	8
+
+typedef struct verification_batch verification_batch_t;
+
+struct verification_batch
+{
+	/* The verification handle that contains the settings used to verify every image
+	 */
+	verification_handle_t *settings_verification_handle;
+
+	/* The maximum number of images that are verified concurrently
+	 */
+	int maximum_number_of_concurrent_images;
+
+	/* The maximum number of open handles, shared by all images
+	 */
+	int maximum_number_of_open_handles;
+
+	/* Value to indicate if the chunk should be zeroed on error
+	 */
+	uint8_t zero_chunk_on_error;
+
+	/* The filenames, where every filename is the first segment file of an image
+	 */
+	system_character_t * const *filenames;
+
+	/* The number of filenames
+	 */
+	int number_of_filenames;
+
+	/* The index of the next filename to verify
+	 */
+	int next_filename_index;
+
+	/* The number of images that failed to verify
+	 */
+	int number_of_failed_images;
+
+	/* The verification handles of the images that are being verified
+	 */
+	verification_handle_t **verification_handles;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The mutex that protects the values of the batch and the output
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The process thread pool shared by the images that are verified concurrently
+	 */
+	libcthreads_thread_pool_t *process_thread_pool;
+#endif
+
+	/* The log handle
+	 */
+	log_handle_t *log_handle;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int verification_batch_initialize(
+     verification_batch_t **verification_batch,
+     verification_handle_t *settings_verification_handle,
+     libcerror_error_t **error );
+
+int verification_batch_free(
+     verification_batch_t **verification_batch,
+     libcerror_error_t **error );
+
+int verification_batch_signal_abort(
+     verification_batch_t *verification_batch,
+     libcerror_error_t **error );
+
+int verification_batch_set_maximum_number_of_concurrent_images(
+     verification_batch_t *verification_batch,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int verification_batch_set_maximum_number_of_open_handles(
+     verification_batch_t *verification_batch,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error );
+
+int verification_batch_set_zero_chunk_on_error(
+     verification_batch_t *verification_batch,
+     uint8_t zero_chunk_on_error,
+     libcerror_error_t **error );
+
+int verification_batch_verify_image(
+     verification_batch_t *verification_batch,
+     int filename_index,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int verification_batch_thread_start_function(
+     verification_batch_t *verification_batch );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+int verification_batch_verify_images(
+     verification_batch_t *verification_batch,
+     system_character_t * const *filenames,
+     int number_of_filenames,
+     log_handle_t *log_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _VERIFICATION_BATCH_H ) */
+
@@ -26,8 +26,18 @@
 #include <types.h>
 #include <wide_string.h>
 
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
 #include "byte_size_string.h"
 #include "digest_hash.h"
+#include "digest_hash_thread.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
 #include "ewftools_libcdata.h"
@@ -39,10 +49,13 @@
 #include "ewftools_libewf.h"
 #include "ewftools_libhmac.h"
 #include "ewftools_system_string.h"
+#include "ewftools_unused.h"
 #include "log_handle.h"
+#include "platform.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "storage_media_buffer_reorder.h"
 #include "verification_handle.h"
 
 #define VERIFICATION_HANDLE_VALUE_SIZE			64
@@ -289,6 +302,54 @@ int verification_handle_free(
 
 			result = -1;
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( digest_hash_thread_free_additional(
+		     &( ( *verification_handle )->sha1_hash_thread ),
+		     &( ( *verification_handle )->sha256_hash_thread ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free additional digest hash threads.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *verification_handle )->shared_process_jobs_condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( ( *verification_handle )->shared_process_jobs_condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free shared process jobs condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *verification_handle )->shared_process_jobs_mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *verification_handle )->shared_process_jobs_mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free shared process jobs mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		if( ( *verification_handle )->md5_context != NULL )
 		{
 			if( libhmac_md5_free(
@@ -451,6 +512,106 @@ int verification_handle_set_maximum_number_of_open_handles(
 
 		return( -1 );
 	}
+	verification_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+
+	return( 1 );
+}
+
+/* Copies the verification settings of the source to the destination verification handle
+ * The destination verification handle should be initialized with the same calculate MD5
+ * and use chunk data functions values as the source
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_copy_settings(
+     verification_handle_t *destination_verification_handle,
+     verification_handle_t *source_verification_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_copy_settings";
+
+	if( destination_verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( destination_verification_handle->calculate_md5 != source_verification_handle->calculate_md5 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid destination verification handle - calculate MD5 value does not match source.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( source_verification_handle->calculate_sha1 != 0 )
+	 && ( destination_verification_handle->calculate_sha1 == 0 ) )
+	{
+		destination_verification_handle->calculated_sha1_hash_string = system_string_allocate(
+		                                                                41 );
+
+		if( destination_verification_handle->calculated_sha1_hash_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create calculated SHA1 digest hash string.",
+			 function );
+
+			return( -1 );
+		}
+		destination_verification_handle->calculate_sha1 = 1;
+	}
+	if( ( source_verification_handle->calculate_sha256 != 0 )
+	 && ( destination_verification_handle->calculate_sha256 == 0 ) )
+	{
+		destination_verification_handle->calculated_sha256_hash_string = system_string_allocate(
+		                                                                  65 );
+
+		if( destination_verification_handle->calculated_sha256_hash_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create calculated SHA256 digest hash string.",
+			 function );
+
+			return( -1 );
+		}
+		destination_verification_handle->calculate_sha256 = 1;
+	}
+	destination_verification_handle->input_format             = source_verification_handle->input_format;
+	destination_verification_handle->header_codepage          = source_verification_handle->header_codepage;
+	destination_verification_handle->use_chunk_data_functions = source_verification_handle->use_chunk_data_functions;
+	destination_verification_handle->verify_chunks_only       = source_verification_handle->verify_chunks_only;
+	destination_verification_handle->sample_method            = source_verification_handle->sample_method;
+	destination_verification_handle->sample_size              = source_verification_handle->sample_size;
+	destination_verification_handle->sample_seed              = source_verification_handle->sample_seed;
+	destination_verification_handle->sample_seed_set          = source_verification_handle->sample_seed_set;
+	destination_verification_handle->process_buffer_size      = source_verification_handle->process_buffer_size;
+	destination_verification_handle->number_of_threads        = source_verification_handle->number_of_threads;
+	destination_verification_handle->memory_limit             = source_verification_handle->memory_limit;
+
 	return( 1 );
 }
 
@@ -757,9 +918,39 @@ int verification_handle_initialize_integrity_hash(
 		}
 		verification_handle->sha256_context_initialized = 1;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->number_of_threads != 0 )
+	{
+		if( digest_hash_thread_initialize_additional(
+		     &( verification_handle->sha1_hash_thread ),
+		     &( verification_handle->sha256_hash_thread ),
+		     (intptr_t *) verification_handle->md5_context,
+		     (intptr_t *) verification_handle->sha1_context,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_sha1_update,
+		     (intptr_t *) verification_handle->sha256_context,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_sha256_update,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize additional digest hash threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	return( 1 );
 
 on_error:
+	if( verification_handle->sha256_context != NULL )
+	{
+		libhmac_sha256_free(
+		 &( verification_handle->sha256_context ),
+		 NULL );
+	}
 	if( verification_handle->sha1_context != NULL )
 	{
 		libhmac_sha1_free(
@@ -784,7 +975,8 @@ int verification_handle_update_integrity_hash(
      size_t buffer_size,
      libcerror_error_t **error )
 {
-	static char *function = "verification_handle_update_integrity_hash";
+	static char *function    = "verification_handle_update_integrity_hash";
+	uint64_t stage_timestamp = 0;
 
 	if( verification_handle == NULL )
 	{
@@ -820,55 +1012,64 @@ int verification_handle_update_integrity_hash(
 
 		return( -1 );
 	}
-	if( verification_handle->calculate_md5 != 0 )
+	if( verification_handle->process_status != NULL )
 	{
-		if( libhmac_md5_update(
-		     verification_handle->md5_context,
-		     buffer,
-		     buffer_size,
+		if( process_status_get_stage_timestamp(
+		     verification_handle->process_status,
+		     &stage_timestamp,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update MD5 digest hash.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve stage timestamp.",
 			 function );
 
 			return( -1 );
 		}
 	}
-	if( verification_handle->calculate_sha1 != 0 )
+	if( digest_hash_thread_update_digest_hashes(
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	     verification_handle->sha1_hash_thread,
+	     verification_handle->sha256_hash_thread,
+#else
+	     NULL,
+	     NULL,
+#endif
+	     (intptr_t *) verification_handle->md5_context,
+	     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_md5_update,
+	     (intptr_t *) verification_handle->sha1_context,
+	     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_sha1_update,
+	     (intptr_t *) verification_handle->sha256_context,
+	     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &libhmac_sha256_update,
+	     buffer,
+	     buffer_size,
+	     error ) != 1 )
 	{
-		if( libhmac_sha1_update(
-		     verification_handle->sha1_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update SHA1 digest hash.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update digest hashes.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	if( verification_handle->calculate_sha256 != 0 )
+	if( verification_handle->process_status != NULL )
 	{
-		if( libhmac_sha256_update(
-		     verification_handle->sha256_context,
-		     buffer,
-		     buffer_size,
+		if( process_status_add_stage_value(
+		     verification_handle->process_status,
+		     PROCESS_STATUS_STAGE_HASH,
+		     (size64_t) buffer_size,
+		     stage_timestamp,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update SHA256 digest hash.",
+			 "%s: unable to add hash stage value.",
 			 function );
 
 			return( -1 );
@@ -901,6 +1102,22 @@ int verification_handle_finalize_integrity_hash(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( digest_hash_thread_free_additional(
+	     &( verification_handle->sha1_hash_thread ),
+	     &( verification_handle->sha256_hash_thread ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free additional digest hash threads.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	if( verification_handle->calculate_md5 != 0 )
 	{
 		if( verification_handle->calculated_md5_hash_string == NULL )
@@ -1091,6 +1308,7 @@ int verification_handle_process_storage_media_buffer_callback(
         libcerror_error_t *error = NULL;
         static char *function    = "verification_handle_process_storage_media_buffer_callback";
 	ssize_t process_count    = 0;
+	uint64_t stage_timestamp = 0;
 
 	if( storage_media_buffer == NULL )
 	{
@@ -1103,6 +1321,23 @@ int verification_handle_process_storage_media_buffer_callback(
 
 		goto on_error;
 	}
+	if( verification_handle->process_status != NULL )
+	{
+		if( process_status_get_stage_timestamp(
+		     verification_handle->process_status,
+		     &stage_timestamp,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve stage timestamp.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	process_count = storage_media_buffer_read_process(
 			 storage_media_buffer,
 			 &error );
@@ -1121,6 +1356,8 @@ int verification_handle_process_storage_media_buffer_callback(
 
 		process_count = verification_handle->chunk_size;
 
+		storage_media_buffer->is_corrupted = 1;
+
 		/* Append a read error
 		 */
 		if( verification_handle_append_read_error(
@@ -1139,11 +1376,48 @@ int verification_handle_process_storage_media_buffer_callback(
 			goto on_error;
 		}
 	}
-	if( libcthreads_thread_pool_push_sorted(
+	else if( storage_media_buffer->is_corrupted != 0 )
+	{
+		if( verification_handle_append_read_error(
+		     verification_handle,
+		     storage_media_buffer->storage_media_offset,
+		     storage_media_buffer->processed_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append checksum error.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( verification_handle->process_status != NULL )
+	{
+		if( process_status_add_stage_value(
+		     verification_handle->process_status,
+		     PROCESS_STATUS_STAGE_PROCESS,
+		     (size64_t) process_count,
+		     stage_timestamp,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add process stage value.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* The output thread brings the storage media buffers back in order
+	 */
+	if( libcthreads_thread_pool_push(
 	     verification_handle->output_thread_pool,
 	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCTHREADS_SORT_FLAG_UNIQUE_VALUES,
 	     &error ) != 1 )
 	{
 		libcerror_error_set(
@@ -1194,193 +1468,264 @@ on_error:
 	return( -1 );
 }
 
-/* Prepares a storage media buffer for verification
- * Callback function for the process thread pool
+/* Prepares a storage media buffer of one of the verification handles that share a process thread pool
+ * Callback function for the shared process thread pool
  * Returns 1 if successful or -1 on error
  */
-int verification_handle_output_storage_media_buffer_callback(
+int verification_handle_shared_process_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
-     verification_handle_t *verification_handle )
+     void *arguments EWFTOOLS_ATTRIBUTE_UNUSED )
 {
-	libcdata_list_element_t *element      = NULL;
-	libcdata_list_element_t *next_element = NULL;
-        libcerror_error_t *error              = NULL;
-	uint8_t *data                         = NULL;
-        static char *function                 = "verification_handle_process_storage_media_buffer_callback";
-	size_t data_size                      = 0;
+	verification_handle_t *verification_handle = NULL;
+	libcerror_error_t *error                   = NULL;
+	static char *function                      = "verification_handle_shared_process_storage_media_buffer_callback";
+	int result                                 = 0;
 
-	if( verification_handle == NULL )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid verification handle.",
-		 function );
+	EWFTOOLS_UNREFERENCED_PARAMETER( arguments )
 
-		goto on_error;
-	}
 	if( storage_media_buffer == NULL )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid storage media buffer.",
-		 function );
-
-		goto on_error;
+		return( -1 );
 	}
-	if( libcdata_list_insert_value(
-	     verification_handle->output_list,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
-	     &error ) != 1 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert storage media buffer into output list.",
-		 function );
+	verification_handle = (verification_handle_t *) storage_media_buffer->owner;
 
-		goto on_error;
+	if( verification_handle == NULL )
+	{
+		return( -1 );
 	}
-	storage_media_buffer = NULL;
+	result = verification_handle_process_storage_media_buffer_callback(
+	          storage_media_buffer,
+	          verification_handle );
 
-	if( libcdata_list_get_first_element(
-	     verification_handle->output_list,
-	     &element,
+	/* The verification handle waits for its storage media buffers to be processed
+	 * before it finishes verification
+	 */
+	if( libcthreads_mutex_grab(
+	     verification_handle->shared_process_jobs_mutex,
 	     &error ) != 1 )
 	{
 		libcerror_error_set(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shared process jobs mutex.",
 		 function );
 
 		goto on_error;
 	}
-	while( element != NULL )
+	verification_handle->number_of_shared_process_jobs -= 1;
+
+	if( verification_handle->number_of_shared_process_jobs == 0 )
 	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
+		if( libcthreads_condition_broadcast(
+		     verification_handle->shared_process_jobs_condition,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast shared process jobs condition.",
 			 function );
 
-			storage_media_buffer = NULL;
+			libcthreads_mutex_release(
+			 verification_handle->shared_process_jobs_mutex,
+			 NULL );
 
 			goto on_error;
 		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
+	}
+	if( libcthreads_mutex_release(
+	     verification_handle->shared_process_jobs_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shared process jobs mutex.",
+		 function );
 
-			goto on_error;
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
 		}
-		if( storage_media_buffer->storage_media_offset != verification_handle->last_offset_hashed )
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Prepares a storage media buffer for verification
+ * Callback function for the process thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_output_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     verification_handle_t *verification_handle )
+{
+        libcerror_error_t *error = NULL;
+	uint8_t *data            = NULL;
+        static char *function    = "verification_handle_process_storage_media_buffer_callback";
+	size_t data_size         = 0;
+	int result               = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->verify_chunks_only != 0 )
+	{
+		if( storage_media_buffer->is_corrupted != 0 )
 		{
-			break;
+			verification_handle->number_of_corrupted_chunks += 1;
 		}
-		if( storage_media_buffer_get_data(
+		verification_handle->last_offset_hashed += storage_media_buffer->processed_size;
+
+		if( storage_media_buffer_queue_release_buffer(
+		     verification_handle->storage_media_buffer_queue,
 		     storage_media_buffer,
-		     &data,
-		     &data_size,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine storage media buffer data.",
+			 "%s: unable to release storage media buffer onto queue.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		if( verification_handle_update_integrity_hash(
+		storage_media_buffer = NULL;
+
+		if( verification_handle_set_telemetry_buffer_values(
 		     verification_handle,
-		     data,
-		     storage_media_buffer->processed_size,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to update integrity hash(es).",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set telemetry buffer values.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		verification_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
-
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
+		if( process_status_update(
+		     verification_handle->process_status,
+		     verification_handle->last_offset_hashed,
+		     verification_handle->verify_size,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update process status.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		if( libcdata_list_remove_element(
-		     verification_handle->output_list,
-		     element,
-		     &error ) != 1 )
+		return( 1 );
+	}
+	if( storage_media_buffer_reorder_insert_buffer(
+	     verification_handle->output_reorder,
+	     storage_media_buffer,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert storage media buffer into output reorder window.",
+		 function );
+
+		goto on_error;
+	}
+	storage_media_buffer = NULL;
+
+	do
+	{
+		result = storage_media_buffer_reorder_remove_buffer(
+		          verification_handle->output_reorder,
+		          verification_handle->last_offset_hashed,
+		          &storage_media_buffer,
+		          &error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
+			 "%s: unable to remove storage media buffer from output reorder window.",
 			 function );
 
-			storage_media_buffer = NULL;
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( storage_media_buffer_get_data(
+		     storage_media_buffer,
+		     &data,
+		     &data_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine storage media buffer data.",
+			 function );
 
 			goto on_error;
 		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
+		if( verification_handle_update_integrity_hash(
+		     verification_handle,
+		     data,
+		     storage_media_buffer->processed_size,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to update integrity hash(es).",
 			 function );
 
 			goto on_error;
 		}
-		element = next_element;
+		verification_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
 
 		if( storage_media_buffer_queue_release_buffer(
 		     verification_handle->storage_media_buffer_queue,
@@ -1398,10 +1743,23 @@ int verification_handle_output_storage_media_buffer_callback(
 		}
 		storage_media_buffer = NULL;
 
+		if( verification_handle_set_telemetry_buffer_values(
+		     verification_handle,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set telemetry buffer values.",
+			 function );
+
+			goto on_error;
+		}
 		if( process_status_update(
 		     verification_handle->process_status,
 		     verification_handle->last_offset_hashed,
-		     verification_handle->media_size,
+		     verification_handle->verify_size,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
@@ -1414,6 +1772,8 @@ int verification_handle_output_storage_media_buffer_callback(
 			goto on_error;
 		}
 	}
+	while( result == 1 );
+
 	return( 1 );
 
 on_error:
@@ -1451,17 +1811,17 @@ on_error:
 	return( -1 );
 }
 
-/* Empties the output list
+/* Sets the process thread pool shared with other verification handles
+ * The verification handle does not create its own process thread pool
+ * if a shared process thread pool is set
  * Returns 1 if successful or -1 on error
  */
-int verification_handle_empty_output_list(
+int verification_handle_set_shared_process_thread_pool(
      verification_handle_t *verification_handle,
+     libcthreads_thread_pool_t *shared_process_thread_pool,
      libcerror_error_t **error )
 {
-	libcdata_list_element_t *element             = NULL;
-	libcdata_list_element_t *next_element        = NULL;
-	storage_media_buffer_t *storage_media_buffer = NULL;
-        static char *function                        = "verification_handle_empty_output_list";
+	static char *function = "verification_handle_set_shared_process_thread_pool";
 
 	if( verification_handle == NULL )
 	{
@@ -1474,110 +1834,967 @@ int verification_handle_empty_output_list(
 
 		return( -1 );
 	}
-	if( libcdata_list_get_first_element(
-	     verification_handle->output_list,
-	     &element,
-	     error ) != 1 )
+	if( verification_handle->number_of_shared_process_jobs != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid verification handle - shared process jobs pending.",
 		 function );
 
 		return( -1 );
 	}
-	while( element != NULL )
+	if( ( shared_process_thread_pool != NULL )
+	 && ( verification_handle->shared_process_jobs_mutex == NULL ) )
 	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
+		if( libcthreads_mutex_initialize(
+		     &( verification_handle->shared_process_jobs_mutex ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
-
-			return( -1 );
-		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create shared process jobs mutex.",
 			 function );
 
 			return( -1 );
 		}
-		if( storage_media_buffer_queue_release_buffer(
-		     verification_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
+		if( libcthreads_condition_initialize(
+		     &( verification_handle->shared_process_jobs_condition ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create shared process jobs condition.",
 			 function );
 
+			libcthreads_mutex_free(
+			 &( verification_handle->shared_process_jobs_mutex ),
+			 NULL );
+
 			return( -1 );
 		}
-		storage_media_buffer = NULL;
+	}
+	verification_handle->shared_process_thread_pool = shared_process_thread_pool;
 
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
+	return( 1 );
+}
 
-			return( -1 );
-		}
-		if( libcdata_list_remove_element(
-		     verification_handle->output_list,
-		     element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
+/* Pushes a storage media buffer onto the process thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_push_storage_media_buffer(
+     verification_handle_t *verification_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_push_storage_media_buffer";
 
-			return( -1 );
-		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     error ) != 1 )
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->shared_process_thread_pool == NULL )
+	{
+		if( libcthreads_thread_pool_push(
+		     verification_handle->process_thread_pool,
+		     (intptr_t *) storage_media_buffer,
+		     error ) == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push storage media buffer onto process thread pool queue.",
 			 function );
 
 			return( -1 );
 		}
-		element = next_element;
+		return( 1 );
+	}
+	storage_media_buffer->owner = (intptr_t *) verification_handle;
+
+	if( libcthreads_mutex_grab(
+	     verification_handle->shared_process_jobs_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shared process jobs mutex.",
+		 function );
+
+		return( -1 );
+	}
+	verification_handle->number_of_shared_process_jobs += 1;
+
+	if( libcthreads_mutex_release(
+	     verification_handle->shared_process_jobs_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shared process jobs mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_thread_pool_push(
+	     verification_handle->shared_process_thread_pool,
+	     (intptr_t *) storage_media_buffer,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push storage media buffer onto shared process thread pool queue.",
+		 function );
+
+		if( libcthreads_mutex_grab(
+		     verification_handle->shared_process_jobs_mutex,
+		     NULL ) == 1 )
+		{
+			verification_handle->number_of_shared_process_jobs -= 1;
+
+			libcthreads_mutex_release(
+			 verification_handle->shared_process_jobs_mutex,
+			 NULL );
+		}
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Waits until the storage media buffers pushed onto the shared process thread pool have been processed
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_wait_for_shared_process_jobs(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_wait_for_shared_process_jobs";
+	int result            = 1;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->shared_process_jobs_mutex == NULL )
+	{
+		return( 1 );
+	}
+	if( libcthreads_mutex_grab(
+	     verification_handle->shared_process_jobs_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shared process jobs mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( verification_handle->number_of_shared_process_jobs > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     verification_handle->shared_process_jobs_condition,
+		     verification_handle->shared_process_jobs_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for shared process jobs condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     verification_handle->shared_process_jobs_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shared process jobs mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Sets the storage media buffer values of the telemetry
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_set_telemetry_buffer_values(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error )
+{
+	static char *function        = "verification_handle_set_telemetry_buffer_values";
+	int number_of_buffers_in_use = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( verification_handle->process_status == NULL )
+	 || ( verification_handle->process_status->telemetry_stream == NULL )
+	 || ( verification_handle->storage_media_buffer_queue == NULL )
+	 || ( verification_handle->output_reorder == NULL ) )
+	{
+		return( 1 );
+	}
+	if( storage_media_buffer_queue_get_number_of_buffers_in_use(
+	     verification_handle->storage_media_buffer_queue,
+	     &number_of_buffers_in_use,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of storage media buffers in use.",
+		 function );
+
+		return( -1 );
+	}
+	if( process_status_set_buffer_values(
+	     verification_handle->process_status,
+	     number_of_buffers_in_use,
+	     verification_handle->storage_media_buffer_queue->number_of_buffers,
+	     verification_handle->output_reorder->number_of_buffers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set process status buffer values.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Opens the reader handles
+ * The chunks are divided in contiguous regions that are read concurrently
+ * by the input handle and the reader handles, where every reader handle
+ * has its own file IO pool
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_open_reader_handles(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error )
+{
+	static char *function              = "verification_handle_open_reader_handles";
+	uint64_t number_of_chunks          = 0;
+	int maximum_number_of_open_handles = 0;
+	int number_of_reader_handles       = 0;
+	int reader_handle_index            = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->reader_handles != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verification handle - reader handles value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid verification handle - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_chunks = verification_handle->media_size / verification_handle->chunk_size;
+
+	if( ( verification_handle->media_size % verification_handle->chunk_size ) != 0 )
+	{
+		number_of_chunks += 1;
+	}
+	number_of_reader_handles = verification_handle->number_of_threads;
+
+	if( number_of_reader_handles > VERIFICATION_HANDLE_MAXIMUM_NUMBER_OF_READER_HANDLES )
+	{
+		number_of_reader_handles = VERIFICATION_HANDLE_MAXIMUM_NUMBER_OF_READER_HANDLES;
+	}
+	if( (uint64_t) number_of_reader_handles > number_of_chunks )
+	{
+		number_of_reader_handles = (int) number_of_chunks;
+	}
+	/* The input handle is used as the first reader handle
+	 */
+	number_of_reader_handles -= 1;
+
+	if( number_of_reader_handles <= 0 )
+	{
+		return( 1 );
+	}
+	verification_handle->read_regions = (verification_handle_read_region_t *) memory_allocate(
+	                                                                           sizeof( verification_handle_read_region_t ) * ( number_of_reader_handles + 1 ) );
+
+	if( verification_handle->read_regions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read regions.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     verification_handle->read_regions,
+	     0,
+	     sizeof( verification_handle_read_region_t ) * ( number_of_reader_handles + 1 ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read regions.",
+		 function );
+
+		goto on_error;
+	}
+	verification_handle->reader_handles = (libewf_handle_t **) memory_allocate(
+	                                                            sizeof( libewf_handle_t * ) * number_of_reader_handles );
+
+	if( verification_handle->reader_handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create reader handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     verification_handle->reader_handles,
+	     0,
+	     sizeof( libewf_handle_t * ) * number_of_reader_handles ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear reader handles.",
+		 function );
+
+		goto on_error;
+	}
+	/* The open file handles are divided over the reader handles
+	 */
+	if( verification_handle->maximum_number_of_open_handles > 0 )
+	{
+		maximum_number_of_open_handles = verification_handle->maximum_number_of_open_handles / ( number_of_reader_handles + 1 );
+
+		if( maximum_number_of_open_handles == 0 )
+		{
+			maximum_number_of_open_handles = 1;
+		}
+		if( libewf_handle_set_maximum_number_of_open_handles(
+		     verification_handle->input_handle,
+		     maximum_number_of_open_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles in input handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( reader_handle_index = 0;
+	     reader_handle_index < number_of_reader_handles;
+	     reader_handle_index++ )
+	{
+		if( libewf_handle_clone(
+		     &( verification_handle->reader_handles[ reader_handle_index ] ),
+		     verification_handle->input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create reader handle: %d.",
+			 function,
+			 reader_handle_index );
+
+			goto on_error;
+		}
+		verification_handle->number_of_reader_handles += 1;
+	}
+	return( 1 );
+
+on_error:
+	verification_handle_close_reader_handles(
+	 verification_handle,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Closes the reader handles
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_close_reader_handles(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error )
+{
+	static char *function   = "verification_handle_close_reader_handles";
+	int reader_handle_index = 0;
+	int result              = 1;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->reader_handles != NULL )
+	{
+		for( reader_handle_index = 0;
+		     reader_handle_index < verification_handle->number_of_reader_handles;
+		     reader_handle_index++ )
+		{
+			if( libewf_handle_close(
+			     verification_handle->reader_handles[ reader_handle_index ],
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close reader handle: %d.",
+				 function,
+				 reader_handle_index );
+
+				result = -1;
+			}
+			if( libewf_handle_free(
+			     &( verification_handle->reader_handles[ reader_handle_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free reader handle: %d.",
+				 function,
+				 reader_handle_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 verification_handle->reader_handles );
+
+		verification_handle->reader_handles = NULL;
+	}
+	if( verification_handle->read_regions != NULL )
+	{
+		memory_free(
+		 verification_handle->read_regions );
+
+		verification_handle->read_regions = NULL;
+	}
+	verification_handle->number_of_reader_handles = 0;
+
+	return( result );
+}
+
+/* Reads the chunks of a region and pushes them onto the process thread pool
+ * Callback function for the read thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_read_region_callback(
+     verification_handle_read_region_t *read_region,
+     verification_handle_t *verification_handle )
+{
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	libcerror_error_t *error                     = NULL;
+	static char *function                        = "verification_handle_read_region_callback";
+	off64_t storage_media_offset                 = 0;
+	size64_t remaining_size                      = 0;
+	size_t read_size                             = 0;
+	ssize_t read_count                           = 0;
+	uint64_t stage_timestamp                     = 0;
+
+	if( read_region == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read region.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_seek_offset(
+	     read_region->reader_handle,
+	     read_region->offset,
+	     SEEK_SET,
+	     &error ) == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 ".",
+		 function,
+		 read_region->offset );
+
+		goto on_error;
+	}
+	storage_media_offset = read_region->offset;
+	remaining_size       = read_region->size;
+
+	while( remaining_size > 0 )
+	{
+		if( verification_handle->abort != 0 )
+		{
+			break;
+		}
+		if( storage_media_buffer_queue_grab_buffer(
+		     verification_handle->storage_media_buffer_queue,
+		     &storage_media_buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to grab storage media buffer from queue.",
+			 function );
+
+			goto on_error;
+		}
+		if( storage_media_buffer == NULL )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing storage media buffer.",
+			 function );
+
+			goto on_error;
+		}
+		/* The regions are only read with the chunk data functions
+		 */
+		read_size = (size_t) verification_handle->chunk_size;
+
+		if( remaining_size < read_size )
+		{
+			read_size = (size_t) remaining_size;
+		}
+		if( verification_handle->process_status != NULL )
+		{
+			if( process_status_get_stage_timestamp(
+			     verification_handle->process_status,
+			     &stage_timestamp,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve stage timestamp.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		read_count = storage_media_buffer_read_from_handle(
+		              storage_media_buffer,
+		              read_region->reader_handle,
+		              read_size,
+		              &error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data.",
+			 function );
+
+			goto on_error;
+		}
+		if( read_count == 0 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unexpected end of data.",
+			 function );
+
+			goto on_error;
+		}
+		storage_media_buffer->storage_media_offset = storage_media_offset;
+
+		storage_media_offset += read_count;
+		remaining_size       -= read_count;
+
+		if( verification_handle->process_status != NULL )
+		{
+			if( process_status_add_stage_value(
+			     verification_handle->process_status,
+			     PROCESS_STATUS_STAGE_READ,
+			     (size64_t) read_count,
+			     stage_timestamp,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to add read stage value.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( verification_handle_push_storage_media_buffer(
+		     verification_handle,
+		     storage_media_buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push storage media buffer.",
+			 function );
+
+			goto on_error;
+		}
+		storage_media_buffer = NULL;
+	}
+	read_region->result = 1;
+
+	return( 1 );
+
+on_error:
+	if( storage_media_buffer != NULL )
+	{
+		if( storage_media_buffer_queue_release_buffer(
+		     verification_handle->storage_media_buffer_queue,
+		     storage_media_buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to release storage media buffer onto queue.",
+			 function );
+
+			storage_media_buffer_free(
+			 &storage_media_buffer,
+			 NULL );
+		}
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_region != NULL )
+	{
+		read_region->result = -1;
+	}
+	return( -1 );
+}
+
+/* Reads the media data in chunk aligned regions, one per reader handle, concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_read_regions(
+     verification_handle_t *verification_handle,
+     size_t process_buffer_size,
+     libcerror_error_t **error )
+{
+	verification_handle_read_region_t *read_region = NULL;
+	static char *function                          = "verification_handle_read_regions";
+	off64_t region_offset                          = 0;
+	size64_t region_size                           = 0;
+	uint64_t number_of_chunks                      = 0;
+	uint64_t number_of_region_chunks               = 0;
+	int number_of_read_regions                     = 0;
+	int read_region_index                          = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( verification_handle->reader_handles == NULL )
+	 || ( verification_handle->read_regions == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid verification handle - missing reader handles.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->read_thread_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verification handle - read thread pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( process_buffer_size != (size_t) verification_handle->chunk_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported process buffer size.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_read_regions = verification_handle->number_of_reader_handles + 1;
+
+	number_of_chunks = verification_handle->media_size / verification_handle->chunk_size;
+
+	if( ( verification_handle->media_size % verification_handle->chunk_size ) != 0 )
+	{
+		number_of_chunks += 1;
+	}
+	/* The first regions contain one more chunk if the chunks cannot be divided evenly
+	 */
+	for( read_region_index = 0;
+	     read_region_index < number_of_read_regions;
+	     read_region_index++ )
+	{
+		number_of_region_chunks = number_of_chunks / number_of_read_regions;
+
+		if( (uint64_t) read_region_index < ( number_of_chunks % number_of_read_regions ) )
+		{
+			number_of_region_chunks += 1;
+		}
+		region_size = number_of_region_chunks * verification_handle->chunk_size;
+
+		if( region_size > ( verification_handle->media_size - (size64_t) region_offset ) )
+		{
+			region_size = verification_handle->media_size - (size64_t) region_offset;
+		}
+		read_region = &( verification_handle->read_regions[ read_region_index ] );
+
+		if( read_region_index == 0 )
+		{
+			read_region->reader_handle = verification_handle->input_handle;
+		}
+		else
+		{
+			read_region->reader_handle = verification_handle->reader_handles[ read_region_index - 1 ];
+		}
+		read_region->offset = region_offset;
+		read_region->size   = region_size;
+		read_region->result = 0;
+
+		region_offset += (off64_t) region_size;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( verification_handle->read_thread_pool ),
+	     NULL,
+	     number_of_read_regions,
+	     number_of_read_regions,
+	     (int (*)(intptr_t *, void *)) &verification_handle_read_region_callback,
+	     (void *) verification_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	for( read_region_index = 0;
+	     read_region_index < number_of_read_regions;
+	     read_region_index++ )
+	{
+		if( libcthreads_thread_pool_push(
+		     verification_handle->read_thread_pool,
+		     (intptr_t *) &( verification_handle->read_regions[ read_region_index ] ),
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push read region: %d onto read thread pool queue.",
+			 function,
+			 read_region_index );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_thread_pool_join(
+	     &( verification_handle->read_thread_pool ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join read thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	for( read_region_index = 0;
+	     read_region_index < number_of_read_regions;
+	     read_region_index++ )
+	{
+		read_region = &( verification_handle->read_regions[ read_region_index ] );
+
+		if( ( read_region->result != 1 )
+		 && ( verification_handle->abort == 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read region: %d at offset: %" PRIi64 ".",
+			 function,
+			 read_region_index,
+			 read_region->offset );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( verification_handle->read_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( verification_handle->read_thread_pool ),
+		 NULL );
 	}
-	return( 1 );
+	return( -1 );
 }
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
@@ -1601,11 +2818,14 @@ int verification_handle_verify_input(
 	size_t read_size                             = 0;
 	ssize_t process_count                        = 0;
 	ssize_t read_count                           = 0;
+	uint64_t chunk_index                         = 0;
+	uint64_t stage_timestamp                     = 0;
 	uint32_t number_of_checksum_errors           = 0;
 	uint8_t storage_media_buffer_mode            = 0;
 	int is_corrupted                             = 0;
 	int maximum_number_of_queued_items           = 0;
 	int md5_hash_compare                         = 0;
+	int result                                   = 0;
 	int sha1_hash_compare                        = 0;
 	int sha256_hash_compare                      = 0;
 	int status                                   = PROCESS_STATUS_COMPLETED;
@@ -1681,6 +2901,28 @@ int verification_handle_verify_input(
 
 		goto on_error;
 	}
+	verification_handle->verify_size = verification_handle->media_size;
+
+	if( verification_handle->sample_size != 0 )
+	{
+		if( verification_handle_initialize_sample(
+		     verification_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize sample.",
+			 function );
+
+			goto on_error;
+		}
+		if( verification_handle->number_of_sample_chunks < verification_handle->number_of_chunks )
+		{
+			verification_handle->verify_size = verification_handle->number_of_sample_chunks * verification_handle->chunk_size;
+		}
+	}
 	if( verification_handle->use_chunk_data_functions != 0 )
 	{
 		process_buffer_size       = verification_handle->chunk_size;
@@ -1701,26 +2943,47 @@ int verification_handle_verify_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 	if( verification_handle->number_of_threads != 0 )
 	{
-		maximum_number_of_queued_items = 1 + ( ( 512 * 1024 * 1024 ) / process_buffer_size );
-
-		if( libcthreads_thread_pool_create(
-		     &( verification_handle->process_thread_pool ),
-		     NULL,
+		if( storage_media_buffer_queue_get_maximum_number_of_values(
+		     verification_handle->memory_limit,
+		     process_buffer_size,
 		     verification_handle->number_of_threads,
-		     maximum_number_of_queued_items,
-		     (int (*)(intptr_t *, void *)) &verification_handle_process_storage_media_buffer_callback,
-		     (void *) verification_handle,
+		     &maximum_number_of_queued_items,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize process thread pool.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine maximum number of queued items.",
 			 function );
 
 			goto on_error;
 		}
+
+		/* With a shared process thread pool the storage media buffers of this
+		 * and other verification handles are processed by the same threads
+		 */
+		if( verification_handle->shared_process_thread_pool == NULL )
+		{
+			if( libcthreads_thread_pool_create(
+			     &( verification_handle->process_thread_pool ),
+			     NULL,
+			     verification_handle->number_of_threads,
+			     maximum_number_of_queued_items,
+			     (int (*)(intptr_t *, void *)) &verification_handle_process_storage_media_buffer_callback,
+			     (void *) verification_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize process thread pool.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		if( libcthreads_thread_pool_create(
 		     &( verification_handle->output_thread_pool ),
 		     NULL,
@@ -1739,15 +3002,17 @@ int verification_handle_verify_input(
 
 			goto on_error;
 		}
-		if( libcdata_list_initialize(
-		     &( verification_handle->output_list ),
+		if( storage_media_buffer_reorder_initialize(
+		     &( verification_handle->output_reorder ),
+		     maximum_number_of_queued_items,
+		     process_buffer_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create output list.",
+			 "%s: unable to create output reorder window.",
 			 function );
 
 			goto on_error;
@@ -1769,6 +3034,26 @@ int verification_handle_verify_input(
 
 			goto on_error;
 		}
+		/* Verifying only the chunks does not require the chunks to be read in order
+		 * hence the chunks are read concurrently with multiple handles
+		 */
+		if( ( verification_handle->verify_chunks_only != 0 )
+		 && ( verification_handle->sample_size == 0 ) )
+		{
+			if( verification_handle_open_reader_handles(
+			     verification_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open reader handles.",
+				 function );
+
+				goto on_error;
+			}
+		}
 	}
 #endif
 	if( verification_handle_initialize_integrity_hash(
@@ -1802,6 +3087,21 @@ int verification_handle_verify_input(
 
 		goto on_error;
 	}
+	if( process_status_set_telemetry(
+	     verification_handle->process_status,
+	     verification_handle->telemetry_stream,
+	     verification_handle->number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set process status telemetry.",
+		 function );
+
+		goto on_error;
+	}
 	if( process_status_start(
 	     verification_handle->process_status,
 	     error ) != 1 )
@@ -1836,12 +3136,74 @@ int verification_handle_verify_input(
 	}
 	remaining_media_size = verification_handle->media_size;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->number_of_reader_handles > 0 )
+	{
+		if( verification_handle_read_regions(
+		     verification_handle,
+		     process_buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read regions.",
+			 function );
+
+			goto on_error;
+		}
+		remaining_media_size = 0;
+	}
+#endif
 	while( remaining_media_size > 0 )
 	{
 		if( verification_handle->abort != 0 )
 		{
 			break;
 		}
+		if( verification_handle->sample_size != 0 )
+		{
+			result = verification_handle_get_next_sample_chunk_index(
+			          verification_handle,
+			          &chunk_index,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve next sample chunk index.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				break;
+			}
+			storage_media_offset = (off64_t) ( chunk_index * verification_handle->chunk_size );
+
+			if( libewf_handle_seek_offset(
+			     verification_handle->input_handle,
+			     storage_media_offset,
+			     SEEK_SET,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to seek sample chunk: %" PRIu64 ".",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			remaining_media_size = verification_handle->media_size - (size64_t) storage_media_offset;
+		}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( verification_handle->number_of_threads != 0 )
 		{
@@ -1878,6 +3240,23 @@ int verification_handle_verify_input(
 		{
 			read_size = (size_t) remaining_media_size;
 		}
+		if( verification_handle->process_status != NULL )
+		{
+			if( process_status_get_stage_timestamp(
+			     verification_handle->process_status,
+			     &stage_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve stage timestamp.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		read_count = storage_media_buffer_read_from_handle(
 		              storage_media_buffer,
 		              verification_handle->input_handle,
@@ -1911,19 +3290,38 @@ int verification_handle_verify_input(
 		storage_media_offset += read_count;
 		remaining_media_size -= read_count;
 
+		if( verification_handle->process_status != NULL )
+		{
+			if( process_status_add_stage_value(
+			     verification_handle->process_status,
+			     PROCESS_STATUS_STAGE_READ,
+			     (size64_t) read_count,
+			     stage_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to add read stage value.",
+				 function );
+
+				goto on_error;
+			}
+		}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( verification_handle->number_of_threads != 0 )
 		{
-			if( libcthreads_thread_pool_push(
-			     verification_handle->process_thread_pool,
-			     (intptr_t *) storage_media_buffer,
-			     error ) == -1 )
+			if( verification_handle_push_storage_media_buffer(
+			     verification_handle,
+			     storage_media_buffer,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to push storage media buffer onto process thread pool queue.",
+				 "%s: unable to push storage media buffer.",
 				 function );
 
 				goto on_error;
@@ -1933,6 +3331,23 @@ int verification_handle_verify_input(
 		else
 #endif
 		{
+			if( verification_handle->process_status != NULL )
+			{
+				if( process_status_get_stage_timestamp(
+				     verification_handle->process_status,
+				     &stage_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve stage timestamp.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			process_count = storage_media_buffer_read_process(
 			                 storage_media_buffer,
 		        	         error );
@@ -1952,6 +3367,8 @@ int verification_handle_verify_input(
 
 				process_count = verification_handle->chunk_size;
 
+				storage_media_buffer->is_corrupted = 1;
+
 				/* Append a read error
 				 */
 				if( verification_handle_append_read_error(
@@ -1970,6 +3387,47 @@ int verification_handle_verify_input(
 					goto on_error;
 				}
 			}
+			else if( storage_media_buffer->is_corrupted != 0 )
+			{
+				if( verification_handle_append_read_error(
+				     verification_handle,
+				     storage_media_buffer->storage_media_offset,
+				     storage_media_buffer->processed_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append checksum error.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( verification_handle->process_status != NULL )
+			{
+				if( process_status_add_stage_value(
+				     verification_handle->process_status,
+				     PROCESS_STATUS_STAGE_PROCESS,
+				     (size64_t) process_count,
+				     stage_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to add process stage value.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( storage_media_buffer->is_corrupted != 0 )
+			{
+				verification_handle->number_of_corrupted_chunks += 1;
+			}
 			if( storage_media_buffer_get_data(
 			     storage_media_buffer,
 			     &data,
@@ -2005,7 +3463,7 @@ int verification_handle_verify_input(
 			if( process_status_update(
 			     verification_handle->process_status,
 			     verification_handle->last_offset_hashed,
-			     verification_handle->media_size,
+			     verification_handle->verify_size,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
@@ -2052,6 +3510,19 @@ int verification_handle_verify_input(
 			goto on_error;
 		}
 	}
+	if( verification_handle_wait_for_shared_process_jobs(
+	     verification_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to wait for shared process jobs.",
+		 function );
+
+		goto on_error;
+	}
 	if( verification_handle->output_thread_pool != NULL )
 	{
 		if( libcthreads_thread_pool_join(
@@ -2068,47 +3539,49 @@ int verification_handle_verify_input(
 			goto on_error;
 		}
 	}
-	if( verification_handle->output_list != NULL )
+	if( verification_handle->output_reorder != NULL )
 	{
-		if( verification_handle_empty_output_list(
-		     verification_handle,
+		if( storage_media_buffer_reorder_free(
+		     &( verification_handle->output_reorder ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
+			 "%s: unable to free output reorder window.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcdata_list_free(
-		     &( verification_handle->output_list ),
-		     NULL,
+	}
+	if( verification_handle->storage_media_buffer_queue != NULL )
+	{
+		if( storage_media_buffer_queue_free(
+		     &( verification_handle->storage_media_buffer_queue ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
+			 "%s: unable to free storage media buffer queue.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	if( verification_handle->storage_media_buffer_queue != NULL )
+	if( verification_handle->reader_handles != NULL )
 	{
-		if( storage_media_buffer_queue_free(
-		     &( verification_handle->storage_media_buffer_queue ),
+		if( verification_handle_close_reader_handles(
+		     verification_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free storage media buffer queue.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close reader handles.",
 			 function );
 
 			goto on_error;
@@ -2193,6 +3666,23 @@ int verification_handle_verify_input(
 
 			goto on_error;
 		}
+		if( verification_handle->sample_size != 0 )
+		{
+			if( verification_handle_sample_fprint(
+			     verification_handle,
+			     verification_handle->notify_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print sample.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		if( verification_handle_hash_values_fprint(
 		     verification_handle,
 		     verification_handle->notify_stream,
@@ -2241,6 +3731,23 @@ int verification_handle_verify_input(
 
 				goto on_error;
 			}
+			if( verification_handle->sample_size != 0 )
+			{
+				if( verification_handle_sample_fprint(
+				     verification_handle,
+				     log_handle->log_stream,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+					 "%s: unable to print sample in log handle.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			if( verification_handle_hash_values_fprint(
 			     verification_handle,
 			     log_handle->log_stream,
@@ -2356,26 +3863,35 @@ on_error:
 		 NULL );
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->read_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( verification_handle->read_thread_pool ),
+		 NULL );
+	}
 	if( verification_handle->process_thread_pool != NULL )
 	{
 		libcthreads_thread_pool_join(
 		 &( verification_handle->process_thread_pool ),
 		 NULL );
 	}
+	/* The storage media buffers on the shared process thread pool must be
+	 * processed before the queue is freed
+	 */
+	verification_handle_wait_for_shared_process_jobs(
+	 verification_handle,
+	 NULL );
+
 	if( verification_handle->output_thread_pool != NULL )
 	{
 		libcthreads_thread_pool_join(
 		 &( verification_handle->output_thread_pool ),
 		 NULL );
 	}
-	if( verification_handle->output_list != NULL )
+	if( verification_handle->output_reorder != NULL )
 	{
-		verification_handle_empty_output_list(
-		 verification_handle,
-		 NULL );
-		libcdata_list_free(
-		 &( verification_handle->output_list ),
-		 NULL,
+		storage_media_buffer_reorder_free(
+		 &( verification_handle->output_reorder ),
 		 NULL );
 	}
 	if( verification_handle->storage_media_buffer_queue != NULL )
@@ -2384,6 +3900,12 @@ on_error:
 		 &( verification_handle->storage_media_buffer_queue ),
 		 NULL );
 	}
+	if( verification_handle->reader_handles != NULL )
+	{
+		verification_handle_close_reader_handles(
+		 verification_handle,
+		 NULL );
+	}
 #endif
 	return( -1 );
 }
@@ -2439,8 +3961,23 @@ int verification_handle_verify_single_files(
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create process status.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_set_telemetry(
+	     verification_handle->process_status,
+	     verification_handle->telemetry_stream,
+	     verification_handle->number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set process status telemetry.",
 		 function );
 
 		goto on_error;
@@ -3596,6 +5133,7 @@ int verification_handle_set_number_of_threads(
 	static char *function      = "verification_handle_set_number_of_threads";
 	size_t string_length       = 0;
 	uint64_t number_of_threads = 0;
+	int number_of_processors   = 0;
 	int result                 = 0;
 
 	if( verification_handle == NULL )
@@ -3604,7 +5142,7 @@ int verification_handle_set_number_of_threads(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid imaging handle.",
+		 "%s: invalid verification handle.",
 		 function );
 
 		return( -1 );
@@ -3612,11 +5150,42 @@ int verification_handle_set_number_of_threads(
 	string_length = system_string_length(
 	                 string );
 
-	if( string[ 0 ] != (system_character_t) '-' )
+	if( ( string_length == 4 )
+	 && ( system_string_compare(
+	       string,
+	       _SYSTEM_STRING( "auto" ),
+	       4 ) == 0 ) )
 	{
-		string_length = system_string_length(
-				 string );
+		/* Use a thread per processor, if the number of processors cannot
+		 * be determined the current number of threads is retained
+		 */
+		result = platform_get_number_of_processors(
+		          &number_of_processors,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine number of processors.",
+			 function );
 
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			if( number_of_processors > VERIFICATION_HANDLE_MAXIMUM_NUMBER_OF_THREADS )
+			{
+				number_of_processors = VERIFICATION_HANDLE_MAXIMUM_NUMBER_OF_THREADS;
+			}
+			verification_handle->number_of_threads = number_of_processors;
+		}
+		result = 1;
+	}
+	else if( string[ 0 ] != (system_character_t) '-' )
+	{
 		if( ewftools_system_string_decimal_copy_to_64_bit(
 		     string,
 		     string_length + 1,
@@ -3634,7 +5203,7 @@ int verification_handle_set_number_of_threads(
 		}
 		result = 1;
 
-		if( number_of_threads > 32 )
+		if( number_of_threads > VERIFICATION_HANDLE_MAXIMUM_NUMBER_OF_THREADS )
 		{
 			result = 0;
 		}
@@ -3646,6 +5215,64 @@ int verification_handle_set_number_of_threads(
 	return( result );
 }
 
+/* Sets the memory limit of the storage media buffers
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int verification_handle_set_memory_limit(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function  = "verification_handle_set_memory_limit";
+	size_t string_length   = 0;
+	uint64_t size_variable = 0;
+	int result             = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	result = byte_size_string_convert(
+	          string,
+	          string_length,
+	          &size_variable,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine memory limit.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( size_variable == 0 )
+		{
+			result = 0;
+		}
+		else
+		{
+			verification_handle->memory_limit = (size64_t) size_variable;
+		}
+	}
+	return( result );
+}
+
 /* Sets the additional digest types
  * Returns 1 if successful or -1 on error
  */
@@ -3875,84 +5502,398 @@ int verification_handle_set_additional_digest_types(
 		verification_handle->calculated_sha1_hash_string = system_string_allocate(
 		                                                    41 );
 
-		if( verification_handle->calculated_sha1_hash_string == NULL )
+		if( verification_handle->calculated_sha1_hash_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create calculated SHA1 digest hash string.",
+			 function );
+
+			goto on_error;
+		}
+		verification_handle->calculate_sha1 = 1;
+	}
+	if( ( calculate_sha256 != 0 )
+	 && ( verification_handle->calculate_sha256 == 0 ) )
+	{
+		verification_handle->calculated_sha256_hash_string = system_string_allocate(
+		                                                      65 );
+
+		if( verification_handle->calculated_sha256_hash_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create calculated SHA256 digest hash string.",
+			 function );
+
+			goto on_error;
+		}
+		verification_handle->calculate_sha256 = 1;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_split_string_free(
+	     &string_elements,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_split_string_free(
+	     &string_elements,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free split string.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( string_elements != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libcsplit_wide_split_string_free(
+		 &string_elements,
+		 NULL );
+#else
+		libcsplit_narrow_split_string_free(
+		 &string_elements,
+		 NULL );
+#endif
+	}
+	return( -1 );
+}
+
+/* Sets the zero chunk on error
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_set_zero_chunk_on_error(
+     verification_handle_t *verification_handle,
+     uint8_t zero_chunk_on_error,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_set_zero_chunk_on_error";
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_set_read_zero_chunk_on_error(
+	     verification_handle->input_handle,
+	     zero_chunk_on_error,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set zero chunk on error in input handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the verify chunks only
+ * This disables calculating the digest hashes and only validates the checksum of every chunk,
+ * which does not require the chunks to be processed in order
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_set_verify_chunks_only(
+     verification_handle_t *verification_handle,
+     uint8_t verify_chunks_only,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_set_verify_chunks_only";
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	verification_handle->verify_chunks_only = verify_chunks_only;
+
+	if( verify_chunks_only != 0 )
+	{
+		verification_handle->use_chunk_data_functions = 1;
+		verification_handle->calculate_md5            = 0;
+		verification_handle->calculate_sha1           = 0;
+		verification_handle->calculate_sha256         = 0;
+	}
+	return( 1 );
+}
+
+/* Sets the sample
+ * The sample is formatted as [random:|stratified:]number_of_chunks
+ * where the default sample method is stratified
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int verification_handle_set_sample(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_set_sample";
+	size_t string_length  = 0;
+	uint64_t sample_size  = 0;
+	uint8_t sample_method = VERIFICATION_HANDLE_SAMPLE_METHOD_STRATIFIED;
+	int result            = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( ( string_length > 7 )
+	 && ( system_string_compare(
+	       string,
+	       _SYSTEM_STRING( "random:" ),
+	       7 ) == 0 ) )
+	{
+		sample_method  = VERIFICATION_HANDLE_SAMPLE_METHOD_RANDOM;
+		string        += 7;
+		string_length -= 7;
+	}
+	else if( ( string_length > 11 )
+	      && ( system_string_compare(
+	            string,
+	            _SYSTEM_STRING( "stratified:" ),
+	            11 ) == 0 ) )
+	{
+		string        += 11;
+		string_length -= 11;
+	}
+	if( ( string[ 0 ] < (system_character_t) '0' )
+	 || ( string[ 0 ] > (system_character_t) '9' ) )
+	{
+		return( 0 );
+	}
+	if( ewftools_system_string_decimal_copy_to_64_bit(
+	     string,
+	     string_length + 1,
+	     &sample_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine sample size.",
+		 function );
+
+		return( -1 );
+	}
+	if( sample_size != 0 )
+	{
+		/* Sampling only validates the checksums of the sampled chunks
+		 */
+		if( verification_handle_set_verify_chunks_only(
+		     verification_handle,
+		     1,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create calculated SHA1 digest hash string.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set verify chunks only.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
-		verification_handle->calculate_sha1 = 1;
+		verification_handle->sample_method = sample_method;
+		verification_handle->sample_size   = sample_size;
+
+		result = 1;
 	}
-	if( ( calculate_sha256 != 0 )
-	 && ( verification_handle->calculate_sha256 == 0 ) )
+	return( result );
+}
+
+/* Sets the sample seed
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int verification_handle_set_sample_seed(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_set_sample_seed";
+	size_t string_length  = 0;
+	uint64_t sample_seed  = 0;
+	int result            = 0;
+
+	if( verification_handle == NULL )
 	{
-		verification_handle->calculated_sha256_hash_string = system_string_allocate(
-		                                                      65 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
 
-		if( verification_handle->calculated_sha256_hash_string == NULL )
+		return( -1 );
+	}
+	if( string[ 0 ] != (system_character_t) '-' )
+	{
+		string_length = system_string_length(
+				 string );
+
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &sample_seed,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create calculated SHA256 digest hash string.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine sample seed.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
-		verification_handle->calculate_sha256 = 1;
+		verification_handle->sample_seed     = sample_seed;
+		verification_handle->sample_seed_set = 1;
+
+		result = 1;
 	}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	if( libcsplit_wide_split_string_free(
-	     &string_elements,
-	     error ) != 1 )
-#else
-	if( libcsplit_narrow_split_string_free(
-	     &string_elements,
-	     error ) != 1 )
-#endif
+	return( result );
+}
+
+/* Initializes the sample
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_initialize_sample(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_initialize_sample";
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->chunk_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free split string.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk size.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	return( result );
+	verification_handle->number_of_chunks = verification_handle->media_size / verification_handle->chunk_size;
 
-on_error:
-	if( string_elements != NULL )
+	if( ( verification_handle->media_size % verification_handle->chunk_size ) != 0 )
 	{
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		libcsplit_wide_split_string_free(
-		 &string_elements,
-		 NULL );
-#else
-		libcsplit_narrow_split_string_free(
-		 &string_elements,
-		 NULL );
-#endif
+		verification_handle->number_of_chunks += 1;
 	}
-	return( -1 );
+	if( verification_handle->sample_seed_set == 0 )
+	{
+		verification_handle->sample_seed     = (uint64_t) time( NULL );
+		verification_handle->sample_seed_set = 1;
+	}
+	verification_handle->sample_random_state        = verification_handle->sample_seed;
+	verification_handle->sample_chunk_index         = 0;
+	verification_handle->number_of_sampled_chunks   = 0;
+	verification_handle->number_of_corrupted_chunks = 0;
+
+	if( ( verification_handle->sample_size == 0 )
+	 || ( verification_handle->sample_size > verification_handle->number_of_chunks ) )
+	{
+		verification_handle->number_of_sample_chunks = verification_handle->number_of_chunks;
+	}
+	else
+	{
+		verification_handle->number_of_sample_chunks = verification_handle->sample_size;
+	}
+	return( 1 );
 }
 
-/* Sets the zero chunk on error
- * Returns 1 if successful or -1 on error
+/* Retrieves the next value of the sample pseudo random number generator
+ * The generator is splitmix64 so that a sample can be reproduced from its seed on every platform
+ * Returns the pseudo random value
  */
-int verification_handle_set_zero_chunk_on_error(
+uint64_t verification_handle_get_sample_random_value(
+          verification_handle_t *verification_handle )
+{
+	uint64_t value = 0;
+
+	verification_handle->sample_random_state += 0x9e3779b97f4a7c15ULL;
+
+	value = verification_handle->sample_random_state;
+	value = ( value ^ ( value >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+	value = ( value ^ ( value >> 27 ) ) * 0x94d049bb133111ebULL;
+
+	return( value ^ ( value >> 31 ) );
+}
+
+/* Retrieves the index of the next chunk of the sample
+ * The chunk indexes are returned in increasing order
+ * Returns 1 if successful, 0 if the sample is complete or -1 on error
+ */
+int verification_handle_get_next_sample_chunk_index(
      verification_handle_t *verification_handle,
-     uint8_t zero_chunk_on_error,
+     uint64_t *chunk_index,
      libcerror_error_t **error )
 {
-	static char *function = "verification_handle_set_zero_chunk_on_error";
+	static char *function            = "verification_handle_get_next_sample_chunk_index";
+	uint64_t number_of_candidates    = 0;
+	uint64_t number_of_sample_chunks = 0;
+	uint64_t sampled_index           = 0;
+	uint64_t stratum_end_index       = 0;
+	uint64_t stratum_start_index     = 0;
 
 	if( verification_handle == NULL )
 	{
@@ -3965,20 +5906,72 @@ int verification_handle_set_zero_chunk_on_error(
 
 		return( -1 );
 	}
-	if( libewf_handle_set_read_zero_chunk_on_error(
-	     verification_handle->input_handle,
-	     zero_chunk_on_error,
-	     error ) != 1 )
+	if( chunk_index == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set zero chunk on error in input handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
 		 function );
 
 		return( -1 );
 	}
+	number_of_sample_chunks = verification_handle->number_of_sample_chunks;
+	sampled_index           = verification_handle->number_of_sampled_chunks;
+
+	if( sampled_index >= number_of_sample_chunks )
+	{
+		return( 0 );
+	}
+	if( verification_handle->sample_method == VERIFICATION_HANDLE_SAMPLE_METHOD_RANDOM )
+	{
+		/* Use selection sampling, which selects every candidate chunk with a probability of:
+		 * number of chunks still needed / number of candidate chunks remaining
+		 */
+		while( verification_handle->sample_chunk_index < verification_handle->number_of_chunks )
+		{
+			number_of_candidates = verification_handle->number_of_chunks - verification_handle->sample_chunk_index;
+
+			if( ( verification_handle_get_sample_random_value(
+			       verification_handle ) % number_of_candidates ) < ( number_of_sample_chunks - sampled_index ) )
+			{
+				break;
+			}
+			verification_handle->sample_chunk_index += 1;
+		}
+		if( verification_handle->sample_chunk_index >= verification_handle->number_of_chunks )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid sample chunk index value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		*chunk_index = verification_handle->sample_chunk_index;
+
+		verification_handle->sample_chunk_index += 1;
+	}
+	else
+	{
+		/* Select one chunk from every stratum, where the strata are equally sized
+		 * and span all the chunks
+		 */
+		stratum_start_index = ( sampled_index * ( verification_handle->number_of_chunks / number_of_sample_chunks ) )
+		                    + ( ( sampled_index * ( verification_handle->number_of_chunks % number_of_sample_chunks ) ) / number_of_sample_chunks );
+
+		stratum_end_index = ( ( sampled_index + 1 ) * ( verification_handle->number_of_chunks / number_of_sample_chunks ) )
+		                  + ( ( ( sampled_index + 1 ) * ( verification_handle->number_of_chunks % number_of_sample_chunks ) ) / number_of_sample_chunks );
+
+		*chunk_index = stratum_start_index
+		             + ( verification_handle_get_sample_random_value(
+		                  verification_handle ) % ( stratum_end_index - stratum_start_index ) );
+	}
+	verification_handle->number_of_sampled_chunks += 1;
+
 	return( 1 );
 }
 
@@ -4042,6 +6035,23 @@ int verification_handle_append_read_error(
 			return( -1 );
 		}
 	}
+	if( verification_handle->process_status != NULL )
+	{
+		if( process_status_add_read_errors(
+		     verification_handle->process_status,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add read error.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( 1 );
 }
 
@@ -4595,3 +6605,151 @@ on_error:
 	return( -1 );
 }
 
+/* Calculates the square root of a non-negative value
+ * Returns the square root
+ */
+double verification_handle_square_root(
+        double value )
+{
+	double square_root = 0.0;
+	int iteration      = 0;
+
+	if( value <= 0.0 )
+	{
+		return( 0.0 );
+	}
+	square_root = ( value < 1.0 ) ? 1.0 : value;
+
+	/* Newton's method converges quadratically, 64 iterations is more than sufficient
+	 */
+	for( iteration = 0;
+	     iteration < 64;
+	     iteration++ )
+	{
+		square_root = ( square_root + ( value / square_root ) ) / 2.0;
+	}
+	return( square_root );
+}
+
+/* Prints the sample and the estimated corruption rate to a stream
+ * The estimate is bounded by the 95% Wilson score interval
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_sample_fprint(
+     verification_handle_t *verification_handle,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	const char *sample_method_string = NULL;
+	static char *function            = "verification_handle_sample_fprint";
+	double corruption_rate           = 0.0;
+	double interval_center           = 0.0;
+	double interval_denominator      = 0.0;
+	double interval_margin           = 0.0;
+	double lower_bound               = 0.0;
+	double number_of_samples         = 0.0;
+	double upper_bound               = 0.0;
+	double z_score                   = 1.96;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->sample_method == VERIFICATION_HANDLE_SAMPLE_METHOD_RANDOM )
+	{
+		sample_method_string = "random";
+	}
+	else
+	{
+		sample_method_string = "stratified";
+	}
+	fprintf(
+	 stream,
+	 "Sample verification:\n" );
+
+	fprintf(
+	 stream,
+	 "Sample method:\t\t\t%s\n",
+	 sample_method_string );
+
+	fprintf(
+	 stream,
+	 "Sample seed:\t\t\t%" PRIu64 "\n",
+	 verification_handle->sample_seed );
+
+	fprintf(
+	 stream,
+	 "Sampled chunks:\t\t\t%" PRIu64 " of %" PRIu64 "\n",
+	 verification_handle->number_of_sampled_chunks,
+	 verification_handle->number_of_chunks );
+
+	fprintf(
+	 stream,
+	 "Corrupted chunks:\t\t%" PRIu64 "\n",
+	 verification_handle->number_of_corrupted_chunks );
+
+	if( verification_handle->number_of_sampled_chunks > 0 )
+	{
+		number_of_samples = (double) verification_handle->number_of_sampled_chunks;
+		corruption_rate   = (double) verification_handle->number_of_corrupted_chunks / number_of_samples;
+
+		interval_denominator = 1.0 + ( ( z_score * z_score ) / number_of_samples );
+
+		interval_center = ( corruption_rate + ( ( z_score * z_score ) / ( 2.0 * number_of_samples ) ) )
+		                / interval_denominator;
+
+		interval_margin = ( z_score * verification_handle_square_root(
+		                               ( ( corruption_rate * ( 1.0 - corruption_rate ) ) / number_of_samples )
+		                               + ( ( z_score * z_score ) / ( 4.0 * number_of_samples * number_of_samples ) ) ) )
+		                / interval_denominator;
+
+		lower_bound = interval_center - interval_margin;
+		upper_bound = interval_center + interval_margin;
+
+		if( ( lower_bound < 0.0 )
+		 || ( verification_handle->number_of_corrupted_chunks == 0 ) )
+		{
+			lower_bound = 0.0;
+		}
+		if( ( upper_bound > 1.0 )
+		 || ( verification_handle->number_of_corrupted_chunks == verification_handle->number_of_sampled_chunks ) )
+		{
+			upper_bound = 1.0;
+		}
+		fprintf(
+		 stream,
+		 "Estimated corruption rate:\t%.4f%% (95%% confidence interval: %.4f%% - %.4f%%)\n",
+		 corruption_rate * 100.0,
+		 lower_bound * 100.0,
+		 upper_bound * 100.0 );
+
+		fprintf(
+		 stream,
+		 "Estimated corrupted chunks:\tat most %" PRIu64 "\n",
+		 (uint64_t) ( ( upper_bound * (double) verification_handle->number_of_chunks ) + 0.5 ) );
+	}
+	fprintf(
+	 stream,
+	 "\n" );
+
+	return( 1 );
+}
+
@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "digest_hash.h"
+#include "digest_hash_thread.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
@@ -34,17 +35,56 @@
 #include "log_handle.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+#include "storage_media_buffer_reorder.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+/* The maximum number of threads in the process thread pool
+ */
+#define VERIFICATION_HANDLE_MAXIMUM_NUMBER_OF_THREADS	256
+
+/* The maximum number of reader handles used to verify only the chunks
+ */
+#define VERIFICATION_HANDLE_MAXIMUM_NUMBER_OF_READER_HANDLES	32
+
 enum VERIFICATION_HANDLE_INPUT_FORMATS
 {
 	VERIFICATION_HANDLE_INPUT_FORMAT_FILES	= (int) 'f',
 	VERIFICATION_HANDLE_INPUT_FORMAT_RAW	= (int) 'r'
 };
 
+enum VERIFICATION_HANDLE_SAMPLE_METHODS
+{
+	VERIFICATION_HANDLE_SAMPLE_METHOD_RANDOM	= (int) 'r',
+	VERIFICATION_HANDLE_SAMPLE_METHOD_STRATIFIED	= (int) 's'
+};
+
+typedef struct verification_handle_read_region verification_handle_read_region_t;
+
+/* A region of the media data that is read by a single reader handle
+ */
+struct verification_handle_read_region
+{
+	/* The reader handle
+	 */
+	libewf_handle_t *reader_handle;
+
+	/* The offset of the region
+	 */
+	off64_t offset;
+
+	/* The size of the region
+	 */
+	size64_t size;
+
+	/* The result of reading the region
+	 */
+	int result;
+};
+
 typedef struct verification_handle verification_handle_t;
 
 struct verification_handle
@@ -129,10 +169,60 @@ struct verification_handle
 	 */
 	system_character_t *stored_sha256_hash_string;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The thread that calculates the SHA1 digest hash
+	 */
+	digest_hash_thread_t *sha1_hash_thread;
+
+	/* The thread that calculates the SHA256 digest hash
+	 */
+	digest_hash_thread_t *sha256_hash_thread;
+
+#endif
 	/* Value to indicate if the chunk data instead of the buffered read and write functions should be used
 	 */
 	uint8_t use_chunk_data_functions;
 
+	/* Value to indicate only the chunk checksums should be verified
+	 */
+	uint8_t verify_chunks_only;
+
+	/* The sample method
+	 */
+	uint8_t sample_method;
+
+	/* The number of chunks to sample, where 0 represents all chunks
+	 */
+	uint64_t sample_size;
+
+	/* The sample seed
+	 */
+	uint64_t sample_seed;
+
+	/* Value to indicate the sample seed was set
+	 */
+	uint8_t sample_seed_set;
+
+	/* The state of the sample pseudo random number generator
+	 */
+	uint64_t sample_random_state;
+
+	/* The number of chunks in the sample
+	 */
+	uint64_t number_of_sample_chunks;
+
+	/* The index of the next candidate chunk of the sample
+	 */
+	uint64_t sample_chunk_index;
+
+	/* The number of sampled chunks
+	 */
+	uint64_t number_of_sampled_chunks;
+
+	/* The number of corrupted chunks
+	 */
+	uint64_t number_of_corrupted_chunks;
+
 	/* The process buffer size
 	 */
 	size_t process_buffer_size;
@@ -141,6 +231,10 @@ struct verification_handle
 	 */
 	int number_of_threads;
 
+	/* The memory limit of the storage media buffers, 0 represents the default
+	 */
+	size64_t memory_limit;
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
 	/* The process thread pool
@@ -151,16 +245,54 @@ struct verification_handle
 	 */
 	libcthreads_thread_pool_t *output_thread_pool;
 
-	/* The output list
+	/* The output reorder window
 	 */
-	libcdata_list_t *output_list;
+	storage_media_buffer_reorder_t *output_reorder;
 
 	/* The storage media buffer queue
 	 */
-	libcthreads_queue_t *storage_media_buffer_queue;
+	storage_media_buffer_queue_t *storage_media_buffer_queue;
+
+	/* The read thread pool
+	 */
+	libcthreads_thread_pool_t *read_thread_pool;
+
+	/* The reader handles, in addition to the input handle
+	 */
+	libewf_handle_t **reader_handles;
+
+	/* The number of reader handles
+	 */
+	int number_of_reader_handles;
+
+	/* The read regions
+	 */
+	verification_handle_read_region_t *read_regions;
+
+	/* The process thread pool shared with other verification handles
+	 * The shared process thread pool is not owned by the verification handle
+	 */
+	libcthreads_thread_pool_t *shared_process_thread_pool;
+
+	/* The number of storage media buffers pushed onto the shared process thread pool
+	 * that have not been processed
+	 */
+	int number_of_shared_process_jobs;
+
+	/* The shared process jobs mutex
+	 */
+	libcthreads_mutex_t *shared_process_jobs_mutex;
+
+	/* The shared process jobs condition
+	 */
+	libcthreads_condition_t *shared_process_jobs_condition;
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
+	/* The maximum number of (concurrent) open file handles, 0 represents the default
+	 */
+	int maximum_number_of_open_handles;
+
 	/* The libewf input handle
 	 */
 	libewf_handle_t *input_handle;
@@ -169,6 +301,14 @@ struct verification_handle
 	 */
 	size64_t media_size;
 
+	/* The number of bytes to verify
+	 */
+	size64_t verify_size;
+
+	/* The number of chunks
+	 */
+	uint64_t number_of_chunks;
+
 	/* The chunk size
 	 */
 	size32_t chunk_size;
@@ -189,6 +329,10 @@ struct verification_handle
 	 */
 	process_status_t *process_status;
 
+	/* The telemetry stream
+	 */
+	FILE *telemetry_stream;
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
@@ -213,6 +357,11 @@ int verification_handle_set_maximum_number_of_open_handles(
      int maximum_number_of_open_handles,
      libcerror_error_t **error );
 
+int verification_handle_copy_settings(
+     verification_handle_t *destination_verification_handle,
+     verification_handle_t *source_verification_handle,
+     libcerror_error_t **error );
+
 int verification_handle_open_input(
      verification_handle_t *verification_handle,
      system_character_t * const * filenames,
@@ -248,12 +397,47 @@ int verification_handle_process_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      verification_handle_t *verification_handle );
 
+int verification_handle_shared_process_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     void *arguments );
+
 int verification_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      verification_handle_t *verification_handle );
 
-int verification_handle_empty_output_list(
+int verification_handle_set_shared_process_thread_pool(
      verification_handle_t *verification_handle,
+     libcthreads_thread_pool_t *shared_process_thread_pool,
+     libcerror_error_t **error );
+
+int verification_handle_push_storage_media_buffer(
+     verification_handle_t *verification_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
+int verification_handle_wait_for_shared_process_jobs(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error );
+
+int verification_handle_set_telemetry_buffer_values(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error );
+
+int verification_handle_open_reader_handles(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error );
+
+int verification_handle_close_reader_handles(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error );
+
+int verification_handle_read_region_callback(
+     verification_handle_read_region_t *read_region,
+     verification_handle_t *verification_handle );
+
+int verification_handle_read_regions(
+     verification_handle_t *verification_handle,
+     size_t process_buffer_size,
      libcerror_error_t **error );
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
@@ -315,6 +499,11 @@ int verification_handle_set_number_of_threads(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int verification_handle_set_memory_limit(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int verification_handle_set_additional_digest_types(
      verification_handle_t *verification_handle,
      const system_character_t *string,
@@ -325,6 +514,33 @@ int verification_handle_set_zero_chunk_on_error(
      uint8_t zero_chunk_on_error,
      libcerror_error_t **error );
 
+int verification_handle_set_verify_chunks_only(
+     verification_handle_t *verification_handle,
+     uint8_t verify_chunks_only,
+     libcerror_error_t **error );
+
+int verification_handle_set_sample(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int verification_handle_set_sample_seed(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int verification_handle_initialize_sample(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error );
+
+uint64_t verification_handle_get_sample_random_value(
+          verification_handle_t *verification_handle );
+
+int verification_handle_get_next_sample_chunk_index(
+     verification_handle_t *verification_handle,
+     uint64_t *chunk_index,
+     libcerror_error_t **error );
+
 int verification_handle_append_read_error(
       verification_handle_t *verification_handle,
       off64_t start_offset,
@@ -346,6 +562,14 @@ int verification_handle_checksum_errors_fprint(
      FILE *stream,
      libcerror_error_t **error );
 
+double verification_handle_square_root(
+        double value );
+
+int verification_handle_sample_fprint(
+     verification_handle_t *verification_handle,
+     FILE *stream,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -26,22 +26,29 @@
 
 #include "libewf_checksum.h"
 #include "libewf_chunk_data.h"
+#include "libewf_chunk_data_pool.h"
 #include "libewf_compression.h"
 #include "libewf_definitions.h"
+#include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
 #include "libewf_libcnotify.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
+#include "libewf_probes.h"
+#include "libewf_statistics.h"
 #include "libewf_types.h"
 #include "libewf_unused.h"
 
 /* Creates chunk data
  * Make sure the value chunk_data is referencing, is set to NULL
+ * The data buffers are retrieved from and released to the chunk data pool if not NULL
+ * The chunk data holds a reference to the chunk data pool until it is freed
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_data_initialize(
      libewf_chunk_data_t **chunk_data,
+     libewf_chunk_data_pool_t *chunk_data_pool,
      size32_t chunk_size,
      uint8_t clear_data,
      libcerror_error_t **error )
@@ -116,6 +123,23 @@ int libewf_chunk_data_initialize(
 
 		return( -1 );
 	}
+	if( chunk_data_pool != NULL )
+	{
+		if( libewf_chunk_data_pool_add_reference(
+		     chunk_data_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add reference to chunk data pool.",
+			 function );
+
+			goto on_error;
+		}
+		( *chunk_data )->chunk_data_pool = chunk_data_pool;
+	}
 	/* Reserve 4 bytes for the chunk checksum
 	 */
 	allocated_data_size = (size_t) chunk_size + 4;
@@ -128,10 +152,12 @@ int libewf_chunk_data_initialize(
 	}
 	allocated_data_size = ( allocated_data_size / 16 ) * 16;
 
-	( *chunk_data )->data = (uint8_t *) memory_allocate(
-					     sizeof( uint8_t ) * allocated_data_size );
-
-	if( ( *chunk_data )->data == NULL )
+	if( libewf_chunk_data_pool_get_buffer(
+	     chunk_data_pool,
+	     allocated_data_size,
+	     &( ( *chunk_data )->data ),
+	     &allocated_data_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -170,9 +196,16 @@ on_error:
 	{
 		if( ( *chunk_data )->data != NULL )
 		{
-			memory_free(
-			 ( *chunk_data )->data );
+			libewf_chunk_data_pool_release_buffer(
+			 ( *chunk_data )->chunk_data_pool,
+			 &( ( *chunk_data )->data ),
+			 allocated_data_size,
+			 NULL );
 		}
+		libewf_chunk_data_pool_free(
+		 &( ( *chunk_data )->chunk_data_pool ),
+		 NULL );
+
 		memory_free(
 		 *chunk_data );
 
@@ -189,6 +222,7 @@ int libewf_chunk_data_free(
      libcerror_error_t **error )
 {
 	static char *function = "libewf_chunk_data_free";
+	int result            = 1;
 
 	if( chunk_data == NULL )
 	{
@@ -205,23 +239,56 @@ int libewf_chunk_data_free(
 	{
 		if( ( ( *chunk_data )->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) != 0 )
 		{
-			if( ( *chunk_data )->data != NULL )
+			if( libewf_chunk_data_pool_release_buffer(
+			     ( *chunk_data )->chunk_data_pool,
+			     &( ( *chunk_data )->data ),
+			     ( *chunk_data )->allocated_data_size,
+			     error ) != 1 )
 			{
-				memory_free(
-				 ( *chunk_data )->data );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to release data.",
+				 function );
+
+				result = -1;
 			}
 		}
-		if( ( *chunk_data )->compressed_data != NULL )
+		if( libewf_chunk_data_pool_release_buffer(
+		     ( *chunk_data )->chunk_data_pool,
+		     &( ( *chunk_data )->compressed_data ),
+		     ( *chunk_data )->allocated_compressed_data_size,
+		     error ) != 1 )
 		{
-			memory_free(
-			 ( *chunk_data )->compressed_data );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release compressed data.",
+			 function );
+
+			result = -1;
+		}
+		if( libewf_chunk_data_pool_free(
+		     &( ( *chunk_data )->chunk_data_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data pool reference.",
+			 function );
+
+			result = -1;
 		}
 		memory_free(
 		 *chunk_data );
 
 		*chunk_data = NULL;
 	}
-	return( 1 );
+	return( result );
 }
 
 /* Clones the chunk data
@@ -295,15 +362,36 @@ int libewf_chunk_data_clone(
 
 		return( -1 );
 	}
+	( *destination_chunk_data )->chunk_data_pool = NULL;
 	( *destination_chunk_data )->data            = NULL;
 	( *destination_chunk_data )->compressed_data = NULL;
 
-	if( source_chunk_data->data != NULL )
+	if( source_chunk_data->chunk_data_pool != NULL )
 	{
-		( *destination_chunk_data )->data = (uint8_t *) memory_allocate(
-		                                                 sizeof( uint8_t ) * source_chunk_data->allocated_data_size );
+		if( libewf_chunk_data_pool_add_reference(
+		     source_chunk_data->chunk_data_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add reference to chunk data pool.",
+			 function );
 
-		if( ( *destination_chunk_data )->data == NULL )
+			goto on_error;
+		}
+		( *destination_chunk_data )->chunk_data_pool = source_chunk_data->chunk_data_pool;
+	}
+
+	if( source_chunk_data->data != NULL )
+	{
+		if( libewf_chunk_data_pool_get_buffer(
+		     source_chunk_data->chunk_data_pool,
+		     source_chunk_data->allocated_data_size,
+		     &( ( *destination_chunk_data )->data ),
+		     &( ( *destination_chunk_data )->allocated_data_size ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -331,10 +419,12 @@ int libewf_chunk_data_clone(
 	}
 	if( source_chunk_data->compressed_data != NULL )
 	{
-		( *destination_chunk_data )->compressed_data = (uint8_t *) memory_allocate(
-		                                                            sizeof( uint8_t ) * source_chunk_data->compressed_data_size );
-
-		if( ( *destination_chunk_data )->compressed_data == NULL )
+		if( libewf_chunk_data_pool_get_buffer(
+		     source_chunk_data->chunk_data_pool,
+		     source_chunk_data->compressed_data_size,
+		     &( ( *destination_chunk_data )->compressed_data ),
+		     &( ( *destination_chunk_data )->allocated_compressed_data_size ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -367,14 +457,24 @@ on_error:
 	{
 		if( ( *destination_chunk_data )->compressed_data != NULL )
 		{
-			memory_free(
-			 ( *destination_chunk_data )->compressed_data );
+			libewf_chunk_data_pool_release_buffer(
+			 ( *destination_chunk_data )->chunk_data_pool,
+			 &( ( *destination_chunk_data )->compressed_data ),
+			 ( *destination_chunk_data )->allocated_compressed_data_size,
+			 NULL );
 		}
 		if( ( *destination_chunk_data )->data != NULL )
 		{
-			memory_free(
-			 ( *destination_chunk_data )->data );
+			libewf_chunk_data_pool_release_buffer(
+			 ( *destination_chunk_data )->chunk_data_pool,
+			 &( ( *destination_chunk_data )->data ),
+			 ( *destination_chunk_data )->allocated_data_size,
+			 NULL );
 		}
+		libewf_chunk_data_pool_free(
+		 &( ( *destination_chunk_data )->chunk_data_pool ),
+		 NULL );
+
 		memory_free(
 		 *destination_chunk_data );
 
@@ -723,10 +823,12 @@ int libewf_chunk_data_pack(
 		{
 			chunk_data->compressed_data_size = 2 * chunk_data->chunk_size;
 		}
-		chunk_data->compressed_data = (uint8_t *) memory_allocate(
-		                                           sizeof( uint8_t ) * chunk_data->compressed_data_size );
-
-		if( chunk_data->compressed_data == NULL )
+		if( libewf_chunk_data_pool_get_buffer(
+		     chunk_data->chunk_data_pool,
+		     chunk_data->compressed_data_size,
+		     &( chunk_data->compressed_data ),
+		     &( chunk_data->allocated_compressed_data_size ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -809,6 +911,10 @@ int libewf_chunk_data_pack(
 			safe_compressed_data_size = chunk_data->compressed_data_size;
 
 /* TODO add a light weight entropy test */
+			LIBEWF_PROBE_COMPRESS_ENTRY(
+			 chunk_data->data_size,
+			 io_handle->compression_level );
+
 			result = libewf_compress_data(
 				  chunk_data->compressed_data,
 				  &safe_compressed_data_size,
@@ -818,6 +924,11 @@ int libewf_chunk_data_pack(
 				  chunk_data->data_size,
 				  error );
 
+			LIBEWF_PROBE_COMPRESS_RETURN(
+			 chunk_data->data_size,
+			 safe_compressed_data_size,
+			 result );
+
 			if( result == -1 )
 			{
 				libcerror_error_set(
@@ -1006,14 +1117,29 @@ int libewf_chunk_data_pack(
 	{
 		if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) != 0 )
 		{
-			memory_free(
-			 chunk_data->data );
+			if( libewf_chunk_data_pool_release_buffer(
+			     chunk_data->chunk_data_pool,
+			     &( chunk_data->data ),
+			     chunk_data->allocated_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to release data.",
+				 function );
+
+				goto on_error;
+			}
 		}
-		chunk_data->data  = chunk_data->compressed_data;
-		chunk_data->flags = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+		chunk_data->data                = chunk_data->compressed_data;
+		chunk_data->allocated_data_size = chunk_data->allocated_compressed_data_size;
+		chunk_data->flags               = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
 
-		chunk_data->compressed_data      = NULL;
-		chunk_data->compressed_data_size = 0;
+		chunk_data->compressed_data                = NULL;
+		chunk_data->compressed_data_size           = 0;
+		chunk_data->allocated_compressed_data_size = 0;
 	}
 	chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_PACKED;
 
@@ -1022,12 +1148,14 @@ int libewf_chunk_data_pack(
 on_error:
 	if( chunk_data->compressed_data != NULL )
 	{
-		memory_free(
-		 chunk_data->compressed_data );
-
-		chunk_data->compressed_data = NULL;
+		libewf_chunk_data_pool_release_buffer(
+		 chunk_data->chunk_data_pool,
+		 &( chunk_data->compressed_data ),
+		 chunk_data->allocated_compressed_data_size,
+		 NULL );
 	}
-	chunk_data->compressed_data_size = 0;
+	chunk_data->compressed_data_size           = 0;
+	chunk_data->allocated_compressed_data_size = 0;
 
 	return( -1 );
 }
@@ -1043,7 +1171,9 @@ int libewf_chunk_data_unpack(
 {
 	static char *function        = "libewf_chunk_data_unpack";
 	size_t remaining_chunk_size  = 0;
+	uint64_t start_timestamp     = 0;
 	uint32_t calculated_checksum = 0;
+	int result                   = 0;
 
 	if( chunk_data == NULL )
 	{
@@ -1109,8 +1239,11 @@ int libewf_chunk_data_unpack(
 
 				goto on_error;
 			}
-			chunk_data->compressed_data      = chunk_data->data;
-			chunk_data->compressed_data_size = chunk_data->data_size;
+			chunk_data->compressed_data                = chunk_data->data;
+			chunk_data->compressed_data_size           = chunk_data->data_size;
+			chunk_data->allocated_compressed_data_size = chunk_data->allocated_data_size;
+
+			chunk_data->data = NULL;
 
 			/* Reserve 4 bytes for the checksum
 			 */
@@ -1124,10 +1257,12 @@ int libewf_chunk_data_unpack(
 			}
 			chunk_data->allocated_data_size = ( chunk_data->allocated_data_size / 16 ) * 16;
 
-			chunk_data->data = (uint8_t *) memory_allocate(
-			                                sizeof( uint8_t ) * chunk_data->allocated_data_size );
-
-			if( chunk_data->data == NULL )
+			if( libewf_chunk_data_pool_get_buffer(
+			     chunk_data->chunk_data_pool,
+			     chunk_data->allocated_data_size,
+			     &( chunk_data->data ),
+			     &( chunk_data->allocated_data_size ),
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
@@ -1201,13 +1336,47 @@ int libewf_chunk_data_unpack(
 			}
 			else
 			{
-				if( libewf_decompress_data(
-				     chunk_data->compressed_data,
-				     chunk_data->compressed_data_size,
-				     io_handle->compression_method,
-				     chunk_data->data,
-				     &( chunk_data->data_size ),
-				     error ) != 1 )
+				/* The statistics should not cause a read to fail
+				 */
+				if( ( io_handle->statistics_flags & LIBEWF_STATISTICS_FLAG_MEASURE_DECOMPRESSION_TIME ) != 0 )
+				{
+					if( libewf_statistics_get_timestamp(
+					     &start_timestamp,
+					     NULL ) != 1 )
+					{
+						start_timestamp = 0;
+					}
+				}
+				LIBEWF_PROBE_DECOMPRESS_ENTRY(
+				 chunk_data->compressed_data_size,
+				 chunk_data->chunk_size );
+
+				result = libewf_decompress_data(
+				          chunk_data->compressed_data,
+				          chunk_data->compressed_data_size,
+				          io_handle->compression_method,
+				          chunk_data->data,
+				          &( chunk_data->data_size ),
+				          error );
+
+				LIBEWF_PROBE_DECOMPRESS_RETURN(
+				 chunk_data->compressed_data_size,
+				 chunk_data->data_size,
+				 result );
+
+				if( start_timestamp != 0 )
+				{
+					libewf_statistics_add_decompression_time(
+					 &( io_handle->statistics ),
+					 start_timestamp );
+				}
+				if( result == 1 )
+				{
+					libewf_statistics_add(
+					 io_handle->statistics.number_of_bytes_decompressed,
+					 chunk_data->data_size );
+				}
+				else
 				{
 					libcerror_error_set(
 					 error,
@@ -1232,6 +1401,10 @@ int libewf_chunk_data_unpack(
 
 					chunk_data->data_size    = (size_t) chunk_data->chunk_size;
 					chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+
+					libewf_statistics_add(
+					 io_handle->statistics.number_of_checksum_errors,
+					 1 );
 				}
 			}
 		}
@@ -1299,6 +1472,10 @@ int libewf_chunk_data_unpack(
 
 				chunk_data->data_size    = (size_t) chunk_data->chunk_size;
 				chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+
+				libewf_statistics_add(
+				 io_handle->statistics.number_of_checksum_errors,
+				 1 );
 			}
 		}
 		chunk_data->range_flags &= ~( LIBEWF_RANGE_FLAG_IS_PACKED );
@@ -1328,14 +1505,19 @@ on_error:
 	{
 		if( chunk_data->data != NULL )
 		{
-			memory_free(
-			 chunk_data->data );
+			libewf_chunk_data_pool_release_buffer(
+			 chunk_data->chunk_data_pool,
+			 &( chunk_data->data ),
+			 chunk_data->allocated_data_size,
+			 NULL );
 		}
-		chunk_data->data      = chunk_data->compressed_data;
-		chunk_data->data_size = chunk_data->compressed_data_size;
+		chunk_data->data                = chunk_data->compressed_data;
+		chunk_data->data_size           = chunk_data->compressed_data_size;
+		chunk_data->allocated_data_size = chunk_data->allocated_compressed_data_size;
 
-		chunk_data->compressed_data      = NULL;
-		chunk_data->compressed_data_size = 0;
+		chunk_data->compressed_data                = NULL;
+		chunk_data->compressed_data_size           = 0;
+		chunk_data->allocated_compressed_data_size = 0;
 	}
 	return( -1 );
 }
@@ -1586,6 +1768,29 @@ ssize_t libewf_chunk_data_write(
 	}
 	write_size = chunk_data->data_size + chunk_data->padding_size;
 
+	/* A reserved chunk only advances the offset in the segment file
+	 * the chunk data is written at the reserved offset later
+	 */
+	if( ( chunk_data->chunk_io_flags & LIBEWF_CHUNK_IO_FLAG_IS_RESERVED ) != 0 )
+	{
+		if( libbfio_pool_seek_offset(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     (off64_t) write_size,
+		     SEEK_CUR,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek past reserved chunk data.",
+			 function );
+
+			return( -1 );
+		}
+		return( (ssize_t) write_size );
+	}
 	/* Write the chunk data to the segment file
 	 */
 	write_count = libbfio_pool_write_buffer(
@@ -1992,6 +2197,7 @@ int libewf_chunk_data_read_element_data(
 	}
 	if( libewf_chunk_data_initialize(
 	     &chunk_data,
+	     io_handle->chunk_data_pool,
 	     io_handle->chunk_size,
 	     0,
 	     error ) != 1 )
@@ -2016,6 +2222,22 @@ int libewf_chunk_data_read_element_data(
 		 file_io_pool_entry );
 	}
 #endif
+	if( libewf_io_handle_open_segment_file(
+	     io_handle,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO pool entry: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
 	read_count = libewf_chunk_data_read_from_file_io_pool(
 		      chunk_data,
 		      file_io_pool,
@@ -2036,6 +2258,14 @@ int libewf_chunk_data_read_element_data(
 
 		goto on_error;
 	}
+	libewf_statistics_add(
+	 io_handle->statistics.number_of_chunk_reads,
+	 1 );
+
+	libewf_statistics_add(
+	 io_handle->statistics.number_of_bytes_read,
+	 read_count );
+
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
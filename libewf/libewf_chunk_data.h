@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_chunk_data_pool.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
@@ -39,6 +40,10 @@ typedef struct libewf_chunk_data libewf_chunk_data_t;
 
 struct libewf_chunk_data
 {
+	/* The chunk data pool
+	 */
+	libewf_chunk_data_pool_t *chunk_data_pool;
+
 	/* The chunk size
 	 */
 	size32_t chunk_size;
@@ -67,6 +72,10 @@ struct libewf_chunk_data
 	 */
 	size_t compressed_data_size;
 
+	/* The allocated compressed data size
+	 */
+	size_t allocated_compressed_data_size;
+
 	/* The padding size
 	 */
 	size_t padding_size;
@@ -90,6 +99,7 @@ struct libewf_chunk_data
 
 int libewf_chunk_data_initialize(
      libewf_chunk_data_t **chunk_data,
+     libewf_chunk_data_pool_t *chunk_data_pool,
      size32_t chunk_size,
      uint8_t clear_data,
      libcerror_error_t **error );
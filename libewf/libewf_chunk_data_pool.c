@@ -0,0 +1,670 @@
+/*
+ * Chunk data pool functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data_pool.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+/* Creates a chunk data pool
+ * Make sure the value chunk_data_pool is referencing, is set to NULL
+ * The chunk data pool is created with a single reference
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_initialize(
+     libewf_chunk_data_pool_t **chunk_data_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_pool_initialize";
+
+	if( chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk data pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_data_pool = memory_allocate_structure(
+	                    libewf_chunk_data_pool_t );
+
+	if( *chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk data pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_data_pool,
+	     0,
+	     sizeof( libewf_chunk_data_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk data pool.",
+		 function );
+
+		memory_free(
+		 *chunk_data_pool );
+
+		*chunk_data_pool = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *chunk_data_pool )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to intialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *chunk_data_pool )->number_of_references = 1;
+
+	return( 1 );
+
+on_error:
+	if( *chunk_data_pool != NULL )
+	{
+		memory_free(
+		 *chunk_data_pool );
+
+		*chunk_data_pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk data pool
+ * Releases a reference to the chunk data pool, the chunk data pool
+ * and its free buffers are only freed when the last reference is released
+ * This allows chunk data, such as that of a data chunk, to outlive the handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_free(
+     libewf_chunk_data_pool_t **chunk_data_pool,
+     libcerror_error_t **error )
+{
+	static char *function    = "libewf_chunk_data_pool_free";
+	int number_of_references = 0;
+	int result               = 1;
+
+	if( chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data_pool == NULL )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     ( *chunk_data_pool )->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	( *chunk_data_pool )->number_of_references -= 1;
+
+	number_of_references = ( *chunk_data_pool )->number_of_references;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     ( *chunk_data_pool )->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( number_of_references <= 0 )
+	{
+		if( libewf_chunk_data_pool_clear(
+		     *chunk_data_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to clear chunk data pool.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *chunk_data_pool )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *chunk_data_pool );
+	}
+	*chunk_data_pool = NULL;
+
+	return( result );
+}
+
+/* Adds a reference to the chunk data pool
+ * Every reference must be released with libewf_chunk_data_pool_free
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_add_reference(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_pool_add_reference";
+
+	if( chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_data_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	chunk_data_pool->number_of_references += 1;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_data_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Clears the chunk data pool
+ * Frees the buffers in the free lists
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_clear(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer       = NULL;
+	static char *function = "libewf_chunk_data_pool_clear";
+	int size_class_index  = 0;
+
+	if( chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_data_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( size_class_index = 0;
+	     size_class_index < LIBEWF_CHUNK_DATA_POOL_NUMBER_OF_SIZE_CLASSES;
+	     size_class_index++ )
+	{
+		while( chunk_data_pool->free_lists[ size_class_index ] != NULL )
+		{
+			buffer = chunk_data_pool->free_lists[ size_class_index ];
+
+			chunk_data_pool->free_lists[ size_class_index ] = *( (uint8_t **) buffer );
+
+			memory_free(
+			 buffer );
+		}
+		chunk_data_pool->number_of_free_buffers[ size_class_index ] = 0;
+	}
+	chunk_data_pool->free_size = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_data_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Determines the size class of a buffer size
+ * Returns 1 if successful, 0 if the buffer size is not within a size class or -1 on error
+ */
+int libewf_chunk_data_pool_get_size_class(
+     size_t buffer_size,
+     int *size_class,
+     size_t *size_class_buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function   = "libewf_chunk_data_pool_get_size_class";
+	size_t safe_buffer_size = 0;
+	int safe_size_class     = 0;
+
+	if( size_class == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size class.",
+		 function );
+
+		return( -1 );
+	}
+	if( size_class_buffer_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size class buffer size.",
+		 function );
+
+		return( -1 );
+	}
+	for( safe_size_class = LIBEWF_CHUNK_DATA_POOL_MINIMUM_SIZE_CLASS;
+	     safe_size_class <= LIBEWF_CHUNK_DATA_POOL_MAXIMUM_SIZE_CLASS;
+	     safe_size_class++ )
+	{
+		safe_buffer_size = ( (size_t) 1 << safe_size_class ) + LIBEWF_CHUNK_DATA_POOL_BUFFER_PADDING_SIZE;
+
+		if( buffer_size <= safe_buffer_size )
+		{
+			*size_class             = safe_size_class;
+			*size_class_buffer_size = safe_buffer_size;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Retrieves a buffer of at least the buffer size
+ * If the chunk data pool is NULL or the buffer size is not within a size class
+ * the buffer is allocated with the buffer size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_get_buffer(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     size_t buffer_size,
+     uint8_t **buffer,
+     size_t *allocated_buffer_size,
+     libcerror_error_t **error )
+{
+	uint8_t *safe_buffer   = NULL;
+	static char *function  = "libewf_chunk_data_pool_get_buffer";
+	size_t size_class_size = 0;
+	int result             = 0;
+	int size_class         = 0;
+	int size_class_index   = 0;
+
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocated_buffer_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocated buffer size.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_pool != NULL )
+	{
+		result = libewf_chunk_data_pool_get_size_class(
+		          buffer_size,
+		          &size_class,
+		          &size_class_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine size class.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( result != 0 )
+	{
+		size_class_index = size_class - LIBEWF_CHUNK_DATA_POOL_MINIMUM_SIZE_CLASS;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     chunk_data_pool->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		safe_buffer = chunk_data_pool->free_lists[ size_class_index ];
+
+		if( safe_buffer != NULL )
+		{
+			chunk_data_pool->free_lists[ size_class_index ] = *( (uint8_t **) safe_buffer );
+
+			chunk_data_pool->number_of_free_buffers[ size_class_index ] -= 1;
+			chunk_data_pool->free_size                                  -= size_class_size;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     chunk_data_pool->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			if( safe_buffer != NULL )
+			{
+				memory_free(
+				 safe_buffer );
+			}
+			return( -1 );
+		}
+#endif
+		buffer_size = size_class_size;
+	}
+	if( safe_buffer == NULL )
+	{
+		safe_buffer = (uint8_t *) memory_allocate(
+		                           sizeof( uint8_t ) * buffer_size );
+
+		if( safe_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	*buffer                = safe_buffer;
+	*allocated_buffer_size = buffer_size;
+
+	return( 1 );
+}
+
+/* Releases a buffer retrieved by libewf_chunk_data_pool_get_buffer
+ * The buffer is added to the free list of its size class or freed
+ * if the chunk data pool is NULL or the free list is full
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_release_buffer(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     uint8_t **buffer,
+     size_t allocated_buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function  = "libewf_chunk_data_pool_release_buffer";
+	size_t size_class_size = 0;
+	int result             = 0;
+	int size_class         = 0;
+	int size_class_index   = 0;
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer == NULL )
+	{
+		return( 1 );
+	}
+	if( chunk_data_pool != NULL )
+	{
+		result = libewf_chunk_data_pool_get_size_class(
+		          allocated_buffer_size,
+		          &size_class,
+		          &size_class_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine size class.",
+			 function );
+
+			return( -1 );
+		}
+		/* Only buffers allocated with the size of a size class can be reused
+		 */
+		else if( ( result != 0 )
+		      && ( allocated_buffer_size != size_class_size ) )
+		{
+			result = 0;
+		}
+	}
+	if( result != 0 )
+	{
+		size_class_index = size_class - LIBEWF_CHUNK_DATA_POOL_MINIMUM_SIZE_CLASS;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     chunk_data_pool->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		if( ( chunk_data_pool->number_of_free_buffers[ size_class_index ] < LIBEWF_CHUNK_DATA_POOL_MAXIMUM_NUMBER_OF_FREE_BUFFERS )
+		 && ( ( chunk_data_pool->free_size + size_class_size ) <= (size_t) LIBEWF_CHUNK_DATA_POOL_MAXIMUM_FREE_SIZE ) )
+		{
+			*( (uint8_t **) *buffer ) = chunk_data_pool->free_lists[ size_class_index ];
+
+			chunk_data_pool->free_lists[ size_class_index ] = *buffer;
+
+			chunk_data_pool->number_of_free_buffers[ size_class_index ] += 1;
+			chunk_data_pool->free_size                                  += size_class_size;
+
+			*buffer = NULL;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     chunk_data_pool->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+	}
+	if( *buffer != NULL )
+	{
+		memory_free(
+		 *buffer );
+
+		*buffer = NULL;
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,106 @@
+/*
+ * Chunk data pool functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_DATA_POOL_H )
+#define _LIBEWF_CHUNK_DATA_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_chunk_data_pool libewf_chunk_data_pool_t;
+
+struct libewf_chunk_data_pool
+{
+	/* The free lists per size class
+	 * the first bytes of a free buffer contain the next free buffer
+	 */
+	uint8_t *free_lists[ LIBEWF_CHUNK_DATA_POOL_NUMBER_OF_SIZE_CLASSES ];
+
+	/* The number of free buffers per size class
+	 */
+	int number_of_free_buffers[ LIBEWF_CHUNK_DATA_POOL_NUMBER_OF_SIZE_CLASSES ];
+
+	/* The size of all the free buffers
+	 */
+	size_t free_size;
+
+	/* The number of references
+	 * the io handle and every chunk data that retrieved its buffers
+	 * from the pool hold a reference
+	 */
+	int number_of_references;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libewf_chunk_data_pool_initialize(
+     libewf_chunk_data_pool_t **chunk_data_pool,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_free(
+     libewf_chunk_data_pool_t **chunk_data_pool,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_add_reference(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_clear(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_get_size_class(
+     size_t buffer_size,
+     int *size_class,
+     size_t *size_class_buffer_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_get_buffer(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     size_t buffer_size,
+     uint8_t **buffer,
+     size_t *allocated_buffer_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_release_buffer(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     uint8_t **buffer,
+     size_t allocated_buffer_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_DATA_POOL_H ) */
+
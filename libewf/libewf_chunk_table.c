@@ -33,8 +33,10 @@
 #include "libewf_libcerror.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
+#include "libewf_probes.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
+#include "libewf_statistics.h"
 
 /* Creates a chunk table
  * Make sure the value chunk_table is referencing, is set to NULL
@@ -739,6 +741,8 @@ int libewf_chunk_table_chunk_exists_for_offset(
 
 /* Retrieves the chunk data of a chunk at a specific offset
  * Adds a checksum error if the data is corrupted
+ * If unpack_chunk_data is 0 the chunk data is not unpacked, which leaves
+ * validating the checksum of stored chunk data to the caller
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_table_get_chunk_data_by_offset(
@@ -751,6 +755,7 @@ int libewf_chunk_table_get_chunk_data_by_offset(
      libfcache_cache_t *chunk_groups_cache,
      libfcache_cache_t *chunks_cache,
      off64_t offset,
+     uint8_t unpack_chunk_data,
      libewf_chunk_data_t **chunk_data,
      off64_t *chunk_data_offset,
      libcerror_error_t **error )
@@ -770,6 +775,10 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 	int chunks_list_index                     = 0;
 	int result                                = 0;
 
+#if defined( LIBEWF_PROBES_ENABLED )
+	uint64_t number_of_chunk_reads            = 0;
+#endif
+
 	if( chunk_table == NULL )
 	{
 		libcerror_error_set(
@@ -825,6 +834,14 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 
 		return( -1 );
 	}
+#if defined( LIBEWF_PROBES_ENABLED )
+	number_of_chunk_reads = libewf_statistics_load(
+	                         io_handle->statistics.number_of_chunk_reads );
+#endif
+	LIBEWF_PROBE_CHUNK_FETCH_ENTRY(
+	 chunk_index,
+	 offset );
+
 	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
 		  chunk_table,
 		  file_io_pool,
@@ -865,6 +882,10 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 
 			goto on_error;
 		}
+		libewf_statistics_add(
+		 io_handle->statistics.number_of_chunk_lookups,
+		 1 );
+
 		result = libfdata_list_get_element_value_at_offset(
 			  chunk_group->chunks_list,
 			  (intptr_t *) file_io_pool,
@@ -906,20 +927,23 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 
 			goto on_error;
 		}
-		if( libewf_chunk_data_unpack(
-		     *chunk_data,
-		     io_handle,
-		     error ) != 1 )
+		if( unpack_chunk_data != 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to unpack chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
-
-			goto on_error;
+			if( libewf_chunk_data_unpack(
+			     *chunk_data,
+			     io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to unpack chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
 		}
 		if( ( ( *chunk_data )->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
 		{
@@ -939,6 +963,7 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 		}
 		if( libewf_chunk_data_initialize(
 		     &corrupted_chunk_data,
+		     io_handle->chunk_data_pool,
 		     media_values->chunk_size,
 		     1,
 		     error ) != 1 )
@@ -1030,6 +1055,12 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 			goto on_error;
 		}
 	}
+	LIBEWF_PROBE_CHUNK_FETCH_RETURN(
+	 chunk_index,
+	 ( *chunk_data )->data_size,
+	 libewf_statistics_load( io_handle->statistics.number_of_chunk_reads ) == number_of_chunk_reads,
+	 1 );
+
 	return( 1 );
 
 on_error:
@@ -1041,6 +1072,12 @@ on_error:
 	}
 	*chunk_data = NULL;
 
+	LIBEWF_PROBE_CHUNK_FETCH_RETURN(
+	 chunk_index,
+	 0,
+	 0,
+	 -1 );
+
 	return( -1 );
 }
 
@@ -128,6 +128,7 @@ int libewf_chunk_table_get_chunk_data_by_offset(
      libfcache_cache_t *chunk_groups_cache,
      libfcache_cache_t *chunks_cache,
      off64_t offset,
+     uint8_t unpack_chunk_data,
      libewf_chunk_data_t **chunk_data,
      off64_t *chunk_data_offset,
      libcerror_error_t **error );
@@ -20,6 +20,7 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <memory.h>
 #include <types.h>
 
@@ -425,6 +426,106 @@ on_error:
 	return( -1 );
 }
 
+/* Determines if the data chunk is corrupted
+ * It applies decompression if necessary and validates the chunk checksum
+ * This function should be used after libewf_handle_read_data_chunk or libewf_handle_read_packed_data_chunk
+ * Returns 1 if the data chunk is corrupted, 0 if not or -1 on error
+ */
+int libewf_data_chunk_is_corrupted(
+     libewf_data_chunk_t *data_chunk,
+     libcerror_error_t **error )
+{
+	libewf_internal_data_chunk_t *internal_data_chunk = NULL;
+	static char *function                             = "libewf_data_chunk_is_corrupted";
+	int result                                        = 0;
+
+	if( data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_chunk = (libewf_internal_data_chunk_t *) data_chunk;
+
+	if( internal_data_chunk->chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data chunk - missing chunk data.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_data_chunk->chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 )
+	{
+		if( libewf_chunk_data_unpack(
+		     internal_data_chunk->chunk_data,
+		     internal_data_chunk->io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unpack chunk: %" PRIu64 " data.",
+			 function,
+			 internal_data_chunk->chunk_index );
+
+			goto on_error;
+		}
+	}
+	if( ( internal_data_chunk->chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	{
+		result = 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_data_chunk->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
 /* Writes a buffer to the data chunk
  * It applies compression if necessary and calculated the chunk checksum
  * This function should be used before libewf_handle_write_data_chunk
@@ -508,6 +609,7 @@ ssize_t libewf_data_chunk_write_buffer(
 	}
 	if( libewf_chunk_data_initialize(
 	     &( internal_data_chunk->chunk_data ),
+	     internal_data_chunk->io_handle->chunk_data_pool,
 	     internal_data_chunk->io_handle->chunk_size,
 	     0,
 	     error ) != 1 )
@@ -584,3 +686,531 @@ on_error:
 	return( -1 );
 }
 
+/* Retrieves the size of the packed data of the data chunk
+ * The packed data is the data as stored in the segment file, this includes the checksum if set
+ * This function should be used after libewf_handle_read_packed_data_chunk
+ * Returns 1 if successful, 0 if the data chunk is not packed or -1 on error
+ */
+int libewf_data_chunk_get_packed_data_size(
+     libewf_data_chunk_t *data_chunk,
+     size_t *packed_data_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_data_chunk_t *internal_data_chunk = NULL;
+	static char *function                             = "libewf_data_chunk_get_packed_data_size";
+	int result                                        = 0;
+
+	if( data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_chunk = (libewf_internal_data_chunk_t *) data_chunk;
+
+	if( internal_data_chunk->chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data chunk - missing chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( packed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed data size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_data_chunk->chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 )
+	{
+		*packed_data_size = internal_data_chunk->chunk_data->data_size;
+
+		if( ( internal_data_chunk->chunk_data->chunk_io_flags & LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET ) != 0 )
+		{
+			*packed_data_size += 4;
+		}
+		result = 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads the packed data from the data chunk
+ * The packed data is the data as stored in the segment file, it is not decompressed
+ * and its checksum is not validated
+ * This function should be used after libewf_handle_read_packed_data_chunk
+ * Returns the number of bytes read, 0 when the data chunk is not packed or -1 on error
+ */
+ssize_t libewf_data_chunk_read_packed_data(
+         libewf_data_chunk_t *data_chunk,
+         void *buffer,
+         size_t buffer_size,
+         uint32_t *chunk_flags,
+         libcerror_error_t **error )
+{
+	libewf_internal_data_chunk_t *internal_data_chunk = NULL;
+	static char *function                             = "libewf_data_chunk_read_packed_data";
+	size_t packed_data_size                           = 0;
+	uint32_t safe_chunk_flags                         = 0;
+
+	if( data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_chunk = (libewf_internal_data_chunk_t *) data_chunk;
+
+	if( internal_data_chunk->chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data chunk - missing chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk flags.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_data_chunk->chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 )
+	{
+		packed_data_size = internal_data_chunk->chunk_data->data_size;
+
+		if( ( internal_data_chunk->chunk_data->chunk_io_flags & LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET ) != 0 )
+		{
+			packed_data_size += 4;
+		}
+		if( packed_data_size > buffer_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+			 "%s: invalid buffer size value too small.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     buffer,
+		     internal_data_chunk->chunk_data->data,
+		     internal_data_chunk->chunk_data->data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy packed data.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( internal_data_chunk->chunk_data->chunk_io_flags & LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET ) != 0 )
+		{
+			byte_stream_copy_from_uint32_little_endian(
+			 &( ( (uint8_t *) buffer )[ internal_data_chunk->chunk_data->data_size ] ),
+			 internal_data_chunk->chunk_data->checksum );
+		}
+		if( ( internal_data_chunk->chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+		{
+			safe_chunk_flags |= LIBEWF_DATA_CHUNK_FLAG_IS_COMPRESSED;
+		}
+		if( ( internal_data_chunk->chunk_data->range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
+		{
+			safe_chunk_flags |= LIBEWF_DATA_CHUNK_FLAG_HAS_CHECKSUM;
+		}
+		if( ( internal_data_chunk->chunk_data->range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) != 0 )
+		{
+			safe_chunk_flags |= LIBEWF_DATA_CHUNK_FLAG_USES_PATTERN_FILL;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*chunk_flags = safe_chunk_flags;
+
+	return( (ssize_t) packed_data_size );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_data_chunk->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Writes packed data to the data chunk
+ * The packed data is written as-is, it is not compressed and no checksum is calculated
+ * The data size contains the number of bytes of media data the packed data represents
+ * This function should be used before libewf_handle_write_data_chunk
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_data_chunk_write_packed_data(
+         libewf_data_chunk_t *data_chunk,
+         const void *buffer,
+         size_t buffer_size,
+         size_t data_size,
+         uint32_t chunk_flags,
+         libcerror_error_t **error )
+{
+	libewf_internal_data_chunk_t *internal_data_chunk = NULL;
+	static char *function                             = "libewf_data_chunk_write_packed_data";
+	size_t padding_size                               = 0;
+
+	if( data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_chunk = (libewf_internal_data_chunk_t *) data_chunk;
+
+	if( internal_data_chunk->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data chunk - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_data_chunk->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data chunk - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > (size_t) internal_data_chunk->io_handle->chunk_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_flags & ~( LIBEWF_DATA_CHUNK_FLAG_IS_COMPRESSED | LIBEWF_DATA_CHUNK_FLAG_HAS_CHECKSUM | LIBEWF_DATA_CHUNK_FLAG_USES_PATTERN_FILL ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported chunk flags: 0x%08" PRIx32 ".",
+		 function,
+		 chunk_flags );
+
+		return( -1 );
+	}
+	if( ( ( chunk_flags & LIBEWF_DATA_CHUNK_FLAG_IS_COMPRESSED ) != 0 )
+	 && ( buffer_size < 4 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid buffer size value too small.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_data_chunk->chunk_data != NULL )
+	{
+		if( libewf_chunk_data_free(
+		     &( internal_data_chunk->chunk_data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_chunk_data_initialize(
+	     &( internal_data_chunk->chunk_data ),
+	     internal_data_chunk->io_handle->chunk_data_pool,
+	     internal_data_chunk->io_handle->chunk_size,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	/* The 64-bit pattern fill is stored in the table entry and is not padded
+	 */
+	if( ( ( internal_data_chunk->write_io_handle->pack_flags & LIBEWF_PACK_FLAG_ADD_ALIGNMENT_PADDING ) != 0 )
+	 && ( ( chunk_flags & LIBEWF_DATA_CHUNK_FLAG_USES_PATTERN_FILL ) == 0 ) )
+	{
+		padding_size = buffer_size % 16;
+
+		if( padding_size != 0 )
+		{
+			padding_size = 16 - padding_size;
+		}
+	}
+	if( ( buffer_size + padding_size ) > internal_data_chunk->chunk_data->allocated_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     internal_data_chunk->chunk_data->data,
+	     buffer,
+	     buffer_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy packed data.",
+		 function );
+
+		goto on_error;
+	}
+	if( padding_size > 0 )
+	{
+		if( memory_set(
+		     &( ( internal_data_chunk->chunk_data->data )[ buffer_size ] ),
+		     0,
+		     padding_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear alignment padding.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	internal_data_chunk->chunk_data->data_size    = buffer_size;
+	internal_data_chunk->chunk_data->padding_size = padding_size;
+	internal_data_chunk->chunk_data->range_flags  = LIBEWF_RANGE_FLAG_IS_PACKED;
+
+	if( ( chunk_flags & LIBEWF_DATA_CHUNK_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		internal_data_chunk->chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_COMPRESSED;
+	}
+	if( ( chunk_flags & LIBEWF_DATA_CHUNK_FLAG_HAS_CHECKSUM ) != 0 )
+	{
+		internal_data_chunk->chunk_data->range_flags |= LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+	}
+	if( ( chunk_flags & LIBEWF_DATA_CHUNK_FLAG_USES_PATTERN_FILL ) != 0 )
+	{
+		internal_data_chunk->chunk_data->range_flags |= LIBEWF_RANGE_FLAG_USES_PATTERN_FILL;
+	}
+	else if( ( ( chunk_flags & LIBEWF_DATA_CHUNK_FLAG_IS_COMPRESSED ) != 0 )
+	      && ( internal_data_chunk->io_handle->compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE ) )
+	{
+		/* Deflate has its own checksum
+		 */
+		byte_stream_copy_to_uint32_little_endian(
+		 &( ( internal_data_chunk->chunk_data->data )[ buffer_size - 4 ] ),
+		 internal_data_chunk->chunk_data->checksum );
+	}
+	internal_data_chunk->data_size = data_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( (ssize_t) buffer_size );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_data_chunk->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
@@ -92,6 +92,11 @@ ssize_t libewf_data_chunk_read_buffer(
          size_t buffer_size,
          libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_data_chunk_is_corrupted(
+     libewf_data_chunk_t *data_chunk,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 ssize_t libewf_data_chunk_write_buffer(
          libewf_data_chunk_t *data_chunk,
@@ -99,6 +104,29 @@ ssize_t libewf_data_chunk_write_buffer(
          size_t buffer_size,
          libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_data_chunk_get_packed_data_size(
+     libewf_data_chunk_t *data_chunk,
+     size_t *packed_data_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+ssize_t libewf_data_chunk_read_packed_data(
+         libewf_data_chunk_t *data_chunk,
+         void *buffer,
+         size_t buffer_size,
+         uint32_t *chunk_flags,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+ssize_t libewf_data_chunk_write_packed_data(
+         libewf_data_chunk_t *data_chunk,
+         const void *buffer,
+         size_t buffer_size,
+         size_t data_size,
+         uint32_t chunk_flags,
+         libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
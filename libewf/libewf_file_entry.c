@@ -2089,26 +2089,14 @@ ssize_t libewf_internal_file_entry_read_buffer_from_single_file_entry(
 	{
 		read_size = 1;
 	}
-	if( libewf_handle_seek_offset(
-	     (libewf_handle_t *) internal_file_entry->internal_handle,
-	     data_offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset: %" PRIi64 ".",
-		 function,
-		 data_offset );
-
-		return( -1 );
-	}
-	read_count = libewf_handle_read_buffer(
+	/* The seek and read are done in a single call so that the file entries
+	 * of the same handle can be read concurrently
+	 */
+	read_count = libewf_handle_read_buffer_at_offset(
 		      (libewf_handle_t *) internal_file_entry->internal_handle,
 		      buffer,
 		      read_size,
+		      data_offset,
 		      error );
 
 	if( read_count <= -1 )
@@ -2117,8 +2105,9 @@ ssize_t libewf_internal_file_entry_read_buffer_from_single_file_entry(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
-		 function );
+		 "%s: unable to read buffer at offset: %" PRIi64 ".",
+		 function,
+		 data_offset );
 
 		return( -1 );
 	}
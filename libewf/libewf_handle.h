@@ -284,6 +284,7 @@ ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
          libewf_internal_data_chunk_t *internal_data_chunk,
+         uint8_t unpack_chunk_data,
          libcerror_error_t **error );
 
 LIBEWF_EXTERN \
@@ -292,6 +293,12 @@ ssize_t libewf_handle_read_data_chunk(
          libewf_data_chunk_t *data_chunk,
          libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+ssize_t libewf_handle_read_packed_data_chunk(
+         libewf_handle_t *handle,
+         libewf_data_chunk_t *data_chunk,
+         libcerror_error_t **error );
+
 ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -304,11 +311,35 @@ ssize_t libewf_handle_write_data_chunk(
          libewf_data_chunk_t *data_chunk,
          libcerror_error_t **error );
 
+int libewf_internal_handle_write_layout(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_write_reserved_data_chunk(
+         libewf_internal_handle_t *internal_handle,
+         libewf_internal_data_chunk_t *internal_data_chunk,
+         off64_t offset,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+ssize_t libewf_handle_write_data_chunk_at_offset(
+         libewf_handle_t *handle,
+         libewf_data_chunk_t *data_chunk,
+         off64_t offset,
+         libcerror_error_t **error );
+
 ssize_t libewf_internal_handle_write_finalize_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
          libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_write_checkpoint(
+     libewf_handle_t *handle,
+     uint32_t *segment_number,
+     uint64_t *number_of_chunks,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 ssize_t libewf_handle_write_finalize(
          libewf_handle_t *handle,
@@ -369,6 +400,13 @@ int libewf_handle_set_segment_filename(
      size_t filename_length,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_append_segment_filename(
+     libewf_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
 #if defined( HAVE_WIDE_CHARACTER_TYPE )
 
 LIBEWF_EXTERN \
@@ -391,6 +429,13 @@ int libewf_handle_set_segment_filename_wide(
      size_t filename_length,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_append_segment_filename_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
 LIBEWF_EXTERN \
@@ -405,6 +450,42 @@ int libewf_handle_set_maximum_segment_size(
      size64_t maximum_segment_size,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_get_chunks_section_limit(
+     libewf_handle_t *handle,
+     uint32_t *chunks_section_limit,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_chunks_section_limit(
+     libewf_handle_t *handle,
+     uint32_t chunks_section_limit,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_concurrent_segment_write(
+     libewf_handle_t *handle,
+     uint8_t concurrent_segment_write,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_statistics(
+     libewf_handle_t *handle,
+     uint64_t *values,
+     int number_of_values,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_reset_statistics(
+     libewf_handle_t *handle,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_statistics_flags(
+     libewf_handle_t *handle,
+     uint8_t statistics_flags,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_get_filename_size(
      libewf_handle_t *handle,
@@ -23,10 +23,13 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libewf_chunk_data_pool.h"
 #include "libewf_codepage.h"
 #include "libewf_definitions.h"
 #include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
+#include "libewf_statistics.h"
 
 /* Creates an IO handle
  * Make sure the value io_handle is referencing, is set to NULL
@@ -88,6 +91,19 @@ int libewf_io_handle_initialize(
 
 		goto on_error;
 	}
+	if( libewf_chunk_data_pool_initialize(
+	     &( ( *io_handle )->chunk_data_pool ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk data pool.",
+		 function );
+
+		goto on_error;
+	}
 	( *io_handle )->segment_file_type  = LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED;
 	( *io_handle )->format             = LIBEWF_FORMAT_ENCASE6;
 	( *io_handle )->major_version      = 1;
@@ -146,6 +162,19 @@ int libewf_io_handle_free(
 
 			result = -1;
 		}
+		if( libewf_chunk_data_pool_free(
+		     &( ( *io_handle )->chunk_data_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data pool.",
+			 function );
+
+			result = -1;
+		}
 		memory_free(
 		 *io_handle );
 
@@ -161,7 +190,8 @@ int libewf_io_handle_clear(
      libewf_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_io_handle_clear";
+	libewf_chunk_data_pool_t *chunk_data_pool = NULL;
+	static char *function                     = "libewf_io_handle_clear";
 
 	if( io_handle == NULL )
 	{
@@ -174,6 +204,27 @@ int libewf_io_handle_clear(
 
 		return( -1 );
 	}
+	/* The chunk data pool is retained so that chunk data that is still
+	 * referenced can release its buffers
+	 */
+	chunk_data_pool = io_handle->chunk_data_pool;
+
+	if( chunk_data_pool != NULL )
+	{
+		if( libewf_chunk_data_pool_clear(
+		     chunk_data_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to clear chunk data pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	if( memory_set(
 	     io_handle,
 	     0,
@@ -196,6 +247,7 @@ int libewf_io_handle_clear(
 	io_handle->compression_level  = LIBEWF_COMPRESSION_NONE;
 	io_handle->zero_on_error      = 1;
 	io_handle->header_codepage    = LIBEWF_CODEPAGE_ASCII;
+	io_handle->chunk_data_pool    = chunk_data_pool;
 
 	return( 1 );
 }
@@ -268,6 +320,36 @@ int libewf_io_handle_clone(
 	}
 	( *destination_io_handle )->zero_on_error = source_io_handle->zero_on_error;
 
+	if( libewf_statistics_clear(
+	     &( ( *destination_io_handle )->statistics ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to clear destination statistics.",
+		 function );
+
+		goto on_error;
+	}
+	/* The destination IO handle uses its own chunk data pool
+	 */
+	( *destination_io_handle )->chunk_data_pool = NULL;
+
+	if( libewf_chunk_data_pool_initialize(
+	     &( ( *destination_io_handle )->chunk_data_pool ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination chunk data pool.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
@@ -281,3 +363,137 @@ on_error:
 	return( -1 );
 }
 
+/* Opens a segment file in the file IO pool if it is not open
+ * Otherwise the file IO pool opens the segment file when it is read, which
+ * cannot be counted in the statistics
+ * If the file IO pool has reached its maximum number of open handles
+ * it closes the least recently used segment file first
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_io_handle_open_segment_file(
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle   = NULL;
+	static char *function              = "libewf_io_handle_open_segment_file";
+	int maximum_number_of_open_handles = 0;
+	int number_of_open_segment_files   = 0;
+	int result                         = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* In write mode the segment files are opened and reopened with varying
+	 * access flags, hence they are left for the file IO pool to open
+	 */
+	if( ( io_handle->access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		return( 1 );
+	}
+	if( libbfio_pool_get_handle(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	result = libbfio_handle_is_open(
+	          file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if file IO handle: %d is open.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		return( 1 );
+	}
+	if( libbfio_pool_get_maximum_number_of_open_handles(
+	     file_io_pool,
+	     &maximum_number_of_open_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve maximum number of open handles.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_open_handles != LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES )
+	{
+		if( libewf_statistics_get_number_of_open_segment_files(
+		     file_io_pool,
+		     &number_of_open_segment_files,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of open segment files.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libbfio_pool_open(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO pool entry: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	libewf_statistics_add(
+	 io_handle->statistics.number_of_segment_file_opens,
+	 1 );
+
+	if( ( maximum_number_of_open_handles != LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES )
+	 && ( number_of_open_segment_files >= maximum_number_of_open_handles ) )
+	{
+		libewf_statistics_add(
+		 io_handle->statistics.number_of_segment_file_closes,
+		 1 );
+	}
+	return( 1 );
+}
+
@@ -25,7 +25,10 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_chunk_data_pool.h"
+#include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
+#include "libewf_statistics.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -83,6 +86,18 @@ struct libewf_io_handle
 	 */
 	int header_codepage;
 
+	/* The statistics
+	 */
+	libewf_statistics_t statistics;
+
+	/* The statistics flags
+	 */
+	uint8_t statistics_flags;
+
+	/* The chunk data pool
+	 */
+	libewf_chunk_data_pool_t *chunk_data_pool;
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
@@ -105,6 +120,12 @@ int libewf_io_handle_clone(
      libewf_io_handle_t *source_io_handle,
      libcerror_error_t **error );
 
+int libewf_io_handle_open_segment_file(
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,119 @@
+/*
+ * Statically defined tracing probes
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_PROBES_H )
+#define _LIBEWF_PROBES_H
+
+#include <common.h>
+#include <types.h>
+
+/* The probes are only available if enabled with: ./configure --enable-usdt-probes
+ * A probe site is a single no-operation instruction that is patched by
+ * the tracer (perf, bpftrace, SystemTap) when the probe is attached.
+ *
+ * The probes are defined under the provider: libewf, e.g.
+ * bpftrace -e 'usdt:/usr/lib/libewf.so:libewf:chunk_fetch_return { @[arg2] = count(); }'
+ */
+#if defined( HAVE_USDT_PROBES ) && defined( HAVE_SYS_SDT_H )
+
+#include <sys/sdt.h>
+
+#define LIBEWF_PROBES_ENABLED	1
+
+/* Chunk fetch
+ * entry:  chunk index, storage media offset
+ * return: chunk index, chunk data size, cache hit (0 or 1), result
+ */
+#define LIBEWF_PROBE_CHUNK_FETCH_ENTRY( chunk_index, offset ) \
+	DTRACE_PROBE2( libewf, chunk_fetch_entry, (uint64_t) ( chunk_index ), (int64_t) ( offset ) )
+
+#define LIBEWF_PROBE_CHUNK_FETCH_RETURN( chunk_index, data_size, cache_hit, result ) \
+	DTRACE_PROBE4( libewf, chunk_fetch_return, (uint64_t) ( chunk_index ), (uint64_t) ( data_size ), (int) ( cache_hit ), (int) ( result ) )
+
+/* Chunk data decompression
+ * entry:  compressed data size, chunk size
+ * return: compressed data size, decompressed data size, result
+ */
+#define LIBEWF_PROBE_DECOMPRESS_ENTRY( compressed_data_size, chunk_size ) \
+	DTRACE_PROBE2( libewf, decompress_entry, (uint64_t) ( compressed_data_size ), (uint64_t) ( chunk_size ) )
+
+#define LIBEWF_PROBE_DECOMPRESS_RETURN( compressed_data_size, data_size, result ) \
+	DTRACE_PROBE3( libewf, decompress_return, (uint64_t) ( compressed_data_size ), (uint64_t) ( data_size ), (int) ( result ) )
+
+/* Chunk data compression
+ * entry:  data size, compression level
+ * return: data size, compressed data size, result
+ */
+#define LIBEWF_PROBE_COMPRESS_ENTRY( data_size, compression_level ) \
+	DTRACE_PROBE2( libewf, compress_entry, (uint64_t) ( data_size ), (int) ( compression_level ) )
+
+#define LIBEWF_PROBE_COMPRESS_RETURN( data_size, compressed_data_size, result ) \
+	DTRACE_PROBE3( libewf, compress_return, (uint64_t) ( data_size ), (uint64_t) ( compressed_data_size ), (int) ( result ) )
+
+/* Chunk write
+ * entry:  chunk index, input data size
+ * return: chunk index, write count
+ */
+#define LIBEWF_PROBE_CHUNK_WRITE_ENTRY( chunk_index, input_data_size ) \
+	DTRACE_PROBE2( libewf, chunk_write_entry, (uint64_t) ( chunk_index ), (uint64_t) ( input_data_size ) )
+
+#define LIBEWF_PROBE_CHUNK_WRITE_RETURN( chunk_index, write_count ) \
+	DTRACE_PROBE2( libewf, chunk_write_return, (uint64_t) ( chunk_index ), (int64_t) ( write_count ) )
+
+/* Segment file open, reads the file header and section descriptors
+ * entry:  file IO pool entry, segment file size
+ * return: file IO pool entry, segment number, number of sections, result
+ */
+#define LIBEWF_PROBE_SEGMENT_FILE_OPEN_ENTRY( file_io_pool_entry, segment_file_size ) \
+	DTRACE_PROBE2( libewf, segment_file_open_entry, (int) ( file_io_pool_entry ), (uint64_t) ( segment_file_size ) )
+
+#define LIBEWF_PROBE_SEGMENT_FILE_OPEN_RETURN( file_io_pool_entry, segment_number, number_of_sections, result ) \
+	DTRACE_PROBE4( libewf, segment_file_open_return, (int) ( file_io_pool_entry ), (uint32_t) ( segment_number ), (int) ( number_of_sections ), (int) ( result ) )
+
+/* Table section parse
+ * entry:  file IO pool entry, section offset, section data size
+ * return: file IO pool entry, number of entries, entries corrupted, read count
+ */
+#define LIBEWF_PROBE_TABLE_READ_ENTRY( file_io_pool_entry, section_offset, section_data_size ) \
+	DTRACE_PROBE3( libewf, table_read_entry, (int) ( file_io_pool_entry ), (int64_t) ( section_offset ), (uint64_t) ( section_data_size ) )
+
+#define LIBEWF_PROBE_TABLE_READ_RETURN( file_io_pool_entry, number_of_entries, entries_corrupted, read_count ) \
+	DTRACE_PROBE4( libewf, table_read_return, (int) ( file_io_pool_entry ), (uint32_t) ( number_of_entries ), (int) ( entries_corrupted ), (int64_t) ( read_count ) )
+
+#else
+
+#define LIBEWF_PROBE_CHUNK_FETCH_ENTRY( chunk_index, offset )
+#define LIBEWF_PROBE_CHUNK_FETCH_RETURN( chunk_index, data_size, cache_hit, result )
+#define LIBEWF_PROBE_DECOMPRESS_ENTRY( compressed_data_size, chunk_size )
+#define LIBEWF_PROBE_DECOMPRESS_RETURN( compressed_data_size, data_size, result )
+#define LIBEWF_PROBE_COMPRESS_ENTRY( data_size, compression_level )
+#define LIBEWF_PROBE_COMPRESS_RETURN( data_size, compressed_data_size, result )
+#define LIBEWF_PROBE_CHUNK_WRITE_ENTRY( chunk_index, input_data_size )
+#define LIBEWF_PROBE_CHUNK_WRITE_RETURN( chunk_index, write_count )
+#define LIBEWF_PROBE_SEGMENT_FILE_OPEN_ENTRY( file_io_pool_entry, segment_file_size )
+#define LIBEWF_PROBE_SEGMENT_FILE_OPEN_RETURN( file_io_pool_entry, segment_number, number_of_sections, result )
+#define LIBEWF_PROBE_TABLE_READ_ENTRY( file_io_pool_entry, section_offset, section_data_size )
+#define LIBEWF_PROBE_TABLE_READ_RETURN( file_io_pool_entry, number_of_entries, entries_corrupted, read_count )
+
+#endif /* defined( HAVE_USDT_PROBES ) && defined( HAVE_SYS_SDT_H ) */
+
+#endif /* !defined( _LIBEWF_PROBES_H ) */
+
@@ -39,6 +39,7 @@
 #include "libewf_libcnotify.h"
 #include "libewf_libhmac.h"
 #include "libewf_media_values.h"
+#include "libewf_probes.h"
 #include "libewf_section.h"
 #include "libewf_sector_range.h"
 #include "libewf_single_files.h"
@@ -451,23 +452,20 @@ int libewf_section_set_values(
 }
 
 /* Reads a section descriptor
- * Returns the number of bytes read or -1 on error
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_section_descriptor_read(
-         libewf_section_t *section,
-         libbfio_pool_t *file_io_pool,
-         int file_io_pool_entry,
-         off64_t file_offset,
-         uint8_t format_version,
-         libcerror_error_t **error )
+int libewf_section_descriptor_read_data(
+     libewf_section_t *section,
+     const uint8_t *data,
+     size_t data_size,
+     off64_t file_offset,
+     uint8_t format_version,
+     libcerror_error_t **error )
 {
-	uint8_t *section_descriptor_data    = NULL;
-	static char *function               = "libewf_section_descriptor_read";
-	size_t section_descriptor_data_size = 0;
-	ssize_t read_count                  = 0;
-	uint32_t calculated_checksum        = 0;
-	uint32_t section_descriptor_size    = 0;
-	uint32_t stored_checksum            = 0;
+	static char *function            = "libewf_section_descriptor_read_data";
+	uint32_t calculated_checksum     = 0;
+	uint32_t section_descriptor_size = 0;
+	uint32_t stored_checksum         = 0;
 
 	if( section == NULL )
 	{
@@ -480,85 +478,55 @@ ssize_t libewf_section_descriptor_read(
 
 		return( -1 );
 	}
-	if( format_version == 1 )
-	{
-		section_descriptor_data_size = sizeof( ewf_section_descriptor_v1_t );
-	}
-	else if( format_version == 2 )
-	{
-		section_descriptor_data_size = sizeof( ewf_section_descriptor_v2_t );
-	}
-	else
+	if( data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported format version.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: reading section descriptor from file IO pool entry: %d at offset: 0x%08" PRIx64 "\n",
-		 function,
-		 file_io_pool_entry,
-		 file_offset );
-	}
-#endif
-	if( libbfio_pool_seek_offset(
-	     file_io_pool,
-	     file_io_pool_entry,
-	     file_offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	if( format_version == 1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek section descriptor offset: %" PRIi64 " in file IO pool entry: %d.",
-		 function,
-		 file_offset,
-		 file_io_pool_entry );
+		if( data_size != sizeof( ewf_section_descriptor_v1_t ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid data size value out of bounds.",
+			 function );
 
-		goto on_error;
+			return( -1 );
+		}
 	}
-	section_descriptor_data = (uint8_t *) memory_allocate(
-	                                       section_descriptor_data_size );
-
-	if( section_descriptor_data == NULL )
+	else if( format_version == 2 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create section descriptor data.",
-		 function );
+		if( data_size != sizeof( ewf_section_descriptor_v2_t ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid data size value out of bounds.",
+			 function );
 
-		goto on_error;
+			return( -1 );
+		}
 	}
-	read_count = libbfio_pool_read_buffer(
-	              file_io_pool,
-	              file_io_pool_entry,
-	              section_descriptor_data,
-	              section_descriptor_data_size,
-	              error );
-
-	if( read_count != (ssize_t) section_descriptor_data_size )
+	else
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read section descriptor from file IO pool entry: %d.",
-		 function,
-		 file_io_pool_entry );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
@@ -567,8 +535,8 @@ ssize_t libewf_section_descriptor_read(
 	 	 "%s: section descriptor data:\n",
 		 function );
 		libcnotify_print_data(
-		 section_descriptor_data,
-		 section_descriptor_data_size,
+		 data,
+		 data_size,
 		 0 );
 	}
 #endif
@@ -576,7 +544,7 @@ ssize_t libewf_section_descriptor_read(
 	{
 		if( memory_copy(
 		     section->type_string,
-		     ( (ewf_section_descriptor_v1_t *) section_descriptor_data )->type_string,
+		     ( (ewf_section_descriptor_v1_t *) data )->type_string,
 		     16 ) == NULL )
 		{
 			libcerror_error_set(
@@ -586,7 +554,7 @@ ssize_t libewf_section_descriptor_read(
 			 "%s: unable to set type string.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 		section->type_string[ 16 ] = 0;
 
@@ -594,50 +562,50 @@ ssize_t libewf_section_descriptor_read(
 		                               (char *) section->type_string );
 
 		byte_stream_copy_to_uint64_little_endian(
-		 ( (ewf_section_descriptor_v1_t *) section_descriptor_data )->size,
+		 ( (ewf_section_descriptor_v1_t *) data )->size,
 		 section->size );
 
 		byte_stream_copy_to_uint64_little_endian(
-		 ( (ewf_section_descriptor_v1_t *) section_descriptor_data )->next_offset,
+		 ( (ewf_section_descriptor_v1_t *) data )->next_offset,
 		 section->end_offset );
 
 		byte_stream_copy_to_uint32_little_endian(
-		 ( (ewf_section_descriptor_v1_t *) section_descriptor_data )->checksum,
+		 ( (ewf_section_descriptor_v1_t *) data )->checksum,
 		 stored_checksum );
 	}
 	else if( format_version == 2 )
 	{
 		byte_stream_copy_to_uint32_little_endian(
-		 ( (ewf_section_descriptor_v2_t *) section_descriptor_data )->type,
+		 ( (ewf_section_descriptor_v2_t *) data )->type,
 		 section->type );
 
 		byte_stream_copy_to_uint32_little_endian(
-		 ( (ewf_section_descriptor_v2_t *) section_descriptor_data )->data_flags,
+		 ( (ewf_section_descriptor_v2_t *) data )->data_flags,
 		 section->data_flags );
 
 		byte_stream_copy_to_uint64_little_endian(
-		 ( (ewf_section_descriptor_v2_t *) section_descriptor_data )->previous_offset,
+		 ( (ewf_section_descriptor_v2_t *) data )->previous_offset,
 		 section->start_offset );
 
 		byte_stream_copy_to_uint64_little_endian(
-		 ( (ewf_section_descriptor_v2_t *) section_descriptor_data )->data_size,
+		 ( (ewf_section_descriptor_v2_t *) data )->data_size,
 		 section->data_size );
 
 		byte_stream_copy_to_uint32_little_endian(
-		 ( (ewf_section_descriptor_v2_t *) section_descriptor_data )->padding_size,
+		 ( (ewf_section_descriptor_v2_t *) data )->padding_size,
 		 section->padding_size );
 
 		byte_stream_copy_to_uint32_little_endian(
-		 ( (ewf_section_descriptor_v2_t *) section_descriptor_data )->descriptor_size,
+		 ( (ewf_section_descriptor_v2_t *) data )->descriptor_size,
 		 section_descriptor_size );
 
 		byte_stream_copy_to_uint32_little_endian(
-		 ( (ewf_section_descriptor_v2_t *) section_descriptor_data )->checksum,
+		 ( (ewf_section_descriptor_v2_t *) data )->checksum,
 		 stored_checksum );
 
 		if( memory_copy(
 		     section->data_integrity_hash,
-		     ( (ewf_section_descriptor_v2_t *) section_descriptor_data )->data_integrity_hash,
+		     ( (ewf_section_descriptor_v2_t *) data )->data_integrity_hash,
 		     16 ) == NULL )
 		{
 			libcerror_error_set(
@@ -647,7 +615,7 @@ ssize_t libewf_section_descriptor_read(
 			 "%s: unable to set data integrity hash.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
@@ -674,7 +642,7 @@ ssize_t libewf_section_descriptor_read(
 			 "%s: padding:\n",
 			 function );
 			libcnotify_print_data(
-			 ( (ewf_section_descriptor_v1_t *) section_descriptor_data )->padding,
+			 ( (ewf_section_descriptor_v1_t *) data )->padding,
 			 40,
 			 0 );
 		}
@@ -722,7 +690,7 @@ ssize_t libewf_section_descriptor_read(
 			 "%s: data integrity hash:\n",
 			 function );
 			libcnotify_print_data(
-			 ( (ewf_section_descriptor_v2_t *) section_descriptor_data )->data_integrity_hash,
+			 ( (ewf_section_descriptor_v2_t *) data )->data_integrity_hash,
 			 16,
 			 0 );
 
@@ -730,7 +698,7 @@ ssize_t libewf_section_descriptor_read(
 			 "%s: padding:\n",
 			 function );
 			libcnotify_print_data(
-			 ( (ewf_section_descriptor_v2_t *) section_descriptor_data )->padding,
+			 ( (ewf_section_descriptor_v2_t *) data )->padding,
 			 12,
 			 0 );
 		}
@@ -745,8 +713,8 @@ ssize_t libewf_section_descriptor_read(
 #endif
 	if( libewf_checksum_calculate_adler32(
 	     &calculated_checksum,
-	     section_descriptor_data,
-	     section_descriptor_data_size - 4,
+	     data,
+	     data_size - 4,
 	     1,
 	     error ) != 1 )
 	{
@@ -757,7 +725,7 @@ ssize_t libewf_section_descriptor_read(
 		 "%s: unable to calculate checksum.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	if( stored_checksum != calculated_checksum )
 	{
@@ -770,13 +738,8 @@ ssize_t libewf_section_descriptor_read(
 		 stored_checksum,
 		 calculated_checksum );
 
-		goto on_error;
+		return( -1 );
 	}
-	memory_free(
-	 section_descriptor_data );
-
-	section_descriptor_data = NULL;
-
 	if( format_version == 1 )
 	{
 		if( ( section->end_offset < file_offset )
@@ -789,7 +752,7 @@ ssize_t libewf_section_descriptor_read(
 			 "%s: invalid section next offset value out of bounds.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 		if( ( section->size != 0 )
 		 && ( ( section->size < (size64_t) sizeof( ewf_section_descriptor_v1_t ) )
@@ -802,7 +765,7 @@ ssize_t libewf_section_descriptor_read(
 			 "%s: invalid section size value out of bounds.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 		section->start_offset = file_offset;
 
@@ -833,7 +796,7 @@ ssize_t libewf_section_descriptor_read(
 			 "%s: invalid section previous offset value out of bounds.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 		if( section->start_offset == 0 )
 		{
@@ -855,7 +818,7 @@ ssize_t libewf_section_descriptor_read(
 			 "%s: invalid section data size value out of bounds.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 		if( section->padding_size > section->data_size )
 		{
@@ -866,7 +829,7 @@ ssize_t libewf_section_descriptor_read(
 			 "%s: invalid section padding size value out of bounds.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 	}
 	if( format_version == 1 )
@@ -960,7 +923,7 @@ ssize_t libewf_section_descriptor_read(
 					 section->end_offset,
 					 section->start_offset );
 
-					goto on_error;
+					return( -1 );
 				}
 				if( section->size != sizeof( ewf_section_descriptor_v1_t ) )
 				{
@@ -971,7 +934,7 @@ ssize_t libewf_section_descriptor_read(
 					 "%s: invalid section size value out of bounds.",
 					 function );
 
-					goto on_error;
+					return( -1 );
 				}
 			}
 			else
@@ -989,7 +952,7 @@ ssize_t libewf_section_descriptor_read(
 					 section->end_offset,
 					 file_offset );
 
-					goto on_error;
+					return( -1 );
 				}
 			}
 		}
@@ -1012,7 +975,7 @@ ssize_t libewf_section_descriptor_read(
 					 section->end_offset,
 					 section->start_offset );
 
-					goto on_error;
+					return( -1 );
 				}
 				section->size = (size64_t) sizeof( ewf_section_descriptor_v1_t );
 			}
@@ -1029,7 +992,7 @@ ssize_t libewf_section_descriptor_read(
 					 "%s: invalid section next offset value out of bounds.",
 					 function );
 
-					goto on_error;
+					return( -1 );
 				}
 				section->size = (size64_t) ( section->end_offset - section->start_offset );
 			}
@@ -1046,9 +1009,140 @@ ssize_t libewf_section_descriptor_read(
 			 "%s: mismatch in section descriptor size.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 	}
+	return( 1 );
+}
+
+
+/* Reads a section descriptor
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_section_descriptor_read(
+         libewf_section_t *section,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         off64_t file_offset,
+         uint8_t format_version,
+         libcerror_error_t **error )
+{
+	uint8_t *section_descriptor_data    = NULL;
+	static char *function               = "libewf_section_descriptor_read";
+	size_t section_descriptor_data_size = 0;
+	ssize_t read_count                  = 0;
+
+	if( section == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section.",
+		 function );
+
+		return( -1 );
+	}
+	if( format_version == 1 )
+	{
+		section_descriptor_data_size = sizeof( ewf_section_descriptor_v1_t );
+	}
+	else if( format_version == 2 )
+	{
+		section_descriptor_data_size = sizeof( ewf_section_descriptor_v2_t );
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading section descriptor from file IO pool entry: %d at offset: 0x%08" PRIx64 "\n",
+		 function,
+		 file_io_pool_entry,
+		 file_offset );
+	}
+#endif
+	if( libbfio_pool_seek_offset(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     file_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek section descriptor offset: %" PRIi64 " in file IO pool entry: %d.",
+		 function,
+		 file_offset,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	section_descriptor_data = (uint8_t *) memory_allocate(
+	                                       section_descriptor_data_size );
+
+	if( section_descriptor_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create section descriptor data.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_pool_read_buffer(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              section_descriptor_data,
+	              section_descriptor_data_size,
+	              error );
+
+	if( read_count != (ssize_t) section_descriptor_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read section descriptor from file IO pool entry: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	if( libewf_section_descriptor_read_data(
+	     section,
+	     section_descriptor_data,
+	     section_descriptor_data_size,
+	     file_offset,
+	     format_version,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read section descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 section_descriptor_data );
+
 	return( read_count );
 
 on_error:
@@ -8037,6 +8131,11 @@ ssize_t libewf_section_table_read(
 
 		return( -1 );
 	}
+	LIBEWF_PROBE_TABLE_READ_ENTRY(
+	 file_io_pool_entry,
+	 section->start_offset,
+	 section->data_size );
+
 	/* In original EWF, SMART (EWF-S01) and EnCase1 EWF-E01 the trailing data will be the chunk data
 	 */
 	if( ( segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
@@ -8103,6 +8202,12 @@ ssize_t libewf_section_table_read(
 		*section_data      = NULL;
 		*section_data_size = 0;
 
+		LIBEWF_PROBE_TABLE_READ_RETURN(
+		 file_io_pool_entry,
+		 0,
+		 0,
+		 0 );
+
 		return( 0 );
 	}
 	if( *section_data_size < table_header_data_size )
@@ -8498,6 +8603,12 @@ ssize_t libewf_section_table_read(
 		}
 	}
 #endif
+	LIBEWF_PROBE_TABLE_READ_RETURN(
+	 file_io_pool_entry,
+	 *number_of_entries,
+	 *entries_corrupted,
+	 read_count );
+
 	return( read_count );
 
 on_error:
@@ -8512,6 +8623,12 @@ on_error:
 	*table_entries_data      = NULL;
 	*table_entries_data_size = 0;
 
+	LIBEWF_PROBE_TABLE_READ_RETURN(
+	 file_io_pool_entry,
+	 0,
+	 0,
+	 -1 );
+
 	return( -1 );
 }
 
@@ -123,6 +123,14 @@ int libewf_section_set_values(
      uint32_t padding_size,
      libcerror_error_t **error );
 
+int libewf_section_descriptor_read_data(
+     libewf_section_t *section,
+     const uint8_t *data,
+     size_t data_size,
+     off64_t file_offset,
+     uint8_t format_version,
+     libcerror_error_t **error );
+
 ssize_t libewf_section_descriptor_read(
          libewf_section_t *section,
          libbfio_pool_t *file_io_pool,
@@ -0,0 +1,902 @@
+/*
+ * Section correction functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_case_data.h"
+#include "libewf_definitions.h"
+#include "libewf_device_information.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libfvalue.h"
+#include "libewf_media_values.h"
+#include "libewf_section.h"
+#include "libewf_section_correction.h"
+#include "libewf_segment_writer.h"
+#include "libewf_unused.h"
+
+#include "ewf_data.h"
+
+/* Creates a section correction
+ * Make sure the value section_correction is referencing, is set to NULL
+ * The section correction takes over the management of the section
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_section_correction_initialize(
+     libewf_section_correction_t **section_correction,
+     uint32_t segment_number,
+     int file_io_pool_entry,
+     libewf_section_t *section,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_section_correction_initialize";
+
+	if( section_correction == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section correction.",
+		 function );
+
+		return( -1 );
+	}
+	if( *section_correction != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid section correction value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( section == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section.",
+		 function );
+
+		return( -1 );
+	}
+	*section_correction = memory_allocate_structure(
+	                       libewf_section_correction_t );
+
+	if( *section_correction == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create section correction.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *section_correction,
+	     0,
+	     sizeof( libewf_section_correction_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear section correction.",
+		 function );
+
+		goto on_error;
+	}
+	( *section_correction )->segment_number     = segment_number;
+	( *section_correction )->file_io_pool_entry = file_io_pool_entry;
+	( *section_correction )->section            = section;
+
+	return( 1 );
+
+on_error:
+	if( *section_correction != NULL )
+	{
+		memory_free(
+		 *section_correction );
+
+		*section_correction = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a section correction
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_section_correction_free(
+     libewf_section_correction_t **section_correction,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_section_correction_free";
+	int result            = 1;
+
+	if( section_correction == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section correction.",
+		 function );
+
+		return( -1 );
+	}
+	if( *section_correction != NULL )
+	{
+		/* The segment writer is referenced by the section correction and freed elsewhere
+		 */
+		if( ( *section_correction )->data != NULL )
+		{
+			memory_free(
+			 ( *section_correction )->data );
+		}
+		if( libewf_section_free(
+		     &( ( *section_correction )->section ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free section.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *section_correction );
+
+		*section_correction = NULL;
+	}
+	return( result );
+}
+
+/* Writes a corrected section
+ * The section is written with the (final) media values at the file offset in the file IO pool entry,
+ * the section values, such as the offset and data size, are those of the section when it was first written
+ * Returns the number of bytes written, 0 if the section does not need to be corrected or -1 on error
+ */
+ssize_t libewf_section_correction_write_section(
+         libewf_section_t *section,
+         libewf_io_handle_t *io_handle,
+         uint8_t segment_file_type,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         off64_t file_offset,
+         libewf_media_values_t *media_values,
+         libfvalue_table_t *header_values,
+         time_t timestamp,
+         uint8_t **case_data,
+         size_t *case_data_size,
+         uint8_t **device_information,
+         size_t *device_information_size,
+         ewf_data_t **data_section,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_section_correction_write_section";
+	ssize_t write_count   = 0;
+	uint8_t section_type  = 0;
+
+	if( section == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( case_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid case data.",
+		 function );
+
+		return( -1 );
+	}
+	if( case_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid case data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_information == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device information.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_information_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device information size.",
+		 function );
+
+		return( -1 );
+	}
+	/* Only the device information, case data, volume and data sections contain media values
+	 */
+	if( section->type == LIBEWF_SECTION_TYPE_DEVICE_INFORMATION )
+	{
+		section_type = 1;
+	}
+	else if( section->type == LIBEWF_SECTION_TYPE_CASE_DATA )
+	{
+		section_type = 2;
+	}
+	else if( section->type == 0 )
+	{
+		if( ( section->type_string_length == 6 )
+		 && ( memory_compare(
+		       section->type_string,
+		       "volume",
+		       6 ) == 0 ) )
+		{
+			section_type = 3;
+		}
+		else if( ( section->type_string_length == 4 )
+		      && ( memory_compare(
+		            section->type_string,
+		            "data",
+		            4 ) == 0 ) )
+		{
+			section_type = 4;
+		}
+	}
+	if( section_type == 0 )
+	{
+		return( 0 );
+	}
+	if( libbfio_pool_seek_offset(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     file_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek section offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		return( -1 );
+	}
+	switch( section_type )
+	{
+		case 1:
+			if( *device_information == NULL )
+			{
+				if( libewf_device_information_generate(
+				     device_information,
+				     device_information_size,
+				     media_values,
+				     header_values,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to generate device information.",
+					 function );
+
+					return( -1 );
+				}
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: correcting device information section.\n",
+				 function );
+			}
+#endif
+			/* Do not include the end of string character in the compressed data
+			 */
+			write_count = libewf_section_write_compressed_string(
+				       section,
+				       io_handle,
+				       file_io_pool,
+				       file_io_pool_entry,
+				       2,
+				       LIBEWF_SECTION_TYPE_DEVICE_INFORMATION,
+				       NULL,
+				       0,
+				       section->start_offset,
+				       io_handle->compression_method,
+				       LIBEWF_COMPRESSION_DEFAULT,
+				       *device_information,
+				       *device_information_size - 2,
+				       (size_t) section->data_size,
+				       error );
+
+			if( write_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write device information section.",
+				 function );
+
+				return( -1 );
+			}
+			break;
+
+		case 2:
+			if( *case_data == NULL )
+			{
+				if( libewf_case_data_generate(
+				     case_data,
+				     case_data_size,
+				     media_values,
+				     header_values,
+				     timestamp,
+				     io_handle->format,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to generate case data.",
+					 function );
+
+					return( -1 );
+				}
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: correcting case data section.\n",
+				 function );
+			}
+#endif
+			/* Do not include the end of string character in the compressed data
+			 */
+			write_count = libewf_section_write_compressed_string(
+				       section,
+				       io_handle,
+				       file_io_pool,
+				       file_io_pool_entry,
+				       2,
+				       LIBEWF_SECTION_TYPE_CASE_DATA,
+				       NULL,
+				       0,
+				       section->start_offset,
+				       io_handle->compression_method,
+				       LIBEWF_COMPRESSION_DEFAULT,
+				       *case_data,
+				       *case_data_size - 2,
+				       (size_t) section->data_size,
+				       error );
+
+			if( write_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write case data section.",
+				 function );
+
+				return( -1 );
+			}
+			break;
+
+		case 3:
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: correcting volume section.\n",
+				 function );
+			}
+#endif
+			if( segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1 )
+			{
+				write_count = libewf_section_volume_e01_write(
+					       section,
+					       io_handle,
+					       file_io_pool,
+					       file_io_pool_entry,
+					       section->start_offset,
+					       media_values,
+					       error );
+			}
+			else if( segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+			{
+				write_count = libewf_section_volume_s01_write(
+					       section,
+					       io_handle,
+					       file_io_pool,
+					       file_io_pool_entry,
+					       section->start_offset,
+					       media_values,
+					       error );
+			}
+			else
+			{
+				write_count = -1;
+			}
+			if( write_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to correct volume section.",
+				 function );
+
+				return( -1 );
+			}
+			break;
+
+		case 4:
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: correcting data section.\n",
+				 function );
+			}
+#endif
+			write_count = libewf_section_data_write(
+				       section,
+				       io_handle,
+				       file_io_pool,
+				       file_io_pool_entry,
+				       section->start_offset,
+				       media_values,
+				       data_section,
+				       error );
+
+			if( write_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to correct data section.",
+				 function );
+
+				return( -1 );
+			}
+			break;
+	}
+	return( write_count );
+}
+
+/* Builds the corrected section data in memory
+ * The data is written by the same functions that write the section to file
+ * but to a memory range the size of the section
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_section_correction_build_data(
+     libewf_section_correction_t *section_correction,
+     libewf_io_handle_t *io_handle,
+     uint8_t segment_file_type,
+     libewf_media_values_t *media_values,
+     libfvalue_table_t *header_values,
+     time_t timestamp,
+     uint8_t **case_data,
+     size_t *case_data_size,
+     uint8_t **device_information,
+     size_t *device_information_size,
+     ewf_data_t **data_section,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	libbfio_pool_t *file_io_pool     = NULL;
+	static char *function            = "libewf_section_correction_build_data";
+	size_t data_size                 = 0;
+	ssize_t write_count              = 0;
+	int file_io_pool_entry           = 0;
+
+	if( section_correction == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section correction.",
+		 function );
+
+		return( -1 );
+	}
+	if( section_correction->section == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid section correction - missing section.",
+		 function );
+
+		return( -1 );
+	}
+	if( section_correction->data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid section correction - data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( section_correction->section->size == 0 )
+	 || ( section_correction->section->size > (size64_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid section correction - section size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	data_size = (size_t) section_correction->section->size;
+
+	section_correction->data = (uint8_t *) memory_allocate(
+	                                        sizeof( uint8_t ) * data_size );
+
+	if( section_correction->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     section_correction->data,
+	     0,
+	     sizeof( uint8_t ) * data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_memory_range_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create memory range file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_memory_range_set(
+	     file_io_handle,
+	     section_correction->data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set memory range of file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_initialize(
+	     &file_io_pool,
+	     0,
+	     LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_append_handle(
+	     file_io_pool,
+	     &file_io_pool_entry,
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ_WRITE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append memory range file IO handle to pool.",
+		 function );
+
+		goto on_error;
+	}
+	/* The file IO handle is now managed by the file IO pool
+	 */
+	file_io_handle = NULL;
+
+	write_count = libewf_section_correction_write_section(
+	               section_correction->section,
+	               io_handle,
+	               segment_file_type,
+	               file_io_pool,
+	               file_io_pool_entry,
+	               0,
+	               media_values,
+	               header_values,
+	               timestamp,
+	               case_data,
+	               case_data_size,
+	               device_information,
+	               device_information_size,
+	               data_section,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write corrected section of segment file: %" PRIu32 ".",
+		 function,
+		 section_correction->segment_number );
+
+		goto on_error;
+	}
+	else if( ( write_count == 0 )
+	      || ( (size_t) write_count > data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid corrected section size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	section_correction->data_size = (size_t) write_count;
+
+	if( libbfio_pool_free(
+	     &file_io_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( section_correction->data != NULL )
+	{
+		memory_free(
+		 section_correction->data );
+
+		section_correction->data = NULL;
+	}
+	section_correction->data_size = 0;
+
+	return( -1 );
+}
+
+/* Writes the corrected section data to the segment file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_section_correction_write_data(
+     libewf_section_correction_t *section_correction,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_section_correction_write_data";
+	ssize_t write_count   = 0;
+
+	if( section_correction == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section correction.",
+		 function );
+
+		return( -1 );
+	}
+	if( section_correction->section == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid section correction - missing section.",
+		 function );
+
+		return( -1 );
+	}
+	if( section_correction->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid section correction - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( section_correction->segment_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid section correction - missing segment writer.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = libewf_segment_writer_write_data(
+	               section_correction->segment_writer,
+	               section_correction->section->start_offset,
+	               section_correction->data,
+	               section_correction->data_size,
+	               error );
+
+	if( write_count != (ssize_t) section_correction->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write corrected section data to segment file: %" PRIu32 ".",
+		 function,
+		 section_correction->segment_number );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Callback function to write the corrected section data from a thread pool
+ * The result is stored in the section correction since the thread pool does not pass it on
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_section_correction_write_data_callback(
+     libewf_section_correction_t *section_correction,
+     void *arguments LIBEWF_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_section_correction_write_data_callback";
+
+	LIBEWF_UNREFERENCED_PARAMETER( arguments )
+
+	if( section_correction == NULL )
+	{
+		return( -1 );
+	}
+	section_correction->write_result = libewf_section_correction_write_data(
+	                                    section_correction,
+	                                    &error );
+
+	if( section_correction->write_result != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write section correction.",
+		 function );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
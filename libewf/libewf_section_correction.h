@@ -0,0 +1,133 @@
+/*
+ * Section correction functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SECTION_CORRECTION_H )
+#define _LIBEWF_SECTION_CORRECTION_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libfvalue.h"
+#include "libewf_media_values.h"
+#include "libewf_section.h"
+#include "libewf_segment_writer.h"
+
+#include "ewf_data.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_section_correction libewf_section_correction_t;
+
+/* The section correction contains a section that was written with the media values
+ * known at the start of a streamed write and needs to be corrected when the write is finalized
+ */
+struct libewf_section_correction
+{
+	/* The segment number
+	 */
+	uint32_t segment_number;
+
+	/* The file IO pool entry of the segment file
+	 */
+	int file_io_pool_entry;
+
+	/* The section
+	 */
+	libewf_section_t *section;
+
+	/* The corrected section data
+	 */
+	uint8_t *data;
+
+	/* The size of the corrected section data
+	 */
+	size_t data_size;
+
+	/* The segment writer used to write the corrected section data
+	 */
+	libewf_segment_writer_t *segment_writer;
+
+	/* The result of writing the corrected section data
+	 */
+	int write_result;
+};
+
+int libewf_section_correction_initialize(
+     libewf_section_correction_t **section_correction,
+     uint32_t segment_number,
+     int file_io_pool_entry,
+     libewf_section_t *section,
+     libcerror_error_t **error );
+
+int libewf_section_correction_free(
+     libewf_section_correction_t **section_correction,
+     libcerror_error_t **error );
+
+ssize_t libewf_section_correction_write_section(
+         libewf_section_t *section,
+         libewf_io_handle_t *io_handle,
+         uint8_t segment_file_type,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         off64_t file_offset,
+         libewf_media_values_t *media_values,
+         libfvalue_table_t *header_values,
+         time_t timestamp,
+         uint8_t **case_data,
+         size_t *case_data_size,
+         uint8_t **device_information,
+         size_t *device_information_size,
+         ewf_data_t **data_section,
+         libcerror_error_t **error );
+
+int libewf_section_correction_build_data(
+     libewf_section_correction_t *section_correction,
+     libewf_io_handle_t *io_handle,
+     uint8_t segment_file_type,
+     libewf_media_values_t *media_values,
+     libfvalue_table_t *header_values,
+     time_t timestamp,
+     uint8_t **case_data,
+     size_t *case_data_size,
+     uint8_t **device_information,
+     size_t *device_information_size,
+     ewf_data_t **data_section,
+     libcerror_error_t **error );
+
+int libewf_section_correction_write_data(
+     libewf_section_correction_t *section_correction,
+     libcerror_error_t **error );
+
+int libewf_section_correction_write_data_callback(
+     libewf_section_correction_t *section_correction,
+     void *arguments );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SECTION_CORRECTION_H ) */
+
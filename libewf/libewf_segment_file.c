@@ -50,10 +50,13 @@
 #include "libewf_libfdata.h"
 #include "libewf_libfguid.h"
 #include "libewf_libfvalue.h"
+#include "libewf_probes.h"
 #include "libewf_section.h"
+#include "libewf_section_correction.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
 #include "libewf_single_files.h"
+#include "libewf_statistics.h"
 #include "libewf_unused.h"
 
 #include "ewf_file_header.h"
@@ -1723,6 +1726,85 @@ ssize_t libewf_segment_file_read_volume_section(
 	return( read_count );
 }
 
+/* Appends a section correction for a section that was written with the media values known at the start of the write
+ * The section correction takes over the management of the section
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_append_section_correction(
+     libewf_segment_file_t *segment_file,
+     libcdata_array_t *sections_corrections,
+     int file_io_pool_entry,
+     libewf_section_t **section,
+     libcerror_error_t **error )
+{
+	libewf_section_correction_t *section_correction = NULL;
+	static char *function                           = "libewf_segment_file_append_section_correction";
+	int entry_index                                 = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( section == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_section_correction_initialize(
+	     &section_correction,
+	     segment_file->segment_number,
+	     file_io_pool_entry,
+	     *section,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create section correction.",
+		 function );
+
+		return( -1 );
+	}
+	/* The section is now managed by the section correction
+	 */
+	*section = NULL;
+
+	if( libcdata_array_append_entry(
+	     sections_corrections,
+	     &entry_index,
+	     (intptr_t *) section_correction,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append section correction to array.",
+		 function );
+
+		libewf_section_correction_free(
+		 &section_correction,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Writes a device information section to file
  * Returns the number of bytes written or -1 on error
  */
@@ -1734,6 +1816,7 @@ ssize_t libewf_segment_file_write_device_information_section(
          size_t *device_information_size,
          libewf_media_values_t *media_values,
          libfvalue_table_t *header_values,
+         libcdata_array_t *sections_corrections,
          libcerror_error_t **error )
 {
 	libewf_section_t *section = NULL;
@@ -1849,9 +1932,28 @@ ssize_t libewf_segment_file_write_device_information_section(
 	}
 	segment_file->current_offset += write_count;
 
-	if( libewf_section_free(
-	     &section,
-	     error ) != 1 )
+	if( sections_corrections != NULL )
+	{
+		if( libewf_segment_file_append_section_correction(
+		     segment_file,
+		     sections_corrections,
+		     file_io_pool_entry,
+		     &section,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append section correction.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else if( libewf_section_free(
+	          &section,
+	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -1904,6 +2006,7 @@ ssize_t libewf_segment_file_write_case_data_section(
          libewf_media_values_t *media_values,
          libfvalue_table_t *header_values,
          time_t timestamp,
+         libcdata_array_t *sections_corrections,
          libcerror_error_t **error )
 {
 	libewf_section_t *section = NULL;
@@ -2021,9 +2124,28 @@ ssize_t libewf_segment_file_write_case_data_section(
 	}
 	segment_file->current_offset += write_count;
 
-	if( libewf_section_free(
-	     &section,
-	     error ) != 1 )
+	if( sections_corrections != NULL )
+	{
+		if( libewf_segment_file_append_section_correction(
+		     segment_file,
+		     sections_corrections,
+		     file_io_pool_entry,
+		     &section,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append section correction.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else if( libewf_section_free(
+	          &section,
+	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -3067,6 +3189,7 @@ ssize_t libewf_segment_file_write_start(
          libewf_media_values_t *media_values,
          libfvalue_table_t *header_values,
          time_t timestamp,
+         libcdata_array_t *sections_corrections,
          libcerror_error_t **error )
 {
 	libewf_section_t *section = NULL;
@@ -3233,9 +3356,29 @@ ssize_t libewf_segment_file_write_start(
 			segment_file->current_offset += write_count;
 			total_write_count            += write_count;
 		}
-		if( libewf_section_free(
-		     &section,
-		     error ) != 1 )
+		if( ( sections_corrections != NULL )
+		 && ( write_count > 0 ) )
+		{
+			if( libewf_segment_file_append_section_correction(
+			     segment_file,
+			     sections_corrections,
+			     file_io_pool_entry,
+			     &section,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append section correction.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else if( libewf_section_free(
+		          &section,
+		          error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -3257,6 +3400,7 @@ ssize_t libewf_segment_file_write_start(
 			       device_information_size,
 			       media_values,
 			       header_values,
+			       sections_corrections,
 			       error );
 
 		if( write_count == -1 )
@@ -3281,6 +3425,7 @@ ssize_t libewf_segment_file_write_start(
 			       media_values,
 			       header_values,
 			       timestamp,
+			       sections_corrections,
 			       error );
 
 		if( write_count == -1 )
@@ -5289,7 +5434,9 @@ int libewf_segment_file_reopen(
 	return( 1 );
 }
 
-/* Corrects sections after streamed write
+/* Corrects sections after streamed write by reading back the section descriptors
+ * This is used for segment files of which the sections were not recorded when written,
+ * such as the segment files written before a resumed write
  * Returns 1 if successful or -1 on error
  */
 int libewf_segment_file_write_sections_correction(
@@ -5471,312 +5618,49 @@ int libewf_segment_file_write_sections_correction(
 
 			goto on_error;
 		}
-		if( section->type != 0 )
+		if( section->type == LIBEWF_SECTION_TYPE_NEXT )
 		{
-			switch( section->type )
+			/* The last segment file should be terminated with a done section and not with a next section
+			 */
+			if( last_segment_file != 0 )
 			{
-				case LIBEWF_SECTION_TYPE_DEVICE_INFORMATION:
-					if( *device_information == NULL )
-					{
-						if( libewf_device_information_generate(
-						     device_information,
-						     device_information_size,
-						     media_values,
-						     header_values,
-						     error ) != 1 )
-						{
-							libcerror_error_set(
-							 error,
-							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-							 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-							 "%s: unable to generate device information.",
-							 function );
-
-							goto on_error;
-						}
-					}
-#if defined( HAVE_DEBUG_OUTPUT )
-					if( libcnotify_verbose != 0 )
-					{
-						libcnotify_printf(
-						 "%s: correcting device information section.\n",
-						 function );
-					}
-#endif
-					if( libbfio_pool_seek_offset(
-					     file_io_pool,
-					     file_io_pool_entry,
-					     section->start_offset,
-					     SEEK_SET,
-					     error ) == -1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_SEEK_FAILED,
-						 "%s: unable to find offset to correct device information section.",
-						 function );
-
-						goto on_error;
-					}
-					segment_file->current_offset = section->start_offset;
-
-					/* Do not include the end of string character in the compressed data
-					 */
-					write_count = libewf_section_write_compressed_string(
-						       section,
-						       segment_file->io_handle,
-						       file_io_pool,
-						       file_io_pool_entry,
-						       2,
-						       LIBEWF_SECTION_TYPE_DEVICE_INFORMATION,
-						       NULL,
-						       0,
-						       section->start_offset,
-						       segment_file->io_handle->compression_method,
-						       LIBEWF_COMPRESSION_DEFAULT,
-						       *device_information,
-						       *device_information_size - 2,
-						       (size_t) section->data_size,
-						       error );
-
-					if( write_count == -1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_WRITE_FAILED,
-						 "%s: unable to write device information section.",
-						 function );
-
-						goto on_error;
-					}
-					segment_file->current_offset += write_count;
-
-					break;
-
-				case LIBEWF_SECTION_TYPE_CASE_DATA:
-					if( *case_data == NULL )
-					{
-						if( libewf_case_data_generate(
-						     case_data,
-						     case_data_size,
-						     media_values,
-						     header_values,
-						     timestamp,
-						     segment_file->io_handle->format,
-						     error ) != 1 )
-						{
-							libcerror_error_set(
-							 error,
-							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-							 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-							 "%s: unable to generate case data.",
-							 function );
-
-							goto on_error;
-						}
-					}
-#if defined( HAVE_DEBUG_OUTPUT )
-					if( libcnotify_verbose != 0 )
-					{
-						libcnotify_printf(
-						 "%s: correcting case data section.\n",
-						 function );
-					}
-#endif
-					if( libbfio_pool_seek_offset(
-					     file_io_pool,
-					     file_io_pool_entry,
-					     section->start_offset,
-					     SEEK_SET,
-					     error ) == -1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_SEEK_FAILED,
-						 "%s: unable to find offset to correct case data section.",
-						 function );
-
-						goto on_error;
-					}
-					segment_file->current_offset = section->start_offset;
-
-					/* Do not include the end of string character in the compressed data
-					 */
-					write_count = libewf_section_write_compressed_string(
-						       section,
-						       segment_file->io_handle,
-						       file_io_pool,
-						       file_io_pool_entry,
-						       2,
-						       LIBEWF_SECTION_TYPE_CASE_DATA,
-						       NULL,
-						       0,
-						       section->start_offset,
-						       segment_file->io_handle->compression_method,
-						       LIBEWF_COMPRESSION_DEFAULT,
-						       *case_data,
-						       *case_data_size - 2,
-						       (size_t) section->data_size,
-						       error );
-
-					if( write_count == -1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_WRITE_FAILED,
-						 "%s: unable to write case data section.",
-						 function );
-
-						goto on_error;
-					}
-					segment_file->current_offset += write_count;
-
-					break;
-
-				case LIBEWF_SECTION_TYPE_NEXT:
-					/* The last segment file should be terminated with a done section and not with a next section
-					 */
-					if( last_segment_file != 0 )
-					{
-						correct_last_next_section = 1;
-						next_section_start_offset = section->start_offset;
-					}
-					break;
+				correct_last_next_section = 1;
+				next_section_start_offset = section->start_offset;
 			}
+			continue;
 		}
-		else if( section->type_string_length == 6 )
-		{
-			if( memory_compare(
-			     section->type_string,
-			     "volume",
-			     6 ) == 0 )
-			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: correcting volume section.\n",
-					 function );
-				}
-#endif
-				if( libbfio_pool_seek_offset(
-				     file_io_pool,
-				     file_io_pool_entry,
-				     section->start_offset,
-				     SEEK_SET,
-				     error ) == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_SEEK_FAILED,
-					 "%s: unable to find offset to correct volume section.",
-					 function );
-
-					goto on_error;
-				}
-				segment_file->current_offset = section->start_offset;
+		write_count = libewf_section_correction_write_section(
+		               section,
+		               segment_file->io_handle,
+		               segment_file->type,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               section->start_offset,
+		               media_values,
+		               header_values,
+		               timestamp,
+		               case_data,
+		               case_data_size,
+		               device_information,
+		               device_information_size,
+		               data_section,
+		               error );
 
-				if( segment_file->type == LIBEWF_SEGMENT_FILE_TYPE_EWF1 )
-				{
-					write_count = libewf_section_volume_e01_write(
-						       section,
-						       segment_file->io_handle,
-						       file_io_pool,
-						       file_io_pool_entry,
-						       section->start_offset,
-						       media_values,
-						       error );
-				}
-				else if( segment_file->type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-				{
-					write_count = libewf_section_volume_s01_write(
-						       section,
-						       segment_file->io_handle,
-						       file_io_pool,
-						       file_io_pool_entry,
-						       section->start_offset,
-						       media_values,
-						       error );
-				}
-				else
-				{
-					write_count = -1;
-				}
-				if( write_count == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_WRITE_FAILED,
-					 "%s: unable to correct volume section.",
-					 function );
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to correct section: %d.",
+			 function,
+			 section_index );
 
-					goto on_error;
-				}
-				segment_file->current_offset += write_count;
-			}
+			goto on_error;
 		}
-		else if( section->type_string_length == 4 )
+		else if( write_count > 0 )
 		{
-			if( memory_compare(
-			     section->type_string,
-			     "data",
-			     4 ) == 0 )
-			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: correcting data section.\n",
-					 function );
-				}
-#endif
-				if( libbfio_pool_seek_offset(
-				     file_io_pool,
-				     file_io_pool_entry,
-				     section->start_offset,
-				     SEEK_SET,
-				     error ) == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_SEEK_FAILED,
-					 "%s: unable to seek offset of data section.",
-					 function );
-
-					goto on_error;
-				}
-				segment_file->current_offset = section->start_offset;
-
-				write_count = libewf_section_data_write(
-					       section,
-					       segment_file->io_handle,
-					       file_io_pool,
-					       file_io_pool_entry,
-					       section->start_offset,
-					       media_values,
-					       data_section,
-					       error );
-
-				if( write_count == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_WRITE_FAILED,
-					 "%s: unable to correct data section.",
-					 function );
-
-					goto on_error;
-				}
-				segment_file->current_offset += write_count;
-			}
+			segment_file->current_offset = section->start_offset + write_count;
 		}
 	}
 	if( correct_last_next_section == 0 )
@@ -5877,33 +5761,378 @@ on_error:
 	return( -1 );
 }
 
-/* Reads a segment file
- * Callback function for the segment files list
- * Returns 1 if successful or -1 on error
+/* Determines the window of section descriptors that is read at once
+ * EWF version 1 stores the section descriptors before the section data and they are read front to back,
+ * hence the window starts at the section descriptor
+ * EWF version 2 stores the section descriptors after the section data and they are read back to front,
+ * hence the window ends at the end of the section descriptor
+ * Returns 1 if successful, 0 if the section descriptor lies outside the segment file or -1 on error
  */
-int libewf_segment_file_read_element_data(
-     libewf_io_handle_t *io_handle,
-     libbfio_pool_t *file_io_pool,
-     libfdata_list_element_t *element,
-     libfcache_cache_t *segment_file_cache,
-     int file_io_pool_entry,
-     off64_t segment_file_offset,
+int libewf_segment_file_get_section_descriptors_window(
+     libewf_segment_file_t *segment_file,
+     off64_t section_descriptor_offset,
      size64_t segment_file_size,
-     uint32_t element_flags LIBEWF_ATTRIBUTE_UNUSED,
-     uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
+     off64_t *window_offset,
+     size_t *window_data_size,
      libcerror_error_t **error )
 {
-	libfcache_cache_t *sections_cache   = NULL;
-	libewf_section_t *section           = NULL;
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_segment_file_read_element_data";
-	off64_t section_data_offset         = 0;
-	ssize_t read_count                  = 0;
-	int element_index                   = 0;
-	int last_section                    = 0;
-	int number_of_sections              = 0;
-	int result                          = 0;
-	int section_index                   = 0;
+	static char *function               = "libewf_segment_file_get_section_descriptors_window";
+	size64_t window_end_offset          = 0;
+	size_t section_descriptor_data_size = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->major_version == 1 )
+	{
+		section_descriptor_data_size = sizeof( ewf_section_descriptor_v1_t );
+	}
+	else if( segment_file->major_version == 2 )
+	{
+		section_descriptor_data_size = sizeof( ewf_section_descriptor_v2_t );
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version.",
+		 function );
+
+		return( -1 );
+	}
+	if( section_descriptor_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid section descriptor offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( window_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid window offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( window_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid window data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( (size64_t) section_descriptor_offset > segment_file_size )
+	 || ( section_descriptor_data_size > ( segment_file_size - (size64_t) section_descriptor_offset ) ) )
+	{
+		return( 0 );
+	}
+	if( segment_file->major_version == 1 )
+	{
+		window_end_offset = segment_file_size;
+
+		if( window_end_offset > ( (size64_t) section_descriptor_offset + LIBEWF_SEGMENT_FILE_SECTION_DESCRIPTORS_WINDOW_SIZE ) )
+		{
+			window_end_offset = (size64_t) section_descriptor_offset + LIBEWF_SEGMENT_FILE_SECTION_DESCRIPTORS_WINDOW_SIZE;
+		}
+		*window_offset = section_descriptor_offset;
+	}
+	else
+	{
+		window_end_offset = (size64_t) section_descriptor_offset + section_descriptor_data_size;
+
+		if( window_end_offset > LIBEWF_SEGMENT_FILE_SECTION_DESCRIPTORS_WINDOW_SIZE )
+		{
+			*window_offset = (off64_t) ( window_end_offset - LIBEWF_SEGMENT_FILE_SECTION_DESCRIPTORS_WINDOW_SIZE );
+		}
+		else
+		{
+			*window_offset = 0;
+		}
+	}
+	*window_data_size = (size_t) ( window_end_offset - (size64_t) *window_offset );
+
+	return( 1 );
+}
+
+/* Reads a window of section descriptors
+ * The section descriptors and the small sections in between them are read at once,
+ * hence the section descriptors within the window do not need to be read individually
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_segment_file_read_section_descriptors_window(
+         libewf_segment_file_t *segment_file,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         off64_t window_offset,
+         uint8_t *window_data,
+         size_t window_data_size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_read_section_descriptors_window";
+	ssize_t read_count    = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_file->major_version != 1 )
+	 && ( segment_file->major_version != 2 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version.",
+		 function );
+
+		return( -1 );
+	}
+	if( window_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid window offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( window_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid window data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( window_data_size == 0 )
+	 || ( window_data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid window data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading section descriptors window of size: %" PRIzd " from file IO pool entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 window_data_size,
+		 file_io_pool_entry,
+		 window_offset,
+		 window_offset );
+	}
+#endif
+	if( libbfio_pool_seek_offset(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     window_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek section descriptors window offset: %" PRIi64 " in file IO pool entry: %d.",
+		 function,
+		 window_offset,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	read_count = libbfio_pool_read_buffer(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              window_data,
+	              window_data_size,
+	              error );
+
+	if( read_count != (ssize_t) window_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read section descriptors window from file IO pool entry: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Reads a section descriptor
+ * The section descriptor is parsed from the window data if it lies within the window,
+ * otherwise it is read from the segment file
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_segment_file_read_section_descriptor(
+         libewf_segment_file_t *segment_file,
+         libewf_section_t *section,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         off64_t section_descriptor_offset,
+         const uint8_t *window_data,
+         size_t window_data_size,
+         off64_t window_offset,
+         libcerror_error_t **error )
+{
+	static char *function               = "libewf_segment_file_read_section_descriptor";
+	size_t section_descriptor_data_size = 0;
+	ssize_t read_count                  = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->major_version == 1 )
+	{
+		section_descriptor_data_size = sizeof( ewf_section_descriptor_v1_t );
+	}
+	else if( segment_file->major_version == 2 )
+	{
+		section_descriptor_data_size = sizeof( ewf_section_descriptor_v2_t );
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( window_data == NULL )
+	 || ( window_data_size == 0 )
+	 || ( section_descriptor_offset < window_offset )
+	 || ( (size64_t) ( section_descriptor_offset - window_offset ) > window_data_size )
+	 || ( section_descriptor_data_size > ( window_data_size - (size_t) ( section_descriptor_offset - window_offset ) ) ) )
+	{
+		read_count = libewf_section_descriptor_read(
+		              section,
+		              file_io_pool,
+		              file_io_pool_entry,
+		              section_descriptor_offset,
+		              segment_file->major_version,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read section descriptor.",
+			 function );
+
+			return( -1 );
+		}
+		return( read_count );
+	}
+	if( libewf_section_descriptor_read_data(
+	     section,
+	     &( window_data[ section_descriptor_offset - window_offset ] ),
+	     section_descriptor_data_size,
+	     section_descriptor_offset,
+	     segment_file->major_version,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read section descriptor at offset: %" PRIi64 ".",
+		 function,
+		 section_descriptor_offset );
+
+		return( -1 );
+	}
+	return( (ssize_t) section_descriptor_data_size );
+}
+
+/* Reads a segment file
+ * Callback function for the segment files list
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_read_element_data(
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libfdata_list_element_t *element,
+     libfcache_cache_t *segment_file_cache,
+     int file_io_pool_entry,
+     off64_t segment_file_offset,
+     size64_t segment_file_size,
+     uint32_t element_flags LIBEWF_ATTRIBUTE_UNUSED,
+     uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	uint8_t window_data[ LIBEWF_SEGMENT_FILE_SECTION_DESCRIPTORS_WINDOW_SIZE ];
+
+	libfcache_cache_t *sections_cache   = NULL;
+	libewf_section_t *section           = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_segment_file_read_element_data";
+	size_t section_descriptor_data_size = 0;
+	size_t window_data_size             = 0;
+	off64_t section_data_offset         = 0;
+	off64_t window_offset               = 0;
+	ssize_t read_count                  = 0;
+	uint8_t read_ahead                  = 0;
+	int element_index                   = 0;
+	int last_section                    = 0;
+	int number_of_sections              = 0;
+	int result                          = 0;
+	int section_index                   = 0;
 
 	LIBEWF_UNREFERENCED_PARAMETER( element_flags )
 	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
@@ -5919,6 +6148,10 @@ int libewf_segment_file_read_element_data(
 
 		return( -1 );
 	}
+	LIBEWF_PROBE_SEGMENT_FILE_OPEN_ENTRY(
+	 file_io_pool_entry,
+	 segment_file_size );
+
 	if( libewf_segment_file_initialize(
 	     &segment_file,
 	     io_handle,
@@ -5995,7 +6228,7 @@ int libewf_segment_file_read_element_data(
 			 "%s: unsupported compression method.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 	}
 	/* Read the section descriptors:
@@ -6004,12 +6237,20 @@ int libewf_segment_file_read_element_data(
 	 */
 	if( segment_file->major_version == 1 )
 	{
+		section_descriptor_data_size = sizeof( ewf_section_descriptor_v1_t );
+
 		segment_file_offset = (off64_t) read_count;
 	}
 	else if( segment_file->major_version == 2 )
 	{
+		section_descriptor_data_size = sizeof( ewf_section_descriptor_v2_t );
+
 		segment_file_offset = (off64_t) segment_file_size - sizeof( ewf_section_descriptor_v2_t );
 	}
+	/* The section descriptors are read ahead in a window, starting with the first section descriptor,
+	 * and as long as the sections in between them are small, such as the header, volume and hash sections
+	 */
+	read_ahead = 1;
 	last_section = 0;
 
 	if( libewf_section_initialize(
@@ -6028,12 +6269,76 @@ int libewf_segment_file_read_element_data(
 	while( ( segment_file_offset > 0 )
 	    && ( (size64_t) segment_file_offset < segment_file_size ) )
 	{
-		read_count = libewf_section_descriptor_read(
+		if( ( read_ahead != 0 )
+		 && ( ( window_data_size == 0 )
+		  || ( segment_file_offset < window_offset )
+		  || ( ( (size64_t) ( segment_file_offset - window_offset ) + section_descriptor_data_size ) > (size64_t) window_data_size ) ) )
+		{
+			result = libewf_segment_file_get_section_descriptors_window(
+			          segment_file,
+			          segment_file_offset,
+			          segment_file_size,
+			          &window_offset,
+			          &window_data_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve section descriptors window.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				window_data_size = 0;
+			}
+			else
+			{
+				read_count = libewf_segment_file_read_section_descriptors_window(
+				              segment_file,
+				              file_io_pool,
+				              file_io_pool_entry,
+				              window_offset,
+				              window_data,
+				              window_data_size,
+				              error );
+
+				/* The section descriptors are read individually if the window cannot be read
+				 */
+				if( read_count == -1 )
+				{
+#if defined( HAVE_DEBUG_OUTPUT )
+					if( libcnotify_verbose != 0 )
+					{
+						if( ( error != NULL )
+						 && ( *error != NULL ) )
+						{
+							libcnotify_print_error_backtrace(
+							 *error );
+						}
+					}
+#endif
+					libcerror_error_free(
+					 error );
+
+					window_data_size = 0;
+				}
+			}
+		}
+		read_count = libewf_segment_file_read_section_descriptor(
+			      segment_file,
 			      section,
 			      file_io_pool,
 			      file_io_pool_entry,
 			      segment_file_offset,
-			      segment_file->major_version,
+			      window_data,
+			      window_data_size,
+			      window_offset,
 			      error );
 
 		if( read_count == -1 )
@@ -6065,6 +6370,17 @@ int libewf_segment_file_read_element_data(
 		}
 		segment_file->current_offset = segment_file_offset + read_count;
 
+		/* After a large section, such as a sectors or table section, the next section descriptor
+		 * lies outside the window and is read individually
+		 */
+		if( section->size <= (size64_t) LIBEWF_SEGMENT_FILE_SECTION_DESCRIPTORS_WINDOW_SIZE )
+		{
+			read_ahead = 1;
+		}
+		else
+		{
+			read_ahead = 0;
+		}
 		if( segment_file->major_version == 1 )
 		{
 			if( section->type == LIBEWF_SECTION_TYPE_NEXT )
@@ -6442,6 +6758,12 @@ int libewf_segment_file_read_element_data(
 
 		goto on_error;
 	}
+	LIBEWF_PROBE_SEGMENT_FILE_OPEN_RETURN(
+	 file_io_pool_entry,
+	 segment_file->segment_number,
+	 number_of_sections,
+	 1 );
+
 	return( 1 );
 
 on_error:
@@ -6463,6 +6785,12 @@ on_error:
 		 &segment_file,
 		 NULL );
 	}
+	LIBEWF_PROBE_SEGMENT_FILE_OPEN_RETURN(
+	 file_io_pool_entry,
+	 0,
+	 0,
+	 -1 );
+
 	return( -1 );
 }
 
@@ -6645,6 +6973,22 @@ int libewf_segment_file_read_chunk_group_element_data(
 
 		return( -1 );
 	}
+	if( libewf_io_handle_open_segment_file(
+	     segment_file->io_handle,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO pool entry: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
 	if( libewf_section_initialize(
 	     &section,
 	     error ) != 1 )
@@ -6760,6 +7104,14 @@ int libewf_segment_file_read_chunk_group_element_data(
 	segment_file->current_offset += read_count;
 	chunk_group_data_size        -= read_count;
 
+	libewf_statistics_add(
+	 segment_file->io_handle->statistics.number_of_chunk_group_reads,
+	 1 );
+
+	libewf_statistics_add(
+	 segment_file->io_handle->statistics.number_of_bytes_read,
+	 segment_file->current_offset - chunk_group_data_offset );
+
 	if( number_of_entries == 0 )
 	{
 		libcerror_error_set(
@@ -6960,6 +7312,12 @@ int libewf_segment_file_get_chunk_group_by_offset(
 
 		return( -1 );
 	}
+	if( segment_file->io_handle != NULL )
+	{
+		libewf_statistics_add(
+		 segment_file->io_handle->statistics.number_of_chunk_group_lookups,
+		 1 );
+	}
 	result = libfdata_list_get_element_value_at_offset(
 		  segment_file->chunk_groups_list,
 		  (intptr_t *) file_io_pool,
@@ -211,6 +211,13 @@ ssize_t libewf_segment_file_read_volume_section(
          libewf_media_values_t *media_values,
          libcerror_error_t **error );
 
+int libewf_segment_file_append_section_correction(
+     libewf_segment_file_t *segment_file,
+     libcdata_array_t *sections_corrections,
+     int file_io_pool_entry,
+     libewf_section_t **section,
+     libcerror_error_t **error );
+
 ssize_t libewf_segment_file_write_device_information_section(
          libewf_segment_file_t *segment_file,
          libbfio_pool_t *file_io_pool,
@@ -219,6 +226,7 @@ ssize_t libewf_segment_file_write_device_information_section(
          size_t *device_information_size,
          libewf_media_values_t *media_values,
          libfvalue_table_t *header_values,
+         libcdata_array_t *sections_corrections,
          libcerror_error_t **error );
 
 ssize_t libewf_segment_file_write_case_data_section(
@@ -230,6 +238,7 @@ ssize_t libewf_segment_file_write_case_data_section(
          libewf_media_values_t *media_values,
          libfvalue_table_t *header_values,
          time_t timestamp,
+         libcdata_array_t *sections_corrections,
          libcerror_error_t **error );
 
 ssize_t libewf_segment_file_write_header_section(
@@ -281,6 +290,7 @@ ssize_t libewf_segment_file_write_start(
          libewf_media_values_t *media_values,
          libfvalue_table_t *header_values,
          time_t timestamp,
+         libcdata_array_t *sections_corrections,
          libcerror_error_t **error );
 
 ssize_t libewf_segment_file_write_chunks_section_start(
@@ -371,6 +381,34 @@ int libewf_segment_file_write_sections_correction(
      ewf_data_t **data_section,
      libcerror_error_t **error );
 
+int libewf_segment_file_get_section_descriptors_window(
+     libewf_segment_file_t *segment_file,
+     off64_t section_descriptor_offset,
+     size64_t segment_file_size,
+     off64_t *window_offset,
+     size_t *window_data_size,
+     libcerror_error_t **error );
+
+ssize_t libewf_segment_file_read_section_descriptors_window(
+         libewf_segment_file_t *segment_file,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         off64_t window_offset,
+         uint8_t *window_data,
+         size_t window_data_size,
+         libcerror_error_t **error );
+
+ssize_t libewf_segment_file_read_section_descriptor(
+         libewf_segment_file_t *segment_file,
+         libewf_section_t *section,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         off64_t section_descriptor_offset,
+         const uint8_t *window_data,
+         size_t window_data_size,
+         off64_t window_offset,
+         libcerror_error_t **error );
+
 int libewf_segment_file_read_element_data(
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
@@ -148,6 +148,20 @@ int libewf_segment_table_initialize(
 
 		goto on_error;
 	}
+	if( libcdata_array_initialize(
+	     &( ( *segment_table )->additional_basenames ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create additional basenames array.",
+		 function );
+
+		goto on_error;
+	}
 	( *segment_table )->maximum_segment_size = maximum_segment_size;
 
 	return( 1 );
@@ -155,6 +169,12 @@ int libewf_segment_table_initialize(
 on_error:
 	if( *segment_table != NULL )
 	{
+		if( ( *segment_table )->segment_files_cache != NULL )
+		{
+			libfcache_cache_free(
+			 &( ( *segment_table )->segment_files_cache ),
+			 NULL );
+		}
 		if( ( *segment_table )->segment_files_list != NULL )
 		{
 			libfdata_list_free(
@@ -223,6 +243,20 @@ int libewf_segment_table_free(
 
 			result = -1;
 		}
+		if( libcdata_array_free(
+		     &( ( *segment_table )->additional_basenames ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_segment_table_basename_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free additional basenames array.",
+			 function );
+
+			result = -1;
+		}
 		memory_free(
 		 *segment_table );
 
@@ -362,6 +396,22 @@ int libewf_segment_table_clone(
 
 		goto on_error;
 	}
+	if( libcdata_array_clone(
+	     &( ( *destination_segment_table )->additional_basenames ),
+	     source_segment_table->additional_basenames,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_segment_table_basename_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libewf_segment_table_basename_clone,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination additional basenames array.",
+		 function );
+
+		goto on_error;
+	}
 	( *destination_segment_table )->maximum_segment_size = source_segment_table->maximum_segment_size;
 
 	return( 1 );
@@ -369,6 +419,12 @@ int libewf_segment_table_clone(
 on_error:
 	if( *destination_segment_table != NULL )
 	{
+		if( ( *destination_segment_table )->segment_files_cache != NULL )
+		{
+			libfcache_cache_free(
+			 &( ( *destination_segment_table )->segment_files_cache ),
+			 NULL );
+		}
 		if( ( *destination_segment_table )->segment_files_list != NULL )
 		{
 			libfdata_list_free(
@@ -442,11 +498,133 @@ int libewf_segment_table_empty(
 
 		result = -1;
 	}
+	if( libcdata_array_empty(
+	     segment_table->additional_basenames,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_segment_table_basename_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty additional basenames array.",
+		 function );
+
+		result = -1;
+	}
 	segment_table->number_of_segments = 0;
 
 	return( result );
 }
 
+/* Frees a basename
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_table_basename_free(
+     system_character_t **basename,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_table_basename_free";
+
+	if( basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename.",
+		 function );
+
+		return( -1 );
+	}
+	if( *basename != NULL )
+	{
+		memory_free(
+		 *basename );
+
+		*basename = NULL;
+	}
+	return( 1 );
+}
+
+/* Clones a basename
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_table_basename_clone(
+     system_character_t **destination_basename,
+     system_character_t *source_basename,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_table_basename_clone";
+	size_t basename_size  = 0;
+
+	if( destination_basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination basename.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_basename != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination basename value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_basename == NULL )
+	{
+		*destination_basename = NULL;
+
+		return( 1 );
+	}
+	basename_size = system_string_length(
+	                 source_basename ) + 1;
+
+	*destination_basename = system_string_allocate(
+	                         basename_size );
+
+	if( *destination_basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create destination basename.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     *destination_basename,
+	     source_basename,
+	     sizeof( system_character_t ) * basename_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy source to destination basename.",
+		 function );
+
+		memory_free(
+		 *destination_basename );
+
+		*destination_basename = NULL;
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Retrieves the size of the basename
  * Returns 1 if successful, 0 if value not present or -1 on error
  */
@@ -927,20 +1105,23 @@ int libewf_segment_table_set_basename(
 	return( 1 );
 }
 
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
-
-/* Retrieves the size of the basename
- * Returns 1 if successful, 0 if value not present or -1 on error
+/* Appends an additional basename
+ * The segment files are distributed round-robin over the basename and the additional basenames
+ * Returns 1 if successful or -1 on error
  */
-int libewf_segment_table_get_basename_size_wide(
+int libewf_segment_table_append_basename(
      libewf_segment_table_t *segment_table,
-     size_t *basename_size,
+     const char *basename,
+     size_t basename_length,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_segment_table_get_basename_size_wide";
+	system_character_t *additional_basename = NULL;
+	static char *function                   = "libewf_segment_table_append_basename";
+	size_t additional_basename_size         = 0;
+	int entry_index                         = 0;
 
-#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	int result            = 0;
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	int result                              = 0;
 #endif
 
 	if( segment_table == NULL )
@@ -954,37 +1135,31 @@ int libewf_segment_table_get_basename_size_wide(
 
 		return( -1 );
 	}
-	if( basename_size == NULL )
+	if( basename == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid basename size.",
+		 "%s: invalid basename.",
 		 function );
 
 		return( -1 );
 	}
-	if( segment_table->basename == NULL )
-	{
-		return( 0 );
-	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	*basename_size = segment_table->basename_size;
-#else
 	if( libclocale_codepage == 0 )
 	{
 #if SIZEOF_WCHAR_T == 4
 		result = libuna_utf32_string_size_from_utf8(
-		          (libuna_utf8_character_t *) segment_table->basename,
-		          segment_table->basename_size,
-		          basename_size,
+		          (libuna_utf8_character_t *) basename,
+		          basename_length + 1,
+		          &additional_basename_size,
 		          error );
 #elif SIZEOF_WCHAR_T == 2
 		result = libuna_utf16_string_size_from_utf8(
-		          (libuna_utf8_character_t *) segment_table->basename,
-		          segment_table->basename_size,
-		          basename_size,
+		          (libuna_utf8_character_t *) basename,
+		          basename_length + 1,
+		          &additional_basename_size,
 		          error );
 #else
 #error Unsupported size of wchar_t
@@ -994,17 +1169,17 @@ int libewf_segment_table_get_basename_size_wide(
 	{
 #if SIZEOF_WCHAR_T == 4
 		result = libuna_utf32_string_size_from_byte_stream(
-		          (uint8_t *) segment_table->basename,
-		          segment_table->basename_size,
+		          (uint8_t *) basename,
+		          basename_length + 1,
 		          libclocale_codepage,
-		          basename_size,
+		          &additional_basename_size,
 		          error );
 #elif SIZEOF_WCHAR_T == 2
 		result = libuna_utf16_string_size_from_byte_stream(
-		          (uint8_t *) segment_table->basename,
-		          segment_table->basename_size,
+		          (uint8_t *) basename,
+		          basename_length + 1,
 		          libclocale_codepage,
-		          basename_size,
+		          &additional_basename_size,
 		          error );
 #else
 #error Unsupported size of wchar_t
@@ -1016,73 +1191,44 @@ int libewf_segment_table_get_basename_size_wide(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
 		 LIBCERROR_CONVERSION_ERROR_GENERIC,
-		 "%s: unable to determine basename size.",
+		 "%s: unable to determine additional basename size.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
-	return( 1 );
-}
-
-/* Retrieves the basename
- * Returns 1 if successful, 0 if value not present or -1 on error
- */
-int libewf_segment_table_get_basename_wide(
-     libewf_segment_table_t *segment_table,
-     wchar_t *basename,
-     size_t basename_size,
-     libcerror_error_t **error )
-{
-	static char *function     = "libewf_segment_table_get_basename_wide";
-	size_t wide_basename_size = 0;
-
-#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	int result                = 0;
+#else
+	additional_basename_size = basename_length + 1;
 #endif
+	additional_basename = system_string_allocate(
+	                       additional_basename_size );
 
-	if( segment_table == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment table.",
-		 function );
-
-		return( -1 );
-	}
-	if( basename == NULL )
+	if( additional_basename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid basename.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create additional basename.",
 		 function );
 
-		return( -1 );
-	}
-	if( segment_table->basename == NULL )
-	{
-		return( 0 );
+		goto on_error;
 	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	wide_basename_size = segment_table->basename_size;
-#else
 	if( libclocale_codepage == 0 )
 	{
 #if SIZEOF_WCHAR_T == 4
-		result = libuna_utf32_string_size_from_utf8(
-		          (libuna_utf8_character_t *) segment_table->basename,
-		          segment_table->basename_size,
-		          &wide_basename_size,
+		result = libuna_utf32_string_copy_from_utf8(
+		          (libuna_utf32_character_t *) additional_basename,
+		          additional_basename_size,
+		          (libuna_utf8_character_t *) basename,
+		          basename_length + 1,
 		          error );
 #elif SIZEOF_WCHAR_T == 2
-		result = libuna_utf16_string_size_from_utf8(
-		          (libuna_utf8_character_t *) segment_table->basename,
-		          segment_table->basename_size,
-		          &wide_basename_size,
+		result = libuna_utf16_string_copy_from_utf8(
+		          (libuna_utf16_character_t *) additional_basename,
+		          additional_basename_size,
+		          (libuna_utf8_character_t *) basename,
+		          basename_length + 1,
 		          error );
 #else
 #error Unsupported size of wchar_t
@@ -1091,18 +1237,20 @@ int libewf_segment_table_get_basename_wide(
 	else
 	{
 #if SIZEOF_WCHAR_T == 4
-		result = libuna_utf32_string_size_from_byte_stream(
-		          (uint8_t *) segment_table->basename,
-		          segment_table->basename_size,
+		result = libuna_utf32_string_copy_from_byte_stream(
+		          (libuna_utf32_character_t *) additional_basename,
+		          additional_basename_size,
+		          (uint8_t *) basename,
+		          basename_length + 1,
 		          libclocale_codepage,
-		          &wide_basename_size,
 		          error );
 #elif SIZEOF_WCHAR_T == 2
-		result = libuna_utf16_string_size_from_byte_stream(
-		          (uint8_t *) segment_table->basename,
-		          segment_table->basename_size,
+		result = libuna_utf16_string_copy_from_byte_stream(
+		          (libuna_utf16_character_t *) additional_basename,
+		          additional_basename_size,
+		          (uint8_t *) basename,
+		          basename_length + 1,
 		          libclocale_codepage,
-		          &wide_basename_size,
 		          error );
 #else
 #error Unsupported size of wchar_t
@@ -1114,22 +1262,258 @@ int libewf_segment_table_get_basename_wide(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
 		 LIBCERROR_CONVERSION_ERROR_GENERIC,
-		 "%s: unable to determine basename size.",
+		 "%s: unable to set additional basename.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
-	if( basename_size < wide_basename_size )
+#else
+	if( system_string_copy(
+	     additional_basename,
+	     basename,
+	     basename_length ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-		 "%s: basename too small.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to set additional basename.",
 		 function );
 
-		return( -1 );
+		goto on_error;
+	}
+	additional_basename[ basename_length ] = 0;
+#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+	if( libcdata_array_append_entry(
+	     segment_table->additional_basenames,
+	     &entry_index,
+	     (intptr_t *) additional_basename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append additional basename to array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( additional_basename != NULL )
+	{
+		memory_free(
+		 additional_basename );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Retrieves the size of the basename
+ * Returns 1 if successful, 0 if value not present or -1 on error
+ */
+int libewf_segment_table_get_basename_size_wide(
+     libewf_segment_table_t *segment_table,
+     size_t *basename_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_table_get_basename_size_wide";
+
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	int result            = 0;
+#endif
+
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename size.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_table->basename == NULL )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	*basename_size = segment_table->basename_size;
+#else
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf32_string_size_from_utf8(
+		          (libuna_utf8_character_t *) segment_table->basename,
+		          segment_table->basename_size,
+		          basename_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf16_string_size_from_utf8(
+		          (libuna_utf8_character_t *) segment_table->basename,
+		          segment_table->basename_size,
+		          basename_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf32_string_size_from_byte_stream(
+		          (uint8_t *) segment_table->basename,
+		          segment_table->basename_size,
+		          libclocale_codepage,
+		          basename_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf16_string_size_from_byte_stream(
+		          (uint8_t *) segment_table->basename,
+		          segment_table->basename_size,
+		          libclocale_codepage,
+		          basename_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine basename size.",
+		 function );
+
+		return( -1 );
+	}
+#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+	return( 1 );
+}
+
+/* Retrieves the basename
+ * Returns 1 if successful, 0 if value not present or -1 on error
+ */
+int libewf_segment_table_get_basename_wide(
+     libewf_segment_table_t *segment_table,
+     wchar_t *basename,
+     size_t basename_size,
+     libcerror_error_t **error )
+{
+	static char *function     = "libewf_segment_table_get_basename_wide";
+	size_t wide_basename_size = 0;
+
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	int result                = 0;
+#endif
+
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_table->basename == NULL )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	wide_basename_size = segment_table->basename_size;
+#else
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf32_string_size_from_utf8(
+		          (libuna_utf8_character_t *) segment_table->basename,
+		          segment_table->basename_size,
+		          &wide_basename_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf16_string_size_from_utf8(
+		          (libuna_utf8_character_t *) segment_table->basename,
+		          segment_table->basename_size,
+		          &wide_basename_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf32_string_size_from_byte_stream(
+		          (uint8_t *) segment_table->basename,
+		          segment_table->basename_size,
+		          libclocale_codepage,
+		          &wide_basename_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf16_string_size_from_byte_stream(
+		          (uint8_t *) segment_table->basename,
+		          segment_table->basename_size,
+		          libclocale_codepage,
+		          &wide_basename_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine basename size.",
+		 function );
+
+		return( -1 );
+	}
+#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+	if( basename_size < wide_basename_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: basename too small.",
+		 function );
+
+		return( -1 );
 	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( system_string_copy(
@@ -1403,8 +1787,322 @@ int libewf_segment_table_set_basename_wide(
 	return( 1 );
 }
 
+/* Appends an additional basename
+ * The segment files are distributed round-robin over the basename and the additional basenames
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_table_append_basename_wide(
+     libewf_segment_table_t *segment_table,
+     const wchar_t *basename,
+     size_t basename_length,
+     libcerror_error_t **error )
+{
+	system_character_t *additional_basename = NULL;
+	static char *function                   = "libewf_segment_table_append_basename_wide";
+	size_t additional_basename_size         = 0;
+	int entry_index                         = 0;
+
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	int result                              = 0;
+#endif
+
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	additional_basename_size = basename_length + 1;
+#else
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf8_string_size_from_utf32(
+		          (libuna_utf32_character_t *) basename,
+		          basename_length + 1,
+		          &additional_basename_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf8_string_size_from_utf16(
+		          (libuna_utf16_character_t *) basename,
+		          basename_length + 1,
+		          &additional_basename_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_byte_stream_size_from_utf32(
+		          (libuna_utf32_character_t *) basename,
+		          basename_length + 1,
+		          libclocale_codepage,
+		          &additional_basename_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_byte_stream_size_from_utf16(
+		          (libuna_utf16_character_t *) basename,
+		          basename_length + 1,
+		          libclocale_codepage,
+		          &additional_basename_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine additional basename size.",
+		 function );
+
+		goto on_error;
+	}
+#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+	additional_basename = system_string_allocate(
+	                       additional_basename_size );
+
+	if( additional_basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create additional basename.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( system_string_copy(
+	     additional_basename,
+	     basename,
+	     basename_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to set additional basename.",
+		 function );
+
+		goto on_error;
+	}
+	additional_basename[ basename_length ] = 0;
+#else
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf8_string_copy_from_utf32(
+		          (libuna_utf8_character_t *) additional_basename,
+		          additional_basename_size,
+		          (libuna_utf32_character_t *) basename,
+		          basename_length + 1,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf8_string_copy_from_utf16(
+		          (libuna_utf8_character_t *) additional_basename,
+		          additional_basename_size,
+		          (libuna_utf16_character_t *) basename,
+		          basename_length + 1,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_byte_stream_copy_from_utf32(
+		          (uint8_t *) additional_basename,
+		          additional_basename_size,
+		          libclocale_codepage,
+		          (libuna_utf32_character_t *) basename,
+		          basename_length + 1,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_byte_stream_copy_from_utf16(
+		          (uint8_t *) additional_basename,
+		          additional_basename_size,
+		          libclocale_codepage,
+		          (libuna_utf16_character_t *) basename,
+		          basename_length + 1,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to set additional basename.",
+		 function );
+
+		goto on_error;
+	}
+#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+	if( libcdata_array_append_entry(
+	     segment_table->additional_basenames,
+	     &entry_index,
+	     (intptr_t *) additional_basename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append additional basename to array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( additional_basename != NULL )
+	{
+		memory_free(
+		 additional_basename );
+	}
+	return( -1 );
+}
+
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
+/* Retrieves the basename of a specific segment
+ * The segment files are distributed round-robin over the basename and the additional basenames
+ * The basename size includes the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_table_get_basename_by_segment_number(
+     libewf_segment_table_t *segment_table,
+     uint32_t segment_number,
+     system_character_t **basename,
+     size_t *basename_size,
+     libcerror_error_t **error )
+{
+	system_character_t *additional_basename = NULL;
+	static char *function                   = "libewf_segment_table_get_basename_by_segment_number";
+	int entry_index                         = 0;
+	int number_of_additional_basenames      = 0;
+
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     segment_table->additional_basenames,
+	     &number_of_additional_basenames,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of additional basenames.",
+		 function );
+
+		return( -1 );
+	}
+	entry_index = (int) ( segment_number % ( (uint32_t) number_of_additional_basenames + 1 ) );
+
+	if( entry_index == 0 )
+	{
+		*basename      = segment_table->basename;
+		*basename_size = segment_table->basename_size;
+
+		return( 1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     segment_table->additional_basenames,
+	     entry_index - 1,
+	     (intptr_t **) &additional_basename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve additional basename: %d.",
+		 function,
+		 entry_index - 1 );
+
+		return( -1 );
+	}
+	if( additional_basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing additional basename: %d.",
+		 function,
+		 entry_index - 1 );
+
+		return( -1 );
+	}
+	*basename      = additional_basename;
+	*basename_size = system_string_length(
+	                  additional_basename ) + 1;
+
+	return( 1 );
+}
+
 /* Sets the maximum segment size
  * Returns 1 if successful or -1 on error
  */
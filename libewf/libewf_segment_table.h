@@ -27,6 +27,7 @@
 
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
+#include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
@@ -48,6 +49,10 @@ struct libewf_segment_table
 	 */
 	size_t basename_size;
 
+	/* The additional basenames array
+	 */
+	libcdata_array_t *additional_basenames;
+
 	/* The maximum segment size
 	 */
 	size64_t maximum_segment_size;
@@ -88,6 +93,15 @@ int libewf_segment_table_empty(
      libewf_segment_table_t *segment_table,
      libcerror_error_t **error );
 
+int libewf_segment_table_basename_free(
+     system_character_t **basename,
+     libcerror_error_t **error );
+
+int libewf_segment_table_basename_clone(
+     system_character_t **destination_basename,
+     system_character_t *source_basename,
+     libcerror_error_t **error );
+
 int libewf_segment_table_get_basename_size(
      libewf_segment_table_t *segment_table,
      size_t *basename_size,
@@ -105,6 +119,12 @@ int libewf_segment_table_set_basename(
      size_t basename_length,
      libcerror_error_t **error );
 
+int libewf_segment_table_append_basename(
+     libewf_segment_table_t *segment_table,
+     const char *basename,
+     size_t basename_length,
+     libcerror_error_t **error );
+
 #if defined( HAVE_WIDE_CHARACTER_TYPE )
 
 int libewf_segment_table_get_basename_size_wide(
@@ -124,8 +144,21 @@ int libewf_segment_table_set_basename_wide(
      size_t basename_length,
      libcerror_error_t **error );
 
+int libewf_segment_table_append_basename_wide(
+     libewf_segment_table_t *segment_table,
+     const wchar_t *basename,
+     size_t basename_length,
+     libcerror_error_t **error );
+
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
+int libewf_segment_table_get_basename_by_segment_number(
+     libewf_segment_table_t *segment_table,
+     uint32_t segment_number,
+     system_character_t **basename,
+     size_t *basename_size,
+     libcerror_error_t **error );
+
 int libewf_segment_table_set_maximum_segment_size(
      libewf_segment_table_t *segment_table,
      size64_t maximum_segment_size,
@@ -0,0 +1,1015 @@
+/*
+ * Segment writer functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_definitions.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_segment_writer.h"
+
+/* Creates a segment writer
+ * Make sure the value segment_writer is referencing, is set to NULL
+ * The file IO handle of the segment writer refers to the same file as the file IO pool entry
+ * but is opened separately, without truncation, when the first chunk is written
+ * The chunk stride is 0 if the segment writer only writes section data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_writer_initialize(
+     libewf_segment_writer_t **segment_writer,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     uint32_t segment_number,
+     uint64_t first_chunk_index,
+     size_t chunk_stride,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *pool_file_io_handle = NULL;
+	system_character_t *filename          = NULL;
+	static char *function                 = "libewf_segment_writer_initialize";
+	size_t filename_size                  = 0;
+
+	if( segment_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_writer != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment writer value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_stride > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk stride value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_pool_get_handle(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     &pool_file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle: %d from pool.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	*segment_writer = memory_allocate_structure(
+	                   libewf_segment_writer_t );
+
+	if( *segment_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment writer.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *segment_writer,
+	     0,
+	     sizeof( libewf_segment_writer_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment writer.",
+		 function );
+
+		memory_free(
+		 *segment_writer );
+
+		*segment_writer = NULL;
+
+		return( -1 );
+	}
+	/* The file IO handle is not cloned from the pool since a clone is opened
+	 * with the access flags of the source, which truncate a segment file
+	 * while it is written
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_get_name_size_wide(
+	     pool_file_io_handle,
+	     &filename_size,
+	     error ) != 1 )
+#else
+	if( libbfio_file_get_name_size(
+	     pool_file_io_handle,
+	     &filename_size,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve filename size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( filename_size == 0 )
+	 || ( filename_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	filename = system_string_allocate(
+	            filename_size );
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_get_name_wide(
+	     pool_file_io_handle,
+	     filename,
+	     filename_size,
+	     error ) != 1 )
+#else
+	if( libbfio_file_get_name(
+	     pool_file_io_handle,
+	     filename,
+	     filename_size,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_initialize(
+	     &( ( *segment_writer )->file_io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_set_name_wide(
+	     ( *segment_writer )->file_io_handle,
+	     filename,
+	     filename_size,
+	     error ) != 1 )
+#else
+	if( libbfio_file_set_name(
+	     ( *segment_writer )->file_io_handle,
+	     filename,
+	     filename_size,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 filename );
+
+	filename = NULL;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *segment_writer )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to intialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *segment_writer )->segment_number    = segment_number;
+	( *segment_writer )->first_chunk_index = first_chunk_index;
+	( *segment_writer )->chunk_stride      = chunk_stride;
+
+	return( 1 );
+
+on_error:
+	if( filename != NULL )
+	{
+		memory_free(
+		 filename );
+	}
+	if( *segment_writer != NULL )
+	{
+		if( ( *segment_writer )->file_io_handle != NULL )
+		{
+			libbfio_handle_free(
+			 &( ( *segment_writer )->file_io_handle ),
+			 NULL );
+		}
+		memory_free(
+		 *segment_writer );
+
+		*segment_writer = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a segment writer
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_writer_free(
+     libewf_segment_writer_t **segment_writer,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_writer_free";
+	int result            = 1;
+
+	if( segment_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_writer != NULL )
+	{
+		if( libewf_segment_writer_close(
+		     *segment_writer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close segment writer.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_handle_free(
+		     &( ( *segment_writer )->file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *segment_writer )->sections_first_chunk_index != NULL )
+		{
+			memory_free(
+			 ( *segment_writer )->sections_first_chunk_index );
+		}
+		if( ( *segment_writer )->sections_data_offset != NULL )
+		{
+			memory_free(
+			 ( *segment_writer )->sections_data_offset );
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *segment_writer )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *segment_writer );
+
+		*segment_writer = NULL;
+	}
+	return( result );
+}
+
+/* Appends a chunk whose space was reserved in the segment file
+ * The chunks must be appended in order, a chunk that does not directly follow
+ * the previous chunk starts a new chunks section
+ * This function is not multi-thread safe, only call it during the layout of the segment file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_writer_append_chunk(
+     libewf_segment_writer_t *segment_writer,
+     uint64_t chunk_index,
+     off64_t chunk_offset,
+     libcerror_error_t **error )
+{
+	uint64_t *sections_first_chunk_index = NULL;
+	off64_t *sections_data_offset        = NULL;
+	static char *function                = "libewf_segment_writer_append_chunk";
+	off64_t expected_chunk_offset        = -1;
+	int section_index                    = 0;
+
+	if( segment_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index != ( segment_writer->first_chunk_index + segment_writer->number_of_chunks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index: %" PRIu64 " value out of bounds.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( chunk_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_writer->number_of_sections > 0 )
+	{
+		section_index = segment_writer->number_of_sections - 1;
+
+		expected_chunk_offset = segment_writer->sections_data_offset[ section_index ]
+		                      + (off64_t) ( ( chunk_index - segment_writer->sections_first_chunk_index[ section_index ] ) * segment_writer->chunk_stride );
+	}
+	if( chunk_offset != expected_chunk_offset )
+	{
+		if( segment_writer->number_of_sections >= (int) ( INT_MAX - 1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid segment writer - number of sections value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		section_index = segment_writer->number_of_sections;
+
+		sections_first_chunk_index = (uint64_t *) memory_reallocate(
+		                                           segment_writer->sections_first_chunk_index,
+		                                           sizeof( uint64_t ) * ( section_index + 1 ) );
+
+		if( sections_first_chunk_index == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize sections first chunk index.",
+			 function );
+
+			return( -1 );
+		}
+		segment_writer->sections_first_chunk_index = sections_first_chunk_index;
+
+		sections_data_offset = (off64_t *) memory_reallocate(
+		                                    segment_writer->sections_data_offset,
+		                                    sizeof( off64_t ) * ( section_index + 1 ) );
+
+		if( sections_data_offset == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize sections data offset.",
+			 function );
+
+			return( -1 );
+		}
+		segment_writer->sections_data_offset = sections_data_offset;
+
+		segment_writer->sections_first_chunk_index[ section_index ] = chunk_index;
+		segment_writer->sections_data_offset[ section_index ]       = chunk_offset;
+
+		segment_writer->number_of_sections += 1;
+	}
+	segment_writer->number_of_chunks += 1;
+
+	return( 1 );
+}
+
+/* Retrieves the offset of a chunk in the segment file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_writer_get_chunk_offset(
+     libewf_segment_writer_t *segment_writer,
+     uint64_t chunk_index,
+     off64_t *chunk_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_writer_get_chunk_offset";
+	int section_index     = 0;
+
+	if( segment_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_index < segment_writer->first_chunk_index )
+	 || ( chunk_index >= ( segment_writer->first_chunk_index + segment_writer->number_of_chunks ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index: %" PRIu64 " value out of bounds.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( chunk_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk offset.",
+		 function );
+
+		return( -1 );
+	}
+	/* A segment file only contains a few chunks sections
+	 */
+	for( section_index = segment_writer->number_of_sections - 1;
+	     section_index > 0;
+	     section_index-- )
+	{
+		if( chunk_index >= segment_writer->sections_first_chunk_index[ section_index ] )
+		{
+			break;
+		}
+	}
+	*chunk_offset = segment_writer->sections_data_offset[ section_index ]
+	              + (off64_t) ( ( chunk_index - segment_writer->sections_first_chunk_index[ section_index ] ) * segment_writer->chunk_stride );
+
+	return( 1 );
+}
+
+/* Writes the chunk data at the offset reserved for the chunk
+ * The file IO handle is opened for the first chunk written and closed
+ * after the last chunk of the segment file has been written
+ * Every chunk must be written once
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_segment_writer_write_chunk_data(
+         libewf_segment_writer_t *segment_writer,
+         uint64_t chunk_index,
+         libewf_chunk_data_t *chunk_data,
+         size_t input_data_size,
+         libcerror_error_t **error )
+{
+	uint8_t checksum_buffer[ 4 ];
+
+	static char *function     = "libewf_segment_writer_write_chunk_data";
+	off64_t chunk_offset      = 0;
+	size_t write_size         = 0;
+	ssize_t total_write_count = 0;
+	ssize_t write_count       = 0;
+	int result                = 0;
+
+	if( segment_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_writer_get_chunk_offset(
+	     segment_writer,
+	     chunk_index,
+	     &chunk_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " offset.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	write_size = chunk_data->data_size + chunk_data->padding_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     segment_writer->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libbfio_handle_is_open(
+	          segment_writer->file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if file IO handle is open.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libbfio_handle_open(
+		     segment_writer->file_io_handle,
+		     LIBBFIO_OPEN_WRITE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open segment file: %" PRIu32 ".",
+			 function,
+			 segment_writer->segment_number );
+
+			goto on_error;
+		}
+	}
+	if( libbfio_handle_seek_offset(
+	     segment_writer->file_io_handle,
+	     chunk_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek chunk: %" PRIu64 " offset: %" PRIi64 " (0x%08" PRIx64 ") in segment file: %" PRIu32 ".",
+		 function,
+		 chunk_index,
+		 chunk_offset,
+		 chunk_offset,
+		 segment_writer->segment_number );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer(
+	               segment_writer->file_io_handle,
+	               chunk_data->data,
+	               write_size,
+	               error );
+
+	if( write_count != (ssize_t) write_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	total_write_count += write_count;
+
+	if( ( chunk_data->chunk_io_flags & LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET ) != 0 )
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 checksum_buffer,
+		 chunk_data->checksum );
+
+		write_count = libbfio_handle_write_buffer(
+		               segment_writer->file_io_handle,
+		               checksum_buffer,
+		               4,
+		               error );
+
+		if( write_count != (ssize_t) 4 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write chunk: %" PRIu64 " checksum.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		total_write_count += write_count;
+	}
+	segment_writer->number_of_chunks_written += 1;
+	segment_writer->input_write_count        += input_data_size;
+
+	/* Close the file IO handle once all the chunks of the segment file have been written
+	 * so that only the segment files that are being written are kept open
+	 */
+	if( segment_writer->number_of_chunks_written >= segment_writer->number_of_chunks )
+	{
+		if( libbfio_handle_close(
+		     segment_writer->file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close segment file: %" PRIu32 ".",
+			 function,
+			 segment_writer->segment_number );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     segment_writer->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( total_write_count );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 segment_writer->mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Writes data at a specific offset in the segment file
+ * The file IO handle is opened if necessary and kept open until the segment writer is closed
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_segment_writer_write_data(
+         libewf_segment_writer_t *segment_writer,
+         off64_t offset,
+         const uint8_t *data,
+         size_t data_size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_writer_write_data";
+	ssize_t write_count   = 0;
+	int result            = 0;
+
+	if( segment_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     segment_writer->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libbfio_handle_is_open(
+	          segment_writer->file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if file IO handle is open.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libbfio_handle_open(
+		     segment_writer->file_io_handle,
+		     LIBBFIO_OPEN_WRITE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open segment file: %" PRIu32 ".",
+			 function,
+			 segment_writer->segment_number );
+
+			goto on_error;
+		}
+	}
+	if( libbfio_handle_seek_offset(
+	     segment_writer->file_io_handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ") in segment file: %" PRIu32 ".",
+		 function,
+		 offset,
+		 offset,
+		 segment_writer->segment_number );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer(
+	               segment_writer->file_io_handle,
+	               data,
+	               data_size,
+	               error );
+
+	if( write_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write data at offset: %" PRIi64 " (0x%08" PRIx64 ") in segment file: %" PRIu32 ".",
+		 function,
+		 offset,
+		 offset,
+		 segment_writer->segment_number );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     segment_writer->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 segment_writer->mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Closes the file IO handle of the segment writer if open
+ * This function is not multi-thread safe, only call it when no chunks are being written
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_writer_close(
+     libewf_segment_writer_t *segment_writer,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_writer_close";
+	int result            = 0;
+
+	if( segment_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_writer->file_io_handle == NULL )
+	{
+		return( 1 );
+	}
+	result = libbfio_handle_is_open(
+	          segment_writer->file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if file IO handle is open.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libbfio_handle_close(
+		     segment_writer->file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close segment file: %" PRIu32 ".",
+			 function,
+			 segment_writer->segment_number );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
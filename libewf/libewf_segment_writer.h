@@ -0,0 +1,139 @@
+/*
+ * Segment writer functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SEGMENT_WRITER_H )
+#define _LIBEWF_SEGMENT_WRITER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_segment_writer libewf_segment_writer_t;
+
+/* The segment writer writes chunk data at the offsets reserved
+ * in a segment file with its own file IO handle
+ */
+struct libewf_segment_writer
+{
+	/* The segment number
+	 */
+	uint32_t segment_number;
+
+	/* The file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The size of the chunk data and checksum of a chunk in the segment file
+	 */
+	size_t chunk_stride;
+
+	/* The index of the first chunk
+	 */
+	uint64_t first_chunk_index;
+
+	/* The number of chunks
+	 */
+	uint64_t number_of_chunks;
+
+	/* The number of chunks written
+	 */
+	uint64_t number_of_chunks_written;
+
+	/* The number of bytes of the input written
+	 */
+	size64_t input_write_count;
+
+	/* The number of chunks sections
+	 */
+	int number_of_sections;
+
+	/* The first chunk index of the chunks sections
+	 */
+	uint64_t *sections_first_chunk_index;
+
+	/* The offset of the chunk data of the chunks sections
+	 */
+	off64_t *sections_data_offset;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libewf_segment_writer_initialize(
+     libewf_segment_writer_t **segment_writer,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     uint32_t segment_number,
+     uint64_t first_chunk_index,
+     size_t chunk_stride,
+     libcerror_error_t **error );
+
+int libewf_segment_writer_free(
+     libewf_segment_writer_t **segment_writer,
+     libcerror_error_t **error );
+
+int libewf_segment_writer_append_chunk(
+     libewf_segment_writer_t *segment_writer,
+     uint64_t chunk_index,
+     off64_t chunk_offset,
+     libcerror_error_t **error );
+
+int libewf_segment_writer_get_chunk_offset(
+     libewf_segment_writer_t *segment_writer,
+     uint64_t chunk_index,
+     off64_t *chunk_offset,
+     libcerror_error_t **error );
+
+ssize_t libewf_segment_writer_write_chunk_data(
+         libewf_segment_writer_t *segment_writer,
+         uint64_t chunk_index,
+         libewf_chunk_data_t *chunk_data,
+         size_t input_data_size,
+         libcerror_error_t **error );
+
+ssize_t libewf_segment_writer_write_data(
+         libewf_segment_writer_t *segment_writer,
+         off64_t offset,
+         const uint8_t *data,
+         size_t data_size,
+         libcerror_error_t **error );
+
+int libewf_segment_writer_close(
+     libewf_segment_writer_t *segment_writer,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SEGMENT_WRITER_H ) */
+
@@ -0,0 +1,382 @@
+/*
+ * Statistics functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+#if defined( HAVE_CLOCK_GETTIME ) && defined( HAVE_SYS_TIME_H ) && !defined( TIME_WITH_SYS_TIME )
+#include <time.h>
+#endif
+
+#include "libewf_definitions.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_statistics.h"
+
+/* Clears the statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_clear(
+     libewf_statistics_t *statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_statistics_clear";
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     statistics,
+	     0,
+	     sizeof( libewf_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear statistics.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the statistics values
+ * The values are stored in the order of the LIBEWF_STATISTICS_VALUE definitions
+ * If the number of values is less than LIBEWF_STATISTICS_NUMBER_OF_VALUES
+ * only the first number of values are retrieved
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_get_values(
+     libewf_statistics_t *statistics,
+     uint64_t *values,
+     int number_of_values,
+     libcerror_error_t **error )
+{
+	uint64_t statistics_values[ LIBEWF_STATISTICS_NUMBER_OF_VALUES ];
+
+	static char *function                  = "libewf_statistics_get_values";
+	uint64_t number_of_chunk_group_lookups = 0;
+	uint64_t number_of_chunk_group_reads   = 0;
+	uint64_t number_of_chunk_lookups       = 0;
+	uint64_t number_of_chunk_reads         = 0;
+	int value_index                        = 0;
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid values.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_values < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of values value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	/* A read that misses the cache is counted after its lookup
+	 * hence the lookups are loaded after the reads
+	 */
+	number_of_chunk_reads         = libewf_statistics_load( statistics->number_of_chunk_reads );
+	number_of_chunk_lookups       = libewf_statistics_load( statistics->number_of_chunk_lookups );
+	number_of_chunk_group_reads   = libewf_statistics_load( statistics->number_of_chunk_group_reads );
+	number_of_chunk_group_lookups = libewf_statistics_load( statistics->number_of_chunk_group_lookups );
+
+	if( number_of_chunk_reads > number_of_chunk_lookups )
+	{
+		number_of_chunk_reads = number_of_chunk_lookups;
+	}
+	if( number_of_chunk_group_reads > number_of_chunk_group_lookups )
+	{
+		number_of_chunk_group_reads = number_of_chunk_group_lookups;
+	}
+	statistics_values[ LIBEWF_STATISTICS_VALUE_CHUNK_CACHE_HITS ]         = number_of_chunk_lookups - number_of_chunk_reads;
+	statistics_values[ LIBEWF_STATISTICS_VALUE_CHUNK_CACHE_MISSES ]       = number_of_chunk_reads;
+	statistics_values[ LIBEWF_STATISTICS_VALUE_CHUNK_GROUP_CACHE_HITS ]   = number_of_chunk_group_lookups - number_of_chunk_group_reads;
+	statistics_values[ LIBEWF_STATISTICS_VALUE_CHUNK_GROUP_CACHE_MISSES ] = number_of_chunk_group_reads;
+	statistics_values[ LIBEWF_STATISTICS_VALUE_BYTES_READ ]               = libewf_statistics_load( statistics->number_of_bytes_read );
+	statistics_values[ LIBEWF_STATISTICS_VALUE_BYTES_DECOMPRESSED ]       = libewf_statistics_load( statistics->number_of_bytes_decompressed );
+	statistics_values[ LIBEWF_STATISTICS_VALUE_DECOMPRESSION_TIME ]       = libewf_statistics_load( statistics->decompression_time );
+	statistics_values[ LIBEWF_STATISTICS_VALUE_CHECKSUM_ERRORS ]          = libewf_statistics_load( statistics->number_of_checksum_errors );
+	statistics_values[ LIBEWF_STATISTICS_VALUE_SEGMENT_FILE_OPENS ]       = libewf_statistics_load( statistics->number_of_segment_file_opens );
+	statistics_values[ LIBEWF_STATISTICS_VALUE_SEGMENT_FILE_CLOSES ]      = libewf_statistics_load( statistics->number_of_segment_file_closes );
+
+	for( value_index = 0;
+	     value_index < number_of_values;
+	     value_index++ )
+	{
+		if( value_index >= LIBEWF_STATISTICS_NUMBER_OF_VALUES )
+		{
+			break;
+		}
+		values[ value_index ] = statistics_values[ value_index ];
+	}
+	return( 1 );
+}
+
+/* Retrieves a monotonic timestamp in nano seconds
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_get_timestamp(
+     uint64_t *timestamp,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	struct timespec time_value;
+
+#elif defined( HAVE_GETTIMEOFDAY )
+	struct timeval time_value;
+
+#endif
+	static char *function = "libewf_statistics_get_timestamp";
+
+	if( timestamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( QueryPerformanceCounter(
+	       &counter ) == 0 )
+	 || ( frequency.QuadPart <= 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve performance counter.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) ( counter.QuadPart / frequency.QuadPart ) * 1000000000UL )
+	           + ( ( (uint64_t) ( counter.QuadPart % frequency.QuadPart ) * 1000000000UL ) / (uint64_t) frequency.QuadPart );
+
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_value ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve monotonic clock time.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) time_value.tv_sec * 1000000000UL )
+	           + (uint64_t) time_value.tv_nsec;
+
+#elif defined( HAVE_GETTIMEOFDAY )
+	if( gettimeofday(
+	     &time_value,
+	     NULL ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve time of day.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) time_value.tv_sec * 1000000000UL )
+	           + ( (uint64_t) time_value.tv_usec * 1000 );
+
+#else
+	*timestamp = (uint64_t) time( NULL ) * 1000000000UL;
+
+#endif
+	return( 1 );
+}
+
+/* Adds the time elapsed since the start timestamp to the decompression time
+ * The decompression time is not updated if the timestamp cannot be retrieved,
+ * since the statistics should not cause a read to fail
+ */
+void libewf_statistics_add_decompression_time(
+      libewf_statistics_t *statistics,
+      uint64_t start_timestamp )
+{
+	uint64_t timestamp = 0;
+
+	if( statistics == NULL )
+	{
+		return;
+	}
+	if( libewf_statistics_get_timestamp(
+	     &timestamp,
+	     NULL ) != 1 )
+	{
+		return;
+	}
+	if( timestamp > start_timestamp )
+	{
+		libewf_statistics_add(
+		 statistics->decompression_time,
+		 timestamp - start_timestamp );
+	}
+}
+
+/* Retrieves the number of segment files that are open in the file IO pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_get_number_of_open_segment_files(
+     libbfio_pool_t *file_io_pool,
+     int *number_of_open_segment_files,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libewf_statistics_get_number_of_open_segment_files";
+	int file_io_pool_entry           = 0;
+	int number_of_file_io_handles    = 0;
+	int result                       = 0;
+
+	if( number_of_open_segment_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of open segment files.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_pool_get_number_of_handles(
+	     file_io_pool,
+	     &number_of_file_io_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of file IO handles.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_open_segment_files = 0;
+
+	for( file_io_pool_entry = 0;
+	     file_io_pool_entry < number_of_file_io_handles;
+	     file_io_pool_entry++ )
+	{
+		if( libbfio_pool_get_handle(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file IO handle: %d.",
+			 function,
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+		if( file_io_handle == NULL )
+		{
+			continue;
+		}
+		result = libbfio_handle_is_open(
+		          file_io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if file IO handle: %d is open.",
+			 function,
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			*number_of_open_segment_files += 1;
+		}
+	}
+	return( 1 );
+}
+
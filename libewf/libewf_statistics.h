@@ -0,0 +1,129 @@
+/*
+ * Statistics functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_STATISTICS_H )
+#define _LIBEWF_STATISTICS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The counters are updated without a lock, since chunk data can be
+ * unpacked by multiple threads outside of the handle
+ */
+#if defined( HAVE_ATOMIC_BUILTINS )
+
+#define libewf_statistics_add( value, increment ) \
+	__atomic_add_fetch( &( value ), (uint64_t) ( increment ), __ATOMIC_RELAXED )
+
+#define libewf_statistics_load( value ) \
+	__atomic_load_n( &( value ), __ATOMIC_RELAXED )
+
+#else
+
+#define libewf_statistics_add( value, increment ) \
+	( value ) += (uint64_t) ( increment )
+
+#define libewf_statistics_load( value ) \
+	( value )
+
+#endif /* defined( HAVE_ATOMIC_BUILTINS ) */
+
+typedef struct libewf_statistics libewf_statistics_t;
+
+struct libewf_statistics
+{
+	/* The number of chunk lookups
+	 */
+	uint64_t number_of_chunk_lookups;
+
+	/* The number of chunks read from the segment files
+	 */
+	uint64_t number_of_chunk_reads;
+
+	/* The number of chunk group lookups
+	 */
+	uint64_t number_of_chunk_group_lookups;
+
+	/* The number of chunk groups read from the segment files
+	 */
+	uint64_t number_of_chunk_group_reads;
+
+	/* The number of bytes read from the segment files
+	 */
+	uint64_t number_of_bytes_read;
+
+	/* The number of bytes decompressed
+	 */
+	uint64_t number_of_bytes_decompressed;
+
+	/* The time spent decompressing in nano seconds
+	 */
+	uint64_t decompression_time;
+
+	/* The number of chunks with a checksum error
+	 */
+	uint64_t number_of_checksum_errors;
+
+	/* The number of segment files opened
+	 */
+	uint64_t number_of_segment_file_opens;
+
+	/* The number of segment files closed
+	 */
+	uint64_t number_of_segment_file_closes;
+};
+
+int libewf_statistics_clear(
+     libewf_statistics_t *statistics,
+     libcerror_error_t **error );
+
+int libewf_statistics_get_values(
+     libewf_statistics_t *statistics,
+     uint64_t *values,
+     int number_of_values,
+     libcerror_error_t **error );
+
+int libewf_statistics_get_timestamp(
+     uint64_t *timestamp,
+     libcerror_error_t **error );
+
+void libewf_statistics_add_decompression_time(
+     libewf_statistics_t *statistics,
+     uint64_t start_timestamp );
+
+int libewf_statistics_get_number_of_open_segment_files(
+     libbfio_pool_t *file_io_pool,
+     int *number_of_open_segment_files,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_STATISTICS_H ) */
+
@@ -46,14 +46,17 @@
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
 #include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
 #include "libewf_libfvalue.h"
 #include "libewf_media_values.h"
 #include "libewf_read_io_handle.h"
 #include "libewf_section.h"
+#include "libewf_section_correction.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
+#include "libewf_segment_writer.h"
 #include "libewf_unused.h"
 #include "libewf_write_io_handle.h"
 
@@ -223,6 +226,40 @@ int libewf_write_io_handle_free(
 
 			result = -1;
 		}
+		if( ( *write_io_handle )->sections_corrections != NULL )
+		{
+			if( libcdata_array_free(
+			     &( ( *write_io_handle )->sections_corrections ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_section_correction_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free sections corrections array.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *write_io_handle )->segment_writers != NULL )
+		{
+			if( libcdata_array_free(
+			     &( ( *write_io_handle )->segment_writers ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_segment_writer_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free segment writers array.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 *write_io_handle );
 
@@ -307,6 +344,9 @@ int libewf_write_io_handle_clone(
 	( *destination_write_io_handle )->table_entries_data      = NULL;
 	( *destination_write_io_handle )->table_entries_data_size = 0;
 	( *destination_write_io_handle )->number_of_table_entries = 0;
+	( *destination_write_io_handle )->layout_written          = 0;
+	( *destination_write_io_handle )->segment_writers         = NULL;
+	( *destination_write_io_handle )->sections_corrections    = NULL;
 
 	if( source_write_io_handle->case_data != NULL )
 	{
@@ -867,6 +907,27 @@ int libewf_write_io_handle_initialize_values(
 			zero_byte_empty_block = NULL;
 		}
 	}
+	/* The sections that contain media values are recorded when a streamed write is used
+	 * so that they can be corrected when the write is finalized
+	 */
+	if( ( media_values->media_size == 0 )
+	 && ( write_io_handle->sections_corrections == NULL ) )
+	{
+		if( libcdata_array_initialize(
+		     &( write_io_handle->sections_corrections ),
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create sections corrections array.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	write_io_handle->timestamp = time( NULL );
 
 	/* Flag that the write values were initialized
@@ -1640,6 +1701,22 @@ int libewf_write_io_handle_initialize_resume(
 		 write_io_handle->number_of_chunks_written );
 	}
 #endif
+	/* The sections of the segment files written before the write was resumed were not recorded
+	 */
+	if( libewf_segment_table_get_number_of_segments(
+	     segment_table,
+	     &( write_io_handle->number_of_resumed_segments ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfcache_cache_free(
 	     &sections_cache,
 	     error ) != 1 )
@@ -1957,6 +2034,11 @@ int libewf_write_io_handle_calculate_chunks_per_section(
 	{
 		remaining_number_of_chunks = (int64_t) write_io_handle->maximum_chunks_per_section;
 	}
+	if( ( write_io_handle->chunks_section_limit != 0 )
+	 && ( remaining_number_of_chunks > (int64_t) write_io_handle->chunks_section_limit ) )
+	{
+		remaining_number_of_chunks = (int64_t) write_io_handle->chunks_section_limit;
+	}
 	/* Fail safe no more than 2^31 values are allowed
 	 */
 	if( remaining_number_of_chunks > (int64_t) INT32_MAX )
@@ -2210,6 +2292,22 @@ int libewf_write_io_handle_test_chunks_section_full(
 			 "%s: no space left for additional chunk - maximum reached.\n",
 			 function );
 		}
+#endif
+		return( 1 );
+	}
+	/* Close the chunks section when the chunks section limit has been reached
+	 * so that the chunks written so far can be recovered on resume
+	 */
+	if( ( write_io_handle->chunks_section_limit != 0 )
+	 && ( write_io_handle->number_of_chunks_written_to_section >= write_io_handle->chunks_section_limit ) )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: chunks section limit reached.\n",
+			 function );
+		}
 #endif
 		return( 1 );
 	}
@@ -2301,8 +2399,10 @@ int libewf_write_io_handle_create_segment_file(
      libcerror_error_t **error )
 {
 	libbfio_handle_t *file_io_handle = NULL;
+	system_character_t *basename     = NULL;
 	system_character_t *filename     = NULL;
 	static char *function            = "libewf_write_io_handle_create_segment_file";
+	size_t basename_size             = 0;
 	size_t filename_size             = 0;
 	int bfio_access_flags            = 0;
 
@@ -2361,11 +2461,28 @@ int libewf_write_io_handle_create_segment_file(
 
 		return( -1 );
 	}
+	if( libewf_segment_table_get_basename_by_segment_number(
+	     segment_table,
+	     segment_number,
+	     &basename,
+	     &basename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file: %" PRIu32 " basename.",
+		 function,
+		 segment_number );
+
+		goto on_error;
+	}
 	if( libewf_filename_create(
 	     &filename,
 	     &filename_size,
-	     segment_table->basename,
-	     segment_table->basename_size - 1,
+	     basename,
+	     basename_size - 1,
 	     segment_number + 1,
 	     maximum_number_of_segments,
 	     segment_file_type,
@@ -2843,6 +2960,162 @@ ssize_t libewf_write_io_handle_write_chunks_section_end(
 	return( write_count );
 }
 
+/* Closes the current chunks section and the segment file if it is full
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_write_io_handle_close_chunks_section(
+         libewf_write_io_handle_t *write_io_handle,
+         libewf_io_handle_t *io_handle,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         libewf_segment_file_t *segment_file,
+         uint32_t segment_number,
+         libewf_media_values_t *media_values,
+         libfvalue_table_t *hash_values,
+         libewf_hash_sections_t *hash_sections,
+         libcdata_array_t *sessions,
+         libcdata_array_t *tracks,
+         libcdata_range_list_t *acquiry_errors,
+         libcerror_error_t **error )
+{
+	static char *function     = "libewf_write_io_handle_close_chunks_section";
+	ssize_t total_write_count = 0;
+	ssize_t write_count       = 0;
+	int result                = 0;
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = libewf_write_io_handle_write_chunks_section_end(
+		       write_io_handle,
+		       io_handle,
+		       file_io_pool,
+		       file_io_pool_entry,
+		       segment_file,
+		       error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunks section end.",
+		 function );
+
+		return( -1 );
+	}
+	total_write_count += write_count;
+
+	write_io_handle->create_chunks_section = 1;
+	write_io_handle->chunks_section_offset = 0;
+
+	/* Check if the current segment file is full, if so close the current segment file
+	 */
+	result = libewf_write_io_handle_test_segment_file_full(
+		  write_io_handle,
+		  media_values,
+		  io_handle->segment_file_type,
+		  io_handle->format,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if segment file is full.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 1 )
+	{
+		/* Check if this is not the last segment file
+		 */
+		if( ( media_values->media_size == 0 )
+		 || ( write_io_handle->input_write_count < (ssize64_t) media_values->media_size ) )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+			 	"%s: closing segment file: %" PRIu32 ".\n",
+				 function,
+				 segment_number );
+			}
+#endif
+			/* Keep track of the offset of the next section in case this turns out
+			 * to be the last segment file of a streamed write
+			 */
+			write_io_handle->next_section_segment_number = segment_file->segment_number;
+			write_io_handle->next_section_offset         = segment_file->current_offset;
+
+			/* Finish and close the segment file
+			 */
+			write_count = libewf_segment_file_write_close(
+				       segment_file,
+				       file_io_pool,
+				       file_io_pool_entry,
+				       write_io_handle->number_of_chunks_written_to_segment_file,
+				       0,
+				       hash_sections,
+				       hash_values,
+				       media_values,
+				       sessions,
+				       tracks,
+				       acquiry_errors,
+				       &( write_io_handle->data_section ),
+			               error );
+
+			if( write_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to close segment file.",
+				 function );
+
+				return( -1 );
+			}
+			total_write_count += write_count;
+		}
+	}
+	return( total_write_count );
+}
+
 /* Writes a new chunk of data in EWF format at the current offset
  * The necessary settings of the write values must have been made
  * Returns the number of bytes written, 0 when no longer bytes can be written or -1 on error
@@ -3081,6 +3354,7 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 		               media_values,
 		               header_values,
 		               write_io_handle->timestamp,
+		               write_io_handle->sections_corrections,
 		               error );
 
 		if( write_count == -1 )
@@ -3348,6 +3622,29 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 
 		return( -1 );
 	}
+	if( ( chunk_data->chunk_io_flags & LIBEWF_CHUNK_IO_FLAG_IS_RESERVED ) != 0 )
+	{
+		if( libewf_write_io_handle_append_reserved_chunk(
+		     write_io_handle,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     media_values,
+		     segment_number,
+		     chunk_index,
+		     chunk_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append reserved chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+	}
 	write_io_handle->input_write_count                        += input_data_size;
 	write_io_handle->chunks_section_write_count               += write_count;
 	write_io_handle->chunks_section_padding_size              += (uint32_t) chunk_data->padding_size;
@@ -3383,13 +3680,20 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 	}
 	if( result == 1 )
 	{
-		write_count = libewf_write_io_handle_write_chunks_section_end(
-			       write_io_handle,
-			       io_handle,
-			       file_io_pool,
-			       file_io_pool_entry,
-			       segment_file,
-			       error );
+		write_count = libewf_write_io_handle_close_chunks_section(
+		               write_io_handle,
+		               io_handle,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               segment_file,
+		               segment_number,
+		               media_values,
+		               hash_values,
+		               hash_sections,
+		               sessions,
+		               tracks,
+		               acquiry_errors,
+		               error );
 
 		if( write_count == -1 )
 		{
@@ -3397,106 +3701,1381 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write chunks section end.",
+			 "%s: unable to close chunks section.",
 			 function );
 
 			return( -1 );
 		}
 		total_write_count += write_count;
-
-		write_io_handle->create_chunks_section = 1;
-		write_io_handle->chunks_section_offset = 0;
-
-		/* Check if the current segment file is full, if so close the current segment file
-		 */
-		result = libewf_write_io_handle_test_segment_file_full(
-			  write_io_handle,
-			  media_values,
-			  io_handle->segment_file_type,
-			  io_handle->format,
-			  error );
-
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine if segment file is full.",
-			 function );
-
-			return( -1 );
-		}
-		else if( result == 1 )
-		{
-			/* Check if this is not the last segment file
-			 */
-			if( ( media_values->media_size == 0 )
-			 || ( write_io_handle->input_write_count < (ssize64_t) media_values->media_size ) )
-			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-				 	"%s: closing segment file: %" PRIu32 ".\n",
-					 function,
-					 segment_number );
-				}
-#endif
-				/* Finish and close the segment file
-				 */
-				write_count = libewf_segment_file_write_close(
-					       segment_file,
-					       file_io_pool,
-					       file_io_pool_entry,
-					       write_io_handle->number_of_chunks_written_to_segment_file,
-					       0,
-					       hash_sections,
-					       hash_values,
-					       media_values,
-					       sessions,
-					       tracks,
-					       acquiry_errors,
-					       &( write_io_handle->data_section ),
-				               error );
-
-				if( write_count == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_WRITE_FAILED,
-					 "%s: unable to close segment file.",
-					 function );
-
-					return( -1 );
-				}
-				total_write_count += write_count;
-			}
-		}
 	}
 	return( total_write_count );
 }
 
-/* Corrects sections after streamed write
+/* Appends a chunk whose space was reserved in the segment file to its segment writer
  * Returns 1 if successful or -1 on error
  */
-int libewf_write_io_handle_finalize_write_sections_corrections(
+int libewf_write_io_handle_append_reserved_chunk(
      libewf_write_io_handle_t *write_io_handle,
      libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
      libewf_media_values_t *media_values,
-     libewf_segment_table_t *segment_table,
-     libfvalue_table_t *header_values,
-     libfvalue_table_t *hash_values,
-     libewf_hash_sections_t *hash_sections,
-     libcdata_array_t *sessions,
-     libcdata_array_t *tracks,
-     libcdata_range_list_t *acquiry_errors,
+     uint32_t segment_number,
+     uint64_t chunk_index,
+     off64_t chunk_offset,
      libcerror_error_t **error )
 {
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_write_io_handle_finalize_write_sections_corrections";
-	size64_t segment_file_size          = 0;
+	libewf_segment_writer_t *segment_writer = NULL;
+	static char *function                   = "libewf_write_io_handle_append_reserved_chunk";
+	int entry_index                         = 0;
+	int number_of_segment_writers           = 0;
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->segment_writers == NULL )
+	{
+		if( libcdata_array_initialize(
+		     &( write_io_handle->segment_writers ),
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment writers array.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcdata_array_get_number_of_entries(
+	     write_io_handle->segment_writers,
+	     &number_of_segment_writers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segment writers.",
+		 function );
+
+		goto on_error;
+	}
+	if( segment_number == (uint32_t) number_of_segment_writers )
+	{
+		if( libewf_segment_writer_initialize(
+		     &segment_writer,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     segment_number,
+		     chunk_index,
+		     (size_t) media_values->chunk_size + 4,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment writer: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		if( libcdata_array_append_entry(
+		     write_io_handle->segment_writers,
+		     &entry_index,
+		     (intptr_t *) segment_writer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append segment writer: %" PRIu32 " to array.",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+	}
+	else if( segment_number == (uint32_t) ( number_of_segment_writers - 1 ) )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     write_io_handle->segment_writers,
+		     (int) segment_number,
+		     (intptr_t **) &segment_writer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment writer: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_writer_append_chunk(
+	     segment_writer,
+	     chunk_index,
+	     chunk_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append chunk: %" PRIu64 " to segment writer: %" PRIu32 ".",
+		 function,
+		 chunk_index,
+		 segment_number );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( segment_writer != NULL )
+	{
+		libewf_segment_writer_free(
+		 &segment_writer,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes the layout of all the segment files for a concurrent segment write
+ * The segment files are created and all their sections are written, where the space
+ * of the chunk data is reserved, so that the chunk data can be written afterwards
+ * in any order and by multiple threads with libewf_write_io_handle_write_reserved_chunk
+ * The layout is the same as that of a sequential write, hence it is only supported for
+ * uncompressed EWF version 1 segment files with a known media size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_io_handle_write_layout(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfvalue_table_t *header_values,
+     libfvalue_table_t *hash_values,
+     libewf_hash_sections_t *hash_sections,
+     libcdata_array_t *sessions,
+     libcdata_array_t *tracks,
+     libcdata_range_list_t *acquiry_errors,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *reserved_chunk_data = NULL;
+	static char *function                    = "libewf_write_io_handle_write_layout";
+	size64_t remaining_media_size            = 0;
+	size_t input_data_size                   = 0;
+	ssize_t write_count                      = 0;
+	uint64_t chunk_index                     = 0;
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->layout_written != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid write IO handle - layout already written.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->number_of_chunks_written != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid write IO handle - chunks already written.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values->media_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: concurrent segment write requires a media size.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: concurrent segment write requires EWF version 1 segment files.",
+		 function );
+
+		return( -1 );
+	}
+	/* The reserved space of a chunk must match the chunk data written later
+	 * which is only known upfront when the chunk data is not compressed
+	 */
+	if( ( io_handle->compression_level != LIBEWF_COMPRESSION_NONE )
+	 || ( io_handle->compression_flags != 0 )
+	 || ( ( write_io_handle->pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) != 0 )
+	 || ( ( write_io_handle->pack_flags & LIBEWF_PACK_FLAG_ADD_ALIGNMENT_PADDING ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: concurrent segment write requires uncompressed chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_data_initialize(
+	     &reserved_chunk_data,
+	     NULL,
+	     media_values->chunk_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create reserved chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	reserved_chunk_data->range_flags    = LIBEWF_RANGE_FLAG_HAS_CHECKSUM | LIBEWF_RANGE_FLAG_IS_PACKED;
+	reserved_chunk_data->chunk_io_flags = LIBEWF_CHUNK_IO_FLAG_IS_RESERVED;
+
+	remaining_media_size = media_values->media_size;
+
+	while( remaining_media_size > 0 )
+	{
+		if( remaining_media_size > (size64_t) media_values->chunk_size )
+		{
+			input_data_size = (size_t) media_values->chunk_size;
+		}
+		else
+		{
+			input_data_size = (size_t) remaining_media_size;
+		}
+		/* The space of the chunk data and its checksum
+		 */
+		reserved_chunk_data->data_size = input_data_size + 4;
+
+		write_count = libewf_write_io_handle_write_new_chunk(
+		               write_io_handle,
+		               io_handle,
+		               file_io_pool,
+		               media_values,
+		               segment_table,
+		               header_values,
+		               hash_values,
+		               hash_sections,
+		               sessions,
+		               tracks,
+		               acquiry_errors,
+		               chunk_index,
+		               reserved_chunk_data,
+		               input_data_size,
+		               error );
+
+		if( write_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to reserve chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		remaining_media_size -= input_data_size;
+
+		chunk_index++;
+	}
+	if( libewf_chunk_data_free(
+	     &reserved_chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free reserved chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	write_io_handle->layout_written = 1;
+
+	return( 1 );
+
+on_error:
+	if( reserved_chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &reserved_chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes a chunk at the offset reserved by libewf_write_io_handle_write_layout
+ * This function can be called by multiple threads, for different chunks, at the same time
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_write_io_handle_write_reserved_chunk(
+         libewf_write_io_handle_t *write_io_handle,
+         libewf_media_values_t *media_values,
+         uint64_t chunk_index,
+         libewf_chunk_data_t *chunk_data,
+         size_t input_data_size,
+         libcerror_error_t **error )
+{
+	libewf_segment_writer_t *segment_writer = NULL;
+	static char *function                   = "libewf_write_io_handle_write_reserved_chunk";
+	size64_t chunk_data_offset              = 0;
+	size_t expected_input_data_size         = 0;
+	ssize_t write_count                     = 0;
+	uint32_t chunk_write_size               = 0;
+	int number_of_segment_writers           = 0;
+	int segment_writer_index                = 0;
+	int lower_index                         = 0;
+	int upper_index                         = 0;
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->layout_written == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid write IO handle - missing layout.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index >= ( media_values->media_size / media_values->chunk_size ) + 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_data_offset = (size64_t) chunk_index * media_values->chunk_size;
+
+	if( chunk_data_offset >= media_values->media_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( media_values->media_size - chunk_data_offset ) > (size64_t) media_values->chunk_size )
+	{
+		expected_input_data_size = (size_t) media_values->chunk_size;
+	}
+	else
+	{
+		expected_input_data_size = (size_t) ( media_values->media_size - chunk_data_offset );
+	}
+	if( input_data_size != expected_input_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) == 0 )
+	 || ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+	 || ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported chunk data - chunk: %" PRIu64 " must be packed without compression.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( libewf_chunk_data_get_write_size(
+	     chunk_data,
+	     &chunk_write_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk write size.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size_t) chunk_write_size != ( input_data_size + 4 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk: %" PRIu64 " write size value does not match reserved size.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     write_io_handle->segment_writers,
+	     &number_of_segment_writers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segment writers.",
+		 function );
+
+		return( -1 );
+	}
+	/* Determine the segment writer of the chunk, the segment writers are sorted by their first chunk index
+	 */
+	lower_index = 0;
+	upper_index = number_of_segment_writers - 1;
+
+	while( lower_index <= upper_index )
+	{
+		segment_writer_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+
+		if( libcdata_array_get_entry_by_index(
+		     write_io_handle->segment_writers,
+		     segment_writer_index,
+		     (intptr_t **) &segment_writer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment writer: %d.",
+			 function,
+			 segment_writer_index );
+
+			return( -1 );
+		}
+		if( segment_writer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment writer: %d.",
+			 function,
+			 segment_writer_index );
+
+			return( -1 );
+		}
+		if( chunk_index < segment_writer->first_chunk_index )
+		{
+			upper_index = segment_writer_index - 1;
+		}
+		else if( chunk_index >= ( segment_writer->first_chunk_index + segment_writer->number_of_chunks ) )
+		{
+			lower_index = segment_writer_index + 1;
+		}
+		else
+		{
+			break;
+		}
+		segment_writer = NULL;
+	}
+	if( segment_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing segment writer for chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	write_count = libewf_segment_writer_write_chunk_data(
+	               segment_writer,
+	               chunk_index,
+	               chunk_data,
+	               input_data_size,
+	               error );
+
+	if( write_count != (ssize_t) chunk_write_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunk: %" PRIu64 " to segment file: %" PRIu32 ".",
+		 function,
+		 chunk_index,
+		 segment_writer->segment_number );
+
+		return( -1 );
+	}
+	return( write_count );
+}
+
+/* Closes the segment writers used by a concurrent segment write
+ * This function is not multi-thread safe, only call it when no chunks are being written
+ * Returns 1 if all the chunk data was written, 0 if not or -1 on error
+ */
+int libewf_write_io_handle_close_segment_writers(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_media_values_t *media_values,
+     libcerror_error_t **error )
+{
+	libewf_segment_writer_t *segment_writer = NULL;
+	static char *function                   = "libewf_write_io_handle_close_segment_writers";
+	size64_t input_write_count              = 0;
+	int number_of_segment_writers           = 0;
+	int segment_writer_index                = 0;
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->segment_writers == NULL )
+	{
+		return( 0 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     write_io_handle->segment_writers,
+	     &number_of_segment_writers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segment writers.",
+		 function );
+
+		return( -1 );
+	}
+	for( segment_writer_index = 0;
+	     segment_writer_index < number_of_segment_writers;
+	     segment_writer_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     write_io_handle->segment_writers,
+		     segment_writer_index,
+		     (intptr_t **) &segment_writer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment writer: %d.",
+			 function,
+			 segment_writer_index );
+
+			return( -1 );
+		}
+		if( libewf_segment_writer_close(
+		     segment_writer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close segment writer: %d.",
+			 function,
+			 segment_writer_index );
+
+			return( -1 );
+		}
+		input_write_count += segment_writer->input_write_count;
+	}
+	if( input_write_count < media_values->media_size )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Writes a checkpoint
+ * Closes the current chunks section, if any, so that a resumed write continues
+ * after the last chunk written and retrieves the segment number of the segment
+ * file that contains the last chunk written and the number of chunks written
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_io_handle_write_checkpoint(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfvalue_table_t *hash_values,
+     libewf_hash_sections_t *hash_sections,
+     libcdata_array_t *sessions,
+     libcdata_array_t *tracks,
+     libcdata_range_list_t *acquiry_errors,
+     uint32_t *segment_number,
+     uint64_t *number_of_chunks,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_write_io_handle_write_checkpoint";
+	size64_t segment_file_size          = 0;
+	ssize_t write_count                 = 0;
+	uint32_t number_of_segments         = 0;
+	uint32_t segment_index              = 0;
+	int file_io_pool_entry              = -1;
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment number.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->write_finalized != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid write IO handle - write already finalized.",
+		 function );
+
+		return( -1 );
+	}
+	/* With a concurrent segment write all the chunks sections are written upfront
+	 * hence there is no point from which the write can be resumed
+	 */
+	if( write_io_handle->concurrent_segment_write != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: checkpoints are not supported with a concurrent segment write.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments from segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_segments > 0 )
+	 && ( write_io_handle->create_chunks_section == 0 )
+	 && ( write_io_handle->number_of_chunks_written_to_section > 0 ) )
+	{
+		segment_index = number_of_segments - 1;
+
+		if( libewf_segment_table_get_segment_by_index(
+		     segment_table,
+		     segment_index,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 segment_index );
+
+			return( -1 );
+		}
+		if( libewf_segment_table_get_segment_file_by_index(
+		     segment_table,
+		     segment_index,
+		     file_io_pool,
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 function,
+			 segment_index );
+
+			return( -1 );
+		}
+		if( segment_file == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment file: %" PRIu32 ".",
+			 function,
+			 segment_index );
+
+			return( -1 );
+		}
+		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_WRITE_OPEN ) != 0 )
+		{
+			write_count = libewf_write_io_handle_close_chunks_section(
+			               write_io_handle,
+			               io_handle,
+			               file_io_pool,
+			               file_io_pool_entry,
+			               segment_file,
+			               segment_index,
+			               media_values,
+			               hash_values,
+			               hash_sections,
+			               sessions,
+			               tracks,
+			               acquiry_errors,
+			               error );
+
+			if( write_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to close chunks section.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	*segment_number   = number_of_segments;
+	*number_of_chunks = write_io_handle->number_of_chunks_written;
+
+	return( 1 );
+}
+
+/* Writes the recorded sections corrections
+ * The corrected sections are first built in memory and then written in parallel,
+ * with a dedicated file IO handle per segment file, at the offsets the sections were written
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_io_handle_write_sections_corrections(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libfvalue_table_t *header_values,
+     libcerror_error_t **error )
+{
+	libcdata_array_t *segment_writers               = NULL;
+	libewf_section_correction_t *section_correction = NULL;
+	libewf_segment_writer_t *segment_writer         = NULL;
+	static char *function                           = "libewf_write_io_handle_write_sections_corrections";
+	int entry_index                                 = 0;
+	int number_of_sections_corrections              = 0;
+	int number_of_segment_writers                   = 0;
+	int result                                      = 1;
+	int section_correction_index                    = 0;
+	int segment_writer_index                        = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *write_thread_pool    = NULL;
+	int number_of_threads                           = 0;
+#endif
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->sections_corrections == NULL )
+	{
+		return( 1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     write_io_handle->sections_corrections,
+	     &number_of_sections_corrections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sections corrections.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_sections_corrections == 0 )
+	{
+		return( 1 );
+	}
+	if( libcdata_array_initialize(
+	     &segment_writers,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment writers array.",
+		 function );
+
+		goto on_error;
+	}
+	/* Build the corrected sections in memory, this is done sequentially since the
+	 * case data, device information and data section are generated once and cached
+	 */
+	for( section_correction_index = 0;
+	     section_correction_index < number_of_sections_corrections;
+	     section_correction_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     write_io_handle->sections_corrections,
+		     section_correction_index,
+		     (intptr_t **) &section_correction,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve section correction: %d.",
+			 function,
+			 section_correction_index );
+
+			goto on_error;
+		}
+		if( section_correction == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing section correction: %d.",
+			 function,
+			 section_correction_index );
+
+			goto on_error;
+		}
+		if( libewf_section_correction_build_data(
+		     section_correction,
+		     io_handle,
+		     io_handle->segment_file_type,
+		     media_values,
+		     header_values,
+		     write_io_handle->timestamp,
+		     &( write_io_handle->case_data ),
+		     &( write_io_handle->case_data_size ),
+		     &( write_io_handle->device_information ),
+		     &( write_io_handle->device_information_size ),
+		     &( write_io_handle->data_section ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to build section correction: %d data.",
+			 function,
+			 section_correction_index );
+
+			goto on_error;
+		}
+		/* The sections corrections are recorded in segment file order
+		 * hence a segment writer is only created for the first section correction of a segment file
+		 */
+		if( ( segment_writer == NULL )
+		 || ( segment_writer->segment_number != section_correction->segment_number ) )
+		{
+			segment_writer = NULL;
+
+			if( libewf_segment_writer_initialize(
+			     &segment_writer,
+			     file_io_pool,
+			     section_correction->file_io_pool_entry,
+			     section_correction->segment_number,
+			     0,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create segment writer for segment file: %" PRIu32 ".",
+				 function,
+				 section_correction->segment_number );
+
+				goto on_error;
+			}
+			if( libcdata_array_append_entry(
+			     segment_writers,
+			     &entry_index,
+			     (intptr_t *) segment_writer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append segment writer to array.",
+				 function );
+
+				libewf_segment_writer_free(
+				 &segment_writer,
+				 NULL );
+
+				goto on_error;
+			}
+			number_of_segment_writers++;
+		}
+		section_correction->segment_writer = segment_writer;
+		section_correction->write_result   = 0;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* Write the corrected sections in parallel, the segment writer serializes
+	 * the writes to the same segment file
+	 */
+	number_of_threads = number_of_segment_writers;
+
+	if( number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_SECTIONS_CORRECTION_THREADS )
+	{
+		number_of_threads = LIBEWF_MAXIMUM_NUMBER_OF_SECTIONS_CORRECTION_THREADS;
+	}
+	if( libcthreads_thread_pool_create(
+	     &write_thread_pool,
+	     NULL,
+	     number_of_threads,
+	     number_of_sections_corrections,
+	     (int (*)(intptr_t *, void *)) &libewf_section_correction_write_data_callback,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create write thread pool.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	for( section_correction_index = 0;
+	     section_correction_index < number_of_sections_corrections;
+	     section_correction_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     write_io_handle->sections_corrections,
+		     section_correction_index,
+		     (intptr_t **) &section_correction,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve section correction: %d.",
+			 function,
+			 section_correction_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_thread_pool_push(
+		     write_thread_pool,
+		     (intptr_t *) section_correction,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to push section correction: %d onto queue.",
+			 function,
+			 section_correction_index );
+
+			goto on_error;
+		}
+#else
+		section_correction->write_result = libewf_section_correction_write_data(
+		                                    section_correction,
+		                                    error );
+
+		if( section_correction->write_result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write section correction: %d.",
+			 function,
+			 section_correction_index );
+
+			goto on_error;
+		}
+#endif
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_thread_pool_join(
+	     &write_thread_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join write thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	/* The thread pool does not pass on the result of the callback
+	 */
+	for( section_correction_index = 0;
+	     section_correction_index < number_of_sections_corrections;
+	     section_correction_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     write_io_handle->sections_corrections,
+		     section_correction_index,
+		     (intptr_t **) &section_correction,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve section correction: %d.",
+			 function,
+			 section_correction_index );
+
+			goto on_error;
+		}
+		if( section_correction->write_result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write section correction: %d to segment file: %" PRIu32 ".",
+			 function,
+			 section_correction_index,
+			 section_correction->segment_number );
+
+			goto on_error;
+		}
+	}
+#endif
+	for( segment_writer_index = 0;
+	     segment_writer_index < number_of_segment_writers;
+	     segment_writer_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     segment_writers,
+		     segment_writer_index,
+		     (intptr_t **) &segment_writer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment writer: %d.",
+			 function,
+			 segment_writer_index );
+
+			goto on_error;
+		}
+		if( libewf_segment_writer_close(
+		     segment_writer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close segment writer: %d.",
+			 function,
+			 segment_writer_index );
+
+			goto on_error;
+		}
+	}
+	if( libcdata_array_free(
+	     &segment_writers,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_segment_writer_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free segment writers array.",
+		 function );
+
+		result = -1;
+	}
+	/* The sections corrections are no longer needed once written
+	 */
+	if( libcdata_array_empty(
+	     write_io_handle->sections_corrections,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_section_correction_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty sections corrections array.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( write_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &write_thread_pool,
+		 NULL );
+	}
+#endif
+	if( segment_writers != NULL )
+	{
+		libcdata_array_free(
+		 &segment_writers,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_segment_writer_free,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Corrects sections after streamed write
+ * The sections of the segment files written before a resumed write are read back and corrected,
+ * the sections recorded during the write are corrected by writing them in parallel
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_io_handle_finalize_write_sections_corrections(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfvalue_table_t *header_values,
+     libfvalue_table_t *hash_values,
+     libewf_hash_sections_t *hash_sections,
+     libcdata_array_t *sessions,
+     libcdata_array_t *tracks,
+     libcdata_range_list_t *acquiry_errors,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_write_io_handle_finalize_write_sections_corrections";
+	size64_t segment_file_size          = 0;
+	ssize_t write_count                 = 0;
+	uint32_t number_of_resumed_segments = 0;
 	uint32_t number_of_segments         = 0;
 	uint32_t segment_number             = 0;
 	int file_io_pool_entry              = 0;
@@ -3527,8 +5106,14 @@ int libewf_write_io_handle_finalize_write_sections_corrections(
 
 		return( -1 );
 	}
+	number_of_resumed_segments = write_io_handle->number_of_resumed_segments;
+
+	if( number_of_resumed_segments > number_of_segments )
+	{
+		number_of_resumed_segments = number_of_segments;
+	}
 	for( segment_number = 0;
-	     segment_number < number_of_segments;
+	     segment_number < number_of_resumed_segments;
 	     segment_number++ )
 	{
 		if( segment_number == ( number_of_segments - 1 ) )
@@ -3615,6 +5200,131 @@ int libewf_write_io_handle_finalize_write_sections_corrections(
 			return( -1 );
 		}
 	}
+	if( libewf_write_io_handle_write_sections_corrections(
+	     write_io_handle,
+	     io_handle,
+	     file_io_pool,
+	     media_values,
+	     header_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write sections corrections.",
+		 function );
+
+		return( -1 );
+	}
+	/* The last segment file should be terminated with a done section and not with a next section
+	 * which is the case when the data ended at the end of the last segment file
+	 */
+	if( ( number_of_segments > number_of_resumed_segments )
+	 && ( write_io_handle->next_section_segment_number == number_of_segments ) )
+	{
+		segment_number = number_of_segments - 1;
+
+		if( libewf_segment_table_get_segment_by_index(
+		     segment_table,
+		     segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( libewf_segment_table_get_segment_file_by_index(
+		     segment_table,
+		     segment_number,
+		     file_io_pool,
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( segment_file == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: correcting last next section.\n",
+			 function );
+		}
+#endif
+		if( libbfio_pool_seek_offset(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     write_io_handle->next_section_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to find offset to last next section.",
+			 function );
+
+			return( -1 );
+		}
+		segment_file->current_offset = write_io_handle->next_section_offset;
+
+		write_count = libewf_segment_file_write_close(
+			       segment_file,
+			       file_io_pool,
+			       file_io_pool_entry,
+			       write_io_handle->number_of_chunks_written_to_segment_file,
+			       1,
+			       hash_sections,
+			       hash_values,
+			       media_values,
+			       sessions,
+			       tracks,
+			       acquiry_errors,
+			       &( write_io_handle->data_section ),
+			       error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to close last segment file.",
+			 function );
+
+			return( -1 );
+		}
+		write_io_handle->next_section_segment_number = 0;
+	}
 	return( 1 );
 }
 
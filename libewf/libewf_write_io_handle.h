@@ -180,6 +180,11 @@ struct libewf_write_io_handle
          */
         uint32_t maximum_chunks_per_section;
 
+        /* The chunks section limit, which is the maximum number of chunks written
+         * to a chunks section before the section is closed, 0 represents no limit
+         */
+        uint32_t chunks_section_limit;
+
 	/* The offset of the chunks section within the current segment file
 	 */
 	off64_t chunks_section_offset;
@@ -207,6 +212,36 @@ struct libewf_write_io_handle
 	/* The size of the compressed zero byte empty block
 	 */
 	size_t compressed_zero_byte_empty_block_size;
+
+	/* Value to indicate the segment files are written concurrently
+	 */
+	uint8_t concurrent_segment_write;
+
+	/* Value to indicate the layout of the segment files was written
+	 */
+	uint8_t layout_written;
+
+	/* The segment writers of a concurrent segment write
+	 */
+	libcdata_array_t *segment_writers;
+
+	/* The sections that contain media values written during a streamed write
+	 * these are corrected when the write is finalized
+	 */
+	libcdata_array_t *sections_corrections;
+
+	/* The number of segments when the write was resumed
+	 * the sections of these segment files were not recorded and are read back to be corrected
+	 */
+	uint32_t number_of_resumed_segments;
+
+	/* The segment number of the segment file that was last closed with a next section
+	 */
+	uint32_t next_section_segment_number;
+
+	/* The offset of the next section in the segment file that was last closed with a next section
+	 */
+	off64_t next_section_offset;
 };
 
 int libewf_write_io_handle_initialize(
@@ -299,6 +334,21 @@ ssize_t libewf_write_io_handle_write_chunks_section_end(
          libewf_segment_file_t *segment_file,
          libcerror_error_t **error );
 
+ssize_t libewf_write_io_handle_close_chunks_section(
+         libewf_write_io_handle_t *write_io_handle,
+         libewf_io_handle_t *io_handle,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         libewf_segment_file_t *segment_file,
+         uint32_t segment_number,
+         libewf_media_values_t *media_values,
+         libfvalue_table_t *hash_values,
+         libewf_hash_sections_t *hash_sections,
+         libcdata_array_t *sessions,
+         libcdata_array_t *tracks,
+         libcdata_range_list_t *acquiry_errors,
+         libcerror_error_t **error );
+
 ssize_t libewf_write_io_handle_write_new_chunk(
          libewf_write_io_handle_t *write_io_handle,
          libewf_io_handle_t *io_handle,
@@ -316,8 +366,69 @@ ssize_t libewf_write_io_handle_write_new_chunk(
          size_t input_data_size,
          libcerror_error_t **error );
 
+int libewf_write_io_handle_append_reserved_chunk(
+     libewf_write_io_handle_t *write_io_handle,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libewf_media_values_t *media_values,
+     uint32_t segment_number,
+     uint64_t chunk_index,
+     off64_t chunk_offset,
+     libcerror_error_t **error );
+
+int libewf_write_io_handle_write_layout(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfvalue_table_t *header_values,
+     libfvalue_table_t *hash_values,
+     libewf_hash_sections_t *hash_sections,
+     libcdata_array_t *sessions,
+     libcdata_array_t *tracks,
+     libcdata_range_list_t *acquiry_errors,
+     libcerror_error_t **error );
+
+ssize_t libewf_write_io_handle_write_reserved_chunk(
+         libewf_write_io_handle_t *write_io_handle,
+         libewf_media_values_t *media_values,
+         uint64_t chunk_index,
+         libewf_chunk_data_t *chunk_data,
+         size_t input_data_size,
+         libcerror_error_t **error );
+
+int libewf_write_io_handle_close_segment_writers(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_media_values_t *media_values,
+     libcerror_error_t **error );
+
+int libewf_write_io_handle_write_checkpoint(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfvalue_table_t *hash_values,
+     libewf_hash_sections_t *hash_sections,
+     libcdata_array_t *sessions,
+     libcdata_array_t *tracks,
+     libcdata_range_list_t *acquiry_errors,
+     uint32_t *segment_number,
+     uint64_t *number_of_chunks,
+     libcerror_error_t **error );
+
+int libewf_write_io_handle_write_sections_corrections(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libfvalue_table_t *header_values,
+     libcerror_error_t **error );
+
 int libewf_write_io_handle_finalize_write_sections_corrections(
      libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
      libewf_media_values_t *media_values,
      libewf_segment_table_t *segment_table,
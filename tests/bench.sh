@@ -0,0 +1,210 @@
+#!/bin/bash
+# Benchmark script
+#
+# Writes a JSON object per line to bench.jsonl or the file defined by
+# BENCH_OUTPUT so that the results of different revisions can be compared.
+#
+# Version: 20170227
+
+EXIT_SUCCESS=0;
+EXIT_FAILURE=1;
+EXIT_IGNORE=77;
+
+TEST_PREFIX=`dirname ${PWD}`;
+TEST_PREFIX=`basename ${TEST_PREFIX} | sed 's/^lib\([^-]*\).*$/\1/'`;
+
+TEST_TOOL_DIRECTORY="../${TEST_PREFIX}tools";
+
+BENCH_OUTPUT=${BENCH_OUTPUT:-bench.jsonl};
+BENCH_TMPDIR=${BENCH_TMPDIR:-tmp_bench};
+
+# The benchmark matrix, the mix defines the weight of zeros, pattern, text and random data
+BENCH_FORMATS=${BENCH_FORMATS:-"encase6 ex01"};
+BENCH_MEDIA_SIZE=${BENCH_MEDIA_SIZE:-67108864};
+BENCH_MIXES=${BENCH_MIXES:-"25,25,25,25 70,10,10,10 0,0,0,100"};
+BENCH_SECTORS_PER_CHUNK=${BENCH_SECTORS_PER_CHUNK:-"64 512"};
+BENCH_SEED=${BENCH_SEED:-1};
+
+find_executable()
+{
+	local EXECUTABLE=$1;
+
+	if ! test -x "${EXECUTABLE}";
+	then
+		EXECUTABLE="${EXECUTABLE}.exe";
+	fi
+	if ! test -x "${EXECUTABLE}";
+	then
+		return ${EXIT_FAILURE};
+	fi
+	echo ${EXECUTABLE};
+
+	return ${EXIT_SUCCESS};
+}
+
+# Determines the revision the results are for
+get_revision()
+{
+	local REVISION=`git describe --always --dirty 2> /dev/null`;
+
+	if test -z "${REVISION}";
+	then
+		REVISION=`sed -n 's/^AC_INIT(\[libewf\],[ ]*\[\([0-9]*\)\].*$/\1/p' ../configure.ac 2> /dev/null`;
+	fi
+	if test -z "${REVISION}";
+	then
+		REVISION="unknown";
+	fi
+	echo ${REVISION};
+}
+
+# Adds the benchmark parameters to the JSON objects read from stdin
+add_parameters()
+{
+	local FORMAT=$1;
+	local SECTORS_PER_CHUNK=$2;
+	local MIX=$3;
+
+	sed "s/^{/{\"revision\": \"${REVISION}\", \"format\": \"${FORMAT}\", \"sectors_per_chunk\": ${SECTORS_PER_CHUNK}, \"mix\": \"${MIX}\", /";
+}
+
+# Writes the last telemetry record of a tool as a benchmark result
+add_telemetry()
+{
+	local BENCHMARK=$1;
+	local TELEMETRY_FILE=$2;
+	local FORMAT=$3;
+	local SECTORS_PER_CHUNK=$4;
+	local MIX=$5;
+
+	if ! test -f "${TELEMETRY_FILE}";
+	then
+		return ${EXIT_FAILURE};
+	fi
+	tail -n 1 "${TELEMETRY_FILE}" | sed "s/^{/{\"benchmark\": \"${BENCHMARK}\", /" | add_parameters "${FORMAT}" "${SECTORS_PER_CHUNK}" "${MIX}" >> ${BENCH_OUTPUT};
+
+	return ${EXIT_SUCCESS};
+}
+
+run_benchmark()
+{
+	local FORMAT=$1;
+	local SECTORS_PER_CHUNK=$2;
+	local MIX=$3;
+
+	local ACQUIRE_FORMAT=${FORMAT};
+	local EXTENSION="E01";
+
+	if test "${FORMAT}" = "ex01";
+	then
+		ACQUIRE_FORMAT="encase7-v2";
+		EXTENSION="Ex01";
+	fi
+	rm -rf ${BENCH_TMPDIR}/*;
+
+	# The EWF segment file extension is added by the library
+	${BENCH_GENERATE} -b ${SECTORS_PER_CHUNK} -B ${BENCH_MEDIA_SIZE} -f ${FORMAT} -m ${MIX} -s ${BENCH_SEED} ${BENCH_TMPDIR}/image;
+
+	if test $? -ne ${EXIT_SUCCESS};
+	then
+		echo "Unable to generate image: ${FORMAT} ${SECTORS_PER_CHUNK} ${MIX}";
+
+		return ${EXIT_FAILURE};
+	fi
+	${BENCH} -s ${BENCH_SEED} -m ${MIX} -t ${BENCH_TMPDIR}/pack ${BENCH_TMPDIR}/image.${EXTENSION} | add_parameters "${FORMAT}" "${SECTORS_PER_CHUNK}" "${MIX}" >> ${BENCH_OUTPUT};
+
+	if test ${PIPESTATUS[0]} -ne ${EXIT_SUCCESS};
+	then
+		echo "Unable to run benchmark: ${FORMAT} ${SECTORS_PER_CHUNK} ${MIX}";
+
+		return ${EXIT_FAILURE};
+	fi
+	if ! test -z "${EWFACQUIRE}";
+	then
+		${BENCH_GENERATE} -b ${SECTORS_PER_CHUNK} -B ${BENCH_MEDIA_SIZE} -f raw -m ${MIX} -s ${BENCH_SEED} ${BENCH_TMPDIR}/image.raw;
+
+		if test $? -ne ${EXIT_SUCCESS};
+		then
+			echo "Unable to generate RAW image: ${SECTORS_PER_CHUNK} ${MIX}";
+
+			return ${EXIT_FAILURE};
+		fi
+		${EWFACQUIRE} -q -u -b ${SECTORS_PER_CHUNK} -c fast -f ${ACQUIRE_FORMAT} -J ${BENCH_TMPDIR}/ewfacquire.jsonl -t ${BENCH_TMPDIR}/acquire ${BENCH_TMPDIR}/image.raw > /dev/null;
+
+		if test $? -ne ${EXIT_SUCCESS};
+		then
+			echo "Unable to run ewfacquire: ${FORMAT} ${SECTORS_PER_CHUNK} ${MIX}";
+
+			return ${EXIT_FAILURE};
+		fi
+		add_telemetry "ewfacquire" ${BENCH_TMPDIR}/ewfacquire.jsonl "${FORMAT}" "${SECTORS_PER_CHUNK}" "${MIX}";
+	fi
+	if ! test -z "${EWFVERIFY}";
+	then
+		${EWFVERIFY} -q -J ${BENCH_TMPDIR}/ewfverify.jsonl ${BENCH_TMPDIR}/image.${EXTENSION} > /dev/null;
+
+		if test $? -ne ${EXIT_SUCCESS};
+		then
+			echo "Unable to run ewfverify: ${FORMAT} ${SECTORS_PER_CHUNK} ${MIX}";
+
+			return ${EXIT_FAILURE};
+		fi
+		add_telemetry "ewfverify" ${BENCH_TMPDIR}/ewfverify.jsonl "${FORMAT}" "${SECTORS_PER_CHUNK}" "${MIX}";
+	fi
+	return ${EXIT_SUCCESS};
+}
+
+BENCH=`find_executable "./${TEST_PREFIX}_bench"`;
+
+if test -z "${BENCH}";
+then
+	echo "Missing benchmark executable: ./${TEST_PREFIX}_bench";
+
+	exit ${EXIT_FAILURE};
+fi
+
+BENCH_GENERATE=`find_executable "./${TEST_PREFIX}_bench_generate"`;
+
+if test -z "${BENCH_GENERATE}";
+then
+	echo "Missing benchmark executable: ./${TEST_PREFIX}_bench_generate";
+
+	exit ${EXIT_FAILURE};
+fi
+
+# The tools benchmarks are skipped if the tools are not available
+EWFACQUIRE=`find_executable "${TEST_TOOL_DIRECTORY}/${TEST_PREFIX}acquire"`;
+EWFVERIFY=`find_executable "${TEST_TOOL_DIRECTORY}/${TEST_PREFIX}verify"`;
+
+REVISION=`get_revision`;
+
+mkdir -p ${BENCH_TMPDIR};
+
+RESULT=${EXIT_SUCCESS};
+
+for FORMAT in ${BENCH_FORMATS};
+do
+	for SECTORS_PER_CHUNK in ${BENCH_SECTORS_PER_CHUNK};
+	do
+		for MIX in ${BENCH_MIXES};
+		do
+			run_benchmark "${FORMAT}" "${SECTORS_PER_CHUNK}" "${MIX}";
+			RESULT=$?;
+
+			if test ${RESULT} -ne ${EXIT_SUCCESS};
+			then
+				break 3;
+			fi
+		done
+	done
+done
+
+rm -rf ${BENCH_TMPDIR};
+
+if test ${RESULT} -eq ${EXIT_SUCCESS};
+then
+	echo "Benchmark results written to: ${BENCH_OUTPUT}";
+fi
+
+exit ${RESULT};
+
@@ -127,6 +127,13 @@ do
 			echo "Creating option set file: ${OUTPUT_FILE}";
 
 			echo "-cdeflate:empty-block -dsha1,sha256 -fencase7 -j0" > "${OUTPUT_FILE}";
+
+			# Test adjusting the number of active jobs.
+			OUTPUT_FILE="${TEST_SET_DIR}/${INPUT_NAME}.jobs:auto";
+
+			echo "Creating option set file: ${OUTPUT_FILE}";
+
+			echo "-cdeflate:fast -fencase7 -jauto" > "${OUTPUT_FILE}";
 		else
 			for FORMAT in encase7 encase7-v2 smart;
 			do
@@ -0,0 +1,1666 @@
+/*
+ * Library benchmark program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+#if defined( HAVE_CLOCK_GETTIME ) && defined( HAVE_SYS_TIME_H ) && !defined( TIME_WITH_SYS_TIME )
+#include <time.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_bench_data.h"
+#include "ewf_test_getopt.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+
+#include "../libewf/libewf_compression.h"
+#include "../libewf/libewf_deflate.h"
+
+#define EWF_BENCH_DEFAULT_NUMBER_OF_ITERATIONS	256
+#define EWF_BENCH_DEFAULT_NUMBER_OF_READS	1024
+
+/* Copies a string of a decimal value to a 64-bit value
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_system_string_decimal_copy_to_64_bit(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function              = "ewf_bench_system_string_decimal_copy_to_64_bit";
+	size_t string_index                = 0;
+	system_character_t character_value = 0;
+	uint8_t maximum_string_index       = 20;
+	int8_t sign                        = 1;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid string size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	*value_64bit = 0;
+
+	if( string[ string_index ] == (system_character_t) '-' )
+	{
+		string_index++;
+		maximum_string_index++;
+
+		sign = -1;
+	}
+	else if( string[ string_index ] == (system_character_t) '+' )
+	{
+		string_index++;
+		maximum_string_index++;
+	}
+	while( string_index < string_size )
+	{
+		if( string[ string_index ] == 0 )
+		{
+			break;
+		}
+		if( string_index > (size_t) maximum_string_index )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
+			 "%s: string too large.",
+			 function );
+
+			return( -1 );
+		}
+		*value_64bit *= 10;
+
+		if( ( string[ string_index ] >= (system_character_t) '0' )
+		 && ( string[ string_index ] <= (system_character_t) '9' ) )
+		{
+			character_value = (system_character_t) ( string[ string_index ] - (system_character_t) '0' );
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character value: %" PRIc_SYSTEM " at index: %d.",
+			 function,
+			 string[ string_index ],
+			 string_index );
+
+			return( -1 );
+		}
+		*value_64bit += character_value;
+
+		string_index++;
+	}
+	if( sign == -1 )
+	{
+		*value_64bit *= (uint64_t) -1;
+	}
+	return( 1 );
+}
+
+/* Retrieves a monotonic timestamp in micro seconds
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_get_timestamp(
+     uint64_t *timestamp,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	struct timespec time_value;
+
+#elif defined( HAVE_GETTIMEOFDAY )
+	struct timeval time_value;
+
+#endif
+	static char *function = "ewf_bench_get_timestamp";
+
+	if( timestamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( QueryPerformanceCounter(
+	       &counter ) == 0 )
+	 || ( frequency.QuadPart <= 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve performance counter.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) ( counter.QuadPart / frequency.QuadPart ) * 1000000UL )
+	           + ( ( (uint64_t) ( counter.QuadPart % frequency.QuadPart ) * 1000000UL ) / (uint64_t) frequency.QuadPart );
+
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_value ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve monotonic clock time.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) time_value.tv_sec * 1000000UL )
+	           + ( (uint64_t) time_value.tv_nsec / 1000 );
+
+#elif defined( HAVE_GETTIMEOFDAY )
+	if( gettimeofday(
+	     &time_value,
+	     NULL ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve time of day.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) time_value.tv_sec * 1000000UL )
+	           + (uint64_t) time_value.tv_usec;
+
+#else
+	*timestamp = (uint64_t) time( NULL ) * 1000000UL;
+
+#endif
+	return( 1 );
+}
+
+/* Prints a benchmark result as a JSON line
+ */
+void ewf_bench_print_result(
+      const char *benchmark,
+      size_t chunk_size,
+      uint64_t iterations,
+      uint64_t bytes,
+      uint64_t start_timestamp,
+      uint64_t end_timestamp )
+{
+	uint64_t elapsed_micro_seconds = 0;
+
+	if( end_timestamp > start_timestamp )
+	{
+		elapsed_micro_seconds = end_timestamp - start_timestamp;
+	}
+	fprintf(
+	 stdout,
+	 "{\"benchmark\": \"%s\", \"chunk_size\": %" PRIzd ", \"iterations\": %" PRIu64 ", \"bytes\": %" PRIu64 ", \"elapsed_micro_seconds\": %" PRIu64 "}\n",
+	 benchmark,
+	 chunk_size,
+	 iterations,
+	 bytes,
+	 elapsed_micro_seconds );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Benchmarks the libewf_deflate_calculate_adler32 function
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_adler32(
+     const uint8_t *buffer,
+     size_t buffer_size,
+     uint64_t number_of_iterations,
+     libcerror_error_t **error )
+{
+	static char *function    = "ewf_bench_adler32";
+	uint64_t end_timestamp   = 0;
+	uint64_t iteration       = 0;
+	uint64_t start_timestamp = 0;
+	uint32_t checksum        = 0;
+
+	if( ewf_bench_get_timestamp(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	for( iteration = 0;
+	     iteration < number_of_iterations;
+	     iteration++ )
+	{
+		if( libewf_deflate_calculate_adler32(
+		     &checksum,
+		     buffer,
+		     buffer_size,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to calculate checksum.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ewf_bench_get_timestamp(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	ewf_bench_print_result(
+	 "adler32",
+	 buffer_size,
+	 number_of_iterations,
+	 number_of_iterations * buffer_size,
+	 start_timestamp,
+	 end_timestamp );
+
+	return( 1 );
+}
+
+/* Benchmarks the libewf_compress_data and libewf_deflate_decompress functions
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_compression(
+     const uint8_t *buffer,
+     size_t buffer_size,
+     int8_t compression_level,
+     uint64_t number_of_iterations,
+     libcerror_error_t **error )
+{
+	uint8_t *compressed_data       = NULL;
+	uint8_t *uncompressed_data     = NULL;
+	static char *function          = "ewf_bench_compression";
+	size_t compressed_data_size    = 0;
+	size_t maximum_compressed_size = 0;
+	size_t uncompressed_data_size  = 0;
+	uint64_t end_timestamp         = 0;
+	uint64_t iteration             = 0;
+	uint64_t start_timestamp       = 0;
+
+	/* Leave room for data that does not compress
+	 */
+	maximum_compressed_size = buffer_size + ( buffer_size / 1000 ) + 64;
+
+	compressed_data = (uint8_t *) memory_allocate(
+	                               sizeof( uint8_t ) * maximum_compressed_size );
+
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compressed data.",
+		 function );
+
+		goto on_error;
+	}
+	uncompressed_data = (uint8_t *) memory_allocate(
+	                                 sizeof( uint8_t ) * buffer_size );
+
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create uncompressed data.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_bench_get_timestamp(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	for( iteration = 0;
+	     iteration < number_of_iterations;
+	     iteration++ )
+	{
+		compressed_data_size = maximum_compressed_size;
+
+		if( libewf_compress_data(
+		     compressed_data,
+		     &compressed_data_size,
+		     LIBEWF_COMPRESSION_METHOD_DEFLATE,
+		     compression_level,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+			 "%s: unable to compress data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ewf_bench_get_timestamp(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	ewf_bench_print_result(
+	 ( compression_level == LIBEWF_COMPRESSION_BEST ) ? "compress_best" : "compress_fast",
+	 buffer_size,
+	 number_of_iterations,
+	 number_of_iterations * buffer_size,
+	 start_timestamp,
+	 end_timestamp );
+
+	if( ewf_bench_get_timestamp(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	for( iteration = 0;
+	     iteration < number_of_iterations;
+	     iteration++ )
+	{
+		uncompressed_data_size = buffer_size;
+
+		if( libewf_deflate_decompress(
+		     compressed_data,
+		     compressed_data_size,
+		     uncompressed_data,
+		     &uncompressed_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ewf_bench_get_timestamp(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	ewf_bench_print_result(
+	 ( compression_level == LIBEWF_COMPRESSION_BEST ) ? "decompress_best" : "decompress_fast",
+	 buffer_size,
+	 number_of_iterations,
+	 number_of_iterations * buffer_size,
+	 start_timestamp,
+	 end_timestamp );
+
+	memory_free(
+	 uncompressed_data );
+	memory_free(
+	 compressed_data );
+
+	return( 1 );
+
+on_error:
+	if( uncompressed_data != NULL )
+	{
+		memory_free(
+		 uncompressed_data );
+	}
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	return( -1 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* Benchmarks packing chunk data using a data chunk of a write handle
+ * The target image only contains the media values since no chunks are written
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_pack(
+     const system_character_t *target,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     uint32_t sectors_per_chunk,
+     uint64_t number_of_iterations,
+     libcerror_error_t **error )
+{
+	libewf_data_chunk_t *data_chunk = NULL;
+	libewf_handle_t *handle         = NULL;
+	static char *function           = "ewf_bench_pack";
+	ssize_t write_count             = 0;
+	uint64_t end_timestamp          = 0;
+	uint64_t iteration              = 0;
+	uint64_t start_timestamp        = 0;
+
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     (wchar_t * const *) &target,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     (char * const *) &target,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_media_size(
+	     handle,
+	     (size64_t) buffer_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_sectors_per_chunk(
+	     handle,
+	     sectors_per_chunk,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set sectors per chunk.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_compression_values(
+	     handle,
+	     LIBEWF_COMPRESSION_FAST,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set compression values.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_data_chunk(
+	     handle,
+	     &data_chunk,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data chunk.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_bench_get_timestamp(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	for( iteration = 0;
+	     iteration < number_of_iterations;
+	     iteration++ )
+	{
+		write_count = libewf_data_chunk_write_buffer(
+		               data_chunk,
+		               buffer,
+		               buffer_size,
+		               error );
+
+		if( write_count != (ssize_t) buffer_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write buffer to data chunk.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ewf_bench_get_timestamp(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	ewf_bench_print_result(
+	 "pack",
+	 buffer_size,
+	 number_of_iterations,
+	 number_of_iterations * buffer_size,
+	 start_timestamp,
+	 end_timestamp );
+
+	if( libewf_data_chunk_free(
+	     &data_chunk,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free data chunk.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( data_chunk != NULL )
+	{
+		libewf_data_chunk_free(
+		 &data_chunk,
+		 NULL );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Creates and opens a source handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_handle_open_source(
+     libewf_handle_t **handle,
+     const system_character_t *source,
+     libcerror_error_t **error )
+{
+	system_character_t **filenames = NULL;
+	static char *function          = "ewf_bench_handle_open_source";
+	size_t source_length           = 0;
+	int number_of_filenames        = 0;
+	int result                     = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( source == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source.",
+		 function );
+
+		return( -1 );
+	}
+	source_length = system_string_length(
+	                 source );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_glob_wide(
+	          source,
+	          source_length,
+	          LIBEWF_FORMAT_UNKNOWN,
+	          &filenames,
+	          &number_of_filenames,
+	          error );
+#else
+	result = libewf_glob(
+	          source,
+	          source_length,
+	          LIBEWF_FORMAT_UNKNOWN,
+	          &filenames,
+	          &number_of_filenames,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to resolve filename(s).",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_initialize(
+	     handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_handle_open_wide(
+	          *handle,
+	          (wchar_t * const *) filenames,
+	          number_of_filenames,
+	          LIBEWF_OPEN_READ,
+	          error );
+#else
+	result = libewf_handle_open(
+	          *handle,
+	          (char * const *) filenames,
+	          number_of_filenames,
+	          LIBEWF_OPEN_READ,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_glob_wide_free(
+	          filenames,
+	          number_of_filenames,
+	          error );
+#else
+	result = libewf_glob_free(
+	          filenames,
+	          number_of_filenames,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free globbed filenames.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *handle != NULL )
+	{
+		libewf_handle_free(
+		 handle,
+		 NULL );
+	}
+	if( filenames != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	return( -1 );
+}
+
+/* Benchmarks reading the storage media data sequentially
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_read_sequential(
+     libewf_handle_t *handle,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function    = "ewf_bench_read_sequential";
+	ssize_t read_count       = 0;
+	uint64_t end_timestamp   = 0;
+	uint64_t number_of_reads = 0;
+	uint64_t start_timestamp = 0;
+	uint64_t total_read      = 0;
+
+	if( libewf_handle_seek_offset(
+	     handle,
+	     0,
+	     SEEK_SET,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: 0.",
+		 function );
+
+		return( -1 );
+	}
+	if( ewf_bench_get_timestamp(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              buffer_size,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer.",
+			 function );
+
+			return( -1 );
+		}
+		total_read += (uint64_t) read_count;
+
+		number_of_reads++;
+	}
+	while( read_count > 0 );
+
+	if( ewf_bench_get_timestamp(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	ewf_bench_print_result(
+	 "read_sequential",
+	 buffer_size,
+	 number_of_reads,
+	 total_read,
+	 start_timestamp,
+	 end_timestamp );
+
+	return( 1 );
+}
+
+/* Benchmarks reading the storage media data at random offsets
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_read_random(
+     libewf_handle_t *handle,
+     ewf_bench_data_generator_t *data_generator,
+     uint8_t *buffer,
+     size_t buffer_size,
+     uint64_t number_of_reads,
+     libcerror_error_t **error )
+{
+	static char *function    = "ewf_bench_read_random";
+	size64_t media_size      = 0;
+	ssize_t read_count       = 0;
+	off64_t offset           = 0;
+	uint64_t end_timestamp   = 0;
+	uint64_t read_index      = 0;
+	uint64_t start_timestamp = 0;
+	uint64_t total_read      = 0;
+
+	if( libewf_handle_get_media_size(
+	     handle,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_size == 0 )
+	{
+		return( 1 );
+	}
+	if( ewf_bench_get_timestamp(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	for( read_index = 0;
+	     read_index < number_of_reads;
+	     read_index++ )
+	{
+		/* Use sector aligned offsets as most consumers of an image do
+		 */
+		offset = (off64_t) ( ( ewf_bench_data_generator_get_random_value(
+		                        data_generator ) % media_size ) & ~( (uint64_t) 511 ) );
+
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              buffer_size,
+		              offset,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		total_read += (uint64_t) read_count;
+	}
+	if( ewf_bench_get_timestamp(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	ewf_bench_print_result(
+	 "read_random",
+	 buffer_size,
+	 number_of_reads,
+	 total_read,
+	 start_timestamp,
+	 end_timestamp );
+
+	return( 1 );
+}
+
+/* Benchmarks unpacking the chunks using data chunks
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_unpack(
+     libewf_handle_t *handle,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	libewf_data_chunk_t *data_chunk = NULL;
+	static char *function           = "ewf_bench_unpack";
+	ssize_t read_count              = 0;
+	uint64_t end_timestamp          = 0;
+	uint64_t number_of_chunks       = 0;
+	uint64_t start_timestamp        = 0;
+	uint64_t total_read             = 0;
+
+	if( libewf_handle_seek_offset(
+	     handle,
+	     0,
+	     SEEK_SET,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: 0.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_data_chunk(
+	     handle,
+	     &data_chunk,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data chunk.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_bench_get_timestamp(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	do
+	{
+		read_count = libewf_handle_read_data_chunk(
+		              handle,
+		              data_chunk,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data chunk.",
+			 function );
+
+			goto on_error;
+		}
+		else if( read_count == 0 )
+		{
+			break;
+		}
+		read_count = libewf_data_chunk_read_buffer(
+		              data_chunk,
+		              buffer,
+		              buffer_size,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from data chunk.",
+			 function );
+
+			goto on_error;
+		}
+		total_read += (uint64_t) read_count;
+
+		number_of_chunks++;
+	}
+	while( read_count > 0 );
+
+	if( ewf_bench_get_timestamp(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	ewf_bench_print_result(
+	 "unpack",
+	 buffer_size,
+	 number_of_chunks,
+	 total_read,
+	 start_timestamp,
+	 end_timestamp );
+
+	if( libewf_data_chunk_free(
+	     &data_chunk,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free data chunk.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( data_chunk != NULL )
+	{
+		libewf_data_chunk_free(
+		 &data_chunk,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	ewf_bench_data_generator_t *data_generator     = NULL;
+	libcerror_error_t *error                       = NULL;
+	libewf_handle_t *handle                        = NULL;
+	system_character_t *option_iterations          = NULL;
+	system_character_t *option_mix                 = NULL;
+	system_character_t *option_number_of_reads     = NULL;
+	system_character_t *option_sectors_per_chunk   = NULL;
+	system_character_t *option_seed                = NULL;
+	system_character_t *option_target              = NULL;
+	uint8_t *buffer                                = NULL;
+	system_integer_t option                        = 0;
+	size_t chunk_size                              = 0;
+	size_t string_length                           = 0;
+	uint64_t number_of_iterations                  = EWF_BENCH_DEFAULT_NUMBER_OF_ITERATIONS;
+	uint64_t number_of_reads                       = EWF_BENCH_DEFAULT_NUMBER_OF_READS;
+	uint64_t sectors_per_chunk                     = 64;
+	uint64_t seed                                  = 1;
+	uint32_t handle_sectors_per_chunk              = 0;
+
+	while( ( option = ewf_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "b:i:m:r:s:t:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'b':
+				option_sectors_per_chunk = optarg;
+
+				break;
+
+			case (system_integer_t) 'i':
+				option_iterations = optarg;
+
+				break;
+
+			case (system_integer_t) 'm':
+				option_mix = optarg;
+
+				break;
+
+			case (system_integer_t) 'r':
+				option_number_of_reads = optarg;
+
+				break;
+
+			case (system_integer_t) 's':
+				option_seed = optarg;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_target = optarg;
+
+				break;
+		}
+	}
+	if( option_sectors_per_chunk != NULL )
+	{
+		string_length = system_string_length(
+				 option_sectors_per_chunk );
+
+		if( ( ewf_bench_system_string_decimal_copy_to_64_bit(
+		       option_sectors_per_chunk,
+		       string_length + 1,
+		       &sectors_per_chunk,
+		       &error ) != 1 )
+		 || ( sectors_per_chunk == 0 )
+		 || ( sectors_per_chunk > (uint64_t) ( 32 * 1024 ) ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported sectors per chunk.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_iterations != NULL )
+	{
+		string_length = system_string_length(
+				 option_iterations );
+
+		if( ewf_bench_system_string_decimal_copy_to_64_bit(
+		     option_iterations,
+		     string_length + 1,
+		     &number_of_iterations,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of iterations.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_number_of_reads != NULL )
+	{
+		string_length = system_string_length(
+				 option_number_of_reads );
+
+		if( ewf_bench_system_string_decimal_copy_to_64_bit(
+		     option_number_of_reads,
+		     string_length + 1,
+		     &number_of_reads,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of reads.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_seed != NULL )
+	{
+		string_length = system_string_length(
+				 option_seed );
+
+		if( ewf_bench_system_string_decimal_copy_to_64_bit(
+		     option_seed,
+		     string_length + 1,
+		     &seed,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported seed.\n" );
+
+			goto on_error;
+		}
+	}
+	if( ewf_bench_data_generator_initialize(
+	     &data_generator,
+	     seed,
+	     option_mix,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create data generator.\n" );
+
+		goto on_error;
+	}
+	if( optind < argc )
+	{
+		if( ewf_bench_handle_open_source(
+		     &handle,
+		     argv[ optind ],
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open source.\n" );
+
+			goto on_error;
+		}
+		/* Benchmark with the chunk size of the image
+		 */
+		if( libewf_handle_get_sectors_per_chunk(
+		     handle,
+		     &handle_sectors_per_chunk,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to retrieve sectors per chunk.\n" );
+
+			goto on_error;
+		}
+		sectors_per_chunk = handle_sectors_per_chunk;
+	}
+	chunk_size = (size_t) sectors_per_chunk * 512;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * chunk_size );
+
+	if( buffer == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create buffer.\n" );
+
+		goto on_error;
+	}
+	if( ewf_bench_data_generator_fill_buffer(
+	     data_generator,
+	     buffer,
+	     chunk_size,
+	     chunk_size,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to fill buffer.\n" );
+
+		goto on_error;
+	}
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+	if( ewf_bench_adler32(
+	     buffer,
+	     chunk_size,
+	     number_of_iterations,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to benchmark Adler-32.\n" );
+
+		goto on_error;
+	}
+	if( ewf_bench_compression(
+	     buffer,
+	     chunk_size,
+	     LIBEWF_COMPRESSION_FAST,
+	     number_of_iterations,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to benchmark fast compression.\n" );
+
+		goto on_error;
+	}
+	if( ewf_bench_compression(
+	     buffer,
+	     chunk_size,
+	     LIBEWF_COMPRESSION_BEST,
+	     number_of_iterations,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to benchmark best compression.\n" );
+
+		goto on_error;
+	}
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	if( option_target != NULL )
+	{
+		if( ewf_bench_pack(
+		     option_target,
+		     buffer,
+		     chunk_size,
+		     (uint32_t) sectors_per_chunk,
+		     number_of_iterations,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to benchmark pack.\n" );
+
+			goto on_error;
+		}
+	}
+	if( handle != NULL )
+	{
+		if( ewf_bench_read_sequential(
+		     handle,
+		     buffer,
+		     chunk_size,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to benchmark sequential read.\n" );
+
+			goto on_error;
+		}
+		if( ewf_bench_read_random(
+		     handle,
+		     data_generator,
+		     buffer,
+		     ( chunk_size < 4096 ) ? chunk_size : 4096,
+		     number_of_reads,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to benchmark random read.\n" );
+
+			goto on_error;
+		}
+		if( ewf_bench_unpack(
+		     handle,
+		     buffer,
+		     chunk_size,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to benchmark unpack.\n" );
+
+			goto on_error;
+		}
+		if( libewf_handle_close(
+		     handle,
+		     &error ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to close handle.\n" );
+
+			goto on_error;
+		}
+		if( libewf_handle_free(
+		     &handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free handle.\n" );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
+	if( ewf_bench_data_generator_free(
+	     &data_generator,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free data generator.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( data_generator != NULL )
+	{
+		ewf_bench_data_generator_free(
+		 &data_generator,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
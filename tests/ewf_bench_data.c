@@ -0,0 +1,612 @@
+/*
+ * Synthetic storage media data functions for benchmarking
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "ewf_bench_data.h"
+#include "ewf_test_libcerror.h"
+
+/* The words used to generate text data
+ */
+static const char *ewf_bench_data_words[ 32 ] = {
+	"the", "evidence", "file", "contains", "a", "copy", "of", "media",
+	"sector", "chunk", "table", "section", "header", "digest", "hash", "volume",
+	"data", "and", "is", "stored", "in", "segment", "files", "with",
+	"compressed", "checksum", "offset", "size", "error", "acquiry", "case", "number" };
+
+/* Creates a data generator
+ * Make sure the value data_generator is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_data_generator_initialize(
+     ewf_bench_data_generator_t **data_generator,
+     uint64_t seed,
+     const system_character_t *mix_string,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_bench_data_generator_initialize";
+
+	if( data_generator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data generator.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_generator != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid data generator value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*data_generator = memory_allocate_structure(
+	                   ewf_bench_data_generator_t );
+
+	if( *data_generator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data generator.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *data_generator,
+	     0,
+	     sizeof( ewf_bench_data_generator_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data generator.",
+		 function );
+
+		memory_free(
+		 *data_generator );
+
+		*data_generator = NULL;
+
+		return( -1 );
+	}
+	/* The xorshift generator requires a state other than 0
+	 */
+	if( seed == 0 )
+	{
+		seed = 0x9e3779b97f4a7c15ULL;
+	}
+	( *data_generator )->random_state = seed;
+
+	if( mix_string == NULL )
+	{
+		mix_string = EWF_BENCH_DATA_DEFAULT_MIX;
+	}
+	if( ewf_bench_data_generator_set_mix(
+	     *data_generator,
+	     mix_string,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set mix.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *data_generator != NULL )
+	{
+		memory_free(
+		 *data_generator );
+
+		*data_generator = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a data generator
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_data_generator_free(
+     ewf_bench_data_generator_t **data_generator,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_bench_data_generator_free";
+
+	if( data_generator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data generator.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_generator != NULL )
+	{
+		memory_free(
+		 *data_generator );
+
+		*data_generator = NULL;
+	}
+	return( 1 );
+}
+
+/* Sets the mix of the data types
+ * The mix string contains the comma separated weights of zeros, pattern, text and random data
+ * e.g. "25,25,25,25" or "0,0,0,100", weights that are not specified are 0
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_data_generator_set_mix(
+     ewf_bench_data_generator_t *data_generator,
+     const system_character_t *mix_string,
+     libcerror_error_t **error )
+{
+	uint32_t weights[ EWF_BENCH_DATA_NUMBER_OF_TYPES ];
+
+	static char *function = "ewf_bench_data_generator_set_mix";
+	size_t string_index   = 0;
+	uint32_t total_weight = 0;
+	uint32_t weight       = 0;
+	int data_type         = 0;
+	int number_of_digits  = 0;
+
+	if( data_generator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data generator.",
+		 function );
+
+		return( -1 );
+	}
+	if( mix_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mix string.",
+		 function );
+
+		return( -1 );
+	}
+	for( data_type = 0;
+	     data_type < EWF_BENCH_DATA_NUMBER_OF_TYPES;
+	     data_type++ )
+	{
+		weights[ data_type ] = 0;
+	}
+	data_type = 0;
+
+	do
+	{
+		if( ( mix_string[ string_index ] >= (system_character_t) '0' )
+		 && ( mix_string[ string_index ] <= (system_character_t) '9' ) )
+		{
+			if( number_of_digits >= 4 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
+				 "%s: weight: %d too large.",
+				 function,
+				 data_type );
+
+				return( -1 );
+			}
+			weight *= 10;
+			weight += (uint32_t) ( mix_string[ string_index ] - (system_character_t) '0' );
+
+			number_of_digits++;
+		}
+		else if( ( mix_string[ string_index ] == (system_character_t) ',' )
+		      || ( mix_string[ string_index ] == 0 ) )
+		{
+			if( ( number_of_digits == 0 )
+			 || ( data_type >= EWF_BENCH_DATA_NUMBER_OF_TYPES ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported mix string.",
+				 function );
+
+				return( -1 );
+			}
+			weights[ data_type++ ] = weight;
+			total_weight          += weight;
+
+			weight           = 0;
+			number_of_digits = 0;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character in mix string at index: %" PRIzd ".",
+			 function,
+			 string_index );
+
+			return( -1 );
+		}
+	}
+	while( mix_string[ string_index++ ] != 0 );
+
+	if( total_weight == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid mix string - sum of weights is zero.",
+		 function );
+
+		return( -1 );
+	}
+	for( data_type = 0;
+	     data_type < EWF_BENCH_DATA_NUMBER_OF_TYPES;
+	     data_type++ )
+	{
+		data_generator->weights[ data_type ] = weights[ data_type ];
+	}
+	data_generator->total_weight = total_weight;
+
+	return( 1 );
+}
+
+/* Retrieves the next pseudo random value
+ * Uses xorshift64* so the data is the same on every platform for the same seed
+ * Returns the random value
+ */
+uint64_t ewf_bench_data_generator_get_random_value(
+          ewf_bench_data_generator_t *data_generator )
+{
+	uint64_t random_state = 0;
+
+	if( data_generator == NULL )
+	{
+		return( 0 );
+	}
+	random_state  = data_generator->random_state;
+	random_state ^= random_state >> 12;
+	random_state ^= random_state << 25;
+	random_state ^= random_state >> 27;
+
+	data_generator->random_state = random_state;
+
+	return( random_state * 0x2545f4914f6cdd1dULL );
+}
+
+/* Fills a block with data of a specific type
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_data_generator_fill_block(
+     ewf_bench_data_generator_t *data_generator,
+     uint8_t *block,
+     size_t block_size,
+     int data_type,
+     libcerror_error_t **error )
+{
+	uint8_t value_data[ 8 ];
+
+	const char *word      = NULL;
+	static char *function = "ewf_bench_data_generator_fill_block";
+	size_t block_offset   = 0;
+	uint64_t value_64bit  = 0;
+	int number_of_words   = 0;
+
+	if( data_generator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data generator.",
+		 function );
+
+		return( -1 );
+	}
+	if( block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid block size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	switch( data_type )
+	{
+		case EWF_BENCH_DATA_TYPE_ZEROS:
+			if( memory_set(
+			     block,
+			     0,
+			     block_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear block.",
+				 function );
+
+				return( -1 );
+			}
+			break;
+
+		case EWF_BENCH_DATA_TYPE_PATTERN:
+			/* Make sure the pattern is not 0 so it differs from the zeros data type
+			 */
+			value_64bit = ewf_bench_data_generator_get_random_value(
+			               data_generator ) | 1;
+
+			byte_stream_copy_from_uint64_little_endian(
+			 value_data,
+			 value_64bit );
+
+			for( block_offset = 0;
+			     block_offset < block_size;
+			     block_offset++ )
+			{
+				block[ block_offset ] = value_data[ block_offset % 8 ];
+			}
+			break;
+
+		case EWF_BENCH_DATA_TYPE_TEXT:
+			while( block_offset < block_size )
+			{
+				value_64bit = ewf_bench_data_generator_get_random_value(
+				               data_generator );
+
+				word = ewf_bench_data_words[ value_64bit % 32 ];
+
+				while( ( *word != 0 )
+				    && ( block_offset < block_size ) )
+				{
+					block[ block_offset++ ] = (uint8_t) *word++;
+				}
+				if( block_offset < block_size )
+				{
+					number_of_words++;
+
+					if( ( number_of_words % 12 ) == 0 )
+					{
+						block[ block_offset++ ] = (uint8_t) '\n';
+					}
+					else
+					{
+						block[ block_offset++ ] = (uint8_t) ' ';
+					}
+				}
+			}
+			break;
+
+		case EWF_BENCH_DATA_TYPE_RANDOM:
+			while( block_offset < block_size )
+			{
+				value_64bit = ewf_bench_data_generator_get_random_value(
+				               data_generator );
+
+				byte_stream_copy_from_uint64_little_endian(
+				 value_data,
+				 value_64bit );
+
+				if( ( block_size - block_offset ) >= 8 )
+				{
+					if( memory_copy(
+					     &( block[ block_offset ] ),
+					     value_data,
+					     8 ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+						 "%s: unable to copy random value to block.",
+						 function );
+
+						return( -1 );
+					}
+					block_offset += 8;
+				}
+				else
+				{
+					while( block_offset < block_size )
+					{
+						block[ block_offset ] = value_data[ block_offset % 8 ];
+
+						block_offset++;
+					}
+				}
+			}
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported data type: %d.",
+			 function,
+			 data_type );
+
+			return( -1 );
+	}
+	return( 1 );
+}
+
+/* Fills a buffer with blocks of data
+ * The data type of every block is chosen according to the mix
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_data_generator_fill_buffer(
+     ewf_bench_data_generator_t *data_generator,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t block_size,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_bench_data_generator_fill_buffer";
+	size_t buffer_offset  = 0;
+	size_t fill_size      = 0;
+	uint32_t weight       = 0;
+	int data_type         = 0;
+
+	if( data_generator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data generator.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_generator->total_weight == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data generator - missing mix.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid block size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < buffer_size )
+	{
+		fill_size = buffer_size - buffer_offset;
+
+		if( fill_size > block_size )
+		{
+			fill_size = block_size;
+		}
+		weight = (uint32_t) ( ewf_bench_data_generator_get_random_value(
+		                       data_generator ) % data_generator->total_weight );
+
+		for( data_type = 0;
+		     data_type < ( EWF_BENCH_DATA_NUMBER_OF_TYPES - 1 );
+		     data_type++ )
+		{
+			if( weight < data_generator->weights[ data_type ] )
+			{
+				break;
+			}
+			weight -= data_generator->weights[ data_type ];
+		}
+		if( ewf_bench_data_generator_fill_block(
+		     data_generator,
+		     &( buffer[ buffer_offset ] ),
+		     fill_size,
+		     data_type,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to fill block at offset: %" PRIzd ".",
+			 function,
+			 buffer_offset );
+
+			return( -1 );
+		}
+		buffer_offset += fill_size;
+	}
+	return( 1 );
+}
+
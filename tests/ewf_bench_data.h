@@ -0,0 +1,103 @@
+/*
+ * Synthetic storage media data functions for benchmarking
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EWF_BENCH_DATA_H )
+#define _EWF_BENCH_DATA_H
+
+#include <common.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "ewf_test_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+enum EWF_BENCH_DATA_TYPES
+{
+	EWF_BENCH_DATA_TYPE_ZEROS		= 0,
+	EWF_BENCH_DATA_TYPE_PATTERN		= 1,
+	EWF_BENCH_DATA_TYPE_TEXT		= 2,
+	EWF_BENCH_DATA_TYPE_RANDOM		= 3
+};
+
+#define EWF_BENCH_DATA_NUMBER_OF_TYPES		4
+
+/* The default mix of zeros, pattern, text and random data
+ */
+#define EWF_BENCH_DATA_DEFAULT_MIX		_SYSTEM_STRING( "25,25,25,25" )
+
+typedef struct ewf_bench_data_generator ewf_bench_data_generator_t;
+
+struct ewf_bench_data_generator
+{
+	/* The state of the pseudo random number generator
+	 */
+	uint64_t random_state;
+
+	/* The weight per data type
+	 */
+	uint32_t weights[ EWF_BENCH_DATA_NUMBER_OF_TYPES ];
+
+	/* The sum of the weights
+	 */
+	uint32_t total_weight;
+};
+
+int ewf_bench_data_generator_initialize(
+     ewf_bench_data_generator_t **data_generator,
+     uint64_t seed,
+     const system_character_t *mix_string,
+     libcerror_error_t **error );
+
+int ewf_bench_data_generator_free(
+     ewf_bench_data_generator_t **data_generator,
+     libcerror_error_t **error );
+
+int ewf_bench_data_generator_set_mix(
+     ewf_bench_data_generator_t *data_generator,
+     const system_character_t *mix_string,
+     libcerror_error_t **error );
+
+uint64_t ewf_bench_data_generator_get_random_value(
+          ewf_bench_data_generator_t *data_generator );
+
+int ewf_bench_data_generator_fill_block(
+     ewf_bench_data_generator_t *data_generator,
+     uint8_t *block,
+     size_t block_size,
+     int data_type,
+     libcerror_error_t **error );
+
+int ewf_bench_data_generator_fill_buffer(
+     ewf_bench_data_generator_t *data_generator,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t block_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _EWF_BENCH_DATA_H ) */
+
@@ -0,0 +1,867 @@
+/*
+ * Synthetic storage media image generator for benchmarking
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_bench_data.h"
+#include "ewf_test_getopt.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+
+#define EWF_BENCH_GENERATE_DEFAULT_MEDIA_SIZE	( 64 * 1024 * 1024 )
+
+/* The output format of the generator, the EWF formats are passed to libewf
+ */
+#define EWF_BENCH_GENERATE_FORMAT_RAW		0xff
+
+/* Copies a string of a decimal value to a 64-bit value
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_system_string_decimal_copy_to_64_bit(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function              = "ewf_bench_system_string_decimal_copy_to_64_bit";
+	size_t string_index                = 0;
+	system_character_t character_value = 0;
+	uint8_t maximum_string_index       = 20;
+	int8_t sign                        = 1;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid string size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	*value_64bit = 0;
+
+	if( string[ string_index ] == (system_character_t) '-' )
+	{
+		string_index++;
+		maximum_string_index++;
+
+		sign = -1;
+	}
+	else if( string[ string_index ] == (system_character_t) '+' )
+	{
+		string_index++;
+		maximum_string_index++;
+	}
+	while( string_index < string_size )
+	{
+		if( string[ string_index ] == 0 )
+		{
+			break;
+		}
+		if( string_index > (size_t) maximum_string_index )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
+			 "%s: string too large.",
+			 function );
+
+			return( -1 );
+		}
+		*value_64bit *= 10;
+
+		if( ( string[ string_index ] >= (system_character_t) '0' )
+		 && ( string[ string_index ] <= (system_character_t) '9' ) )
+		{
+			character_value = (system_character_t) ( string[ string_index ] - (system_character_t) '0' );
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character value: %" PRIc_SYSTEM " at index: %d.",
+			 function,
+			 string[ string_index ],
+			 string_index );
+
+			return( -1 );
+		}
+		*value_64bit += character_value;
+
+		string_index++;
+	}
+	if( sign == -1 )
+	{
+		*value_64bit *= (uint64_t) -1;
+	}
+	return( 1 );
+}
+
+/* Generates a RAW storage media image
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_generate_raw(
+     const system_character_t *filename,
+     ewf_bench_data_generator_t *data_generator,
+     size64_t media_size,
+     size_t chunk_size,
+     libcerror_error_t **error )
+{
+	FILE *file_stream     = NULL;
+	uint8_t *buffer       = NULL;
+	static char *function = "ewf_bench_generate_raw";
+	size_t write_size     = 0;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * chunk_size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	file_stream = file_stream_open_wide(
+	               filename,
+	               _SYSTEM_STRING( FILE_STREAM_BINARY_OPEN_WRITE ) );
+#else
+	file_stream = file_stream_open(
+	               filename,
+	               FILE_STREAM_BINARY_OPEN_WRITE );
+#endif
+	if( file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	while( media_size > 0 )
+	{
+		write_size = chunk_size;
+
+		if( (size64_t) write_size > media_size )
+		{
+			write_size = (size_t) media_size;
+		}
+		if( ewf_bench_data_generator_fill_buffer(
+		     data_generator,
+		     buffer,
+		     write_size,
+		     chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to fill buffer.",
+			 function );
+
+			goto on_error;
+		}
+		if( file_stream_write(
+		     file_stream,
+		     buffer,
+		     write_size ) != write_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write buffer of size: %" PRIzd ".",
+			 function,
+			 write_size );
+
+			goto on_error;
+		}
+		media_size -= write_size;
+	}
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		file_stream = NULL;
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		goto on_error;
+	}
+	file_stream = NULL;
+
+	memory_free(
+	 buffer );
+
+	return( 1 );
+
+on_error:
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
+/* Generates an EWF storage media image
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_generate_ewf(
+     const system_character_t *filename,
+     ewf_bench_data_generator_t *data_generator,
+     uint8_t format,
+     size64_t media_size,
+     size64_t maximum_segment_size,
+     uint32_t sectors_per_chunk,
+     int8_t compression_level,
+     uint8_t compression_flags,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *handle = NULL;
+	uint8_t *buffer         = NULL;
+	static char *function   = "ewf_bench_generate_ewf";
+	size_t chunk_size       = 0;
+	size_t write_size       = 0;
+	ssize_t write_count     = 0;
+
+	chunk_size = (size_t) sectors_per_chunk * 512;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * chunk_size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     (wchar_t * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     (char * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_format(
+	     handle,
+	     format,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set format.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_media_size(
+	     handle,
+	     media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( maximum_segment_size > 0 )
+	{
+		if( libewf_handle_set_maximum_segment_size(
+		     handle,
+		     maximum_segment_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable set maximum segment size.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_handle_set_sectors_per_chunk(
+	     handle,
+	     sectors_per_chunk,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set sectors per chunk.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_compression_values(
+	     handle,
+	     compression_level,
+	     compression_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set compression values.",
+		 function );
+
+		goto on_error;
+	}
+	while( media_size > 0 )
+	{
+		write_size = chunk_size;
+
+		if( (size64_t) write_size > media_size )
+		{
+			write_size = (size_t) media_size;
+		}
+		if( ewf_bench_data_generator_fill_buffer(
+		     data_generator,
+		     buffer,
+		     write_size,
+		     chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to fill buffer.",
+			 function );
+
+			goto on_error;
+		}
+		write_count = libewf_handle_write_buffer(
+		               handle,
+		               buffer,
+		               write_size,
+		               error );
+
+		if( write_count != (ssize_t) write_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable write buffer of size: %" PRIzd ".",
+			 function,
+			 write_size );
+
+			goto on_error;
+		}
+		media_size -= write_size;
+	}
+	if( libewf_handle_write_finalize(
+	     handle,
+	     error ) < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to finalize handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 buffer );
+
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	ewf_bench_data_generator_t *data_generator      = NULL;
+	libcerror_error_t *error                        = NULL;
+	system_character_t *option_compression_level    = NULL;
+	system_character_t *option_format               = NULL;
+	system_character_t *option_maximum_segment_size = NULL;
+	system_character_t *option_media_size           = NULL;
+	system_character_t *option_mix                  = NULL;
+	system_character_t *option_sectors_per_chunk    = NULL;
+	system_character_t *option_seed                 = NULL;
+	system_integer_t option                         = 0;
+	size64_t maximum_segment_size                   = 0;
+	size64_t media_size                             = EWF_BENCH_GENERATE_DEFAULT_MEDIA_SIZE;
+	size_t string_length                            = 0;
+	uint64_t sectors_per_chunk                      = 64;
+	uint64_t seed                                   = 1;
+	uint8_t compression_flags                       = 0;
+	uint8_t format                                  = LIBEWF_FORMAT_ENCASE6;
+	int8_t compression_level                        = LIBEWF_COMPRESSION_FAST;
+	int result                                      = 0;
+
+	while( ( option = ewf_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "b:B:c:f:m:s:S:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'b':
+				option_sectors_per_chunk = optarg;
+
+				break;
+
+			case (system_integer_t) 'B':
+				option_media_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'c':
+				option_compression_level = optarg;
+
+				break;
+
+			case (system_integer_t) 'f':
+				option_format = optarg;
+
+				break;
+
+			case (system_integer_t) 'm':
+				option_mix = optarg;
+
+				break;
+
+			case (system_integer_t) 's':
+				option_seed = optarg;
+
+				break;
+
+			case (system_integer_t) 'S':
+				option_maximum_segment_size = optarg;
+
+				break;
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing target filename.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	if( option_sectors_per_chunk != NULL )
+	{
+		string_length = system_string_length(
+				 option_sectors_per_chunk );
+
+		if( ( ewf_bench_system_string_decimal_copy_to_64_bit(
+		       option_sectors_per_chunk,
+		       string_length + 1,
+		       &sectors_per_chunk,
+		       &error ) != 1 )
+		 || ( sectors_per_chunk == 0 )
+		 || ( sectors_per_chunk > (uint64_t) ( 32 * 1024 ) ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported sectors per chunk.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_media_size != NULL )
+	{
+		string_length = system_string_length(
+				 option_media_size );
+
+		if( ewf_bench_system_string_decimal_copy_to_64_bit(
+		     option_media_size,
+		     string_length + 1,
+		     &media_size,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported media size.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_compression_level != NULL )
+	{
+		string_length = system_string_length(
+				 option_compression_level );
+
+		if( string_length != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported compression level.\n" );
+
+			goto on_error;
+		}
+		if( option_compression_level[ 0 ] == (system_character_t) 'b' )
+		{
+			compression_level = LIBEWF_COMPRESSION_BEST;
+			compression_flags = 0;
+		}
+		else if( option_compression_level[ 0 ] == (system_character_t) 'e' )
+		{
+			compression_level = LIBEWF_COMPRESSION_NONE;
+			compression_flags = LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION;
+		}
+		else if( option_compression_level[ 0 ] == (system_character_t) 'f' )
+		{
+			compression_level = LIBEWF_COMPRESSION_FAST;
+			compression_flags = 0;
+		}
+		else if( option_compression_level[ 0 ] == (system_character_t) 'n' )
+		{
+			compression_level = LIBEWF_COMPRESSION_NONE;
+			compression_flags = 0;
+		}
+		else
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported compression level.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_format != NULL )
+	{
+		string_length = system_string_length(
+				 option_format );
+
+		if( ( string_length == 3 )
+		 && ( system_string_compare(
+		       option_format,
+		       _SYSTEM_STRING( "raw" ),
+		       3 ) == 0 ) )
+		{
+			format = EWF_BENCH_GENERATE_FORMAT_RAW;
+		}
+		else if( ( string_length == 4 )
+		      && ( system_string_compare(
+		            option_format,
+		            _SYSTEM_STRING( "ewfx" ),
+		            4 ) == 0 ) )
+		{
+			format = LIBEWF_FORMAT_EWFX;
+		}
+		else if( ( string_length == 4 )
+		      && ( system_string_compare(
+		            option_format,
+		            _SYSTEM_STRING( "ex01" ),
+		            4 ) == 0 ) )
+		{
+			format = LIBEWF_FORMAT_V2_ENCASE7;
+		}
+		else if( ( string_length == 7 )
+		      && ( system_string_compare(
+		            option_format,
+		            _SYSTEM_STRING( "encase6" ),
+		            7 ) == 0 ) )
+		{
+			format = LIBEWF_FORMAT_ENCASE6;
+		}
+		else if( ( string_length == 7 )
+		      && ( system_string_compare(
+		            option_format,
+		            _SYSTEM_STRING( "encase7" ),
+		            7 ) == 0 ) )
+		{
+			format = LIBEWF_FORMAT_ENCASE7;
+		}
+		else
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported format.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_seed != NULL )
+	{
+		string_length = system_string_length(
+				 option_seed );
+
+		if( ewf_bench_system_string_decimal_copy_to_64_bit(
+		     option_seed,
+		     string_length + 1,
+		     &seed,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported seed.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_maximum_segment_size != NULL )
+	{
+		string_length = system_string_length(
+				 option_maximum_segment_size );
+
+		if( ewf_bench_system_string_decimal_copy_to_64_bit(
+		     option_maximum_segment_size,
+		     string_length + 1,
+		     &maximum_segment_size,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported maximum segment size.\n" );
+
+			goto on_error;
+		}
+	}
+	if( ewf_bench_data_generator_initialize(
+	     &data_generator,
+	     seed,
+	     option_mix,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create data generator.\n" );
+
+		goto on_error;
+	}
+	if( format == EWF_BENCH_GENERATE_FORMAT_RAW )
+	{
+		result = ewf_bench_generate_raw(
+		          argv[ optind ],
+		          data_generator,
+		          media_size,
+		          (size_t) sectors_per_chunk * 512,
+		          &error );
+	}
+	else
+	{
+		result = ewf_bench_generate_ewf(
+		          argv[ optind ],
+		          data_generator,
+		          format,
+		          media_size,
+		          maximum_segment_size,
+		          (uint32_t) sectors_per_chunk,
+		          compression_level,
+		          compression_flags,
+		          &error );
+	}
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to generate image.\n" );
+
+		goto on_error;
+	}
+	if( ewf_bench_data_generator_free(
+	     &data_generator,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free data generator.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( data_generator != NULL )
+	{
+		ewf_bench_data_generator_free(
+		 &data_generator,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,1390 @@
+/*
+ * Library chunk_data_pool type test program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_chunk_data.h"
+#include "../libewf/libewf_chunk_data_pool.h"
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_io_handle.h"
+
+#if defined( __GNUC__ )
+
+/* Tests the libewf_chunk_data_pool_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_pool_initialize(
+     void )
+{
+	libcerror_error_t *error                  = NULL;
+	libewf_chunk_data_pool_t *chunk_data_pool = NULL;
+	int result                                = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_data_pool_initialize(
+	          &chunk_data_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "chunk_data_pool",
+         chunk_data_pool );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data_pool->number_of_references",
+	 chunk_data_pool->number_of_references,
+	 1 );
+
+	result = libewf_chunk_data_pool_free(
+	          &chunk_data_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "chunk_data_pool",
+         chunk_data_pool );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_pool_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	chunk_data_pool = (libewf_chunk_data_pool_t *) 0x12345678UL;
+
+	result = libewf_chunk_data_pool_initialize(
+	          &chunk_data_pool,
+	          &error );
+
+	chunk_data_pool = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data_pool != NULL )
+	{
+		libewf_chunk_data_pool_free(
+		 &chunk_data_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_pool_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_pool_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_pool_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_pool_add_reference function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_pool_add_reference(
+     void )
+{
+	libcerror_error_t *error                            = NULL;
+	libewf_chunk_data_pool_t *chunk_data_pool           = NULL;
+	libewf_chunk_data_pool_t *chunk_data_pool_reference = NULL;
+	int result                                          = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_data_pool_initialize(
+	          &chunk_data_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "chunk_data_pool",
+         chunk_data_pool );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_data_pool_add_reference(
+	          chunk_data_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data_pool->number_of_references",
+	 chunk_data_pool->number_of_references,
+	 2 );
+
+	chunk_data_pool_reference = chunk_data_pool;
+
+	/* Releasing the first reference should not free the chunk data pool
+	 */
+	result = libewf_chunk_data_pool_free(
+	          &chunk_data_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "chunk_data_pool",
+         chunk_data_pool );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data_pool_reference->number_of_references",
+	 chunk_data_pool_reference->number_of_references,
+	 1 );
+
+	result = libewf_chunk_data_pool_free(
+	          &chunk_data_pool_reference,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "chunk_data_pool_reference",
+         chunk_data_pool_reference );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_pool_add_reference(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data_pool_reference != NULL )
+	{
+		libewf_chunk_data_pool_free(
+		 &chunk_data_pool_reference,
+		 NULL );
+	}
+	if( chunk_data_pool != NULL )
+	{
+		libewf_chunk_data_pool_free(
+		 &chunk_data_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_pool_get_size_class function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_pool_get_size_class(
+     void )
+{
+	libcerror_error_t *error      = NULL;
+	size_t size_class_buffer_size = 0;
+	int result                    = 0;
+	int size_class                = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_data_pool_get_size_class(
+	          1,
+	          &size_class,
+	          &size_class_buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "size_class",
+	 size_class,
+	 LIBEWF_CHUNK_DATA_POOL_MINIMUM_SIZE_CLASS );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "size_class_buffer_size",
+	 size_class_buffer_size,
+	 (size_t) 512 + LIBEWF_CHUNK_DATA_POOL_BUFFER_PADDING_SIZE );
+
+	/* A chunk of 32 KiB with checksum rounded to 16 bytes should fit the 32 KiB size class
+	 */
+	result = libewf_chunk_data_pool_get_size_class(
+	          32768 + 16,
+	          &size_class,
+	          &size_class_buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "size_class",
+	 size_class,
+	 15 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "size_class_buffer_size",
+	 size_class_buffer_size,
+	 (size_t) 32768 + LIBEWF_CHUNK_DATA_POOL_BUFFER_PADDING_SIZE );
+
+	result = libewf_chunk_data_pool_get_size_class(
+	          32768 + LIBEWF_CHUNK_DATA_POOL_BUFFER_PADDING_SIZE + 1,
+	          &size_class,
+	          &size_class_buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "size_class",
+	 size_class,
+	 16 );
+
+	result = libewf_chunk_data_pool_get_size_class(
+	          ( (size_t) 1 << LIBEWF_CHUNK_DATA_POOL_MAXIMUM_SIZE_CLASS ) + LIBEWF_CHUNK_DATA_POOL_BUFFER_PADDING_SIZE,
+	          &size_class,
+	          &size_class_buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "size_class",
+	 size_class,
+	 LIBEWF_CHUNK_DATA_POOL_MAXIMUM_SIZE_CLASS );
+
+	/* Test a buffer size that is not within a size class
+	 */
+	result = libewf_chunk_data_pool_get_size_class(
+	          ( (size_t) 1 << LIBEWF_CHUNK_DATA_POOL_MAXIMUM_SIZE_CLASS ) + LIBEWF_CHUNK_DATA_POOL_BUFFER_PADDING_SIZE + 1,
+	          &size_class,
+	          &size_class_buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_pool_get_size_class(
+	          512,
+	          NULL,
+	          &size_class_buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_pool_get_size_class(
+	          512,
+	          &size_class,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_pool_get_buffer and libewf_chunk_data_pool_release_buffer functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_pool_get_and_release_buffer(
+     void )
+{
+	libcerror_error_t *error                  = NULL;
+	libewf_chunk_data_pool_t *chunk_data_pool = NULL;
+	uint8_t *buffer                           = NULL;
+	uint8_t *released_buffer                  = NULL;
+	size_t allocated_buffer_size              = 0;
+	int result                                = 0;
+	int size_class_index                      = 15 - LIBEWF_CHUNK_DATA_POOL_MINIMUM_SIZE_CLASS;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_data_pool_initialize(
+	          &chunk_data_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "chunk_data_pool",
+         chunk_data_pool );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_data_pool_get_buffer(
+	          chunk_data_pool,
+	          32768 + 16,
+	          &buffer,
+	          &allocated_buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "buffer",
+         buffer );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "allocated_buffer_size",
+	 allocated_buffer_size,
+	 (size_t) 32768 + LIBEWF_CHUNK_DATA_POOL_BUFFER_PADDING_SIZE );
+
+	released_buffer = buffer;
+
+	result = libewf_chunk_data_pool_release_buffer(
+	          chunk_data_pool,
+	          &buffer,
+	          allocated_buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "buffer",
+         buffer );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data_pool->number_of_free_buffers",
+	 chunk_data_pool->number_of_free_buffers[ size_class_index ],
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunk_data_pool->free_size",
+	 chunk_data_pool->free_size,
+	 allocated_buffer_size );
+
+	/* A buffer of the same size class should reuse the released buffer
+	 */
+	result = libewf_chunk_data_pool_get_buffer(
+	          chunk_data_pool,
+	          32768,
+	          &buffer,
+	          &allocated_buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	if( buffer != released_buffer )
+	{
+		fprintf(
+		 stdout,
+		 "%s:%d buffer was not reused\n",
+		 __FILE__,
+		 __LINE__ );
+
+		goto on_error;
+	}
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data_pool->number_of_free_buffers",
+	 chunk_data_pool->number_of_free_buffers[ size_class_index ],
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunk_data_pool->free_size",
+	 chunk_data_pool->free_size,
+	 (size_t) 0 );
+
+	result = libewf_chunk_data_pool_release_buffer(
+	          chunk_data_pool,
+	          &buffer,
+	          allocated_buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* A buffer that was not allocated with the size of a size class is freed
+	 */
+	result = libewf_chunk_data_pool_get_buffer(
+	          NULL,
+	          1000,
+	          &buffer,
+	          &allocated_buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "buffer",
+         buffer );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "allocated_buffer_size",
+	 allocated_buffer_size,
+	 (size_t) 1000 );
+
+	result = libewf_chunk_data_pool_release_buffer(
+	          chunk_data_pool,
+	          &buffer,
+	          allocated_buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "buffer",
+         buffer );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data_pool->number_of_free_buffers",
+	 chunk_data_pool->number_of_free_buffers[ 10 - LIBEWF_CHUNK_DATA_POOL_MINIMUM_SIZE_CLASS ],
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_pool_get_buffer(
+	          chunk_data_pool,
+	          0,
+	          &buffer,
+	          &allocated_buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_pool_get_buffer(
+	          chunk_data_pool,
+	          512,
+	          NULL,
+	          &allocated_buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_pool_get_buffer(
+	          chunk_data_pool,
+	          512,
+	          &buffer,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_pool_release_buffer(
+	          chunk_data_pool,
+	          NULL,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_pool_free(
+	          &chunk_data_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "chunk_data_pool",
+         chunk_data_pool );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffer != NULL )
+	{
+		libewf_chunk_data_pool_release_buffer(
+		 NULL,
+		 &buffer,
+		 allocated_buffer_size,
+		 NULL );
+	}
+	if( chunk_data_pool != NULL )
+	{
+		libewf_chunk_data_pool_free(
+		 &chunk_data_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the maximum number of free buffers and maximum free size of the chunk data pool
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_pool_maximums(
+     void )
+{
+	uint8_t *buffers[ LIBEWF_CHUNK_DATA_POOL_MAXIMUM_NUMBER_OF_FREE_BUFFERS + 1 ];
+
+	libcerror_error_t *error                  = NULL;
+	libewf_chunk_data_pool_t *chunk_data_pool = NULL;
+	uint8_t *buffer                           = NULL;
+	size_t allocated_buffer_size              = 0;
+	int buffer_index                          = 0;
+	int result                                = 0;
+
+	for( buffer_index = 0;
+	     buffer_index < ( LIBEWF_CHUNK_DATA_POOL_MAXIMUM_NUMBER_OF_FREE_BUFFERS + 1 );
+	     buffer_index++ )
+	{
+		buffers[ buffer_index ] = NULL;
+	}
+	/* Initialize test
+	 */
+	result = libewf_chunk_data_pool_initialize(
+	          &chunk_data_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "chunk_data_pool",
+         chunk_data_pool );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test that no more than the maximum number of free buffers are kept
+	 */
+	for( buffer_index = 0;
+	     buffer_index < ( LIBEWF_CHUNK_DATA_POOL_MAXIMUM_NUMBER_OF_FREE_BUFFERS + 1 );
+	     buffer_index++ )
+	{
+		result = libewf_chunk_data_pool_get_buffer(
+		          chunk_data_pool,
+		          512,
+		          &( buffers[ buffer_index ] ),
+		          &allocated_buffer_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+	        EWF_TEST_ASSERT_IS_NULL(
+	         "error",
+	         error );
+	}
+	for( buffer_index = 0;
+	     buffer_index < ( LIBEWF_CHUNK_DATA_POOL_MAXIMUM_NUMBER_OF_FREE_BUFFERS + 1 );
+	     buffer_index++ )
+	{
+		result = libewf_chunk_data_pool_release_buffer(
+		          chunk_data_pool,
+		          &( buffers[ buffer_index ] ),
+		          allocated_buffer_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+	        EWF_TEST_ASSERT_IS_NULL(
+	         "error",
+	         error );
+	}
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data_pool->number_of_free_buffers",
+	 chunk_data_pool->number_of_free_buffers[ 0 ],
+	 LIBEWF_CHUNK_DATA_POOL_MAXIMUM_NUMBER_OF_FREE_BUFFERS );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunk_data_pool->free_size",
+	 chunk_data_pool->free_size,
+	 (size_t) LIBEWF_CHUNK_DATA_POOL_MAXIMUM_NUMBER_OF_FREE_BUFFERS * allocated_buffer_size );
+
+	/* Test that a buffer that exceeds the maximum free size is not kept
+	 */
+	result = libewf_chunk_data_pool_get_buffer(
+	          chunk_data_pool,
+	          (size_t) 1 << LIBEWF_CHUNK_DATA_POOL_MAXIMUM_SIZE_CLASS,
+	          &buffer,
+	          &allocated_buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_chunk_data_pool_release_buffer(
+	          chunk_data_pool,
+	          &buffer,
+	          allocated_buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "buffer",
+         buffer );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data_pool->number_of_free_buffers",
+	 chunk_data_pool->number_of_free_buffers[ LIBEWF_CHUNK_DATA_POOL_NUMBER_OF_SIZE_CLASSES - 1 ],
+	 0 );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_pool_free(
+	          &chunk_data_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( buffer_index = 0;
+	     buffer_index < ( LIBEWF_CHUNK_DATA_POOL_MAXIMUM_NUMBER_OF_FREE_BUFFERS + 1 );
+	     buffer_index++ )
+	{
+		if( buffers[ buffer_index ] != NULL )
+		{
+			memory_free(
+			 buffers[ buffer_index ] );
+		}
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( chunk_data_pool != NULL )
+	{
+		libewf_chunk_data_pool_free(
+		 &chunk_data_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_pool_clear function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_pool_clear(
+     void )
+{
+	libcerror_error_t *error                  = NULL;
+	libewf_chunk_data_pool_t *chunk_data_pool = NULL;
+	uint8_t *buffer                           = NULL;
+	uint8_t *released_buffer                  = NULL;
+	size_t allocated_buffer_size              = 0;
+	int result                                = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_data_pool_initialize(
+	          &chunk_data_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "chunk_data_pool",
+         chunk_data_pool );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_chunk_data_pool_get_buffer(
+	          chunk_data_pool,
+	          512,
+	          &buffer,
+	          &allocated_buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_chunk_data_pool_release_buffer(
+	          chunk_data_pool,
+	          &buffer,
+	          allocated_buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_data_pool_clear(
+	          chunk_data_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "chunk_data_pool->free_lists",
+         chunk_data_pool->free_lists[ 0 ] );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data_pool->number_of_free_buffers",
+	 chunk_data_pool->number_of_free_buffers[ 0 ],
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunk_data_pool->free_size",
+	 chunk_data_pool->free_size,
+	 (size_t) 0 );
+
+	/* Test that the chunk data pool reuses buffers after a clear
+	 */
+	result = libewf_chunk_data_pool_get_buffer(
+	          chunk_data_pool,
+	          512,
+	          &buffer,
+	          &allocated_buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	released_buffer = buffer;
+
+	result = libewf_chunk_data_pool_release_buffer(
+	          chunk_data_pool,
+	          &buffer,
+	          allocated_buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data_pool->number_of_free_buffers",
+	 chunk_data_pool->number_of_free_buffers[ 0 ],
+	 1 );
+
+	result = libewf_chunk_data_pool_get_buffer(
+	          chunk_data_pool,
+	          512,
+	          &buffer,
+	          &allocated_buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	if( buffer != released_buffer )
+	{
+		fprintf(
+		 stdout,
+		 "%s:%d buffer was not reused\n",
+		 __FILE__,
+		 __LINE__ );
+
+		goto on_error;
+	}
+	result = libewf_chunk_data_pool_release_buffer(
+	          chunk_data_pool,
+	          &buffer,
+	          allocated_buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_pool_clear(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_pool_free(
+	          &chunk_data_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( chunk_data_pool != NULL )
+	{
+		libewf_chunk_data_pool_free(
+		 &chunk_data_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests freeing chunk data after the IO handle that owns the chunk data pool was freed
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_pool_chunk_data_outlives_io_handle(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_chunk_data_t *chunk_data = NULL;
+	libewf_io_handle_t *io_handle   = NULL;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "io_handle",
+         io_handle );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          io_handle->chunk_data_pool,
+	          32768,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "chunk_data",
+         chunk_data );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data->chunk_data_pool->number_of_references",
+	 chunk_data->chunk_data_pool->number_of_references,
+	 2 );
+
+	/* Test regular cases
+	 */
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data->chunk_data_pool->number_of_references",
+	 chunk_data->chunk_data_pool->number_of_references,
+	 1 );
+
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "chunk_data",
+         chunk_data );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_pool_initialize",
+	 ewf_test_chunk_data_pool_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_pool_free",
+	 ewf_test_chunk_data_pool_free );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_pool_add_reference",
+	 ewf_test_chunk_data_pool_add_reference );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_pool_get_size_class",
+	 ewf_test_chunk_data_pool_get_size_class );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_pool_get_buffer and libewf_chunk_data_pool_release_buffer",
+	 ewf_test_chunk_data_pool_get_and_release_buffer );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_pool maximums",
+	 ewf_test_chunk_data_pool_maximums );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_pool_clear",
+	 ewf_test_chunk_data_pool_clear );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_free after libewf_io_handle_free",
+	 ewf_test_chunk_data_pool_chunk_data_outlives_io_handle );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -33,7 +33,11 @@
 #include "ewf_test_memory.h"
 #include "ewf_test_unused.h"
 
+#include "../libewf/libewf_checksum.h"
+#include "../libewf/libewf_chunk_data.h"
 #include "../libewf/libewf_data_chunk.h"
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_io_handle.h"
 
 /* Tests the libewf_data_chunk_free function
  * Returns 1 if successful or 0 if not
@@ -73,8 +77,508 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_data_chunk_is_corrupted function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_data_chunk_is_corrupted(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_data_chunk_is_corrupted(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_data_chunk_get_packed_data_size function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_data_chunk_get_packed_data_size(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	size_t packed_data_size  = 0;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_data_chunk_get_packed_data_size(
+	          NULL,
+	          &packed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_data_chunk_read_packed_data function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_data_chunk_read_packed_data(
+     void )
+{
+	uint8_t buffer[ 64 ];
+
+	libcerror_error_t *error = NULL;
+	ssize_t read_count       = 0;
+	uint32_t chunk_flags     = 0;
+
+	/* Test error cases
+	 */
+	read_count = libewf_data_chunk_read_packed_data(
+	              NULL,
+	              buffer,
+	              64,
+	              &chunk_flags,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_data_chunk_write_packed_data function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_data_chunk_write_packed_data(
+     void )
+{
+	uint8_t buffer[ 64 ];
+
+	libcerror_error_t *error = NULL;
+	ssize_t write_count      = 0;
+
+	/* Test error cases
+	 */
+	write_count = libewf_data_chunk_write_packed_data(
+	               NULL,
+	               buffer,
+	               64,
+	               64,
+	               0,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 #if defined( __GNUC__ )
 
+/* Creates a data chunk that contains packed chunk data with a checksum
+ * If corrupt_data is set the chunk data does not match its checksum
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_data_chunk_initialize_with_packed_data(
+     libewf_data_chunk_t **data_chunk,
+     libewf_io_handle_t *io_handle,
+     uint8_t corrupt_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "ewf_test_data_chunk_initialize_with_packed_data";
+	size_t data_offset              = 0;
+	uint32_t checksum               = 0;
+
+	if( libewf_chunk_data_initialize(
+	     &chunk_data,
+	     io_handle->chunk_data_pool,
+	     512,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	for( data_offset = 0;
+	     data_offset < 512;
+	     data_offset++ )
+	{
+		chunk_data->data[ data_offset ] = (uint8_t) data_offset;
+	}
+	if( libewf_checksum_calculate_adler32(
+	     &checksum,
+	     chunk_data->data,
+	     512,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 &( chunk_data->data[ 512 ] ),
+	 checksum );
+
+	if( corrupt_data != 0 )
+	{
+		chunk_data->data[ 0 ] ^= 0xff;
+	}
+	chunk_data->data_size   = 512 + 4;
+	chunk_data->range_flags = LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+
+	if( libewf_data_chunk_initialize(
+	     data_chunk,
+	     io_handle,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create data chunk.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_internal_data_chunk_set_chunk_data(
+	     (libewf_internal_data_chunk_t *) *data_chunk,
+	     0,
+	     chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk data in data chunk.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_chunk_data_free(
+	     &chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *data_chunk != NULL )
+	{
+		libewf_data_chunk_free(
+		 data_chunk,
+		 NULL );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests the libewf_data_chunk_is_corrupted function with packed chunk data
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_data_chunk_is_corrupted_with_packed_data(
+     void )
+{
+	uint8_t buffer[ 512 ];
+
+	libcerror_error_t *error           = NULL;
+	libewf_data_chunk_t *data_chunk    = NULL;
+	libewf_io_handle_t *io_handle      = NULL;
+	uint64_t number_of_checksum_errors = 0;
+	ssize_t read_count                 = 0;
+	int result                         = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "io_handle",
+         io_handle );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test an intact chunk
+	 */
+	result = ewf_test_data_chunk_initialize_with_packed_data(
+	          &data_chunk,
+	          io_handle,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_data_chunk_is_corrupted(
+	          data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	read_count = libewf_data_chunk_read_buffer(
+	              data_chunk,
+	              buffer,
+	              512,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "buffer[ 255 ]",
+	 (int) buffer[ 255 ],
+	 255 );
+
+	result = libewf_data_chunk_free(
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	number_of_checksum_errors = libewf_statistics_load(
+	                             io_handle->statistics.number_of_checksum_errors );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_checksum_errors",
+	 number_of_checksum_errors,
+	 (uint64_t) 0 );
+
+	/* Test a corrupted chunk
+	 */
+	result = ewf_test_data_chunk_initialize_with_packed_data(
+	          &data_chunk,
+	          io_handle,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_data_chunk_is_corrupted(
+	          data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test that the chunk data is validated only once
+	 */
+	result = libewf_data_chunk_is_corrupted(
+	          data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	number_of_checksum_errors = libewf_statistics_load(
+	                             io_handle->statistics.number_of_checksum_errors );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_checksum_errors",
+	 number_of_checksum_errors,
+	 (uint64_t) 1 );
+
+	/* Clean up
+	 */
+	result = libewf_data_chunk_free(
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_chunk != NULL )
+	{
+		libewf_data_chunk_free(
+		 &data_chunk,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) */
 
 /* The main program
@@ -106,10 +610,34 @@ int main(
 
 	/* TODO: add tests for libewf_data_chunk_read_buffer */
 
+#endif /* defined( __GNUC__ ) */
+
+	EWF_TEST_RUN(
+	 "libewf_data_chunk_is_corrupted",
+	 ewf_test_data_chunk_is_corrupted );
+
+#if defined( __GNUC__ )
+
+	EWF_TEST_RUN(
+	 "libewf_data_chunk_is_corrupted with packed data",
+	 ewf_test_data_chunk_is_corrupted_with_packed_data );
+
 	/* TODO: add tests for libewf_data_chunk_write_buffer */
 
 #endif /* defined( __GNUC__ ) */
 
+	EWF_TEST_RUN(
+	 "libewf_data_chunk_get_packed_data_size",
+	 ewf_test_data_chunk_get_packed_data_size );
+
+	EWF_TEST_RUN(
+	 "libewf_data_chunk_read_packed_data",
+	 ewf_test_data_chunk_read_packed_data );
+
+	EWF_TEST_RUN(
+	 "libewf_data_chunk_write_packed_data",
+	 ewf_test_data_chunk_write_packed_data );
+
 	return( EXIT_SUCCESS );
 
 on_error:
@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
@@ -2009,6 +2010,624 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_handle_get_statistics functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_statistics(
+     libewf_handle_t *handle )
+{
+	uint64_t values[ LIBEWF_STATISTICS_NUMBER_OF_VALUES ];
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_statistics(
+	          handle,
+	          values,
+	          LIBEWF_STATISTICS_NUMBER_OF_VALUES,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test retrieving less values than available
+	 */
+	result = libewf_handle_get_statistics(
+	          handle,
+	          values,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_statistics(
+	          NULL,
+	          values,
+	          LIBEWF_STATISTICS_NUMBER_OF_VALUES,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_statistics(
+	          handle,
+	          NULL,
+	          LIBEWF_STATISTICS_NUMBER_OF_VALUES,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_statistics(
+	          handle,
+	          values,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_reset_statistics functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_reset_statistics(
+     libewf_handle_t *handle )
+{
+	uint64_t values[ LIBEWF_STATISTICS_NUMBER_OF_VALUES ];
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_reset_statistics(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_handle_get_statistics(
+	          handle,
+	          values,
+	          LIBEWF_STATISTICS_NUMBER_OF_VALUES,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBEWF_STATISTICS_VALUE_CHUNK_CACHE_MISSES ]",
+	 values[ LIBEWF_STATISTICS_VALUE_CHUNK_CACHE_MISSES ],
+	 (uint64_t) 0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBEWF_STATISTICS_VALUE_BYTES_READ ]",
+	 values[ LIBEWF_STATISTICS_VALUE_BYTES_READ ],
+	 (uint64_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_reset_statistics(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+
+/* Tests the libewf_handle_set_statistics_flags functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_set_statistics_flags(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_set_statistics_flags(
+	          handle,
+	          LIBEWF_STATISTICS_FLAG_MEASURE_DECOMPRESSION_TIME,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_handle_set_statistics_flags(
+	          handle,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_set_statistics_flags(
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_statistics_flags(
+	          handle,
+	          0xff,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the statistics after reading data chunks
+ * The source is opened with a separate handle so that the chunks are not cached
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_statistics_after_read(
+     const system_character_t *source )
+{
+	uint64_t values[ LIBEWF_STATISTICS_NUMBER_OF_VALUES ];
+
+	libcerror_error_t *error             = NULL;
+	libewf_data_chunk_t *data_chunk      = NULL;
+	libewf_handle_t *handle              = NULL;
+	uint8_t *chunk_buffer                = NULL;
+	uint8_t *packed_buffer               = NULL;
+	uint8_t *reallocated_buffer          = NULL;
+	size_t packed_buffer_size            = 0;
+	size_t packed_data_size              = 0;
+	ssize_t read_count                   = 0;
+	uint64_t expected_bytes_decompressed = 0;
+	uint64_t number_of_chunk_lookups     = 0;
+	uint64_t number_of_chunks            = 0;
+	uint64_t number_of_corrupted_chunks  = 0;
+	uint32_t chunk_flags                 = 0;
+	size32_t chunk_size                  = 0;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_handle_open_source(
+	          &handle,
+	          source,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "handle",
+         handle );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_handle_get_chunk_size(
+	          handle,
+	          &chunk_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	chunk_buffer = (uint8_t *) memory_allocate(
+	                            sizeof( uint8_t ) * chunk_size );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "chunk_buffer",
+         chunk_buffer );
+
+	result = libewf_handle_get_data_chunk(
+	          handle,
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_handle_set_statistics_flags(
+	          handle,
+	          LIBEWF_STATISTICS_FLAG_MEASURE_DECOMPRESSION_TIME,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_handle_reset_statistics(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test reading the first chunks
+	 * Only the chunks that are stored compressed are decompressed
+	 */
+	while( number_of_chunks < 16 )
+	{
+		read_count = libewf_handle_read_packed_data_chunk(
+		              handle,
+		              data_chunk,
+		              &error );
+
+		EWF_TEST_ASSERT_NOT_EQUAL_INT(
+		 "read_count",
+		 (int) read_count,
+		 -1 );
+
+	        EWF_TEST_ASSERT_IS_NULL(
+	         "error",
+	         error );
+
+		if( read_count == 0 )
+		{
+			break;
+		}
+		number_of_chunks++;
+
+		chunk_flags = 0;
+
+		result = libewf_data_chunk_get_packed_data_size(
+		          data_chunk,
+		          &packed_data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+	        EWF_TEST_ASSERT_IS_NULL(
+	         "error",
+	         error );
+
+		if( result != 0 )
+		{
+			if( packed_data_size > packed_buffer_size )
+			{
+				reallocated_buffer = (uint8_t *) memory_reallocate(
+				                                  packed_buffer,
+				                                  sizeof( uint8_t ) * packed_data_size );
+
+			        EWF_TEST_ASSERT_IS_NOT_NULL(
+			         "reallocated_buffer",
+			         reallocated_buffer );
+
+				packed_buffer      = reallocated_buffer;
+				packed_buffer_size = packed_data_size;
+			}
+			read_count = libewf_data_chunk_read_packed_data(
+			              data_chunk,
+			              packed_buffer,
+			              packed_buffer_size,
+			              &chunk_flags,
+			              &error );
+
+			EWF_TEST_ASSERT_NOT_EQUAL_INT(
+			 "read_count",
+			 (int) read_count,
+			 -1 );
+
+		        EWF_TEST_ASSERT_IS_NULL(
+		         "error",
+		         error );
+		}
+		result = libewf_data_chunk_is_corrupted(
+		          data_chunk,
+		          &error );
+
+		EWF_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+	        EWF_TEST_ASSERT_IS_NULL(
+	         "error",
+	         error );
+
+		read_count = libewf_data_chunk_read_buffer(
+		              data_chunk,
+		              chunk_buffer,
+		              (size_t) chunk_size,
+		              &error );
+
+		EWF_TEST_ASSERT_NOT_EQUAL_INT(
+		 "read_count",
+		 (int) read_count,
+		 -1 );
+
+	        EWF_TEST_ASSERT_IS_NULL(
+	         "error",
+	         error );
+
+		if( result != 0 )
+		{
+			number_of_corrupted_chunks++;
+		}
+		else if( ( ( chunk_flags & LIBEWF_DATA_CHUNK_FLAG_IS_COMPRESSED ) != 0 )
+		 && ( ( chunk_flags & LIBEWF_DATA_CHUNK_FLAG_USES_PATTERN_FILL ) == 0 ) )
+		{
+			expected_bytes_decompressed += (uint64_t) read_count;
+		}
+	}
+	result = libewf_handle_get_statistics(
+	          handle,
+	          values,
+	          LIBEWF_STATISTICS_NUMBER_OF_VALUES,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	if( number_of_chunks > 0 )
+	{
+		number_of_chunk_lookups = values[ LIBEWF_STATISTICS_VALUE_CHUNK_CACHE_HITS ]
+		                        + values[ LIBEWF_STATISTICS_VALUE_CHUNK_CACHE_MISSES ];
+
+		EWF_TEST_ASSERT_GREATER_THAN_UINT64(
+		 "number_of_chunk_lookups",
+		 number_of_chunk_lookups,
+		 (uint64_t) 0 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "number_of_chunk_lookups >= number_of_chunks",
+		 (int) ( number_of_chunk_lookups >= number_of_chunks ),
+		 1 );
+
+		if( values[ LIBEWF_STATISTICS_VALUE_CHUNK_CACHE_MISSES ] > 0 )
+		{
+			EWF_TEST_ASSERT_GREATER_THAN_UINT64(
+			 "values[ LIBEWF_STATISTICS_VALUE_BYTES_READ ]",
+			 values[ LIBEWF_STATISTICS_VALUE_BYTES_READ ],
+			 (uint64_t) 0 );
+		}
+	}
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBEWF_STATISTICS_VALUE_BYTES_DECOMPRESSED ]",
+	 values[ LIBEWF_STATISTICS_VALUE_BYTES_DECOMPRESSED ],
+	 expected_bytes_decompressed );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBEWF_STATISTICS_VALUE_CHECKSUM_ERRORS ]",
+	 values[ LIBEWF_STATISTICS_VALUE_CHECKSUM_ERRORS ],
+	 number_of_corrupted_chunks );
+
+	/* Clean up
+	 */
+	if( packed_buffer != NULL )
+	{
+		memory_free(
+		 packed_buffer );
+
+		packed_buffer = NULL;
+	}
+	memory_free(
+	 chunk_buffer );
+
+	chunk_buffer = NULL;
+
+	result = libewf_data_chunk_free(
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = ewf_test_handle_close_source(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( packed_buffer != NULL )
+	{
+		memory_free(
+		 packed_buffer );
+	}
+	if( chunk_buffer != NULL )
+	{
+		memory_free(
+		 chunk_buffer );
+	}
+	if( data_chunk != NULL )
+	{
+		libewf_data_chunk_free(
+		 &data_chunk,
+		 NULL );
+	}
+	if( handle != NULL )
+	{
+		ewf_test_handle_close_source(
+		 &handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* Tests the libewf_handle_get_checksum_error functions
  * Returns 1 if successful or 0 if not
  */
@@ -5013,6 +5632,26 @@ int main(
 
 		/* TODO add test for libewf_handle_append_checksum_error */
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_statistics",
+		 ewf_test_handle_get_statistics,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_reset_statistics",
+		 ewf_test_handle_reset_statistics,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_statistics_flags",
+		 ewf_test_handle_set_statistics_flags,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_statistics after read",
+		 ewf_test_handle_get_statistics_after_read,
+		 source );
+
 		EWF_TEST_RUN_WITH_ARGS(
 		 "libewf_handle_get_number_of_sessions",
 		 ewf_test_handle_get_number_of_sessions,
@@ -0,0 +1,1725 @@
+/*
+ * Library segment_file type test program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_getopt.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/ewf_section.h"
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_io_handle.h"
+#include "../libewf/libewf_libbfio.h"
+#include "../libewf/libewf_libcdata.h"
+#include "../libewf/libewf_media_values.h"
+#include "../libewf/libewf_section.h"
+#include "../libewf/libewf_section_correction.h"
+#include "../libewf/libewf_segment_file.h"
+
+/* The maximum number of sections read from a segment file by the tests
+ */
+#define EWF_TEST_SEGMENT_FILE_MAXIMUM_NUMBER_OF_SECTIONS	65536
+
+#if defined( __GNUC__ )
+
+/* Creates a file IO pool and opens the source
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_segment_file_open_source(
+     libbfio_pool_t **file_io_pool,
+     const system_character_t *source,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "ewf_test_segment_file_open_source";
+	size_t source_length             = 0;
+	int file_io_pool_entry           = 0;
+	int result                       = 0;
+
+	if( file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( source == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	source_length = system_string_length(
+	                 source );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbfio_file_set_name_wide(
+	          file_io_handle,
+	          source,
+	          source_length,
+	          error );
+#else
+	result = libbfio_file_set_name(
+	          file_io_handle,
+	          source,
+	          source_length,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_initialize(
+	     file_io_pool,
+	     0,
+	     LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_append_handle(
+	     *file_io_pool,
+	     &file_io_pool_entry,
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append file IO handle to pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 file_io_pool,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests the libewf_segment_file_get_section_descriptors_window function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_file_get_section_descriptors_window(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libewf_io_handle_t *io_handle       = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	size_t window_data_size             = 0;
+	off64_t window_offset               = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "io_handle",
+         io_handle );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_segment_file_initialize(
+	          &segment_file,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "segment_file",
+         segment_file );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test regular cases with EWF version 1, where the window starts at the section descriptor
+	 */
+	segment_file->major_version = 1;
+
+	result = libewf_segment_file_get_section_descriptors_window(
+	          segment_file,
+	          13,
+	          1048576,
+	          &window_offset,
+	          &window_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "window_offset",
+	 (int64_t) window_offset,
+	 (int64_t) 13 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "window_data_size",
+	 window_data_size,
+	 (size_t) LIBEWF_SEGMENT_FILE_SECTION_DESCRIPTORS_WINDOW_SIZE );
+
+	/* Test with a window that is bounded by the end of the segment file
+	 */
+	result = libewf_segment_file_get_section_descriptors_window(
+	          segment_file,
+	          13,
+	          1024,
+	          &window_offset,
+	          &window_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "window_offset",
+	 (int64_t) window_offset,
+	 (int64_t) 13 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "window_data_size",
+	 window_data_size,
+	 (size_t) 1024 - 13 );
+
+	/* Test with a section descriptor that lies outside the segment file
+	 */
+	result = libewf_segment_file_get_section_descriptors_window(
+	          segment_file,
+	          1000,
+	          1024,
+	          &window_offset,
+	          &window_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test regular cases with EWF version 2, where the window ends at the end of the section descriptor
+	 */
+	segment_file->major_version = 2;
+
+	result = libewf_segment_file_get_section_descriptors_window(
+	          segment_file,
+	          1048576 - sizeof( ewf_section_descriptor_v2_t ),
+	          1048576,
+	          &window_offset,
+	          &window_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "window_offset",
+	 (int64_t) window_offset,
+	 (int64_t) 1048576 - LIBEWF_SEGMENT_FILE_SECTION_DESCRIPTORS_WINDOW_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "window_data_size",
+	 window_data_size,
+	 (size_t) LIBEWF_SEGMENT_FILE_SECTION_DESCRIPTORS_WINDOW_SIZE );
+
+	/* Test with a window that is bounded by the start of the segment file
+	 */
+	result = libewf_segment_file_get_section_descriptors_window(
+	          segment_file,
+	          1024 - sizeof( ewf_section_descriptor_v2_t ),
+	          1024,
+	          &window_offset,
+	          &window_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "window_offset",
+	 (int64_t) window_offset,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "window_data_size",
+	 window_data_size,
+	 (size_t) 1024 );
+
+	/* Test error cases
+	 */
+	result = libewf_segment_file_get_section_descriptors_window(
+	          NULL,
+	          0,
+	          1024,
+	          &window_offset,
+	          &window_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_file_get_section_descriptors_window(
+	          segment_file,
+	          -1,
+	          1024,
+	          &window_offset,
+	          &window_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_file_get_section_descriptors_window(
+	          segment_file,
+	          0,
+	          1024,
+	          NULL,
+	          &window_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_file_get_section_descriptors_window(
+	          segment_file,
+	          0,
+	          1024,
+	          &window_offset,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with an unsupported format version
+	 */
+	segment_file->major_version = 3;
+
+	result = libewf_segment_file_get_section_descriptors_window(
+	          segment_file,
+	          0,
+	          1024,
+	          &window_offset,
+	          &window_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_segment_file_free(
+	          &segment_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_segment_file_read_section_descriptors_window function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_file_read_section_descriptors_window(
+     void )
+{
+	uint8_t window_data[ 64 ];
+
+	libcerror_error_t *error            = NULL;
+	libewf_io_handle_t *io_handle       = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	ssize_t read_count                  = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "io_handle",
+         io_handle );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_segment_file_initialize(
+	          &segment_file,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "segment_file",
+         segment_file );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	segment_file->major_version = 2;
+
+	/* Test error cases
+	 */
+	read_count = libewf_segment_file_read_section_descriptors_window(
+	              NULL,
+	              NULL,
+	              0,
+	              0,
+	              window_data,
+	              64,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_segment_file_read_section_descriptors_window(
+	              segment_file,
+	              NULL,
+	              0,
+	              -1,
+	              window_data,
+	              64,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_segment_file_read_section_descriptors_window(
+	              segment_file,
+	              NULL,
+	              0,
+	              0,
+	              NULL,
+	              64,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_segment_file_read_section_descriptors_window(
+	              segment_file,
+	              NULL,
+	              0,
+	              0,
+	              window_data,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with an unsupported format version
+	 */
+	segment_file->major_version = 3;
+
+	read_count = libewf_segment_file_read_section_descriptors_window(
+	              segment_file,
+	              NULL,
+	              0,
+	              0,
+	              window_data,
+	              64,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_segment_file_free(
+	          &segment_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_segment_file_read_section_descriptor function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_file_read_section_descriptor(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libewf_section_t *section = NULL;
+	ssize_t read_count        = 0;
+	int result                = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_section_initialize(
+	          &section,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "section",
+         section );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	read_count = libewf_segment_file_read_section_descriptor(
+	              NULL,
+	              section,
+	              NULL,
+	              0,
+	              0,
+	              NULL,
+	              0,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_section_free(
+	          &section,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( section != NULL )
+	{
+		libewf_section_free(
+		 &section,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests that the section descriptors read using a section descriptors window
+ * match those read individually with libewf_section_descriptor_read
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_file_read_section_descriptors_with_window(
+     const system_character_t *source )
+{
+	uint8_t window_data[ LIBEWF_SEGMENT_FILE_SECTION_DESCRIPTORS_WINDOW_SIZE ];
+
+	libbfio_pool_t *file_io_pool        = NULL;
+	libcerror_error_t *error            = NULL;
+	libewf_io_handle_t *io_handle       = NULL;
+	libewf_section_t *section           = NULL;
+	libewf_section_t *window_section    = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	size64_t segment_file_size          = 0;
+	size_t section_descriptor_data_size = 0;
+	size_t window_data_size             = 0;
+	ssize_t read_count                  = 0;
+	ssize_t window_read_count           = 0;
+	off64_t section_descriptor_offset   = 0;
+	off64_t window_offset               = 0;
+	uint8_t read_ahead                  = 0;
+	int number_of_sections              = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_segment_file_open_source(
+	          &file_io_pool,
+	          source,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "file_io_pool",
+         file_io_pool );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbfio_pool_get_size(
+	          file_io_pool,
+	          0,
+	          &segment_file_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_segment_file_initialize(
+	          &segment_file,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	read_count = libewf_segment_file_read_file_header(
+	              segment_file,
+	              file_io_pool,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "read_count",
+	 (int) read_count,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_section_initialize(
+	          &section,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_section_initialize(
+	          &window_section,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Determine the first section descriptor in the same way
+	 * as libewf_segment_file_read_element_data
+	 */
+	if( segment_file->major_version == 1 )
+	{
+		section_descriptor_data_size = sizeof( ewf_section_descriptor_v1_t );
+		section_descriptor_offset    = (off64_t) read_count;
+	}
+	else if( segment_file->major_version == 2 )
+	{
+		section_descriptor_data_size = sizeof( ewf_section_descriptor_v2_t );
+		section_descriptor_offset    = (off64_t) segment_file_size - sizeof( ewf_section_descriptor_v2_t );
+	}
+	read_ahead = 1;
+
+	/* Test regular cases
+	 */
+	while( ( section_descriptor_offset > 0 )
+	    && ( (size64_t) section_descriptor_offset < segment_file_size )
+	    && ( number_of_sections < EWF_TEST_SEGMENT_FILE_MAXIMUM_NUMBER_OF_SECTIONS ) )
+	{
+		if( ( read_ahead != 0 )
+		 && ( ( window_data_size == 0 )
+		  || ( section_descriptor_offset < window_offset )
+		  || ( ( (size64_t) ( section_descriptor_offset - window_offset ) + section_descriptor_data_size ) > (size64_t) window_data_size ) ) )
+		{
+			result = libewf_segment_file_get_section_descriptors_window(
+			          segment_file,
+			          section_descriptor_offset,
+			          segment_file_size,
+			          &window_offset,
+			          &window_data_size,
+			          &error );
+
+			EWF_TEST_ASSERT_NOT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+		        EWF_TEST_ASSERT_IS_NULL(
+		         "error",
+		         error );
+
+			if( result == 0 )
+			{
+				window_data_size = 0;
+			}
+			else
+			{
+				read_count = libewf_segment_file_read_section_descriptors_window(
+				              segment_file,
+				              file_io_pool,
+				              0,
+				              window_offset,
+				              window_data,
+				              window_data_size,
+				              &error );
+
+				EWF_TEST_ASSERT_EQUAL_SSIZE(
+				 "read_count",
+				 read_count,
+				 (ssize_t) window_data_size );
+
+			        EWF_TEST_ASSERT_IS_NULL(
+			         "error",
+			         error );
+			}
+		}
+		read_count = libewf_section_descriptor_read(
+		              section,
+		              file_io_pool,
+		              0,
+		              section_descriptor_offset,
+		              segment_file->major_version,
+		              &error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_free(
+			 &error );
+		}
+		window_read_count = libewf_segment_file_read_section_descriptor(
+		                   segment_file,
+		                   window_section,
+		                   file_io_pool,
+		                   0,
+		                   section_descriptor_offset,
+		                   window_data,
+		                   window_data_size,
+		                   window_offset,
+		                   &error );
+
+		if( window_read_count == -1 )
+		{
+			libcerror_error_free(
+			 &error );
+		}
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "window_read_count",
+		 window_read_count,
+		 read_count );
+
+		/* A corrupted section descriptor ends the sections list
+		 */
+		if( read_count == -1 )
+		{
+			break;
+		}
+		EWF_TEST_ASSERT_EQUAL_UINT32(
+		 "window_section->type",
+		 window_section->type,
+		 section->type );
+
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "window_section->start_offset",
+		 (int64_t) window_section->start_offset,
+		 (int64_t) section->start_offset );
+
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "window_section->end_offset",
+		 (int64_t) window_section->end_offset,
+		 (int64_t) section->end_offset );
+
+		EWF_TEST_ASSERT_EQUAL_UINT64(
+		 "window_section->size",
+		 (uint64_t) window_section->size,
+		 (uint64_t) section->size );
+
+		EWF_TEST_ASSERT_EQUAL_UINT64(
+		 "window_section->data_size",
+		 (uint64_t) window_section->data_size,
+		 (uint64_t) section->data_size );
+
+		number_of_sections++;
+
+		if( section->size <= (size64_t) LIBEWF_SEGMENT_FILE_SECTION_DESCRIPTORS_WINDOW_SIZE )
+		{
+			read_ahead = 1;
+		}
+		else
+		{
+			read_ahead = 0;
+		}
+
+		if( section->size == 0 )
+		{
+			break;
+		}
+		if( segment_file->major_version == 1 )
+		{
+			if( ( section->type == LIBEWF_SECTION_TYPE_NEXT )
+			 || ( section->type == LIBEWF_SECTION_TYPE_DONE ) )
+			{
+				break;
+			}
+			section_descriptor_offset += section->size;
+		}
+		else
+		{
+			section_descriptor_offset -= section->size;
+		}
+	}
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_sections",
+	 number_of_sections,
+	 0 );
+
+	/* Clean up
+	 */
+	result = libewf_section_free(
+	          &window_section,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_section_free(
+	          &section,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_segment_file_free(
+	          &segment_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbfio_pool_close_all(
+	          file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbfio_pool_free(
+	          &file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( window_section != NULL )
+	{
+		libewf_section_free(
+		 &window_section,
+		 NULL );
+	}
+	if( section != NULL )
+	{
+		libewf_section_free(
+		 &section,
+		 NULL );
+	}
+	if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_close_all(
+		 file_io_pool,
+		 NULL );
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_segment_file_append_section_correction function
+ * and building the corrected section data in memory
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_file_append_section_correction(
+     void )
+{
+	libcdata_array_t *sections_corrections          = NULL;
+	libcerror_error_t *error                        = NULL;
+	libewf_io_handle_t *io_handle                   = NULL;
+	libewf_media_values_t *media_values             = NULL;
+	libewf_section_t *section                       = NULL;
+	libewf_section_correction_t *section_correction = NULL;
+	libewf_segment_file_t *segment_file             = NULL;
+	ewf_data_t *data_section                        = NULL;
+	uint8_t *case_data                              = NULL;
+	uint8_t *device_information                     = NULL;
+	size_t case_data_size                           = 0;
+	size_t device_information_size                  = 0;
+	int number_of_entries                           = 0;
+	int result                                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_media_values_initialize(
+	          &media_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_segment_file_initialize(
+	          &segment_file,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	segment_file->segment_number = 2;
+
+	result = libcdata_array_initialize(
+	          &sections_corrections,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_section_initialize(
+	          &section,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_section_set_values(
+	          section,
+	          0,
+	          (uint8_t *) "data",
+	          4,
+	          4096,
+	          (size64_t) ( sizeof( ewf_section_descriptor_v1_t ) + sizeof( ewf_data_t ) ),
+	          (size64_t) sizeof( ewf_data_t ),
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test regular cases
+	 */
+	result = libewf_segment_file_append_section_correction(
+	          segment_file,
+	          sections_corrections,
+	          1,
+	          &section,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "section",
+         section );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libcdata_array_get_number_of_entries(
+	          sections_corrections,
+	          &number_of_entries,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 1 );
+
+	result = libcdata_array_get_entry_by_index(
+	          sections_corrections,
+	          0,
+	          (intptr_t **) &section_correction,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "section_correction",
+         section_correction );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "section_correction->segment_number",
+	 section_correction->segment_number,
+	 2 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "section_correction->file_io_pool_entry",
+	 section_correction->file_io_pool_entry,
+	 1 );
+
+	media_values->media_size        = 1048576;
+	media_values->number_of_chunks  = 32;
+	media_values->number_of_sectors = 2048;
+
+	result = libewf_section_correction_build_data(
+	          section_correction,
+	          io_handle,
+	          LIBEWF_SEGMENT_FILE_TYPE_EWF1,
+	          media_values,
+	          NULL,
+	          0,
+	          &case_data,
+	          &case_data_size,
+	          &device_information,
+	          &device_information_size,
+	          &data_section,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "section_correction->data_size",
+	 section_correction->data_size,
+	 (size_t) ( sizeof( ewf_section_descriptor_v1_t ) + sizeof( ewf_data_t ) ) );
+
+	result = memory_compare(
+	          section_correction->data,
+	          "data",
+	          4 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* The corrected section is written at the offset of the original section
+	 */
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "section_correction->section->start_offset",
+	 (int64_t) section_correction->section->start_offset,
+	 (int64_t) 4096 );
+
+	/* Test error cases
+	 */
+	result = libewf_segment_file_append_section_correction(
+	          NULL,
+	          sections_corrections,
+	          1,
+	          &section,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_file_append_section_correction(
+	          segment_file,
+	          sections_corrections,
+	          1,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* The corrected data can only be build once
+	 */
+	result = libewf_section_correction_build_data(
+	          section_correction,
+	          io_handle,
+	          LIBEWF_SEGMENT_FILE_TYPE_EWF1,
+	          media_values,
+	          NULL,
+	          0,
+	          &case_data,
+	          &case_data_size,
+	          &device_information,
+	          &device_information_size,
+	          &data_section,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        EWF_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	if( data_section != NULL )
+	{
+		memory_free(
+		 data_section );
+
+		data_section = NULL;
+	}
+	result = libcdata_array_free(
+	          &sections_corrections,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libewf_section_correction_free,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_segment_file_free(
+	          &segment_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_media_values_free(
+	          &media_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_section != NULL )
+	{
+		memory_free(
+		 data_section );
+	}
+	if( section != NULL )
+	{
+		libewf_section_free(
+		 &section,
+		 NULL );
+	}
+	if( sections_corrections != NULL )
+	{
+		libcdata_array_free(
+		 &sections_corrections,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_section_correction_free,
+		 NULL );
+	}
+	if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	if( media_values != NULL )
+	{
+		libewf_media_values_free(
+		 &media_values,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+	system_character_t *source = NULL;
+	system_integer_t option    = 0;
+
+	while( ( option = ewf_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				return( EXIT_FAILURE );
+		}
+	}
+	if( optind < argc )
+	{
+		source = argv[ optind ];
+	}
+#if defined( __GNUC__ )
+
+	EWF_TEST_RUN(
+	 "libewf_segment_file_get_section_descriptors_window",
+	 ewf_test_segment_file_get_section_descriptors_window );
+
+	EWF_TEST_RUN(
+	 "libewf_segment_file_read_section_descriptors_window",
+	 ewf_test_segment_file_read_section_descriptors_window );
+
+	EWF_TEST_RUN(
+	 "libewf_segment_file_read_section_descriptor",
+	 ewf_test_segment_file_read_section_descriptor );
+
+	EWF_TEST_RUN(
+	 "libewf_segment_file_append_section_correction",
+	 ewf_test_segment_file_append_section_correction );
+
+#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
+	if( source != NULL )
+	{
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_segment_file_read_section_descriptor with window",
+		 ewf_test_segment_file_read_section_descriptors_with_window,
+		 source );
+	}
+#endif /* !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 ) */
+
+#else
+	EWF_TEST_UNREFERENCED_PARAMETER( source )
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -159,16 +159,19 @@ int ewf_test_write(
      const system_character_t *filename,
      size64_t media_size,
      size64_t maximum_segment_size,
+     uint32_t chunks_section_limit,
      int8_t compression_level,
      uint8_t compression_flags,
      libcerror_error_t **error )
 {
-	libewf_handle_t *handle = NULL;
-	uint8_t *buffer         = NULL;
-	static char *function   = "ewf_test_write";
-	size_t write_size       = 0;
-	ssize_t write_count     = 0;
-	int sector_iterator     = 0;
+	libewf_handle_t *handle   = NULL;
+	uint8_t *buffer           = NULL;
+	static char *function     = "ewf_test_write";
+	size_t write_size         = 0;
+	ssize_t write_count       = 0;
+	uint64_t number_of_chunks = 0;
+	uint32_t segment_number   = 0;
+	int sector_iterator       = 0;
 
 	if( libewf_handle_initialize(
 	     &handle,
@@ -242,6 +245,23 @@ int ewf_test_write(
 			goto on_error;
 		}
 	}
+	if( chunks_section_limit > 0 )
+	{
+		if( libewf_handle_set_chunks_section_limit(
+		     handle,
+		     chunks_section_limit,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable set chunks section limit.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libewf_handle_set_compression_values(
 	     handle,
 	     compression_level,
@@ -329,6 +349,26 @@ int ewf_test_write(
 			media_size -= write_count;
 		}
 	}
+	/* Closing the chunks section at a checkpoint should not affect the data written
+	 */
+	if( chunks_section_limit > 0 )
+	{
+		if( libewf_handle_write_checkpoint(
+		     handle,
+		     &segment_number,
+		     &number_of_chunks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write checkpoint.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	write_size = 3751;
 
 	for( sector_iterator = 0;
@@ -438,6 +478,379 @@ on_error:
 	return( -1 );
 }
 
+/* Tests reading back the data written by ewf_test_write
+ * This verifies that the sections were corrected with the media size when the write was finalized
+ * Return 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_write_verify(
+     const system_character_t *filename,
+     size64_t media_size,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *handle              = NULL;
+	system_character_t **filenames       = NULL;
+	system_character_t *segment_filename = NULL;
+	uint8_t *buffer                      = NULL;
+	static char *function                = "ewf_test_write_verify";
+	size64_t expected_media_size         = 0;
+	size64_t stored_media_size           = 0;
+	size_t buffer_index                  = 0;
+	size_t filename_length               = 0;
+	size_t read_size                     = 0;
+	ssize_t read_count                   = 0;
+	off64_t read_offset                  = 0;
+	uint32_t number_of_checksum_errors   = 0;
+	uint8_t expected_value               = 0;
+	int number_of_filenames              = 0;
+	int result                           = 1;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	/* ewf_test_write writes 26 buffers of 512 bytes followed by 26 buffers of 3751 bytes
+	 */
+	expected_media_size = ( 26 * 512 ) + ( 26 * 3751 );
+
+	if( ( media_size > 0 )
+	 && ( media_size < expected_media_size ) )
+	{
+		expected_media_size = media_size;
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+	segment_filename = system_string_allocate(
+	                    filename_length + 5 );
+
+	if( segment_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     segment_filename,
+	     filename,
+	     filename_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     &( segment_filename[ filename_length ] ),
+	     _SYSTEM_STRING( ".E01" ),
+	     4 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy extension.",
+		 function );
+
+		goto on_error;
+	}
+	segment_filename[ filename_length + 4 ] = 0;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide(
+	     segment_filename,
+	     filename_length + 4,
+	     LIBEWF_FORMAT_UNKNOWN,
+	     (wchar_t ***) &filenames,
+	     &number_of_filenames,
+	     error ) != 1 )
+#else
+	if( libewf_glob(
+	     segment_filename,
+	     filename_length + 4,
+	     LIBEWF_FORMAT_UNKNOWN,
+	     (char ***) &filenames,
+	     &number_of_filenames,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to resolve filename(s).",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 segment_filename );
+
+	segment_filename = NULL;
+
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     (wchar_t * const *) filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     (char * const *) filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_media_size(
+	     handle,
+	     &stored_media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( stored_media_size != expected_media_size )
+	{
+		fprintf(
+		 stderr,
+		 "%s: media size: %" PRIu64 " does not match expected: %" PRIu64 ".\n",
+		 function,
+		 stored_media_size,
+		 expected_media_size );
+
+		result = 0;
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      EWF_TEST_WRITE_BUFFER_SIZE );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable created buffer.",
+		 function );
+
+		goto on_error;
+	}
+	while( ( result == 1 )
+	    && ( (size64_t) read_offset < expected_media_size ) )
+	{
+		read_size = EWF_TEST_WRITE_BUFFER_SIZE;
+
+		if( (size64_t) read_size > ( expected_media_size - read_offset ) )
+		{
+			read_size = (size_t) ( expected_media_size - read_offset );
+		}
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              read_size,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable read buffer of size: %" PRIzd ".",
+			 function,
+			 read_size );
+
+			goto on_error;
+		}
+		for( buffer_index = 0;
+		     buffer_index < read_size;
+		     buffer_index++ )
+		{
+			if( read_offset < ( 26 * 512 ) )
+			{
+				expected_value = (uint8_t) ( 'A' + ( read_offset / 512 ) );
+			}
+			else
+			{
+				expected_value = (uint8_t) ( 'a' + ( ( read_offset - ( 26 * 512 ) ) / 3751 ) );
+			}
+			if( buffer[ buffer_index ] != expected_value )
+			{
+				fprintf(
+				 stderr,
+				 "%s: mismatch in data at offset: %" PRIi64 ".\n",
+				 function,
+				 read_offset );
+
+				result = 0;
+
+				break;
+			}
+			read_offset++;
+		}
+	}
+	if( libewf_handle_get_number_of_checksum_errors(
+	     handle,
+	     &number_of_checksum_errors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of checksum errors.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_checksum_errors != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "%s: unexpected number of checksum errors: %" PRIu32 ".\n",
+		 function,
+		 number_of_checksum_errors );
+
+		result = 0;
+	}
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide_free(
+	     (wchar_t **) filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+#else
+	if( libewf_glob_free(
+	     (char **) filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free glob.",
+		 function );
+
+		filenames = NULL;
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( filenames != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 (wchar_t **) filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 (char **) filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	if( segment_filename != NULL )
+	{
+		memory_free(
+		 segment_filename );
+	}
+	return( -1 );
+}
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -448,21 +861,24 @@ int main( int argc, char * const argv[] )
 {
 	libcerror_error_t *error                        = NULL;
 	system_character_t *option_chunk_size           = NULL;
+	system_character_t *option_chunks_section_limit = NULL;
 	system_character_t *option_compression_level    = NULL;
 	system_character_t *option_maximum_segment_size = NULL;
 	system_character_t *option_media_size           = NULL;
 	system_integer_t option                         = 0;
 	size64_t chunk_size                             = 0;
+	uint64_t chunks_section_limit                   = 0;
 	size64_t maximum_segment_size                   = 0;
 	size64_t media_size                             = 0;
 	size_t string_length                            = 0;
 	uint8_t compression_flags                       = 0;
 	int8_t compression_level                        = LIBEWF_COMPRESSION_NONE;
+	int result                                      = 0;
 
 	while( ( option = ewf_test_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "b:B:c:S:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "b:B:c:k:S:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -490,6 +906,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'k':
+				option_chunks_section_limit = optarg;
+
+				break;
+
 			case (system_integer_t) 'S':
 				option_maximum_segment_size = optarg;
 
@@ -571,6 +992,32 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( option_chunks_section_limit != NULL )
+	{
+		string_length = system_string_length(
+				 option_chunks_section_limit );
+
+		if( ewf_test_system_string_decimal_copy_to_64_bit(
+		     option_chunks_section_limit,
+		     string_length + 1,
+		     &chunks_section_limit,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported chunks section limit.\n" );
+
+			goto on_error;
+		}
+		if( chunks_section_limit > (uint64_t) INT32_MAX )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported chunks section limit.\n" );
+
+			goto on_error;
+		}
+	}
 	if( option_maximum_segment_size != NULL )
 	{
 		string_length = system_string_length(
@@ -611,6 +1058,7 @@ int main( int argc, char * const argv[] )
 	     argv[ optind ],
 	     media_size,
 	     maximum_segment_size,
+	     (uint32_t) chunks_section_limit,
 	     compression_level,
 	     compression_flags,
 	     &error ) != 1 )
@@ -621,6 +1069,19 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	result = ewf_test_write_verify(
+	          argv[ optind ],
+	          media_size,
+	          &error );
+
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to verify written data.\n" );
+
+		goto on_error;
+	}
 	return( EXIT_SUCCESS );
 
 on_error:
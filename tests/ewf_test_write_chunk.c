@@ -146,15 +146,327 @@ int ewf_test_system_string_decimal_copy_to_64_bit(
 	return( 1 );
 }
 
+/* Tests reading back the data written with a concurrent segment write
+ * Every chunk is expected to be filled with 'A' + chunk index modulo 26
+ * Return 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_write_chunk_verify(
+     const system_character_t *filename,
+     size64_t media_size,
+     size_t chunk_size,
+     libcerror_error_t **error )
+{
+	system_character_t **filenames       = NULL;
+	system_character_t *segment_filename = NULL;
+	libewf_handle_t *handle              = NULL;
+	uint8_t *chunk_buffer                = NULL;
+	static char *function                = "ewf_test_write_chunk_verify";
+	size64_t read_media_size             = 0;
+	size_t buffer_index                  = 0;
+	size_t filename_length               = 0;
+	size_t read_size                     = 0;
+	ssize_t read_count                   = 0;
+	off64_t offset                       = 0;
+	uint64_t chunk_index                 = 0;
+	int number_of_filenames              = 0;
+	int result                           = 0;
+
+	filename_length = system_string_length(
+	                   filename );
+
+	segment_filename = system_string_allocate(
+	                    filename_length + 5 );
+
+	if( segment_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     segment_filename,
+	     filename,
+	     filename_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     &( segment_filename[ filename_length ] ),
+	     _SYSTEM_STRING( ".E01" ),
+	     5 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy extension.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_glob_wide(
+	          segment_filename,
+	          filename_length + 4,
+	          LIBEWF_FORMAT_UNKNOWN,
+	          &filenames,
+	          &number_of_filenames,
+	          error );
+#else
+	result = libewf_glob(
+	          segment_filename,
+	          filename_length + 4,
+	          LIBEWF_FORMAT_UNKNOWN,
+	          &filenames,
+	          &number_of_filenames,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to resolve filename(s).",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_handle_open_wide(
+	          handle,
+	          (wchar_t * const *) filenames,
+	          number_of_filenames,
+	          LIBEWF_OPEN_READ,
+	          error );
+#else
+	result = libewf_handle_open(
+	          handle,
+	          (char * const *) filenames,
+	          number_of_filenames,
+	          LIBEWF_OPEN_READ,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_media_size(
+	     handle,
+	     &read_media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	result = 1;
+
+	if( read_media_size != media_size )
+	{
+		result = 0;
+	}
+	chunk_buffer = (uint8_t *) memory_allocate(
+	                            sizeof( uint8_t ) * chunk_size );
+
+	if( chunk_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk buffer.",
+		 function );
+
+		goto on_error;
+	}
+	while( ( result == 1 )
+	    && ( (size64_t) offset < media_size ) )
+	{
+		read_size = chunk_size;
+
+		if( ( media_size - (size64_t) offset ) < (size64_t) read_size )
+		{
+			read_size = (size_t) ( media_size - (size64_t) offset );
+		}
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              chunk_buffer,
+		              read_size,
+		              offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		for( buffer_index = 0;
+		     buffer_index < read_size;
+		     buffer_index++ )
+		{
+			if( chunk_buffer[ buffer_index ] != (uint8_t) ( 'A' + ( chunk_index % 26 ) ) )
+			{
+				result = 0;
+
+				break;
+			}
+		}
+		offset      += (off64_t) read_size;
+		chunk_index += 1;
+	}
+	memory_free(
+	 chunk_buffer );
+
+	chunk_buffer = NULL;
+
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide_free(
+	     filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+#else
+	if( libewf_glob_free(
+	     filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free globbed filenames.",
+		 function );
+
+		filenames = NULL;
+
+		goto on_error;
+	}
+	memory_free(
+	 segment_filename );
+
+	return( result );
+
+on_error:
+	if( chunk_buffer != NULL )
+	{
+		memory_free(
+		 chunk_buffer );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( filenames != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	if( segment_filename != NULL )
+	{
+		memory_free(
+		 segment_filename );
+	}
+	return( -1 );
+}
+
 /* Tests writing data of media size to EWF file(s) with a maximum segment size
+ * With a concurrent segment write the chunks are written in reverse order and read back
  * Return 1 if successful, 0 if not or -1 on error
  */
 int ewf_test_write_chunk(
      const system_character_t *filename,
      size64_t media_size,
      size64_t maximum_segment_size,
+     uint32_t chunks_section_limit,
      int8_t compression_level,
      uint8_t compression_flags,
+     uint8_t concurrent_segment_write,
      libcerror_error_t **error )
 {
 	libewf_data_chunk_t *data_chunk = NULL;
@@ -165,7 +477,11 @@ int ewf_test_write_chunk(
 	size_t write_size               = 0;
 	ssize_t process_count           = 0;
 	ssize_t write_count             = 0;
+	size64_t written_media_size     = 0;
+	uint64_t chunk_index            = 0;
+	uint64_t number_of_chunks       = 0;
 	uint32_t sectors_per_chunk      = 0;
+	int result                      = 1;
 	int sector_iterator             = 0;
 
 	if( libewf_handle_initialize(
@@ -240,6 +556,23 @@ int ewf_test_write_chunk(
 			goto on_error;
 		}
 	}
+	if( chunks_section_limit > 0 )
+	{
+		if( libewf_handle_set_chunks_section_limit(
+		     handle,
+		     chunks_section_limit,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable set chunks section limit.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libewf_handle_set_compression_values(
 	     handle,
 	     compression_level,
@@ -271,6 +604,23 @@ int ewf_test_write_chunk(
 
 		goto on_error;
 	}
+	if( concurrent_segment_write != 0 )
+	{
+		if( libewf_handle_set_concurrent_segment_write(
+		     handle,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable set concurrent segment write.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libewf_handle_get_data_chunk(
 	     handle,
 	     &data_chunk,
@@ -292,76 +642,164 @@ int ewf_test_write_chunk(
 	chunk_buffer = (uint8_t *) memory_allocate(
 	                            sizeof( uint8_t ) * chunk_buffer_size );
 
-	for( sector_iterator = 0;
-	     sector_iterator < 26;
-	     sector_iterator++ )
+	if( chunk_buffer == NULL )
 	{
-		if( memory_set(
-		     chunk_buffer,
-		     (int) 'A' + sector_iterator,
-		     chunk_buffer_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-			 "%s: unable set value in chunk buffer.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk buffer.",
+		 function );
 
-			goto on_error;
-		}
-		if( chunk_buffer_size < media_size )
+		goto on_error;
+	}
+	written_media_size = media_size;
+
+	if( concurrent_segment_write != 0 )
+	{
+		number_of_chunks = media_size / chunk_buffer_size;
+
+		if( ( media_size % chunk_buffer_size ) != 0 )
 		{
-			write_size = chunk_buffer_size;
+			number_of_chunks += 1;
 		}
-		else
+		/* Write the chunks in reverse order to test that the write
+		 * does not depend on the order of the chunks
+		 */
+		for( chunk_index = number_of_chunks;
+		     chunk_index > 0;
+		     chunk_index-- )
 		{
-			write_size = (size_t) media_size;
-		}
-		process_count = libewf_data_chunk_write_buffer(
-				 data_chunk,
-				 chunk_buffer,
-				 write_size,
-				 error );
+			if( memory_set(
+			     chunk_buffer,
+			     (int) 'A' + (int) ( ( chunk_index - 1 ) % 26 ),
+			     chunk_buffer_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable set value in chunk buffer.",
+				 function );
 
-		if( process_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write buffer to data chunk.",
-			 function );
+				goto on_error;
+			}
+			write_size = chunk_buffer_size;
 
-			goto on_error;
-		}
-		write_count = libewf_handle_write_data_chunk(
-			       handle,
-			       data_chunk,
-			       error );
+			if( ( media_size - ( ( chunk_index - 1 ) * chunk_buffer_size ) ) < (size64_t) write_size )
+			{
+				write_size = (size_t) ( media_size - ( ( chunk_index - 1 ) * chunk_buffer_size ) );
+			}
+			process_count = libewf_data_chunk_write_buffer(
+					 data_chunk,
+					 chunk_buffer,
+					 write_size,
+					 error );
 
-		if( write_count < 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable write data chunk to handle.",
-			 function );
+			if( process_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write buffer to data chunk.",
+				 function );
 
-			goto on_error;
-		}
-		if( media_size > (size64_t) chunk_buffer_size )
-		{
-			media_size -= chunk_buffer_size;
-		}
-		else if( media_size > 0 )
-		{
-			media_size = 0;
+				goto on_error;
+			}
+			write_count = libewf_handle_write_data_chunk_at_offset(
+				       handle,
+				       data_chunk,
+				       (off64_t) ( ( chunk_index - 1 ) * chunk_buffer_size ),
+				       error );
+
+			if( write_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable write data chunk: %" PRIu64 " to handle.",
+				 function,
+				 chunk_index - 1 );
+
+				goto on_error;
+			}
 		}
-		if( media_size == 0 )
+	}
+	else
+	{
+		for( sector_iterator = 0;
+		     sector_iterator < 26;
+		     sector_iterator++ )
 		{
-			break;
+			if( memory_set(
+			     chunk_buffer,
+			     (int) 'A' + sector_iterator,
+			     chunk_buffer_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable set value in chunk buffer.",
+				 function );
+
+				goto on_error;
+			}
+			if( chunk_buffer_size < media_size )
+			{
+				write_size = chunk_buffer_size;
+			}
+			else
+			{
+				write_size = (size_t) media_size;
+			}
+			process_count = libewf_data_chunk_write_buffer(
+					 data_chunk,
+					 chunk_buffer,
+					 write_size,
+					 error );
+
+			if( process_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write buffer to data chunk.",
+				 function );
+
+				goto on_error;
+			}
+			write_count = libewf_handle_write_data_chunk(
+				       handle,
+				       data_chunk,
+				       error );
+
+			if( write_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable write data chunk to handle.",
+				 function );
+
+				goto on_error;
+			}
+			if( media_size > (size64_t) chunk_buffer_size )
+			{
+				media_size -= chunk_buffer_size;
+			}
+			else if( media_size > 0 )
+			{
+				media_size = 0;
+			}
+			if( media_size == 0 )
+			{
+				break;
+			}
 		}
 	}
 	memory_free(
@@ -408,7 +846,27 @@ int ewf_test_write_chunk(
 
 		goto on_error;
 	}
-	return( 1 );
+	if( concurrent_segment_write != 0 )
+	{
+		result = ewf_test_write_chunk_verify(
+		          filename,
+		          written_media_size,
+		          chunk_buffer_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to verify written data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( result );
 
 on_error:
 	if( chunk_buffer != NULL )
@@ -444,21 +902,25 @@ int main( int argc, char * const argv[] )
 {
 	libcerror_error_t *error                        = NULL;
 	system_character_t *option_chunk_size           = NULL;
+	system_character_t *option_chunks_section_limit = NULL;
 	system_character_t *option_compression_level    = NULL;
 	system_character_t *option_maximum_segment_size = NULL;
 	system_character_t *option_media_size           = NULL;
 	system_integer_t option                         = 0;
 	size64_t chunk_size                             = 0;
+	uint64_t chunks_section_limit                   = 0;
 	size64_t maximum_segment_size                   = 0;
 	size64_t media_size                             = 0;
 	size_t string_length                            = 0;
 	uint8_t compression_flags                       = 0;
+	uint8_t concurrent_segment_write                = 0;
 	int8_t compression_level                        = LIBEWF_COMPRESSION_NONE;
+	int result                                      = 0;
 
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "b:B:c:S:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "b:B:c:Ck:S:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -481,6 +943,16 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'C':
+				concurrent_segment_write = 1;
+
+				break;
+
+			case (system_integer_t) 'k':
+				option_chunks_section_limit = optarg;
+
+				break;
+
 			case (system_integer_t) 'B':
 				option_media_size = optarg;
 
@@ -560,6 +1032,32 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( option_chunks_section_limit != NULL )
+	{
+		string_length = system_string_length(
+				 option_chunks_section_limit );
+
+		if( ewf_test_system_string_decimal_copy_to_64_bit(
+		     option_chunks_section_limit,
+		     string_length + 1,
+		     &chunks_section_limit,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported chunks section limit.\n" );
+
+			goto on_error;
+		}
+		if( chunks_section_limit > (uint64_t) INT32_MAX )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported chunks section limit.\n" );
+
+			goto on_error;
+		}
+	}
 	if( option_maximum_segment_size != NULL )
 	{
 		string_length = system_string_length(
@@ -596,13 +1094,17 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
-	if( ewf_test_write_chunk(
-	     argv[ optind ],
-	     media_size,
-	     maximum_segment_size,
-	     compression_level,
-	     compression_flags,
-	     &error ) != 1 )
+	result = ewf_test_write_chunk(
+	          argv[ optind ],
+	          media_size,
+	          maximum_segment_size,
+	          (uint32_t) chunks_section_limit,
+	          compression_level,
+	          compression_flags,
+	          concurrent_segment_write,
+	          &error );
+
+	if( result == -1 )
 	{
 		fprintf(
 		 stderr,
@@ -610,6 +1112,14 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	else if( result == 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Data read back does not match data written.\n" );
+
+		goto on_error;
+	}
 	return( EXIT_SUCCESS );
 
 on_error:
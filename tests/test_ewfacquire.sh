@@ -57,6 +57,20 @@ test_callback()
 		run_test_with_input_and_arguments "${VERIFY_TOOL}" ${TMPDIR}/acquire.* -q > /dev/null;
 		local RESULT=$?;
 	fi
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		# Verify only the chunks, which reads them with multiple handles.
+		run_test_with_input_and_arguments "${VERIFY_TOOL}" ${TMPDIR}/acquire.* -c -j4 -q > /dev/null;
+		local RESULT=$?;
+	fi
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		# Verify the image twice as a batch, which shares the processing jobs.
+		local FIRST_SEGMENT_FILE=`ls ${TMPDIR}/acquire.* | head -n 1`;
+
+		run_test_with_input_and_arguments "${VERIFY_TOOL}" ${FIRST_SEGMENT_FILE} -b2 -j4 -q ${FIRST_SEGMENT_FILE} > /dev/null;
+		local RESULT=$?;
+	fi
 	return ${RESULT};
 }
 
@@ -14,13 +14,20 @@ test_write_resume()
 { 
 	INPUT_FILE=$1;
 	RESUME_OFFSET=$2;
+	CHUNKS_SECTION_LIMIT=$3;
 
 	TMPDIR="tmp$$";
 
 	rm -rf ${TMPDIR};
 	mkdir ${TMPDIR};
 
-	run_test_with_input_and_arguments "${ACQUIRE_TOOL}" "${INPUT_FILE}" -b 64 -c deflate:none -C Case -D Description -E Evidence -e Examiner -f encase5 -m removable -M logical -N Notes -q -S 650MB -t ${TMPDIR}/acquire_resume -u > /dev/null;
+	OPTIONS="";
+
+	if ! test -z "${CHUNKS_SECTION_LIMIT}";
+	then
+		OPTIONS="-k ${CHUNKS_SECTION_LIMIT}";
+	fi
+	run_test_with_input_and_arguments "${ACQUIRE_TOOL}" "${INPUT_FILE}" -b 64 -c deflate:none -C Case -D Description -E Evidence -e Examiner -f encase5 ${OPTIONS} -m removable -M logical -N Notes -q -S 650MB -t ${TMPDIR}/acquire_resume -u > /dev/null;
 
 	RESULT=$?;
 
@@ -31,6 +38,12 @@ test_write_resume()
 		RESULT=$?;
 	fi
 
+	# The checkpoint is removed when the acquiry completes
+	if test ${RESULT} -eq ${EXIT_SUCCESS} && test -f ${TMPDIR}/acquire_resume.checkpoint;
+	then
+		RESULT=${EXIT_FAILURE};
+	fi
+
 	if test ${RESULT} -eq ${EXIT_SUCCESS};
 	then
 		run_test_with_input_and_arguments "${TRUNCATE_TOOL}" ${TMPDIR}/acquire_resume.E01 ${RESUME_OFFSET} > /dev/null;
@@ -38,24 +51,58 @@ test_write_resume()
 		RESULT=$?;
 	fi
 
+	# A checkpoint beyond the data that was written is ignored
+	if test ${RESULT} -eq ${EXIT_SUCCESS} && ! test -z "${CHUNKS_SECTION_LIMIT}";
+	then
+		cat > ${TMPDIR}/acquire_resume.checkpoint <<EOT
+# Checkpoint created by ewfacquire
+offset: 1474560
+segment number: 1
+number of chunks: 45
+md5: 00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000
+EOT
+	fi
+
 	if test ${RESULT} -eq ${EXIT_SUCCESS};
 	then
-		run_test_with_input_and_arguments "${ACQUIRE_TOOL}" "${INPUT_FILE}" -q -R -t ${TMPDIR}/acquire_resume.E01 -u > ${TMPDIR}/output;
+		run_test_with_input_and_arguments "${ACQUIRE_TOOL}" "${INPUT_FILE}" ${OPTIONS} -q -R -t ${TMPDIR}/acquire_resume.E01 -u > ${TMPDIR}/output;
 
 		RESULT=$?;
 	fi
 
+	# With a chunks section limit the write is resumed after the last chunks section
+	# that was completely written instead of at the start of the media
+	if test ${RESULT} -eq ${EXIT_SUCCESS} && ! test -z "${CHUNKS_SECTION_LIMIT}";
+	then
+		ACQUIRE_OFFSET=`sed -n 's/^Resuming acquire at offset: \([0-9]*\)\.$/\1/p' ${TMPDIR}/output`;
+
+		if test -z "${ACQUIRE_OFFSET}" || test ${ACQUIRE_OFFSET} -eq 0;
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	fi
+
 	if test ${RESULT} -eq ${EXIT_SUCCESS};
 	then
 		run_test_with_input_and_arguments "${VERIFY_TOOL}" ${TMPDIR}/acquire_resume.E01 -q > /dev/null;
 
 		RESULT=$?;
 	fi
+
+	if test ${RESULT} -eq ${EXIT_SUCCESS} && test -f ${TMPDIR}/acquire_resume.checkpoint;
+	then
+		RESULT=${EXIT_FAILURE};
+	fi
 	rm -rf ${TMPDIR};
 
 	if test ${RESULT} -ne ${EXIT_IGNORE};
 	then
-		echo -n "Testing ewfacquire resume of at offset: ${RESUME_OFFSET}";
+		if test -z "${CHUNKS_SECTION_LIMIT}";
+		then
+			echo -n "Testing ewfacquire resume of at offset: ${RESUME_OFFSET}";
+		else
+			echo -n "Testing ewfacquire resume of at offset: ${RESUME_OFFSET} with chunks section limit: ${CHUNKS_SECTION_LIMIT}";
+		fi
 
 		if test ${RESULT} -ne ${EXIT_SUCCESS};
 		then
@@ -67,6 +114,37 @@ test_write_resume()
 	return ${RESULT};
 }
 
+test_write_resume_additional_target()
+{ 
+	INPUT_FILE=$1;
+
+	TMPDIR="tmp$$";
+
+	rm -rf ${TMPDIR};
+	mkdir ${TMPDIR};
+
+	# Resume is not supported with additional targets and should fail
+	run_test_with_input_and_arguments "${ACQUIRE_TOOL}" "${INPUT_FILE}" -q -R -O ${TMPDIR}/additional -t ${TMPDIR}/acquire_resume.E01 -u > /dev/null 2>&1;
+
+	if test $? -eq ${EXIT_SUCCESS};
+	then
+		RESULT=${EXIT_FAILURE};
+	else
+		RESULT=${EXIT_SUCCESS};
+	fi
+	rm -rf ${TMPDIR};
+
+	echo -n "Testing ewfacquire resume with additional target";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
 if ! test -z ${SKIP_TOOLS_TESTS};
 then
 	exit ${EXIT_IGNORE};
@@ -200,5 +278,22 @@ then
 	exit ${RESULT};
 fi
 
+test_write_resume_additional_target "${FILENAME}"
+RESULT=$?;
+
+if test ${RESULT} -ne ${EXIT_SUCCESS};
+then
+	exit ${RESULT};
+fi
+
+# Interrupt the write within the sectors section of a later chunks section
+test_write_resume "${FILENAME}" 800000 4
+RESULT=$?;
+
+if test ${RESULT} -ne ${EXIT_SUCCESS};
+then
+	exit ${RESULT};
+fi
+
 exit ${RESULT};
 
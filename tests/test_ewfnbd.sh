@@ -0,0 +1,148 @@
+#!/bin/bash
+# NBD server tool testing script
+#
+# Version: 20160328
+
+EXIT_SUCCESS=0;
+EXIT_FAILURE=1;
+EXIT_IGNORE=77;
+
+TEST_PREFIX=`dirname ${PWD}`;
+TEST_PREFIX=`basename ${TEST_PREFIX} | sed 's/^lib\([^-]*\)/\1/'`;
+
+test_nbd()
+{
+	INPUT_FILE=$1;
+	NUMBER_OF_JOBS=$2;
+
+	TMPDIR="tmp$$";
+
+	rm -rf ${TMPDIR};
+	mkdir ${TMPDIR};
+
+	SOCKET_PATH="${PWD}/${TMPDIR}/ewfnbd.sock";
+	NBD_URI="nbd+unix:///?socket=${SOCKET_PATH}";
+
+	run_test_with_input_and_arguments "${ACQUIRE_TOOL}" "${INPUT_FILE}" -c deflate:fast -C Case -D Description -E Evidence -e Examiner -f encase5 -m removable -M logical -N Notes -q -t ${TMPDIR}/nbd -u > /dev/null;
+
+	RESULT=$?;
+
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		${NBD_TOOL} -j ${NUMBER_OF_JOBS} -u ${SOCKET_PATH} ${TMPDIR}/nbd.E01 > /dev/null &
+
+		NBD_PID=$!;
+
+		# Wait for the server to create the socket.
+		for ITERATION in `seq 1 50`;
+		do
+			if test -S ${SOCKET_PATH};
+			then
+				break;
+			fi
+			sleep 0.1;
+		done
+
+		${NBDCOPY} "${NBD_URI}" ${TMPDIR}/nbd.raw;
+
+		RESULT=$?;
+
+		if test ${RESULT} -eq ${EXIT_SUCCESS};
+		then
+			cmp -s "${INPUT_FILE}" ${TMPDIR}/nbd.raw;
+
+			RESULT=$?;
+		fi
+
+		# The map is determined using block status requests.
+		if test ${RESULT} -eq ${EXIT_SUCCESS} && test -n "${NBDINFO}";
+		then
+			${NBDINFO} --map "${NBD_URI}" > /dev/null;
+
+			RESULT=$?;
+		fi
+
+		kill -TERM ${NBD_PID};
+		wait ${NBD_PID};
+	fi
+	rm -rf ${TMPDIR};
+
+	echo -n "Testing ewfnbd with ${NUMBER_OF_JOBS} jobs ";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
+if ! test -z ${SKIP_TOOLS_TESTS};
+then
+	exit ${EXIT_IGNORE};
+fi
+
+NBDCOPY=`which nbdcopy 2> /dev/null`;
+
+if test -z "${NBDCOPY}";
+then
+	exit ${EXIT_IGNORE};
+fi
+
+NBDINFO=`which nbdinfo 2> /dev/null`;
+
+ACQUIRE_TOOL="../${TEST_PREFIX}tools/${TEST_PREFIX}acquire";
+
+if ! test -x "${ACQUIRE_TOOL}";
+then
+	echo "Missing executable: ${ACQUIRE_TOOL}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+NBD_TOOL="../${TEST_PREFIX}tools/${TEST_PREFIX}nbd";
+
+if ! test -x "${NBD_TOOL}";
+then
+	echo "Missing executable: ${NBD_TOOL}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+TEST_RUNNER="tests/test_runner.sh";
+
+if ! test -f "${TEST_RUNNER}";
+then
+	TEST_RUNNER="./test_runner.sh";
+fi
+
+if ! test -f "${TEST_RUNNER}";
+then
+	echo "Missing test runner: ${TEST_RUNNER}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+source ${TEST_RUNNER};
+
+FILENAME="input/raw/floppy.raw";
+
+if ! test -f ${FILENAME};
+then
+	exit ${EXIT_IGNORE};
+fi
+
+test_nbd "${FILENAME}" 0
+RESULT=$?;
+
+if test ${RESULT} -ne ${EXIT_SUCCESS};
+then
+	exit ${RESULT};
+fi
+
+test_nbd "${FILENAME}" 4
+RESULT=$?;
+
+exit ${RESULT};
+
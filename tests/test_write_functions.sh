@@ -101,6 +101,33 @@ test_write()
 			return ${RESULT};
 		fi
 
+		test_api_write_function "${TEST_FUNCTION}" -B100000 -c${COMPRESSION_LEVEL} -k1 -S0;
+		RESULT=$?;
+
+		if test ${RESULT} -ne ${EXIT_SUCCESS};
+		then
+			return ${RESULT};
+		fi
+
+		if test "${TEST_FUNCTION}" = "write_chunk" && test "${COMPRESSION_LEVEL}" = "n";
+		then
+			test_api_write_function "${TEST_FUNCTION}" -B100000 -c${COMPRESSION_LEVEL} -C -S0;
+			RESULT=$?;
+
+			if test ${RESULT} -ne ${EXIT_SUCCESS};
+			then
+				return ${RESULT};
+			fi
+
+			test_api_write_function "${TEST_FUNCTION}" -B1000000 -c${COMPRESSION_LEVEL} -C -S100000;
+			RESULT=$?;
+
+			if test ${RESULT} -ne ${EXIT_SUCCESS};
+			then
+				return ${RESULT};
+			fi
+		fi
+
 		echo "";
 	done
 